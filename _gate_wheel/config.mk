@@ -0,0 +1,14 @@
+clickprefix=/root/repo/_gate_wheel/inst
+clickbindir=/root/repo/_gate_wheel/inst/bin
+clicksbindir=/root/repo/_gate_wheel/inst/sbin
+clicklibdir=/root/repo/_gate_wheel/inst/lib
+clickincludedir=/root/repo/_gate_wheel/inst/include
+clickdatadir=/root/repo/_gate_wheel/inst/share/click
+clicklinux_builddir=NONE
+clicklinux_srcdir=NONE
+clicksrcdir=/root/repo/_gate_wheel/inst/share/click/src
+CLICK_HAVE_USERLEVEL_DRIVER=1
+CLICK_HAVE_LINUXMODULE_DRIVER=0
+CLICK_HAVE_BSDMODULE_DRIVER=0
+CLICK_LINUXMODULE_2_6=
+CLICK_GMAKE=make
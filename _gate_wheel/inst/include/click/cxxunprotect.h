@@ -0,0 +1,14 @@
+#ifdef __cplusplus
+# undef new
+# undef this
+# undef delete
+# undef class
+# undef virtual
+# undef typename
+# undef private
+# undef protected
+# undef public
+# undef namespace
+# undef false
+# undef true
+#endif
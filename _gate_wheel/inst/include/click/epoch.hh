@@ -0,0 +1,126 @@
+// -*- c-basic-offset: 4; related-file-name: "../../lib/epoch.cc" -*-
+#ifndef CLICK_EPOCH_HH
+#define CLICK_EPOCH_HH
+#include <click/vector.hh>
+CLICK_DECLS
+class Master;
+
+/** @file <click/epoch.hh>
+ * @brief Deferred reclamation for tables with lock-free readers.
+ */
+
+/** @class EpochReclaimer include/click/epoch.hh <click/epoch.hh>
+ * @brief Frees objects once no lock-free reader can reach them.
+ *
+ * An EpochReclaimer lets a table serve readers without locks or atomic
+ * operations.  Writers, serialized by a lock of the table's own, never
+ * change published objects in place.  Instead they publish a replacement,
+ * unlink the old object, and pass it to retire().  The object is freed by a
+ * later reclaim(), once every RouterThread has passed a quiescent point
+ * (see Master::epoch()), since a thread between elements can hold no
+ * references into the table.
+ *
+ * Readers must run as element code in a RouterThread's driver, and must not
+ * keep references to table objects after returning.  Code running on other
+ * threads, such as handlers called from outside the driver, should read the
+ * table under the writers' lock.
+ *
+ * The table calls reclaim() when convenient, usually after retire() and from
+ * a timer, with its lock held.  Objects are freed in the order they were
+ * retired.
+ *
+ * @code
+ * // writer, holding _lock
+ * Entry *old = _entries[i];
+ * _entries[i] = replacement;	// after initializing *replacement
+ * _reclaimer.retire(old);
+ * _reclaimer.reclaim();
+ * @endcode
+ */
+class EpochReclaimer { public:
+
+    /** @brief Function that frees a retired object. */
+    typedef void (*Deleter)(void *object, void *user_data);
+
+    inline EpochReclaimer();
+    ~EpochReclaimer();
+
+    inline void initialize(Master *master);
+    inline Master *master() const;
+
+    void retire(void *object, Deleter deleter, void *user_data = 0);
+    template <typename T> inline void retire(T *object);
+
+    int reclaim();
+    void reclaim_all();
+
+    inline int size() const;
+
+    void swap(EpochReclaimer &x);
+
+  private:
+
+    struct Retired {
+	uint32_t epoch;
+	void *object;
+	Deleter deleter;
+	void *user_data;
+    };
+
+    Master *_master;
+    Vector<Retired> _retired;
+    int _head;
+
+    template <typename T> static void delete_object(void *object, void *);
+
+    EpochReclaimer(const EpochReclaimer &);
+    EpochReclaimer &operator=(const EpochReclaimer &);
+
+};
+
+/** @brief Construct an EpochReclaimer.
+ *
+ * Until initialize() is called, retired objects are freed by the next
+ * reclaim(), as if no thread were running. */
+inline
+EpochReclaimer::EpochReclaimer()
+    : _master(0), _head(0)
+{
+}
+
+/** @brief Set the Master whose threads may read the table. */
+inline void
+EpochReclaimer::initialize(Master *master)
+{
+    _master = master;
+}
+
+/** @brief Return the Master set by initialize(), or null. */
+inline Master *
+EpochReclaimer::master() const
+{
+    return _master;
+}
+
+/** @brief Retire @a object, which will be freed with delete. */
+template <typename T> inline void
+EpochReclaimer::retire(T *object)
+{
+    retire(object, delete_object<T>, 0);
+}
+
+/** @brief Return the number of retired objects not yet freed. */
+inline int
+EpochReclaimer::size() const
+{
+    return _retired.size() - _head;
+}
+
+template <typename T> void
+EpochReclaimer::delete_object(void *object, void *)
+{
+    delete static_cast<T *>(object);
+}
+
+CLICK_ENDDECLS
+#endif
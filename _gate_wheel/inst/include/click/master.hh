@@ -0,0 +1,287 @@
+// -*- c-basic-offset: 4; related-file-name: "../../lib/master.cc" -*-
+#ifndef CLICK_MASTER_HH
+#define CLICK_MASTER_HH
+#include <click/router.hh>
+#include <click/atomic.hh>
+#if CLICK_USERLEVEL
+# include <unistd.h>
+# include <signal.h>
+#endif
+#if CLICK_NS
+# include <click/simclick.h>
+#endif
+CLICK_DECLS
+
+#define CLICK_DEBUG_MASTER 0
+
+class Master { public:
+
+    Master(int nthreads);
+    ~Master();
+
+    void use();
+    void unuse();
+
+    void pause();
+    inline void unpause();
+    inline bool paused() const;
+
+    inline int nthreads() const;
+    inline RouterThread* thread(int id) const;
+
+    const volatile int* stopper_ptr() const	{ return &_stopper; }
+
+    inline unsigned max_timer_stride() const;
+    void set_max_timer_stride(unsigned timer_stride);
+
+    inline uint32_t epoch() const;
+    uint32_t advance_epoch();
+    uint32_t oldest_epoch() const;
+
+#if CLICK_USERLEVEL
+    int add_signal_handler(int signo, Router *router, String handler);
+    int remove_signal_handler(int signo, Router *router, String handler);
+#endif
+
+    void kill_router(Router*);
+
+#if CLICK_NS
+    void initialize_ns(simclick_node_t *simnode);
+    simclick_node_t *simnode() const		{ return _simnode; }
+#endif
+
+#if CLICK_DEBUG_MASTER || CLICK_DEBUG_SCHEDULING
+    String info() const;
+#endif
+
+#if CLICK_USERLEVEL
+    static volatile sig_atomic_t signals_pending;
+#endif
+
+  private:
+
+#if CLICK_LINUXMODULE
+    spinlock_t _master_lock;
+    struct task_struct *_master_lock_task;
+    int _master_lock_count;
+#elif HAVE_MULTITHREAD
+    Spinlock _master_lock;
+#endif
+    atomic_uint32_t _master_paused;
+    inline void lock_master();
+    inline void unlock_master();
+
+    // ROUTERS
+    Router* _routers;
+    int _refcount;
+    void register_router(Router*);
+    void prepare_router(Router*);
+    void run_router(Router*, bool foreground);
+    void unregister_router(Router*);
+
+    // THREADS
+    Vector<RouterThread*> _threads;
+
+    // DRIVERMANAGER
+    volatile int _stopper;
+    inline void set_stopper(int);
+    bool check_driver();
+
+    // EPOCHS
+    atomic_uint32_t _epoch;
+    static inline void epoch_fence();
+    inline void epoch_quiescent(RouterThread *thread);
+    inline void epoch_offline(RouterThread *thread);
+
+#if CLICK_USERLEVEL
+    // SIGNALS
+    struct SignalInfo {
+	int signo;
+	Router *router;
+	String handler;
+	SignalInfo *next;
+	SignalInfo(int signo_, Router *router_, const String &handler_)
+	    : signo(signo_), router(router_), handler(handler_), next() {
+	}
+	bool equals(int signo_, Router *router_, const String &handler_) const {
+	    return signo == signo_ && router == router_ && handler == handler_;
+	}
+    };
+    SignalInfo *_siginfo;
+    sigset_t _sig_dispatching;
+    Spinlock _signal_lock;
+    void process_signals(RouterThread *thread);
+    inline void run_signals(RouterThread *thread);
+#endif
+
+#if CLICK_NS
+    simclick_node_t *_simnode;
+#endif
+
+    Master(const Master&);
+    Master& operator=(const Master&);
+
+    friend class Task;
+    friend class Timer;
+    friend class RouterThread;
+    friend class Router;
+#if CLICK_USERLEVEL
+    friend class SelectSet;
+#endif
+
+};
+
+inline int
+Master::nthreads() const
+{
+    return _threads.size() - 2;
+}
+
+inline RouterThread*
+Master::thread(int id) const
+{
+    // return the requested thread, or the quiescent thread if there's no such
+    // thread
+    if ((unsigned)(id + 2) < (unsigned)_threads.size())
+	return _threads.at_u(id + 2);
+    else
+	return _threads.at_u(1);
+}
+
+#if CLICK_USERLEVEL
+inline void
+Master::run_signals(RouterThread *thread)
+{
+# if HAVE_MULTITHREAD
+    if (thread->_wake_pipe_pending || signals_pending)
+	process_signals(thread);
+# else
+    if (signals_pending)
+	process_signals(thread);
+# endif
+}
+#endif
+
+inline void
+Master::set_stopper(int s)
+{
+    _stopper = s;
+}
+
+/** @brief Return the current epoch.
+ *
+ * Epochs let tables free objects that lock-free readers might still be
+ * using.  A writer that unlinks an object calls advance_epoch() and tags
+ * the object with the result.  Each thread records the current epoch
+ * whenever it is between elements, which is a quiescent point: it can hold
+ * no references into element state.  Once oldest_epoch() has reached an
+ * object's tag, every thread has passed a quiescent point since the object
+ * was unlinked, so the object can be freed.  EpochReclaimer implements this
+ * protocol.
+ *
+ * Epochs are never zero. */
+inline uint32_t
+Master::epoch() const
+{
+    return _epoch.value();
+}
+
+inline void
+Master::epoch_fence()
+{
+#if CLICK_LINUXMODULE
+    smp_mb();
+#elif HAVE___SYNC_SYNCHRONIZE
+    __sync_synchronize();
+#else
+    __asm__ volatile("" : : : "memory");
+#endif
+}
+
+inline void
+Master::epoch_quiescent(RouterThread *thread)
+{
+    // Readers pay only this load and comparison: the epoch changes only
+    // when a writer retires an object.  When it changes, order this
+    // thread's earlier reads before the store, and the store before its
+    // later reads.
+    uint32_t e = _epoch.value();
+    if (thread->_epoch != e) {
+	epoch_fence();
+	thread->_epoch = e;
+	epoch_fence();
+    }
+}
+
+inline void
+Master::epoch_offline(RouterThread *thread)
+{
+    // Called when thread stops running element code, such as before it
+    // blocks.  An offline thread never delays reclamation.
+    epoch_fence();
+    thread->_epoch = 0;
+}
+
+inline void
+Master::lock_master()
+{
+#if CLICK_LINUXMODULE
+    if (current != _master_lock_task) {
+	spin_lock(&_master_lock);
+	_master_lock_task = current;
+    } else
+	_master_lock_count++;
+#elif HAVE_MULTITHREAD
+    _master_lock.acquire();
+#endif
+}
+
+inline void
+Master::unlock_master()
+{
+#if CLICK_LINUXMODULE
+    assert(current == _master_lock_task);
+    if (_master_lock_count == 0) {
+	_master_lock_task = 0;
+	spin_unlock(&_master_lock);
+    } else
+	_master_lock_count--;
+#elif HAVE_MULTITHREAD
+    _master_lock.release();
+#endif
+}
+
+inline void
+Master::unpause()
+{
+    _master_paused--;
+}
+
+/** @brief Return true iff the master is paused.
+ *
+ * While paused, threads run no timers, selects, or pending task
+ * operations. */
+inline bool
+Master::paused() const
+{
+    return _master_paused > 0;
+}
+
+/** @brief Return the maximum timer stride.
+ *
+ * All threads share the same maximum stride; see
+ * set_max_timer_stride(). */
+inline unsigned
+Master::max_timer_stride() const
+{
+    return thread(0)->timer_set().max_timer_stride();
+}
+
+inline Master *
+Element::master() const
+{
+    return _router->master();
+}
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,45 @@
+# pkg-config.mk -- build tools for Click
+# Eddie Kohler
+#
+# Copyright (c) 2006 Regents of the University of California
+# Copyright (c) 2008 Meraki, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, subject to the conditions
+# listed in the Click LICENSE file. These conditions include: you must
+# preserve this copyright notice, and you cannot mention the copyright
+# holders in advertising related to the Software without their permission.
+# The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+# notice is a summary of the Click LICENSE file; the license in that file is
+# legally binding.
+
+CLICKCC = gcc -W -Wall
+CLICKCPP = gcc -E
+CLICKCXX = g++ -W -Wall 
+CLICKCXXCPP = g++ -W -Wall  -E
+
+CLICKAR_CREATE = ar cru
+CLICKRANLIB = ranlib
+CLICKSTRIP = strip
+
+CLICKKERNEL_CC = gcc -w -W -Wall
+CLICKKERNEL_CXX = g++ -w -W -Wall -fno-exceptions -fno-rtti  -fpermissive
+CLICKLINUX_MAKEARGS = 
+
+CLICKCPPFLAGS = 
+CLICKCFLAGS = -O2 -g -w
+CLICKCFLAGS_NDEBUG = -O2  -w
+CLICKCXXFLAGS = -std=gnu++98 -O2 -g -fpermissive -w -include stddef.h -include linux/sockios.h
+CLICKCXXFLAGS_NDEBUG = -std=gnu++98 -O2  -fpermissive -w -include stddef.h -include linux/sockios.h
+CLICKDEPCFLAGS = -MD -MP
+
+CLICKDEFS = -DHAVE_CONFIG_H
+CLICKINCLUDES = -I$(clickincludedir) -I$(clicksrcdir) 
+CLICKLDFLAGS = 
+CLICKLDMODULEFLAGS = -shared
+
+CLICKAUTOCONF = autoconf
+CLICKGMAKE = make
+CLICKINSTALL = /usr/bin/install -c
+
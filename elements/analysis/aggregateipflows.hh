@@ -3,7 +3,7 @@
 #define CLICK_AGGREGATEIPFLOWS_HH
 #include <click/element.hh>
 #include <click/ipflowid.hh>
-#include <click/hashtable.hh>
+#include <click/flowhashtable.hh>
 #include "aggregatenotifier.hh"
 CLICK_DECLS
 class HandlerCall;
@@ -208,7 +208,12 @@ class AggregateIPFlows : public Element, public AggregateNotifier { public:
 	FlowInfo *find_force(uint32_t ports);
     };
 
-    typedef HashTable<HostPair, HostPairInfo> Map;
+    // Each packet costs one Map lookup.  A host pair's flows hang off its
+    // HostPairInfo in a move-to-front list, not in a table of their own:
+    // most pairs have one flow, the fragment and reaping code work a host
+    // pair at a time, and inline table slots would make every FlowInfo as
+    // large as a StatFlowInfo.
+    typedef FlowHashTable<HostPair, HostPairInfo> Map;
     Map _tcp_map;
     Map _udp_map;
 
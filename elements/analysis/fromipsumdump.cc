@@ -73,7 +73,8 @@ FromIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
     bool stop = false, active = true, zero = true, checksum = false, multipacket = false, timing = false;
     uint8_t default_proto = IP_PROTO_TCP;
     _sampling_prob = (1 << SAMPLING_SHIFT);
-    String default_contents, default_flowid;
+    bool have_start = false, have_end = false;
+    String default_contents, default_flowid, ignore;
 
     if (cp_va_kparse(conf, this, errh,
 		     "FILENAME", cpkP+cpkM, cpFilename, &_ff.filename(),
@@ -89,6 +90,9 @@ FromIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
 		     "DEFAULT_FLOWID", 0, cpArgument, &default_flowid,
 		     "CONTENTS", 0, cpArgument, &default_contents,
 		     "FLOWID", 0, cpArgument, &default_flowid,
+		     "IGNORE", 0, cpArgument, &ignore,
+		     "START", cpkC, &have_start, cpTimestamp, &_start,
+		     "END", cpkC, &have_end, cpTimestamp, &_end,
 		     cpEnd) < 0)
 	return -1;
     if (_sampling_prob > (1 << SAMPLING_SHIFT)) {
@@ -105,7 +109,22 @@ FromIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
     _timing = timing;
     _have_timing = false;
     _multipacket = multipacket;
-    _have_flowid = _have_aggregate = _binary = false;
+    _have_flowid = _have_aggregate = _binary = _columnar = false;
+    _have_start = have_start;
+    _have_end = have_end;
+    _time_field = -1;
+    _block_count = _block_pos = 0;
+
+    Vector<String> words;
+    cp_spacevec(ignore, words);
+    for (String *w = words.begin(); w != words.end(); ++w) {
+	const IPSummaryDump::FieldReader *f = IPSummaryDump::FieldReader::find(cp_unquote(*w));
+	if (!f)
+	    errh->error("unknown content type '%s'", w->c_str());
+	else
+	    _ignore.push_back(f);
+    }
+
     if (default_contents)
 	bang_data(default_contents, errh);
     if (default_flowid)
@@ -215,6 +234,7 @@ FromIPSummaryDump::bang_data(const String &line, ErrorHandler *errh)
 
     _fields.clear();
     _field_order.clear();
+    _time_field = -1;
     for (int i = 0; i < words.size(); i++) {
 	String word = cp_unquote(words[i]);
 	if (i == 0 && (word == "!data" || word == "!contents"))
@@ -223,10 +243,16 @@ FromIPSummaryDump::bang_data(const String &line, ErrorHandler *errh)
 	if (!f) {
 	    _ff.warning(errh, "unknown content type '%s'", word.c_str());
 	    f = &IPSummaryDump::null_reader;
-	} else if (!f->inject) {
+	} else if (find(_ignore.begin(), _ignore.end(), f) != _ignore.end())
+	    f = &IPSummaryDump::null_reader;
+	else if (!f->inject) {
 	    _ff.warning(errh, "content type '%s' ignored on input", word.c_str());
 	    f = &IPSummaryDump::null_reader;
 	}
+	if (strcmp(f->name, "timestamp") == 0 || strcmp(f->name, "ntimestamp") == 0) {
+	    _time_field = _fields.size();
+	    _time_nsec = (f->name[0] == 'n');
+	}
 	_fields.push_back(f);
 	_field_order.push_back(_fields.size() - 1);
     }
@@ -305,12 +331,69 @@ FromIPSummaryDump::bang_binary(const String &line, ErrorHandler *errh)
     Vector<String> words;
     cp_spacevec(line, words);
     if (words.size() != 1)
-	_ff.error(errh, "bad !binary specification");
+	_ff.error(errh, "bad %s specification", words[0].c_str());
     _binary = true;
+    _columnar = (words[0] == "!columnar");
     _ff.set_landmark_pattern("%f:record %l");
     _ff.set_lineno(1);
 }
 
+inline Timestamp
+FromIPSummaryDump::column_timestamp(const uint8_t *s) const
+{
+    if (_time_nsec)
+	return Timestamp::make_nsec(GET4(s), GET4(s + 4));
+    else
+	return Timestamp::make_usec(GET4(s), GET4(s + 4));
+}
+
+void
+FromIPSummaryDump::read_block(const String &block, ErrorHandler *errh)
+{
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(block.data());
+    const uint8_t *end = s + block.length();
+    int n;
+    _block = block;
+    _block_count = _block_pos = 0;
+    if (end - s < 4)
+	goto bad;
+    n = GET4(s);
+    s += 4;
+
+    // find the columns
+    _columns.resize(_fields.size());
+    for (IPSummaryDump::Column *c = _columns.begin(); c != _columns.end(); ++c)
+	if (!(s = IPSummaryDump::parse_column(s, end, *c)))
+	    goto bad;
+
+    // skip blocks entirely outside START and END
+    if (_time_field >= 0 && (_have_start || _have_end)) {
+	const IPSummaryDump::Column &c = _columns[_time_field];
+	if (c.width == 8 && c.min
+	    && ((_have_start && column_timestamp(c.max) < _start)
+		|| (_have_end && column_timestamp(c.min) >= _end)))
+	    return;
+    }
+
+    // decode only the columns that affect packets
+    _column_base.assign(_fields.size(), 0);
+    _column_buf.resize(_fields.size());
+    _column_bounds.resize(_fields.size());
+    for (int i = 0; i < _fields.size(); ++i) {
+	const IPSummaryDump::FieldReader *f = _fields[i];
+	if (!f->inject || !f->inb
+	    || _columns[i].width != IPSummaryDump::column_width(f->type))
+	    continue;
+	if (!(_column_base[i] = IPSummaryDump::decode_column(_columns[i], n, _column_buf[i], _column_bounds[i])))
+	    goto bad;
+    }
+    _block_count = n;
+    return;
+
+  bad:
+    _ff.error(errh, "bad columnar block");
+}
+
 static void
 set_checksums(WritablePacket *q, click_ip *iph)
 {
@@ -348,11 +431,17 @@ FromIPSummaryDump::read_packet(ErrorHandler *errh)
     const char *end;
 
     while (1) {
-	if ((binary = _binary)) {
+	if (_block_pos < _block_count) {
+	    binary = true;
+	    break;
+	} else if ((binary = _binary)) {
 	    int result = read_binary(line, errh);
 	    if (result <= 0)
 		goto eof;
-	    else
+	    else if (result == 1 && _columnar) {
+		read_block(line, errh);
+		continue;
+	    } else
 		binary = (result == 1);
 	} else if (_ff.read_line(line, errh, true) <= 0) {
 	  eof:
@@ -381,6 +470,8 @@ FromIPSummaryDump::read_packet(ErrorHandler *errh)
 		bang_aggregate(line, errh);
 	    else if (data + 8 <= end && memcmp(data, "!binary", 7) == 0 && isspace((unsigned char) data[7]))
 		bang_binary(line, errh);
+	    else if (data + 10 <= end && memcmp(data, "!columnar", 9) == 0 && isspace((unsigned char) data[9]))
+		bang_binary(line, errh);
 	    else if (data + 10 <= end && memcmp(data, "!contents", 9) == 0 && isspace((unsigned char) data[9]))
 		bang_data(line, errh);
 	}
@@ -400,8 +491,30 @@ FromIPSummaryDump::read_packet(ErrorHandler *errh)
     IPSummaryDump::PacketOdesc d(this, q, _default_proto, (_have_flowid ? &_flowid : 0), _minor_version);
     int nfields = 0;
 
-    // new code goes here
-    if (_binary) {
+    if (_columnar) {
+	int row = _block_pos++;
+	for (int *fip = _field_order.begin();
+	     fip != _field_order.end() && d.p;
+	     ++fip) {
+	    const IPSummaryDump::FieldReader *f = _fields[*fip];
+	    const uint8_t *s = _column_base[*fip], *e;
+	    if (!s)
+		continue;
+	    if (_columns[*fip].width == IPSummaryDump::C_VARIABLE) {
+		e = s + _column_bounds[*fip][2*row + 1];
+		s += _column_bounds[*fip][2*row];
+	    } else {
+		s += row * _columns[*fip].width;
+		e = s + _columns[*fip].width;
+	    }
+	    d.clear_values();
+	    if (f->inb(d, s, e, f)) {
+		f->inject(d, f);
+		nfields++;
+	    }
+	}
+
+    } else if (_binary) {
 	Vector<const unsigned char *> args;
 	int nbytes;
 	for (const IPSummaryDump::FieldReader * const *fp = _fields.begin(); fp != _fields.end(); ++fp) {
@@ -560,6 +673,13 @@ FromIPSummaryDump::read_packet(ErrorHandler *errh)
     if (d.p && d.want_len > d.p->length())
 	SET_EXTRA_LENGTH_ANNO(d.p, d.want_len - d.p->length());
 
+    // drop packets outside START and END
+    if (d.p && ((_have_start && d.p->timestamp_anno() < _start)
+		|| (_have_end && d.p->timestamp_anno() >= _end))) {
+	d.p->kill();
+	d.p = 0;
+    }
+
     return d.p;
 }
 
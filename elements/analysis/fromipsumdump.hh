@@ -13,7 +13,7 @@ CLICK_DECLS
 /*
 =c
 
-FromIPSummaryDump(FILENAME [, I<keywords> STOP, TIMING, ACTIVE, ZERO, CHECKSUM, PROTO, MULTIPACKET, SAMPLE, CONTENTS, FLOWID])
+FromIPSummaryDump(FILENAME [, I<keywords> STOP, TIMING, ACTIVE, ZERO, CHECKSUM, PROTO, MULTIPACKET, SAMPLE, CONTENTS, FLOWID, IGNORE, START, END])
 
 =s traces
 
@@ -28,6 +28,12 @@ output. Optionally stops the driver when there are no more packets.
 The file may be compressed with gzip(1) or bzip2(1); FromIPSummaryDump will
 run zcat(1) or bzcat(1) to uncompress it.
 
+FromIPSummaryDump reads ASCII, BINARY, and COLUMNAR dumps (see
+ToIPSummaryDump).  COLUMNAR dumps are fastest to read: FromIPSummaryDump
+decodes each column of a block at once, never decodes columns for IGNOREd or
+unknown fields, and skips blocks whose timestamps lie outside START and END
+without decoding them.
+
 FromIPSummaryDump reads from the file named FILENAME unless FILENAME is a
 single dash 'C<->', in which case it reads from the standard input. It will
 not uncompress the standard input, however.
@@ -100,6 +106,22 @@ destination address, destination port, and, optionally, protocol). Defines the
 IP addresses and ports used by default. Any flow information in the input file
 will override this setting.
 
+=item IGNORE
+
+String, containing a space-separated list of content names. FromIPSummaryDump
+leaves these fields out of generated packets, as if the dump did not contain
+them.
+
+=item START
+
+Timestamp. If set, FromIPSummaryDump leaves out packets with earlier
+timestamps.
+
+=item END
+
+Timestamp. If set, FromIPSummaryDump leaves out packets with timestamps
+at or after END.
+
 =back
 
 Only available in user-level processes.
@@ -187,6 +209,10 @@ class FromIPSummaryDump : public Element, public IPSummaryDumpInfo { public:
     bool _binary : 1;
     bool _timing : 1;
     bool _have_timing : 1;
+    bool _columnar : 1;
+    bool _have_start : 1;
+    bool _have_end : 1;
+    bool _time_nsec : 1;
     Packet *_work_packet;
     uint32_t _multipacket_length;
     Timestamp _multipacket_timestamp_delta;
@@ -200,7 +226,22 @@ class FromIPSummaryDump : public Element, public IPSummaryDumpInfo { public:
     int _minor_version;
     IPFlowID _given_flowid;
 
+    Timestamp _start;
+    Timestamp _end;
+    Vector<const IPSummaryDump::FieldReader *> _ignore;
+    int _time_field;
+
+    String _block;
+    int _block_count;
+    int _block_pos;
+    Vector<IPSummaryDump::Column> _columns;
+    Vector<const uint8_t *> _column_base;
+    Vector<StringAccum> _column_buf;
+    Vector<Vector<uint32_t> > _column_bounds;
+
     int read_binary(String &, ErrorHandler *);
+    void read_block(const String &, ErrorHandler *);
+    inline Timestamp column_timestamp(const uint8_t *) const;
 
     static int sort_fields_compare(const void *, const void *, void *);
     void bang_data(const String &, ErrorHandler *);
@@ -507,6 +507,184 @@ const uint8_t tcp_flag_mapping[256] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0  // 0xF-
 };
 
+
+/////////////////////
+// COLUMNAR FORMAT
+
+int column_width(int type)
+{
+    switch (type) {
+      case B_0:
+      case B_1:
+      case B_2:
+      case B_4:
+      case B_6PTR:
+      case B_8:
+      case B_16:
+	return type;
+      case B_4NET:
+	return 4;
+      default:
+	return C_VARIABLE;
+    }
+}
+
+static inline bool delta_width(int width)
+{
+    return width == 1 || width == 2 || width == 4 || width == 8;
+}
+
+static inline uint32_t get_lane(const uint8_t *s, int lb)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < lb; ++i)
+	v = (v << 8) | s[i];
+    return v;
+}
+
+static inline void put_lane(uint8_t *s, int lb, uint32_t v)
+{
+    for (int i = lb - 1; i >= 0; --i, v >>= 8)
+	s[i] = v;
+}
+
+static inline uint8_t *put_varint(uint8_t *s, uint32_t v)
+{
+    while (v >= 0x80) {
+	*s++ = v | 0x80;
+	v >>= 7;
+    }
+    *s++ = v;
+    return s;
+}
+
+static inline const uint8_t *get_varint(const uint8_t *s, const uint8_t *end, uint32_t &v)
+{
+    v = 0;
+    for (int shift = 0; s < end && shift < 35; shift += 7) {
+	v |= (uint32_t) (*s & 0x7F) << shift;
+	if (!(*s++ & 0x80))
+	    return s;
+    }
+    return 0;
+}
+
+void append_variable(StringAccum &column, const char *s, int len)
+{
+    uint8_t *out = (uint8_t *) column.reserve(len + 5);
+    uint8_t *x = put_varint(out, len);
+    memcpy(x, s, len);
+    column.adjust_length(x - out + len);
+}
+
+void encode_column(StringAccum &sa, const uint8_t *v, int len, int n, int width)
+{
+    int hpos = sa.length();
+    sa.extend(6);
+    if (width >= 1 && width <= 8 && n) {
+	const uint8_t *min = v, *max = v;
+	for (const uint8_t *x = v + width; x < v + len; x += width)
+	    if (memcmp(x, min, width) < 0)
+		min = x;
+	    else if (memcmp(x, max, width) > 0)
+		max = x;
+	sa.append(reinterpret_cast<const char *>(min), width);
+	sa.append(reinterpret_cast<const char *>(max), width);
+    }
+
+    // Store each value as the zigzag varint of its difference from the
+    // previous value, lane by lane, unless the raw values are smaller.
+    int dpos = sa.length(), coding = C_RAW;
+    if (delta_width(width)) {
+	int lb = (width == 8 ? 4 : width), shift = 32 - 8 * lb;
+	uint32_t prev[2] = { 0, 0 };
+	uint8_t *start = (uint8_t *) sa.reserve(n * (width / lb) * 5);
+	uint8_t *out = start;
+	for (const uint8_t *x = v; x < v + len; x += lb) {
+	    int lane = (x - v) % width ? 1 : 0;
+	    uint32_t y = get_lane(x, lb);
+	    int32_t d = (int32_t) ((y - prev[lane]) << shift) >> shift;
+	    prev[lane] = y;
+	    out = put_varint(out, ((uint32_t) d << 1) ^ (uint32_t) (d >> 31));
+	}
+	if (out - start < len) {
+	    sa.adjust_length(out - start);
+	    coding = C_DELTA;
+	}
+    }
+    if (coding == C_RAW)
+	sa.append(reinterpret_cast<const char *>(v), len);
+
+    uint8_t *h = (uint8_t *) sa.data() + hpos;
+    uint32_t dlen = sa.length() - dpos;
+    h[0] = coding;
+    h[1] = width;
+    put_lane(h + 2, 4, dlen);
+}
+
+const uint8_t *parse_column(const uint8_t *s, const uint8_t *end, Column &c)
+{
+    if (end - s < 6)
+	return 0;
+    c.coding = s[0];
+    c.width = s[1];
+    uint32_t dlen = get_lane(s + 2, 4);
+    s += 6;
+    if (c.width >= 1 && c.width <= 8) {
+	if (end - s < 2 * c.width)
+	    return 0;
+	c.min = s;
+	c.max = s + c.width;
+	s += 2 * c.width;
+    } else
+	c.min = c.max = 0;
+    if ((uint32_t) (end - s) < dlen
+	|| (c.coding == C_DELTA && !delta_width(c.width))
+	|| c.coding > C_DELTA)
+	return 0;
+    c.data = s;
+    c.end = s + dlen;
+    return c.end;
+}
+
+const uint8_t *decode_column(const Column &c, int n, StringAccum &buf, Vector<uint32_t> &bounds)
+{
+    if (c.width == C_VARIABLE) {
+	// values are prefixed by their lengths; record where each lies
+	bounds.resize(2 * n);
+	const uint8_t *s = c.data;
+	for (int i = 0; i < n; ++i) {
+	    uint32_t vlen;
+	    if (!(s = get_varint(s, c.end, vlen)) || (uint32_t) (c.end - s) < vlen)
+		return 0;
+	    bounds[2*i] = s - c.data;
+	    bounds[2*i + 1] = s - c.data + vlen;
+	    s += vlen;
+	}
+	return c.data;
+    } else if (c.coding == C_RAW)
+	return (c.end - c.data == n * c.width ? c.data : 0);
+
+    buf.clear();
+    uint8_t *out = (uint8_t *) buf.extend(n * c.width);
+    uint8_t *oend = out + n * c.width;
+    const uint8_t *s = c.data;
+    int lb = (c.width == 8 ? 4 : c.width), lanes = c.width / lb;
+    uint32_t mask = (lb == 4 ? 0xFFFFFFFFU : (1U << (8 * lb)) - 1);
+    uint32_t prev[2] = { 0, 0 };
+    for (; out < oend; out += c.width)
+	for (int lane = 0; lane < lanes; ++lane) {
+	    uint32_t z;
+	    if (s < c.end && *s < 0x80)	// common case: small difference
+		z = *s++;
+	    else if (!(s = get_varint(s, c.end, z)))
+		return 0;
+	    prev[lane] = (prev[lane] + ((z >> 1) ^ -(z & 1))) & mask;
+	    put_lane(out + lane * lb, lb, prev[lane]);
+	}
+    return (s == c.end ? (const uint8_t *) buf.data() : 0);
+}
+
 }
 
 ELEMENT_REQUIRES(userlevel)
@@ -3,6 +3,7 @@
 #define CLICK_IPSUMDUMPINFO_HH
 #include <click/string.hh>
 #include <click/straccum.hh>
+#include <click/vector.hh>
 #include <click/packet.hh>
 CLICK_DECLS
 class Element;
@@ -135,6 +136,28 @@ struct FieldSynonym {
     static void remove(const FieldSynonym *);
 };
 
+// Columnar files store blocks of up to COLUMNAR_BLOCK packets, one column
+// per field; see ToIPSummaryDump's documentation.
+enum { COLUMNAR_BLOCK = 4096,
+       C_RAW = 0,
+       C_DELTA = 1,
+       C_VARIABLE = 255 };
+
+struct Column {
+    int coding;
+    int width;			// bytes per value, or C_VARIABLE
+    const uint8_t *min;		// smallest and largest value in the block,
+    const uint8_t *max;		// or null
+    const uint8_t *data;
+    const uint8_t *end;
+};
+
+int column_width(int type);
+void append_variable(StringAccum &column, const char *s, int len);
+void encode_column(StringAccum &sa, const uint8_t *values, int len, int n, int width);
+const uint8_t *parse_column(const uint8_t *s, const uint8_t *end, Column &c);
+const uint8_t *decode_column(const Column &c, int n, StringAccum &buf, Vector<uint32_t> &bounds);
+
 extern const FieldReader null_reader;
 extern const FieldWriter null_writer;
 
@@ -23,13 +23,18 @@
 #include <click/standard/scheduleinfo.hh>
 #include <click/confparse.hh>
 #include <click/router.hh>
+#include <click/algorithm.hh>
 CLICK_DECLS
 
 TimeSortedSched::TimeSortedSched()
-    : _pkt(0), _npkt(0), _input(0), _nready(0),
-      _notifier(Notifier::SEARCH_CONTINUE_WAKE), _buffer(1),
+    : _input(0), _pkt(0), _ninput(0), _ready(0), _nready(0), _tree(0),
+      _notifier(Notifier::SEARCH_CONTINUE_WAKE), _buffer(1), _batch(1),
       _well_ordered(true)
 {
+#if CLICK_TIMESORTEDSCHED_THREADS
+    _nthreads = 0;
+    _workers = 0;
+#endif
 }
 
 TimeSortedSched::~TimeSortedSched()
@@ -50,80 +55,196 @@ TimeSortedSched::configure(Vector<String> &conf, ErrorHandler *errh)
 {
     _notifier.initialize(Notifier::EMPTY_NOTIFIER, router());
     _stop = false;
+    int nthreads = 0;
+    uint32_t prefetch = 256;
     if (cp_va_kparse(conf, this, errh,
 		     "STOP", 0, cpBool, &_stop,
 		     "BUFFER", 0, cpInteger, &_buffer,
+		     "BATCH", 0, cpInteger, &_batch,
+		     "THREADS", 0, cpInteger, &nthreads,
+		     "PREFETCH", 0, cpUnsigned, &prefetch,
 		     cpEnd) < 0)
 	return -1;
     if (_buffer <= 0)
 	return errh->error("BUFFER must be at least 1");
+    if (_batch <= 0)
+	return errh->error("BATCH must be at least 1");
+#if CLICK_TIMESORTEDSCHED_THREADS
+    if (nthreads < 0)
+	return errh->error("THREADS must be at least 0");
+    if (prefetch == 0)
+	return errh->error("PREFETCH must be at least 1");
+    _nthreads = nthreads;
+    _prefetch = prefetch;
+#else
+    if (nthreads > 0)
+	return errh->error("THREADS requires a multithreaded user-level driver");
+#endif
     return 0;
 }
 
 int
 TimeSortedSched::initialize(ErrorHandler *errh)
 {
-    _pkt = new packet_s[ninputs() * _buffer];
-    _input = new input_s[ninputs()];
-    if (!_pkt || !_input)
+    _ninput = ninputs();
+    int capacity = (_buffer > _batch ? _buffer : _batch);
+    _pkt = new Packet *[_ninput * capacity];
+    _input = new input_s[_ninput];
+    _ready = new int[_ninput];
+    _tree = new int[_ninput ? _ninput : 1];
+    if (!_pkt || !_input || !_ready || !_tree)
 	return errh->error("out of memory!");
-    for (int i = 0; i < ninputs(); i++) {
+    for (int i = 0; i < _ninput; i++) {
 	_input[i].signal = Notifier::upstream_empty_signal(this, i, 0, &_notifier);
-	_input[i].space = _buffer;
-	_input[i].ready = i;
+	_input[i].pkt = _pkt + i * capacity;
+	_input[i].npkt = 0;
+	_ready[i] = i;
     }
-    _nready = ninputs();
+    _nready = _ninput;
+    build_tree();
+#if CLICK_TIMESORTEDSCHED_THREADS
+    if (_nthreads > 0 && _ninput > 0)
+	init_workers();
+#endif
     return 0;
 }
 
 void
 TimeSortedSched::cleanup(CleanupStage)
 {
-    for (int i = 0; i < _npkt; ++i)
-	_pkt[i].p->kill();
+#if CLICK_TIMESORTEDSCHED_THREADS
+    stop_workers();
+#endif
+    if (_input)
+	for (int i = 0; i < _ninput; ++i)
+	    for (int j = 0; j < _input[i].npkt; ++j)
+		_input[i].pkt[j]->kill();
     delete[] _pkt;
     delete[] _input;
+    delete[] _ready;
+    delete[] _tree;
+    _input = 0;
+}
+
+inline bool
+TimeSortedSched::earlier(int a, int b) const
+{
+    // Inputs without packets lose to inputs with packets; ties go to the
+    // lower-numbered input.
+    const input_s &ia = _input[a], &ib = _input[b];
+    if (!ia.npkt || !ib.npkt)
+	return ia.npkt ? true : (ib.npkt ? false : a < b);
+    const Timestamp &ta = ia.pkt[0]->timestamp_anno();
+    const Timestamp &tb = ib.pkt[0]->timestamp_anno();
+    return ta < tb || (ta == tb && a < b);
+}
+
+inline int
+TimeSortedSched::match(int k) const
+{
+    // Node k's children are 2k and 2k + 1; leaf i sits at _ninput + i.
+    int a = (2*k >= _ninput ? 2*k - _ninput : _tree[2*k]);
+    int b = (2*k + 1 >= _ninput ? 2*k + 1 - _ninput : _tree[2*k + 1]);
+    return earlier(b, a) ? b : a;
+}
+
+void
+TimeSortedSched::build_tree()
+{
+    // Each internal node holds the winner of its subtree, so a change to
+    // any input, not just the winning one, takes O(log N) comparisons.
+    for (int k = _ninput - 1; k > 0; --k)
+	_tree[k] = match(k);
+    _tree[0] = (_ninput > 1 ? _tree[1] : 0);
+}
+
+void
+TimeSortedSched::replay(int i)
+{
+    // Input i's earliest packet changed: replay its matches to the root.
+    for (int k = (_ninput + i) >> 1; k > 0; k >>= 1)
+	_tree[k] = match(k);
+    _tree[0] = (_ninput > 1 ? _tree[1] : 0);
+}
+
+bool
+TimeSortedSched::fill(int i, bool &live)
+{
+    input_s &in = _input[i];
+    Packet *head = (in.npkt ? in.pkt[0] : 0);
+    int capacity = (_buffer > _batch ? _buffer : _batch);
+#if CLICK_TIMESORTEDSCHED_THREADS
+    if (_nthreads > 0) {
+	// Read the worker's live flag before its ring, so a false flag
+	// means every packet it will ever prefetch is already visible.
+	bool more = in.live;
+	click_order_fence();
+	uint32_t ring_head = in.ring_head, tail = in.ring_tail;
+	click_order_fence();
+	while (in.npkt < capacity && ring_head != tail) {
+	    in.pkt[in.npkt++] = in.ring[ring_head & _ring_mask];
+	    push_heap(in.pkt, in.pkt + in.npkt, packet_compare());
+	    ++ring_head;
+	}
+	if (ring_head != in.ring_head) {
+	    click_order_fence();
+	    in.ring_head = ring_head;
+	    wake_worker(i);
+	}
+	live = more || ring_head != tail;
+    } else
+#endif
+    if ((live = in.signal))
+	while (in.npkt < capacity) {
+	    Packet *p = input(i).pull();
+	    if (!p)
+		break;
+	    in.pkt[in.npkt++] = p;
+	    push_heap(in.pkt, in.pkt + in.npkt, packet_compare());
+	}
+    return in.npkt && in.pkt[0] != head;
 }
 
 Packet*
 TimeSortedSched::pull(int)
 {
-    bool signals_on = false;
-    // first maybe fill in buffer
+    bool signals_on = false, wait = false;
+#if CLICK_TIMESORTEDSCHED_THREADS
+    if (_nthreads > 0 && !_workers_started && !start_workers())
+	return 0;
+#endif
+    // first maybe fill in buffers
     for (int rpos = _nready - 1; rpos >= 0; --rpos) {
-	int i = _input[rpos].ready;
-	input_s &is = _input[i];
-	if (is.signal) {
-	    signals_on = true;
-	    while ((_pkt[_npkt].p = input(i).pull())) {
-		_pkt[_npkt].input = i;
-		++_npkt;
-		push_heap(_pkt, _pkt + _npkt, packet_s::compare);
-		--is.space;
-		if (!is.space) {
-		    _input[rpos].ready = _input[_nready - 1].ready;
-		    --_nready;
-		    break;
-		}
-	    }
-	}
+	int i = _ready[rpos];
+	bool live;
+	if (fill(i, live))
+	    replay(i);
+	signals_on = signals_on || live;
+	// with worker threads, wait for inputs that may still have packets
+	wait = wait || (live && !_input[i].npkt);
+	if (_input[i].npkt >= _buffer)
+	    _ready[rpos] = _ready[--_nready];
     }
+#if CLICK_TIMESORTEDSCHED_THREADS
+    if (_nthreads > 0 && wait) {
+	_notifier.set_active(true);
+	return 0;
+    }
+#endif
 
     // then maybe emit a packet
-    _notifier.set_active(_npkt > 0 || signals_on);
-    if (_npkt > 0) {
-	Packet *p = _pkt[0].p;
+    input_s *in = (_ninput ? &_input[_tree[0]] : 0);
+    _notifier.set_active((in && in->npkt > 0) || signals_on);
+    if (in && in->npkt > 0) {
+	Packet *p = in->pkt[0];
 	if (_last_emission && p->timestamp_anno() < _last_emission)
 	    _well_ordered = false;
 	_last_emission = p->timestamp_anno();
-	input_s &is = _input[_pkt[0].input];
-	++is.space;
-	if (is.space == 1) {
-	    _input[_nready].ready = _pkt[0].input;
-	    ++_nready;
-	}
-	pop_heap(_pkt, _pkt + _npkt, packet_s::compare);
-	--_npkt;
+	pop_heap(in->pkt, in->pkt + in->npkt, packet_compare());
+	--in->npkt;
+	if (in->npkt == _buffer - 1)
+	    _ready[_nready++] = _tree[0];
+	replay(_tree[0]);
 	return p;
     } else {
 	if (_stop && !signals_on)
@@ -132,6 +253,160 @@ TimeSortedSched::pull(int)
     }
 }
 
+#if CLICK_TIMESORTEDSCHED_THREADS
+extern "C" {
+static void *timesortedsched_worker_thread(void *arg)
+{
+    return TimeSortedSched::worker_thread(arg);
+}
+}
+
+void
+TimeSortedSched::init_workers()
+{
+    uint32_t capacity = 2;
+    while (capacity < _prefetch)
+	capacity *= 2;
+    _ring_mask = capacity - 1;
+    for (int i = 0; i < _ninput; ++i) {
+	_input[i].ring = new Packet *[capacity];
+	_input[i].ring_head = _input[i].ring_tail = 0;
+	_input[i].live = true;
+    }
+
+    if (_nthreads > _ninput)
+	_nthreads = _ninput;
+    _workers = new worker_s[_nthreads];
+    _workers_stop = false;
+    for (int t = 0; t < _nthreads; ++t) {
+	worker_s &w = _workers[t];
+	w.tss = this;
+	w.id = t;
+	w.sleeping = 0;
+	w.started = false;
+	pthread_mutex_init(&w.lock, 0);
+	pthread_cond_init(&w.cond, 0);
+    }
+    _workers_started = false;
+}
+
+bool
+TimeSortedSched::start_workers()
+{
+    // Called from the first pull, once upstream elements are initialized.
+    _workers_started = true;
+    for (int t = 0; t < _nthreads; ++t) {
+	int err = pthread_create(&_workers[t].thread, 0, timesortedsched_worker_thread, &_workers[t]);
+	if (err != 0) {
+	    click_chatter("%{element}: cannot start worker thread: %s", this, strerror(err));
+	    router()->please_stop_driver();
+	    return false;
+	}
+	_workers[t].started = true;
+    }
+    return true;
+}
+
+void
+TimeSortedSched::stop_workers()
+{
+    if (!_workers)
+	return;
+    _workers_stop = true;
+    for (int t = 0; t < _nthreads; ++t) {
+	worker_s &w = _workers[t];
+	if (w.started) {
+	    pthread_mutex_lock(&w.lock);
+	    pthread_cond_signal(&w.cond);
+	    pthread_mutex_unlock(&w.lock);
+	    pthread_join(w.thread, 0);
+	}
+	pthread_mutex_destroy(&w.lock);
+	pthread_cond_destroy(&w.cond);
+    }
+    delete[] _workers;
+    _workers = 0;
+    for (int i = 0; i < _ninput; ++i) {
+	input_s &in = _input[i];
+	for (uint32_t x = in.ring_head; x != in.ring_tail; ++x)
+	    in.ring[x & _ring_mask]->kill();
+	delete[] in.ring;
+    }
+}
+
+inline void
+TimeSortedSched::wake_worker(int i)
+{
+    worker_s &w = _workers[i % _nthreads];
+    if (w.sleeping && w.sleeping.compare_and_swap(1, 0)) {
+	pthread_mutex_lock(&w.lock);
+	pthread_cond_signal(&w.cond);
+	pthread_mutex_unlock(&w.lock);
+    }
+}
+
+void *
+TimeSortedSched::worker_thread(void *arg)
+{
+    worker_s *w = static_cast<worker_s *>(arg);
+    w->tss->run_worker(*w);
+    return 0;
+}
+
+void
+TimeSortedSched::run_worker(worker_s &w)
+{
+    // Each worker owns every _nthreads-th input, pulling packets into that
+    // input's ring until the ring fills or the input runs dry.  When no
+    // input makes progress, it sleeps until the merging thread takes
+    // packets, or for a millisecond in case an empty input wakes up.
+    uint32_t capacity = _ring_mask + 1;
+    while (!_workers_stop) {
+	bool progress = false;
+	uint32_t seen = 0;
+	for (int i = w.id; i < _ninput; i += _nthreads) {
+	    input_s &in = _input[i];
+	    uint32_t tail = in.ring_tail;
+	    bool empty = !in.signal;
+	    while (!empty && tail - in.ring_head < capacity)
+		if (Packet *p = input(i).pull()) {
+		    in.ring[tail & _ring_mask] = p;
+		    ++tail;
+		} else
+		    empty = true;
+	    if (tail != in.ring_tail) {
+		if (!in.live)
+		    in.live = true;
+		click_order_fence();
+		in.ring_tail = tail;
+		progress = true;
+	    }
+	    bool live = !empty || in.signal;
+	    if (live != in.live) {
+		click_order_fence();
+		in.live = live;
+	    }
+	    seen += in.ring_head;
+	}
+
+	if (!progress) {
+	    pthread_mutex_lock(&w.lock);
+	    w.sleeping.swap(1);
+	    uint32_t now = 0;
+	    for (int i = w.id; i < _ninput; i += _nthreads)
+		now += _input[i].ring_head;
+	    if (now == seen && !_workers_stop) {
+		Timestamp t = Timestamp::now() + Timestamp::make_msec(1);
+		struct timespec ts = t.timespec();
+		pthread_cond_timedwait(&w.cond, &w.lock, &ts);
+	    }
+	    w.sleeping = 0;
+	    pthread_mutex_unlock(&w.lock);
+	}
+    }
+}
+#endif
+
 void
 TimeSortedSched::add_handlers()
 {
@@ -3,12 +3,17 @@
 #define CLICK_TIMESORTEDSCHED_HH
 #include <click/element.hh>
 #include <click/notifier.hh>
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+# include <click/atomic.hh>
+# include <pthread.h>
+# define CLICK_TIMESORTEDSCHED_THREADS 1
+#endif
 CLICK_DECLS
 
 /*
 =c
 
-TimeSortedSched(I<keywords> STOP, BUFFER)
+TimeSortedSched(I<keywords> STOP, BUFFER, BATCH, THREADS, PREFETCH)
 
 =s timestamps
 
@@ -31,6 +36,10 @@ TimeSortedSched emitted some packets out of order.  (But see BUFFER, below.)
 TimeSortedSched listens for notification from its inputs to avoid useless
 pulls, and provides notification for its output.
 
+TimeSortedSched keeps each input's buffered packets in a small heap, and
+merges the inputs with a tournament tree, so choosing each packet takes
+O(log N) timestamp comparisons for N inputs.
+
 Keyword arguments are:
 
 =over 8
@@ -47,6 +56,28 @@ Integer. Up to BUFFER packets per input are buffered within
 TimeSortedSched. Default BUFFER is 1. Higher BUFFER values let TimeSortedSched
 cope with minor reordering in its input streams.
 
+=item BATCH
+
+Integer. Once an input has fewer than BUFFER packets buffered,
+TimeSortedSched pulls from it until it has BUFFER or BATCH packets, whichever
+is more. Larger BATCH values pull from each input in batches. Default is 1.
+
+=item THREADS
+
+Integer. If positive, start THREADS worker threads that prefetch packets
+from the inputs, each thread serving every THREADS-th input, so that the
+thread running TimeSortedSched only compares timestamps. Upstream elements
+must tolerate pulls from another thread, as FromDump and FromIPSummaryDump
+do when nothing else pulls from them. TimeSortedSched then waits for each
+input until it supplies a packet or its notifier goes inactive, so inputs
+that are briefly empty do not cause misordered output. Default is 0. Only
+available in multithreaded user-level drivers.
+
+=item PREFETCH
+
+Integer. With THREADS, the number of packets each worker thread may
+prefetch per input. Default is 256.
+
 =back
 
 =n
@@ -95,33 +126,73 @@ class TimeSortedSched : public Element { public:
 
     Packet *pull(int);
 
+#if CLICK_TIMESORTEDSCHED_THREADS
+    static void *worker_thread(void *);
+#endif
+
   private:
 
-    struct packet_s {
-	Packet *p;
-	int input;		// for space, consider using annotation?
-	static bool compare(packet_s &a, packet_s &b) {
-	    return a.p->timestamp_anno() < b.p->timestamp_anno();
+    struct packet_compare {
+	bool operator()(Packet *a, Packet *b) const {
+	    return a->timestamp_anno() < b->timestamp_anno();
 	}
     };
     struct input_s {
 	NotifierSignal signal;
-	int space;
-	int ready;
+	Packet **pkt;		// heap of buffered packets, earliest first
+	int npkt;
+#if CLICK_TIMESORTEDSCHED_THREADS
+	Packet **ring;		// packets prefetched by a worker thread
+	volatile uint32_t ring_head;	// written by the merging thread
+	volatile uint32_t ring_tail;	// written by the worker thread
+	volatile bool live;	// the worker might prefetch more packets
+#endif
     };
 
-    packet_s *_pkt;
-    int _npkt;
-
     input_s *_input;
+    Packet **_pkt;
+    int _ninput;
+    int *_ready;		// inputs with fewer than _buffer packets
     int _nready;
+    int *_tree;			// tournament tree: _tree[0] is the winning input
 
     Notifier _notifier;
     int _buffer;
+    int _batch;
     Timestamp _last_emission;
     bool _stop;
     bool _well_ordered;
 
+#if CLICK_TIMESORTEDSCHED_THREADS
+    struct worker_s {
+	TimeSortedSched *tss;
+	int id;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	atomic_uint32_t sleeping;
+	bool started;
+    };
+    int _nthreads;
+    uint32_t _prefetch;
+    uint32_t _ring_mask;
+    worker_s *_workers;
+    bool _workers_started;
+    volatile bool _workers_stop;
+
+    void init_workers();
+    bool start_workers();
+    void stop_workers();
+    void run_worker(worker_s &);
+    void wake_worker(int i);
+#endif
+
+    inline bool earlier(int a, int b) const;
+    inline int match(int k) const;
+    void replay(int i);
+    void build_tree();
+    bool fill(int i, bool &live);
+
 };
 
 CLICK_ENDDECLS
@@ -31,7 +31,7 @@
 CLICK_DECLS
 
 ToIPSummaryDump::ToIPSummaryDump()
-    : _f(0), _task(this)
+    : _task(this)
 {
 }
 
@@ -49,11 +49,14 @@ ToIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
     bool careful_trunc = true;
     bool multipacket = false;
     bool binary = false;
+    bool columnar = false;
     bool header = true;
     bool extra_length = true;
 
+    if (_tf.configure_keywords(conf, this, errh) < 0)
+	return -1;
     if (cp_va_kparse(conf, this, errh,
-		     "FILENAME", cpkP+cpkM, cpFilename, &_filename,
+		     "FILENAME", cpkP+cpkM, cpFilename, &_tf.filename(),
 		     "CONTENTS", 0, cpArgument, &save,
 		     "DATA", 0, cpArgument, &save,
 		     "VERBOSE", 0, cpBool, &verbose,
@@ -64,9 +67,14 @@ ToIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
 		     "CAREFUL_TRUNC", 0, cpBool, &careful_trunc,
 		     "EXTRA_LENGTH", 0, cpBool, &extra_length,
 		     "BINARY", 0, cpBool, &binary,
+		     "COLUMNAR", 0, cpBool, &columnar,
 		     cpEnd) < 0)
 	return -1;
 
+    if (binary && columnar)
+	errh->error("'BINARY' and 'COLUMNAR' are mutually exclusive");
+    binary = binary || columnar;
+
     Vector<String> v;
     cp_spacevec(save, v);
     _binary_size = 4;
@@ -92,7 +100,7 @@ ToIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
       found_prepare:
 	int s = f->binary_size();
 	if ((s < 0 || !f->outb) && binary)
-	    errh->error("cannot use CONTENTS %s with BINARY", word.c_str());
+	    errh->error("cannot use CONTENTS %s with %s", word.c_str(), columnar ? "COLUMNAR" : "BINARY");
 	_binary_size += s;
 
 	// remove _multipacket if packet count specified
@@ -107,6 +115,7 @@ ToIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
     _careful_trunc = careful_trunc;
     _multipacket = multipacket;
     _binary = binary;
+    _columnar = columnar;
     _header = header;
     _extra_length = extra_length;
 
@@ -116,16 +125,6 @@ ToIPSummaryDump::configure(Vector<String> &conf, ErrorHandler *errh)
 int
 ToIPSummaryDump::initialize(ErrorHandler *errh)
 {
-    assert(!_f);
-    if (_filename != "-") {
-	_f = fopen(_filename.c_str(), "wb");
-	if (!_f)
-	    return errh->error("%s: %s", _filename.c_str(), strerror(errno));
-    } else {
-	_f = stdout;
-	_filename = "<stdout>";
-    }
-
     if (input_is_pull(0)) {
 	ScheduleInfo::join_scheduler(this, &_task, errh);
 	_signal = Notifier::upstream_empty_signal(this, 0, &_task);
@@ -162,22 +161,33 @@ ToIPSummaryDump::initialize(ErrorHandler *errh)
     sa << '\n';
 
     // binary marker
-    if (_binary)
+    if (_columnar)
+	sa << "!columnar\n";
+    else if (_binary)
 	sa << "!binary\n";
 
-    // print output
-    if (_header)
-	ignore_result(fwrite(sa.data(), 1, sa.length(), _f));
+    // columns collect a block of packets before it is written
+    if (_columnar) {
+	_columns.resize(_fields.size());
+	_marks.resize(_fields.size());
+	_widths.clear();
+	for (int i = 0; i < _fields.size(); i++)
+	    _widths.push_back(IPSummaryDump::column_width(_fields[i]->type));
+	_nrows = 0;
+    }
 
-    return 0;
+    // every file, including rotated files, starts with the header
+    if (_header)
+	_tf.set_header(sa.take_string());
+    return _tf.initialize(errh);
 }
 
 void
 ToIPSummaryDump::cleanup(CleanupStage)
 {
-    if (_f && _f != stdout)
-	fclose(_f);
-    _f = 0;
+    if (_columnar && _tf.initialized())
+	flush_block();
+    _tf.cleanup();
 }
 
 bool
@@ -212,6 +222,83 @@ ToIPSummaryDump::summary(Packet* p, StringAccum& sa, StringAccum* bad_sa) const
     return true;
 }
 
+void
+ToIPSummaryDump::add_row(Packet *p, StringAccum *bad_sa)
+{
+    IPSummaryDump::PacketDesc d(this, p, 0, bad_sa, _careful_trunc, _extra_length);
+
+    for (int i = 0; i < _prepare_fields.size(); i++)
+	_prepare_fields[i]->prepare(d, _prepare_fields[i]);
+
+    for (int i = 0; i < _fields.size(); i++) {
+	d.clear_values();
+	bool ok = _fields[i]->extract(d, _fields[i]);
+	if (_widths[i] == IPSummaryDump::C_VARIABLE) {
+	    _sa.clear();
+	    d.sa = &_sa;
+	    _fields[i]->outb(d, ok, _fields[i]);
+	    IPSummaryDump::append_variable(_columns[i], _sa.data(), _sa.length());
+	} else {
+	    d.sa = &_columns[i];
+	    _fields[i]->outb(d, ok, _fields[i]);
+	    assert(_columns[i].length() == (_nrows + 1) * _widths[i]);
+	}
+    }
+
+    _nrows++;
+}
+
+void
+ToIPSummaryDump::flush_block()
+{
+    if (!_nrows)
+	return;
+
+    StringAccum sa;
+    sa.extend(8);
+    for (int i = 0; i < _fields.size(); i++) {
+	IPSummaryDump::encode_column(sa, reinterpret_cast<const uint8_t *>(_columns[i].data()), _columns[i].length(), _nrows, _widths[i]);
+	_columns[i].clear();
+    }
+    uint32_t *h = reinterpret_cast<uint32_t *>(sa.data());
+    h[0] = htonl(sa.length());
+    h[1] = htonl(_nrows);
+    _nrows = 0;
+
+    if (_tf.begin_record(sa.length()))
+	_tf.write(sa.data(), sa.length());
+}
+
+void
+ToIPSummaryDump::write_columnar_packet(Packet *p)
+{
+    _bad_sa.clear();
+    if (_bad_packets)
+	for (int i = 0; i < _fields.size(); i++)
+	    _marks[i] = _columns[i].length();
+    add_row(p, (_bad_packets ? &_bad_sa : 0));
+
+    // a packet's '!bad' line must precede it, so end the block early
+    if (_bad_packets && _bad_sa) {
+	Vector<String> row;
+	for (int i = 0; i < _fields.size(); i++) {
+	    int pos = _marks[i];
+	    row.push_back(String(_columns[i].data() + pos, _columns[i].length() - pos));
+	    _columns[i].set_length(pos);
+	}
+	_nrows--;
+	flush_block();
+	if (_tf.begin_record(_bad_sa.length() + 4))
+	    put_line(_bad_sa.take_string());
+	for (int i = 0; i < _fields.size(); i++)
+	    _columns[i] << row[i];
+	_nrows = 1;
+    }
+
+    if (_nrows == IPSummaryDump::COLUMNAR_BLOCK)
+	flush_block();
+}
+
 void
 ToIPSummaryDump::write_packet(Packet* p, int multipacket)
 {
@@ -244,15 +331,25 @@ ToIPSummaryDump::write_packet(Packet* p, int multipacket)
 		p->timestamp_anno() += timestamp_delta;
 	}
 
+    } else if (_columnar) {
+	write_columnar_packet(p);
+	_output_count++;
+
     } else {
 	_sa.clear();
 	_bad_sa.clear();
 
 	summary(p, _sa, (_bad_packets ? &_bad_sa : 0));
 
+	// keep a packet's '!bad' line in the same file as the packet
+	size_t len = _sa.length();
 	if (_bad_packets && _bad_sa)
-	    write_line(_bad_sa.take_string());
-	ignore_result(fwrite(_sa.data(), 1, _sa.length(), _f));
+	    len += _bad_sa.length() + (_binary ? 4 : 0);
+	if (_tf.begin_record(len)) {
+	    if (_bad_packets && _bad_sa)
+		put_line(_bad_sa.take_string());
+	    _tf.write(_sa.data(), _sa.length());
+	}
 
 	_output_count++;
     }
@@ -283,16 +380,25 @@ ToIPSummaryDump::run_task(Task *)
 	return false;
 }
 
+void
+ToIPSummaryDump::put_line(const String &s)
+{
+    if (_binary) {
+	uint32_t marker = htonl((s.length() + 4) | 0x80000000U);
+	_tf.write(&marker, 4);
+    }
+    _tf.write(s);
+}
+
 void
 ToIPSummaryDump::write_line(const String& s)
 {
     if (s.length()) {
 	assert(s.back() == '\n');
-	if (_binary) {
-	    uint32_t marker = htonl(s.length() | 0x80000000U);
-	    ignore_result(fwrite(&marker, 4, 1, _f));
-	}
-	ignore_result(fwrite(s.data(), 1, s.length(), _f));
+	if (_columnar)
+	    flush_block();
+	if (_tf.begin_record(s.length() + (_binary ? 4 : 0)))
+	    put_line(s);
     }
 }
 
@@ -301,14 +407,18 @@ ToIPSummaryDump::add_note(const String &s)
 {
     if (s.length()) {
 	int extra = 1 + (s.back() == '\n' ? 0 : 1);
+	if (_columnar)
+	    flush_block();
+	if (!_tf.begin_record(s.length() + extra + (_binary ? 4 : 0)))
+	    return;
 	if (_binary) {
-	    uint32_t marker = htonl((s.length() + extra) | 0x80000000U);
-	    ignore_result(fwrite(&marker, 4, 1, _f));
+	    uint32_t marker = htonl((s.length() + extra + 4) | 0x80000000U);
+	    _tf.write(&marker, 4);
 	}
-	fputc('#', _f);
-	ignore_result(fwrite(s.data(), 1, s.length(), _f));
+	_tf.write("#", 1);
+	_tf.write(s);
 	if (extra > 1)
-	    fputc('\n', _f);
+	    _tf.write("\n", 1);
     }
 }
 
@@ -316,8 +426,11 @@ int
 ToIPSummaryDump::flush_handler(const String &, Element *e, void *, ErrorHandler *)
 {
     ToIPSummaryDump *tod = (ToIPSummaryDump *) e;
-    if (tod->_f)
-	fflush(tod->_f);
+    if (tod->_tf.initialized()) {
+	if (tod->_columnar)
+	    tod->flush_block();
+	tod->_tf.flush();
+    }
     return 0;
 }
 
@@ -327,8 +440,9 @@ ToIPSummaryDump::add_handlers()
     if (input_is_pull(0))
 	add_task_handlers(&_task);
     add_write_handler("flush", flush_handler, 0);
+    _tf.add_handlers(this);
 }
 
-ELEMENT_REQUIRES(userlevel IPSummaryDump IPSummaryDump_Anno IPSummaryDump_IP IPSummaryDump_TCP IPSummaryDump_UDP IPSummaryDump_ICMP IPSummaryDump_Payload IPSummaryDump_Link)
+ELEMENT_REQUIRES(userlevel ToFile IPSummaryDump IPSummaryDump_Anno IPSummaryDump_IP IPSummaryDump_TCP IPSummaryDump_UDP IPSummaryDump_ICMP IPSummaryDump_Payload IPSummaryDump_Link)
 EXPORT_ELEMENT(ToIPSummaryDump)
 CLICK_ENDDECLS
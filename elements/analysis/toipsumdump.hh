@@ -6,6 +6,7 @@
 #include <click/straccum.hh>
 #include <click/notifier.hh>
 #include "ipsumdumpinfo.hh"
+#include "elements/userlevel/tofile.hh"
 CLICK_DECLS
 
 /*
@@ -134,6 +135,12 @@ of the dump. Ignored if HEADER is false.
 Boolean. If true, then output packet records in a binary format (explained
 below). Defaults to false.
 
+=item COLUMNAR
+
+Boolean. If true, then output packets in a columnar binary format (explained
+below), which is smaller than BINARY output and much faster for
+FromIPSummaryDump to read. Defaults to false.
+
 =item MULTIPACKET
 
 Boolean. If true, and the CONTENTS option doesn't contain 'C<count>', then
@@ -160,6 +167,18 @@ Actual packet output immediately follows the 'C<!bad>' line.  Default is true.
 
 Boolean.  If false, then ignore extra length annotations.  Defaults to true.
 
+=item ASYNC, BUFFER_SIZE, BUFFERS, BLOCKING, DIRECT
+
+Control asynchronous output through a writer thread, as for ToDump.  When
+BLOCKING is false and every buffer is full, packets are left out of the dump.
+By default ToIPSummaryDump writes synchronously.
+
+=item ROTATE_SIZE, ROTATE_INTERVAL
+
+Start a new dump file after the current file reaches ROTATE_SIZE bytes or
+ROTATE_INTERVAL time, as for ToDump.  Each file starts with the 'C<!>' header
+lines, if any.
+
 =back
 
 =e
@@ -334,9 +353,57 @@ The data stored in a metadata record is just an ASCII string, ending with
 newline, same as in a regular ASCII IPSummaryDump file. 'C<!bad>' records, for
 example, are stored this way.
 
+=head1 COLUMNAR FORMAT
+
+Columnar IPSummaryDump files begin with ASCII lines, like regular files. The
+line 'C<!columnar>' indicates that the rest of the file consists of records
+that start with the same length word as binary records. Metadata records are
+the same as in the binary format. Other records are blocks holding up to 4096
+packets:
+
+   +---------------+---------------+--------...
+   |0| block length| packet count  | columns
+   +---------------+---------------+--------...
+    <---4 bytes---> <---4 bytes--->
+
+The block has one column per field, in the order indicated by the 'C<!data>'
+line. Each column looks like this:
+
+   +------+------+--------------+-------+-------+--------...
+   |coding|width | data length  |  min  |  max  | data
+   +------+------+--------------+-------+-------+--------...
+    1 byte 1 byte <--4 bytes--->
+
+Width is the field's Length from the binary format table, or 255 for
+variable-length fields. The min and max values, present only for widths 1
+through 8, are the smallest and largest values in the column, compared as
+byte strings; they let readers skip blocks without decoding them.
+
+Coding 0 means the data holds the values just as they appear in binary
+records, one after another; variable-length values are each preceded by
+their length. Coding 1, used only for widths 1, 2, 4, and 8, stores each
+value as its difference from the previous value in the column. Fields of
+width 8 are split into two 4-byte halves, such as a timestamp's seconds and
+microseconds, and each half is differenced separately. Each difference is
+taken modulo the width, read as a signed number, and zigzag encoded (0, -1,
+1, -2, ... become 0, 1, 2, 3, ...). Lengths and differences are stored as
+little-endian base-128 varints, 7 bits per byte, with the high-order bit set
+in all but the last byte.
+
 =h flush write-only
 
-Flush all internal buffers to disk.
+Flush all internal buffers to disk, ending the current COLUMNAR block.  With
+ASYNC, waits for the writer thread to write every buffer.
+
+=h drops read-only
+
+Returns the number of packets left out of the dump because every ASYNC buffer
+was full.
+
+=h stalls read-only
+
+Returns the number of times ToIPSummaryDump waited for the ASYNC writer
+thread.
 
 =a
 
@@ -360,15 +427,14 @@ class ToIPSummaryDump : public Element, public IPSummaryDumpInfo { public:
     void push(int, Packet *);
     bool run_task(Task *);
 
-    String filename() const		{ return _filename; }
+    String filename() const		{ return _tf.print_filename(); }
     uint32_t output_count() const	{ return _output_count; }
     void add_note(const String &);
     void write_line(const String &);
 
   private:
 
-    String _filename;
-    FILE *_f;
+    ToFile _tf;
     Vector<const IPSummaryDump::FieldWriter *> _fields;
     Vector<const IPSummaryDump::FieldWriter *> _prepare_fields;
     bool _verbose : 1;
@@ -379,6 +445,7 @@ class ToIPSummaryDump : public Element, public IPSummaryDumpInfo { public:
     bool _binary : 1;
     bool _header : 1;
     bool _extra_length : 1;
+    bool _columnar : 1;
     int32_t _binary_size;
     uint32_t _output_count;
     Task _task;
@@ -389,8 +456,17 @@ class ToIPSummaryDump : public Element, public IPSummaryDumpInfo { public:
 
     String _banner;
 
+    Vector<StringAccum> _columns;
+    Vector<int> _widths;
+    Vector<int> _marks;
+    int _nrows;
+
     bool summary(Packet* p, StringAccum& sa, StringAccum* bad_sa) const;
     void write_packet(Packet* p, int multipacket);
+    void add_row(Packet *p, StringAccum *bad_sa);
+    void write_columnar_packet(Packet *p);
+    void flush_block();
+    void put_line(const String &s);
     static int flush_handler(const String &, Element *, void *, ErrorHandler *);
 
 };
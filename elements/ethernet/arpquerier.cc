@@ -269,8 +269,8 @@ ARPQuerier::handle_ip(Packet *p, bool response)
     EtherAddress *dst_eth = reinterpret_cast<EtherAddress *>(q->ether_header()->ether_dhost);
     int r;
 
-    // Easy case: requires only read lock
-  retry_read_lock:
+    // Easy case: lookups take no lock
+  retry_lookup:
     r = _arpt->lookup(dst_ip, dst_eth, _poll_timeout_j);
     if (r >= 0) {
 	assert(!dst_eth->is_broadcast());
@@ -302,7 +302,7 @@ ARPQuerier::handle_ip(Packet *p, bool response)
 	} else {
 	    r = _arpt->append_query(dst_ip, q);
 	    if (r == -EAGAIN)
-		goto retry_read_lock;
+		goto retry_lookup;
 	    if (r > 0)
 		send_query_for(q, false); // q is on the ARP entry's queue
 	    // Do not q->kill() since it is stored in some ARP entry.
@@ -26,18 +26,25 @@
 #include <click/bitvector.hh>
 #include <click/straccum.hh>
 #include <click/router.hh>
+#include <click/master.hh>
 #include <click/error.hh>
 #include <click/glue.hh>
 CLICK_DECLS
 
+ARPTable::ARPEntry * const ARPTable::tombstone = reinterpret_cast<ARPTable::ARPEntry *>(1);
+
 ARPTable::ARPTable()
-    : _entry_capacity(0), _packet_capacity(2048), _expire_timer(this)
+    : _slots(0), _entry_capacity(0), _packet_capacity(2048), _expire_timer(this)
 {
     _entry_count = _packet_count = _drops = 0;
 }
 
 ARPTable::~ARPTable()
 {
+    // _reclaimer's entries belong to _alloc, which is destroyed first
+    _reclaimer.reclaim_all();
+    if (_slots)
+	free_slots(_slots, 0);
 }
 
 int
@@ -51,6 +58,9 @@ ARPTable::configure(Vector<String> &conf, ErrorHandler *errh)
 		     cpEnd) < 0)
 	return -1;
     set_timeout(timeout);
+    if (!_slots && !(_slots = new_slots(min_slots)))
+	return errh->error("out of memory");
+    _reclaimer.initialize(master());
     if (_timeout_j) {
 	_expire_timer.initialize(this);
 	_expire_timer.schedule_after_sec(_timeout_j / CLICK_HZ);
@@ -61,24 +71,150 @@ ARPTable::configure(Vector<String> &conf, ErrorHandler *errh)
 void
 ARPTable::cleanup(CleanupStage)
 {
-    clear();
+    if (_slots)
+	clear();
+    _reclaimer.reclaim_all();
+}
+
+ARPTable::Slots *
+ARPTable::new_slots(uint32_t nslots)
+{
+    Slots *s = (Slots *) CLICK_LALLOC(sizeof(Slots) + (nslots - 1) * sizeof(ARPEntry *));
+    if (s) {
+	s->mask = nslots - 1;
+	s->used = 0;
+	for (uint32_t i = 0; i < nslots; i++)
+	    s->slot[i] = 0;
+    }
+    return s;
+}
+
+void
+ARPTable::free_slots(void *slots, void *)
+{
+    Slots *s = (Slots *) slots;
+    CLICK_LFREE(s, sizeof(Slots) + s->mask * sizeof(ARPEntry *));
+}
+
+void
+ARPTable::free_entry(void *ae, void *arpt)
+{
+    ((ARPTable *) arpt)->_alloc.deallocate(ae);
+}
+
+ARPTable::ARPEntry * volatile *
+ARPTable::find_slot(IPAddress ip) const
+{
+    Slots *s = _slots;
+    for (uint32_t i = bucket(ip, s->mask); ; i = (i + 1) & s->mask) {
+	ARPEntry *ae = s->slot[i];
+	if (!ae)
+	    return 0;
+	else if (ae != tombstone && ae->_ip == ip)
+	    return &s->slot[i];
+    }
+}
+
+void
+ARPTable::rebuild(uint32_t nslots)
+{
+    // Build a new array of the live entries, leaving the old one intact for
+    // readers that are still probing it.  If memory is short, keep the old
+    // array.
+    Slots *s = new_slots(nslots);
+    if (!s)
+	return;
+    for (ARPEntry *ae = _age.front(); ae; ae = ae->_age_link.next()) {
+	uint32_t i = bucket(ae->_ip, s->mask);
+	while (s->slot[i])
+	    i = (i + 1) & s->mask;
+	s->slot[i] = ae;
+	++s->used;
+    }
+    click_order_fence();
+    Slots *old = _slots;
+    _slots = s;
+    _reclaimer.retire(old, free_slots);
+}
+
+bool
+ARPTable::add(ARPEntry *ae)
+{
+    // Keep the array at most half full of entries and tombstones, so
+    // probes stay short and always end.
+    Slots *s = _slots;
+    if ((s->used + 1) * 2 > s->mask + 1) {
+	uint32_t nslots = min_slots;
+	while (nslots < 4 * _entry_count.value())
+	    nslots *= 2;
+	rebuild(nslots);
+	s = _slots;
+	if (s->used + 2 > s->mask)
+	    return false;
+    }
+
+    uint32_t i = bucket(ae->_ip, s->mask);
+    while (s->slot[i] && s->slot[i] != tombstone)
+	i = (i + 1) & s->mask;
+    if (!s->slot[i])
+	++s->used;
+    click_order_fence();
+    s->slot[i] = ae;
+    _age.push_back(ae);
+    return true;
+}
+
+ARPTable::ARPEntry *
+ARPTable::replace(ARPEntry * volatile *slotp, const EtherAddress &eth)
+{
+    // Readers may be copying the old entry's address, so publish a new
+    // entry instead of changing it.
+    void *x = _alloc.allocate();
+    if (!x)
+	return 0;
+    ARPEntry *old = *slotp;
+    ARPEntry *ae = new(x) ARPEntry(old->_ip);
+    ae->_eth = eth;
+    ae->_known = !eth.is_broadcast();
+    ae->_live_at_j = old->_live_at_j;
+    ae->_polled_at_j = old->_polled_at_j;
+    ae->_head = old->_head;
+    ae->_tail = old->_tail;
+    _age.insert(old->_age_link.next(), ae);
+    _age.erase(old);
+    click_order_fence();
+    *slotp = ae;
+    _reclaimer.retire(old, free_entry, this);
+    return ae;
+}
+
+void
+ARPTable::remove(ARPEntry *ae)
+{
+    // Leave a tombstone, since readers may be probing past this slot.
+    *find_slot(ae->_ip) = tombstone;
+    _age.erase(ae);
+    while (Packet *p = ae->_head) {
+	ae->_head = p->next();
+	p->kill();
+	--_packet_count;
+	++_drops;
+    }
+    --_entry_count;
+    _reclaimer.retire(ae, free_entry, this);
 }
 
 void
 ARPTable::clear()
 {
     // Walk the arp cache table and free any stored packets and arp entries.
-    for (Table::iterator it = _table.begin(); it; ) {
-	ARPEntry *ae = _table.erase(it);
-	while (Packet *p = ae->_head) {
-	    ae->_head = p->next();
-	    p->kill();
-	    ++_drops;
-	}
-	_alloc.deallocate(ae);
-    }
+    _lock.acquire();
+    while (ARPEntry *ae = _age.front())
+	remove(ae);
     _entry_count = _packet_count = 0;
-    _age.__clear();
+    rebuild(min_slots);
+    _reclaimer.reclaim();
+    _lock.release();
 }
 
 void
@@ -87,12 +223,18 @@ ARPTable::take_state(Element *e, ErrorHandler *errh)
     ARPTable *arpt = (ARPTable *)e->cast("ARPTable");
     if (!arpt)
 	return;
-    if (_table.size() > 0) {
+    if (_entry_count > 0) {
 	errh->error("late take_state");
 	return;
     }
 
-    _table.swap(arpt->_table);
+    // The old router has been killed, so no lookups can reach arpt's
+    // retired entries.  Free them before taking the allocator they came
+    // from.
+    arpt->_reclaimer.reclaim_all();
+    Slots *s = _slots;
+    _slots = arpt->_slots;
+    arpt->_slots = s;
     _age.swap(arpt->_age);
     _entry_count = arpt->_entry_count;
     _packet_count = arpt->_packet_count;
@@ -111,20 +253,8 @@ ARPTable::slim(click_jiffies_t now)
     // Delete old entries.
     while ((ae = _age.front())
 	   && (ae->expired(now, _timeout_j)
-	       || (_entry_capacity && _entry_count > _entry_capacity))) {
-	_table.erase(ae->_ip);
-	_age.pop_front();
-
-	while (Packet *p = ae->_head) {
-	    ae->_head = p->next();
-	    p->kill();
-	    --_packet_count;
-	    ++_drops;
-	}
-
-	_alloc.deallocate(ae);
-	--_entry_count;
-    }
+	       || (_entry_capacity && _entry_count > _entry_capacity)))
+	remove(ae);
 
     // Mark entries for polling, and delete packets to make space.
     while (_packet_capacity && _packet_count > _packet_capacity) {
@@ -145,49 +275,65 @@ ARPTable::run_timer(Timer *timer)
 {
     // Expire any old entries, and make sure there's room for at least one
     // packet.
-    _lock.acquire_write();
+    _lock.acquire();
     slim(click_jiffies());
-    _lock.release_write();
+    _reclaimer.reclaim();
+    _lock.release();
     if (_timeout_j)
 	timer->schedule_after_sec(_timeout_j / CLICK_HZ + 1);
 }
 
 ARPTable::ARPEntry *
-ARPTable::ensure(IPAddress ip, click_jiffies_t now)
+ARPTable::create(IPAddress ip, const EtherAddress &eth, click_jiffies_t now)
 {
-    _lock.acquire_write();
-    Table::iterator it = _table.find(ip);
-    if (!it) {
-	void *x = _alloc.allocate();
-	if (!x) {
-	    _lock.release_write();
-	    return 0;
-	}
-
-	++_entry_count;
-	if (_entry_capacity && _entry_count > _entry_capacity)
-	    slim(now);
+    void *x = _alloc.allocate();
+    if (!x)
+	return 0;
 
-	ARPEntry *ae = new(x) ARPEntry(ip);
-	ae->_live_at_j = now;
-	ae->_polled_at_j = ae->_live_at_j - CLICK_HZ;
-	_table.set(it, ae);
+    ++_entry_count;
+    if (_entry_capacity && _entry_count > _entry_capacity)
+	slim(now);
 
-	_age.push_back(ae);
+    ARPEntry *ae = new(x) ARPEntry(ip);
+    ae->_eth = eth;
+    ae->_known = !eth.is_broadcast();
+    ae->_live_at_j = now;
+    ae->_polled_at_j = ae->_live_at_j - CLICK_HZ;
+    if (!add(ae)) {
+	--_entry_count;
+	_alloc.deallocate(ae);
+	return 0;
     }
-    return it.get();
+    return ae;
+}
+
+ARPTable::ARPEntry *
+ARPTable::ensure(IPAddress ip, click_jiffies_t now)
+{
+    // Call with _lock held.
+    if (ARPEntry * volatile *slotp = find_slot(ip))
+	return *slotp;
+    else
+	return create(ip, EtherAddress::make_broadcast(), now);
 }
 
 int
 ARPTable::insert(IPAddress ip, const EtherAddress &eth, Packet **head)
 {
     click_jiffies_t now = click_jiffies();
-    ARPEntry *ae = ensure(ip, now);
-    if (!ae)
+    _lock.acquire();
+    ARPEntry *ae;
+    if (ARPEntry * volatile *slotp = find_slot(ip)) {
+	ae = *slotp;
+	if ((ae->_eth != eth || ae->_known != !eth.is_broadcast())
+	    && !(ae = replace(slotp, eth))) {
+	    _lock.release();
+	    return -ENOMEM;
+	}
+    } else if (!(ae = create(ip, eth, now))) {
+	_lock.release();
 	return -ENOMEM;
-
-    ae->_eth = eth;
-    ae->_known = !eth.is_broadcast();
+    }
 
     ae->_live_at_j = now;
     ae->_polled_at_j = ae->_live_at_j - CLICK_HZ;
@@ -204,8 +350,8 @@ ARPTable::insert(IPAddress ip, const EtherAddress &eth, Packet **head)
 	    --_packet_count;
     }
 
-    _table.balance();
-    _lock.release_write();
+    _reclaimer.reclaim();
+    _lock.release();
     return 0;
 }
 
@@ -213,12 +359,15 @@ int
 ARPTable::append_query(IPAddress ip, Packet *p)
 {
     click_jiffies_t now = click_jiffies();
+    _lock.acquire();
     ARPEntry *ae = ensure(ip, now);
-    if (!ae)
+    if (!ae) {
+	_lock.release();
 	return -ENOMEM;
+    }
 
     if (ae->known(now, _timeout_j)) {
-	_lock.release_write();
+	_lock.release();
 	return -EAGAIN;
     }
 
@@ -260,25 +409,23 @@ ARPTable::append_query(IPAddress ip, Packet *p)
     } else
 	r = 0;
 
-    _table.balance();
-    _lock.release_write();
+    _reclaimer.reclaim();
+    _lock.release();
     return r;
 }
 
 IPAddress
 ARPTable::reverse_lookup(const EtherAddress &eth)
 {
-    _lock.acquire_read();
-
-    IPAddress ip;
-    for (Table::iterator it = _table.begin(); it; ++it)
-	if (it->_eth == eth) {
-	    ip = it->_ip;
-	    break;
-	}
-
-    _lock.release_read();
-    return ip;
+    // A lookup like any other: entries and the array stay valid until this
+    // thread is next quiescent.
+    const Slots *s = _slots;
+    for (uint32_t i = 0; i <= s->mask; ++i) {
+	ARPEntry *ae = s->slot[i];
+	if (ae && ae != tombstone && ae->_eth == eth)
+	    return ae->_ip;
+    }
+    return IPAddress();
 }
 
 String
@@ -289,11 +436,13 @@ ARPTable::read_handler(Element *e, void *user_data)
     click_jiffies_t now = click_jiffies();
     switch (reinterpret_cast<uintptr_t>(user_data)) {
     case h_table:
+	arpt->_lock.acquire();
 	for (ARPEntry *ae = arpt->_age.front(); ae; ae = ae->_age_link.next()) {
 	    int ok = ae->known(now, arpt->_timeout_j);
 	    sa << ae->_ip << ' ' << ok << ' ' << ae->_eth << ' '
 	       << Timestamp::make_jiffies(now - ae->_live_at_j) << '\n';
 	}
+	arpt->_lock.release();
 	break;
     }
     return sa.take_string();
@@ -2,8 +2,8 @@
 #define CLICK_ARPTABLE_HH
 #include <click/element.hh>
 #include <click/etheraddress.hh>
-#include <click/hashcontainer.hh>
 #include <click/hashallocator.hh>
+#include <click/epoch.hh>
 #include <click/sync.hh>
 #include <click/timer.hh>
 #include <click/list.hh>
@@ -26,6 +26,15 @@ outputs.  ARPQuerier normally encapsulates access to an ARPTable element.  A
 separate ARPTable is useful if several ARPQuerier elements should share a
 table.
 
+Lookups take no locks and perform no atomic operations, so threads forwarding
+through a shared table do not contend.  Updates are serialized by a lock.  An
+entry's IP address, Ethernet address, and validity never change once it is
+published; an update that changes them replaces the entry, and frees the old
+one only after every thread has finished any lookup that might have found it.
+Other entry state, such as timestamps and the queue of packets awaiting an
+answer, is updated in place under the lock, except that a lookup records the
+time it decided to poll without taking the lock.
+
 Keyword arguments are:
 
 =over 8
@@ -143,19 +152,13 @@ class ARPTable : public Element { public:
 
     struct ARPEntry {		// This structure is now larger than I'd like
 	IPAddress _ip;		// (40B) but probably still fine.
-	ARPEntry *_hashnext;
-	EtherAddress _eth;
-	bool _known;
-	click_jiffies_t _live_at_j;
-	click_jiffies_t _polled_at_j;
+	EtherAddress _eth;	// _ip, _eth, and _known never change once the
+	bool _known;		// entry is published.  The rest change in
+	click_jiffies_t _live_at_j;	// place under _lock, except that
+	click_jiffies_t _polled_at_j;	// lookup() sets _polled_at_j unlocked.
 	Packet *_head;
 	Packet *_tail;
 	List_member<ARPEntry> _age_link;
-	typedef IPAddress key_type;
-	typedef IPAddress key_const_reference;
-	key_const_reference hashkey() const {
-	    return _ip;
-	}
 	bool expired(click_jiffies_t now, uint32_t timeout_j) const {
 	    return click_jiffies_less(_live_at_j + timeout_j, now)
 		&& timeout_j;
@@ -164,17 +167,28 @@ class ARPTable : public Element { public:
 	    return _known && !expired(now, timeout_j);
 	}
 	ARPEntry(IPAddress ip)
-	    : _ip(ip), _hashnext(), _eth(EtherAddress::make_broadcast()),
+	    : _ip(ip), _eth(EtherAddress::make_broadcast()),
 	      _known(false), _head(), _tail() {
 	}
     };
 
   private:
 
-    ReadWriteLock _lock;
+    // Readers probe _slots, an open-addressed array of entry pointers, with
+    // no lock.  Writers hold _lock.  Removed entries leave a tombstone
+    // until the array is rebuilt; old arrays and entries are retired to
+    // _reclaimer.
+    struct Slots {
+	uint32_t mask;
+	uint32_t used;		// entries plus tombstones
+	ARPEntry * volatile slot[1];
+    };
+    enum { min_slots = 16 };
+    Slots * volatile _slots;
+    EpochReclaimer _reclaimer;
+
+    Spinlock _lock;
 
-    typedef HashContainer<ARPEntry> Table;
-    Table _table;
     typedef List<ARPEntry, &ARPEntry::_age_link> AgeList;
     AgeList _age;
     atomic_uint32_t _entry_count;
@@ -186,31 +200,64 @@ class ARPTable : public Element { public:
     SizedHashAllocator<sizeof(ARPEntry)> _alloc;
     Timer _expire_timer;
 
+    static ARPEntry * const tombstone;
+    static inline uint32_t bucket(IPAddress ip, uint32_t mask);
+    inline ARPEntry *find(IPAddress ip) const;
+    ARPEntry * volatile *find_slot(IPAddress ip) const;
+    static Slots *new_slots(uint32_t nslots);
+    static void free_slots(void *slots, void *);
+    static void free_entry(void *ae, void *arpt);
+    void rebuild(uint32_t nslots);
+    bool add(ARPEntry *ae);
+    ARPEntry *replace(ARPEntry * volatile *slotp, const EtherAddress &eth);
+    void remove(ARPEntry *ae);
+    ARPEntry *create(IPAddress ip, const EtherAddress &eth, click_jiffies_t now);
     ARPEntry *ensure(IPAddress ip, click_jiffies_t now);
     void slim(click_jiffies_t now);
 
 };
 
+inline uint32_t
+ARPTable::bucket(IPAddress ip, uint32_t mask)
+{
+    uint32_t h = ip.addr() * 0x9E3779B1U;
+    return (h ^ (h >> 16)) & mask;
+}
+
+inline ARPTable::ARPEntry *
+ARPTable::find(IPAddress ip) const
+{
+    // The array always has an empty slot, so the probe ends.
+    const Slots *s = _slots;
+    for (uint32_t i = bucket(ip, s->mask); ; i = (i + 1) & s->mask) {
+	ARPEntry *ae = s->slot[i];
+	if (!ae)
+	    return 0;
+	else if (ae != tombstone && ae->_ip == ip)
+	    return ae;
+    }
+}
+
 inline int
 ARPTable::lookup(IPAddress ip, EtherAddress *eth, uint32_t poll_timeout_j)
 {
-    _lock.acquire_read();
-    int r = -1;
-    if (Table::iterator it = _table.find(ip)) {
+    ARPEntry *ae = find(ip);
+    if (ae) {
 	click_jiffies_t now = click_jiffies();
-	if (it->known(now, _timeout_j)) {
-	    *eth = it->_eth;
+	if (ae->known(now, _timeout_j)) {
+	    *eth = ae->_eth;
+	    // Racing lookups may both decide to poll; that costs only an
+	    // extra query.
 	    if (poll_timeout_j
-		&& !click_jiffies_less(now, it->_live_at_j + poll_timeout_j)
-		&& !click_jiffies_less(now, it->_polled_at_j + (CLICK_HZ / 10))) {
-		it->_polled_at_j = now;
-		r = 1;
+		&& !click_jiffies_less(now, ae->_live_at_j + poll_timeout_j)
+		&& !click_jiffies_less(now, ae->_polled_at_j + (CLICK_HZ / 10))) {
+		ae->_polled_at_j = now;
+		return 1;
 	    } else
-		r = 0;
+		return 0;
 	}
     }
-    _lock.release_read();
-    return r;
+    return -1;
 }
 
 inline EtherAddress
@@ -71,6 +71,27 @@ EtherEncap::pull(int)
 	return 0;
 }
 
+void
+EtherEncap::push_batch(int, PacketBatch &batch)
+{
+    PacketBatch out;
+    while (Packet *p = batch.pop_front())
+	if (Packet *q = smaction(p))
+	    out.append(q);
+    if (out)
+	output(0).push_batch(out);
+}
+
+PacketBatch
+EtherEncap::pull_batch(int, unsigned max)
+{
+    PacketBatch batch = input(0).pull_batch(max), out;
+    while (Packet *p = batch.pop_front())
+	if (Packet *q = smaction(p))
+	    out.append(q);
+    return out;
+}
+
 void
 EtherEncap::add_handlers()
 {
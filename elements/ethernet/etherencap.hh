@@ -61,6 +61,8 @@ class EtherEncap : public Element { public:
     Packet *smaction(Packet *);
     void push(int, Packet *);
     Packet *pull(int);
+    void push_batch(int, PacketBatch &);
+    PacketBatch pull_batch(int, unsigned);
 
   private:
 
@@ -26,67 +26,186 @@
 CLICK_DECLS
 
 EtherSwitch::EtherSwitch()
-    : _table(AddrInfo(-1, Timestamp())), _timeout(300)
+    : _slots(0), _timeout(300), _in_counts(0), _out_counts(0)
 {
 }
 
 EtherSwitch::~EtherSwitch()
 {
-    _table.clear();
 }
 
 int
 EtherSwitch::configure(Vector<String> &conf, ErrorHandler *errh)
 {
-    return cp_va_kparse(conf, this, errh,
-			"TIMEOUT", 0, cpSeconds, &_timeout,
-			cpEnd);
+    _capacity = 16384;
+    if (cp_va_kparse(conf, this, errh,
+		     "TIMEOUT", 0, cpSeconds, &_timeout,
+		     "CAPACITY", 0, cpUnsigned, &_capacity,
+		     cpEnd) < 0)
+	return -1;
+    if (_capacity < 1 || _capacity > 0x1000000)
+	return errh->error("CAPACITY must be between 1 and 16777216");
+    return 0;
+}
+
+int
+EtherSwitch::initialize(ErrorHandler *errh)
+{
+    // keep the table at most half full
+    uint32_t nslots = 2 * max_probe;
+    while (nslots < 2 * _capacity)
+	nslots *= 2;
+    if (!(_slots = new Slot[nslots]))
+	return errh->error("out of memory");
+    memset(_slots, 0, sizeof(Slot) * nslots);
+    _mask = nslots - 1;
+
+    _in_counts = new PerThreadCounter[ninputs()];
+    _out_counts = new PerThreadCounter[noutputs()];
+    for (int i = 0; i < ninputs(); i++)
+	if (_in_counts[i].initialize(master()) < 0)
+	    return errh->error("out of memory");
+    for (int i = 0; i < noutputs(); i++)
+	if (_out_counts[i].initialize(master()) < 0)
+	    return errh->error("out of memory");
+    if (_floods.initialize(master()) < 0
+	|| _learn_failures.initialize(master()) < 0)
+	return errh->error("out of memory");
+    return 0;
 }
 
 void
-EtherSwitch::broadcast(int source, Packet *p)
+EtherSwitch::cleanup(CleanupStage)
+{
+    delete[] _slots;
+    delete[] _in_counts;
+    delete[] _out_counts;
+    _slots = 0;
+    _in_counts = _out_counts = 0;
+}
+
+int
+EtherSwitch::lookup(uint64_t key, uint32_t now) const
 {
-  int n = noutputs();
-  assert((unsigned) source < (unsigned) n);
-  int sent = 0;
-  for (int i = 0; i < n; i++)
-    if (i != source) {
-      Packet *pp = (sent < n - 2 ? p->clone() : p);
-      output(i).push(pp);
-      sent++;
+    uint32_t h = home(key);
+    for (int i = 0; i < max_probe; i++) {
+	const Slot &s = _slots[(h + i) & _mask];
+	uint64_t e = s.entry;
+	if (!e)
+	    break;
+	if ((e & 0xFFFFFFFFFFFFULL) == key)
+	    return live(s, now) ? (int) (e >> 48) - 1 : -1;
     }
-  assert(sent == n - 1);
+    return -1;
 }
 
 void
-EtherSwitch::push(int source, Packet *p)
+EtherSwitch::learn(uint64_t key, int port, uint32_t now)
 {
-    click_ether* e = (click_ether*) p->data();
-    int outport = -1;		// Broadcast
+    uint64_t want = ((uint64_t) (port + 1) << 48) | key;
+    uint32_t h = home(key);
+
+    // Common case: the address is known on this port.  Refresh its time at
+    // most once a second.  Racing refreshes store nearly equal times.
+    for (int i = 0; i < max_probe; i++) {
+	Slot &s = _slots[(h + i) & _mask];
+	uint64_t e = s.entry;
+	if (!e)
+	    break;
+	if (e == want) {
+	    if (s.seen != now)
+		s.seen = now;
+	    return;
+	}
+    }
+
+    // New or moved address: update the address's slot if it has one, or
+    // else reuse the first empty or timed-out slot.  Store the time before
+    // the entry, so readers never see a new entry with an old time.
+    _lock.acquire();
+    Slot *reuse = 0;
+    for (int i = 0; i < max_probe; i++) {
+	Slot &s = _slots[(h + i) & _mask];
+	uint64_t e = s.entry;
+	if (e && (e & 0xFFFFFFFFFFFFULL) == key) {
+	    reuse = &s;
+	    break;
+	} else if (!reuse && (!e || !live(s, now)))
+	    reuse = &s;
+	if (!e)
+	    break;
+    }
+    if (reuse) {
+	reuse->seen = now;
+	click_order_fence();
+	reuse->entry = want;
+    } else
+	_learn_failures++;
+    _lock.release();
+}
+
+int
+EtherSwitch::route(int source, Packet *p)
+{
+    const click_ether *e = (const click_ether *) p->data();
+    _in_counts[source]++;
 
     // 0 timeout means dumb switch
-    if (_timeout != 0) {
-	_table.set(EtherAddress(e->ether_shost), AddrInfo(source, p->timestamp_anno()));
-
-	// Set outport if dst is unicast, we have info about it, and the
-	// info is still valid.
-	EtherAddress dst(e->ether_dhost);
-	if (!dst.is_group()) {
-	    if (Table::iterator dst_info = _table.find(dst)) {
-		if (p->timestamp_anno() < dst_info.value().stamp + Timestamp(_timeout, 0))
-		    outport = dst_info.value().port;
-		else
-		    _table.erase(dst_info);
+    if (_timeout == 0)
+	return -1;
+
+    uint32_t now = p->timestamp_anno().sec();
+    learn(address_key(e->ether_shost), source, now);
+
+    // Use the outport if dst is unicast, we have info about it, and the
+    // info is still valid.
+    if (e->ether_dhost[0] & 1)
+	return -1;
+    return lookup(address_key(e->ether_dhost), now);
+}
+
+void
+EtherSwitch::broadcast(int source, Packet *p)
+{
+    // Send clones to all but the last output, and p itself to that one.
+    // The clones share p's data, and are made in chunks, so the shared
+    // reference count is updated once per chunk.
+    int n = noutputs();
+    assert((unsigned) source < (unsigned) n);
+    _floods++;
+    int last = (source == n - 1 ? n - 2 : n - 1);
+    int left = n - 2;
+    Packet *clones[flood_chunk];
+    int nclones = 0, next_clone = 0;
+    for (int i = 0; i < last; i++)
+	if (i != source) {
+	    if (next_clone == nclones) {
+		nclones = p->clone(clones, left < flood_chunk ? left : flood_chunk);
+		next_clone = 0;
+		if (!nclones)
+		    break;
 	    }
+	    left--;
+	    _out_counts[i]++;
+	    output(i).push(clones[next_clone++]);
 	}
-    }
+    _out_counts[last]++;
+    output(last).push(p);
+}
+
+void
+EtherSwitch::push(int source, Packet *p)
+{
+    int outport = route(source, p);
 
   if (outport < 0)
     broadcast(source, p);
   else if (outport == source)	// Don't send back out on same interface
     p->kill();
-  else				// forward
+  else {			// forward
+    _out_counts[outport]++;
     output(outport).push(p);
+  }
 }
 
 String
@@ -96,22 +215,41 @@ EtherSwitch::reader(Element* f, void *thunk)
     switch ((intptr_t) thunk) {
     case 0: {
 	StringAccum sa;
-	for (Table::iterator iter = sw->_table.begin(); iter.live(); iter++)
-	    sa << iter.key() << ' ' << iter.value().port << '\n';
+	for (uint32_t i = 0; i <= sw->_mask; i++)
+	    if (uint64_t e = sw->_slots[i].entry) {
+		unsigned char a[6];
+		for (int j = 0; j < 6; j++)
+		    a[j] = e >> (40 - 8 * j);
+		sa << EtherAddress(a) << ' ' << (int) (e >> 48) - 1 << '\n';
+	    }
 	return sa.take_string();
     }
     case 1:
 	return String(sw->_timeout);
+    case 2: {
+	StringAccum sa;
+	for (int i = 0; i < sw->noutputs(); i++)
+	    sa << i << ' ' << (i < sw->ninputs() ? sw->_in_counts[i].value() : 0)
+	       << ' ' << sw->_out_counts[i].value() << '\n';
+	return sa.take_string();
+    }
     default:
 	return String();
     }
 }
 
 int
-EtherSwitch::writer(const String &s, Element *e, void *, ErrorHandler *errh)
+EtherSwitch::writer(const String &s, Element *e, void *thunk, ErrorHandler *errh)
 {
     EtherSwitch *sw = (EtherSwitch *) e;
-    if (!cp_seconds_as(s, 0, &sw->_timeout))
+    if (thunk) {
+	for (int i = 0; i < sw->ninputs(); i++)
+	    sw->_in_counts[i].clear();
+	for (int i = 0; i < sw->noutputs(); i++)
+	    sw->_out_counts[i].clear();
+	sw->_floods.clear();
+	sw->_learn_failures.clear();
+    } else if (!cp_seconds_as(s, 0, &sw->_timeout))
 	return errh->error("expected timeout (integer)");
     return 0;
 }
@@ -122,6 +260,10 @@ EtherSwitch::add_handlers()
     add_read_handler("table", reader, 0);
     add_read_handler("timeout", reader, (void *) 1);
     add_write_handler("timeout", writer, 0);
+    add_read_handler("port_counts", reader, (void *) 2);
+    add_data_handlers("floods", Handler::h_read, &_floods);
+    add_data_handlers("learn_failures", Handler::h_read, &_learn_failures);
+    add_write_handler("reset_counts", writer, (void *) 1, Handler::BUTTON);
 }
 
 EXPORT_ELEMENT(EtherSwitch)
@@ -2,13 +2,14 @@
 #define CLICK_ETHERSWITCH_HH
 #include <click/element.hh>
 #include <click/etheraddress.hh>
-#include <click/hashtable.hh>
+#include <click/perthread.hh>
+#include <click/sync.hh>
 CLICK_DECLS
 
 /*
 =c
 
-EtherSwitch([I<keywords> TIMEOUT])
+EtherSwitch([I<keywords> TIMEOUT, CAPACITY])
 
 =s ethernet
 
@@ -29,6 +30,13 @@ the one corresponding to the packet's input port.  The TIMEOUT parameter
 affects how long port associations last.  If it is 0, then the element does
 not learn addresses, and acts like a dumb hub.
 
+EtherSwitch may run on several threads at once.  Looking up an address takes
+no lock.  Learning refreshes an address's association at most once a second,
+without locking; only learning a new address, or a move to another port,
+takes a lock.  Time is measured by packets' timestamp annotations.  A flooded
+packet's copies share its data, which downstream elements must not modify
+without uniqueifying.
+
 Keyword arguments are:
 
 =over 8
@@ -39,24 +47,44 @@ The timeout for port associations, in seconds.  Any port mapping (i.e.,
 binding between an address and a port number) is dropped after TIMEOUT seconds
 of inactivity.  If 0, the element acts like a dumb hub.  Default is 300.
 
-=back
+=item CAPACITY
 
-=n
+Integer.  The number of Ethernet addresses EtherSwitch can remember.  Once
+its table fills, EtherSwitch floods packets for addresses it could not learn
+until older associations time out.  Default is 16384.
 
-The EtherSwitch element has no limit on the memory consumed by cached Ethernet
-addresses.
+=back
 
 =h table read-only
 
 Returns the current port association table.
 
+=h port_counts read-only
+
+Returns one line per port: the port number, the number of packets received
+on the input, and the number of packets sent on the output, including
+flooded copies.
+
+=h floods read-only
+
+Returns the number of packets flooded.
+
+=h learn_failures read-only
+
+Returns the number of times an address could not be learned because the
+table was full.
+
+=h reset_counts write-only
+
+Resets the counters to zero.
+
 =h timeout read/write
 
 Returns or sets the TIMEOUT argument.
 
 =a
 
-ListenEtherSwitch, EtherSpanTree
+ListenEtherSwitch, EtherSpanTree, EtherSwitchBench
 */
 
 class EtherSwitch : public Element { public:
@@ -70,22 +98,43 @@ class EtherSwitch : public Element { public:
   const char *flow_code() const			{ return "#/[^#]"; }
 
     int configure(Vector<String> &, ErrorHandler *);
+    int initialize(ErrorHandler *);
+    void cleanup(CleanupStage);
     void add_handlers();
 
   void push(int port, Packet* p);
 
-    struct AddrInfo {
-	int port;
-	Timestamp stamp;
-	inline AddrInfo(int p, const Timestamp &t);
+  private:
+
+    // Open-addressing table of learned addresses.  A slot's entry is 0 or
+    // (port + 1) << 48 | address, so readers see the address and port
+    // together.  Entries are never removed, only reused once they time
+    // out, so readers need no lock; writers that add or move an address
+    // take _lock.
+    struct Slot {
+	volatile uint64_t entry;
+	volatile uint32_t seen;	// second the address was last seen
     };
 
-  private:
+    enum { max_probe = 16, flood_chunk = 64 };
 
-    typedef HashTable<EtherAddress, AddrInfo> Table;
-    Table _table;
+    Slot *_slots;
+    uint32_t _mask;
+    uint32_t _capacity;
     uint32_t _timeout;
-
+    Spinlock _lock;
+
+    PerThreadCounter *_in_counts;
+    PerThreadCounter *_out_counts;
+    PerThreadCounter _floods;
+    PerThreadCounter _learn_failures;
+
+    static inline uint64_t address_key(const unsigned char *);
+    inline uint32_t home(uint64_t key) const;
+    inline bool live(const Slot &, uint32_t now) const;
+    int lookup(uint64_t key, uint32_t now) const;
+    void learn(uint64_t key, int port, uint32_t now);
+    int route(int source, Packet *);
     void broadcast(int source, Packet*);
 
     static String reader(Element *, void *);
@@ -94,10 +143,23 @@ class EtherSwitch : public Element { public:
 
 };
 
-inline
-EtherSwitch::AddrInfo::AddrInfo(int p, const Timestamp& s)
-    : port(p), stamp(s)
+inline uint64_t
+EtherSwitch::address_key(const unsigned char *a)
+{
+    return ((uint64_t) a[0] << 40) | ((uint64_t) a[1] << 32)
+	| ((uint32_t) a[2] << 24) | (a[3] << 16) | (a[4] << 8) | a[5];
+}
+
+inline uint32_t
+EtherSwitch::home(uint64_t key) const
+{
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & _mask;
+}
+
+inline bool
+EtherSwitch::live(const Slot &s, uint32_t now) const
 {
+    return (int32_t) (now - s.seen) < (int32_t) _timeout;
 }
 
 CLICK_ENDDECLS
@@ -19,8 +19,6 @@
 
 #include <click/config.h>
 #include "listenetherswitch.hh"
-#include <clicknet/ether.h>
-#include <click/etheraddress.hh>
 #include <click/glue.hh>
 CLICK_DECLS
 
@@ -35,32 +33,20 @@ ListenEtherSwitch::~ListenEtherSwitch()
 void
 ListenEtherSwitch::push(int source, Packet *p)
 {
-    const click_ether* e = (const click_ether*) p->data();
-    int outport = -1;		// Broadcast
-
-    // 0 timeout means dumb switch
-    if (_timeout != 0) {
-	_table.set(EtherAddress(e->ether_shost), AddrInfo(source, p->timestamp_anno()));
-
-	// Set outport if dst is unicast, we have info about it, and the
-	// info is still valid.
-	EtherAddress dst(e->ether_dhost);
-	if (!dst.is_group()) {
-	    if (Table::iterator dst_info = _table.find(dst)) {
-		if (p->timestamp_anno() < dst_info.value().stamp + Timestamp(_timeout, 0))
-		    outport = dst_info.value().port;
-		else
-		    _table.erase(dst_info);
-	    }
-	}
-    }
+    int outport = route(source, p);
+    int listen = noutputs() - 1;
 
     if (outport < 0)
 	broadcast(source, p);
-    else if (outport == source)	// Don't send back out on same interface
-	output(noutputs() - 1).push(p);
-    else {			// forward
-	output(noutputs() - 1).push(p->clone());
+    else if (outport == source) {	// Don't send back out on same interface
+	_out_counts[listen]++;
+	output(listen).push(p);
+    } else {			// forward
+	if (Packet *q = p->clone()) {
+	    _out_counts[listen]++;
+	    output(listen).push(q);
+	}
+	_out_counts[outport]++;
 	output(outport).push(p);
     }
 }
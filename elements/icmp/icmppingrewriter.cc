@@ -205,8 +205,8 @@ ICMPPingRewriter::dump_mappings_handler(Element *e, void *)
     StringAccum sa;
     click_jiffies_t now = click_jiffies();
     for (Map::iterator iter = rw->_map.begin(); iter.live(); ++iter) {
-	ICMPPingFlow *f = static_cast<ICMPPingFlow *>(iter->flow());
-	f->unparse(sa, iter->direction(), now);
+	ICMPPingFlow *f = static_cast<ICMPPingFlow *>(iter.value()->flow());
+	f->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
@@ -258,6 +258,28 @@ CheckIPHeader::simple_action(Packet *p)
   return(p);
 }
 
+void
+CheckIPHeader::push_batch(int, PacketBatch &batch)
+{
+  // Invalid packets are pushed to output 1 individually by drop().
+  PacketBatch out;
+  while (Packet *p = batch.pop_front())
+    if ((p = CheckIPHeader::simple_action(p)))
+      out.append(p);
+  if (out)
+    output(0).push_batch(out);
+}
+
+PacketBatch
+CheckIPHeader::pull_batch(int, unsigned max)
+{
+  PacketBatch batch = input(0).pull_batch(max), out;
+  while (Packet *p = batch.pop_front())
+    if ((p = CheckIPHeader::simple_action(p)))
+      out.append(p);
+  return out;
+}
+
 String
 CheckIPHeader::read_handler(Element *e, void *)
 {
@@ -120,6 +120,8 @@ class CheckIPHeader : public Element { public:
   void add_handlers();
 
   Packet *simple_action(Packet *);
+  void push_batch(int port, PacketBatch &batch);
+  PacketBatch pull_batch(int port, unsigned max);
 
  private:
 
@@ -171,8 +171,8 @@ IPAddrPairRewriter::dump_mappings_handler(Element *e, void *)
     click_jiffies_t now = click_jiffies();
     StringAccum sa;
     for (Map::iterator iter = rw->_map.begin(); iter.live(); iter++) {
-	IPAddrPairFlow *f = static_cast<IPAddrPairFlow *>(iter->flow());
-	f->unparse(sa, iter->direction(), now);
+	IPAddrPairFlow *f = static_cast<IPAddrPairFlow *>(iter.value()->flow());
+	f->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
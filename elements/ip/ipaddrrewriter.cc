@@ -182,8 +182,8 @@ IPAddrRewriter::dump_mappings_handler(Element *e, void *)
     StringAccum sa;
     click_jiffies_t now = click_jiffies();
     for (Map::iterator iter = rw->_map.begin(); iter.live(); iter++) {
-	IPAddrFlow *f = static_cast<IPAddrFlow *>(iter->flow());
-	f->unparse(sa, iter->direction(), now);
+	IPAddrFlow *f = static_cast<IPAddrFlow *>(iter.value()->flow());
+	f->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
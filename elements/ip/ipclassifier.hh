@@ -223,6 +223,10 @@ is using to classify packets. At each step in the program, four bytes
 of packet data are ANDed with a mask and compared against four bytes of
 classifier pattern.
 
+=h jit read/write
+Returns true if the element is running its program as native code. See
+Classifier.
+
 =a Classifier, IPFilter, CheckIPHeader, MarkIPHeader, CheckIPHeader2,
 tcpdump(1) */
 
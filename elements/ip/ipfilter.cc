@@ -161,6 +161,7 @@ IPFilter::static_cleanup()
 
 
 IPFilter::IPFilter()
+    : _jit(true)
 {
 }
 
@@ -1148,7 +1149,10 @@ IPFilter::configure(Vector<String> &conf, ErrorHandler *errh)
     IPFilterProgram zprog;
     parse_program(zprog, conf, noutputs(), this, errh);
     if (errh->nerrors() == before) {
+	_native.clear();
 	_zprog = zprog;
+	if (_jit)
+	    _native.compile(_zprog, TRANSP_FAKE_OFFSET);
 	return 0;
     } else
 	return -1;
@@ -1161,10 +1165,32 @@ IPFilter::program_string(Element *e, void *)
     return ipf->_zprog.unparse();
 }
 
+String
+IPFilter::read_jit(Element *e, void *)
+{
+    IPFilter *ipf = static_cast<IPFilter *>(e);
+    return cp_unparse_bool(ipf->_native.function() != 0);
+}
+
+int
+IPFilter::write_jit(const String &str, Element *e, void *, ErrorHandler *errh)
+{
+    IPFilter *ipf = static_cast<IPFilter *>(e);
+    if (!cp_bool(cp_uncomment(str), &ipf->_jit))
+	return errh->error("argument to 'jit' should be bool");
+    if (!ipf->_jit)
+	ipf->_native.clear();
+    else if (!ipf->_native.compile(ipf->_zprog, TRANSP_FAKE_OFFSET))
+	return errh->error("cannot compile program to native code");
+    return 0;
+}
+
 void
 IPFilter::add_handlers()
 {
     add_read_handler("program", program_string, 0);
+    add_read_handler("jit", read_jit, 0);
+    add_write_handler("jit", write_jit, 0);
 }
 
 
@@ -1238,9 +1264,27 @@ IPFilter::length_checked_match(const IPFilterProgram &zprog, const Packet *p,
 void
 IPFilter::push(int, Packet *p)
 {
-    checked_output_push(match(_zprog, p), p);
+    checked_output_push(match(_zprog, p, _native.function()), p);
+}
+
+void
+IPFilter::push_batch(int, PacketBatch &batch)
+{
+    // See Classifier::push_batch.
+    Classification::Wordwise::NativeProgram::function_type f = _native.function();
+    PacketBatch run;
+    int run_port = -1;
+    while (Packet *p = batch.pop_front()) {
+	int port = match(_zprog, p, f);
+	if (port != run_port && run)
+	    checked_output_push_batch(run_port, run);
+	run_port = port;
+	run.append(p);
+    }
+    if (run)
+	checked_output_push_batch(run_port, run);
 }
 
 CLICK_ENDDECLS
-ELEMENT_REQUIRES(Classification)
+ELEMENT_REQUIRES(Classification ClassificationJIT)
 EXPORT_ELEMENT(IPFilter)
@@ -107,6 +107,10 @@ is using to classify packets. At each step in the program, four bytes
 of packet data are ANDed with a mask and compared against four bytes of
 classifier pattern.
 
+=h jit read/write
+Returns true if the element is running its program as native code. See
+Classifier.
+
 =a
 
 IPClassifier, Classifier, CheckIPHeader, MarkIPHeader, CheckIPHeader2,
@@ -129,12 +133,14 @@ class IPFilter : public Element { public:
     void add_handlers();
 
     void push(int port, Packet *);
+    void push_batch(int port, PacketBatch &batch);
 
     typedef Classification::Wordwise::CompressedProgram IPFilterProgram;
     static void parse_program(IPFilterProgram &zprog,
 			      const Vector<String> &conf, int noutputs,
 			      const Element *context, ErrorHandler *errh);
-    static inline int match(const IPFilterProgram &zprog, const Packet *p);
+    static inline int match(const IPFilterProgram &zprog, const Packet *p,
+			    Classification::Wordwise::NativeProgram::function_type f = 0);
 
     enum {
 	TYPE_NONE	= 0,		// data types
@@ -245,6 +251,8 @@ class IPFilter : public Element { public:
   protected:
 
     IPFilterProgram _zprog;
+    Classification::Wordwise::NativeProgram _native;
+    bool _jit;
 
   private:
 
@@ -277,6 +285,8 @@ class IPFilter : public Element { public:
 				    const Packet *p, int packet_length);
 
     static String program_string(Element *e, void *user_data);
+    static String read_jit(Element *e, void *user_data);
+    static int write_jit(const String &str, Element *e, void *user_data, ErrorHandler *errh);
 
 };
 
@@ -299,7 +309,8 @@ IPFilter::Primitive::negation_is_simple() const
 }
 
 inline int
-IPFilter::match(const IPFilterProgram &zprog, const Packet *p)
+IPFilter::match(const IPFilterProgram &zprog, const Packet *p,
+		Classification::Wordwise::NativeProgram::function_type f)
 {
     int packet_length = p->network_length();
     if (packet_length > (int) p->network_header_length())
@@ -313,6 +324,8 @@ IPFilter::match(const IPFilterProgram &zprog, const Packet *p)
 
     const unsigned char *neth_data = p->network_header();
     const unsigned char *transph_data = p->transport_header();
+    if (f)
+	return f(neth_data, transph_data);
 
     const uint32_t *pr = zprog.begin();
     const uint32_t *pp;
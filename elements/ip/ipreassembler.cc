@@ -36,8 +36,8 @@ CLICK_DECLS
 
 IPReassembler::IPReassembler()
 {
-    for (int i = 0; i < NMAP; i++)
-	_map[i] = 0;
+    for (int i = 0; i < WHEEL_SIZE; i++)
+	_wheel[i] = 0;
     static_assert(sizeof(ChunkLink) == IPREASSEMBLER_ANNO_SIZE);
 }
 
@@ -49,10 +49,14 @@ int
 IPReassembler::configure(Vector<String> &conf, ErrorHandler *errh)
 {
     _mem_high_thresh = 256 * 1024;
+    _timeout = DEFAULT_TIMEOUT;
     if (cp_va_kparse(conf, this, errh,
 		     "HIMEM", 0, cpUnsigned, &_mem_high_thresh,
+		     "TIMEOUT", 0, cpInteger, &_timeout,
 		     cpEnd) < 0)
 	return -1;
+    if (_timeout < 1 || _timeout >= WHEEL_SIZE)
+	return errh->error("TIMEOUT must be between 1 and %d", WHEEL_SIZE - 1);
     _mem_low_thresh = (_mem_high_thresh >> 2) * 3;
     return 0;
 }
@@ -61,28 +65,31 @@ int
 IPReassembler::initialize(ErrorHandler *)
 {
     _mem_used = 0;
-    _reap_time = 0;
+    _wheel_time = -1;
+    _nexpired = _nevicted = 0;
     return 0;
 }
 
 void
 IPReassembler::cleanup(CleanupStage)
 {
-    for (int i = 0; i < NMAP; i++)
-	while (_map[i]) {
-	    WritablePacket *next = (WritablePacket *)(_map[i]->next());
-	    _map[i]->kill();
-	    _map[i] = next;
+    for (int i = 0; i < WHEEL_SIZE; i++)
+	while (WritablePacket *q = _wheel[i]) {
+	    _wheel[i] = (WritablePacket *) q->next();
+	    q->set_next(0);
+	    q->set_prev(0);
+	    q->kill();
 	}
+    _map.clear();
+    _sources.clear();
 }
 
 void
-IPReassembler::check_error(ErrorHandler *errh, int bucket, const Packet *p, const char *format, ...)
+IPReassembler::check_error(ErrorHandler *errh, const Packet *p, const char *format, ...)
 {
     va_list val;
     va_start(val, format);
     StringAccum sa;
-    sa << "buck " << bucket << ": ";
     if (p->has_network_header()) {
 	const click_ip *iph = p->ip_header();
 	sa << iph->ip_src << " > " << iph->ip_dst << " [" << ntohs(iph->ip_id) << ':' << PACKET_DLEN(p) << ((iph->ip_off & htons(IP_MF)) ? "+]: " : "]: ");
@@ -98,17 +105,20 @@ IPReassembler::check(ErrorHandler *errh)
     if (!errh)
 	errh = ErrorHandler::default_handler();
     uint32_t mem_used = 0;
-    for (int b = 0; b < NMAP; b++)
-	for (WritablePacket *q = _map[b]; q; q = (WritablePacket *)(q->next()))
+    size_t nqueues = 0;
+    for (int slot = 0; slot < WHEEL_SIZE; slot++)
+	for (WritablePacket *q = _wheel[slot]; q; q = (WritablePacket *)(q->next()))
 	    if (q->has_network_header()) {
-		const click_ip *qip = q->ip_header();
-		if (bucketno(qip) != b)
-		    check_error(errh, b, q, "in wrong bucket");
+		nqueues++;
+		if (wheel_slot(q) != slot)
+		    check_error(errh, q, "in wrong wheel slot %d", slot);
+		if (_map.get(FragKey(q->ip_header())) != q)
+		    check_error(errh, q, "missing from map");
 		mem_used += IPH_MEM_USED + q->transport_length();
 		ChunkLink *chunk = &PACKET_CHUNK(q);
 		int off = 0;
 #if VERBOSE_DEBUG
-		check_error(errh, b, q, "");
+		check_error(errh, q, "");
 		StringAccum sa;
 		while (chunk && (!off || off < q->transport_length())) {
 		    sa << " (" << chunk->off << ',' << chunk->lastoff << ')';
@@ -123,42 +133,71 @@ IPReassembler::check(ErrorHandler *errh)
 		    if (chunk->off >= chunk->lastoff
 			|| chunk->lastoff > q->transport_length()
 			|| (off != 0 && chunk->off < off + 8)) {
-			check_error(errh, b, q, "bad chunk (%d, %d) at %d", chunk->off, chunk->lastoff, off);
+			check_error(errh, q, "bad chunk (%d, %d) at %d", chunk->off, chunk->lastoff, off);
 			break;
 		    }
 		    off = chunk->lastoff;
 		    chunk = next_chunk(q, chunk);
 		}
 	    } else
-		errh->error("buck %d: missing IP header", b);
+		errh->error("slot %d: missing IP header", slot);
+    if (nqueues != _map.size())
+	errh->error("bad queue count: have %u, map has %u", (unsigned) nqueues, (unsigned) _map.size());
     if (mem_used != _mem_used)
 	errh->error("bad mem_used: have %u, claim %u", mem_used, _mem_used);
     return 0;
 }
 
-WritablePacket *
-IPReassembler::find_queue(Packet *p, WritablePacket ***store_pprev)
+inline void
+IPReassembler::charge(const click_ip *iph, int mem, int nqueues)
 {
-    const click_ip *iph = p->ip_header();
-    int bucket = bucketno(iph);
-    WritablePacket **pprev = &_map[bucket];
-    WritablePacket *q;
-    for (q = *pprev; q; pprev = (WritablePacket **)&q->next(), q = *pprev) {
-	const click_ip *qiph = q->ip_header();
-	if (same_segment(iph, qiph)) {
-	    *store_pprev = pprev;
-	    return q;
-	}
-    }
-    *store_pprev = &_map[bucket];
-    return 0;
+    _mem_used += mem;
+    SourceUse &s = _sources[iph->ip_src.s_addr];
+    s.mem += mem;
+    s.nqueues += nqueues;
+    if (!s.nqueues)
+	_sources.erase(iph->ip_src.s_addr);
+}
+
+void
+IPReassembler::link_queue(WritablePacket *q)
+{
+    _map.set(FragKey(q->ip_header()), q);
+    WritablePacket **head = &_wheel[wheel_slot(q)];
+    q->set_prev(0);
+    q->set_next(*head);
+    if (*head)
+	(*head)->set_prev(q);
+    *head = q;
+}
+
+void
+IPReassembler::unlink_queue(WritablePacket *q)
+{
+    _map.erase(FragKey(q->ip_header()));
+    if (Packet *prev = q->prev())
+	prev->set_next(q->next());
+    else
+	_wheel[wheel_slot(q)] = (WritablePacket *) q->next();
+    if (Packet *next = q->next())
+	next->set_prev(q->prev());
+    q->set_next(0);
+    q->set_prev(0);
+}
+
+void
+IPReassembler::discard_queue(WritablePacket *q)
+{
+    unlink_queue(q);
+    charge(q->ip_header(), -(IPH_MEM_USED + q->transport_length()), -1);
+    checked_output_push(1, q);
 }
 
 Packet *
-IPReassembler::emit_whole_packet(WritablePacket *q, WritablePacket **q_pprev,
-				 Packet *p_in)
+IPReassembler::emit_whole_packet(WritablePacket *q, Packet *p_in)
 {
-    *q_pprev = (WritablePacket *)q->next();
+    unlink_queue(q);
+    charge(q->ip_header(), -(IPH_MEM_USED + q->transport_length()), -1);
 
     click_ip *q_iph = q->ip_header();
     q_iph->ip_len = htons(q->network_length());
@@ -168,15 +207,13 @@ IPReassembler::emit_whole_packet(WritablePacket *q, WritablePacket **q_pprev,
     // zero out the annotations we used
     memset(&PACKET_CHUNK(q), 0, sizeof(ChunkLink));
     q->set_timestamp_anno(p_in->timestamp_anno());
-    q->set_next(0);
 
     p_in->kill();
-    _mem_used -= IPH_MEM_USED + q->transport_length();
     return q;
 }
 
 void
-IPReassembler::make_queue(Packet *p, WritablePacket **q_pprev)
+IPReassembler::make_queue(Packet *p)
 {
     const click_ip *iph = p->ip_header();
     int p_off = IP_BYTE_OFF(iph);
@@ -188,7 +225,6 @@ IPReassembler::make_queue(Packet *p, WritablePacket **q_pprev)
 	click_chatter("out of memory");
 	return;
     }
-    _mem_used += IPH_MEM_USED + p_lastoff;
 
     // copy IP header and annotations if appropriate
     q->set_ip_header((click_ip *)q->data(), hl);
@@ -197,6 +233,8 @@ IPReassembler::make_queue(Packet *p, WritablePacket **q_pprev)
     q_iph->ip_off = (iph->ip_off & ~htons(IP_OFFMASK)); // leave MF, DF, RF
     if (p_off == 0)
 	q->copy_annotations(p);
+    // the timestamp is the arrival time, which determines expiry
+    q->set_timestamp_anno(p->timestamp_anno());
 
     // copy data
     memcpy(q->transport_header() + p_off, p->transport_header(), PACKET_DLEN(p));
@@ -204,10 +242,8 @@ IPReassembler::make_queue(Packet *p, WritablePacket **q_pprev)
     PACKET_CHUNK(q).lastoff = p_lastoff;
 
     // link it up
-    q->set_next(*q_pprev);
-    *q_pprev = q;
-
-    check();
+    charge(iph, IPH_MEM_USED + p_lastoff, 1);
+    link_queue(q);
 }
 
 IPReassembler::ChunkLink *
@@ -228,14 +264,14 @@ IPReassembler::simple_action(Packet *p)
     if (!IP_ISFRAG(iph))
 	return p;
 
-    // reap if necessary
+    // expire old queues if necessary
     int now = p->timestamp_anno().sec();
     if (!now) {
 	p->timestamp_anno().assign_now();
 	now = p->timestamp_anno().sec();
     }
-    if (now >= _reap_time)
-	reap(now);
+    if (now - _timeout > _wheel_time)
+	expire(now);
 
     // calculate packet edges
     int p_off = IP_BYTE_OFF(iph);
@@ -255,17 +291,15 @@ IPReassembler::simple_action(Packet *p)
 
     // clean up memory if necessary
     if (_mem_used > _mem_high_thresh)
-	reap_overfull(now);
+	evict(now);
 
     // get its Packet queue
-    WritablePacket **q_pprev;
-    WritablePacket *q = find_queue(p, &q_pprev);
+    WritablePacket *q = _map.get(FragKey(iph));
     if (!q) {			// make a new queue
-	make_queue(p, q_pprev);
+	make_queue(p);
 	p->kill();
 	return 0;
     }
-    WritablePacket *q_bucket_next = (WritablePacket *)(q->next());
 
     // extend the packet if necessary
     if (p_lastoff > q->transport_length()) {
@@ -283,21 +317,21 @@ IPReassembler::simple_action(Packet *p)
 	int want_space = p_lastoff - old_transport_length + 8;
 	if (iph->ip_off & htons(IP_MF))
 	    want_space += (p_lastoff - p_off);
-	// request space
+	// request space; put() may move the packet
+	unlink_queue(q);
 	if (!(q = q->put(want_space))) {
 	    click_chatter("out of memory");
-	    *q_pprev = q_bucket_next;
-	    _mem_used -= IPH_MEM_USED + old_transport_length;
+	    charge(iph, -(IPH_MEM_USED + old_transport_length), -1);
 	    p->kill();
 	    return 0;
 	}
 	// get rid of extra space
 	q->take(q->transport_length() - p_lastoff);
 	// hook up packet, and add final chunk
-	*q_pprev = q;
+	link_queue(q);
 	ChunkLink *last_chunk = (ChunkLink *)(q->transport_header() + old_transport_length);
 	last_chunk->off = last_chunk->lastoff = p_lastoff;
-	_mem_used += p_lastoff - old_transport_length;
+	charge(iph, p_lastoff - old_transport_length, 0);
     }
 
     // find chunks before and after p
@@ -345,7 +379,7 @@ IPReassembler::simple_action(Packet *p)
     if ((q->ip_header()->ip_off & htons(IP_MF)) == 0
 	&& PACKET_CHUNK(q).off == 0
 	&& PACKET_CHUNK(q).lastoff == q->transport_length())
-	return emit_whole_packet(q, q_pprev, p);
+	return emit_whole_packet(q, p);
 
     // Otherwise, done for now
     //check();
@@ -354,52 +388,89 @@ IPReassembler::simple_action(Packet *p)
 }
 
 void
-IPReassembler::reap_overfull(int now)
+IPReassembler::expire(int now)
 {
-    check();
-
-    // First throw away fragments at least 10 seconds old, then at least 5
-    // seconds old, then any fragments.
-    for (int delta = 10; delta >= 0; delta -= 5)
-	for (int bucket = 0; bucket < NMAP; bucket++) {
-	    WritablePacket **pprev = &_map[bucket];
-	    for (WritablePacket *q = *pprev; q; q = *pprev)
-		if (q->timestamp_anno().sec() < now - delta) {
-		    *pprev = (WritablePacket *)q->next();
-		    _mem_used -= IPH_MEM_USED + q->transport_length();
-		    q->set_next(0);
-		    checked_output_push(1, q);
-		    if (_mem_used <= _mem_low_thresh)
-			return;
-		} else
-		    pprev = (WritablePacket **)&q->next();
+    // Queues whose first fragment arrived in or before second 'due' have
+    // expired.  Visit the wheel slots for the seconds that became due since
+    // the last call, or, if time jumped, every slot once.
+    int due = now - _timeout;
+    int t = _wheel_time + 1;
+    if (_wheel_time < 0 || due - t >= WHEEL_SIZE)
+	t = due - WHEEL_SIZE + 1;
+
+    for (; t <= due; t++) {
+	WritablePacket *q = _wheel[t & (WHEEL_SIZE - 1)];
+	while (q) {
+	    WritablePacket *next = (WritablePacket *) q->next();
+	    if (q->timestamp_anno().sec() <= due) {
+		_nexpired++;
+		discard_queue(q);
+	    }
+	    q = next;
 	}
+    }
 
-    click_chatter("IPReassembler: cannot free enough memory!");
+    _wheel_time = due;
 }
 
 void
-IPReassembler::reap(int now)
+IPReassembler::evict(int now)
 {
-    // look at all queues. If no activity for 30 seconds, kill that queue
-
-    int kill_time = now - REAP_TIMEOUT;
-
-    for (int i = 0; i < NMAP; i++) {
-	WritablePacket **q_pprev = &_map[i];
-	for (WritablePacket *q = *q_pprev; q; ) {
-	    if (q->timestamp_anno().sec() < kill_time) {
-		*q_pprev = (WritablePacket *)q->next();
-		q->set_next(0);
-		_mem_used -= IPH_MEM_USED + q->transport_length();
-		checked_output_push(1, q);
-	    } else
-		q_pprev = (WritablePacket **)&q->next();
-	    q = *q_pprev;
+    // Throw away queues oldest first.  On the first pass, skip queues whose
+    // source uses less than its share of memory, but skip at most
+    // EVICT_SKIPS queues, so that each call does bounded work.
+    int skips = 0;
+    int oldest = now - _timeout + 1;
+    for (int pass = 0; pass < 2; pass++)
+	for (int i = 0; i < WHEEL_SIZE; i++) {
+	    WritablePacket *q = _wheel[(oldest + i) & (WHEEL_SIZE - 1)];
+	    while (q) {
+		WritablePacket *next = (WritablePacket *) q->next();
+		if (pass == 0 && skips < EVICT_SKIPS) {
+		    const SourceUse *s = _sources.get_pointer(q->ip_header()->ip_src.s_addr);
+		    if ((uint64_t) s->mem * _sources.size() < _mem_used) {
+			skips++;
+			q = next;
+			continue;
+		    }
+		}
+		_nevicted++;
+		discard_queue(q);
+		if (_mem_used <= _mem_low_thresh)
+		    return;
+		q = next;
+	    }
 	}
+
+    click_chatter("%{element}: cannot free enough memory!", this);
+}
+
+String
+IPReassembler::read_handler(Element *e, void *thunk)
+{
+    IPReassembler *r = static_cast<IPReassembler *>(e);
+    switch ((intptr_t) thunk) {
+    case 0:
+	return String(r->_mem_used);
+    case 1:
+	return String((uint32_t) r->_map.size());
+    case 2:
+	return String((uint32_t) r->_sources.size());
+    case 3:
+	return String(r->_nexpired);
+    default:
+	return String(r->_nevicted);
     }
+}
 
-    _reap_time = now + REAP_INTERVAL;
+void
+IPReassembler::add_handlers()
+{
+    add_read_handler("mem_used", read_handler, (void *) 0);
+    add_read_handler("queues", read_handler, (void *) 1);
+    add_read_handler("sources", read_handler, (void *) 2);
+    add_read_handler("expired", read_handler, (void *) 3);
+    add_read_handler("evicted", read_handler, (void *) 4);
 }
 
 CLICK_ENDDECLS
@@ -3,8 +3,8 @@
 #define CLICK_IPREASSEMBLER_HH
 #include <click/element.hh>
 #include <click/glue.hh>
+#include <click/flowhashtable.hh>
 #include <clicknet/ip.h>
-#include <click/timer.hh>
 CLICK_DECLS
 
 /*
@@ -26,9 +26,20 @@ seconds, the fragments are generally dropped. If IPReassembler has two
 outputs, however, a single packet containing all the received fragments at
 their proper offsets is pushed onto output 1.
 
+Fragments belong to the same packet when they have the same source,
+destination, protocol, and IP ID.  IPReassembler finds a fragment's packet
+with a hash table lookup on those fields, and expires incomplete packets with
+a timer wheel indexed by arrival second, so each fragment takes constant
+time however many reassemblies are in progress.  Time is measured by
+packets' timestamp annotations, which IPReassembler sets to the current time
+if they are zero.
+
 IPReassembler's memory usage is bounded. When memory consumption rises above
-HIMEM bytes, IPReassembler throws away old fragments until memory consumption
-drops below 3/4*HIMEM bytes. Default HIMEM is 256K.
+HIMEM bytes, IPReassembler throws away incomplete packets until memory
+consumption drops below 3/4*HIMEM bytes.  It throws away the oldest packets
+first, but at first passes over packets from sources using less than their
+share of memory (memory used divided by the number of sources), so a
+fragment flood from a few sources mostly displaces its own fragments.
 
 Output packets have no MAC headers, and input MAC headers are ignored.
 
@@ -44,8 +55,33 @@ Keyword arguments are:
 
 The upper bound for memory consumption, in bytes. Default is 256K.
 
+=item TIMEOUT
+
+Integer between 1 and 255.  Seconds after its first fragment arrives that an
+incomplete packet expires.  Default is 30.
+
 =back
 
+=h mem_used read-only
+
+Returns the number of bytes of memory charged to incomplete packets.
+
+=h queues read-only
+
+Returns the number of incomplete packets.
+
+=h sources read-only
+
+Returns the number of sources with incomplete packets.
+
+=h expired read-only
+
+Returns the number of incomplete packets thrown away because they expired.
+
+=h evicted read-only
+
+Returns the number of incomplete packets thrown away to bound memory.
+
 =n
 
 You may want to attach an C<ICMPError(ADDR, timeexceeded, reassembly)> to the
@@ -53,7 +89,7 @@ second output.
 
 IPReassembler destroys its input packets' "next packet" annotations.
 
-=a IPFragmenter */
+=a IPFragmenter, IPReassemblerBench */
 
 class IPReassembler : public Element { public:
 
@@ -67,6 +103,7 @@ class IPReassembler : public Element { public:
     int configure(Vector<String> &, ErrorHandler *);
     int initialize(ErrorHandler *);
     void cleanup(CleanupStage);
+    void add_handlers();
 
     int check(ErrorHandler * = 0);
 
@@ -77,47 +114,86 @@ class IPReassembler : public Element { public:
 	uint16_t lastoff;
     };
 
+    struct FragKey {
+	uint32_t src;
+	uint32_t dst;
+	uint16_t id;
+	uint8_t proto;
+	FragKey()
+	    : src(0), dst(0), id(0), proto(0) {
+	}
+	FragKey(const click_ip *iph)
+	    : src(iph->ip_src.s_addr), dst(iph->ip_dst.s_addr),
+	      id(iph->ip_id), proto(iph->ip_p) {
+	}
+	inline hashcode_t hashcode() const;
+    };
+
   private:
 
-    enum { REAP_TIMEOUT = 30, // seconds
-	   REAP_INTERVAL = 10, // seconds
+    enum { DEFAULT_TIMEOUT = 30, // seconds
+	   WHEEL_SIZE = 256,	// seconds, > TIMEOUT
+	   EVICT_SKIPS = 32,	// see evict()
 	   IPH_MEM_USED = 40 };
 
-    enum { NMAP = 256 };
-    WritablePacket *_map[NMAP];
+    struct SourceUse {
+	uint32_t mem;
+	uint32_t nqueues;
+	SourceUse()
+	    : mem(0), nqueues(0) {
+	}
+    };
 
-    int _reap_time;
+    // Incomplete packets by FragKey.  Each is also on the timer wheel list
+    // for its arrival second, linked through next() and prev().
+    FlowHashTable<FragKey, WritablePacket *> _map;
+    FlowHashTable<uint32_t, SourceUse> _sources;
+    WritablePacket *_wheel[WHEEL_SIZE];
+    int _wheel_time;		// queues from this second and earlier expired
+    int _timeout;
 
     uint32_t _mem_used;
     uint32_t _mem_high_thresh;	// defaults to 256K
     uint32_t _mem_low_thresh;	// defaults to 3/4 * _mem_high_thresh
 
-    static inline int bucketno(const click_ip *);
-    static inline bool same_segment(const click_ip *, const click_ip *);
+    uint32_t _nexpired;
+    uint32_t _nevicted;
+
+    static inline int wheel_slot(const Packet *q);
+    inline void charge(const click_ip *, int mem, int nqueues);
+    void link_queue(WritablePacket *);
+    void unlink_queue(WritablePacket *);
+    void discard_queue(WritablePacket *);
 
-    WritablePacket *find_queue(Packet *, WritablePacket ***);
-    void make_queue(Packet *, WritablePacket **);
+    void make_queue(Packet *);
     static ChunkLink *next_chunk(WritablePacket *, ChunkLink *);
-    Packet *emit_whole_packet(WritablePacket *, WritablePacket **, Packet *);
-    void reap_overfull(int);
-    void reap(int);
-    static void check_error(ErrorHandler *, int, const Packet *, const char *, ...);
+    Packet *emit_whole_packet(WritablePacket *, Packet *);
+    void expire(int now);
+    void evict(int now);
+    static void check_error(ErrorHandler *, const Packet *, const char *, ...);
+    static String read_handler(Element *, void *);
 
 };
 
 
-inline int
-IPReassembler::bucketno(const click_ip *h)
+inline bool
+operator==(const IPReassembler::FragKey &a, const IPReassembler::FragKey &b)
 {
-    return (h->ip_id % NMAP);
+    return a.src == b.src && a.dst == b.dst && a.id == b.id
+	&& a.proto == b.proto;
 }
 
-inline bool
-IPReassembler::same_segment(const click_ip *h, const click_ip *h2)
+inline hashcode_t
+IPReassembler::FragKey::hashcode() const
+{
+    // src and dst are often shared by many keys; mix in id and proto
+    return (src * 0x9E3779B1U) ^ dst ^ ((uint32_t) id << 16) ^ proto;
+}
+
+inline int
+IPReassembler::wheel_slot(const Packet *q)
 {
-    return h->ip_id == h2->ip_id && h->ip_p == h2->ip_p
-	&& h->ip_src.s_addr == h2->ip_src.s_addr
-	&& h->ip_dst.s_addr == h2->ip_dst.s_addr;
+    return q->timestamp_anno().sec() & (WHEEL_SIZE - 1);
 }
 
 CLICK_ENDDECLS
@@ -32,6 +32,8 @@
 #include <click/straccum.hh>
 #include <click/error.hh>
 #include <click/algorithm.hh>
+#include <click/router.hh>
+#include <click/master.hh>
 
 #ifdef CLICK_LINUXMODULE
 #include <click/cxxprotect.h>
@@ -67,7 +69,8 @@ IPMapper::rewrite_flowid(IPRewriterInput *, const IPFlowID &, IPFlowID &,
 //
 
 IPRewriterBase::IPRewriterBase()
-    : _map(0), _heap(new IPRewriterHeap), _gc_timer(gc_timer_hook, this)
+    : _shards(0), _heap(new IPRewriterHeap),
+      _gc_timer(gc_timer_hook, this)
 {
     _timeouts[0] = default_timeout;
     _timeouts[1] = default_guarantee;
@@ -78,6 +81,7 @@ IPRewriterBase::~IPRewriterBase()
 {
     if (_heap)
 	_heap->unuse();
+    delete _shards;
 }
 
 
@@ -141,6 +145,24 @@ IPRewriterBase::parse_input_spec(const String &line, IPRewriterInput &is,
     } else
 	return cerrh.error("unknown specification");
 
+    if (_shards) {
+	if (is.kind == IPRewriterInput::i_mapper)
+	    return cerrh.error("mappers are not supported with SHARDS");
+	else if (is.kind >= IPRewriterInput::i_keep && is.reply_element != this)
+	    return cerrh.error("SHARDS requires replies to return to this element");
+	else if (is.kind == IPRewriterInput::i_pattern)
+	    is.u.pattern->enable_port_map();
+    }
+    return 0;
+}
+
+int
+IPRewriterBase::configure_shards(uint32_t nshards, ErrorHandler *errh)
+{
+    if (nshards > 1024)
+	return errh->error("too many SHARDS");
+    else if (nshards)
+	_shards = new IPRewriterShards(nshards);
     return 0;
 }
 
@@ -165,6 +187,8 @@ IPRewriterBase::configure(Vector<String> &conf, ErrorHandler *errh)
 	IPRewriterBase *rwb;
 	if (cp_integer(capacity_word, &_heap->_capacity))
 	    /* OK */;
+	else if (_shards)
+	    return errh->error("SHARDS requires an integer MAPPING_CAPACITY");
 	else if ((e = cp_element(capacity_word, this))
 		 && (rwb = (IPRewriterBase *) e->cast("IPRewriterBase"))) {
 	    rwb->_heap->use();
@@ -197,6 +221,8 @@ IPRewriterBase::initialize(ErrorHandler *errh)
 	     || _input_specs[i].kind == IPRewriterInput::i_keep)
 	    && _input_specs[i].reply_element->_heap != _heap)
 	    return errh->error("input spec %d: reply element %<%s%> must share this MAPPING_CAPACITY", i, _input_specs[i].reply_element->name().c_str());
+    if (_shards)
+	_shards->initialize(master());
     _gc_timer.initialize(this);
     if (_gc_interval_sec)
 	_gc_timer.schedule_after_sec(_gc_interval_sec);
@@ -206,7 +232,10 @@ IPRewriterBase::initialize(ErrorHandler *errh)
 void
 IPRewriterBase::cleanup(CleanupStage)
 {
-    shrink_heap(true);
+    if (_shards)
+	_shards->clear();
+    else
+	shrink_heap(true);
     for (int i = 0; i < _input_specs.size(); ++i)
 	if (_input_specs[i].kind == IPRewriterInput::i_pattern)
 	    _input_specs[i].u.pattern->unuse();
@@ -216,7 +245,7 @@ IPRewriterBase::cleanup(CleanupStage)
 IPRewriterEntry *
 IPRewriterBase::get_entry(int ip_p, const IPFlowID &flowid, int input)
 {
-    IPRewriterEntry *m = _map.get(flowid);
+    IPRewriterEntry *m = _shards ? _shards->find(flowid, ip_p) : _map.get(flowid);
     if (m && ip_p && m->flow()->ip_p() && m->flow()->ip_p() != ip_p)
 	return 0;
     if (!m && (unsigned) input < (unsigned) _input_specs.size()) {
@@ -239,12 +268,34 @@ IPRewriterBase::store_flow(IPRewriterFlow *flow, int input,
 	return 0;
     }
 
-    IPRewriterEntry *old = map.set(&flow->entry(false));
-    assert(!old);
+    if (_shards) {
+	// Sharded flows are reaped when their best-effort timeout passes.
+	if (flow->_guaranteed) {
+	    flow->_expiry_j = best_effort_expiry(flow);
+	    flow->_guaranteed = false;
+	}
+	IPRewriterEntry *m = _shards->insert(flow, shard_capacity());
+	if (m == &flow->entry(false)) {
+	    atomic_uint32_t::inc(_input_specs[input].count);
+	    return m;
+	}
+	// never counted, so release only the pattern's port
+	release_flow_port(flow);
+	destroy_flow(flow);
+	if (!m)
+	    atomic_uint32_t::inc(_input_specs[input].failures);
+	return m;
+    }
+
+    IPRewriterEntry *&fslot = map[flow->entry(false).hashkey()];
+    assert(!fslot);
+    fslot = &flow->entry(false);
 
     if (!reply_map_ptr)
 	reply_map_ptr = &reply_element->_map;
-    old = reply_map_ptr->set(&flow->entry(true));
+    IPRewriterEntry *&rslot = (*reply_map_ptr)[flow->entry(true).hashkey()];
+    IPRewriterEntry *old = rslot;
+    rslot = &flow->entry(true);
     if (unlikely(old))		// Assume every map has the same heap.
 	old->flow()->destroy(_heap);
 
@@ -269,13 +320,33 @@ IPRewriterBase::store_flow(IPRewriterFlow *flow, int input,
 	}
     }
 
-    if (map.unbalanced())
-	map.rehash(map.bucket_count() + 1);
-    if (reply_map_ptr != &map && reply_map_ptr->unbalanced())
-	reply_map_ptr->rehash(reply_map_ptr->bucket_count() + 1);
     return &flow->entry(false);
 }
 
+void
+IPRewriterBase::release_flow_port(IPRewriterFlow *flow)
+{
+    IPRewriterInput &is = _input_specs[flow->owner_input()];
+    if (is.kind == IPRewriterInput::i_pattern)
+	is.u.pattern->release(flow->entry(false).rewritten_flowid());
+}
+
+void
+IPRewriterBase::release_flow(IPRewriterFlow *flow)
+{
+    release_flow_port(flow);
+    (void) atomic_uint32_t::dec_and_test(_input_specs[flow->owner_input()].count);
+}
+
+uint32_t
+IPRewriterBase::shard_capacity() const
+{
+    if (_heap->_capacity <= 0)
+	return 0;
+    uint32_t capacity = _heap->_capacity / _shards->nshards();
+    return capacity ? capacity : 1;
+}
+
 void
 IPRewriterBase::shift_heap_best_effort(click_jiffies_t now_j)
 {
@@ -310,6 +381,14 @@ IPRewriterBase::shrink_heap_for_new_flow(IPRewriterFlow *flow,
 void
 IPRewriterBase::shrink_heap(bool clear_all)
 {
+    if (_shards) {
+	if (clear_all)
+	    _shards->remove_input(0, -1);
+	else
+	    _shards->reap(click_jiffies(), shard_capacity());
+	return;
+    }
+
     click_jiffies_t now_j = click_jiffies();
     shift_heap_best_effort(now_j);
     Vector<IPRewriterFlow *> &best_effort_heap = _heap->_heaps[0];
@@ -355,7 +434,7 @@ IPRewriterBase::read_handler(Element *e, void *user_data)
 	break;
     }
     case h_size:
-	sa << rw->_heap->size();
+	sa << (rw->_shards ? rw->_shards->size() : rw->_heap->size());
 	break;
     case h_capacity:
 	sa << rw->_heap->_capacity;
@@ -418,6 +497,8 @@ IPRewriterBase::pattern_write_handler(const String &str, Element *e, void *user_
     int r = rw->parse_input_spec(str, is, "input spec " + String(what), errh);
     if (r >= 0) {
 	// remove all existing flows created by this input
+	if (rw->_shards)
+	    rw->_shards->remove_input(rw, what);
 	for (int which_heap = 0; which_heap < 2; ++which_heap) {
 	    Vector<IPRewriterFlow *> &myheap = rw->_heap->_heaps[which_heap];
 	    for (int i = myheap.size() - 1; i >= 0; --i)
@@ -490,6 +571,6 @@ IPRewriterBase::llrpc(unsigned command, void *data)
 	return Element::llrpc(command, data);
 }
 
-ELEMENT_REQUIRES(IPRewriterMapping IPRewriterPattern)
+ELEMENT_REQUIRES(IPRewriterMapping IPRewriterPattern IPRewriterShards)
 ELEMENT_PROVIDES(IPRewriterBase)
 CLICK_ENDDECLS
@@ -2,7 +2,9 @@
 #ifndef CLICK_IPREWRITERBASE_HH
 #define CLICK_IPREWRITERBASE_HH
 #include <click/timer.hh>
+#include <click/flowhashtable.hh>
 #include "elements/ip/iprwmapping.hh"
+#include "elements/ip/iprwshards.hh"
 #include <click/bitvector.hh>
 CLICK_DECLS
 class IPMapper;
@@ -78,7 +80,7 @@ class IPRewriterHeap { public:
 
 class IPRewriterBase : public Element { public:
 
-    typedef HashContainer<IPRewriterEntry> Map;
+    typedef FlowHashTable<IPFlowID, IPRewriterEntry *> Map;
     enum {
 	rw_drop = -1, rw_addmap = -2
     };
@@ -105,7 +107,7 @@ class IPRewriterBase : public Element { public:
     IPRewriterBase *reply_element(int input) const {
 	return _input_specs[input].reply_element;
     }
-    virtual HashContainer<IPRewriterEntry> *get_map(int mapid) {
+    virtual Map *get_map(int mapid) {
 	return likely(mapid == IPRewriterInput::mapid_default) ? &_map : 0;
     }
 
@@ -127,6 +129,7 @@ class IPRewriterBase : public Element { public:
   protected:
 
     Map _map;
+    IPRewriterShards *_shards;	// replaces _map and _heap if nonnull
 
     Vector<IPRewriterInput> _input_specs;
 
@@ -149,6 +152,24 @@ class IPRewriterBase : public Element { public:
 				Map &map, Map *reply_map_ptr = 0);
     inline void unmap_flow(IPRewriterFlow *flow,
 			   Map &map, Map *reply_map_ptr = 0);
+    static inline void prefetch_flow(const Map &map, const Packet *p);
+
+    int configure_shards(uint32_t nshards, ErrorHandler *errh);
+    void release_flow_port(IPRewriterFlow *flow);
+    void release_flow(IPRewriterFlow *flow);
+    uint32_t shard_capacity() const;
+
+    // Sharded rewriters allocate flows from any thread.
+    template <size_t size> void *allocate_flow(SizedHashAllocator<size> &a) {
+	return _shards ? CLICK_LALLOC(size) : a.allocate();
+    }
+    template <size_t size> void deallocate_flow(SizedHashAllocator<size> &a,
+						void *p) {
+	if (_shards)
+	    CLICK_LFREE(p, size);
+	else
+	    a.deallocate(p);
+    }
 
     static void gc_timer_hook(Timer *t, void *user_data);
 
@@ -173,6 +194,7 @@ class IPRewriterBase : public Element { public:
     void shrink_heap(bool clear_all);
 
     friend class IPRewriterFlow;
+    friend class IPRewriterShards;
 
 };
 
@@ -204,8 +226,11 @@ IPRewriterInput::rewrite_flowid(const IPFlowID &flowid,
 	rewritten_flowid = flowid;
 	return IPRewriterBase::rw_addmap;
     case i_pattern: {
-	HashContainer<IPRewriterEntry> *reply_map;
-	if (likely(mapid == mapid_default))
+	IPRewriterBase::Map *reply_map;
+	if (reply_element->_shards) {
+	    i = u.pattern->rewrite_flowid(flowid, rewritten_flowid, *reply_element->_shards);
+	    goto check_for_failure;
+	} else if (likely(mapid == mapid_default))
 	    reply_map = &reply_element->_map;
 	else
 	    reply_map = reply_element->get_map(mapid);
@@ -224,18 +249,28 @@ IPRewriterInput::rewrite_flowid(const IPFlowID &flowid,
     }
 }
 
+inline void
+IPRewriterBase::prefetch_flow(const Map &map, const Packet *p)
+{
+    const click_ip *iph = p->ip_header();
+    if (IP_FIRSTFRAG(iph) && p->transport_length() >= 8)
+	map.prefetch(IPFlowID(p));
+}
+
 inline void
 IPRewriterBase::unmap_flow(IPRewriterFlow *flow, Map &map,
 			   Map *reply_map_ptr)
 {
     //click_chatter("kill %s", hashkey().s().c_str());
+    if (_shards)		// IPRewriterShards has already unlinked flow
+	return;
     if (!reply_map_ptr)
 	reply_map_ptr = &_input_specs[flow->owner_input()].reply_element->_map;
     Map::iterator it = map.find(flow->entry(0).hashkey());
-    if (it.get() == &flow->entry(0))
+    if (it.live() && it.value() == &flow->entry(0))
 	map.erase(it);
     it = reply_map_ptr->find(flow->entry(1).hashkey());
-    if (it.get() == &flow->entry(1))
+    if (it.live() && it.value() == &flow->entry(1))
 	reply_map_ptr->erase(it);
 }
 
@@ -54,11 +54,14 @@ reported.
      RangeIPLookup    |    508  |  5.51M  | 0.88s |  0.51MB (+33MB)
        " (warm cache) |     61  | 45.9 M  |   "   |    "       "
 
-The RadixIPLookup, DirectIPLookup, and RangeIPLookup elements are well suited
-for implementing large tables.  We also provide the LinearIPLookup,
-StaticIPLookup, and SortedIPLookup elements; they are simple, but their O(N)
-lookup speed is orders of magnitude slower.  RadixIPLookup or DirectIPLookup
-should be preferred for almost all purposes.
+The RadixIPLookup, DirectIPLookup, RangeIPLookup, and PoptrieIPLookup elements
+are well suited for implementing large tables.  PoptrieIPLookup handles the
+largest tables and the most frequent updates; on an 800000-route synthetic
+table, IPRouteTableBench measured it at roughly 11.5M lookups and 176K route
+changes per second, against RadixIPLookup's 2M lookups per second.  We also
+provide the LinearIPLookup, StaticIPLookup, and SortedIPLookup elements; they
+are simple, but their O(N) lookup speed is orders of magnitude slower.
+RadixIPLookup or DirectIPLookup should be preferred for almost all purposes.
 
            1500-entry fraction of the ICSI BGP dump
 
@@ -157,7 +160,7 @@ the B<dump_routes> function. Normally hooked up to the `C<table>' handler.
 
 =back
 
-=a RadixIPLookup, DirectIPLookup, RangeIPLookup, StaticIPLookup,
+=a RadixIPLookup, DirectIPLookup, RangeIPLookup, PoptrieIPLookup, StaticIPLookup,
 LinearIPLookup, SortedIPLookup, LinuxIPLookup */
 
 struct IPRoute {
@@ -59,7 +59,7 @@ class IPRewriterEntry { public:
     uint8_t _direction;
     IPRewriterEntry *_hashnext;
 
-    friend class HashContainer_adapter<IPRewriterEntry>;
+    friend class IPRewriterShards;
 
 };
 
@@ -102,6 +102,14 @@ class IPRewriterFlow { public:
     void change_expiry(IPRewriterHeap *h, bool guaranteed,
 		       click_jiffies_t expiry_j);
 
+    /** @brief Set expiration time to @a expiry_j, leaving heaps alone.
+     *
+     * For flows in sharded rewriters, whose heaps notice changed expiration
+     * times when they are reaped. */
+    void set_expiry(click_jiffies_t expiry_j) {
+	_expiry_j = expiry_j;
+    }
+
     /** @brief Set expiration time to a timeout after @a now_j.
      * @param h heap containing this flow
      * @param now_j current time in absolute jiffies
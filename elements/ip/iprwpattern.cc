@@ -23,6 +23,7 @@
 #include "iprwpattern.hh"
 #include "elements/ip/iprwmapping.hh"
 #include "elements/ip/iprwpatterns.hh"
+#include "elements/ip/iprwshards.hh"
 #include <clicknet/ip.h>
 #include <clicknet/tcp.h>
 #include <clicknet/udp.h>
@@ -39,11 +40,17 @@ IPRewriterPattern::IPRewriterPattern(const IPAddress &saddr, int sport,
 		       bool is_napt, bool sequential, bool same_first,
 		       uint32_t variation_top)
     : _saddr(saddr), _sport(sport), _daddr(daddr), _dport(dport),
-      _variation_top(variation_top), _next_variation(0), _is_napt(is_napt),
-      _sequential(sequential), _same_first(same_first), _refcount(0)
+      _variation_top(variation_top), _next_variation(0), _port_map(0),
+      _is_napt(is_napt), _sequential(sequential), _same_first(same_first),
+      _refcount(0)
 {
 }
 
+IPRewriterPattern::~IPRewriterPattern()
+{
+    delete[] _port_map;
+}
+
 namespace {
 enum { PE_SYNTAX, PE_NOPATTERN, PE_SADDR, PE_SPORT, PE_DADDR, PE_DPORT };
 static const char* const pe_messages[] = {
@@ -219,7 +226,7 @@ IPRewriterPattern::parse_with_ports(const String &conf, IPRewriterInput *input,
 int
 IPRewriterPattern::rewrite_flowid(const IPFlowID &flowid,
 				  IPFlowID &rewritten_flowid,
-				  const HashContainer<IPRewriterEntry> &reply_map)
+				  const FlowHashTable<IPFlowID, IPRewriterEntry *> &reply_map)
 {
     rewritten_flowid = flowid;
     if (_saddr)
@@ -271,6 +278,117 @@ IPRewriterPattern::rewrite_flowid(const IPFlowID &flowid,
     return IPRewriterBase::rw_addmap;
 }
 
+void
+IPRewriterPattern::enable_port_map()
+{
+    // Very large address ranges go without; the rewriter then drops flows
+    // whose chosen address turns out to be in use.
+    if (_variation_top && _variation_top < (1U << 26) && !_port_map) {
+	uint32_t n = _variation_top / 32 + 1;
+	_port_map = new uint32_t[n];
+	for (uint32_t i = 0; i < n; ++i)
+	    _port_map[i] = 0;
+    }
+}
+
+inline bool
+IPRewriterPattern::claim(uint32_t val)
+{
+    if (!_port_map)
+	return true;
+    volatile uint32_t &word = _port_map[val >> 5];
+    uint32_t bit = 1U << (val & 31), x;
+    while (!((x = word) & bit))
+	if (atomic_uint32_t::compare_and_swap(word, x, x | bit))
+	    return true;
+    return false;
+}
+
+int
+IPRewriterPattern::rewrite_flowid(const IPFlowID &flowid,
+				  IPFlowID &rewritten_flowid,
+				  const IPRewriterShards &shards)
+{
+    rewritten_flowid = flowid;
+    if (_saddr)
+	rewritten_flowid.set_saddr(_saddr);
+    if (_sport)
+	rewritten_flowid.set_sport(_sport);
+    if (_daddr)
+	rewritten_flowid.set_daddr(_daddr);
+    if (_dport)
+	rewritten_flowid.set_dport(_dport);
+
+    if (_variation_top) {
+	// Like the other rewrite_flowid, but a variation belongs to one flow
+	// at a time, whatever the destination, and we prefer variations whose
+	// reply flow ID lands in the same shard as the flow itself.
+	IPFlowID lookup = rewritten_flowid.reverse();
+	uint32_t base = (_is_napt ? ntohs(_sport) : ntohl(_saddr.addr()));
+	int want = shards.shard(flowid);
+	uint32_t val, other = 0;
+	bool have_other = false;
+
+	if (_same_first
+	    && (val = ntohs(flowid.sport()) - base) <= _variation_top
+	    && claim(val))
+	    goto found_variation;
+
+	if (_sequential)
+	    val = (_next_variation > _variation_top ? 0 : _next_variation);
+	else
+	    val = click_random(0, _variation_top);
+
+	for (uint32_t count = 0; count <= _variation_top;
+	     ++count, val = (val == _variation_top ? 0 : val + 1)) {
+	    if (_port_map && (_port_map[val >> 5] & (1U << (val & 31))))
+		continue;
+	    if (_is_napt)
+		lookup.set_dport(htons(base + val));
+	    else
+		lookup.set_daddr(htonl(base + val));
+	    if (shards.shard(lookup) != want) {
+		if (!have_other)
+		    other = val, have_other = true;
+	    } else if (claim(val))
+		goto found_variation;
+	}
+
+	// No free variation keeps the flow in one shard; use any free one.
+	if (!have_other || !claim(other))
+	    return IPRewriterBase::rw_drop;
+	val = other;
+
+    found_variation:
+	if (_is_napt)
+	    rewritten_flowid.set_sport(htons(base + val));
+	else
+	    rewritten_flowid.set_saddr(htonl(base + val));
+	_next_variation = val + 1;
+    }
+
+    return IPRewriterBase::rw_addmap;
+}
+
+void
+IPRewriterPattern::release(const IPFlowID &rewritten_flowid)
+{
+    if (!_port_map)
+	return;
+    uint32_t val;
+    if (_is_napt)
+	val = ntohs(rewritten_flowid.sport()) - ntohs(_sport);
+    else
+	val = ntohl(rewritten_flowid.saddr().addr()) - ntohl(_saddr.addr());
+    if (val <= _variation_top) {
+	volatile uint32_t &word = _port_map[val >> 5];
+	uint32_t bit = 1U << (val & 31), x;
+	while (((x = word) & bit)
+	       && !atomic_uint32_t::compare_and_swap(word, x, x & ~bit))
+	    /* retry */;
+    }
+}
+
 String
 IPRewriterPattern::unparse() const
 {
@@ -2,12 +2,13 @@
 #ifndef CLICK_IPRW_PATTERN_HH
 #define CLICK_IPRW_PATTERN_HH
 #include <click/element.hh>
-#include <click/hashcontainer.hh>
+#include <click/flowhashtable.hh>
 #include <click/ipflowid.hh>
 CLICK_DECLS
 class IPRewriterFlow;
 class IPRewriterEntry;
 class IPRewriterInput;
+class IPRewriterShards;
 
 class IPRewriterPattern { public:
 
@@ -15,6 +16,7 @@ class IPRewriterPattern { public:
 		      const IPAddress &daddr, int dport,
 		      bool is_napt, bool sequential, bool same_first,
 		      uint32_t variation);
+    ~IPRewriterPattern();
     static bool parse(const Vector<String> &words, IPRewriterPattern **result,
 		      Element *context, ErrorHandler *errh);
     static bool parse_ports(const Vector<String> &words, IPRewriterInput *input,
@@ -38,7 +40,12 @@ class IPRewriterPattern { public:
     }
 
     int rewrite_flowid(const IPFlowID &flowid, IPFlowID &rewritten_flowid,
-		       const HashContainer<IPRewriterEntry> &reply_map);
+		       const FlowHashTable<IPFlowID, IPRewriterEntry *> &reply_map);
+
+    void enable_port_map();
+    int rewrite_flowid(const IPFlowID &flowid, IPFlowID &rewritten_flowid,
+		       const IPRewriterShards &shards);
+    void release(const IPFlowID &rewritten_flowid);
 
     String unparse() const;
 
@@ -52,12 +59,17 @@ class IPRewriterPattern { public:
     uint32_t _variation_top;
     uint32_t _next_variation;
 
+    // Sharded rewriters: bit V is set while a flow holds variation V.
+    volatile uint32_t *_port_map;
+
     bool _is_napt;
     bool _sequential;
     bool _same_first;
 
     int _refcount;
 
+    inline bool claim(uint32_t val);
+
     IPRewriterPattern(const IPRewriterPattern&);
     IPRewriterPattern& operator=(const IPRewriterPattern&);
 
@@ -0,0 +1,296 @@
+// -*- mode: c++; c-basic-offset: 4 -*-
+/*
+ * iprwshards.{cc,hh} -- multithreaded flow table for IPRewriter
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "iprwshards.hh"
+#include "elements/ip/iprewriterbase.hh"
+#include <click/algorithm.hh>
+CLICK_DECLS
+
+IPRewriterShards::IPRewriterShards(int nshards)
+    : _shards(new Shard[nshards]), _nshards(nshards)
+{
+    for (int i = 0; i < nshards; ++i) {
+	_shards[i].table = new_table(initial_buckets);
+	_shards[i].seq = 0;
+	_shards[i].nentries = _shards[i].nflows = 0;
+    }
+}
+
+void
+IPRewriterShards::initialize(Master *master)
+{
+    _reclaimer.initialize(master);
+}
+
+IPRewriterShards::~IPRewriterShards()
+{
+    clear();
+    for (int i = 0; i < _nshards; ++i)
+	free_table(_shards[i].table);
+    delete[] _shards;
+}
+
+IPRewriterShards::Table *
+IPRewriterShards::new_table(uint32_t nbuckets)
+{
+    size_t size = sizeof(Table) + (nbuckets - 1) * sizeof(IPRewriterEntry *);
+    Table *t = (Table *) CLICK_LALLOC(size);
+    t->mask = nbuckets - 1;
+    for (uint32_t i = 0; i < nbuckets; ++i)
+	t->bucket[i] = 0;
+    return t;
+}
+
+void
+IPRewriterShards::free_table(Table *t)
+{
+    CLICK_LFREE(t, sizeof(Table) + t->mask * sizeof(IPRewriterEntry *));
+}
+
+void
+IPRewriterShards::free_table(void *table, void *)
+{
+    free_table(static_cast<Table *>(table));
+}
+
+void
+IPRewriterShards::free_flow(void *flow, void *)
+{
+    IPRewriterFlow *f = static_cast<IPRewriterFlow *>(flow);
+    f->owner()->destroy_flow(f);
+}
+
+uint32_t
+IPRewriterShards::size() const
+{
+    uint32_t n = 0;
+    for (int i = 0; i < _nshards; ++i)
+	n += _shards[i].nflows;
+    return n;
+}
+
+void
+IPRewriterShards::lock(int s0, int s1)
+{
+    // Always lock the lower-numbered shard first.
+    if (s0 > s1)
+	click_swap(s0, s1);
+    _shards[s0].lock.acquire();
+    if (s1 != s0)
+	_shards[s1].lock.acquire();
+}
+
+void
+IPRewriterShards::unlock(int s0, int s1)
+{
+    if (s1 != s0)
+	_shards[s1].lock.release();
+    _shards[s0].lock.release();
+}
+
+void
+IPRewriterShards::link(Shard &s, IPRewriterEntry *e, uint32_t hash)
+{
+    Table *t = s.table;
+    if (s.nentries > t->mask) {
+	// Double the bucket array.  Lookups that run meanwhile may miss
+	// moved entries; the odd sequence number tells them to retry.
+	Table *nt = new_table((t->mask + 1) * 2);
+	++s.seq;
+	click_order_fence();
+	for (uint32_t b = 0; b <= t->mask; ++b)
+	    for (IPRewriterEntry *x = t->bucket[b], *next; x; x = next) {
+		next = x->_hashnext;
+		IPRewriterEntry **nb = &nt->bucket[IPRewriterShards::hash(x->flowid()) & nt->mask];
+		x->_hashnext = *nb;
+		*nb = x;
+	    }
+	click_order_fence();
+	*static_cast<Table * volatile *>(&s.table) = nt;
+	click_order_fence();
+	++s.seq;
+	// link() runs under the shard lock, not _reap_lock, so the old
+	// array waits here until the next reap() retires it.
+	s.retired_tables.push_back(t);
+	t = nt;
+    }
+
+    IPRewriterEntry **b = &t->bucket[hash & t->mask];
+    e->_hashnext = *b;
+    click_order_fence();
+    *static_cast<IPRewriterEntry * volatile *>(b) = e;
+    ++s.nentries;
+}
+
+void
+IPRewriterShards::unlink(Shard &s, IPRewriterEntry *e)
+{
+    // Leave e->_hashnext alone: a concurrent lookup may be standing on e.
+    Table *t = s.table;
+    IPRewriterEntry **pprev = &t->bucket[hash(e->flowid()) & t->mask];
+    while (*pprev && *pprev != e)
+	pprev = &(*pprev)->_hashnext;
+    if (*pprev) {
+	*static_cast<IPRewriterEntry * volatile *>(pprev) = e->_hashnext;
+	--s.nentries;
+    }
+}
+
+IPRewriterEntry *
+IPRewriterShards::insert(IPRewriterFlow *flow, uint32_t capacity)
+{
+    IPRewriterEntry *fe = &flow->entry(false), *re = &flow->entry(true);
+    uint32_t fh = hash(fe->flowid()), rh = hash(re->flowid());
+    int s0 = shard(fh), s1 = shard(rh);
+    Shard &fs = _shards[s0], &rs = _shards[s1];
+
+    lock(s0, s1);
+    IPRewriterEntry *result = find(fs.table, fh, fe->flowid(), flow->ip_p());
+    if (result)
+	/* another thread added this flow first */;
+    else if (fs.nflows < capacity
+	     && !find(rs.table, rh, re->flowid(), flow->ip_p())) {
+	link(rs, re, rh);
+	link(fs, fe, fh);
+	++fs.nflows;
+	fs.heap.push_back(HeapItem(flow->expiry(), flow));
+	push_heap(fs.heap.begin(), fs.heap.end(), heap_less());
+	result = fe;
+    }
+    unlock(s0, s1);
+    return result;
+}
+
+void
+IPRewriterShards::remove(const Vector<IPRewriterFlow *> &dead)
+{
+    for (IPRewriterFlow * const *it = dead.begin(); it != dead.end(); ++it) {
+	IPRewriterFlow *f = *it;
+	int s0 = shard(f->entry(false).flowid()),
+	    s1 = shard(f->entry(true).flowid());
+	lock(s0, s1);
+	unlink(_shards[s0], &f->entry(false));
+	unlink(_shards[s1], &f->entry(true));
+	unlock(s0, s1);
+	f->owner()->release_flow(f);
+	_reclaimer.retire(f, free_flow);
+    }
+}
+
+void
+IPRewriterShards::retire_tables(Shard &s)
+{
+    // Retiring later than the unlink is safe: it only delays the free.
+    for (Table **it = s.retired_tables.begin();
+	 it != s.retired_tables.end(); ++it)
+	_reclaimer.retire(*it, free_table);
+    s.retired_tables.clear();
+}
+
+void
+IPRewriterShards::reap(click_jiffies_t now_j, uint32_t capacity)
+{
+    _reap_lock.acquire();
+    Vector<IPRewriterFlow *> dead;
+    for (int i = 0; i < _nshards; ++i) {
+	Shard &s = _shards[i];
+	s.lock.acquire();
+	retire_tables(s);
+	while (s.heap.size()) {
+	    HeapItem top = s.heap[0];
+	    if (click_jiffies_less(now_j, top.expiry) && s.nflows <= capacity)
+		break;
+	    pop_heap(s.heap.begin(), s.heap.end(), heap_less());
+	    s.heap.pop_back();
+	    if (top.flow->expiry() != top.expiry) {
+		// packets have refreshed the flow since it was last queued
+		s.heap.push_back(HeapItem(top.flow->expiry(), top.flow));
+		push_heap(s.heap.begin(), s.heap.end(), heap_less());
+	    } else {
+		dead.push_back(top.flow);
+		--s.nflows;
+	    }
+	}
+	s.lock.release();
+    }
+
+    remove(dead);
+    _reclaimer.reclaim();
+    _reap_lock.release();
+}
+
+void
+IPRewriterShards::filter_heap(Shard &s, IPRewriterBase *owner, int input,
+			      Vector<IPRewriterFlow *> &dead)
+{
+    Vector<HeapItem> heap;
+    heap.swap(s.heap);
+    for (HeapItem *it = heap.begin(); it != heap.end(); ++it)
+	if (!owner || (it->flow->owner() == owner
+		       && it->flow->owner_input() == input)) {
+	    dead.push_back(it->flow);
+	    --s.nflows;
+	} else {
+	    s.heap.push_back(*it);
+	    push_heap(s.heap.begin(), s.heap.end(), heap_less());
+	}
+}
+
+void
+IPRewriterShards::remove_input(IPRewriterBase *owner, int input)
+{
+    _reap_lock.acquire();
+    Vector<IPRewriterFlow *> dead;
+    for (int i = 0; i < _nshards; ++i) {
+	_shards[i].lock.acquire();
+	retire_tables(_shards[i]);
+	filter_heap(_shards[i], owner, input, dead);
+	_shards[i].lock.release();
+    }
+    remove(dead);
+    _reclaimer.reclaim();
+    _reap_lock.release();
+}
+
+void
+IPRewriterShards::clear()
+{
+    // No lookups may be running, so free everything right away.
+    remove_input(0, -1);
+    _reap_lock.acquire();
+    _reclaimer.reclaim_all();
+    _reap_lock.release();
+}
+
+void
+IPRewriterShards::entries(Vector<IPRewriterEntry *> &v, int ip_p) const
+{
+    _reap_lock.acquire();
+    for (int i = 0; i < _nshards; ++i) {
+	Shard &s = _shards[i];
+	s.lock.acquire();
+	for (uint32_t b = 0; b <= s.table->mask; ++b)
+	    for (IPRewriterEntry *e = s.table->bucket[b]; e; e = e->_hashnext)
+		if (!ip_p || e->flow()->ip_p() == ip_p)
+		    v.push_back(e);
+	s.lock.release();
+    }
+    _reap_lock.release();
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(IPRewriterMapping)
+ELEMENT_PROVIDES(IPRewriterShards)
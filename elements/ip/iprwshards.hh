@@ -0,0 +1,181 @@
+// -*- mode: c++; c-basic-offset: 4 -*-
+#ifndef CLICK_IPRW_SHARDS_HH
+#define CLICK_IPRW_SHARDS_HH
+#include <click/sync.hh>
+#include <click/epoch.hh>
+#include <click/ipflowid.hh>
+#include "elements/ip/iprwmapping.hh"
+CLICK_DECLS
+
+/** @brief A flow table for rewriters shared by several threads.
+ *
+ * IPRewriterShards splits a rewriter's flows into shards, selected by a
+ * hash of the flow ID.  The hash is symmetric, so a flow ID and its reverse
+ * land in the same shard; patterns choose ports so that a flow's reply
+ * entry hashes to the same shard as its forward entry, so that threads
+ * that receive both directions of the same flows (as with RSS) work
+ * independently.
+ *
+ * Lookups take no locks.  Each shard has a lock that serializes inserts
+ * into that shard, and a heap of its flows ordered by expiry time.  When a
+ * shard's bucket array grows, entries move between chains, so lookups that
+ * fail recheck a sequence number and retry if the array changed.  Packets
+ * refresh a flow's expiry time without touching the heap; reap() checks
+ * the real expiry time of each flow that reaches the top of its heap.
+ * Removed flows and replaced bucket arrays are retired to an
+ * EpochReclaimer, which frees them from a later reap() once every
+ * RouterThread has passed a quiescent point, so lookups must run as element
+ * code.  reap(), remove_input(), and the other removal functions must not
+ * run concurrently with each other; they are serialized by an internal
+ * lock. */
+class IPRewriterShards { public:
+
+    IPRewriterShards(int nshards);
+    ~IPRewriterShards();
+
+    void initialize(Master *master);
+
+    int nshards() const {
+	return _nshards;
+    }
+    uint32_t size() const;
+
+    static inline uint32_t hash(const IPFlowID &flowid);
+    int shard(uint32_t hash) const {
+	return ((uint64_t) hash * _nshards) >> 32;
+    }
+    int shard(const IPFlowID &flowid) const {
+	return shard(hash(flowid));
+    }
+
+    inline IPRewriterEntry *find(const IPFlowID &flowid, int ip_p) const;
+
+    /** @brief Insert @a flow, an unpublished flow.
+     * @param capacity maximum number of flows per shard
+     * @return &@a flow->entry(false) on success; an existing entry for
+     * @a flow's forward flow ID, if one exists; or null if @a flow's reply
+     * flow ID is in use or the shard is full
+     *
+     * If insert() does not return @a flow's own entry, the caller must
+     * destroy @a flow. */
+    IPRewriterEntry *insert(IPRewriterFlow *flow, uint32_t capacity);
+
+    /** @brief Remove flows that have expired as of @a now_j, then the
+     * soonest-expiring flows of any shard with more than @a capacity flows,
+     * and free removed memory that no lookup can still reach. */
+    void reap(click_jiffies_t now_j, uint32_t capacity);
+    void remove_input(IPRewriterBase *owner, int input);
+    void clear();
+
+    void entries(Vector<IPRewriterEntry *> &v, int ip_p = 0) const;
+
+  private:
+
+    enum {
+	cache_line_size = 64,
+	initial_buckets = 64
+    };
+
+    struct Table {
+	uint32_t mask;
+	IPRewriterEntry *bucket[1];
+    };
+
+    struct HeapItem {
+	click_jiffies_t expiry;
+	IPRewriterFlow *flow;
+	HeapItem(click_jiffies_t e, IPRewriterFlow *f)
+	    : expiry(e), flow(f) {
+	}
+    };
+    struct heap_less {
+	bool operator()(const HeapItem &a, const HeapItem &b) {
+	    return click_jiffies_less(a.expiry, b.expiry);
+	}
+    };
+
+    struct Shard {
+	Table *table;
+	volatile uint32_t seq;	// odd while table is changing
+	uint32_t nentries;
+	uint32_t nflows;
+	Spinlock lock;
+	Vector<HeapItem> heap;
+	Vector<Table *> retired_tables;	// not yet passed to _reclaimer
+	char pad[cache_line_size];
+    };
+
+    Shard *_shards;
+    int _nshards;
+    mutable Spinlock _reap_lock;
+    EpochReclaimer _reclaimer;	// protected by _reap_lock
+
+    static Table *new_table(uint32_t nbuckets);
+    static void free_table(Table *t);
+    static void free_table(void *table, void *user_data);
+    static void free_flow(void *flow, void *user_data);
+    static IPRewriterEntry *find(const Table *t, uint32_t hash,
+				 const IPFlowID &flowid, int ip_p);
+    void link(Shard &s, IPRewriterEntry *e, uint32_t hash);
+    void unlink(Shard &s, IPRewriterEntry *e);
+    void lock(int s0, int s1);
+    void unlock(int s0, int s1);
+    void remove(const Vector<IPRewriterFlow *> &dead);
+    void retire_tables(Shard &s);
+    void filter_heap(Shard &s, IPRewriterBase *owner, int input,
+		     Vector<IPRewriterFlow *> &dead);
+
+    IPRewriterShards(const IPRewriterShards &);
+    IPRewriterShards &operator=(const IPRewriterShards &);
+
+};
+
+inline uint32_t
+IPRewriterShards::hash(const IPFlowID &flowid)
+{
+    // Order the two endpoints so that a flow ID and its reverse hash alike.
+    uint64_t a = ((uint64_t) flowid.saddr().addr() << 16) | flowid.sport();
+    uint64_t b = ((uint64_t) flowid.daddr().addr() << 16) | flowid.dport();
+    if (a > b) {
+	uint64_t t = a;
+	a = b;
+	b = t;
+    }
+    uint64_t h = a * 0x9E3779B97F4A7C15ULL ^ (b + (b << 21)) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 29;
+    h *= 0x165667B19E3779F9ULL;
+    return h >> 32;
+}
+
+inline IPRewriterEntry *
+IPRewriterShards::find(const Table *t, uint32_t hash, const IPFlowID &flowid,
+		       int ip_p)
+{
+    for (IPRewriterEntry *e = t->bucket[hash & t->mask]; e; e = e->_hashnext)
+	if (e->flowid() == flowid) {
+	    int e_ip_p = e->flow()->ip_p();
+	    if (!ip_p || !e_ip_p || e_ip_p == ip_p)
+		return e;
+	}
+    return 0;
+}
+
+inline IPRewriterEntry *
+IPRewriterShards::find(const IPFlowID &flowid, int ip_p) const
+{
+    uint32_t h = hash(flowid);
+    const Shard &s = _shards[shard(h)];
+    uint32_t seq;
+    do {
+	seq = s.seq;
+	click_order_fence();
+	const Table *t = *static_cast<Table * const volatile *>(&s.table);
+	if (IPRewriterEntry *e = find(t, h, flowid, ip_p))
+	    return e;
+	click_order_fence();
+    } while ((seq & 1) || seq != s.seq);
+    return 0;
+}
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,571 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * poptrieiplookup.{cc,hh} -- IP routing lookup using a compressed multibit
+ * trie with population counts
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "poptrieiplookup.hh"
+#include <click/ipaddress.hh>
+#include <click/straccum.hh>
+#include <click/error.hh>
+#include <click/master.hh>
+CLICK_DECLS
+
+// Without -mpopcnt, __builtin_popcountll calls a slow library function.  On
+// x86, compile a second copy of the lookup code that uses the popcnt
+// instruction, and choose between the copies at run time.
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__) \
+    && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+# define POPTRIE_POPCNT_DISPATCH 1
+#endif
+
+int
+PoptrieIPLookup::route_compare(const void *a, const void *b, void *)
+{
+    const LongRoute *ra = static_cast<const LongRoute *>(a);
+    const LongRoute *rb = static_cast<const LongRoute *>(b);
+    if (ra->prefix != rb->prefix)
+	return ra->prefix < rb->prefix ? -1 : 1;
+    return ra->plen - rb->plen;
+}
+
+PoptrieIPLookup::PoptrieIPLookup()
+    : _dir(0), _nexthop(0), _short(0), _long(0), _nroutes(0), _nblocks(0),
+      _block_bytes(0), _reclaim_timer(this)
+{
+#if POPTRIE_POPCNT_DISPATCH
+    _popcnt = __builtin_cpu_supports("popcnt");
+#else
+    _popcnt = false;
+#endif
+}
+
+PoptrieIPLookup::~PoptrieIPLookup()
+{
+}
+
+int
+PoptrieIPLookup::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _dir = (uintptr_t *) CLICK_LALLOC(sizeof(uintptr_t) << dir_bits);
+    _short = (uint16_t *) CLICK_LALLOC(sizeof(uint16_t) << (dir_bits + 1));
+    _nexthop = (NextHop *) CLICK_LALLOC(sizeof(NextHop) * nexthop_limit);
+    _long = new Vector<LongRoute>[1 << dir_bits];
+    if (!_dir || !_short || !_nexthop || !_long)
+	return errh->error("out of memory");
+
+    for (uint32_t i = 0; i < (1U << dir_bits); ++i)
+	_dir[i] = 1;
+    memset(_short, 0, sizeof(uint16_t) << (dir_bits + 1));
+    // next hop 0 means "no route"
+    _nexthop[0].gw = IPAddress();
+    _nexthop[0].port = -1;
+    _nexthop_refcount.push_back(1);
+
+    return IPRouteTable::configure(conf, errh);
+}
+
+int
+PoptrieIPLookup::initialize(ErrorHandler *)
+{
+    _reclaim_timer.initialize(this);
+    _reclaimer.initialize(master());
+    return 0;
+}
+
+void
+PoptrieIPLookup::cleanup(CleanupStage)
+{
+    _reclaimer.reclaim_all();
+    if (_dir) {
+	for (uint32_t i = 0; i < (1U << dir_bits); ++i)
+	    if (!(_dir[i] & 1)) {
+		Block *b = reinterpret_cast<Block *>(_dir[i]);
+		CLICK_LFREE(b, b->size);
+	    }
+	CLICK_LFREE(_dir, sizeof(uintptr_t) << dir_bits);
+    }
+    if (_short)
+	CLICK_LFREE(_short, sizeof(uint16_t) << (dir_bits + 1));
+    if (_nexthop)
+	CLICK_LFREE(_nexthop, sizeof(NextHop) * nexthop_limit);
+    delete[] _long;
+    _dir = 0;
+    _short = 0;
+    _nexthop = 0;
+    _long = 0;
+}
+
+
+// LOOKUP
+
+inline int
+PoptrieIPLookup::lookup(const uintptr_t *dir, uint32_t addr)
+{
+    uintptr_t d = dir[addr >> (32 - dir_bits)];
+    if (d & 1)
+	return d >> 1;
+
+    const Block *b = reinterpret_cast<const Block *>(d);
+    const Node *n = b->nodes();
+    uint32_t key = addr << dir_bits;
+    while (1) {
+	int v = key >> (32 - stride);
+	uint64_t upto = ((uint64_t) 2 << v) - 1;
+	if (n->vector & ((uint64_t) 1 << v)) {
+	    n = b->nodes() + n->base1 + __builtin_popcountll(n->vector & upto) - 1;
+	    key <<= stride;
+	} else
+	    return b->leaves[n->base0 + __builtin_popcountll(n->leafvec & upto) - 1];
+    }
+}
+
+#if POPTRIE_POPCNT_DISPATCH
+__attribute__((target("popcnt"))) int
+PoptrieIPLookup::lookup_popcnt(const uintptr_t *dir, uint32_t addr)
+{
+    return lookup(dir, addr);
+}
+
+__attribute__((noinline)) int
+PoptrieIPLookup::lookup_generic(const uintptr_t *dir, uint32_t addr)
+{
+    return lookup(dir, addr);
+}
+
+inline int
+PoptrieIPLookup::lookup_leaf(uint32_t addr) const
+{
+    // Keep both copies out of line, so the callers stay small.
+    if (_popcnt)
+	return lookup_popcnt(_dir, addr);
+    else
+	return lookup_generic(_dir, addr);
+}
+#else
+inline int
+PoptrieIPLookup::lookup_leaf(uint32_t addr) const
+{
+    return lookup(_dir, addr);
+}
+#endif
+
+int
+PoptrieIPLookup::lookup_route(IPAddress addr, IPAddress &gw) const
+{
+    const NextHop &nh = _nexthop[lookup_leaf(ntohl(addr.addr()))];
+    gw = nh.gw;
+    return nh.port;
+}
+
+void
+PoptrieIPLookup::push(int, Packet *p)
+{
+    const NextHop &nh = _nexthop[lookup_leaf(ntohl(p->dst_ip_anno().addr()))];
+    if (nh.port >= 0) {
+	if (nh.gw)
+	    p->set_dst_ip_anno(nh.gw);
+	output(nh.port).push(p);
+    } else
+	p->kill();
+}
+
+
+// UPDATES
+
+int
+PoptrieIPLookup::nexthop_ref(IPAddress gw, int32_t port)
+{
+    uint64_t key = ((uint64_t) (uint32_t) port << 32) | gw.addr();
+    HashTable<uint64_t, int>::iterator it = _nexthop_map.find(key);
+    if (it) {
+	++_nexthop_refcount[it.value()];
+	return it.value();
+    }
+
+    int nh;
+    if (_nexthop_free.size()) {
+	nh = _nexthop_free.back();
+	_nexthop_free.pop_back();
+    } else if (_nexthop_refcount.size() < nexthop_limit) {
+	nh = _nexthop_refcount.size();
+	_nexthop_refcount.push_back(0);
+    } else
+	return -ENOMEM;
+
+    // No lookup can reach a new or reclaimed next hop yet.
+    _nexthop[nh].gw = gw;
+    _nexthop[nh].port = port;
+    _nexthop_refcount[nh] = 1;
+    _nexthop_map.set(key, nh);
+    return nh;
+}
+
+void
+PoptrieIPLookup::nexthop_unref(int nh)
+{
+    if (--_nexthop_refcount[nh] == 0) {
+	uint64_t key = ((uint64_t) (uint32_t) _nexthop[nh].port << 32) | _nexthop[nh].gw.addr();
+	_nexthop_map.erase(key);
+	retire(0, nh);
+    }
+}
+
+uint16_t
+PoptrieIPLookup::short_leaf(uint32_t slot) const
+{
+    for (int plen = dir_bits; plen >= 0; --plen)
+	if (uint16_t nh = _short[(1 << plen) | (slot >> (dir_bits - plen))])
+	    return nh;
+    return 0;
+}
+
+void
+PoptrieIPLookup::build_node(Vector<Node> &nodes, Vector<uint16_t> &leaves,
+			    int ni, int level, uint16_t leaf,
+			    const LongRoute *r, int nr)
+{
+    int lo = dir_bits + level * stride, hi = lo + stride;
+    uint16_t child_leaf[1 << stride];
+    uint8_t child_plen[1 << stride];
+    for (int c = 0; c < (1 << stride); ++c) {
+	child_leaf[c] = leaf;
+	child_plen[c] = 0;
+    }
+
+    // Routes ending in this node set the leaves they cover; longer routes
+    // make child nodes.  Routes of length lo or less are already in leaf.
+    Node n;
+    n.vector = 0;
+    for (int i = 0; i < nr; ++i)
+	if (r[i].plen > hi)
+	    n.vector |= (uint64_t) 1 << ((r[i].prefix << lo) >> (32 - stride));
+	else if (r[i].plen > lo) {
+	    int c = (r[i].prefix << lo) >> (32 - stride);
+	    for (int e = c + (1 << (hi - r[i].plen)); c < e; ++c)
+		if (r[i].plen > child_plen[c]) {
+		    child_leaf[c] = r[i].nexthop;
+		    child_plen[c] = r[i].plen;
+		}
+	}
+
+    // Store one leaf per run of equal leaves.
+    n.leafvec = 0;
+    n.base0 = leaves.size();
+    for (int c = 0; c < (1 << stride); ++c)
+	if (!(n.vector & ((uint64_t) 1 << c))
+	    && (!n.leafvec || child_leaf[c] != leaves.back())) {
+	    n.leafvec |= (uint64_t) 1 << c;
+	    leaves.push_back(child_leaf[c]);
+	}
+
+    // Child nodes are contiguous.  Routes are sorted by prefix, so each
+    // child's routes are too.
+    n.base1 = nodes.size();
+    nodes.resize(nodes.size() + __builtin_popcountll(n.vector));
+    nodes[ni] = n;
+    for (int i = 0, k = 0; i < nr; ) {
+	int c = (r[i].prefix << lo) >> (32 - stride), j = i + 1;
+	while (j < nr && (int) ((r[j].prefix << lo) >> (32 - stride)) == c)
+	    ++j;
+	if (n.vector & ((uint64_t) 1 << c)) {
+	    build_node(nodes, leaves, n.base1 + k, level + 1, child_leaf[c], r + i, j - i);
+	    ++k;
+	}
+	i = j;
+    }
+}
+
+PoptrieIPLookup::Block *
+PoptrieIPLookup::build(uint16_t leaf, Vector<LongRoute> &routes)
+{
+    click_qsort(routes.begin(), routes.size(), sizeof(LongRoute), route_compare);
+    Vector<Node> nodes;
+    Vector<uint16_t> leaves;
+    nodes.resize(1);
+    build_node(nodes, leaves, 0, 0, leaf, routes.begin(), routes.size());
+
+    size_t size = sizeof(Block) + nodes.size() * sizeof(Node)
+	+ leaves.size() * sizeof(uint16_t);
+    Block *b = (Block *) CLICK_LALLOC(size);
+    if (!b)
+	return 0;
+    Node *bnodes = reinterpret_cast<Node *>(b + 1);
+    uint16_t *bleaves = reinterpret_cast<uint16_t *>(bnodes + nodes.size());
+    memcpy(bnodes, nodes.begin(), nodes.size() * sizeof(Node));
+    memcpy(bleaves, leaves.begin(), leaves.size() * sizeof(uint16_t));
+    b->leaves = bleaves;
+    b->size = size;
+    b->leaf = leaf;
+    return b;
+}
+
+int
+PoptrieIPLookup::rebuild(uint32_t slot)
+{
+    uint16_t leaf = short_leaf(slot);
+    uintptr_t entry, old = _dir[slot];
+    if (!_long[slot].size())
+	entry = ((uintptr_t) leaf << 1) | 1;
+    else if (Block *b = build(leaf, _long[slot])) {
+	entry = reinterpret_cast<uintptr_t>(b);
+	++_nblocks;
+	_block_bytes += b->size;
+    } else
+	return -ENOMEM;
+
+    if (entry != old) {
+	// The new trie must be visible before the entry pointing to it.
+	click_order_fence();
+	_dir[slot] = entry;
+	if (!(old & 1))
+	    retire(reinterpret_cast<Block *>(old), 0);
+    }
+    return 0;
+}
+
+int
+PoptrieIPLookup::rebuild_range(uint32_t prefix, int plen)
+{
+    if (plen > dir_bits)
+	return rebuild(prefix >> (32 - dir_bits));
+
+    uint32_t slot = prefix >> (32 - dir_bits);
+    uint32_t end = slot + (1U << (dir_bits - plen));
+    int r = 0;
+    for (; slot < end; ++slot) {
+	// Short routes only change a trie's default leaf.
+	uintptr_t d = _dir[slot];
+	if (!(d & 1) && reinterpret_cast<Block *>(d)->leaf == short_leaf(slot))
+	    continue;
+	if (rebuild(slot) < 0)
+	    r = -ENOMEM;
+    }
+    return r;
+}
+
+int
+PoptrieIPLookup::add_route(const IPRoute &route, bool allow_replace, IPRoute *old_route, ErrorHandler *errh)
+{
+    int plen = route.prefix_len();
+    if (plen < 0)
+	return errh->error("route mask %s is not a prefix", route.mask.unparse().c_str());
+    uint32_t prefix = ntohl(route.addr.addr() & route.mask.addr());
+
+    uint16_t *nhp = 0;
+    Vector<LongRoute> *lr = 0;
+    if (plen <= dir_bits)
+	nhp = &_short[(1 << plen) | (plen ? prefix >> (32 - plen) : 0)];
+    else {
+	lr = &_long[prefix >> (32 - dir_bits)];
+	for (LongRoute *it = lr->begin(); it != lr->end(); ++it)
+	    if (it->prefix == prefix && it->plen == plen) {
+		nhp = &it->nexthop;
+		break;
+	    }
+    }
+
+    int old_nh = nhp ? *nhp : 0;
+    if (old_nh) {
+	if (old_route)
+	    *old_route = IPRoute(IPAddress(htonl(prefix)), IPAddress::make_prefix(plen),
+				 _nexthop[old_nh].gw, _nexthop[old_nh].port);
+	if (!allow_replace)
+	    return -EEXIST;
+    }
+
+    int nh = nexthop_ref(route.gw, route.port);
+    if (nh < 0)
+	return errh->error("too many next hops");
+    if (nhp)
+	*nhp = nh;
+    else {
+	LongRoute x;
+	x.prefix = prefix;
+	x.plen = plen;
+	x.nexthop = nh;
+	lr->push_back(x);
+    }
+
+    int r = rebuild_range(prefix, plen);
+    if (old_nh)
+	nexthop_unref(old_nh);
+    else
+	++_nroutes;
+    return r;
+}
+
+int
+PoptrieIPLookup::remove_route(const IPRoute &route, IPRoute *old_route, ErrorHandler *)
+{
+    int plen = route.prefix_len();
+    if (plen < 0)
+	return -ENOENT;
+    uint32_t prefix = ntohl(route.addr.addr() & route.mask.addr());
+
+    uint16_t *nhp = 0;
+    Vector<LongRoute> *lr = 0;
+    LongRoute *lrp = 0;
+    if (plen <= dir_bits)
+	nhp = &_short[(1 << plen) | (plen ? prefix >> (32 - plen) : 0)];
+    else {
+	lr = &_long[prefix >> (32 - dir_bits)];
+	for (lrp = lr->begin(); lrp != lr->end(); ++lrp)
+	    if (lrp->prefix == prefix && lrp->plen == plen) {
+		nhp = &lrp->nexthop;
+		break;
+	    }
+    }
+
+    int nh = nhp ? *nhp : 0;
+    if (!nh)
+	return -ENOENT;
+    IPRoute found(IPAddress(htonl(prefix)), IPAddress::make_prefix(plen),
+		  _nexthop[nh].gw, _nexthop[nh].port);
+    if (!route.match(found))
+	return -ENOENT;
+    if (old_route)
+	*old_route = found;
+
+    if (lr) {
+	*lrp = lr->back();
+	lr->pop_back();
+    } else
+	*nhp = 0;
+
+    int r = rebuild_range(prefix, plen);
+    nexthop_unref(nh);
+    --_nroutes;
+    return r;
+}
+
+void
+PoptrieIPLookup::clear()
+{
+    for (uint32_t i = 0; i < (1U << dir_bits); ++i) {
+	uintptr_t d = _dir[i];
+	_dir[i] = 1;
+	if (!(d & 1))
+	    retire(reinterpret_cast<Block *>(d), 0);
+	_long[i].clear();
+    }
+    memset(_short, 0, sizeof(uint16_t) << (dir_bits + 1));
+    for (int nh = 1; nh < _nexthop_refcount.size(); ++nh)
+	if (_nexthop_refcount[nh]) {
+	    _nexthop_refcount[nh] = 0;
+	    retire(0, nh);
+	}
+    _nexthop_map.clear();
+    _nroutes = 0;
+}
+
+
+// RECLAMATION
+
+void
+PoptrieIPLookup::free_block(void *object, void *)
+{
+    Block *block = static_cast<Block *>(object);
+    CLICK_LFREE(block, block->size);
+}
+
+void
+PoptrieIPLookup::free_nexthop(void *object, void *user_data)
+{
+    PoptrieIPLookup *pl = static_cast<PoptrieIPLookup *>(user_data);
+    pl->_nexthop_free.push_back((uintptr_t) object);
+}
+
+void
+PoptrieIPLookup::retire(Block *block, int nh)
+{
+    // A retired next hop is identified by its index, which is never 0.
+    if (block) {
+	--_nblocks;
+	_block_bytes -= block->size;
+	_reclaimer.retire(block, free_block);
+    }
+    if (nh)
+	_reclaimer.retire((void *) (uintptr_t) nh, free_nexthop, this);
+
+    // Before initialize(), no lookups run, and reclaim() frees everything.
+    // Later, try again until every thread has passed a quiescent point.
+    if (_reclaimer.reclaim() && !_reclaim_timer.scheduled())
+	_reclaim_timer.schedule_after_msec(reclaim_msec);
+}
+
+void
+PoptrieIPLookup::run_timer(Timer *)
+{
+    if (_reclaimer.reclaim())
+	_reclaim_timer.schedule_after_msec(reclaim_msec);
+}
+
+
+// HANDLERS
+
+String
+PoptrieIPLookup::dump_routes()
+{
+    StringAccum sa;
+    for (int plen = 0; plen <= dir_bits; ++plen)
+	for (uint32_t i = 0; i < (1U << plen); ++i)
+	    if (uint16_t nh = _short[(1 << plen) | i]) {
+		uint32_t prefix = plen ? i << (32 - plen) : 0;
+		IPRoute r(IPAddress(htonl(prefix)), IPAddress::make_prefix(plen),
+			  _nexthop[nh].gw, _nexthop[nh].port);
+		r.unparse(sa, true) << '\n';
+	    }
+    for (uint32_t slot = 0; slot < (1U << dir_bits); ++slot)
+	for (const LongRoute *it = _long[slot].begin(); it != _long[slot].end(); ++it) {
+	    IPRoute r(IPAddress(htonl(it->prefix)), IPAddress::make_prefix(it->plen),
+		      _nexthop[it->nexthop].gw, _nexthop[it->nexthop].port);
+	    r.unparse(sa, true) << '\n';
+	}
+    return sa.take_string();
+}
+
+int
+PoptrieIPLookup::flush_handler(const String &, Element *e, void *, ErrorHandler *)
+{
+    static_cast<PoptrieIPLookup *>(e)->clear();
+    return 0;
+}
+
+String
+PoptrieIPLookup::stats_handler(Element *e, void *)
+{
+    PoptrieIPLookup *t = static_cast<PoptrieIPLookup *>(e);
+    size_t bytes = t->_block_bytes + (sizeof(uintptr_t) << dir_bits)
+	+ sizeof(NextHop) * nexthop_limit;
+    StringAccum sa;
+    sa << "routes " << t->_nroutes << '\n'
+       << "nexthops " << t->_nexthop_map.size() << '\n'
+       << "tries " << t->_nblocks << '\n'
+       << "memory " << bytes << '\n'
+       << "retired " << t->_reclaimer.size() << '\n';
+    return sa.take_string();
+}
+
+void
+PoptrieIPLookup::add_handlers()
+{
+    IPRouteTable::add_handlers();
+    add_write_handler("flush", flush_handler, 0, Handler::BUTTON);
+    add_read_handler("stats", stats_handler, 0);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(IPRouteTable)
+EXPORT_ELEMENT(PoptrieIPLookup)
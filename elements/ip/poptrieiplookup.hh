@@ -0,0 +1,209 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_POPTRIEIPLOOKUP_HH
+#define CLICK_POPTRIEIPLOOKUP_HH
+#include "iproutetable.hh"
+#include <click/hashtable.hh>
+#include <click/timer.hh>
+#include <click/epoch.hh>
+CLICK_DECLS
+
+/*
+=c
+
+PoptrieIPLookup(ADDR1/MASK1 [GW1] OUT1, ADDR2/MASK2 [GW2] OUT2, ...)
+
+=s iproute
+
+IP routing lookup using a compressed multibit trie
+
+=d
+
+Expects a destination IP address annotation with each packet. Looks up that
+address in its routing table, using longest-prefix-match, sets the destination
+annotation to the corresponding GW (if specified), and emits the packet on the
+indicated OUTput port.
+
+Each argument is a route, specifying a destination and mask, an optional
+gateway IP address, and an output port.  No destination-mask pair should occur
+more than once.
+
+PoptrieIPLookup implements the I<Poptrie> lookup scheme described by Asai and
+Ohara in the paper cited below.  The top 18 bits of an address index a
+direct table.  A direct table entry either holds the lookup result, or
+points to a trie of 64-way nodes, each of which consumes 6 more address bits.
+Nodes store their children and results as bitmaps plus base indexes into
+dense arrays, so a lookup touches at most three nodes and one result, and
+the whole structure for an 800000-route table takes about 15 megabytes.
+Unlike DirectIPLookup, PoptrieIPLookup places no limit on the number of
+long prefixes.
+
+Lookups never wait for route updates.  An update rebuilds the trie below
+each affected direct table entry into new memory, then replaces the entry
+with a single store, so a concurrent lookup sees either the old or the new
+trie, never a mixture.  Replaced memory is freed only after every thread
+has passed a quiescent point between elements, so no lookup can still be
+using it.  Updates themselves must not run concurrently; the usual handlers
+are serialized by the driver.
+
+=h table read-only
+
+Outputs a human-readable version of the current routing table.
+
+=h lookup read-only
+
+Reports the OUTput port and GW corresponding to an address.
+
+=h add write-only
+
+Adds a route to the table. Format should be `C<ADDR/MASK [GW] OUT>'.
+Fails if a route for C<ADDR/MASK> already exists.
+
+=h set write-only
+
+Sets a route, whether or not a route for the same prefix already exists.
+
+=h remove write-only
+
+Removes a route from the table. Format should be `C<ADDR/MASK>'.
+
+=h ctrl write-only
+
+Adds or removes a group of routes. Write `C<add>/C<set ADDR/MASK [GW] OUT>' to
+add a route, and `C<remove ADDR/MASK>' to remove a route. You can supply
+multiple commands, one per line; all commands are executed as one atomic
+operation.
+
+=h flush write-only
+
+Clears the entire routing table.
+
+=h stats read-only
+
+Reports the number of routes, the number of distinct next hops, the number of
+direct table entries that point to tries, the lookup structures' memory size
+in bytes, and the number of replaced tries and next hops not yet freed.
+
+=n
+
+See IPRouteTable for a performance comparison of the various IP routing
+elements.  IPRouteTableBench measures lookup and update rates on synthetic
+full-size tables.
+
+=a IPRouteTable, DirectIPLookup, RangeIPLookup, RadixIPLookup,
+IPRouteTableBench
+
+Hirochika Asai and Yasuhiro Ohara.  "Poptrie: A Compressed Trie with
+Population Count for Fast and Scalable Software IP Routing Table Lookup".  In
+Proc. ACM SIGCOMM 2015, pp. 57-70.
+
+*/
+
+class PoptrieIPLookup : public IPRouteTable { public:
+
+    PoptrieIPLookup();
+    ~PoptrieIPLookup();
+
+    const char *class_name() const	{ return "PoptrieIPLookup"; }
+    const char *port_count() const	{ return "1/-"; }
+    const char *processing() const	{ return PUSH; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+    void run_timer(Timer *timer);
+
+    int add_route(const IPRoute &route, bool allow_replace, IPRoute *old_route, ErrorHandler *errh);
+    int remove_route(const IPRoute &route, IPRoute *old_route, ErrorHandler *errh);
+    int lookup_route(IPAddress addr, IPAddress &gw) const;
+    String dump_routes();
+
+    static int flush_handler(const String &, Element *, void *, ErrorHandler *);
+    static String stats_handler(Element *, void *);
+
+  private:
+
+    enum {
+	dir_bits = 18,
+	stride = 6,
+	nexthop_limit = 1 << 16,
+	reclaim_msec = 10
+    };
+
+    struct Node {
+	uint64_t vector;	// bit i set: child i is a node
+	uint64_t leafvec;	// bit i set: child i starts a run of equal leaves
+	uint32_t base0;		// index of first leaf
+	uint32_t base1;		// index of first child node
+    };
+
+    // A direct table entry's trie: this header, then the nodes (root
+    // first), then the leaves.
+    struct Block {
+	const uint16_t *leaves;
+	uint32_t size;
+	uint16_t leaf;		// leaf from routes of length dir_bits or less
+	const Node *nodes() const {
+	    return reinterpret_cast<const Node *>(this + 1);
+	}
+    };
+
+    struct NextHop {
+	IPAddress gw;
+	int32_t port;
+    };
+
+    struct LongRoute {
+	uint32_t prefix;	// host byte order
+	uint16_t plen;
+	uint16_t nexthop;
+    };
+
+    // Lookup state.  A direct table entry is (leaf << 1) | 1 or a Block
+    // pointer.  A leaf is an index into _nexthop; leaf 0 means no route.
+    uintptr_t *_dir;
+    NextHop *_nexthop;
+
+    // Update state.  _short holds the next hop of each route of length
+    // dir_bits or less, indexed by (1 << length) | (prefix >> (32 -
+    // length)), or 0.  _long[i] lists longer routes below direct table
+    // entry i.
+    uint16_t *_short;
+    Vector<LongRoute> *_long;
+    Vector<int> _nexthop_refcount;
+    Vector<int> _nexthop_free;
+    HashTable<uint64_t, int> _nexthop_map;
+    uint32_t _nroutes;
+    uint32_t _nblocks;
+    size_t _block_bytes;
+
+    EpochReclaimer _reclaimer;
+    Timer _reclaim_timer;
+    bool _popcnt;
+
+    static inline int lookup(const uintptr_t *dir, uint32_t addr) __attribute__((always_inline));
+    static int lookup_popcnt(const uintptr_t *dir, uint32_t addr);
+    static int lookup_generic(const uintptr_t *dir, uint32_t addr);
+    inline int lookup_leaf(uint32_t addr) const;
+
+    static int route_compare(const void *a, const void *b, void *);
+
+    int nexthop_ref(IPAddress gw, int32_t port);
+    void nexthop_unref(int nexthop);
+    uint16_t short_leaf(uint32_t slot) const;
+    int rebuild(uint32_t slot);
+    int rebuild_range(uint32_t prefix, int plen);
+    Block *build(uint16_t leaf, Vector<LongRoute> &routes);
+    void build_node(Vector<Node> &nodes, Vector<uint16_t> &leaves, int ni,
+		    int level, uint16_t leaf, const LongRoute *r, int nr);
+    void retire(Block *block, int nexthop);
+    static void free_block(void *object, void *);
+    static void free_nexthop(void *object, void *user_data);
+    void clear();
+
+};
+
+CLICK_ENDDECLS
+#endif
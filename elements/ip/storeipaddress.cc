@@ -77,23 +77,20 @@ StoreIPAddress::simple_action(Packet *p)
 	// special case: store IP address into IP header
 	// and update checksums incrementally
 	if (WritablePacket *q = p->uniqueify()) {
-	    uint16_t *x = reinterpret_cast<uint16_t *>(q->network_header() - _offset);
-	    uint32_t old_hw = (uint32_t) x[0] + x[1];
-	    old_hw += (old_hw >> 16);
+	    unsigned char *x = q->network_header() - _offset;
+	    uint32_t old_w, new_w = ipa.addr();
+	    memcpy(&old_w, x, 4);
+	    memcpy(x, &new_w, 4);
 
-	    memcpy(x, &ipa, 4);
-
-	    uint32_t new_hw = (uint32_t) x[0] + x[1];
-	    new_hw += (new_hw >> 16);
 	    click_ip *iph = q->ip_header();
-	    click_update_in_cksum(&iph->ip_sum, old_hw, new_hw);
+	    click_update_in_cksum32(&iph->ip_sum, old_w, new_w);
 	    if (iph->ip_p == IP_PROTO_TCP && IP_FIRSTFRAG(iph)
 		&& q->transport_length() >= (int) sizeof(click_tcp))
-		click_update_in_cksum(&q->tcp_header()->th_sum, old_hw, new_hw);
+		click_update_in_cksum32(&q->tcp_header()->th_sum, old_w, new_w);
 	    if (iph->ip_p == IP_PROTO_UDP && IP_FIRSTFRAG(iph)
 		&& q->transport_length() >= (int) sizeof(click_udp)
 		&& q->udp_header()->uh_sum)
-		click_update_in_cksum(&q->udp_header()->uh_sum, old_hw, new_hw);
+		click_update_in_cksum32(&q->udp_header()->uh_sum, old_w, new_w);
 
 	    return q;
 	} else
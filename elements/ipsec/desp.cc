@@ -96,7 +96,7 @@ IPsecESPUnencap::simple_action(Packet *p)
   }
 
   // rip off ESP header
-  p->pull(sizeof(esp_new));
+  p->pull(sizeof(esp_new) - 8 + sa->iv_length());
   // verify padding
   blks = p->length();
   blk = p->data();
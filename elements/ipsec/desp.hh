@@ -14,9 +14,10 @@ CLICK_DECLS
  * =d
  *
  * Removes ESP header added by IPsecESPEncap. see RFC 2406. Does not perform
- * the optional anti-replay attack checks.
+ * the optional anti-replay attack checks. The IV length depends on the
+ * packet's security association; see IPsecESPEncap.
  *
- * =a IPsecESPUnencap, IPsecDES, IPsecAuthSHA1
+ * =a IPsecESPUnencap, IPsecDES, IPsecAuthSHA1, IPsecCrypt
  */
 
 class IPsecESPUnencap : public Element {
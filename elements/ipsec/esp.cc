@@ -61,15 +61,22 @@ IPsecESPEncap::simple_action(Packet *p)
       ip_p = p->ip_header()->ip_p;
   sa_data=(SADataTuple *)IPSEC_SA_DATA_REFERENCE_ANNO(p);
 
-  // make room for ESP header and padding
+  // make room for ESP header and padding; the SA's transform determines
+  // the IV length and the padding block size
   int plen = p->length();
-  int padding = ((BLKS - ((plen + 2) % BLKS)) % BLKS) + 2;
+  int blks = sa_data->pad_block();
+  int ivlen = sa_data->iv_length();
+  int padding = ((blks - ((plen + 2) % blks)) % blks) + 2;
 
-  WritablePacket *q = p->push(sizeof(esp_new));
+  WritablePacket *q = p->push(sizeof(esp_new) - 8 + ivlen);
+  if (!q)
+    return 0;
   q = q->put(padding);
+  if (!q)
+    return 0;
 
   struct esp_new *esp = (struct esp_new *) q->data();
-  u_char *pad = ((u_char *) q->data()) + sizeof(esp_new) + plen;
+  u_char *pad = ((u_char *) q->data()) + sizeof(esp_new) - 8 + ivlen + plen;
 
   // copy in ESP header
   // Get SPI from packet user annotation. This is the fourth user integer.
@@ -80,11 +87,19 @@ IPsecESPEncap::simple_action(Packet *p)
 	//if the replay counter rolls over...set it to the agreed start value
         sa_data->cur_rpl = sa_data->replay_start_counter;
   }
-  i = click_random() >> 2;
-  memmove(&esp->esp_iv[0], &i, 4);
-  i = click_random() >> 2;
-  memmove(&esp->esp_iv[4], &i, 4);
-  memmove(q->data(), esp, sizeof(struct esp_new));
+  if (sa_data->transform == SA_LEGACY) {
+    i = click_random() >> 2;
+    memmove(&esp->esp_iv[0], &i, 4);
+    i = click_random() >> 2;
+    memmove(&esp->esp_iv[4], &i, 4);
+  } else {
+    // AES-GCM needs a unique IV, so count.  IPsecCrypt encrypts AES-CBC's
+    // counter block to make the IV unpredictable.
+    uint64_t ctr = sa_data->next_iv();
+    memset(&esp->esp_iv[0], 0, ivlen - 8);
+    for (i = 0; i < 8; i++)
+      esp->esp_iv[ivlen - 1 - i] = ctr >> (8 * i);
+  }
 
   // default padding specified by RFC 2406
   for (i = 0; i < padding - 2; i++)
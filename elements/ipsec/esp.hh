@@ -20,7 +20,14 @@ CLICK_DECLS
  * The ESP header added to the packet includes the 32 bit SPI, 32 bit replay
  * counter, and 64 bit Integrity Vector (IV).
  *
- * =a IPsecESPUnencap, IPsecAuthSHA1, IPsecDES
+ * If the packet's security association uses the aes-gcm transform, the block
+ * size is 4 bytes and the IV is a 64-bit counter, starting at a value from
+ * the operating system's random number generator, and incremented
+ * atomically, since several threads may share an SA.  If it uses aes-cbc-hmac-sha256, the block size is 16 bytes and the
+ * IV is 128 bits.
+ * IPsecCrypt then encrypts and authenticates the packet.
+ *
+ * =a IPsecESPUnencap, IPsecAuthSHA1, IPsecDES, IPsecCrypt
  */
 
 struct esp_new {
@@ -44,9 +51,6 @@ public:
 
   Packet *simple_action(Packet *);
 
-private:
-
-  enum { BLKS = 8 };
 };
 
 CLICK_ENDDECLS
@@ -0,0 +1,1005 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * ipseccipher.{cc,hh} -- AES-GCM, AES-CBC, and HMAC-SHA-256 for IPsec ESP
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "ipseccipher.hh"
+#include <click/glue.hh>
+#if CLICK_USERLEVEL && (defined(__x86_64__) || defined(__i386__)) \
+    && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+# define IPSEC_CIPHER_DISPATCH 1
+# include <immintrin.h>
+#endif
+#if CLICK_USERLEVEL
+# include <unistd.h>
+# include <fcntl.h>
+# include <errno.h>
+#elif CLICK_LINUXMODULE
+# include <click/cxxprotect.h>
+CLICK_CXX_PROTECT
+# include <linux/random.h>
+CLICK_CXX_UNPROTECT
+# include <click/cxxunprotect.h>
+#endif
+CLICK_DECLS
+
+typedef IPsecCipher::aes_key aes_key;
+typedef IPsecCipher::gcm_key gcm_key;
+
+static inline uint32_t
+load_be32(const uint8_t *p)
+{
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+	| ((uint32_t) p[2] << 8) | p[3];
+}
+
+static inline void
+store_be32(uint8_t *p, uint32_t x)
+{
+    p[0] = x >> 24;
+    p[1] = x >> 16;
+    p[2] = x >> 8;
+    p[3] = x;
+}
+
+static inline uint64_t
+load_be64(const uint8_t *p)
+{
+    return ((uint64_t) load_be32(p) << 32) | load_be32(p + 4);
+}
+
+static inline void
+store_be64(uint8_t *p, uint64_t x)
+{
+    store_be32(p, x >> 32);
+    store_be32(p + 4, x);
+}
+
+static inline uint32_t
+ror32(uint32_t x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+
+// Implementation choice
+
+static bool kernel_chosen;
+static bool use_aesni;
+static bool use_shani;
+
+#if IPSEC_CIPHER_DISPATCH
+static bool
+cpu_has_aesni()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul")
+	&& __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+}
+
+static bool
+cpu_has_shani()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+}
+#endif
+
+static inline void
+choose_kernel()
+{
+    if (!kernel_chosen)
+	IPsecCipher::set_kernel("aesni");
+}
+
+int
+IPsecCipher::set_kernel(const char *name)
+{
+    if (strcmp(name, "generic") == 0) {
+	use_aesni = use_shani = false;
+	kernel_chosen = true;
+	return 0;
+    }
+#if IPSEC_CIPHER_DISPATCH
+    if (strcmp(name, "aesni") == 0 && cpu_has_aesni()) {
+	use_aesni = true;
+	use_shani = cpu_has_shani();
+	kernel_chosen = true;
+	return 0;
+    }
+#endif
+    if (!kernel_chosen)
+	set_kernel("generic");
+    return -1;
+}
+
+const char *
+IPsecCipher::kernel()
+{
+    choose_kernel();
+    if (use_aesni)
+	return use_shani ? "aesni+shani" : "aesni";
+    else
+	return "generic";
+}
+
+bool
+IPsecCipher::equal_tags(const uint8_t *a, const uint8_t *b, int len)
+{
+    uint8_t diff = 0;
+    for (int i = 0; i < len; ++i)
+	diff |= a[i] ^ b[i];
+    return diff == 0;
+}
+
+
+// Portable AES, using tables built at first use
+
+static uint8_t sbox[256];
+static uint8_t inv_sbox[256];
+static uint32_t te0[256];
+static uint32_t td0[256];
+static bool aes_tables_ready;
+
+static uint8_t
+gf_mul(uint8_t a, uint8_t b)
+{
+    uint8_t p = 0;
+    for (; b; b >>= 1) {
+	if (b & 1)
+	    p ^= a;
+	a = (a << 1) ^ (a & 0x80 ? 0x1B : 0);
+    }
+    return p;
+}
+
+static void
+make_aes_tables()
+{
+    for (int x = 0; x < 256; ++x) {
+	uint8_t inv = 0;
+	for (int y = 1; x && y < 256; ++y)
+	    if (gf_mul(x, y) == 1) {
+		inv = y;
+		break;
+	    }
+	uint8_t s = inv;
+	for (int i = 1; i < 5; ++i)
+	    s ^= (uint8_t) ((inv << i) | (inv >> (8 - i)));
+	s ^= 0x63;
+	sbox[x] = s;
+	inv_sbox[s] = x;
+    }
+    for (int x = 0; x < 256; ++x) {
+	uint8_t s = sbox[x], is = inv_sbox[x];
+	te0[x] = ((uint32_t) gf_mul(s, 2) << 24) | ((uint32_t) s << 16)
+	    | ((uint32_t) s << 8) | gf_mul(s, 3);
+	td0[x] = ((uint32_t) gf_mul(is, 14) << 24) | ((uint32_t) gf_mul(is, 9) << 16)
+	    | ((uint32_t) gf_mul(is, 13) << 8) | gf_mul(is, 11);
+    }
+    aes_tables_ready = true;
+}
+
+#define TE(a, b, c, d)	(te0[(a) >> 24] ^ ror32(te0[((b) >> 16) & 255], 8) \
+			 ^ ror32(te0[((c) >> 8) & 255], 16) ^ ror32(te0[(d) & 255], 24))
+#define TD(a, b, c, d)	(td0[(a) >> 24] ^ ror32(td0[((b) >> 16) & 255], 8) \
+			 ^ ror32(td0[((c) >> 8) & 255], 16) ^ ror32(td0[(d) & 255], 24))
+#define SB(t, a, b, c, d) (((uint32_t) t[(a) >> 24] << 24) ^ ((uint32_t) t[((b) >> 16) & 255] << 16) \
+			   ^ ((uint32_t) t[((c) >> 8) & 255] << 8) ^ (uint32_t) t[(d) & 255])
+
+void
+IPsecCipher::aes_setup(aes_key &key, const uint8_t *user_key)
+{
+    choose_kernel();
+    if (!aes_tables_ready)
+	make_aes_tables();
+
+    uint32_t w[4 * (aes_rounds + 1)];
+    uint32_t rcon = 1;
+    for (int i = 0; i < 4; ++i)
+	w[i] = load_be32(user_key + 4 * i);
+    for (int i = 4; i < 4 * (aes_rounds + 1); ++i) {
+	uint32_t t = w[i - 1];
+	if (i % 4 == 0) {
+	    t = (t << 8) | (t >> 24);
+	    t = SB(sbox, t, t, t, t) ^ (rcon << 24);
+	    rcon = gf_mul(rcon, 2);
+	}
+	w[i] = w[i - 4] ^ t;
+    }
+    for (int i = 0; i < 4 * (aes_rounds + 1); ++i)
+	store_be32(key.enc + 4 * i, w[i]);
+
+    // Equivalent inverse cipher: reversed round keys, with InvMixColumns
+    // applied to all but the first and last.
+    for (int r = 0; r <= aes_rounds; ++r)
+	for (int j = 0; j < 4; ++j) {
+	    uint32_t x = w[4 * (aes_rounds - r) + j];
+	    if (r != 0 && r != aes_rounds)
+		x = TD((uint32_t) sbox[x >> 24] << 24, (uint32_t) sbox[(x >> 16) & 255] << 16,
+		       (uint32_t) sbox[(x >> 8) & 255] << 8, (uint32_t) sbox[x & 255]);
+	    store_be32(key.dec + 16 * r + 4 * j, x);
+	}
+}
+
+static void
+aes_encrypt_generic(const aes_key &key, const uint8_t *in, uint8_t *out)
+{
+    const uint8_t *rk = key.enc;
+    uint32_t s0 = load_be32(in) ^ load_be32(rk);
+    uint32_t s1 = load_be32(in + 4) ^ load_be32(rk + 4);
+    uint32_t s2 = load_be32(in + 8) ^ load_be32(rk + 8);
+    uint32_t s3 = load_be32(in + 12) ^ load_be32(rk + 12);
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r) {
+	rk += 16;
+	uint32_t t0 = TE(s0, s1, s2, s3) ^ load_be32(rk);
+	uint32_t t1 = TE(s1, s2, s3, s0) ^ load_be32(rk + 4);
+	uint32_t t2 = TE(s2, s3, s0, s1) ^ load_be32(rk + 8);
+	uint32_t t3 = TE(s3, s0, s1, s2) ^ load_be32(rk + 12);
+	s0 = t0, s1 = t1, s2 = t2, s3 = t3;
+    }
+    rk += 16;
+    store_be32(out, SB(sbox, s0, s1, s2, s3) ^ load_be32(rk));
+    store_be32(out + 4, SB(sbox, s1, s2, s3, s0) ^ load_be32(rk + 4));
+    store_be32(out + 8, SB(sbox, s2, s3, s0, s1) ^ load_be32(rk + 8));
+    store_be32(out + 12, SB(sbox, s3, s0, s1, s2) ^ load_be32(rk + 12));
+}
+
+static void
+aes_decrypt_generic(const aes_key &key, const uint8_t *in, uint8_t *out)
+{
+    const uint8_t *rk = key.dec;
+    uint32_t s0 = load_be32(in) ^ load_be32(rk);
+    uint32_t s1 = load_be32(in + 4) ^ load_be32(rk + 4);
+    uint32_t s2 = load_be32(in + 8) ^ load_be32(rk + 8);
+    uint32_t s3 = load_be32(in + 12) ^ load_be32(rk + 12);
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r) {
+	rk += 16;
+	uint32_t t0 = TD(s0, s3, s2, s1) ^ load_be32(rk);
+	uint32_t t1 = TD(s1, s0, s3, s2) ^ load_be32(rk + 4);
+	uint32_t t2 = TD(s2, s1, s0, s3) ^ load_be32(rk + 8);
+	uint32_t t3 = TD(s3, s2, s1, s0) ^ load_be32(rk + 12);
+	s0 = t0, s1 = t1, s2 = t2, s3 = t3;
+    }
+    rk += 16;
+    store_be32(out, SB(inv_sbox, s0, s3, s2, s1) ^ load_be32(rk));
+    store_be32(out + 4, SB(inv_sbox, s1, s0, s3, s2) ^ load_be32(rk + 4));
+    store_be32(out + 8, SB(inv_sbox, s2, s1, s0, s3) ^ load_be32(rk + 8));
+    store_be32(out + 12, SB(inv_sbox, s3, s2, s1, s0) ^ load_be32(rk + 12));
+}
+
+static inline void
+xor_block(uint8_t *x, const uint8_t *y, int len = 16)
+{
+    for (int i = 0; i < len; ++i)
+	x[i] ^= y[i];
+}
+
+static void
+aes_cbc_encrypt_generic(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+    for (; len >= 16; len -= 16, data += 16) {
+	xor_block(data, iv);
+	aes_encrypt_generic(key, data, data);
+	iv = data;
+    }
+}
+
+static void
+aes_cbc_decrypt_generic(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+    uint8_t prev[16], cur[16];
+    memcpy(prev, iv, 16);
+    for (; len >= 16; len -= 16, data += 16) {
+	memcpy(cur, data, 16);
+	aes_decrypt_generic(key, data, data);
+	xor_block(data, prev);
+	memcpy(prev, cur, 16);
+    }
+}
+
+
+// Portable GHASH, with 4-bit tables (Shoup's method)
+
+static const uint64_t ghash_last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static void
+ghash_setup_generic(gcm_key &key, const uint8_t *h)
+{
+    uint64_t vh = load_be64(h), vl = load_be64(h + 8);
+    key.hl[8] = vl;
+    key.hh[8] = vh;
+    key.hl[0] = key.hh[0] = 0;
+    for (int i = 4; i > 0; i >>= 1) {
+	uint64_t t = (vl & 1) * 0xe1000000U;
+	vl = (vh << 63) | (vl >> 1);
+	vh = (vh >> 1) ^ (t << 32);
+	key.hl[i] = vl;
+	key.hh[i] = vh;
+    }
+    for (int i = 2; i <= 8; i *= 2)
+	for (int j = 1; j < i; ++j) {
+	    key.hh[i + j] = key.hh[i] ^ key.hh[j];
+	    key.hl[i + j] = key.hl[i] ^ key.hl[j];
+	}
+}
+
+// x = x * H
+static void
+ghash_mult_generic(const gcm_key &key, uint8_t *x)
+{
+    int lo = x[15] & 15;
+    uint64_t zh = key.hh[lo], zl = key.hl[lo];
+    for (int i = 15; i >= 0; --i) {
+	lo = x[i] & 15;
+	int hi = x[i] >> 4, rem;
+	if (i != 15) {
+	    rem = zl & 15;
+	    zl = (zh << 60) | (zl >> 4);
+	    zh = (zh >> 4) ^ (ghash_last4[rem] << 48) ^ key.hh[lo];
+	    zl ^= key.hl[lo];
+	}
+	rem = zl & 15;
+	zl = (zh << 60) | (zl >> 4);
+	zh = (zh >> 4) ^ (ghash_last4[rem] << 48) ^ key.hh[hi];
+	zl ^= key.hl[hi];
+    }
+    store_be64(x, zh);
+    store_be64(x + 8, zl);
+}
+
+static void
+ghash_generic(const gcm_key &key, uint8_t *y, const uint8_t *data, int len)
+{
+    for (; len > 0; len -= 16, data += 16) {
+	xor_block(y, data, len < 16 ? len : 16);
+	ghash_mult_generic(key, y);
+    }
+}
+
+static void
+gcm_ctr_generic(const gcm_key &key, const uint8_t *nonce, uint8_t *data, int len)
+{
+    uint8_t ctr[16], ks[16];
+    memcpy(ctr, nonce, 12);
+    for (uint32_t c = 2; len > 0; ++c, len -= 16, data += 16) {
+	store_be32(ctr + 12, c);
+	aes_encrypt_generic(key.aes, ctr, ks);
+	xor_block(data, ks, len < 16 ? len : 16);
+    }
+}
+
+static void
+gcm_tag_generic(const gcm_key &key, const uint8_t *nonce,
+		const uint8_t *aad, int aad_len,
+		const uint8_t *data, int len, uint8_t *tag)
+{
+    uint8_t y[16], lens[16], j0[16];
+    memset(y, 0, 16);
+    ghash_generic(key, y, aad, aad_len);
+    ghash_generic(key, y, data, len);
+    store_be64(lens, (uint64_t) aad_len * 8);
+    store_be64(lens + 8, (uint64_t) len * 8);
+    ghash_generic(key, y, lens, 16);
+    memcpy(j0, nonce, 12);
+    store_be32(j0 + 12, 1);
+    aes_encrypt_generic(key.aes, j0, tag);
+    xor_block(tag, y);
+}
+
+
+// Portable SHA-256
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_init[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static void
+sha256_blocks_generic(uint32_t *state, const uint8_t *data, int nblocks)
+{
+    uint32_t w[64];
+    for (; nblocks > 0; --nblocks, data += 64) {
+	for (int i = 0; i < 16; ++i)
+	    w[i] = load_be32(data + 4 * i);
+	for (int i = 16; i < 64; ++i) {
+	    uint32_t s0 = ror32(w[i-15], 7) ^ ror32(w[i-15], 18) ^ (w[i-15] >> 3);
+	    uint32_t s1 = ror32(w[i-2], 17) ^ ror32(w[i-2], 19) ^ (w[i-2] >> 10);
+	    w[i] = w[i-16] + s0 + w[i-7] + s1;
+	}
+	uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+	    e = state[4], f = state[5], g = state[6], h = state[7];
+	for (int i = 0; i < 64; ++i) {
+	    uint32_t t1 = h + (ror32(e, 6) ^ ror32(e, 11) ^ ror32(e, 25))
+		+ ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+	    uint32_t t2 = (ror32(a, 2) ^ ror32(a, 13) ^ ror32(a, 22))
+		+ ((a & b) ^ (a & c) ^ (b & c));
+	    h = g, g = f, f = e, e = d + t1;
+	    d = c, c = b, b = a, a = t1 + t2;
+	}
+	state[0] += a, state[1] += b, state[2] += c, state[3] += d;
+	state[4] += e, state[5] += f, state[6] += g, state[7] += h;
+    }
+}
+
+
+#if IPSEC_CIPHER_DISPATCH
+// AES-NI, PCLMULQDQ, and SHA-NI
+
+# define AESNI_TARGET __attribute__((target("aes,pclmul,ssse3,sse4.1")))
+# define SHANI_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+
+static inline AESNI_TARGET __m128i
+load_block(const uint8_t *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+static inline AESNI_TARGET void
+store_block(uint8_t *p, __m128i x)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+}
+
+static inline AESNI_TARGET __m128i
+aesni_encrypt1(const uint8_t *rk, __m128i x)
+{
+    x = _mm_xor_si128(x, load_block(rk));
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r)
+	x = _mm_aesenc_si128(x, load_block(rk + 16 * r));
+    return _mm_aesenclast_si128(x, load_block(rk + 16 * IPsecCipher::aes_rounds));
+}
+
+static inline AESNI_TARGET void
+aesni_encrypt4(const uint8_t *rk, __m128i &x0, __m128i &x1, __m128i &x2, __m128i &x3)
+{
+    __m128i k = load_block(rk);
+    x0 = _mm_xor_si128(x0, k);
+    x1 = _mm_xor_si128(x1, k);
+    x2 = _mm_xor_si128(x2, k);
+    x3 = _mm_xor_si128(x3, k);
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r) {
+	k = load_block(rk + 16 * r);
+	x0 = _mm_aesenc_si128(x0, k);
+	x1 = _mm_aesenc_si128(x1, k);
+	x2 = _mm_aesenc_si128(x2, k);
+	x3 = _mm_aesenc_si128(x3, k);
+    }
+    k = load_block(rk + 16 * IPsecCipher::aes_rounds);
+    x0 = _mm_aesenclast_si128(x0, k);
+    x1 = _mm_aesenclast_si128(x1, k);
+    x2 = _mm_aesenclast_si128(x2, k);
+    x3 = _mm_aesenclast_si128(x3, k);
+}
+
+static inline AESNI_TARGET void
+aesni_decrypt4(const uint8_t *rk, __m128i &x0, __m128i &x1, __m128i &x2, __m128i &x3)
+{
+    __m128i k = load_block(rk);
+    x0 = _mm_xor_si128(x0, k);
+    x1 = _mm_xor_si128(x1, k);
+    x2 = _mm_xor_si128(x2, k);
+    x3 = _mm_xor_si128(x3, k);
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r) {
+	k = load_block(rk + 16 * r);
+	x0 = _mm_aesdec_si128(x0, k);
+	x1 = _mm_aesdec_si128(x1, k);
+	x2 = _mm_aesdec_si128(x2, k);
+	x3 = _mm_aesdec_si128(x3, k);
+    }
+    k = load_block(rk + 16 * IPsecCipher::aes_rounds);
+    x0 = _mm_aesdeclast_si128(x0, k);
+    x1 = _mm_aesdeclast_si128(x1, k);
+    x2 = _mm_aesdeclast_si128(x2, k);
+    x3 = _mm_aesdeclast_si128(x3, k);
+}
+
+static inline AESNI_TARGET __m128i
+aesni_decrypt1(const uint8_t *rk, __m128i x)
+{
+    x = _mm_xor_si128(x, load_block(rk));
+    for (int r = 1; r < IPsecCipher::aes_rounds; ++r)
+	x = _mm_aesdec_si128(x, load_block(rk + 16 * r));
+    return _mm_aesdeclast_si128(x, load_block(rk + 16 * IPsecCipher::aes_rounds));
+}
+
+static AESNI_TARGET void
+aes_encrypt_block_aesni(const aes_key &key, const uint8_t *in, uint8_t *out)
+{
+    store_block(out, aesni_encrypt1(key.enc, load_block(in)));
+}
+
+static AESNI_TARGET void
+aes_cbc_encrypt_aesni(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+    __m128i x = load_block(iv);
+    for (; len >= 16; len -= 16, data += 16) {
+	x = aesni_encrypt1(key.enc, _mm_xor_si128(x, load_block(data)));
+	store_block(data, x);
+    }
+}
+
+static AESNI_TARGET void
+aes_cbc_decrypt_aesni(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+    __m128i prev = load_block(iv);
+    for (; len >= 64; len -= 64, data += 64) {
+	__m128i c0 = load_block(data), c1 = load_block(data + 16),
+	    c2 = load_block(data + 32), c3 = load_block(data + 48);
+	__m128i x0 = c0, x1 = c1, x2 = c2, x3 = c3;
+	aesni_decrypt4(key.dec, x0, x1, x2, x3);
+	store_block(data, _mm_xor_si128(x0, prev));
+	store_block(data + 16, _mm_xor_si128(x1, c0));
+	store_block(data + 32, _mm_xor_si128(x2, c1));
+	store_block(data + 48, _mm_xor_si128(x3, c2));
+	prev = c3;
+    }
+    for (; len >= 16; len -= 16, data += 16) {
+	__m128i c = load_block(data);
+	store_block(data, _mm_xor_si128(aesni_decrypt1(key.dec, c), prev));
+	prev = c;
+    }
+}
+
+// Run up to four CBC chains side by side, refilling each lane with the next
+// job as its chain ends.
+static AESNI_TARGET void
+aes_cbc_encrypt_batch_aesni(IPsecCipher::cbc_job *jobs, int njobs)
+{
+    enum { nlanes = 4 };
+    const uint8_t *rk[nlanes];
+    uint8_t *data[nlanes];
+    int left[nlanes];
+    __m128i x[nlanes];
+    int next = 0, active = 0;
+
+    for (int l = 0; l < nlanes; ++l) {
+	left[l] = 0;
+	rk[l] = 0;
+    }
+    while (1) {
+	for (int l = 0; l < nlanes; ++l)
+	    if (left[l] < 16) {
+		while (next < njobs && jobs[next].len < 16)
+		    ++next;
+		if (next < njobs) {
+		    if (!rk[l])
+			++active;
+		    rk[l] = jobs[next].key->enc;
+		    data[l] = jobs[next].data;
+		    left[l] = jobs[next].len;
+		    x[l] = load_block(jobs[next].iv);
+		    ++next;
+		} else if (rk[l]) {
+		    rk[l] = 0;
+		    --active;
+		}
+	    }
+	if (active == 0)
+	    break;
+
+	for (int l = 0; l < nlanes; ++l)
+	    if (rk[l])
+		x[l] = _mm_xor_si128(_mm_xor_si128(x[l], load_block(data[l])),
+				     load_block(rk[l]));
+	for (int r = 1; r < IPsecCipher::aes_rounds; ++r)
+	    for (int l = 0; l < nlanes; ++l)
+		if (rk[l])
+		    x[l] = _mm_aesenc_si128(x[l], load_block(rk[l] + 16 * r));
+	for (int l = 0; l < nlanes; ++l)
+	    if (rk[l]) {
+		x[l] = _mm_aesenclast_si128(x[l], load_block(rk[l] + 16 * IPsecCipher::aes_rounds));
+		store_block(data[l], x[l]);
+		data[l] += 16;
+		left[l] -= 16;
+	    }
+    }
+}
+
+static const uint8_t bswap_mask_bytes[16] = {
+    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+static inline AESNI_TARGET __m128i
+bswap_block(__m128i x)
+{
+    return _mm_shuffle_epi8(x, load_block(bswap_mask_bytes));
+}
+
+// Accumulate the unreduced 256-bit carry-less product a * b into lo:hi.
+static inline AESNI_TARGET void
+clmul_accumulate(__m128i a, __m128i b, __m128i &lo, __m128i &hi)
+{
+    __m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t1 = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+			       _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i t3 = _mm_clmulepi64_si128(a, b, 0x11);
+    lo = _mm_xor_si128(lo, _mm_xor_si128(t0, _mm_slli_si128(t1, 8)));
+    hi = _mm_xor_si128(hi, _mm_xor_si128(t3, _mm_srli_si128(t1, 8)));
+}
+
+// Reduce a 256-bit product of byte-reversed GHASH values modulo the GCM
+// polynomial.  Both steps are linear, so a sum of several products can be
+// reduced once.
+static inline AESNI_TARGET __m128i
+clmul_reduce(__m128i lo, __m128i hi)
+{
+    // shift left by one bit, for the bit-reflected representation
+    __m128i t7 = _mm_srli_epi32(lo, 31), t8 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    __m128i t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    lo = _mm_or_si128(lo, t7);
+    hi = _mm_or_si128(_mm_or_si128(hi, t8), t9);
+
+    t7 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+		       _mm_slli_epi32(lo, 25));
+    t8 = _mm_srli_si128(t7, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t7, 12));
+    __m128i t2 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+			       _mm_srli_epi32(lo, 7));
+    t2 = _mm_xor_si128(t2, t8);
+    lo = _mm_xor_si128(lo, t2);
+    return _mm_xor_si128(hi, lo);
+}
+
+static inline AESNI_TARGET __m128i
+clmul_mult(__m128i a, __m128i b)
+{
+    __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    clmul_accumulate(a, b, lo, hi);
+    return clmul_reduce(lo, hi);
+}
+
+static AESNI_TARGET void
+ghash_setup_aesni(gcm_key &key, const uint8_t *h)
+{
+    __m128i h1 = bswap_block(load_block(h));
+    __m128i hp = h1;
+    for (int i = 0; i < 4; ++i) {
+	store_block(key.hpow[i], hp);
+	hp = clmul_mult(hp, h1);
+    }
+}
+
+// GHASH, four blocks per reduction; y is byte-reversed.
+static inline AESNI_TARGET __m128i
+ghash_aesni(const gcm_key &key, __m128i y, const uint8_t *data, int len)
+{
+    __m128i h1 = load_block(key.hpow[0]);
+    if (len >= 64) {
+	__m128i h2 = load_block(key.hpow[1]), h3 = load_block(key.hpow[2]),
+	    h4 = load_block(key.hpow[3]);
+	for (; len >= 64; len -= 64, data += 64) {
+	    __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+	    clmul_accumulate(_mm_xor_si128(y, bswap_block(load_block(data))), h4, lo, hi);
+	    clmul_accumulate(bswap_block(load_block(data + 16)), h3, lo, hi);
+	    clmul_accumulate(bswap_block(load_block(data + 32)), h2, lo, hi);
+	    clmul_accumulate(bswap_block(load_block(data + 48)), h1, lo, hi);
+	    y = clmul_reduce(lo, hi);
+	}
+    }
+    for (; len >= 16; len -= 16, data += 16)
+	y = clmul_mult(_mm_xor_si128(y, bswap_block(load_block(data))), h1);
+    if (len > 0) {
+	uint8_t last[16];
+	memset(last, 0, 16);
+	memcpy(last, data, len);
+	y = clmul_mult(_mm_xor_si128(y, bswap_block(load_block(last))), h1);
+    }
+    return y;
+}
+
+static AESNI_TARGET void
+gcm_ctr_aesni(const gcm_key &key, const uint8_t *nonce, uint8_t *data, int len)
+{
+    uint8_t ctr_bytes[16];
+    memcpy(ctr_bytes, nonce, 12);
+    memset(ctr_bytes + 12, 0, 4);
+    __m128i base = load_block(ctr_bytes);
+    uint32_t c = 2;
+    for (; len >= 64; len -= 64, data += 64, c += 4) {
+	__m128i x0 = _mm_insert_epi32(base, htonl(c), 3);
+	__m128i x1 = _mm_insert_epi32(base, htonl(c + 1), 3);
+	__m128i x2 = _mm_insert_epi32(base, htonl(c + 2), 3);
+	__m128i x3 = _mm_insert_epi32(base, htonl(c + 3), 3);
+	aesni_encrypt4(key.aes.enc, x0, x1, x2, x3);
+	store_block(data, _mm_xor_si128(x0, load_block(data)));
+	store_block(data + 16, _mm_xor_si128(x1, load_block(data + 16)));
+	store_block(data + 32, _mm_xor_si128(x2, load_block(data + 32)));
+	store_block(data + 48, _mm_xor_si128(x3, load_block(data + 48)));
+    }
+    for (; len > 0; len -= 16, data += 16, ++c) {
+	__m128i ks = aesni_encrypt1(key.aes.enc, _mm_insert_epi32(base, htonl(c), 3));
+	if (len >= 16)
+	    store_block(data, _mm_xor_si128(ks, load_block(data)));
+	else {
+	    uint8_t ks_bytes[16];
+	    store_block(ks_bytes, ks);
+	    xor_block(data, ks_bytes, len);
+	}
+    }
+}
+
+static AESNI_TARGET void
+gcm_tag_aesni(const gcm_key &key, const uint8_t *nonce,
+	      const uint8_t *aad, int aad_len,
+	      const uint8_t *data, int len, uint8_t *tag)
+{
+    uint8_t buf[16];
+    __m128i y = _mm_setzero_si128();
+    y = ghash_aesni(key, y, aad, aad_len);
+    y = ghash_aesni(key, y, data, len);
+    store_be64(buf, (uint64_t) aad_len * 8);
+    store_be64(buf + 8, (uint64_t) len * 8);
+    y = ghash_aesni(key, y, buf, 16);
+    memcpy(buf, nonce, 12);
+    store_be32(buf + 12, 1);
+    __m128i ek = aesni_encrypt1(key.aes.enc, load_block(buf));
+    store_block(tag, _mm_xor_si128(ek, bswap_block(y)));
+}
+
+static SHANI_TARGET void
+sha256_blocks_shani(uint32_t *state, const uint8_t *data, int nblocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);			// CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);		// EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);	// ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);	// CDGH
+
+    for (; nblocks > 0; --nblocks, data += 64) {
+	__m128i abef = state0, cdgh = state1, w[4];
+	for (int i = 0; i < 4; ++i)
+	    w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), mask);
+	for (int g = 0; g < 16; ++g) {
+	    __m128i msg = _mm_add_epi32(w[g & 3], _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256_k + 4 * g)));
+	    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	    msg = _mm_shuffle_epi32(msg, 0x0E);
+	    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	    if (g < 12) {
+		__m128i x = _mm_sha256msg1_epu32(w[g & 3], w[(g + 1) & 3]);
+		x = _mm_add_epi32(x, _mm_alignr_epi8(w[(g + 3) & 3], w[(g + 2) & 3], 4));
+		w[g & 3] = _mm_sha256msg2_epu32(x, w[(g + 3) & 3]);
+	    }
+	}
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);		// FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);		// DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);	// DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);		// HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), state1);
+}
+#endif
+
+
+// Entry points
+
+void
+IPsecCipher::aes_encrypt_block(const aes_key &key, const uint8_t *in, uint8_t *out)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni)
+	return aes_encrypt_block_aesni(key, in, out);
+#endif
+    aes_encrypt_generic(key, in, out);
+}
+
+void
+IPsecCipher::aes_cbc_encrypt(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni)
+	return aes_cbc_encrypt_aesni(key, iv, data, len);
+#endif
+    aes_cbc_encrypt_generic(key, iv, data, len);
+}
+
+void
+IPsecCipher::aes_cbc_encrypt_batch(cbc_job *jobs, int njobs)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni)
+	return aes_cbc_encrypt_batch_aesni(jobs, njobs);
+#endif
+    for (int i = 0; i < njobs; ++i)
+	aes_cbc_encrypt_generic(*jobs[i].key, jobs[i].iv, jobs[i].data, jobs[i].len);
+}
+
+void
+IPsecCipher::aes_cbc_decrypt(const aes_key &key, const uint8_t *iv, uint8_t *data, int len)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni)
+	return aes_cbc_decrypt_aesni(key, iv, data, len);
+#endif
+    aes_cbc_decrypt_generic(key, iv, data, len);
+}
+
+void
+IPsecCipher::gcm_setup(gcm_key &key, const uint8_t *user_key)
+{
+    uint8_t h[16];
+    aes_setup(key.aes, user_key);
+    memset(h, 0, 16);
+    aes_encrypt_generic(key.aes, h, h);
+    ghash_setup_generic(key, h);
+#if IPSEC_CIPHER_DISPATCH
+    // Compute the PCLMULQDQ powers whenever the CPU can use them, so
+    // set_kernel() may switch implementations after setup.
+    if (cpu_has_aesni())
+	ghash_setup_aesni(key, h);
+    else
+#endif
+	memset(key.hpow, 0, sizeof(key.hpow));
+}
+
+void
+IPsecCipher::gcm_encrypt(const gcm_key &key, const uint8_t *nonce,
+			 const uint8_t *aad, int aad_len,
+			 uint8_t *data, int len, uint8_t *tag)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni) {
+	gcm_ctr_aesni(key, nonce, data, len);
+	gcm_tag_aesni(key, nonce, aad, aad_len, data, len, tag);
+	return;
+    }
+#endif
+    gcm_ctr_generic(key, nonce, data, len);
+    gcm_tag_generic(key, nonce, aad, aad_len, data, len, tag);
+}
+
+bool
+IPsecCipher::gcm_decrypt(const gcm_key &key, const uint8_t *nonce,
+			 const uint8_t *aad, int aad_len,
+			 uint8_t *data, int len, const uint8_t *tag)
+{
+    uint8_t expected[gcm_tag_size];
+#if IPSEC_CIPHER_DISPATCH
+    if (use_aesni) {
+	gcm_tag_aesni(key, nonce, aad, aad_len, data, len, expected);
+	if (!equal_tags(expected, tag, gcm_tag_size))
+	    return false;
+	gcm_ctr_aesni(key, nonce, data, len);
+	return true;
+    }
+#endif
+    gcm_tag_generic(key, nonce, aad, aad_len, data, len, expected);
+    if (!equal_tags(expected, tag, gcm_tag_size))
+	return false;
+    gcm_ctr_generic(key, nonce, data, len);
+    return true;
+}
+
+static inline void
+sha256_blocks(uint32_t *state, const uint8_t *data, int nblocks)
+{
+#if IPSEC_CIPHER_DISPATCH
+    if (use_shani)
+	return sha256_blocks_shani(state, data, nblocks);
+#endif
+    sha256_blocks_generic(state, data, nblocks);
+}
+
+// Hash @a len more bytes into @a state, which has already absorbed
+// @a prefix_len bytes (a multiple of the block size), and finish.
+static void
+sha256_finish(uint32_t *state, const uint8_t *data, int len,
+	      uint64_t prefix_len, uint8_t *digest)
+{
+    uint8_t last[128];
+    int nfull = len / 64, rest = len % 64;
+    sha256_blocks(state, data, nfull);
+    memcpy(last, data + nfull * 64, rest);
+    last[rest] = 0x80;
+    int lastlen = (rest < 56 ? 64 : 128);
+    memset(last + rest + 1, 0, lastlen - rest - 9);
+    store_be64(last + lastlen - 8, (prefix_len + len) * 8);
+    sha256_blocks(state, last, lastlen / 64);
+    for (int i = 0; i < 8; ++i)
+	store_be32(digest + 4 * i, state[i]);
+}
+
+void
+IPsecCipher::sha256(const uint8_t *data, int len, uint8_t *digest)
+{
+    uint32_t state[8];
+    choose_kernel();
+    memcpy(state, sha256_init, sizeof(state));
+    sha256_finish(state, data, len, 0, digest);
+}
+
+void
+IPsecCipher::hmac_sha256_setup(hmac_key &key, const uint8_t *user_key, int key_len)
+{
+    uint8_t k[sha256_block_size], pad[sha256_block_size];
+    choose_kernel();
+    memset(k, 0, sizeof(k));
+    if (key_len > sha256_block_size)
+	sha256(user_key, key_len, k);
+    else
+	memcpy(k, user_key, key_len);
+
+    for (int i = 0; i < sha256_block_size; ++i)
+	pad[i] = k[i] ^ 0x36;
+    memcpy(key.inner, sha256_init, sizeof(key.inner));
+    sha256_blocks(key.inner, pad, 1);
+    for (int i = 0; i < sha256_block_size; ++i)
+	pad[i] = k[i] ^ 0x5c;
+    memcpy(key.outer, sha256_init, sizeof(key.outer));
+    sha256_blocks(key.outer, pad, 1);
+}
+
+void
+IPsecCipher::hmac_sha256(const hmac_key &key, const uint8_t *data, int len, uint8_t *digest)
+{
+    uint32_t state[8];
+    uint8_t inner[sha256_digest_size];
+    memcpy(state, key.inner, sizeof(state));
+    sha256_finish(state, data, len, sha256_block_size, inner);
+    memcpy(state, key.outer, sizeof(state));
+    sha256_finish(state, inner, sizeof(inner), sha256_block_size, digest);
+}
+
+int
+IPsecCipher::random_bytes(void *buf, int len)
+{
+#if CLICK_USERLEVEL
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0)
+	return -1;
+    uint8_t *p = reinterpret_cast<uint8_t *>(buf);
+    while (len > 0) {
+	ssize_t r = read(fd, p, len);
+	if (r <= 0 && (r == 0 || errno != EINTR))
+	    break;
+	else if (r > 0)
+	    p += r, len -= r;
+    }
+    close(fd);
+    return len == 0 ? 0 : -1;
+#elif CLICK_LINUXMODULE
+    get_random_bytes(buf, len);
+    return 0;
+#else
+    (void) buf, (void) len;
+    return -1;
+#endif
+}
+
+CLICK_ENDDECLS
+ELEMENT_PROVIDES(IPsecCipher)
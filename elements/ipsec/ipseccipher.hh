@@ -0,0 +1,118 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPSECCIPHER_HH
+#define CLICK_IPSECCIPHER_HH
+#include <click/glue.hh>
+CLICK_DECLS
+
+/*
+ * ipseccipher.hh -- AES-GCM, AES-CBC, and HMAC-SHA-256 for IPsec ESP
+ *
+ * IPsecCipher implements the ciphers behind two ESP transforms: AES-GCM
+ * (RFC 4106) and AES-CBC (RFC 3602) with HMAC-SHA-256-128 (RFC 4868).  Every
+ * function has a portable implementation.  At user level on x86, IPsecCipher
+ * also has implementations using the AES-NI, PCLMULQDQ, and SHA-NI
+ * instructions, and uses them when the CPU supports them.
+ *
+ * The accelerated implementations pipeline independent AES blocks: four
+ * counter blocks at a time for GCM, four ciphertext blocks at a time for CBC
+ * decryption, and, in aes_cbc_encrypt_batch(), four packets' CBC chains at a
+ * time, since one chain cannot be parallelized.
+ *
+ * Keys are expanded once, when a security association is set up.  Expanded
+ * keys are read-only afterwards, so several threads may share them.
+ */
+
+class IPsecCipher { public:
+
+    enum { aes_block_size = 16, aes_key_size = 16, aes_rounds = 10,
+	   gcm_nonce_size = 12, gcm_tag_size = 16,
+	   sha256_block_size = 64, sha256_digest_size = 32 };
+
+    /** @brief An expanded AES-128 key.
+     *
+     * @a dec holds the round keys for the equivalent inverse cipher. */
+    struct aes_key {
+	uint8_t enc[(aes_rounds + 1) * aes_block_size];
+	uint8_t dec[(aes_rounds + 1) * aes_block_size];
+    };
+
+    /** @brief An expanded AES-GCM key. */
+    struct gcm_key {
+	aes_key aes;
+	uint8_t hpow[4][aes_block_size];	// H..H^4, byte-reversed (PCLMULQDQ)
+	uint64_t hl[16];			// 4-bit tables (portable GHASH)
+	uint64_t hh[16];
+    };
+
+    /** @brief An expanded HMAC-SHA-256 key: the hash states after
+     * absorbing the key XORed with the inner and outer pads. */
+    struct hmac_key {
+	uint32_t inner[8];
+	uint32_t outer[8];
+    };
+
+    /** @brief One buffer to encrypt with aes_cbc_encrypt_batch(). */
+    struct cbc_job {
+	const aes_key *key;
+	const uint8_t *iv;
+	uint8_t *data;
+	int len;
+    };
+
+    static void aes_setup(aes_key &key, const uint8_t *user_key);
+    static void aes_encrypt_block(const aes_key &key, const uint8_t *in, uint8_t *out);
+
+    /** @brief Encrypt @a len bytes in place with AES-CBC.
+     *
+     * @a len must be a multiple of aes_block_size. */
+    static void aes_cbc_encrypt(const aes_key &key, const uint8_t *iv, uint8_t *data, int len);
+    /** @brief Encrypt each of @a njobs buffers in place with AES-CBC.
+     *
+     * Equivalent to calling aes_cbc_encrypt() for each job, but faster when
+     * several jobs can be interleaved. */
+    static void aes_cbc_encrypt_batch(cbc_job *jobs, int njobs);
+    static void aes_cbc_decrypt(const aes_key &key, const uint8_t *iv, uint8_t *data, int len);
+
+    static void gcm_setup(gcm_key &key, const uint8_t *user_key);
+    /** @brief Encrypt @a len bytes in place with AES-GCM.
+     * @param nonce gcm_nonce_size bytes
+     * @param tag receives gcm_tag_size bytes
+     *
+     * The tag also authenticates @a aad_len bytes of additional data. */
+    static void gcm_encrypt(const gcm_key &key, const uint8_t *nonce,
+			    const uint8_t *aad, int aad_len,
+			    uint8_t *data, int len, uint8_t *tag);
+    /** @brief Check @a tag, then decrypt @a len bytes in place with AES-GCM.
+     * @return true if @a tag was correct; if not, @a data is unchanged */
+    static bool gcm_decrypt(const gcm_key &key, const uint8_t *nonce,
+			    const uint8_t *aad, int aad_len,
+			    uint8_t *data, int len, const uint8_t *tag);
+
+    static void sha256(const uint8_t *data, int len, uint8_t *digest);
+    static void hmac_sha256_setup(hmac_key &key, const uint8_t *user_key, int key_len);
+    static void hmac_sha256(const hmac_key &key, const uint8_t *data, int len, uint8_t *digest);
+
+    /** @brief Compare @a len bytes in time independent of their values. */
+    static bool equal_tags(const uint8_t *a, const uint8_t *b, int len);
+
+    /** @brief Fill @a len bytes from the operating system's cryptographic
+     * random number generator.
+     * @return 0 on success, -1 if there is none
+     *
+     * Unlike click_random(), the result does not depend on RandomSeed. */
+    static int random_bytes(void *buf, int len);
+
+    /** @brief Choose the implementation: "generic" or "aesni".
+     * @return 0 on success, -1 if @a name is unknown or this CPU cannot
+     * run it
+     *
+     * "aesni" uses AES-NI and PCLMULQDQ, and SHA-NI if the CPU has it.
+     * IPsecCipher normally picks "aesni" when the CPU supports it. */
+    static int set_kernel(const char *name);
+    /** @brief Return the implementation in use, such as "aesni+shani". */
+    static const char *kernel();
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,233 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * ipseccrypt.{cc,hh} -- element applies AES-GCM and AES-CBC/HMAC-SHA-256
+ * ESP transforms
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#ifndef HAVE_IPSEC
+# error "Must #define HAVE_IPSEC in config.h"
+#endif
+#include "ipseccrypt.hh"
+#include <click/confparse.hh>
+#include <click/error.hh>
+#include <click/packet_anno.hh>
+#include <click/standard/scheduleinfo.hh>
+#include "sadatatuple.hh"
+CLICK_DECLS
+
+// ESP header: SPI and sequence number, which are also GCM's additional
+// authenticated data
+enum { esp_header_len = 8, icv_len = 16 };
+
+IPsecCrypt::IPsecCrypt()
+    : _nbatch(0), _task(this)
+{
+}
+
+IPsecCrypt::~IPsecCrypt()
+{
+}
+
+int
+IPsecCrypt::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _batch_size = 16;
+    if (cp_va_kparse(conf, this, errh,
+		     "ENCRYPT", cpkP+cpkM, cpBool, &_encrypt,
+		     "BATCH", 0, cpInteger, &_batch_size,
+		     cpEnd) < 0)
+	return -1;
+    if (_batch_size < 1 || _batch_size > max_batch)
+	return errh->error("BATCH must be between 1 and %d", (int) max_batch);
+    return 0;
+}
+
+int
+IPsecCrypt::initialize(ErrorHandler *errh)
+{
+    _drops = 0;
+    ScheduleInfo::initialize_task(this, &_task, false, errh);
+    return 0;
+}
+
+void
+IPsecCrypt::cleanup(CleanupStage)
+{
+    for (int i = 0; i < _nbatch; ++i)
+	_batch[i]->kill();
+    _nbatch = 0;
+}
+
+void
+IPsecCrypt::push(int, Packet *p)
+{
+    _batch[_nbatch++] = p;
+    if (_nbatch == _batch_size)
+	flush();
+    else if (_nbatch == 1)
+	_task.reschedule();
+}
+
+bool
+IPsecCrypt::run_task(Task *)
+{
+    if (!_nbatch)
+	return false;
+    flush();
+    return true;
+}
+
+void
+IPsecCrypt::drop(Packet *p)
+{
+    _drops++;
+    checked_output_push(1, p);
+}
+
+void
+IPsecCrypt::flush()
+{
+    if (_encrypt)
+	encrypt_batch();
+    else
+	decrypt_batch();
+
+    int n = _nbatch;
+    _nbatch = 0;
+    for (int i = 0; i < n; ++i)
+	if (_batch[i])
+	    output(0).push(_batch[i]);
+}
+
+void
+IPsecCrypt::encrypt_batch()
+{
+    IPsecCipher::cbc_job jobs[max_batch];
+    SADataTuple *cbc_sa[max_batch];
+    int cbc_index[max_batch];
+    int njobs = 0;
+
+    for (int i = 0; i < _nbatch; ++i) {
+	Packet *p = _batch[i];
+	SADataTuple *sa = (SADataTuple *) IPSEC_SA_DATA_REFERENCE_ANNO(p);
+	int payload_len = (sa ? p->length() - esp_header_len - sa->iv_length() : 0);
+	if (!sa || sa->transform == SA_LEGACY || payload_len < 2
+	    || payload_len % sa->pad_block() != 0) {
+	    _batch[i] = 0;
+	    drop(p);
+	    continue;
+	}
+	WritablePacket *q = p->put(icv_len);
+	if (!(_batch[i] = q))
+	    continue;
+	uint8_t *iv = q->data() + esp_header_len;
+	uint8_t *payload = iv + sa->iv_length();
+
+	if (sa->transform == SA_AES_GCM) {
+	    uint8_t nonce[IPsecCipher::gcm_nonce_size];
+	    memcpy(nonce, sa->salt, 4);
+	    memcpy(nonce + 4, iv, 8);
+	    IPsecCipher::gcm_encrypt(sa->cipher_key, nonce, q->data(), esp_header_len,
+				     payload, payload_len, payload + payload_len);
+	} else {
+	    // Encrypt the counter block from IPsecESPEncap for an
+	    // unpredictable IV (NIST SP 800-38A, appendix C).
+	    IPsecCipher::aes_encrypt_block(sa->cipher_key.aes, iv, iv);
+	    jobs[njobs].key = &sa->cipher_key.aes;
+	    jobs[njobs].iv = iv;
+	    jobs[njobs].data = payload;
+	    jobs[njobs].len = payload_len;
+	    cbc_sa[njobs] = sa;
+	    cbc_index[njobs] = i;
+	    ++njobs;
+	}
+    }
+
+    if (njobs) {
+	IPsecCipher::aes_cbc_encrypt_batch(jobs, njobs);
+	for (int j = 0; j < njobs; ++j) {
+	    Packet *q = _batch[cbc_index[j]];
+	    uint8_t digest[IPsecCipher::sha256_digest_size];
+	    int len = q->length() - icv_len;
+	    IPsecCipher::hmac_sha256(cbc_sa[j]->auth_key, q->data(), len, digest);
+	    memcpy(const_cast<unsigned char *>(q->data()) + len, digest, icv_len);
+	}
+    }
+}
+
+void
+IPsecCrypt::decrypt_batch()
+{
+    for (int i = 0; i < _nbatch; ++i) {
+	Packet *p = _batch[i];
+	SADataTuple *sa = (SADataTuple *) IPSEC_SA_DATA_REFERENCE_ANNO(p);
+	int payload_len = (sa ? p->length() - esp_header_len - sa->iv_length() - icv_len : 0);
+	if (!sa || sa->transform == SA_LEGACY || payload_len < 2
+	    || payload_len % sa->pad_block() != 0) {
+	    _batch[i] = 0;
+	    drop(p);
+	    continue;
+	}
+	WritablePacket *q = p->uniqueify();
+	if (!(_batch[i] = q))
+	    continue;
+	uint8_t *iv = q->data() + esp_header_len;
+	uint8_t *payload = iv + sa->iv_length();
+	uint8_t *icv = payload + payload_len;
+
+	bool ok;
+	if (sa->transform == SA_AES_GCM) {
+	    uint8_t nonce[IPsecCipher::gcm_nonce_size];
+	    memcpy(nonce, sa->salt, 4);
+	    memcpy(nonce + 4, iv, 8);
+	    ok = IPsecCipher::gcm_decrypt(sa->cipher_key, nonce, q->data(), esp_header_len,
+					  payload, payload_len, icv);
+	} else {
+	    uint8_t digest[IPsecCipher::sha256_digest_size];
+	    IPsecCipher::hmac_sha256(sa->auth_key, q->data(), icv - q->data(), digest);
+	    ok = IPsecCipher::equal_tags(digest, icv, icv_len);
+	    if (ok)
+		IPsecCipher::aes_cbc_decrypt(sa->cipher_key.aes, iv, payload, payload_len);
+	}
+
+	if (ok)
+	    q->take(icv_len);
+	else {
+	    _batch[i] = 0;
+	    drop(q);
+	}
+    }
+}
+
+String
+IPsecCrypt::read_handler(Element *e, void *thunk)
+{
+    IPsecCrypt *c = static_cast<IPsecCrypt *>(e);
+    if (thunk)
+	return IPsecCipher::kernel();
+    else
+	return String(c->_drops.value());
+}
+
+void
+IPsecCrypt::add_handlers()
+{
+    add_read_handler("drops", read_handler, (void *) 0);
+    add_read_handler("kernel", read_handler, (void *) 1);
+    add_task_handlers(&_task);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(IPsecCipher)
+EXPORT_ELEMENT(IPsecCrypt)
@@ -0,0 +1,103 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPSECCRYPT_HH
+#define CLICK_IPSECCRYPT_HH
+#include <click/element.hh>
+#include <click/task.hh>
+#include <click/atomic.hh>
+#include "ipseccipher.hh"
+CLICK_DECLS
+
+/*
+=c
+
+IPsecCrypt(ENCRYPT, I<keywords> BATCH)
+
+=s ipsec
+
+encrypts and authenticates ESP packets with AES-GCM or AES-CBC/HMAC-SHA-256
+
+=d
+
+Applies the ESP transform of each packet's security association, as set by
+an IPsecRouteTable element such as RadixIPsecLookup.  Input packets start
+with the ESP header.  IPsecCrypt handles the C<aes-gcm> transform, AES-128-GCM
+with a 16-byte ICV (RFC 4106), and the C<aes-cbc-hmac-sha256> transform,
+AES-128-CBC (RFC 3602) with HMAC-SHA-256-128 (RFC 4868).
+
+If ENCRYPT is true, IPsecCrypt encrypts packets from IPsecESPEncap and
+appends the ICV.  Otherwise, it checks and removes the ICV, then decrypts;
+IPsecESPUnencap can then remove the ESP header and padding.  Packets that fail
+authentication, are too short, or whose security association uses another
+transform, are emitted on output 1 if it exists and dropped otherwise.
+
+On x86 CPUs with AES-NI and PCLMULQDQ, IPsecCrypt uses those instructions,
+and SHA-NI for HMAC-SHA-256 if present.  To help them, IPsecCrypt collects up
+to BATCH packets before processing them together: for aes-cbc-hmac-sha256, it
+encrypts the packets' CBC chains side by side.  A batch is processed when full
+or, at the latest, when IPsecCrypt's task next runs.
+
+Keyword arguments are:
+
+=over 8
+
+=item BATCH
+
+Integer between 1 and 64.  Maximum number of packets processed together.
+Default is 16.
+
+=back
+
+=h drops read-only
+
+Returns the number of packets emitted on output 1 or dropped.
+
+=h kernel read-only
+
+Returns the cipher implementation in use, such as "aesni+shani" or
+"generic".
+
+=e
+
+  rt[1] -> IPsecESPEncap -> IPsecCrypt(true) -> IPsecEncap(50) -> ...
+  rt[0] -> StripIPHeader -> IPsecCrypt(false) -> IPsecESPUnencap -> ...
+
+=a IPsecESPEncap, IPsecESPUnencap, RadixIPsecLookup, IPsecCipherBench */
+
+class IPsecCrypt : public Element { public:
+
+    IPsecCrypt();
+    ~IPsecCrypt();
+
+    const char *class_name() const	{ return "IPsecCrypt"; }
+    const char *port_count() const	{ return "1/1-2"; }
+    const char *processing() const	{ return PUSH; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+    bool run_task(Task *task);
+
+  private:
+
+    enum { max_batch = 64 };
+
+    bool _encrypt;
+    int _batch_size;
+    int _nbatch;
+    Packet *_batch[max_batch];
+    Task _task;
+    atomic_uint32_t _drops;
+
+    void flush();
+    void encrypt_batch();
+    void decrypt_batch();
+    void drop(Packet *p);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -47,6 +47,9 @@ cp_ipsec_route(String s, IPsecRoute *r_store, bool remove_route, Element *contex
     //Data to initialize the SADataTuple
     unsigned int replay;
     uint8_t  oowin;
+    String transform;
+    uint32_t salt = 0;
+    int t;
 
     SADataTuple * sa_data;
 
@@ -80,22 +83,45 @@ cp_ipsec_route(String s, IPsecRoute *r_store, bool remove_route, Element *contex
     Vector<String> words;
     words.push_back(word);
     cp_spacevec(s, words);
+    // keyword arguments arrive as two words; rejoin them
+    for (int i = 0; i + 1 < words.size(); i++)
+	if (words[i] == "TRANSFORM" || words[i] == "SALT") {
+	    words[i] += " " + words[i + 1];
+	    words.erase(words.begin() + i + 1);
+	}
     String enc_key, auth_key;
     if (cp_va_kparse(words, context, ErrorHandler::default_handler(),
 		     "SPI", cpkP+cpkM, cpUnsigned, &r.spi,
 		     "ENCRYPT_KEY", cpkP+cpkM, cpString, &enc_key,
 		     "AUTH_KEY", cpkP+cpkM, cpString, &auth_key,
 		     "REPLAY", cpkP+cpkM, cpUnsigned, &replay,
-		     "OOSIZE", cpkP+cpkM, cpUnsigned, &oowin,
+		     "OOSIZE", cpkP+cpkM, cpByte, &oowin,
+		     "TRANSFORM", 0, cpWord, &transform,
+		     "SALT", 0, cpUnsigned, &salt,
 		     cpEnd) < 0)
 	return false;
     if (enc_key.length() != 16 || auth_key.length() != 16) {
 	click_chatter("key has bad length");
 	return false;
     }
+    if (!transform || transform == "legacy")
+	t = SA_LEGACY;
+    else if (transform == "aes-gcm")
+	t = SA_AES_GCM;
+    else if (transform == "aes-cbc-hmac-sha256")
+	t = SA_AES_CBC_HMAC_SHA256;
+    else {
+	click_chatter("unknown transform %s", transform.c_str());
+	return false;
+    }
 
     // Create new Security Association Table entry
     sa_data = new SADataTuple(enc_key.data(), auth_key.data(), replay, oowin);
+    if (sa_data->set_transform(t, salt) < 0) {
+	click_chatter("%s needs a cryptographic random source for its IVs", transform.c_str());
+	delete sa_data;
+	return false;
+    }
     ((IPsecRouteTable*)context)->_sa_table.insert(SPI(r.spi),*sa_data);
     //Set Tuple reference in the Routing entry
     r.sa_data = sa_data;
@@ -267,6 +293,8 @@ IPsecRouteTable::run_command(int command, const String &str, Vector<IPsecRoute>
 	r = add_route(route, true, &old_route, errh);
     else
 	r = remove_route(route, &old_route, errh);
+    if (r >= 0 && command == CMD_SET && old_route.port >= 0 && route.sa_data)
+	route.sa_data->continue_iv(old_route.sa_data);
 
     // save old route if in a transaction
     if (r >= 0 && old_routes) {
@@ -344,8 +372,12 @@ IPsecRouteTable::ctrl_handler(const String &conf_in, Element *e, void *, ErrorHa
 	    table->add_route(rt, false, 0, errh);
 	else if (rt.extra == CMD_ADD)
 	    table->remove_route(rt, 0, errh);
-	else
-	    table->add_route(rt, true, 0, errh);
+	else {
+	    IPsecRoute replaced;
+	    if (table->add_route(rt, true, &replaced, errh) >= 0
+		&& replaced.port >= 0 && rt.sa_data)
+		rt.sa_data->continue_iv(replaced.sa_data);
+	}
 	old_routes.pop_back();
     }
     return r;
@@ -389,4 +421,5 @@ IPsecRouteTable::add_handlers()
 }
 
 CLICK_ENDDECLS
+ELEMENT_REQUIRES(IPsecCipher)
 ELEMENT_PROVIDES(IPsecRouteTable)
@@ -166,9 +166,20 @@ tunneled traffic accordingly. All the routing table entries that refer to an IPS
 |SPI| |128-BIT ENCRYPTION_KEY| |128-BIT AUTHENTICATION_KEY| |REPLAY PROTECTION COUNTER| |OUT-OF-ORDER REPLAY WINDOW|
 The encryption and authentication keys will generally be specified using
 syntax such as C<\E<lt>0183 A947 1ABE 01FF FA04 103B B102<gt>>.
+ An IPsec route may also give the keyword arguments C<TRANSFORM> and
+C<SALT>.  TRANSFORM selects the ESP transform: C<legacy> (the default), for
+use with IPsecDES or IPsecAES and IPsecAuthHMACSHA1; C<aes-gcm>, AES-128-GCM
+with a 16-byte ICV (RFC 4106); or C<aes-cbc-hmac-sha256>, AES-128-CBC (RFC
+3602) with HMAC-SHA-256-128 (RFC 4868).  The last two are applied by
+IPsecCrypt.  SALT is the 32-bit AES-GCM nonce salt; default is 0.  The
+explicit IVs of an AES-GCM SA count up from a 64-bit value read from the
+operating system's random number generator (not click_random, so RandomSeed
+does not affect it); a route with one of these transforms is an error where
+there is no such generator.  When C<set> replaces a route whose SA has the
+same key, the new SA continues the old one's count.
  This module uses 4 and 5 annotation space integers to pass Security Association Data between IPsec modules.
 
-=a RadixIPLookup, RangeIPsecLookup */
+=a RadixIPLookup, RangeIPsecLookup, IPsecCrypt */
 
 
 //Hosts IPsec extensions
@@ -5,6 +5,7 @@
 #include <click/etheraddress.hh>
 #include <click/bighashmap.hh>
 #include <click/glue.hh>
+#include "ipseccipher.hh"
 CLICK_DECLS
 
 /*
@@ -67,6 +68,11 @@ class SPI {
 	uint32_t _spi;
  };
 
+/* ESP transforms.  SA_LEGACY packets are encrypted and authenticated by
+   separate elements, such as IPsecAES and IPsecAuthHMACSHA1; the others by
+   IPsecCrypt. */
+enum { SA_LEGACY = 0, SA_AES_GCM = 1, SA_AES_CBC_HMAC_SHA256 = 2 };
+
 // Security Association Data Tuple
 class SADataTuple {
   public:
@@ -80,6 +86,12 @@ class SADataTuple {
     uint8_t  ooowin;	/* out-of-order window size */
     uint32_t bitmap;	/* Support out-of-order receive support */
     uint32_t lastseq;	/* in host order */
+    /*These fields below deal with the transform*/
+    uint8_t transform;	/* SA_LEGACY, SA_AES_GCM, ... */
+    uint8_t salt[4];	/* AES-GCM nonce salt, RFC 4106 */
+    uint64_t iv_counter;	/* next explicit IV */
+    IPsecCipher::gcm_key cipher_key;	/* expanded Encryption_key */
+    IPsecCipher::hmac_key auth_key;	/* expanded Authentication_key */
 
     SADataTuple() {
 	memset(this, 0, sizeof(*this));
@@ -96,6 +108,69 @@ class SADataTuple {
 		lastseq=cur_rpl=counter;
      }
 
+    /* Select the transform and expand the keys for it.  Returns -1 if
+       there is no cryptographic random source to seed the IV counter. */
+    int set_transform(int t, uint32_t salt_value)
+    {
+	transform = t;
+	salt[0] = salt_value >> 24;
+	salt[1] = salt_value >> 16;
+	salt[2] = salt_value >> 8;
+	salt[3] = salt_value;
+	if (t != SA_LEGACY) {
+	    IPsecCipher::gcm_setup(cipher_key, Encryption_key);
+	    IPsecCipher::hmac_sha256_setup(auth_key, Authentication_key, KEY_SIZE);
+	    // AES-GCM must never repeat an IV under one key, and keys are
+	    // static, so an SA installed again (after a restart, say) must not
+	    // start counting where its predecessor did.  click_random() won't
+	    // do: RandomSeed can fix its seed, and it has only 32 bits.
+	    if (IPsecCipher::random_bytes(&iv_counter, sizeof(iv_counter)) < 0)
+		return -1;
+	}
+	return 0;
+    }
+
+    /* Return the next explicit IV.  Several threads may encapsulate
+       with one SA, so this must not hand out a counter value twice. */
+    uint64_t next_iv()
+    {
+#if CLICK_LINUXMODULE || HAVE_MULTITHREAD
+	return __sync_fetch_and_add(&iv_counter, 1);
+#else
+	return iv_counter++;
+#endif
+    }
+
+    /* Continue the IV sequence of old, which this SA replaces.  Leave a gap
+       for packets other threads encapsulate with old during the switch. */
+    void continue_iv(const SADataTuple *old)
+    {
+	if (old && old != this && transform != SA_LEGACY
+	    && old->transform == transform
+	    && memcmp(old->Encryption_key, Encryption_key, KEY_SIZE) == 0)
+	    iv_counter = old->iv_counter + iv_switch_gap;
+    }
+    enum { iv_switch_gap = 1 << 20 };
+
+    /* ESP IV, padding block, and ICV sizes for the transform */
+    int iv_length() const
+    {
+	return transform == SA_AES_CBC_HMAC_SHA256 ? 16 : 8;
+    }
+    int pad_block() const
+    {
+	if (transform == SA_AES_GCM)
+	    return 4;
+	else if (transform == SA_AES_CBC_HMAC_SHA256)
+	    return 16;
+	else
+	    return 8;
+    }
+    int icv_length() const
+    {
+	return transform == SA_LEGACY ? 0 : 16;
+    }
+
      operator bool() const
      {
          return ((cur_rpl != 0));
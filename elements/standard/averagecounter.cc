@@ -35,10 +35,13 @@ AverageCounter::~AverageCounter()
 void
 AverageCounter::reset()
 {
-  _count = 0;
-  _byte_count = 0;
+  // Other threads may be counting, so remember the current counts instead
+  // of clearing the per-thread slots.
+  stats total;
+  read(total);
+  _count_base += total.count;
+  _byte_count_base += total.byte_count;
   _first = 0;
-  _last = 0;
 }
 
 int
@@ -54,9 +57,12 @@ AverageCounter::configure(Vector<String> &conf, ErrorHandler *errh)
 }
 
 int
-AverageCounter::initialize(ErrorHandler *)
+AverageCounter::initialize(ErrorHandler *errh)
 {
-  reset();
+  if (_stats.initialize(master()) < 0)
+    return errh->error("out of memory");
+  _count_base = _byte_count_base = 0;
+  _first = 0;
   return 0;
 }
 
@@ -64,15 +70,60 @@ Packet *
 AverageCounter::simple_action(Packet *p)
 {
     uint32_t jpart = click_jiffies();
-    _first.compare_and_swap(0, jpart);
+    if (!_first)
+	_first.compare_and_swap(0, jpart);
+    PerThread<stats>::writer w(_stats);
     if (jpart - _first >= _ignore) {
-	_count++;
-	_byte_count += p->length();
+	w->count++;
+	w->byte_count += p->length();
     }
-    _last = jpart;
+    w->last = jpart;
     return p;
 }
 
+void
+AverageCounter::read(stats &total) const
+{
+    // total.last is the latest packet time since the first packet, or
+    // _first if no thread has seen a packet since then.
+    total.count = total.byte_count = 0;
+    total.last = _first;
+    stats st;
+    for (int i = 0; i < _stats.nslots(); ++i) {
+	_stats.read(i, st);
+	total.count += st.count;
+	total.byte_count += st.byte_count;
+	if ((int32_t) (st.last - total.last) > 0)
+	    total.last = st.last;
+    }
+    total.count -= _count_base;
+    total.byte_count -= _byte_count_base;
+}
+
+uint32_t
+AverageCounter::count() const
+{
+    stats total;
+    read(total);
+    return total.count;
+}
+
+uint32_t
+AverageCounter::byte_count() const
+{
+    stats total;
+    read(total);
+    return total.byte_count;
+}
+
+uint32_t
+AverageCounter::last() const
+{
+    stats total;
+    read(total);
+    return total.last;
+}
+
 static String
 averagecounter_read_count_handler(Element *e, void *thunk)
 {
@@ -84,10 +135,12 @@ static String
 averagecounter_read_rate_handler(Element *e, void *thunk)
 {
   AverageCounter *c = (AverageCounter *)e;
-  uint32_t d = c->last() - c->first();
+  AverageCounter::stats total;
+  c->read(total);
+  uint32_t count = (thunk ? total.byte_count : total.count);
+  uint32_t d = total.last - c->first();
   d -= c->ignore();
   if (d < 1) d = 1;
-  uint32_t count = (thunk ? c->byte_count() : c->count());
 #if CLICK_USERLEVEL
   return String(((double) count * CLICK_HZ) / d);
 #else
@@ -4,6 +4,7 @@
 #include <click/ewma.hh>
 #include <click/atomic.hh>
 #include <click/timer.hh>
+#include <click/perthread.hh>
 CLICK_DECLS
 
 /*
@@ -24,6 +25,9 @@ CLICK_DECLS
  * the first IGNORE number of seconds are ignored in
  * the count.
  *
+ * Each thread counts packets in its own cache line,
+ * and handlers sum the threads' counts.
+ *
  * =h count read-only
  * Returns the number of packets that have passed through since the last reset.
  *
@@ -50,10 +54,20 @@ class AverageCounter : public Element { public:
     const char *processing() const		{ return AGNOSTIC; }
     int configure(Vector<String> &, ErrorHandler *);
 
-    uint32_t count() const			{ return _count; }
-    uint32_t byte_count() const			{ return _byte_count; }
+    struct stats {
+	uint32_t count;
+	uint32_t byte_count;
+	uint32_t last;
+	stats()
+	    : count(0), byte_count(0), last(0) {
+	}
+    };
+
+    void read(stats &total) const;
+    uint32_t count() const;
+    uint32_t byte_count() const;
     uint32_t first() const			{ return _first; }
-    uint32_t last() const			{ return _last; }
+    uint32_t last() const;
     uint32_t ignore() const			{ return _ignore; }
     void reset();
 
@@ -64,11 +78,10 @@ class AverageCounter : public Element { public:
 
   private:
 
-    atomic_uint32_t _count;
-    atomic_uint32_t _byte_count;
+    PerThread<stats> _stats;
+    uint32_t _count_base;
+    uint32_t _byte_count_base;
     atomic_uint32_t _first;
-    atomic_uint32_t _last;
-    atomic_uint32_t _first_count;
     uint32_t _ignore;
 
 };
@@ -1,6 +1,9 @@
 #ifndef CLICK_CLASSIFICATION_HH
 #define CLICK_CLASSIFICATION_HH 1
 #define CLICK_CLASSIFICATION_WORDWISE_DOMINATOR_FASTPRED 1
+#if CLICK_USERLEVEL && defined(__x86_64__)
+# define CLICK_CLASSIFICATION_JIT 1
+#endif
 #include <click/packet.hh>
 #include <click/vector.hh>
 CLICK_DECLS
@@ -254,6 +257,64 @@ class CompressedProgram { public:
 };
 
 
+/** @brief Native machine code for a classification program.
+ *
+ * A NativeProgram holds x86-64 code compiled at run time from a Program or
+ * CompressedProgram.  The code implements the program's fast path: it reads
+ * packet words without checking the packet length, so callers must use it
+ * only for packets at least safe_length() bytes long, and fall back to the
+ * interpreter otherwise.
+ *
+ * Compilation fails, and function() returns null, on platforms without JIT
+ * support or when executable memory is unavailable.  Code is freed only when
+ * the NativeProgram is destroyed, since other threads may still be running
+ * it after a recompile. */
+class NativeProgram { public:
+
+    typedef int (*function_type)(const unsigned char *data,
+				 const unsigned char *transport_data);
+
+    NativeProgram()
+	: _f(0), _code_size(0) {
+    }
+    ~NativeProgram();
+
+    /** @brief Return the compiled function, or null if none.
+     *
+     * The function returns the program's output for a packet.  For a Program,
+     * pass the packet data minus the alignment offset, and a null
+     * @a transport_data. */
+    function_type function() const {
+	return _f;
+    }
+    size_t code_size() const {
+	return _code_size;
+    }
+
+    /** @brief Compile @a prog, returning true on success. */
+    bool compile(const Program &prog);
+    /** @brief Compile @a zprog, returning true on success.
+     * @param transport_offset offsets at or above this value are read from
+     *   @a transport_data, less @a transport_offset */
+    bool compile(const CompressedProgram &zprog, int transport_offset);
+    /** @brief Stop using native code; function() will return null. */
+    void clear();
+
+  private:
+
+    function_type volatile _f;
+    size_t _code_size;
+    Vector<void *> _blocks;
+    Vector<size_t> _block_sizes;
+
+    bool install(const Vector<unsigned char> &code);
+
+    NativeProgram(const NativeProgram &);
+    NativeProgram &operator=(const NativeProgram &);
+
+};
+
+
 class DominatorOptimizer { public:
 
     DominatorOptimizer(Program *p);
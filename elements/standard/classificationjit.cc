@@ -0,0 +1,350 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * classificationjit.cc -- compile classification programs to native code
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "classification.hh"
+#include <click/algorithm.hh>
+#if CLICK_CLASSIFICATION_JIT
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+CLICK_DECLS
+namespace Classification {
+namespace Wordwise {
+
+#if CLICK_CLASSIFICATION_JIT
+namespace {
+
+// A tiny x86-64 assembler, just big enough for classification programs.
+// Generated functions follow the System V calling convention: packet data
+// arrives in %rdi, transport data in %rsi, and the output is returned in
+// %eax.  All jumps use 32-bit displacements, resolved by finish().
+class Assembler { public:
+
+    enum { reg_data = 0, reg_transport = 1 };
+    enum { cc_b = 0x2, cc_e = 0x4, cc_ne = 0x5, cc_a = 0x7 };
+
+    int new_label() {
+	_labels.push_back(-1);
+	return _labels.size() - 1;
+    }
+    void bind(int label) {
+	_labels[label] = _code.size();
+    }
+
+    // mov off(%rdi or %rsi), %eax
+    void load(int reg, int32_t off) {
+	byte(0x8B);
+	if (off >= -128 && off < 128) {
+	    byte(reg == reg_transport ? 0x46 : 0x47);
+	    byte(off);
+	} else {
+	    byte(reg == reg_transport ? 0x86 : 0x87);
+	    imm32(off);
+	}
+    }
+    // and $mask, %eax
+    void and_eax(uint32_t mask) {
+	byte(0x25);
+	imm32(mask);
+    }
+    // cmp $value, %eax, or test %eax, %eax for zero
+    void cmp_eax(uint32_t value) {
+	if (value == 0) {
+	    byte(0x85);
+	    byte(0xC0);
+	} else {
+	    byte(0x3D);
+	    imm32(value);
+	}
+    }
+    void jcc(int cc, int label) {
+	byte(0x0F);
+	byte(0x80 | cc);
+	fixup(label);
+    }
+    void jmp(int label) {
+	byte(0xE9);
+	fixup(label);
+    }
+    // mov $value, %eax; ret
+    void return_value(int32_t value) {
+	byte(0xB8);
+	imm32(value);
+	byte(0xC3);
+    }
+
+    // Return a label that returns output -@a j, for a jump value j <= 0.
+    int output_label(int32_t j) {
+	for (int i = 0; i < _outputs.size(); ++i)
+	    if (_outputs[i] == j)
+		return _output_labels[i];
+	_outputs.push_back(j);
+	_output_labels.push_back(new_label());
+	return _output_labels.back();
+    }
+
+    bool finish() {
+	for (int i = 0; i < _outputs.size(); ++i) {
+	    bind(_output_labels[i]);
+	    return_value(-_outputs[i]);
+	}
+	for (int i = 0; i < _fixups.size(); i += 2) {
+	    int pos = _fixups[i], target = _labels[_fixups[i + 1]];
+	    if (target < 0)
+		return false;
+	    int32_t rel = target - (pos + 4);
+	    memcpy(&_code[pos], &rel, 4);
+	}
+	return true;
+    }
+
+    const Vector<unsigned char> &code() const {
+	return _code;
+    }
+
+  private:
+
+    Vector<unsigned char> _code;
+    Vector<int> _labels;
+    Vector<int> _fixups;	// pairs of (code position, label)
+    Vector<int32_t> _outputs;
+    Vector<int> _output_labels;
+
+    void byte(unsigned char c) {
+	_code.push_back(c);
+    }
+    void imm32(uint32_t x) {
+	for (int i = 0; i < 4; ++i, x >>= 8)
+	    byte(x & 0xFF);
+    }
+    void fixup(int label) {
+	_fixups.push_back(_code.size());
+	_fixups.push_back(label);
+	imm32(0);
+    }
+
+};
+
+// Emit a search of the sorted values [lo, hi) for %eax.  Falls through to
+// @a next if that is the no label.
+void
+emit_search(Assembler &a, const Vector<uint32_t> &v, int lo, int hi,
+	    int yes, int no, int next)
+{
+    if (hi - lo <= 4) {
+	for (int i = lo; i < hi; ++i) {
+	    a.cmp_eax(v[i]);
+	    a.jcc(Assembler::cc_e, yes);
+	}
+	if (no != next)
+	    a.jmp(no);
+    } else {
+	int mid = lo + (hi - lo) / 2, right = a.new_label();
+	a.cmp_eax(v[mid]);
+	a.jcc(Assembler::cc_e, yes);
+	a.jcc(Assembler::cc_a, right);
+	emit_search(a, v, lo, mid, yes, no, -1);
+	a.bind(right);
+	emit_search(a, v, mid + 1, hi, yes, no, next);
+    }
+}
+
+// Emit a test of the word at @a off: jump to @a yes if the word, masked
+// with @a mask, equals any of @a values, and to @a no otherwise.  @a next
+// is the label that immediately follows the test.
+void
+emit_test(Assembler &a, int reg, int32_t off, uint32_t mask,
+	  const uint32_t *values, int nvalues, int yes, int no, int next)
+{
+    if (mask == 0) {
+	// values are premasked, so they all equal zero
+	if (yes != next)
+	    a.jmp(yes);
+	return;
+    }
+    a.load(reg, off);
+    if (mask != 0xFFFFFFFFU)
+	a.and_eax(mask);
+    if (nvalues == 1) {
+	a.cmp_eax(values[0]);
+	if (yes == next)
+	    a.jcc(Assembler::cc_ne, no);
+	else {
+	    a.jcc(Assembler::cc_e, yes);
+	    if (no != next)
+		a.jmp(no);
+	}
+    } else {
+	Vector<uint32_t> v;
+	for (int i = 0; i < nvalues; ++i)
+	    v.push_back(values[i]);
+	click_qsort(v.begin(), v.size());
+	emit_search(a, v, 0, v.size(), yes, no, next);
+    }
+}
+
+}
+#endif
+
+
+NativeProgram::~NativeProgram()
+{
+#if CLICK_CLASSIFICATION_JIT
+    for (int i = 0; i < _blocks.size(); ++i)
+	munmap(_blocks[i], _block_sizes[i]);
+#endif
+}
+
+void
+NativeProgram::clear()
+{
+    _f = 0;
+    _code_size = 0;
+}
+
+bool
+NativeProgram::install(const Vector<unsigned char> &code)
+{
+#if CLICK_CLASSIFICATION_JIT
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t size = (code.size() + page - 1) & ~(page - 1);
+    void *mem = mmap(0, size, PROT_READ | PROT_WRITE,
+		     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+	return false;
+    memcpy(mem, code.begin(), code.size());
+    if (mprotect(mem, size, PROT_READ | PROT_EXEC) < 0) {
+	munmap(mem, size);
+	return false;
+    }
+    _blocks.push_back(mem);
+    _block_sizes.push_back(size);
+    _code_size = code.size();
+    _f = reinterpret_cast<function_type>(mem);
+    return true;
+#else
+    (void) code;
+    return false;
+#endif
+}
+
+bool
+NativeProgram::compile(const Program &prog)
+{
+    clear();
+#if CLICK_CLASSIFICATION_JIT
+    if (prog.output_everything() >= 0 || prog.ninsn() == 0)
+	return false;
+
+    // find reachable instructions
+    int n = prog.ninsn();
+    Vector<int> wanted(n, 0), work;
+    wanted[0] = 1;
+    work.push_back(0);
+    while (work.size()) {
+	const Insn &in = prog.insn(work.back());
+	work.pop_back();
+	for (int k = 0; k < 2; ++k) {
+	    int j = in.j[k];
+	    if (j >= n)
+		return false;
+	    else if (j > 0 && !wanted[j]) {
+		wanted[j] = 1;
+		work.push_back(j);
+	    }
+	}
+    }
+
+    Assembler a;
+    Vector<int> label(n, -1);
+    for (int i = 0; i < n; ++i)
+	if (wanted[i])
+	    label[i] = a.new_label();
+    for (int i = 0; i < n; ++i)
+	if (wanted[i]) {
+	    const Insn &in = prog.insn(i);
+	    int next = -1;
+	    for (int k = i + 1; k < n && next < 0; ++k)
+		next = label[k];
+	    int j[2];
+	    for (int k = 0; k < 2; ++k)
+		j[k] = in.j[k] > 0 ? label[in.j[k]] : a.output_label(in.j[k]);
+	    a.bind(label[i]);
+	    emit_test(a, Assembler::reg_data, in.offset, in.mask.u,
+		      &in.value.u, 1, j[1], j[0], next);
+	}
+
+    return a.finish() && install(a.code());
+#else
+    (void) prog;
+    return false;
+#endif
+}
+
+bool
+NativeProgram::compile(const CompressedProgram &zprog, int transport_offset)
+{
+    clear();
+#if CLICK_CLASSIFICATION_JIT
+    const uint32_t *begin = zprog.begin(), *end = zprog.end();
+    if (zprog.output_everything() >= 0 || begin == end)
+	return false;
+
+    // Each test starts with a word whose top 15 bits count its values; see
+    // CompressedProgram::compile.
+    Assembler a;
+    Vector<int> label(end - begin + 1, -1);
+    for (const uint32_t *pr = begin; pr < end; pr += 4 + (pr[0] >> 17))
+	label[pr - begin] = a.new_label();
+
+    for (const uint32_t *pr = begin; pr < end; ) {
+	int nvalues = pr[0] >> 17;
+	const uint32_t *next_pr = pr + 4 + nvalues;
+	int next = next_pr < end ? label[next_pr - begin] : -1;
+
+	int j[2];
+	for (int k = 0; k < 2; ++k) {
+	    int32_t jump = pr[1 + k];
+	    if (jump <= 0)
+		j[k] = a.output_label(jump);
+	    else if (pr + jump < end && label[pr + jump - begin] >= 0)
+		j[k] = label[pr + jump - begin];
+	    else
+		return false;
+	}
+
+	int reg = Assembler::reg_data;
+	int off = (int16_t) pr[0];
+	if (off >= transport_offset) {
+	    reg = Assembler::reg_transport;
+	    off -= transport_offset;
+	}
+	a.bind(label[pr - begin]);
+	emit_test(a, reg, off, pr[3], pr + 4, nvalues, j[1], j[0], next);
+	pr = next_pr;
+    }
+
+    return a.finish() && install(a.code());
+#else
+    (void) zprog, (void) transport_offset;
+    return false;
+#endif
+}
+
+}}
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(Classification)
+ELEMENT_PROVIDES(ClassificationJIT)
@@ -28,6 +28,7 @@
 CLICK_DECLS
 
 Classifier::Classifier()
+    : _jit(true)
 {
 }
 
@@ -222,7 +223,10 @@ Classifier::configure(Vector<String> &conf, ErrorHandler *errh)
 
     if (errh->nerrors() == before) {
 	prog.warn_unused_outputs(noutputs(), errh);
+	_native.clear();
 	_prog = prog;
+	if (_jit)
+	    _native.compile(_prog);
 	return 0;
     } else
 	return -1;
@@ -235,19 +239,59 @@ Classifier::program_string(Element *element, void *)
     return c->_prog.unparse();
 }
 
+String
+Classifier::read_jit(Element *element, void *)
+{
+    Classifier *c = static_cast<Classifier *>(element);
+    return cp_unparse_bool(c->_native.function() != 0);
+}
+
+int
+Classifier::write_jit(const String &str, Element *element, void *, ErrorHandler *errh)
+{
+    Classifier *c = static_cast<Classifier *>(element);
+    if (!cp_bool(cp_uncomment(str), &c->_jit))
+	return errh->error("argument to 'jit' should be bool");
+    if (!c->_jit)
+	c->_native.clear();
+    else if (!c->_native.compile(c->_prog))
+	return errh->error("cannot compile program to native code");
+    return 0;
+}
+
 void
 Classifier::add_handlers()
 {
     add_read_handler("program", Classifier::program_string, 0, Handler::CALM);
+    add_read_handler("jit", read_jit, 0);
+    add_write_handler("jit", write_jit, 0);
 }
 
 void
 Classifier::push(int, Packet *p)
 {
-    checked_output_push(_prog.match(p), p);
+    checked_output_push(match(p), p);
+}
+
+void
+Classifier::push_batch(int, PacketBatch &batch)
+{
+    // Emit each run of consecutive packets bound for the same output as one
+    // batch.  This preserves per-output packet order without allocation.
+    PacketBatch run;
+    int run_port = -1;
+    while (Packet *p = batch.pop_front()) {
+	int port = match(p);
+	if (port != run_port && run)
+	    checked_output_push_batch(run_port, run);
+	run_port = port;
+	run.append(p);
+    }
+    if (run)
+	checked_output_push_batch(run_port, run);
 }
 
 CLICK_ENDDECLS
-ELEMENT_REQUIRES(AlignmentInfo Classification)
+ELEMENT_REQUIRES(AlignmentInfo Classification ClassificationJIT)
 EXPORT_ELEMENT(Classifier)
 ELEMENT_MT_SAFE(Classifier)
@@ -70,6 +70,14 @@ CLICK_DECLS
  *   safe length 22
  *   alignment offset 0
  *
+ * =h jit read/write
+ * Returns true if the element is running its program as native code.  At
+ * user level on x86-64, Classifier compiles its program to machine code each
+ * time it is configured, including after hotswaps and live reconfiguration.
+ * Packets shorter than the program's safe length, and all packets on other
+ * platforms, are classified by the interpreter.  Write false to use the
+ * interpreter for every packet, or true to recompile.
+ *
  * =a IPClassifier, IPFilter */
 
 class Classifier : public Element { public:
@@ -88,6 +96,8 @@ class Classifier : public Element { public:
     void add_handlers();
 
     void push(int port, Packet *);
+    void push_batch(int port, PacketBatch &batch);
+    inline int match(const Packet *p);
 
     Classification::Wordwise::Program empty_program(ErrorHandler *errh) const;
     static void parse_program(Classification::Wordwise::Program &prog,
@@ -96,10 +106,24 @@ class Classifier : public Element { public:
   protected:
 
     Classification::Wordwise::Program _prog;
+    Classification::Wordwise::NativeProgram _native;
+    bool _jit;
 
     static String program_string(Element *, void *);
+    static String read_jit(Element *, void *);
+    static int write_jit(const String &, Element *, void *, ErrorHandler *);
 
 };
 
+inline int
+Classifier::match(const Packet *p)
+{
+    Classification::Wordwise::NativeProgram::function_type f = _native.function();
+    if (f && p->length() >= _prog.safe_length())
+	return f(p->data() - _prog.align_offset(), 0);
+    else
+	return _prog.match(p);
+}
+
 CLICK_ENDDECLS
 #endif
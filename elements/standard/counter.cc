@@ -37,7 +37,12 @@ Counter::~Counter()
 void
 Counter::reset()
 {
-  _count = _byte_count = 0;
+  // Other threads may be counting, so remember the current counts instead
+  // of clearing the per-thread slots.
+  counter_t count, byte_count;
+  read_counts(count, byte_count);
+  _count_base += count;
+  _byte_count_base += byte_count;
   _count_triggered = _byte_triggered = false;
 }
 
@@ -79,59 +84,137 @@ Counter::initialize(ErrorHandler *errh)
     return -1;
   if (_byte_trigger_h && _byte_trigger_h->initialize_write(this, errh) < 0)
     return -1;
-  reset();
+  if (_stats.initialize(master()) < 0)
+    return errh->error("out of memory");
+  _count_base = _byte_count_base = 0;
+  _count_triggered = _byte_triggered = false;
   return 0;
 }
 
+void
+Counter::read_counts(counter_t &count, counter_t &byte_count) const
+{
+    count = byte_count = 0;
+    stats st;
+    for (int i = 0; i < _stats.nslots(); ++i) {
+	_stats.read(i, st);
+	count += st.count;
+	byte_count += st.byte_count;
+    }
+    count -= _count_base;
+    byte_count -= _byte_count_base;
+}
+
+void
+Counter::read_rates(rate_t::signed_value_type &rate, byte_rate_t::signed_value_type &byte_rate) const
+{
+    // Rates are linear in their samples, so the sum of the threads' rates
+    // is the rate of all packets.
+    rate = byte_rate = 0;
+    stats st;
+    for (int i = 0; i < _stats.nslots(); ++i) {
+	_stats.read(i, st);
+	st.rate.update(0);	// drop rate after idle period
+	st.byte_rate.update(0);
+	rate += st.rate.scaled_average();
+	byte_rate += st.byte_rate.scaled_average();
+    }
+}
+
+void
+Counter::check_triggers()
+{
+    counter_t count, byte_count;
+    read_counts(count, byte_count);
+    if (_count_trigger_h && count >= _count_trigger && !_count_triggered) {
+	_count_triggered = true;
+	(void) _count_trigger_h->call_write();
+    }
+    if (_byte_trigger_h && byte_count >= _byte_trigger && !_byte_triggered) {
+	_byte_triggered = true;
+	(void) _byte_trigger_h->call_write();
+    }
+}
+
+inline void
+Counter::count(uint32_t n, uint32_t nbytes)
+{
+    {
+	PerThread<stats>::writer w(_stats);
+	w->count += n;
+	w->byte_count += nbytes;
+	w->rate.update(n);
+	w->byte_rate.update(nbytes);
+    }
+    if (unlikely((_count_trigger_h && !_count_triggered)
+		 || (_byte_trigger_h && !_byte_triggered)))
+	check_triggers();
+}
+
 Packet *
 Counter::simple_action(Packet *p)
 {
-    _count++;
-    _byte_count += p->length();
-    _rate.update(1);
-    _byte_rate.update(p->length());
+    count(1, p->length());
+    return p;
+}
 
-  if (_count == _count_trigger && !_count_triggered) {
-    _count_triggered = true;
-    if (_count_trigger_h)
-      (void) _count_trigger_h->call_write();
-  }
-  if (_byte_count >= _byte_trigger && !_byte_triggered) {
-    _byte_triggered = true;
-    if (_byte_trigger_h)
-      (void) _byte_trigger_h->call_write();
-  }
+void
+Counter::count_batch(const PacketBatch &batch)
+{
+    count(batch.count(), batch.total_length());
+}
 
-  return p;
+void
+Counter::push_batch(int, PacketBatch &batch)
+{
+    count_batch(batch);
+    output(0).push_batch(batch);
+}
+
+PacketBatch
+Counter::pull_batch(int, unsigned max)
+{
+    PacketBatch batch = input(0).pull_batch(max);
+    if (batch)
+	count_batch(batch);
+    return batch;
 }
 
 
-enum { H_COUNT, H_BYTE_COUNT, H_RATE, H_BIT_RATE, H_BYTE_RATE, H_RESET,
+enum { H_COUNT, H_BYTE_COUNT, H_COUNTS, H_RATE, H_BIT_RATE, H_BYTE_RATE, H_RESET,
        H_COUNT_CALL, H_BYTE_COUNT_CALL };
 
 String
 Counter::read_handler(Element *e, void *thunk)
 {
     Counter *c = (Counter *)e;
+    counter_t count, byte_count;
+    rate_t::signed_value_type rate;
+    byte_rate_t::signed_value_type byte_rate;
     switch ((intptr_t)thunk) {
       case H_COUNT:
-	return String(c->_count);
+	c->read_counts(count, byte_count);
+	return String(count);
       case H_BYTE_COUNT:
-	return String(c->_byte_count);
+	c->read_counts(count, byte_count);
+	return String(byte_count);
+      case H_COUNTS:
+	c->read_counts(count, byte_count);
+	return String(count) + " " + String(byte_count);
       case H_RATE:
-	c->_rate.update(0);	// drop rate after idle period
-	return c->_rate.unparse_rate();
+	c->read_rates(rate, byte_rate);
+	return cp_unparse_real2(rate * rate_parameters::epoch_frequency(), rate_parameters::scale());
       case H_BIT_RATE:
-	c->_byte_rate.update(0); // drop rate after idle period
+	c->read_rates(rate, byte_rate);
 	// avoid integer overflow by adjusting scale factor instead of
 	// multiplying
-	if (c->_byte_rate.scale() >= 3)
-	    return cp_unparse_real2(c->_byte_rate.scaled_average() * c->_byte_rate.epoch_frequency(), c->_byte_rate.scale() - 3);
+	if (byte_rate_parameters::scale() >= 3)
+	    return cp_unparse_real2(byte_rate * byte_rate_parameters::epoch_frequency(), byte_rate_parameters::scale() - 3);
 	else
-	    return cp_unparse_real2(c->_byte_rate.scaled_average() * c->_byte_rate.epoch_frequency() * 8, c->_byte_rate.scale());
+	    return cp_unparse_real2(byte_rate * byte_rate_parameters::epoch_frequency() * 8, byte_rate_parameters::scale());
       case H_BYTE_RATE:
-	c->_byte_rate.update(0); // drop rate after idle period
-	return c->_byte_rate.unparse_rate();
+	c->read_rates(rate, byte_rate);
+	return cp_unparse_real2(byte_rate * byte_rate_parameters::epoch_frequency(), byte_rate_parameters::scale());
       case H_COUNT_CALL:
 	if (c->_count_trigger_h)
 	    return String(c->_count_trigger);
@@ -175,6 +258,7 @@ Counter::add_handlers()
 {
     add_read_handler("count", read_handler, (void *)H_COUNT);
     add_read_handler("byte_count", read_handler, (void *)H_BYTE_COUNT);
+    add_read_handler("counts", read_handler, (void *)H_COUNTS);
     add_read_handler("rate", read_handler, (void *)H_RATE);
     add_read_handler("bit_rate", read_handler, (void *)H_BIT_RATE);
     add_read_handler("byte_rate", read_handler, (void *)H_BYTE_RATE);
@@ -192,15 +276,19 @@ Counter::llrpc(unsigned command, void *data)
     uint32_t *val = reinterpret_cast<uint32_t *>(data);
     if (*val != 0)
       return -EINVAL;
-    _rate.update(0);		// drop rate after idle period
-    *val = _rate.rate();
+    rate_t::signed_value_type rate;
+    byte_rate_t::signed_value_type byte_rate;
+    read_rates(rate, byte_rate);
+    *val = (rate * rate_parameters::epoch_frequency()) >> rate_parameters::scale();
     return 0;
 
   } else if (command == CLICK_LLRPC_GET_COUNT) {
     uint32_t *val = reinterpret_cast<uint32_t *>(data);
     if (*val != 0 && *val != 1)
       return -EINVAL;
-    *val = (*val == 0 ? _count : _byte_count);
+    counter_t count, byte_count;
+    read_counts(count, byte_count);
+    *val = (*val == 0 ? count : byte_count);
     return 0;
 
   } else if (command == CLICK_LLRPC_GET_COUNTS) {
@@ -209,11 +297,13 @@ Counter::llrpc(unsigned command, void *data)
     if (CLICK_LLRPC_GET_DATA(&cs, data, sizeof(cs.n) + sizeof(cs.keys)) < 0
 	|| cs.n >= CLICK_LLRPC_COUNTS_SIZE)
       return -EINVAL;
+    counter_t count, byte_count;
+    read_counts(count, byte_count);
     for (unsigned i = 0; i < cs.n; i++) {
       if (cs.keys[i] == 0)
-	cs.values[i] = _count;
+	cs.values[i] = count;
       else if (cs.keys[i] == 1)
-	cs.values[i] = _byte_count;
+	cs.values[i] = byte_count;
       else
 	return -EINVAL;
     }
@@ -4,6 +4,7 @@
 #include <click/element.hh>
 #include <click/ewma.hh>
 #include <click/llrpc.h>
+#include <click/perthread.hh>
 CLICK_DECLS
 class HandlerCall;
 
@@ -21,6 +22,10 @@ measures packet count and rate
 Passes packets unchanged from its input to its output, maintaining statistics
 information about packet count and packet rate.
 
+Each thread counts packets in its own cache line, and handlers sum the
+threads' counts, so several threads can pass packets through one Counter
+without contending for its statistics.
+
 Keyword arguments are:
 
 =over 8
@@ -47,6 +52,12 @@ Returns the number of packets that have passed through since the last reset.
 
 Returns the number of bytes that have passed through since the last reset.
 
+=h counts read-only
+
+Returns the packet count and the byte count, separated by a space.  The
+counts are read together, so the byte count covers exactly the counted
+packets.
+
 =h rate read-only
 
 Returns the recent arrival rate, measured by exponential
@@ -94,7 +105,7 @@ count). Returns the current packet or byte count.
 Argument is a pointer to a click_llrpc_counts_st structure (see
 <click/llrpc.h>). The C<keys> components must be 0 (packet count) or 1 (byte
 count). Stores the corresponding counts in the corresponding C<values>
-components.
+components.  The counts are read together, as for the C<counts> handler.
 
 */
 
@@ -115,25 +126,37 @@ class Counter : public Element { public:
     int llrpc(unsigned, void *);
 
     Packet *simple_action(Packet *);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
 
   private:
 
 #ifdef HAVE_INT64_TYPES
     typedef uint64_t counter_t;
     // Reduce bits of fraction for byte rate to avoid overflow
-    typedef RateEWMAX<RateEWMAXParameters<4, 10, uint64_t, int64_t> > rate_t;
-    typedef RateEWMAX<RateEWMAXParameters<4, 4, uint64_t, int64_t> > byte_rate_t;
+    typedef RateEWMAXParameters<4, 10, uint64_t, int64_t> rate_parameters;
+    typedef RateEWMAXParameters<4, 4, uint64_t, int64_t> byte_rate_parameters;
 #else
     typedef uint32_t counter_t;
-    typedef RateEWMAX<RateEWMAXParameters<4, 10> > rate_t;
-    typedef RateEWMAX<RateEWMAXParameters<4, 4> > byte_rate_t;
+    typedef RateEWMAXParameters<4, 10> rate_parameters;
+    typedef RateEWMAXParameters<4, 4> byte_rate_parameters;
 #endif
-
-    counter_t _count;
-    counter_t _byte_count;
-    rate_t _rate;
-    byte_rate_t _byte_rate;
-
+    typedef RateEWMAX<rate_parameters> rate_t;
+    typedef RateEWMAX<byte_rate_parameters> byte_rate_t;
+
+    struct stats {
+	counter_t count;
+	counter_t byte_count;
+	rate_t rate;
+	byte_rate_t byte_rate;
+	stats()
+	    : count(0), byte_count(0) {
+	}
+    };
+
+    PerThread<stats> _stats;
+    counter_t _count_base;
+    counter_t _byte_count_base;
     counter_t _count_trigger;
     HandlerCall *_count_trigger_h;
 
@@ -143,6 +166,12 @@ class Counter : public Element { public:
     bool _count_triggered : 1;
     bool _byte_triggered : 1;
 
+    void count_batch(const PacketBatch &batch);
+    inline void count(uint32_t n, uint32_t nbytes);
+    void check_triggers();
+    void read_counts(counter_t &count, counter_t &byte_count) const;
+    void read_rates(rate_t::signed_value_type &rate, byte_rate_t::signed_value_type &byte_rate) const;
+
     static String read_handler(Element *, void *);
     static int write_handler(const String&, Element*, void*, ErrorHandler*);
 
@@ -114,10 +114,8 @@ FrontDropQueue::push(int, Packet *p)
 
     // should this stuff be in Queue::enq?
     if (next == _head) {
-	if (_drops == 0 && _capacity > 0)
-	    click_chatter("%{element}: overflow", this);
+	count_drops(1);
 	checked_output_push(1, _q[_head]);
-	_drops++;
 	_head = next_i(_head);
     }
 
@@ -59,6 +59,10 @@ class FrontDropQueue : public NotifierQueue { public:
   void take_state(Element *, ErrorHandler *);
 
   void push(int port, Packet *);
+  // NotifierQueue's batch enqueue tail-drops; use per-packet push()
+  void push_batch(int port, PacketBatch &batch) {
+    Element::push_batch(port, batch);
+  }
 
 };
 
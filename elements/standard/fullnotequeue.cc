@@ -80,6 +80,41 @@ FullNoteQueue::pull(int)
 	return pull_failure();
 }
 
+void
+FullNoteQueue::push_batch(int, PacketBatch &batch)
+{
+    // Code taken from SimpleQueue::push_batch().
+    PacketBatch dropped;
+    int n = batch.count();
+    int s = enq_batch(batch, dropped);
+
+    if (n > (int) dropped.count()) {
+	_empty_note.wake();
+	if (s == capacity()) {
+	    _full_note.sleep();
+#if HAVE_MULTITHREAD
+	    // See FullNoteQueue::push_success().
+	    if (size() < capacity())
+		_full_note.wake();
+#endif
+	}
+    }
+    if (dropped)
+	push_batch_failure(dropped);
+}
+
+PacketBatch
+FullNoteQueue::pull_batch(int, unsigned max)
+{
+    PacketBatch batch = deq_batch(max);
+    if (batch) {
+	_sleepiness = 0;
+	_full_note.wake();
+    } else
+	pull_failure();
+    return batch;
+}
+
 CLICK_ENDDECLS
 ELEMENT_REQUIRES(NotifierQueue)
 EXPORT_ELEMENT(FullNoteQueue FullNoteQueue-FullNoteQueue)
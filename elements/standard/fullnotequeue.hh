@@ -78,6 +78,8 @@ class FullNoteQueue : public NotifierQueue { public:
 
     void push(int port, Packet *p);
     Packet *pull(int port);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
 
   protected:
 
@@ -120,9 +122,7 @@ FullNoteQueue::push_success(int h, int t, int nt, Packet *p)
 inline void
 FullNoteQueue::push_failure(Packet *p)
 {
-    if (_drops == 0 && _capacity > 0)
-	click_chatter("%{element}: overflow", this);
-    _drops++;
+    count_drops(1);
     checked_output_push(1, p);
 }
 
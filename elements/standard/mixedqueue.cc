@@ -45,9 +45,7 @@ MixedQueue::push(int port, Packet *p)
     if (port == 0) {		// FIFO insert, drop new packet if full
 	int h = _head, t = _tail, nt = next_i(t);
 	if (nt == h) {
-	    if (_drops == 0 && _capacity > 0)
-		click_chatter("%{element}: overflow", this);
-	    _drops++;
+	    count_drops(1);
 	    checked_output_push(1, p);
 	} else {
 	    _q[t] = p;
@@ -57,9 +55,7 @@ MixedQueue::push(int port, Packet *p)
     } else {			// LIFO insert, drop old packet if full
 	int h = _head, t = _tail, ph = prev_i(h);
 	if (ph == t) {
-	    if (_drops == 0 && _capacity > 0)
-		click_chatter("%{element}: overflow", this);
-	    _drops++;
+	    count_drops(1);
 	    t = prev_i(t);
 	    oldp = _q[t];
 	    packet_memory_barrier(_q[t], _tail);
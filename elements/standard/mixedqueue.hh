@@ -82,6 +82,10 @@ class MixedQueue : public NotifierQueue { public:
     void *cast(const char *);
 
     void push(int port, Packet *);
+    // NotifierQueue's batch enqueue is FIFO-only; use per-packet push()
+    void push_batch(int port, PacketBatch &batch) {
+	Element::push_batch(port, batch);
+    }
 
 };
 
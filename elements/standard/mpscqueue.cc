@@ -0,0 +1,79 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * mpscqueue.{cc,hh} -- multiple-producer, single-consumer ring queue
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "mpscqueue.hh"
+CLICK_DECLS
+
+MPSCQueue::MPSCQueue()
+{
+}
+
+MPSCQueue::~MPSCQueue()
+{
+}
+
+void *
+MPSCQueue::cast(const char *n)
+{
+    if (strcmp(n, "MPSCQueue") == 0)
+	return (MPSCQueue *)this;
+    else
+	return SPSCQueue::cast(n);
+}
+
+void
+MPSCQueue::push(int port, Packet *p)
+{
+    PacketBatch batch(p);
+    push_batch(port, batch);
+}
+
+void
+MPSCQueue::push_batch(int, PacketBatch &batch)
+{
+    // Reserve slots [t, t + n).  Pushers share no state except _tail, so
+    // each computes room from its own snapshot of _head, read after _tail;
+    // SPSCQueue's _head_cache would be a data race here.  If the snapshot
+    // shows more than a full ring, another pusher advanced _tail and the
+    // puller consumed past t in between, so t is stale: retry.  A successful
+    // compare-and-swap means t was the current tail, and _head can only have
+    // grown since the snapshot, so n slots really are free.
+    uint32_t t, n;
+    while (1) {
+	t = _tail.value();
+	uint32_t used = t - _head;
+	if (used > _capacity)
+	    continue;
+	n = _capacity - used;
+	if (n > batch.count())
+	    n = batch.count();
+	if (_tail.compare_and_swap(t, t + n))
+	    break;
+    }
+
+    // The puller clears a slot before advancing _head past it, so the
+    // reserved slots are empty.
+    if (n) {
+	push_slots(t, batch, n);
+	_empty_note.wake();
+    }
+    if (batch)
+	push_drop(batch);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(SPSCQueue)
+EXPORT_ELEMENT(MPSCQueue)
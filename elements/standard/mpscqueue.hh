@@ -0,0 +1,65 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_MPSCQUEUE_HH
+#define CLICK_MPSCQUEUE_HH
+#include "spscqueue.hh"
+CLICK_DECLS
+
+/*
+=c
+
+MPSCQueue
+MPSCQueue(CAPACITY)
+
+=s storage
+
+stores packets in a multiple-producer, single-consumer ring
+
+=d
+
+Stores incoming packets in a first-in-first-out queue.  Drops incoming
+packets if the queue already holds CAPACITY packets.  CAPACITY is rounded up
+to a power of two; the default is 1024.
+
+MPSCQueue is like SPSCQueue, except that any number of threads may push to it
+concurrently.  At most one thread may pull from it at a time.  A pusher
+reserves ring slots with a single compare-and-swap, so a batched push costs
+one atomic instruction however many packets it holds; it then fills the slots
+without further synchronization.  Packets pushed by any one thread are pulled
+in the order they were pushed.
+
+A pull stops at the first reserved slot whose pusher has not yet filled it,
+even if later slots are already full.
+
+=h length read-only
+
+Returns the current number of packets in the queue, including reserved slots.
+
+=h capacity read-only
+
+Returns the queue's capacity.
+
+=h drops read-only
+
+Returns the number of packets dropped by the queue so far.
+
+=h reset_counts write-only
+
+When written, resets the C<drops> counter.
+
+=a SPSCQueue, ThreadSafeQueue, Queue */
+
+class MPSCQueue : public SPSCQueue { public:
+
+    MPSCQueue();
+    ~MPSCQueue();
+
+    const char *class_name() const		{ return "MPSCQueue"; }
+    void *cast(const char *);
+
+    void push(int port, Packet *p);
+    void push_batch(int port, PacketBatch &batch);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -66,9 +66,7 @@ NotifierQueue::push(int, Packet *p)
 	_empty_note.wake();
 
     } else {
-	if (_drops == 0 && _capacity > 0)
-	    click_chatter("%{element}: overflow", this);
-	_drops++;
+	count_drops(1);
 	checked_output_push(1, p);
     }
 }
@@ -95,6 +93,39 @@ NotifierQueue::pull(int)
     return p;
 }
 
+void
+NotifierQueue::push_batch(int, PacketBatch &batch)
+{
+    // Code taken from SimpleQueue::push_batch().
+    PacketBatch dropped;
+    int n = batch.count();
+    enq_batch(batch, dropped);
+    if (n > (int) dropped.count())
+	_empty_note.wake();
+    if (dropped)
+	push_batch_failure(dropped);
+}
+
+PacketBatch
+NotifierQueue::pull_batch(int, unsigned max)
+{
+    PacketBatch batch = deq_batch(max);
+
+    if (batch)
+	_sleepiness = 0;
+    else if (_sleepiness >= SLEEPINESS_TRIGGER) {
+	_empty_note.sleep();
+#if HAVE_MULTITHREAD
+	// See NotifierQueue::pull().
+	if (size())
+	    _empty_note.wake();
+#endif
+    } else
+	++_sleepiness;
+
+    return batch;
+}
+
 #if NOTIFIERQUEUE_DEBUG
 #include <click/straccum.hh>
 
@@ -80,6 +80,8 @@ class NotifierQueue : public SimpleQueue { public:
 
     void push(int port, Packet *);
     Packet *pull(int port);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
 
 #if NOTIFIERQUEUE_DEBUG
     void add_handlers();
@@ -75,6 +75,9 @@ class QuickNoteQueue : public FullNoteQueue { public:
 
     // FullNoteQueue's push() suffices
     Packet *pull(int port);
+    PacketBatch pull_batch(int port, unsigned max) {
+	return Element::pull_batch(port, max);
+    }
 
 };
 
@@ -62,8 +62,10 @@ SimpleQueue::initialize(ErrorHandler *errh)
     _q = (Packet **) CLICK_LALLOC(sizeof(Packet *) * (_capacity + 1));
     if (_q == 0)
 	return errh->error("out of memory");
-    _drops = 0;
+    if (_drops.initialize(master()) < 0)
+	return errh->error("out of memory");
     _highwater_length = 0;
+    _overflowed = false;
     return 0;
 }
 
@@ -158,10 +160,7 @@ SimpleQueue::push(int, Packet *p)
 	    _highwater_length = s;
 
     } else {
-	// if (!(_drops % 100))
-	if (_drops == 0 && _capacity > 0)
-	    click_chatter("%{element}: overflow", this);
-	_drops++;
+	count_drops(1);
 	checked_output_push(1, p);
     }
 }
@@ -172,6 +171,23 @@ SimpleQueue::pull(int)
     return deq();
 }
 
+void
+SimpleQueue::push_batch(int, PacketBatch &batch)
+{
+    // If you change this code, also change NotifierQueue::push_batch()
+    // and FullNoteQueue::push_batch().
+    PacketBatch dropped;
+    enq_batch(batch, dropped);
+    if (dropped)
+	push_batch_failure(dropped);
+}
+
+PacketBatch
+SimpleQueue::pull_batch(int, unsigned max)
+{
+    return deq_batch(max);
+}
+
 #if 0
 Vector<Packet *>
 SimpleQueue::yank(bool (filter)(const Packet *, void *), void *thunk)
@@ -209,8 +225,6 @@ SimpleQueue::read_handler(Element *e, void *thunk)
 	return String(q->highwater_length());
       case 2:
 	return String(q->capacity());
-      case 3:
-	return String(q->_drops);
       default:
 	return "";
     }
@@ -230,7 +244,8 @@ SimpleQueue::write_handler(const String &, Element *e, void *thunk, ErrorHandler
     int which = reinterpret_cast<intptr_t>(thunk);
     switch (which) {
       case 0:
-	q->_drops = 0;
+	q->_drops.clear();
+	q->_overflowed = false;
 	q->_highwater_length = q->size();
 	return 0;
       case 1:
@@ -247,7 +262,7 @@ SimpleQueue::add_handlers()
     add_read_handler("length", read_handler, (void *)0);
     add_read_handler("highwater_length", read_handler, (void *)1);
     add_read_handler("capacity", read_handler, (void *)2, Handler::CALM);
-    add_read_handler("drops", read_handler, (void *)3);
+    add_data_handlers("drops", Handler::h_read, &_drops);
     add_write_handler("capacity", reconfigure_keyword_handler, "0 CAPACITY");
     add_write_handler("reset_counts", write_handler, (void *)0, Handler::BUTTON | Handler::NONEXCLUSIVE);
     add_write_handler("reset", write_handler, (void *)1, Handler::BUTTON);
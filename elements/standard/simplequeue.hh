@@ -3,6 +3,7 @@
 #define CLICK_SIMPLEQUEUE_HH
 #include <click/element.hh>
 #include <click/standard/storage.hh>
+#include <click/perthread.hh>
 CLICK_DECLS
 
 /*
@@ -67,12 +68,14 @@ class SimpleQueue : public Element, public Storage { public:
     SimpleQueue();
     ~SimpleQueue();
 
-    int drops() const				{ return _drops; }
+    int drops() const				{ return _drops.value(); }
     int highwater_length() const		{ return _highwater_length; }
 
     inline bool enq(Packet*);
     inline void lifo_enq(Packet*);
     inline Packet* deq();
+    inline int enq_batch(PacketBatch &batch, PacketBatch &dropped);
+    inline PacketBatch deq_batch(unsigned max);
 
     // to be used with care
     Packet* packet(int i) const			{ return _q[i]; }
@@ -97,12 +100,18 @@ class SimpleQueue : public Element, public Storage { public:
 
     void push(int port, Packet*);
     Packet* pull(int port);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
 
   protected:
 
     Packet* volatile * _q;
-    volatile int _drops;
+    PerThreadCounter _drops;
     int _highwater_length;
+    bool _overflowed;
+
+    inline void count_drops(uint32_t n);
+    inline void push_batch_failure(PacketBatch &dropped);
 
     friend class MixedQueue;
     friend class TokenQueue;
@@ -166,6 +175,64 @@ SimpleQueue::deq()
 	return 0;
 }
 
+/** @brief Enqueue the packets in @a batch.
+ *
+ * Packets that do not fit are moved to @a dropped; the caller must account
+ * for them.  Returns the queue's size after the enqueue.  The new tail is
+ * published once for the whole batch. */
+inline int
+SimpleQueue::enq_batch(PacketBatch &batch, PacketBatch &dropped)
+{
+    int h = _head, t = _tail;
+    while (Packet *p = batch.pop_front()) {
+	int nt = next_i(t);
+	if (nt != h) {
+	    _q[t] = p;
+	    t = nt;
+	} else
+	    dropped.append(p);
+    }
+    packet_memory_barrier();
+    _tail = t;
+    int s = size(h, t);
+    if (s > _highwater_length)
+	_highwater_length = s;
+    return s;
+}
+
+/** @brief Dequeue and return at most @a max packets. */
+inline PacketBatch
+SimpleQueue::deq_batch(unsigned max)
+{
+    PacketBatch batch;
+    int h = _head, t = _tail;
+    while (h != t && batch.count() < max) {
+	batch.append(_q[h]);
+	h = next_i(h);
+    }
+    packet_memory_barrier();
+    _head = h;
+    return batch;
+}
+
+/** @brief Count @a n dropped packets, reporting the first overflow. */
+inline void
+SimpleQueue::count_drops(uint32_t n)
+{
+    if (!_overflowed && _capacity > 0) {
+	_overflowed = true;
+	click_chatter("%{element}: overflow", this);
+    }
+    _drops += n;
+}
+
+inline void
+SimpleQueue::push_batch_failure(PacketBatch &dropped)
+{
+    count_drops(dropped.count());
+    checked_output_push_batch(1, dropped);
+}
+
 template <typename Filter>
 Packet *
 SimpleQueue::yank1(Filter filter)
@@ -0,0 +1,212 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * spscqueue.{cc,hh} -- single-producer, single-consumer ring queue
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "spscqueue.hh"
+#include <click/confparse.hh>
+#include <click/error.hh>
+CLICK_DECLS
+
+SPSCQueue::SPSCQueue()
+    : _ring(0), _capacity(0), _mask(0), _head(0), _sleepiness(0),
+      _head_cache(0)
+{
+    _tail = 0;
+    _drops = 0;
+}
+
+SPSCQueue::~SPSCQueue()
+{
+}
+
+void *
+SPSCQueue::cast(const char *n)
+{
+    if (strcmp(n, "SPSCQueue") == 0)
+	return (SPSCQueue *)this;
+    else if (strcmp(n, Notifier::EMPTY_NOTIFIER) == 0)
+	return static_cast<Notifier *>(&_empty_note);
+    else
+	return Element::cast(n);
+}
+
+int
+SPSCQueue::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    uint32_t capacity = default_capacity;
+    if (cp_va_kparse(conf, this, errh,
+		     "CAPACITY", cpkP, cpUnsigned, &capacity,
+		     cpEnd) < 0)
+	return -1;
+    if (capacity == 0 || capacity > 0x10000000)
+	return errh->error("CAPACITY must be between 1 and 2^28");
+    for (_capacity = 1; _capacity < capacity; _capacity <<= 1)
+	/* nada */;
+    _mask = _capacity - 1;
+    _empty_note.initialize(Notifier::EMPTY_NOTIFIER, router());
+    return 0;
+}
+
+int
+SPSCQueue::initialize(ErrorHandler *errh)
+{
+    if (!(_ring = new Packet *[_capacity]))
+	return errh->error("out of memory");
+    for (uint32_t i = 0; i < _capacity; ++i)
+	_ring[i] = 0;
+    _head = _head_cache = 0;
+    _tail = 0;
+    return 0;
+}
+
+void
+SPSCQueue::cleanup(CleanupStage)
+{
+    if (_ring) {
+	for (uint32_t i = 0; i < _capacity; ++i)
+	    if (_ring[i])
+		_ring[i]->kill();
+	delete[] _ring;
+	_ring = 0;
+    }
+}
+
+void
+SPSCQueue::push_drop(PacketBatch &dropped)
+{
+    if (_drops == 0)
+	click_chatter("%{element}: overflow", this);
+    _drops += dropped.count();
+    dropped.kill();
+}
+
+void
+SPSCQueue::push(int, Packet *p)
+{
+    uint32_t t = _tail.value();
+    if (push_room(t, 1)) {
+	click_order_fence();
+	_ring[t & _mask] = p;
+	_tail = t + 1;
+	_empty_note.wake();
+    } else {
+	PacketBatch dropped(p);
+	push_drop(dropped);
+    }
+}
+
+void
+SPSCQueue::push_batch(int, PacketBatch &batch)
+{
+    uint32_t t = _tail.value();
+    uint32_t n = push_room(t, batch.count());
+    if (n) {
+	push_slots(t, batch, n);
+	_tail = t + n;
+	_empty_note.wake();
+    }
+    if (batch)
+	push_drop(batch);
+}
+
+void
+SPSCQueue::pull_empty()
+{
+    if (_sleepiness >= SLEEPINESS_TRIGGER) {
+	_empty_note.sleep();
+#if HAVE_MULTITHREAD
+	// See NotifierQueue::pull(): a concurrent push() may have just
+	// called wake().
+	click_order_fence();
+	if (_ring[_head & _mask])
+	    _empty_note.wake();
+#endif
+    } else
+	++_sleepiness;
+}
+
+Packet *
+SPSCQueue::pull(int)
+{
+    uint32_t h = _head;
+    Packet *p = _ring[h & _mask];
+    if (p) {
+	click_order_fence();
+	_ring[h & _mask] = 0;
+	click_order_fence();
+	_head = h + 1;
+	_sleepiness = 0;
+    } else
+	pull_empty();
+    return p;
+}
+
+PacketBatch
+SPSCQueue::pull_batch(int, unsigned max)
+{
+    PacketBatch batch;
+    uint32_t h = _head, n;
+    for (n = 0; n < max; ++n) {
+	Packet *p = _ring[(h + n) & _mask];
+	if (!p)
+	    break;
+	click_order_fence();
+	_ring[(h + n) & _mask] = 0;
+	batch.append(p);
+    }
+    if (n) {
+	click_order_fence();
+	_head = h + n;
+	_sleepiness = 0;
+    } else
+	pull_empty();
+    return batch;
+}
+
+String
+SPSCQueue::read_handler(Element *e, void *thunk)
+{
+    SPSCQueue *q = static_cast<SPSCQueue *>(e);
+    switch (reinterpret_cast<intptr_t>(thunk)) {
+      case 0:
+	return String(q->size());
+      case 1:
+	return String(q->capacity());
+      case 2:
+	return String(q->drops());
+      default:
+	return "";
+    }
+}
+
+int
+SPSCQueue::write_handler(const String &, Element *e, void *, ErrorHandler *)
+{
+    SPSCQueue *q = static_cast<SPSCQueue *>(e);
+    q->_drops = 0;
+    return 0;
+}
+
+void
+SPSCQueue::add_handlers()
+{
+    add_read_handler("length", read_handler, (void *)0);
+    add_read_handler("capacity", read_handler, (void *)1, Handler::CALM);
+    add_read_handler("drops", read_handler, (void *)2);
+    add_write_handler("reset_counts", write_handler, 0, Handler::BUTTON | Handler::NONEXCLUSIVE);
+}
+
+CLICK_ENDDECLS
+EXPORT_ELEMENT(SPSCQueue)
@@ -0,0 +1,154 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_SPSCQUEUE_HH
+#define CLICK_SPSCQUEUE_HH
+#include <click/element.hh>
+#include <click/notifier.hh>
+#include <click/atomic.hh>
+CLICK_DECLS
+
+/*
+=c
+
+SPSCQueue
+SPSCQueue(CAPACITY)
+
+=s storage
+
+stores packets in a single-producer, single-consumer ring
+
+=d
+
+Stores incoming packets in a first-in-first-out queue.  Drops incoming
+packets if the queue already holds CAPACITY packets.  CAPACITY is rounded up
+to a power of two; the default is 1024.
+
+SPSCQueue is designed to hand packets from one thread to another.  At most
+one thread may push to an SPSCQueue at a time, and at most one thread may
+pull from it at a time.  (See MPSCQueue for a queue that supports several
+concurrent pushers.)  The pushing side and the pulling side each keep their
+state on their own cache lines, and neither side takes a lock.  Apart from
+the atomic update of the drop count when packets are dropped, neither side
+executes an atomic instruction.  The puller recognizes new packets by finding a nonnull
+ring slot, so it never reads the pusher's index at all; the pusher reads the
+puller's index only when its cached copy shows the ring full.  Batched pushes
+and pulls move a whole PacketBatch with one pass over the ring.
+
+Like NotifierQueue, SPSCQueue notifies interested parties when it becomes
+empty and when a formerly-empty queue receives a packet.
+
+SPSCQueue's capacity cannot be changed once the router is running.
+
+=h length read-only
+
+Returns the current number of packets in the queue.
+
+=h capacity read-only
+
+Returns the queue's capacity.
+
+=h drops read-only
+
+Returns the number of packets dropped by the queue so far.
+
+=h reset_counts write-only
+
+When written, resets the C<drops> counter.
+
+=a MPSCQueue, NotifierQueue, ThreadSafeQueue, Queue */
+
+class SPSCQueue : public Element { public:
+
+    SPSCQueue();
+    ~SPSCQueue();
+
+    const char *class_name() const		{ return "SPSCQueue"; }
+    const char *port_count() const		{ return PORTS_1_1; }
+    const char *processing() const		{ return PUSH_TO_PULL; }
+    void *cast(const char *);
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+    Packet *pull(int port);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
+
+    uint32_t capacity() const			{ return _capacity; }
+    inline uint32_t size() const;
+    uint32_t drops() const			{ return _drops; }
+
+  protected:
+
+    enum { cache_line_size = 64, default_capacity = 1024,
+	   SLEEPINESS_TRIGGER = 9 };
+
+    Packet * volatile *_ring;
+    uint32_t _capacity;
+    uint32_t _mask;
+    ActiveNotifier _empty_note;
+
+    // Puller state: written only by the pulling thread.
+    char _pad0[cache_line_size];
+    volatile uint32_t _head;
+    int _sleepiness;
+
+    // Pusher state: _head_cache is a possibly stale copy of _head.
+    char _pad1[cache_line_size];
+    atomic_uint32_t _tail;
+    uint32_t _head_cache;
+    atomic_uint32_t _drops;
+    char _pad2[cache_line_size];
+
+    inline uint32_t push_room(uint32_t tail, uint32_t want);
+    inline void push_slots(uint32_t tail, PacketBatch &batch, uint32_t n);
+    void push_drop(PacketBatch &dropped);
+    void pull_empty();
+
+    static String read_handler(Element *e, void *thunk);
+    static int write_handler(const String &str, Element *e, void *thunk, ErrorHandler *errh);
+
+};
+
+inline uint32_t
+SPSCQueue::size() const
+{
+    return _tail.value() - _head;
+}
+
+/** @brief Return how many of @a want packets fit after @a tail.
+ *
+ * Consults the cached head first and rereads _head only when the cache
+ * shows too little room.  Only a single pusher may call this, since it
+ * updates _head_cache; MPSCQueue computes room from a fresh _head instead. */
+inline uint32_t
+SPSCQueue::push_room(uint32_t tail, uint32_t want)
+{
+    uint32_t used = tail - _head_cache;
+    if (used > _capacity || _capacity - used < want) {
+	_head_cache = _head;
+	used = tail - _head_cache;
+	if (used > _capacity)	// stale tail
+	    return 0;
+    }
+    uint32_t room = _capacity - used;
+    return room < want ? room : want;
+}
+
+/** @brief Store the first @a n packets of @a batch into slots starting at
+ * @a tail.
+ *
+ * The puller treats a nonnull slot as a published packet, so each slot is
+ * written after its packet's contents. */
+inline void
+SPSCQueue::push_slots(uint32_t tail, PacketBatch &batch, uint32_t n)
+{
+    click_order_fence();
+    for (uint32_t i = 0; i < n; ++i)
+	_ring[(tail + i) & _mask] = batch.pop_front();
+}
+
+CLICK_ENDDECLS
+#endif
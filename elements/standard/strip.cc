@@ -46,6 +46,23 @@ Strip::simple_action(Packet *p)
     return p;
 }
 
+void
+Strip::push_batch(int, PacketBatch &batch)
+{
+    for (Packet *p = batch.front(); p; p = p->next())
+	p->pull(_nbytes);
+    output(0).push_batch(batch);
+}
+
+PacketBatch
+Strip::pull_batch(int, unsigned max)
+{
+    PacketBatch batch = input(0).pull_batch(max);
+    for (Packet *p = batch.front(); p; p = p->next())
+	p->pull(_nbytes);
+    return batch;
+}
+
 CLICK_ENDDECLS
 EXPORT_ELEMENT(Strip)
 ELEMENT_MT_SAFE(Strip)
@@ -30,6 +30,8 @@ class Strip : public Element { public:
     int configure(Vector<String> &, ErrorHandler *);
 
     Packet *simple_action(Packet *);
+    void push_batch(int port, PacketBatch &batch);
+    PacketBatch pull_batch(int port, unsigned max);
 
   private:
 
@@ -49,7 +49,8 @@ When written, resets the C<drops> and C<highwater_length> counters.
 
 When written, drops all packets in the queue.
 
-=a Queue, SimpleQueue, NotifierQueue, MixedQueue, FrontDropQueue */
+=a Queue, SimpleQueue, NotifierQueue, MixedQueue, FrontDropQueue, SPSCQueue,
+MPSCQueue */
 
 class ThreadSafeQueue : public FullNoteQueue { public:
 
@@ -63,6 +64,13 @@ class ThreadSafeQueue : public FullNoteQueue { public:
 
     void push(int port, Packet *);
     Packet *pull(int port);
+    // the inherited batch functions are not safe for concurrent use
+    void push_batch(int port, PacketBatch &batch) {
+	Element::push_batch(port, batch);
+    }
+    PacketBatch pull_batch(int port, unsigned max) {
+	return Element::pull_batch(port, max);
+    }
 
   private:
 
@@ -19,7 +19,9 @@ pull-to-push converter
 Pulls packets whenever they are available, then pushes them out
 its single output. Pulls a maximum of BURST packets every time
 it is scheduled. Default BURST is 1. If BURST
-is less than 0, pull until nothing comes back.
+is less than 0, pull until nothing comes back. Packets are pulled and pushed
+in batches of up to BURST packets, so a downstream path of batch-aware
+elements handles a whole burst with one call per element.
 
 Keyword arguments are:
 
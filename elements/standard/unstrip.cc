@@ -45,6 +45,27 @@ Unstrip::simple_action(Packet *p)
   return p->push(_nbytes);
 }
 
+void
+Unstrip::push_batch(int, PacketBatch &batch)
+{
+  PacketBatch out;
+  while (Packet *p = batch.pop_front())
+    if (WritablePacket *q = p->push(_nbytes))
+      out.append(q);
+  if (out)
+    output(0).push_batch(out);
+}
+
+PacketBatch
+Unstrip::pull_batch(int, unsigned max)
+{
+  PacketBatch batch = input(0).pull_batch(max), out;
+  while (Packet *p = batch.pop_front())
+    if (WritablePacket *q = p->push(_nbytes))
+      out.append(q);
+  return out;
+}
+
 CLICK_ENDDECLS
 EXPORT_ELEMENT(Unstrip)
 ELEMENT_MT_SAFE(Unstrip)
@@ -34,6 +34,8 @@ class Unstrip : public Element {
   int configure(Vector<String> &, ErrorHandler *);
 
   Packet *simple_action(Packet *);
+  void push_batch(int port, PacketBatch &batch);
+  PacketBatch pull_batch(int port, unsigned max);
 
 };
 
@@ -29,7 +29,6 @@
 CLICK_DECLS
 
 IPRewriter::IPRewriter()
-    : _udp_map(0)
 {
 }
 
@@ -76,7 +75,7 @@ IPRewriter::get_entry(int ip_p, const IPFlowID &flowid, int input)
 	return TCPRewriter::get_entry(ip_p, flowid, input);
     if (ip_p != IP_PROTO_UDP)
 	return 0;
-    IPRewriterEntry *m = _udp_map.get(flowid);
+    IPRewriterEntry *m = _shards ? _shards->find(flowid, ip_p) : _udp_map.get(flowid);
     if (!m && (unsigned) input < (unsigned) _input_specs.size()) {
 	IPRewriterInput &is = _input_specs[input];
 	IPFlowID rewritten_flowid = IPFlowID::uninitialized_t();
@@ -94,7 +93,7 @@ IPRewriter::add_flow(int ip_p, const IPFlowID &flowid,
 	return TCPRewriter::add_flow(ip_p, flowid, rewritten_flowid, input);
 
     void *data;
-    if (!(data = _udp_allocator.allocate()))
+    if (!(data = allocate_flow(_udp_allocator)))
 	return 0;
 
     IPRewriterFlow *flow = new(data) IPRewriterFlow
@@ -125,8 +124,13 @@ IPRewriter::push(int port, Packet *p_in)
     }
 
     IPFlowID flowid(p);
-    HashContainer<IPRewriterEntry> *map = (iph->ip_p == IP_PROTO_TCP ? &_map : &_udp_map);
-    IPRewriterEntry *m = map->get(flowid);
+    IPRewriterEntry *m;
+    if (_shards)
+	m = _shards->find(flowid, iph->ip_p);
+    else {
+	Map *map = (iph->ip_p == IP_PROTO_TCP ? &_map : &_udp_map);
+	m = map->get(flowid);
+    }
 
     if (!m) {			// create new mapping
 	IPRewriterInput &is = _input_specs.at_u(port);
@@ -146,26 +150,50 @@ IPRewriter::push(int port, Packet *p_in)
     if (iph->ip_p == IP_PROTO_TCP) {
 	TCPFlow *tcpmf = static_cast<TCPFlow *>(mf);
 	tcpmf->apply(p, m->direction(), _annos);
-	if (_timeouts[1])
+	if (_shards)
+	    tcpmf->set_expiry(now_j + tcp_flow_timeout(tcpmf));
+	else if (_timeouts[1])
 	    tcpmf->change_expiry(_heap, true, now_j + _timeouts[1]);
 	else
 	    tcpmf->change_expiry(_heap, false, now_j + tcp_flow_timeout(tcpmf));
     } else {
 	mf->apply(p, m->direction(), _annos);
-	mf->change_expiry_by_timeout(_heap, now_j, _udp_timeouts);
+	if (_shards)
+	    mf->set_expiry(now_j + _udp_timeouts[0]);
+	else
+	    mf->change_expiry_by_timeout(_heap, now_j, _udp_timeouts);
     }
 
     output(m->output()).push(p);
 }
 
+void
+IPRewriter::push_batch(int port, PacketBatch &batch)
+{
+    // Fetch every packet's flow table slots before rewriting any of them.
+    if (!_shards)
+	for (Packet *p = batch.front(); p; p = p->next())
+	    prefetch_flow((p->ip_header()->ip_p == IP_PROTO_UDP ? _udp_map : _map), p);
+    while (Packet *p = batch.pop_front())
+	push(port, p);
+}
+
 String
 IPRewriter::udp_mappings_handler(Element *e, void *)
 {
     IPRewriter *rw = (IPRewriter *)e;
     click_jiffies_t now = click_jiffies();
     StringAccum sa;
+    if (rw->_shards) {
+	Vector<IPRewriterEntry *> v;
+	rw->_shards->entries(v, IP_PROTO_UDP);
+	for (IPRewriterEntry **it = v.begin(); it != v.end(); ++it) {
+	    (*it)->flow()->unparse(sa, (*it)->direction(), now);
+	    sa << '\n';
+	}
+    }
     for (Map::iterator iter = rw->_udp_map.begin(); iter.live(); ++iter) {
-	iter->flow()->unparse(sa, iter->direction(), now);
+	iter.value()->flow()->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
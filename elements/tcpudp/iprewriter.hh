@@ -162,6 +162,20 @@ element, in which case this element will share the other element's capacity.
 Boolean. If true, then set the destination IP address annotation on passing
 packets to the rewritten destination address. Default is true.
 
+=item SHARDS I<n>
+
+Unsigned integer.  If nonzero, keep mappings in a flow table split into
+I<n> shards that several threads can use at once.  Lookups take no locks;
+new mappings lock only the shards they touch, and each shard keeps its own
+expiry heap.  Pattern inputs choose source ports whose reply mappings land in
+the same shard as the flow, and never hand out a port that another live
+mapping of the same pattern is using.  The MAPPING_CAPACITY is divided evenly
+among the shards; a full shard drops new flows, even if its flows are not
+guaranteed, and counts them as mapping failures.  Mapper inputs, inputs whose
+replies go to another element, and capacities shared with other elements are
+not supported.  Removed mappings are freed at the second reap after their
+removal.  Default is 0, which uses an unsharded table suitable for one thread.
+
 =back
 
 =h nmappings r
@@ -198,7 +212,8 @@ Returns a human-readable description of the IPRewriter's current set of
 UDP mappings.
 
 =a TCPRewriter, IPAddrRewriter, IPAddrPairRewriter, IPRewriterPatterns,
-RoundRobinIPMapper, FTPPortMapper, ICMPRewriter, ICMPPingRewriter */
+RoundRobinIPMapper, FTPPortMapper, ICMPRewriter, ICMPPingRewriter,
+IPRewriterBench */
 
 class IPRewriter : public TCPRewriter { public:
 
@@ -211,7 +226,7 @@ class IPRewriter : public TCPRewriter { public:
     int configure(Vector<String> &, ErrorHandler *);
 
     IPRewriterEntry *get_entry(int ip_p, const IPFlowID &flowid, int input);
-    HashContainer<IPRewriterEntry> *get_map(int mapid) {
+    Map *get_map(int mapid) {
 	if (mapid == IPRewriterInput::mapid_default)
 	    return &_map;
 	else if (mapid == IPRewriterInput::mapid_iprewriter_udp)
@@ -230,6 +245,7 @@ class IPRewriter : public TCPRewriter { public:
     }
 
     void push(int, Packet *);
+    void push_batch(int port, PacketBatch &batch);
 
     void add_handlers();
 
@@ -256,7 +272,7 @@ IPRewriter::destroy_flow(IPRewriterFlow *flow)
     else {
 	unmap_flow(flow, _udp_map, &reply_udp_map(flow->owner_input()));
 	flow->~IPRewriterFlow();
-	_udp_allocator.deallocate(flow);
+	deallocate_flow(_udp_allocator, flow);
     }
 }
 
@@ -102,11 +102,8 @@ TCPRewriter::TCPFlow::apply_sack(bool direction, click_tcp *tcph, int len)
 	}
 
   done:
-    if (csum_delta) {
-	uint32_t sum = (~tcph->th_sum & 0xFFFF) + csum_delta;
-	sum = (sum & 0xFFFF) + (sum >> 16);
-	tcph->th_sum = ~(sum + (sum >> 16));
-    }
+    if (csum_delta)
+	click_update_in_cksum_delta(&tcph->th_sum, csum_delta);
 }
 
 void
@@ -153,15 +150,13 @@ TCPRewriter::TCPFlow::apply(WritablePacket *p, bool direction, unsigned annos)
     // update sequence numbers
     if (_tflags & (tf_seqno_delta << direction)) {
 	uint32_t newval = htonl(new_seq(direction, ntohl(tcph->th_seq)));
-	click_update_in_cksum(&tcph->th_sum, tcph->th_seq >> 16, newval >> 16);
-	click_update_in_cksum(&tcph->th_sum, tcph->th_seq, newval);
+	click_update_in_cksum32(&tcph->th_sum, tcph->th_seq, newval);
 	tcph->th_seq = newval;
     }
 
     if (_tflags & (tf_seqno_delta << !direction)) {
 	uint32_t newval = htonl(new_ack(direction, ntohl(tcph->th_ack)));
-	click_update_in_cksum(&tcph->th_sum, tcph->th_ack >> 16, newval >> 16);
-	click_update_in_cksum(&tcph->th_sum, tcph->th_ack, newval);
+	click_update_in_cksum32(&tcph->th_sum, tcph->th_ack, newval);
 	tcph->th_ack = newval;
 
 	// update SACK sequence numbers
@@ -212,6 +207,7 @@ TCPRewriter::configure(Vector<String> &conf, ErrorHandler *errh)
     _tcp_done_timeout = 240;	// 4 minutes
     bool dst_anno = true, has_reply_anno = false;
     int reply_anno;
+    uint32_t nshards = 0;
 
     if (cp_va_kparse_remove_keywords
 	(conf, this, errh,
@@ -222,7 +218,9 @@ TCPRewriter::configure(Vector<String> &conf, ErrorHandler *errh)
 	 "TCP_DONE_TIMEOUT", 0, cpSeconds, &_tcp_done_timeout,
 	 "DST_ANNO", 0, cpBool, &dst_anno,
 	 "REPLY_ANNO", cpkC, &has_reply_anno, cpAnno, 1, &reply_anno,
-	 cpEnd) < 0)
+	 "SHARDS", 0, cpUnsigned, &nshards,
+	 cpEnd) < 0
+	|| configure_shards(nshards, errh) < 0)
 	return -1;
 
     _annos = (dst_anno ? 1 : 0) + (has_reply_anno ? 2 + (reply_anno << 2) : 0);
@@ -237,7 +235,7 @@ TCPRewriter::add_flow(int /*ip_p*/, const IPFlowID &flowid,
 		      const IPFlowID &rewritten_flowid, int input)
 {
     void *data;
-    if (!(data = _allocator.allocate()))
+    if (!(data = allocate_flow(_allocator)))
 	return 0;
 
     TCPFlow *flow = new(data) TCPFlow
@@ -268,7 +266,7 @@ TCPRewriter::push(int port, Packet *p_in)
     }
 
     IPFlowID flowid(p);
-    IPRewriterEntry *m = _map.get(flowid);
+    IPRewriterEntry *m = _shards ? _shards->find(flowid, IP_PROTO_TCP) : _map.get(flowid);
 
     if (!m) {			// create new mapping
 	IPRewriterInput &is = _input_specs.at_u(port);
@@ -287,7 +285,9 @@ TCPRewriter::push(int port, Packet *p_in)
     mf->apply(p, m->direction(), _annos);
 
     click_jiffies_t now_j = click_jiffies();
-    if (_timeouts[1])
+    if (_shards)
+	mf->set_expiry(now_j + tcp_flow_timeout(mf));
+    else if (_timeouts[1])
 	mf->change_expiry(_heap, true, now_j + _timeouts[1]);
     else
 	mf->change_expiry(_heap, false, now_j + tcp_flow_timeout(mf));
@@ -295,6 +295,17 @@ TCPRewriter::push(int port, Packet *p_in)
     output(m->output()).push(p);
 }
 
+void
+TCPRewriter::push_batch(int port, PacketBatch &batch)
+{
+    // Fetch every packet's flow table slots before rewriting any of them.
+    if (!_shards)
+	for (Packet *p = batch.front(); p; p = p->next())
+	    prefetch_flow(_map, p);
+    while (Packet *p = batch.pop_front())
+	push(port, p);
+}
+
 
 String
 TCPRewriter::tcp_mappings_handler(Element *e, void *)
@@ -302,9 +313,18 @@ TCPRewriter::tcp_mappings_handler(Element *e, void *)
     TCPRewriter *rw = (TCPRewriter *)e;
     click_jiffies_t now = click_jiffies();
     StringAccum sa;
+    if (rw->_shards) {
+	Vector<IPRewriterEntry *> v;
+	rw->_shards->entries(v, IP_PROTO_TCP);
+	for (IPRewriterEntry **it = v.begin(); it != v.end(); ++it) {
+	    TCPFlow *f = static_cast<TCPFlow *>((*it)->flow());
+	    f->unparse(sa, (*it)->direction(), now);
+	    sa << '\n';
+	}
+    }
     for (Map::iterator iter = rw->_map.begin(); iter.live(); ++iter) {
-	TCPFlow *f = static_cast<TCPFlow *>(iter->flow());
-	f->unparse(sa, iter->direction(), now);
+	TCPFlow *f = static_cast<TCPFlow *>(iter.value()->flow());
+	f->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
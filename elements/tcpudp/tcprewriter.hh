@@ -73,6 +73,12 @@ element, in which case this element will share the other element's capacity.
 Boolean. If true, then set the destination IP address annotation on passing
 packets to the rewritten destination address. Default is true.
 
+=item SHARDS I<n>
+
+Unsigned integer.  If nonzero, keep mappings in a flow table split into
+I<n> shards that several threads can use at once.  See IPRewriter for
+details.  Default is 0.
+
 =back
 
 =h mappings read-only
@@ -137,6 +143,7 @@ class TCPRewriter : public IPRewriterBase { public:
     }
 
     void push(int, Packet *);
+    void push_batch(int port, PacketBatch &batch);
 
     void add_handlers();
 
@@ -165,7 +172,7 @@ TCPRewriter::destroy_flow(IPRewriterFlow *flow)
 {
     unmap_flow(flow, _map);
     static_cast<TCPFlow *>(flow)->~TCPFlow();
-    _allocator.deallocate(flow);
+    deallocate_flow(_allocator, flow);
 }
 
 inline tcp_seq_t
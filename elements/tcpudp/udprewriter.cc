@@ -48,6 +48,7 @@ UDPRewriter::configure(Vector<String> &conf, ErrorHandler *errh)
 {
     bool dst_anno = true, has_reply_anno = false;
     int reply_anno;
+    uint32_t nshards = 0;
     _timeouts[0] = 300;		// 5 minutes
 
     if (cp_va_kparse_remove_keywords
@@ -56,7 +57,9 @@ UDPRewriter::configure(Vector<String> &conf, ErrorHandler *errh)
 	 "REPLY_ANNO", cpkC, &has_reply_anno, cpAnno, 1, &reply_anno,
 	 "UDP_TIMEOUT", 0, cpSeconds, &_timeouts[0],
 	 "UDP_GUARANTEE", 0, cpSeconds, &_timeouts[1],
-	 cpEnd) < 0)
+	 "SHARDS", 0, cpUnsigned, &nshards,
+	 cpEnd) < 0
+	|| configure_shards(nshards, errh) < 0)
 	return -1;
 
     _annos = (dst_anno ? 1 : 0) + (has_reply_anno ? 2 + (reply_anno << 2) : 0);
@@ -68,7 +71,7 @@ UDPRewriter::add_flow(int ip_p, const IPFlowID &flowid,
 		      const IPFlowID &rewritten_flowid, int input)
 {
     void *data;
-    if (!(data = _allocator.allocate()))
+    if (!(data = allocate_flow(_allocator)))
 	return 0;
 
     IPRewriterFlow *flow = new(data) IPRewriterFlow
@@ -102,7 +105,7 @@ UDPRewriter::push(int port, Packet *p_in)
     }
 
     IPFlowID flowid(p);
-    IPRewriterEntry *m = _map.get(flowid);
+    IPRewriterEntry *m = _shards ? _shards->find(flowid, ip_p) : _map.get(flowid);
 
     if (!m) {			// create new mapping
 	IPRewriterInput &is = _input_specs.at_u(port);
@@ -119,11 +122,25 @@ UDPRewriter::push(int port, Packet *p_in)
 
     IPRewriterFlow *mf = static_cast<IPRewriterFlow *>(m->flow());
     mf->apply(p, m->direction(), _annos);
-    mf->change_expiry_by_timeout(_heap, click_jiffies(), _timeouts);
+    if (_shards)
+	mf->set_expiry(click_jiffies() + _timeouts[0]);
+    else
+	mf->change_expiry_by_timeout(_heap, click_jiffies(), _timeouts);
 
     output(m->output()).push(p);
 }
 
+void
+UDPRewriter::push_batch(int port, PacketBatch &batch)
+{
+    // Fetch every packet's flow table slots before rewriting any of them.
+    if (!_shards)
+	for (Packet *p = batch.front(); p; p = p->next())
+	    prefetch_flow(_map, p);
+    while (Packet *p = batch.pop_front())
+	push(port, p);
+}
+
 
 String
 UDPRewriter::dump_mappings_handler(Element *e, void *)
@@ -131,8 +148,16 @@ UDPRewriter::dump_mappings_handler(Element *e, void *)
     UDPRewriter *rw = (UDPRewriter *)e;
     click_jiffies_t now = click_jiffies();
     StringAccum sa;
+    if (rw->_shards) {
+	Vector<IPRewriterEntry *> v;
+	rw->_shards->entries(v);
+	for (IPRewriterEntry **it = v.begin(); it != v.end(); ++it) {
+	    (*it)->flow()->unparse(sa, (*it)->direction(), now);
+	    sa << '\n';
+	}
+    }
     for (Map::iterator iter = rw->_map.begin(); iter.live(); ++iter) {
-	iter->flow()->unparse(sa, iter->direction(), now);
+	iter.value()->flow()->unparse(sa, iter.value()->direction(), now);
 	sa << '\n';
     }
     return sa.take_string();
@@ -143,6 +143,12 @@ element, in which case this element will share the other element's capacity.
 Boolean. If true, then set the destination IP address annotation on passing
 packets to the rewritten destination address. Default is true.
 
+=item SHARDS I<n>
+
+Unsigned integer.  If nonzero, keep mappings in a flow table split into
+I<n> shards that several threads can use at once.  See IPRewriter for
+details.  Default is 0.
+
 =back
 
 =h mappings read-only
@@ -168,6 +174,7 @@ class UDPRewriter : public IPRewriterBase { public:
     void destroy_flow(IPRewriterFlow *flow);
 
     void push(int, Packet *);
+    void push_batch(int port, PacketBatch &batch);
 
     void add_handlers();
 
@@ -188,7 +195,7 @@ UDPRewriter::destroy_flow(IPRewriterFlow *flow)
 {
     unmap_flow(flow, _map);
     flow->~IPRewriterFlow();
-    _allocator.deallocate(flow);
+    deallocate_flow(_allocator, flow);
 }
 
 CLICK_ENDDECLS
@@ -0,0 +1,262 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * checksumbench.{cc,hh} -- benchmark and check the Internet checksum
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "checksumbench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+#include <clicknet/ip.h>
+CLICK_DECLS
+
+static const char * const kernel_names[] = { "generic", "sse2", "avx2" };
+enum { nkernel_names = sizeof(kernel_names) / sizeof(kernel_names[0]),
+       check_length = 2048 };
+
+ChecksumBench::ChecksumBench()
+    : _timer(this), _errors(0)
+{
+}
+
+ChecksumBench::~ChecksumBench()
+{
+}
+
+int
+ChecksumBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    String lengths = "20 64 576 1500 9000";
+    _nbytes = 1000000000;
+    _seed = 1;
+    _stop = false;
+    if (cp_va_kparse(conf, this, errh,
+		     "LENGTHS", 0, cpArgument, &lengths,
+		     "BYTES", 0, cpUnsigned64, &_nbytes,
+		     "KERNEL", 0, cpWord, &_kernel,
+		     "SEED", 0, cpUnsigned, &_seed,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+
+    Vector<String> words;
+    cp_spacevec(lengths, words);
+    _lengths.clear();
+    for (String *it = words.begin(); it != words.end(); ++it) {
+	int len;
+	if (!cp_integer(*it, &len) || len <= 0)
+	    return errh->error("LENGTHS must contain positive integers");
+	_lengths.push_back(len);
+    }
+
+    String original = click_in_cksum_kernel();
+    if (_kernel) {
+	if (click_in_cksum_set_kernel(_kernel.c_str()) < 0)
+	    return errh->error("KERNEL %<%s%> not available on this CPU", _kernel.c_str());
+	click_in_cksum_set_kernel(original.c_str());
+    } else
+	_kernel = original;
+
+    if (_seed == 0)
+	_seed = 1;
+    return 0;
+}
+
+int
+ChecksumBench::initialize(ErrorHandler *)
+{
+    _timer.initialize(this);
+    _timer.schedule_now();
+    return 0;
+}
+
+inline uint32_t
+ChecksumBench::random()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+void
+ChecksumBench::fill(unsigned char *data, int len)
+{
+    for (int i = 0; i < len; ++i)
+	data[i] = random() >> 24;
+}
+
+// Sum the data a byte at a time, in network byte order.
+static uint16_t
+reference_cksum(const unsigned char *data, int len)
+{
+    uint64_t sum = 0;
+    for (int i = 0; i < len; ++i)
+	sum += (i & 1 ? data[i] : data[i] << 8);
+    while (sum >> 16)
+	sum = (sum & 0xFFFF) + (sum >> 16);
+    return htons(~sum & 0xFFFF);
+}
+
+// 0x0000 and 0xFFFF are the same number in one's complement; incremental
+// updates may produce either.
+static inline bool
+same_cksum(uint16_t a, uint16_t b)
+{
+    return a == b || ((uint16_t) (a + 1) <= 1 && (uint16_t) (b + 1) <= 1);
+}
+
+void
+ChecksumBench::error(const char *kernel, int offset, int len, uint16_t got, uint16_t expected)
+{
+    if (++_errors <= 5)
+	click_chatter("%{element}: %s: offset %d length %d: got %04x, expected %04x",
+		      this, kernel, offset, len, ntohs(got), ntohs(expected));
+}
+
+void
+ChecksumBench::check_kernel(const char *kernel, unsigned char *data)
+{
+    for (int offset = 0; offset < 16; offset += 2)
+	for (int len = 0; len <= check_length; ++len) {
+	    uint16_t got = click_in_cksum(data + offset, len);
+	    uint16_t expected = reference_cksum(data + offset, len);
+	    if (got != expected)
+		error(kernel, offset, len, got, expected);
+	}
+    // long runs of 0xFF bytes stress the loops' partial sums
+    unsigned char *ones = new unsigned char[65536];
+    memset(ones, 0xFF, 65536);
+    for (int len = check_length; len <= 65536; len *= 2) {
+	uint16_t got = click_in_cksum(ones, len);
+	uint16_t expected = reference_cksum(ones, len);
+	if (got != expected)
+	    error(kernel, 0, len, got, expected);
+    }
+    delete[] ones;
+}
+
+void
+ChecksumBench::check_updates(unsigned char *data)
+{
+    for (int i = 0; i < 10000; ++i) {
+	int len = 20 + 4 * (random() % 64);
+	fill(data, len);
+	uint16_t csum = click_in_cksum(data, len);
+	int off = 4 * (random() % (len / 4));
+	uint32_t old_w, new_w = random();
+	memcpy(&old_w, data + off, 4);
+	memcpy(data + off, &new_w, 4);
+	uint16_t expected = click_in_cksum(data, len);
+
+	uint16_t got = csum;
+	click_update_in_cksum32(&got, old_w, new_w);
+	if (!same_cksum(got, expected))
+	    error("update32", off, len, got, expected);
+
+	got = csum;
+	uint16_t old_hw[2], new_hw[2];
+	memcpy(old_hw, &old_w, 4);
+	memcpy(new_hw, &new_w, 4);
+	click_update_in_cksum(&got, old_hw[0], new_hw[0]);
+	click_update_in_cksum(&got, old_hw[1], new_hw[1]);
+	if (!same_cksum(got, expected))
+	    error("update", off, len, got, expected);
+
+	got = csum;
+	uint32_t delta = (~old_hw[0] & 0xFFFF) + new_hw[0]
+	    + (~old_hw[1] & 0xFFFF) + new_hw[1];
+	click_update_in_cksum_delta(&got, delta);
+	if (!same_cksum(got, expected))
+	    error("update_delta", off, len, got, expected);
+    }
+}
+
+void
+ChecksumBench::run_timer(Timer *)
+{
+    String original = click_in_cksum_kernel();
+    unsigned char *data = new unsigned char[check_length + 16];
+    fill(data, check_length + 16);
+
+    // check every loop this CPU runs
+    StringAccum sa;
+    for (int k = 0; k < nkernel_names; ++k)
+	if (click_in_cksum_set_kernel(kernel_names[k]) >= 0) {
+	    sa << (sa.length() ? " " : "") << kernel_names[k];
+	    check_kernel(kernel_names[k], data);
+	}
+    _kernels = sa.take_string();
+    click_in_cksum_set_kernel(original.c_str());
+    check_updates(data);
+    delete[] data;
+
+    // time the chosen loop
+    click_in_cksum_set_kernel(_kernel.c_str());
+    _rates.clear();
+    for (int *lp = _lengths.begin(); lp != _lengths.end(); ++lp) {
+	// cycle through enough buffers to leave the L1 cache
+	int len = *lp, nbuf = (len < 65536 ? (65536 + len - 1) / len : 1);
+	unsigned char *buf = new unsigned char[len * nbuf];
+	fill(buf, len * nbuf);
+	uint64_t n = _nbytes / len + 1;
+	uint32_t sum = 0;
+	Timestamp t0 = Timestamp::now();
+	for (uint64_t i = 0; i < n; ++i)
+	    sum += click_in_cksum(buf + (i % nbuf) * len, len);
+	double elapsed = (Timestamp::now() - t0).doubleval();
+	_rates.push_back(elapsed > 0 ? n * len / elapsed : 0);
+	if (sum == 0x7FFFFFFF)	// keep the compiler from dropping checksums
+	    click_chatter("%u", sum);
+	delete[] buf;
+    }
+    click_in_cksum_set_kernel(original.c_str());
+
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+String
+ChecksumBench::read_handler(Element *e, void *thunk)
+{
+    ChecksumBench *b = static_cast<ChecksumBench *>(e);
+    switch ((intptr_t) thunk) {
+    case 1:
+	return String(b->_errors);
+    case 2:
+	return b->_kernels;
+    default: {
+	StringAccum sa;
+	sa << "kernel " << b->_kernel << '\n';
+	for (int i = 0; i < b->_rates.size(); ++i)
+	    sa << "bytes_per_sec_" << b->_lengths[i] << ' '
+	       << (uint64_t) b->_rates[i] << '\n';
+	return sa.take_string();
+    }
+    }
+}
+
+void
+ChecksumBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("errors", read_handler, (void *) 1);
+    add_read_handler("kernels", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel)
+EXPORT_ELEMENT(ChecksumBench)
@@ -0,0 +1,119 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_CHECKSUMBENCH_HH
+#define CLICK_CHECKSUMBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+CLICK_DECLS
+
+/*
+=c
+
+ChecksumBench([I<keywords> LENGTHS, BYTES, KERNEL, SEED, STOP])
+
+=s test
+
+measures and checks Internet checksum speed
+
+=d
+
+ChecksumBench measures how fast click_in_cksum computes the Internet checksum
+of random data, and checks the checksum loops against a simple reference.  It
+runs once, just after the router is initialized.
+
+At user level on x86, click_in_cksum picks an SSE2 or AVX2 loop for long
+data, depending on what the CPU supports.  ChecksumBench first checks every
+loop this CPU can run against a byte-at-a-time reference, over all lengths up
+to 2048 bytes and at several alignments, and on long runs of 0xFF bytes up to
+64 kilobytes.  It also checks the incremental
+update functions click_update_in_cksum and click_update_in_cksum32 against
+checksums computed from scratch.  The C<errors> handler counts the
+differences.  ChecksumBench then times click_in_cksum on buffers of each
+length in LENGTHS.
+
+Keyword arguments are:
+
+=over 8
+
+=item LENGTHS
+
+Space-separated list of integers.  Buffer lengths to time.  Default is "20 64
+576 1500 9000".
+
+=item BYTES
+
+Integer.  Number of bytes to checksum for each length.  Default is 1000000000.
+
+=item KERNEL
+
+Word.  The checksum loop to time: "generic", "sse2", or "avx2".  It is an
+error if this CPU cannot run KERNEL.  Default is the loop click_in_cksum picks
+itself.
+
+=item SEED
+
+Integer.  Random seed.  Default is 1.
+
+=item STOP
+
+Boolean.  If true, stop the driver when done.  Default is false.
+
+=back
+
+=h results read-only
+
+Returns the checksum loop timed, and for each length, the number of bytes
+checksummed per second.
+
+=h errors read-only
+
+Returns the number of checksums that disagreed with the reference.
+
+=h kernels read-only
+
+Returns the checksum loops this CPU can run, and hence those checked.
+
+=e
+
+  b :: ChecksumBench(STOP true);
+
+Run with "click -h b.results".
+
+=a CheckIPHeader, SetIPChecksum, SetTCPChecksum */
+
+class ChecksumBench : public Element { public:
+
+    ChecksumBench();
+    ~ChecksumBench();
+
+    const char *class_name() const	{ return "ChecksumBench"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void add_handlers();
+
+    void run_timer(Timer *timer);
+
+  private:
+
+    Vector<int> _lengths;
+    uint64_t _nbytes;
+    String _kernel;
+    uint32_t _seed;
+    bool _stop;
+    Timer _timer;
+
+    String _kernels;
+    Vector<double> _rates;
+    uint32_t _errors;
+
+    inline uint32_t random();
+    void fill(unsigned char *data, int len);
+    void error(const char *kernel, int offset, int len, uint16_t got, uint16_t expected);
+    void check_kernel(const char *kernel, unsigned char *data);
+    void check_updates(unsigned char *data);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
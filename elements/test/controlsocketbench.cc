@@ -0,0 +1,429 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * controlsocketbench.{cc,hh} -- measure ControlSocket handler read rates
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "controlsocketbench.hh"
+#include "elements/userlevel/controlsocket.hh"
+#include <click/confparse.hh>
+#include <click/error.hh>
+#include <click/router.hh>
+#include <click/handler.hh>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+CLICK_DECLS
+
+ControlSocketBench::ControlSocketBench()
+    : _timer(this), _state(S_INIT), _fd(-1), _out_pos(0), _next_request(0),
+      _outstanding(0), _next_id(0), _expected_id(0), _reads(0), _errors(0),
+      _updates(0)
+{
+}
+
+ControlSocketBench::~ControlSocketBench()
+{
+}
+
+int
+ControlSocketBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    String handlers;
+    uint16_t port = 0;
+    _socket = 0;
+    _address = IPAddress(htonl(0x7F000001U));
+    _binary = _typed = true;
+    _stop = false;
+    _batch = _pipeline = 16;
+    _duration = Timestamp(1, 0);
+    _subscribe = Timestamp();
+    if (cp_va_kparse(conf, this, errh,
+		     "HANDLERS", cpkP+cpkM, cpString, &handlers,
+		     "PORT", 0, cpTCPPort, &port,
+		     "SOCKET", 0, cpElement, &_socket,
+		     "ADDRESS", 0, cpIPAddress, &_address,
+		     "BINARY", 0, cpBool, &_binary,
+		     "TYPED", 0, cpBool, &_typed,
+		     "BATCH", 0, cpInteger, &_batch,
+		     "PIPELINE", 0, cpInteger, &_pipeline,
+		     "SUBSCRIBE", 0, cpTimestamp, &_subscribe,
+		     "DURATION", 0, cpTimestamp, &_duration,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+    cp_spacevec(handlers, _handlers);
+    _port = port;
+    if (_handlers.size() == 0)
+	return errh->error("no HANDLERS");
+    if (!_port == !_socket)
+	return errh->error("specify exactly one of PORT and SOCKET");
+    if (_batch < 1 || _batch > 0xFFFF)
+	return errh->error("BATCH must be between 1 and 65535");
+    if (_pipeline < 1)
+	return errh->error("PIPELINE must be positive");
+    if (_subscribe && !_binary)
+	return errh->error("SUBSCRIBE requires BINARY");
+    return 0;
+}
+
+int
+ControlSocketBench::initialize(ErrorHandler *)
+{
+    make_requests();
+    // Start from the timer, after SOCKET has opened its port.
+    _timer.initialize(this);
+    _timer.schedule_now();
+    return 0;
+}
+
+void
+ControlSocketBench::cleanup(CleanupStage)
+{
+    if (_fd >= 0) {
+	remove_select(_fd, SELECT_READ | SELECT_WRITE);
+	close(_fd);
+	_fd = -1;
+    }
+}
+
+static inline void
+store_uint32(char *s, uint32_t x)
+{
+    x = htonl(x);
+    memcpy(s, &x, 4);
+}
+
+static inline uint16_t
+extract_uint16(const char *s)
+{
+    uint16_t x;
+    memcpy(&x, s, 2);
+    return ntohs(x);
+}
+
+static inline uint32_t
+extract_uint32(const char *s)
+{
+    uint32_t x;
+    memcpy(&x, s, 4);
+    return ntohl(x);
+}
+
+void
+ControlSocketBench::make_requests()
+{
+    // Request I reads handlers starting with handler I.  Binary requests'
+    // IDs are filled in as they are sent.
+    int n = _handlers.size();
+    if (_subscribe) {
+	// one request subscribing to every handler
+	StringAccum sa;
+	char *h = sa.extend(ControlSocket::BINARY_HEADER_LEN);
+	h[8] = 0;
+	h[9] = ControlSocket::BINARY_SUBSCRIBE;
+	h[10] = 0;
+	h[11] = (_typed ? ControlSocket::BINARY_FLAG_TYPED : 0);
+	String interval = _subscribe.unparse();
+	char *s = sa.extend(4 + interval.length());
+	store_uint32(s, interval.length());
+	memcpy(s + 4, interval.data(), interval.length());
+	for (int j = 0; j < n; ++j) {
+	    s = sa.extend(4 + _handlers[j].length());
+	    store_uint32(s, _handlers[j].length());
+	    memcpy(s + 4, _handlers[j].data(), _handlers[j].length());
+	}
+	store_uint32(sa.data(), sa.length() - 4);
+	_requests.push_back(sa.take_string());
+	return;
+    }
+    for (int i = 0; i < n; ++i)
+	if (_binary) {
+	    StringAccum sa;
+	    char *h = sa.extend(ControlSocket::BINARY_HEADER_LEN);
+	    h[8] = 0;
+	    h[9] = ControlSocket::BINARY_READMANY;
+	    h[10] = 0;
+	    h[11] = (_typed ? ControlSocket::BINARY_FLAG_TYPED : 0);
+	    for (int j = 0; j < _batch; ++j) {
+		const String &name = _handlers[(i + j) % n];
+		char *s = sa.extend(4 + name.length());
+		store_uint32(s, name.length());
+		memcpy(s + 4, name.data(), name.length());
+	    }
+	    store_uint32(sa.data(), sa.length() - 4);
+	    _requests.push_back(sa.take_string());
+	} else
+	    _requests.push_back("READ " + _handlers[i] + "\r\n");
+}
+
+int
+ControlSocketBench::start(ErrorHandler *errh)
+{
+    if (_socket) {
+	const Handler *h = Router::handler(_socket, "port");
+	int port;
+	if (!h || !h->read_visible()
+	    || !cp_integer(h->call_read(_socket), &port)
+	    || port <= 0 || port > 65535)
+	    return errh->error("SOCKET %<%s%> has no TCP port", _socket->name().c_str());
+	_port = port;
+    }
+
+    _fd = socket(PF_INET, SOCK_STREAM, 0);
+    if (_fd < 0)
+	return errh->error("socket: %s", strerror(errno));
+    fcntl(_fd, F_SETFL, O_NONBLOCK);
+    fcntl(_fd, F_SETFD, FD_CLOEXEC);
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(_port);
+    sa.sin_addr = _address.in_addr();
+    if (connect(_fd, (struct sockaddr *) &sa, sizeof(sa)) < 0
+	&& errno != EINPROGRESS)
+	return errh->error("connect: %s", strerror(errno));
+
+    add_select(_fd, SELECT_READ);
+    _state = S_GREETING;
+    _start = Timestamp::now();
+    _timer.schedule_at(_start + _duration);
+    return 0;
+}
+
+void
+ControlSocketBench::finish()
+{
+    if (_state == S_DONE)
+	return;
+    _end = Timestamp::now();
+    if (!_start)
+	_start = _end;
+    _state = S_DONE;
+    _timer.unschedule();
+    cleanup(CLEANUP_ROUTER_INITIALIZED);
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+bool
+ControlSocketBench::parse_line(String &line)
+{
+    const char *nl = find(_in, '\n');
+    if (nl == _in.end())
+	return false;
+    const char *end = nl;
+    if (end != _in.begin() && end[-1] == '\r')
+	--end;
+    line = _in.substring(_in.begin(), end);
+    _in = _in.substring(nl + 1, _in.end());
+    return true;
+}
+
+int
+ControlSocketBench::parse_text_response()
+{
+    // Message lines, then, for a successful read, "DATA n" and n bytes.
+    // Consume nothing until the whole response has arrived.
+    const char *s = _in.begin(), *end = _in.end();
+    int code;
+    while (1) {
+	const char *nl = reinterpret_cast<const char *>(memchr(s, '\n', end - s));
+	if (!nl)
+	    return 0;
+	if (nl - s < 4 || !cp_integer(String(s, 3), &code))
+	    return -1;
+	bool more = (s[3] == '-');
+	s = nl + 1;
+	if (!more)
+	    break;
+    }
+    if (code == ControlSocket::CSERR_OK) {
+	const char *nl = reinterpret_cast<const char *>(memchr(s, '\n', end - s));
+	if (!nl)
+	    return 0;
+	int len;
+	if (nl - s < 6 || memcmp(s, "DATA ", 5) != 0
+	    || cp_integer(s + 5, nl, 10, &len) == s + 5 || len < 0)
+	    return -1;
+	s = nl + 1;
+	if (end - s < len)
+	    return 0;
+	s += len;
+	_reads++;
+    } else
+	_errors++;
+    _in = _in.substring(s, end);
+    _outstanding--;
+    return 1;
+}
+
+int
+ControlSocketBench::parse_binary_response()
+{
+    if (_in.length() < 4)
+	return 0;
+    uint32_t len = extract_uint32(_in.data());
+    if (len < ControlSocket::BINARY_HEADER_LEN - 4)
+	return -1;
+    if ((uint32_t) _in.length() - 4 < len)
+	return 0;
+    const char *s = _in.data() + 4, *end = s + len;
+    bool update = (extract_uint16(s + 4) == ControlSocket::BINARY_UPDATE);
+    if (update ? extract_uint32(s) != 0 : extract_uint32(s) != _expected_id)
+	return -1;
+    int n = extract_uint16(s + 6);
+    for (s += 8; n > 0; --n) {
+	if (end - s < ControlSocket::BINARY_RECORD_HEADER_LEN)
+	    return -1;
+	int code = extract_uint16(s);
+	int type = extract_uint16(s + 2);
+	uint32_t rlen = extract_uint32(s + 4);
+	s += ControlSocket::BINARY_RECORD_HEADER_LEN;
+	if (rlen > (uint32_t) (end - s))
+	    return -1;
+	if (update && type == ControlSocket::BINARY_TYPE_INDEX)
+	    /* index of the next record's handler */;
+	else if (code == ControlSocket::CSERR_OK)
+	    _reads++;
+	else
+	    _errors++;
+	s += rlen;
+    }
+    _in = _in.substring(end, _in.end());
+    if (update)
+	_updates++;
+    else {
+	_expected_id++;
+	_outstanding--;
+    }
+    return 1;
+}
+
+void
+ControlSocketBench::selected(int, int mask)
+{
+    if (mask & SELECT_READ) {
+	char buf[16384];
+	int r = read(_fd, buf, sizeof(buf));
+	if (r > 0)
+	    _in.append(buf, r);
+	else if (r == 0 || (errno != EAGAIN && errno != EINTR)) {
+	    click_chatter("%{element}: connection closed", this);
+	    return finish();
+	}
+    }
+
+    while (1) {
+	int r;
+	if (_state == S_GREETING || _state == S_SWITCHING) {
+	    String line;
+	    if (!parse_line(line))
+		break;
+	    if (_state == S_GREETING && line.starts_with("Click::ControlSocket/")) {
+		if (_binary)
+		    _out << "BINARY\r\n";
+		_state = (_binary ? S_SWITCHING : S_RUNNING);
+		continue;
+	    } else if (_state == S_SWITCHING && line.starts_with("200 ")) {
+		_state = S_RUNNING;
+		continue;
+	    }
+	    r = -1;
+	} else if (_state == S_RUNNING)
+	    r = (_binary ? parse_binary_response() : parse_text_response());
+	else
+	    break;
+	if (r < 0) {
+	    click_chatter("%{element}: protocol error", this);
+	    return finish();
+	} else if (r == 0)
+	    break;
+    }
+
+    if (_state == S_RUNNING)
+	while (_outstanding < _pipeline && !(_subscribe && _next_id)) {
+	    const String &req = _requests[_next_request];
+	    char *s = _out.extend(req.length());
+	    memcpy(s, req.data(), req.length());
+	    if (_binary)
+		store_uint32(s + 4, _next_id++);
+	    _next_request = (_next_request + (_binary ? _batch : 1)) % _requests.size();
+	    _outstanding++;
+	}
+
+    if (_out_pos < _out.length()) {
+	int w = write(_fd, _out.data() + _out_pos, _out.length() - _out_pos);
+	if (w > 0)
+	    _out_pos += w;
+	else if (w < 0 && errno != EAGAIN && errno != EINTR) {
+	    click_chatter("%{element}: write: %s", this, strerror(errno));
+	    return finish();
+	}
+	if (_out_pos == _out.length()) {
+	    _out.clear();
+	    _out_pos = 0;
+	}
+    }
+    if (_out_pos < _out.length())
+	add_select(_fd, SELECT_WRITE);
+    else
+	remove_select(_fd, SELECT_WRITE);
+}
+
+void
+ControlSocketBench::run_timer(Timer *)
+{
+    if (_state == S_INIT && start(ErrorHandler::default_handler()) >= 0)
+	return;
+    finish();
+}
+
+String
+ControlSocketBench::read_handler(Element *e, void *thunk)
+{
+    ControlSocketBench *csb = static_cast<ControlSocketBench *>(e);
+    switch ((uintptr_t) thunk) {
+      case H_READS:
+	return String(csb->_reads);
+      case H_ERRORS:
+	return String(csb->_errors);
+      case H_RATE: {
+	  Timestamp elapsed = (csb->_end ? csb->_end : Timestamp::now()) - csb->_start;
+	  if (!csb->_start || elapsed.doubleval() <= 0)
+	      return String(0);
+	  return String((uint64_t) (csb->_reads / elapsed.doubleval()));
+      }
+      case H_UPDATES:
+	return String(csb->_updates);
+      case H_DONE:
+	return cp_unparse_bool(csb->_state == S_DONE);
+      default:
+	return "<error>";
+    }
+}
+
+void
+ControlSocketBench::add_handlers()
+{
+    add_read_handler("reads", read_handler, (void *) H_READS);
+    add_read_handler("errors", read_handler, (void *) H_ERRORS);
+    add_read_handler("rate", read_handler, (void *) H_RATE);
+    add_read_handler("updates", read_handler, (void *) H_UPDATES);
+    add_read_handler("done", read_handler, (void *) H_DONE);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel ControlSocket)
+EXPORT_ELEMENT(ControlSocketBench)
@@ -0,0 +1,186 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_CONTROLSOCKETBENCH_HH
+#define CLICK_CONTROLSOCKETBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+#include <click/ipaddress.hh>
+#include <click/straccum.hh>
+CLICK_DECLS
+
+/*
+=c
+
+ControlSocketBench(HANDLERS, [I<keywords> PORT, SOCKET, ADDRESS, BINARY, TYPED, BATCH, PIPELINE, SUBSCRIBE, DURATION, STOP])
+
+=s test
+
+measures ControlSocket handler read throughput
+
+=d
+
+ControlSocketBench connects to a TCP ControlSocket and reads handlers from
+it as fast as it can for DURATION, then reports the number of handler reads
+per second.  HANDLERS is a space-separated list of handler names, such as
+"c1.count c2.count"; ControlSocketBench reads them in rotation.
+
+In binary mode, the default, ControlSocketBench switches the connection to
+ControlSocket's binary protocol and sends READMANY requests, each reading
+BATCH handlers.  Otherwise it sends text READ commands, one handler each.  In
+either mode, up to PIPELINE requests are outstanding at a time.
+
+With SUBSCRIBE, ControlSocketBench instead subscribes once to all HANDLERS,
+and counts the values ControlSocket sends.
+
+For accurate numbers, run ControlSocketBench in a different process than
+the router being measured.
+
+Keyword arguments are:
+
+=over 8
+
+=item PORT
+
+TCP port number of the ControlSocket.
+
+=item SOCKET
+
+Element name.  A TCP ControlSocket in this router; ControlSocketBench
+connects to its port.  Either PORT or SOCKET must be given.
+
+=item ADDRESS
+
+IP address of the ControlSocket.  Default is 127.0.0.1.
+
+=item BINARY
+
+Boolean.  If true, use the binary protocol.  Default is true.
+
+=item TYPED
+
+Boolean.  If true, ask for integer handler values in binary form.  Only
+meaningful in binary mode.  Default is true.
+
+=item BATCH
+
+Integer.  Handlers read per binary request.  Default is 16.
+
+=item PIPELINE
+
+Integer.  Maximum number of outstanding requests.  Default is 16.
+
+=item SUBSCRIBE
+
+Time.  If set, subscribe to HANDLERS with this interval rather than reading
+them.  Requires BINARY.
+
+=item DURATION
+
+Time.  How long to send requests.  Default is 1 second.
+
+=item STOP
+
+Boolean.  If true, stop the driver after DURATION.  Default is false.
+
+=back
+
+ControlSocketBench is only available at user level.
+
+=h reads read-only
+
+Returns the number of successful handler reads, or, with SUBSCRIBE, the
+number of handler values received.
+
+=h errors read-only
+
+Returns the number of failed handler reads.
+
+=h rate read-only
+
+Returns the number of successful handler reads per second.
+
+=h updates read-only
+
+Returns the number of subscription updates received.
+
+=h done read-only
+
+Returns true iff the benchmark has finished.
+
+=e
+
+In the router being measured:
+
+  ControlSocket(TCP, 41900);
+
+In another process:
+
+  csb :: ControlSocketBench("c1.count c2.count", PORT 41900,
+                            BATCH 64, DURATION 5s, STOP true);
+
+Run the second with "click -h csb.rate", and compare the rate with BINARY
+false.
+
+=a ControlSocket */
+
+class ControlSocketBench : public Element { public:
+
+    ControlSocketBench();
+    ~ControlSocketBench();
+
+    const char *class_name() const	{ return "ControlSocketBench"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void selected(int fd, int mask);
+    void run_timer(Timer *timer);
+
+  private:
+
+    Vector<String> _handlers;
+    Element *_socket;
+    IPAddress _address;
+    uint16_t _port;
+    bool _binary;
+    bool _typed;
+    bool _stop;
+    int _batch;
+    int _pipeline;
+    Timestamp _subscribe;
+    Timestamp _duration;
+    Timer _timer;
+
+    enum { S_INIT, S_GREETING, S_SWITCHING, S_RUNNING, S_DONE };
+    int _state;
+    int _fd;
+    String _in;
+    StringAccum _out;
+    int _out_pos;
+    Vector<String> _requests;
+    int _next_request;
+    int _outstanding;
+    uint32_t _next_id;
+    uint32_t _expected_id;
+
+    uint64_t _reads;
+    uint64_t _errors;
+    uint64_t _updates;
+    Timestamp _start;
+    Timestamp _end;
+
+    int start(ErrorHandler *errh);
+    void finish();
+    void make_requests();
+    bool parse_line(String &line);
+    int parse_text_response();
+    int parse_binary_response();
+
+    enum { H_READS, H_ERRORS, H_RATE, H_UPDATES, H_DONE };
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
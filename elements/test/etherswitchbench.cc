@@ -0,0 +1,164 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * etherswitchbench.{cc,hh} -- generate Ethernet address mixes
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "etherswitchbench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/error.hh>
+#include <clicknet/ether.h>
+CLICK_DECLS
+
+EtherSwitchBench::EtherSwitchBench()
+    : _sent(0), _unicast(0), _delivered(0), _errors(0)
+{
+}
+
+EtherSwitchBench::~EtherSwitchBench()
+{
+}
+
+int
+EtherSwitchBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _naddresses = 1024;
+    _broadcast = 0;
+    _seed = 1;
+    if (cp_va_kparse(conf, this, errh,
+		     "ADDRESSES", 0, cpUnsigned, &_naddresses,
+		     "BROADCAST", 0, cpUnsigned, &_broadcast,
+		     "SEED", 0, cpUnsigned, &_seed,
+		     cpEnd) < 0)
+	return -1;
+    if (noutputs() < 2 || ninputs() != noutputs() + 1)
+	return errh->error("need N+1 inputs and N outputs, N >= 2");
+    if (_naddresses < (uint32_t) noutputs() || _naddresses > 0x1000000)
+	return errh->error("ADDRESSES must be between %d and 16777216", noutputs());
+    if (_broadcast > 100)
+	return errh->error("BROADCAST must be between 0 and 100");
+    if (_seed == 0)
+	_seed = 1;
+    return 0;
+}
+
+inline uint32_t
+EtherSwitchBench::random()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+inline void
+EtherSwitchBench::store_address(unsigned char *a, uint32_t station)
+{
+    a[0] = 2;
+    a[1] = a[2] = 0;
+    a[3] = station >> 16;
+    a[4] = station >> 8;
+    a[5] = station;
+}
+
+static inline uint32_t
+station(const unsigned char *a)
+{
+    return (a[3] << 16) | (a[4] << 8) | a[5];
+}
+
+void
+EtherSwitchBench::check(int port, Packet *p)
+{
+    const click_ether *e = reinterpret_cast<const click_ether *>(p->data());
+    uint32_t n = noutputs();
+    if (station(e->ether_shost) % n == (uint32_t) port)
+	_errors++;
+    else if (!(e->ether_dhost[0] & 1)
+	     && station(e->ether_dhost) % n == (uint32_t) port)
+	_delivered++;
+    p->kill();
+}
+
+void
+EtherSwitchBench::push(int port, Packet *p)
+{
+    if (port > 0) {
+	check(port - 1, p);
+	return;
+    }
+
+    WritablePacket *q = p->uniqueify();
+    if (!q || q->length() < sizeof(click_ether)) {
+	if (q)
+	    q->kill();
+	return;
+    }
+    click_ether *e = reinterpret_cast<click_ether *>(q->data());
+    uint32_t n = noutputs();
+    uint32_t src = random() % _naddresses;
+    store_address(e->ether_shost, src);
+    if (random() % 100 < _broadcast)
+	memset(e->ether_dhost, 0xFF, 6);
+    else {
+	uint32_t dst;
+	do {
+	    dst = random() % _naddresses;
+	} while (dst % n == src % n);
+	store_address(e->ether_dhost, dst);
+	_unicast++;
+    }
+
+    Timestamp now = Timestamp::now();
+    if (!_sent)
+	_first = now;
+    _last = now;
+    _sent++;
+    output(src % n).push(q);
+}
+
+String
+EtherSwitchBench::read_handler(Element *e, void *thunk)
+{
+    EtherSwitchBench *b = static_cast<EtherSwitchBench *>(e);
+    StringAccum sa;
+    switch ((intptr_t) thunk) {
+    case 0: {
+	double elapsed = (b->_last - b->_first).doubleval();
+	sa << "packets " << b->_sent << '\n'
+	   << "packets_per_sec " << (uint64_t) (elapsed > 0 ? (b->_sent - 1) / elapsed : 0) << '\n';
+	break;
+    }
+    case 1:
+	sa << "unicast " << b->_unicast << '\n'
+	   << "delivered " << b->_delivered << '\n';
+	break;
+    default:
+	sa << b->_errors;
+	break;
+    }
+    return sa.take_string();
+}
+
+void
+EtherSwitchBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("delivered", read_handler, (void *) 1);
+    add_read_handler("errors", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+EXPORT_ELEMENT(EtherSwitchBench)
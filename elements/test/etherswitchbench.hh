@@ -0,0 +1,112 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_ETHERSWITCHBENCH_HH
+#define CLICK_ETHERSWITCHBENCH_HH
+#include <click/element.hh>
+#include <click/timestamp.hh>
+CLICK_DECLS
+
+/*
+=c
+
+EtherSwitchBench([I<keywords> ADDRESSES, BROADCAST, SEED])
+
+=s test
+
+generates Ethernet address mixes for switch benchmarks
+
+=d
+
+EtherSwitchBench turns a stream of packets, such as those from InfiniteSource,
+into traffic among ADDRESSES Ethernet stations, and checks how an Ethernet
+switch such as EtherSwitch delivers it.
+
+Station I has address 02:00:00:XX:XX:XX, where XX:XX:XX is I, and lives on
+port I mod N, where N is the number of switch ports.  Each packet arriving on
+input 0 is rewritten to come from a random station, and to go to a random
+station on another port, or, with probability BROADCAST percent, to the
+broadcast address.  It is emitted on its source station's port: output I
+should be connected to the switch's input I.
+
+EtherSwitchBench has N+1 inputs; connect the switch's output I to input I+1.
+Every unicast packet should arrive exactly once at its destination station's
+port, whether forwarded or flooded, and no packet should return to its source
+station's port.
+
+Keyword arguments are:
+
+=over 8
+
+=item ADDRESSES
+
+Integer.  Number of stations.  Default is 1024.
+
+=item BROADCAST
+
+Integer between 0 and 100.  Percentage of broadcast packets.  Default is 0.
+
+=item SEED
+
+Integer.  Random seed.  Default is 1.
+
+=back
+
+=h results read-only
+
+Returns the number of packets sent, and the number sent per second between
+the first and last.
+
+=h delivered read-only
+
+Returns the number of unicast packets sent, and the number that arrived at
+their destination station's port.
+
+=h errors read-only
+
+Returns the number of packets that returned to their source station's port.
+
+=e
+
+  InfiniteSource(LENGTH 64, LIMIT 1000000, STOP true)
+    -> b :: EtherSwitchBench(ADDRESSES 100000, BROADCAST 1);
+  b[0] -> [0]sw :: EtherSwitch(CAPACITY 100000);
+  b[1] -> [1]sw;  sw[0] -> [1]b;  sw[1] -> [2]b;
+
+=a EtherSwitch */
+
+class EtherSwitchBench : public Element { public:
+
+    EtherSwitchBench();
+    ~EtherSwitchBench();
+
+    const char *class_name() const	{ return "EtherSwitchBench"; }
+    const char *port_count() const	{ return "2-/1-"; }
+    const char *processing() const	{ return PUSH; }
+    const char *flow_code() const	{ return "xy/x"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+
+  private:
+
+    uint32_t _naddresses;
+    uint32_t _broadcast;
+    uint32_t _seed;
+
+    uint64_t _sent;
+    uint64_t _unicast;
+    uint64_t _delivered;
+    uint64_t _errors;
+    Timestamp _first;
+    Timestamp _last;
+
+    inline uint32_t random();
+    static inline void store_address(unsigned char *a, uint32_t station);
+    void check(int port, Packet *p);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,295 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * flowhashtabletest.{cc,hh} -- regression test element for FlowHashTable<K, V>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "flowhashtabletest.hh"
+#include <click/flowhashtable.hh>
+#include <click/hashtable.hh>
+#include <click/hashcontainer.hh>
+#include <click/ipflowid.hh>
+#include <click/confparse.hh>
+#include <click/error.hh>
+CLICK_DECLS
+
+FlowHashTableTest::FlowHashTableTest()
+{
+}
+
+FlowHashTableTest::~FlowHashTableTest()
+{
+}
+
+int
+FlowHashTableTest::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _nflows = 0;
+    _nlookups = 10000000;
+    return cp_va_kparse(conf, this, errh,
+			"FLOWS", 0, cpUnsigned, &_nflows,
+			"LOOKUPS", 0, cpUnsigned, &_nlookups,
+			cpEnd);
+}
+
+#define CHECK(x) if (!(x)) return errh->error("%s:%d: test `%s' failed", __FILE__, __LINE__, #x);
+
+static IPFlowID
+make_flowid(uint32_t k)
+{
+    return IPFlowID(IPAddress(htonl(0x0A000000 + (k >> 4))), htons(1024 + (k & 15)),
+		    IPAddress(htonl(0xC0000201)), htons(80));
+}
+
+namespace {
+// A key whose hash codes collide in groups of 64, forcing long probes.
+struct BadKey {
+    uint32_t x;
+    BadKey(uint32_t xx) : x(xx) { }
+    hashcode_t hashcode() const { return x / 64; }
+};
+inline bool operator==(const BadKey &a, const BadKey &b) {
+    return a.x == b.x;
+}
+}
+
+template <typename T>
+static int
+compare_tables(const FlowHashTable<IPFlowID, T> &ft, const HashTable<IPFlowID, T> &ht,
+	       ErrorHandler *errh)
+{
+    CHECK(ft.size() == ht.size());
+    size_t n = 0;
+    for (typename FlowHashTable<IPFlowID, T>::const_iterator it = ft.begin(); it; ++it, ++n) {
+	typename HashTable<IPFlowID, T>::const_iterator hit = ht.find(it.key());
+	CHECK(hit.live() && hit.value() == it.value());
+    }
+    CHECK(n == ft.size());
+    for (typename HashTable<IPFlowID, T>::const_iterator it = ht.begin(); it; ++it)
+	CHECK(ft.get(it.key()) == it.value());
+    return 0;
+}
+
+int
+FlowHashTableTest::initialize(ErrorHandler *errh)
+{
+    {
+	FlowHashTable<IPFlowID, int> t;
+	CHECK(t.empty());
+	CHECK(t.set(make_flowid(1), 1));
+	CHECK(t.set(make_flowid(2), 2));
+	CHECK(!t.set(make_flowid(2), 20));
+	t[make_flowid(3)] = 3;
+	CHECK(t.size() == 3);
+	CHECK(t.get(make_flowid(1)) == 1);
+	CHECK(t.get(make_flowid(2)) == 20);
+	CHECK(t[make_flowid(3)] == 3);
+	CHECK(t.get(make_flowid(4)) == 0);
+	CHECK(!t.get_pointer(make_flowid(4)));
+	CHECK(t.find(make_flowid(4)) == t.end());
+	CHECK(t.size() == 3);
+	CHECK(t.erase(make_flowid(1)) == 1);
+	CHECK(t.erase(make_flowid(1)) == 0);
+	CHECK(t.size() == 2);
+	CHECK(t.find_insert(make_flowid(2), 5).value() == 20);
+	for (FlowHashTable<IPFlowID, int>::iterator it = t.begin(); it; )
+	    if (it.value() == 20)
+		it = t.erase(it);
+	    else {
+		it.value() = 30;
+		++it;
+	    }
+	CHECK(t.size() == 1);
+	CHECK(t.get(make_flowid(3)) == 30);
+	t.clear();
+	CHECK(t.empty() && !t.begin().live());
+    }
+
+    // Compare random operations with HashTable.  The key range is small
+    // enough that erases and reinserts leave many deleted slots.
+    {
+	FlowHashTable<IPFlowID, int> ft;
+	HashTable<IPFlowID, int> ht;
+	uint32_t seed = 1;
+	for (int round = 0; round < 4; ++round) {
+	    for (int i = 0; i < 50000; ++i) {
+		seed = seed * 1664525 + 1013904223;
+		uint32_t k = (seed >> 8) % (5000 << round);
+		if ((seed & 3) == 0) {
+		    CHECK(ft.erase(make_flowid(k)) == ht.erase(make_flowid(k)));
+		} else {
+		    CHECK(ft.set(make_flowid(k), i) == ht.set(make_flowid(k), i));
+		}
+	    }
+	    if (compare_tables(ft, ht, errh) < 0)
+		return -1;
+	}
+	for (FlowHashTable<IPFlowID, int>::iterator it = ft.begin(); it; )
+	    if (it.value() & 1) {
+		ht.erase(it.key());
+		it = ft.erase(it);
+	    } else
+		++it;
+	if (compare_tables(ft, ht, errh) < 0)
+	    return -1;
+    }
+
+    // Values with constructors and destructors.
+    {
+	FlowHashTable<IPFlowID, String> t;
+	for (uint32_t k = 0; k < 3000; ++k)
+	    t.set(make_flowid(k), String(k));
+	for (uint32_t k = 0; k < 3000; k += 2)
+	    t.erase(make_flowid(k));
+	CHECK(t.size() == 1500);
+	for (uint32_t k = 0; k < 3000; ++k)
+	    CHECK(t.get(make_flowid(k)) == (k & 1 ? String(k) : String()));
+    }
+
+    // Colliding hash codes.
+    {
+	FlowHashTable<BadKey, uint32_t> t;
+	for (uint32_t k = 0; k < 2000; ++k)
+	    t.set(BadKey(k), k + 1);
+	for (uint32_t k = 0; k < 2000; k += 3)
+	    t.erase(BadKey(k));
+	for (uint32_t k = 2000; k < 2500; ++k)
+	    t.set(BadKey(k), k + 1);
+	for (uint32_t k = 0; k < 2500; ++k)
+	    CHECK(t.get(BadKey(k)) == (k < 2000 && k % 3 == 0 ? 0 : k + 1));
+    }
+
+    if (_nflows && benchmark(errh) < 0)
+	return -1;
+
+    errh->message("All tests pass!");
+    return 0;
+}
+
+namespace {
+struct BenchEntry {
+    typedef IPFlowID key_type;
+    typedef const IPFlowID &key_const_reference;
+    IPFlowID _flowid;
+    BenchEntry *_hashnext;
+    uint32_t _data;
+    const IPFlowID &hashkey() const {
+	return _flowid;
+    }
+};
+}
+
+static void
+bench_report(ErrorHandler *errh, const char *name, double bytes, uint32_t n,
+	     const Timestamp &elapsed)
+{
+    double rate = elapsed.doubleval() > 0 ? n / elapsed.doubleval() : 0;
+    errh->message("%s: %.1f bytes/flow, %.0f lookups/s", name, bytes, rate);
+}
+
+int
+FlowHashTableTest::benchmark(ErrorHandler *errh)
+{
+    enum { batch = 32 };
+    BenchEntry *entries = new BenchEntry[_nflows];
+    for (uint32_t i = 0; i < _nflows; ++i) {
+	uint32_t a = click_random() ^ (click_random() << 16);
+	uint32_t b = click_random() ^ (click_random() << 16);
+	entries[i]._flowid = IPFlowID(IPAddress(a), b, IPAddress(htonl(0xC0000201)), i);
+	entries[i]._data = i;
+    }
+    // Look up the flows in a scattered order.  Keys come from a sequential
+    // array, as they would from packet headers; 2654435761 is prime.
+    IPFlowID *keys = new IPFlowID[_nflows];
+    for (uint32_t i = 0, j = 0; i < _nflows; ++i, j = (j + 2654435761U) % _nflows)
+	keys[i] = entries[j]._flowid;
+    uint32_t sum, found;
+    Timestamp t0;
+
+    {
+	HashContainer<BenchEntry> hc;
+	for (uint32_t i = 0; i < _nflows; ++i) {
+	    hc.set(&entries[i]);
+	    if (hc.unbalanced())
+		hc.rehash(hc.bucket_count() + 1);
+	}
+	sum = found = 0;
+	t0 = Timestamp::now();
+	for (uint32_t i = 0, j = 0; i < _nlookups; ++i, j = (j + 1 == _nflows ? 0 : j + 1))
+	    if (BenchEntry *e = hc.get(keys[j])) {
+		sum += e->_data;
+		++found;
+	    }
+	CHECK(found == _nlookups);
+	bench_report(errh, "HashContainer", (hc.bucket_count() + hc.size()) * sizeof(void *) / (double) _nflows, _nlookups, Timestamp::now() - t0);
+    }
+
+    {
+	HashTable<IPFlowID, BenchEntry *> ht;
+	for (uint32_t i = 0; i < _nflows; ++i)
+	    ht.set(entries[i]._flowid, &entries[i]);
+	sum = found = 0;
+	t0 = Timestamp::now();
+	for (uint32_t i = 0, j = 0; i < _nlookups; ++i, j = (j + 1 == _nflows ? 0 : j + 1))
+	    if (BenchEntry *e = ht.get(keys[j])) {
+		sum += e->_data;
+		++found;
+	    }
+	CHECK(found == _nlookups);
+	// Each element holds a key, a value, and a chain pointer.
+	size_t elt_size = (sizeof(IPFlowID) + 2 * sizeof(void *) + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+	bench_report(errh, "HashTable", (ht.bucket_count() * sizeof(void *) + ht.size() * elt_size) / (double) _nflows, _nlookups, Timestamp::now() - t0);
+    }
+
+    {
+	FlowHashTable<IPFlowID, BenchEntry *> ft;
+	for (uint32_t i = 0; i < _nflows; ++i)
+	    ft.set(entries[i]._flowid, &entries[i]);
+	double bytes = ft.memory_size() / (double) _nflows;
+
+	sum = found = 0;
+	t0 = Timestamp::now();
+	for (uint32_t i = 0, j = 0; i < _nlookups; ++i, j = (j + 1 == _nflows ? 0 : j + 1))
+	    if (BenchEntry *e = ft.get(keys[j])) {
+		sum += e->_data;
+		++found;
+	    }
+	CHECK(found == _nlookups);
+	bench_report(errh, "FlowHashTable", bytes, _nlookups, Timestamp::now() - t0);
+
+	sum = found = 0;
+	t0 = Timestamp::now();
+	for (uint32_t i = 0, j = 0, n; i < _nlookups; i += n) {
+	    n = _nlookups - i < batch ? _nlookups - i : batch;
+	    if (n > _nflows - j)
+		n = _nflows - j;
+	    for (uint32_t k = 0; k < n; ++k)
+		ft.prefetch(keys[j + k]);
+	    for (uint32_t k = 0; k < n; ++k)
+		if (BenchEntry *e = ft.get(keys[j + k])) {
+		    sum += e->_data;
+		    ++found;
+		}
+	    j = (j + n == _nflows ? 0 : j + n);
+	}
+	CHECK(found == _nlookups);
+	bench_report(errh, "FlowHashTable+prefetch", bytes, _nlookups, Timestamp::now() - t0);
+    }
+
+    delete[] keys;
+    delete[] entries;
+    return 0;
+}
+
+CLICK_ENDDECLS
+EXPORT_ELEMENT(FlowHashTableTest)
@@ -0,0 +1,66 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_FLOWHASHTABLETEST_HH
+#define CLICK_FLOWHASHTABLETEST_HH
+#include <click/element.hh>
+CLICK_DECLS
+
+/*
+=c
+
+FlowHashTableTest([I<keywords> FLOWS, LOOKUPS])
+
+=s test
+
+runs regression tests for FlowHashTable<K, V>
+
+=d
+
+FlowHashTableTest runs FlowHashTable regression tests at initialization time. It
+does not route packets.
+
+If FLOWS is nonzero, FlowHashTableTest also compares FlowHashTable with the chained
+hash tables it replaces.  It fills each table with FLOWS random IPFlowID
+keys, then performs LOOKUPS lookups of those keys in scattered order, and
+reports each table's memory per flow and lookup rate.  FlowHashTable is timed
+both with and without prefetch() over batches of 32 keys.  The chained
+tables are HashContainer, which IPRewriter used, and HashTable, which
+AggregateIPFlows used.
+
+Keyword arguments are:
+
+=over 8
+
+=item FLOWS
+
+Integer.  Number of flows in the comparison.  Default is 0, which skips the
+comparison.
+
+=item LOOKUPS
+
+Integer.  Number of lookups per table.  Default is 10000000.
+
+=back
+
+=a HashTableTest */
+
+class FlowHashTableTest : public Element { public:
+
+    FlowHashTableTest();
+    ~FlowHashTableTest();
+
+    const char *class_name() const		{ return "FlowHashTableTest"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+
+  private:
+
+    uint32_t _nflows;
+    uint32_t _nlookups;
+
+    int benchmark(ErrorHandler *errh);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,246 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * ipreassemblerbench.{cc,hh} -- benchmark IP reassembly
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "ipreassemblerbench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+#include <clicknet/ip.h>
+CLICK_DECLS
+
+static const uint32_t flood_source = 0xC0000201U;	// 192.0.2.1
+
+IPReassemblerBench::IPReassemblerBench()
+    : _timer(this), _completed(0), _errors(0), _fragment_rate(0),
+      _packet_rate(0)
+{
+}
+
+IPReassemblerBench::~IPReassemblerBench()
+{
+}
+
+int
+IPReassemblerBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _count = 1000000;
+    _length = 1480;
+    _fragment = 576;
+    _nsources = 16;
+    _concurrent = 16;
+    _flood = 0;
+    _rate = 1000000;
+    _seed = 1;
+    _stop = false;
+    if (cp_va_kparse(conf, this, errh,
+		     "COUNT", 0, cpUnsigned, &_count,
+		     "LENGTH", 0, cpInteger, &_length,
+		     "FRAGMENT", 0, cpInteger, &_fragment,
+		     "SOURCES", 0, cpInteger, &_nsources,
+		     "CONCURRENT", 0, cpInteger, &_concurrent,
+		     "FLOOD", 0, cpInteger, &_flood,
+		     "RATE", 0, cpUnsigned, &_rate,
+		     "SEED", 0, cpUnsigned, &_seed,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+    if (_length < 16 || _length > 65515)
+	return errh->error("LENGTH must be between 16 and 65515");
+    if (_fragment < 8 || _fragment % 8 != 0 || _fragment >= _length)
+	return errh->error("FRAGMENT must be a multiple of 8 less than LENGTH");
+    if (_nsources < 1 || _nsources > 65536)
+	return errh->error("SOURCES must be between 1 and 65536");
+    if (_concurrent < 1 || _concurrent > trace_packets)
+	return errh->error("CONCURRENT must be between 1 and %d", (int) trace_packets);
+    if (_flood < 0 || _rate == 0)
+	return errh->error("FLOOD and RATE must be positive");
+    if (_seed == 0)
+	_seed = 1;
+    return 0;
+}
+
+int
+IPReassemblerBench::initialize(ErrorHandler *)
+{
+    _timer.initialize(this);
+    _timer.schedule_now();
+    return 0;
+}
+
+void
+IPReassemblerBench::cleanup(CleanupStage)
+{
+    for (Packet **pp = _trace.begin(); pp != _trace.end(); ++pp)
+	(*pp)->kill();
+    _trace.clear();
+}
+
+inline uint32_t
+IPReassemblerBench::random()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+void
+IPReassemblerBench::make_trace()
+{
+    // Fragment each packet, then shuffle the fragments of each group of
+    // _concurrent packets.  Payload byte i of the packet with IP ID id is
+    // id + i.
+    unsigned char *buf = new unsigned char[sizeof(click_ip) + _fragment];
+    for (int first = 0; first < trace_packets; first += _concurrent) {
+	int group_start = _trace.size();
+	for (int n = first; n < first + _concurrent && n < trace_packets; ++n) {
+	    uint16_t id = n;
+	    for (int off = 0; off < _length; off += _fragment) {
+		int len = (off + _fragment < _length ? _fragment : _length - off);
+		click_ip *iph = reinterpret_cast<click_ip *>(buf);
+		memset(iph, 0, sizeof(click_ip));
+		iph->ip_v = 4;
+		iph->ip_hl = sizeof(click_ip) >> 2;
+		iph->ip_len = htons(sizeof(click_ip) + len);
+		iph->ip_id = htons(id);
+		iph->ip_off = htons((off >> 3) | (off + len < _length ? IP_MF : 0));
+		iph->ip_ttl = 64;
+		iph->ip_p = IP_PROTO_UDP;
+		iph->ip_src.s_addr = htonl(0x0A000001U + n % _nsources);
+		iph->ip_dst.s_addr = htonl(0x0A800001U);
+		iph->ip_sum = click_in_cksum(buf, sizeof(click_ip));
+		for (int i = 0; i < len; ++i)
+		    buf[sizeof(click_ip) + i] = id + off + i;
+		_trace.push_back(Packet::make(0, buf, sizeof(click_ip) + len, 0));
+	    }
+	}
+	for (int i = _trace.size() - 1; i > group_start; --i) {
+	    int j = group_start + random() % (i - group_start + 1);
+	    Packet *p = _trace[i];
+	    _trace[i] = _trace[j];
+	    _trace[j] = p;
+	}
+    }
+    delete[] buf;
+}
+
+Packet *
+IPReassemblerBench::flood_fragment(const Timestamp &ts)
+{
+    // A first fragment whose other fragments never arrive
+    WritablePacket *q = Packet::make(0, 0, sizeof(click_ip) + _fragment, 0);
+    if (!q)
+	return 0;
+    click_ip *iph = reinterpret_cast<click_ip *>(q->data());
+    memset(iph, 0, sizeof(click_ip));
+    iph->ip_v = 4;
+    iph->ip_hl = sizeof(click_ip) >> 2;
+    iph->ip_len = htons(q->length());
+    iph->ip_id = random();
+    iph->ip_off = htons(IP_MF);
+    iph->ip_ttl = 64;
+    iph->ip_p = IP_PROTO_UDP;
+    iph->ip_src.s_addr = htonl(flood_source);
+    iph->ip_dst.s_addr = random();
+    q->set_ip_header(iph, sizeof(click_ip));
+    q->set_timestamp_anno(ts);
+    return q;
+}
+
+void
+IPReassemblerBench::push(int, Packet *p)
+{
+    const click_ip *iph = p->ip_header();
+    const unsigned char *data = p->transport_header();
+    uint16_t id = ntohs(iph->ip_id);
+    bool ok = (p->transport_length() == _length
+	       && iph->ip_src.s_addr != htonl(flood_source));
+    for (int i = 0; ok && i < _length; ++i)
+	ok = (data[i] == (unsigned char) (id + i));
+    if (ok)
+	_completed++;
+    else if (++_errors <= 5)
+	click_chatter("%{element}: bad reassembled packet", this);
+    p->kill();
+}
+
+void
+IPReassemblerBench::run_timer(Timer *)
+{
+    make_trace();
+    int fragments_per_packet = (_length + _fragment - 1) / _fragment;
+    uint32_t flood_limit = 100 * fragments_per_packet;
+    double fragment_interval = 1. / ((double) _rate * fragments_per_packet);
+    uint64_t nfragments = (uint64_t) _count * fragments_per_packet;
+    uint64_t nsent = 0;
+
+    Timestamp t0 = Timestamp::now();
+    for (uint64_t i = 0; i < nfragments; ++i) {
+	Timestamp ts(1000 + i * fragment_interval);
+	Packet *t = _trace[i % _trace.size()];
+	if (WritablePacket *q = Packet::make(0, t->data(), t->length(), 0)) {
+	    q->set_ip_header(reinterpret_cast<click_ip *>(q->data()), sizeof(click_ip));
+	    q->set_timestamp_anno(ts);
+	    output(0).push(q);
+	    nsent++;
+	}
+	if (_flood && random() % flood_limit < (uint32_t) _flood)
+	    if (Packet *q = flood_fragment(ts)) {
+		output(0).push(q);
+		nsent++;
+	    }
+    }
+    double elapsed = (Timestamp::now() - t0).doubleval();
+    if (elapsed > 0) {
+	_fragment_rate = nsent / elapsed;
+	_packet_rate = _count / elapsed;
+    }
+
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+String
+IPReassemblerBench::read_handler(Element *e, void *thunk)
+{
+    IPReassemblerBench *b = static_cast<IPReassemblerBench *>(e);
+    switch ((intptr_t) thunk) {
+    case 1:
+	return String(b->_completed);
+    case 2:
+	return String(b->_errors);
+    default: {
+	StringAccum sa;
+	sa << "fragments_per_sec " << (uint64_t) b->_fragment_rate << '\n'
+	   << "packets_per_sec " << (uint64_t) b->_packet_rate << '\n';
+	return sa.take_string();
+    }
+    }
+}
+
+void
+IPReassemblerBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("completed", read_handler, (void *) 1);
+    add_read_handler("errors", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel)
+EXPORT_ELEMENT(IPReassemblerBench)
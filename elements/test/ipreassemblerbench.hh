@@ -0,0 +1,143 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPREASSEMBLERBENCH_HH
+#define CLICK_IPREASSEMBLERBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+CLICK_DECLS
+
+/*
+=c
+
+IPReassemblerBench([I<keywords> COUNT, LENGTH, FRAGMENT, SOURCES, CONCURRENT, FLOOD, RATE, SEED, STOP])
+
+=s test
+
+measures IP reassembly speed
+
+=d
+
+IPReassemblerBench replays a synthetic trace of fragmented IP packets through
+an IP reassembler, such as IPReassembler, as fast as it can, and checks the
+reassembled packets that come back.  Connect its output to the reassembler
+and the reassembler's first output to its input.  It runs once, just after
+the router is initialized.
+
+The trace has COUNT packets of LENGTH bytes of IP payload, from SOURCES
+different source addresses, each split into fragments carrying FRAGMENT bytes
+of payload.  The fragments of each group of CONCURRENT consecutive packets
+are shuffled together, so CONCURRENT reassemblies are in progress at once.
+Timestamp annotations advance by 1/RATE seconds per packet.  If FLOOD is
+nonzero, IPReassemblerBench also sends, for every 100 packets, FLOOD first
+fragments from a single flooding source that are never completed.
+
+Keyword arguments are:
+
+=over 8
+
+=item COUNT
+
+Integer.  Number of packets.  Default is 1000000.
+
+=item LENGTH
+
+Integer.  IP payload bytes per packet.  Default is 1480.
+
+=item FRAGMENT
+
+Integer, a multiple of 8.  Payload bytes per fragment.  Default is 576.
+
+=item SOURCES
+
+Integer.  Number of source addresses.  Default is 16.
+
+=item CONCURRENT
+
+Integer.  Number of packets whose fragments are shuffled together.  Default
+is 16.
+
+=item FLOOD
+
+Integer.  Flood fragments per 100 packets.  Default is 0.
+
+=item RATE
+
+Integer.  Packets per second of trace time.  Default is 1000000.
+
+=item SEED
+
+Integer.  Random seed.  Default is 1.
+
+=item STOP
+
+Boolean.  If true, stop the driver when done.  Default is false.
+
+=back
+
+=h results read-only
+
+Returns the number of fragments and packets replayed per second.
+
+=h completed read-only
+
+Returns the number of packets reassembled.
+
+=h errors read-only
+
+Returns the number of reassembled packets with bad contents.
+
+=e
+
+  b :: IPReassemblerBench(FLOOD 50, STOP true);
+  b -> r :: IPReassembler -> b;
+
+Run with "click -h b.results -h b.completed -h r.evicted".
+
+=a IPReassembler */
+
+class IPReassemblerBench : public Element { public:
+
+    IPReassemblerBench();
+    ~IPReassemblerBench();
+
+    const char *class_name() const	{ return "IPReassemblerBench"; }
+    const char *port_count() const	{ return PORTS_1_1; }
+    const char *processing() const	{ return PUSH; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+    void run_timer(Timer *timer);
+
+  private:
+
+    enum { trace_packets = 1024 };
+
+    uint32_t _count;
+    int _length;
+    int _fragment;
+    int _nsources;
+    int _concurrent;
+    int _flood;
+    uint32_t _rate;
+    uint32_t _seed;
+    bool _stop;
+    Timer _timer;
+
+    Vector<Packet *> _trace;
+    uint32_t _completed;
+    uint32_t _errors;
+    double _fragment_rate;
+    double _packet_rate;
+
+    inline uint32_t random();
+    void make_trace();
+    Packet *flood_fragment(const Timestamp &ts);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,236 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * iprewriterbench.{cc,hh} -- benchmark rewriters from many threads
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "iprewriterbench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+#include <click/algorithm.hh>
+#include <clicknet/ip.h>
+#include <clicknet/udp.h>
+#include <sched.h>
+CLICK_DECLS
+
+IPRewriterBench::IPRewriterBench()
+    : _workers(0), _mapping(0), _stopping(false)
+{
+    for (int i = 0; i < 2; ++i)
+	_arrived[i] = _finished[i] = _received[i] = 0;
+    _errors = 0;
+}
+
+IPRewriterBench::~IPRewriterBench()
+{
+}
+
+int
+IPRewriterBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _nthreads = 1;
+    _nflows = 50000;
+    _npackets = 1000000;
+    if (cp_va_kparse(conf, this, errh,
+		     "THREADS", 0, cpUnsigned, &_nthreads,
+		     "FLOWS", 0, cpUnsigned, &_nflows,
+		     "PACKETS", 0, cpUnsigned, &_npackets,
+		     cpEnd) < 0)
+	return -1;
+    if (_nthreads == 0 || _nflows < _nthreads)
+	return errh->error("need at least one flow per thread");
+    if (_nflows > (1U << 24))
+	return errh->error("too many FLOWS");
+    return 0;
+}
+
+extern "C" {
+static void *iprewriter_bench_worker(void *arg)
+{
+    return IPRewriterBench::worker_thread(arg);
+}
+}
+
+int
+IPRewriterBench::initialize(ErrorHandler *errh)
+{
+    _mapping = new uint64_t[_nflows];
+    for (uint32_t i = 0; i < _nflows; ++i)
+	_mapping[i] = 0;
+    _workers = new Worker[_nthreads];
+    for (uint32_t i = 0; i < _nthreads; ++i) {
+	_workers[i].bench = this;
+	_workers[i].id = i;
+	_workers[i].started = false;
+    }
+    for (uint32_t i = 0; i < _nthreads; ++i) {
+	int err = pthread_create(&_workers[i].thread, 0, iprewriter_bench_worker, &_workers[i]);
+	if (err != 0)
+	    return errh->error("cannot start thread: %s", strerror(err));
+	_workers[i].started = true;
+    }
+    return 0;
+}
+
+void
+IPRewriterBench::cleanup(CleanupStage)
+{
+    if (_workers) {
+	_stopping = true;
+	for (uint32_t i = 0; i < _nthreads; ++i)
+	    if (_workers[i].started)
+		pthread_join(_workers[i].thread, 0);
+	delete[] _workers;
+	_workers = 0;
+    }
+    delete[] _mapping;
+    _mapping = 0;
+}
+
+Packet *
+IPRewriterBench::make_packet(uint32_t flow, int phase)
+{
+    WritablePacket *p = Packet::make(sizeof(click_ip) + sizeof(click_udp) + 8);
+    if (!p)
+	return 0;
+    click_ip *iph = reinterpret_cast<click_ip *>(p->data());
+    memset(iph, 0, p->length());
+    iph->ip_v = 4;
+    iph->ip_hl = sizeof(click_ip) >> 2;
+    iph->ip_len = htons(p->length());
+    iph->ip_ttl = 64;
+    iph->ip_p = IP_PROTO_UDP;
+    iph->ip_src.s_addr = htonl(0x0A000000 + flow);
+    iph->ip_dst.s_addr = htonl(0xC0000201);
+    iph->ip_sum = click_in_cksum((const unsigned char *) iph, sizeof(click_ip));
+    p->set_ip_header(iph, sizeof(click_ip));
+    click_udp *udph = p->udp_header();
+    udph->uh_sport = htons(1024);
+    udph->uh_dport = htons(53);
+    udph->uh_ulen = htons(sizeof(click_udp) + 8);
+    uint32_t *data = reinterpret_cast<uint32_t *>(udph + 1);
+    data[0] = flow;
+    data[1] = phase;
+    return p;
+}
+
+void
+IPRewriterBench::run_phase(int phase, uint32_t id)
+{
+    // Wait for all threads; the last to arrive starts the clock.
+    if (_arrived[phase].fetch_and_add(1) + 1 == _nthreads) {
+	_start[phase] = Timestamp::now();
+	_arrived[phase] += 1;
+    }
+    while (_arrived[phase].value() <= _nthreads && !_stopping)
+	sched_yield();
+
+    uint32_t lo = (uint64_t) _nflows * id / _nthreads,
+	hi = (uint64_t) _nflows * (id + 1) / _nthreads;
+    uint32_t n = (phase == 0 ? hi - lo : (uint64_t) _npackets * (id + 1) / _nthreads - (uint64_t) _npackets * id / _nthreads);
+    for (uint32_t i = 0; i < n && !_stopping; ++i) {
+	// established packets visit the thread's flows in a scattered order
+	uint32_t flow = (phase == 0 ? lo + i : lo + (uint32_t) ((i * 2654435761ULL) % (hi - lo)));
+	if (Packet *p = make_packet(flow, phase))
+	    output(0).push(p);
+    }
+
+    if (_finished[phase].fetch_and_add(1) + 1 == _nthreads) {
+	_end[phase] = Timestamp::now();
+	if (phase == 0)
+	    check_mappings();
+	_finished[phase] += 1;
+    }
+}
+
+void *
+IPRewriterBench::worker_thread(void *arg)
+{
+    Worker *w = static_cast<Worker *>(arg);
+    IPRewriterBench *b = w->bench;
+    while (!b->router()->running() && !b->_stopping)
+	sched_yield();
+    for (int phase = 0; phase < 2; ++phase)
+	b->run_phase(phase, w->id);
+    return 0;
+}
+
+void
+IPRewriterBench::check_mappings()
+{
+    // Every flow should have a different rewritten source.
+    Vector<uint64_t> v;
+    for (uint32_t i = 0; i < _nflows; ++i)
+	if (_mapping[i])
+	    v.push_back(_mapping[i]);
+    click_qsort(v.begin(), v.size());
+    for (int i = 1; i < v.size(); ++i)
+	if (v[i] == v[i - 1])
+	    ++_errors;
+}
+
+void
+IPRewriterBench::push(int, Packet *p)
+{
+    const click_ip *iph = p->ip_header();
+    const click_udp *udph = p->udp_header();
+    const uint32_t *data = reinterpret_cast<const uint32_t *>(udph + 1);
+    if (p->transport_length() < (int) sizeof(click_udp) + 8
+	|| data[0] >= _nflows || data[1] > 1)
+	++_errors;
+    else {
+	uint64_t m = ((uint64_t) ntohl(iph->ip_src.s_addr) << 16) | ntohs(udph->uh_sport);
+	if (data[1] == 0)
+	    _mapping[data[0]] = m;
+	else if (_mapping[data[0]] != m)
+	    ++_errors;
+	++_received[data[1]];
+    }
+    p->kill();
+}
+
+String
+IPRewriterBench::read_handler(Element *e, void *thunk)
+{
+    IPRewriterBench *b = static_cast<IPRewriterBench *>(e);
+    if (thunk == (void *) 1)
+	return String(b->_errors.value());
+    else if (thunk == (void *) 2)
+	return cp_unparse_bool(b->_finished[1].value() > b->_nthreads);
+
+    StringAccum sa;
+    double rate[2];
+    for (int i = 0; i < 2; ++i) {
+	double elapsed = b->_finished[i].value() > b->_nthreads ? (b->_end[i] - b->_start[i]).doubleval() : 0;
+	rate[i] = elapsed > 0 ? (i ? b->_npackets : b->_nflows) / elapsed : 0;
+    }
+    sa << "flows " << b->_received[0].value() << '\n'
+       << "new_flows_per_sec " << (uint64_t) rate[0] << '\n'
+       << "packets " << b->_received[1].value() << '\n'
+       << "packets_per_sec " << (uint64_t) rate[1] << '\n';
+    return sa.take_string();
+}
+
+void
+IPRewriterBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("errors", read_handler, (void *) 1);
+    add_read_handler("done", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel umultithread)
+EXPORT_ELEMENT(IPRewriterBench)
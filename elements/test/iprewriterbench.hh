@@ -0,0 +1,131 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPREWRITERBENCH_HH
+#define CLICK_IPREWRITERBENCH_HH
+#include <click/element.hh>
+#include <click/atomic.hh>
+#include <pthread.h>
+CLICK_DECLS
+
+/*
+=c
+
+IPRewriterBench([I<keywords> THREADS, FLOWS, PACKETS])
+
+=s test
+
+measures rewriter flow setup and forwarding rates from many threads
+
+=d
+
+IPRewriterBench starts THREADS POSIX threads, separate from Click's own
+threads, once the router is running.  Connect its output to the input of a
+rewriter, such as UDPRewriter, and the rewriter's forward output back to
+IPRewriterBench's input.
+
+The test has two phases.  First, the threads push one UDP packet for each of
+FLOWS new flows, each thread taking an equal share of the flows.  Then, once
+all threads have finished, they push PACKETS more packets, spread over the
+flows each thread created.  IPRewriterBench times each phase from the moment
+all threads start it to the moment the last thread finishes.
+
+Packets come from 10.0.0.0/8 port 1024 and go to 192.0.2.1 port 53.  Each
+carries its flow number.  IPRewriterBench checks that the rewriter gives
+every flow a different rewritten source, and that later packets of a flow
+are rewritten the same way as its first packet.
+
+Keyword arguments are:
+
+=over 8
+
+=item THREADS
+
+Integer.  Number of pushing threads.  Default is 1.
+
+=item FLOWS
+
+Integer.  Number of flows.  Default is 50000.
+
+=item PACKETS
+
+Integer.  Number of packets to push over established flows.  Default is
+1000000.
+
+=back
+
+=h results read-only
+
+Returns the number of flows and packets the rewriter returned in each
+phase, the rate of new flows per second, and the rate of established-flow
+packets per second.
+
+=h errors read-only
+
+Returns the number of flows that shared a rewritten source with another
+flow, plus the number of packets rewritten differently from their flow's
+first packet.
+
+=h done read-only
+
+Returns true iff both phases are done.
+
+=e
+
+  b :: IPRewriterBench(THREADS 4, FLOWS 50000);
+  rw :: UDPRewriter(pattern 100.64.0.1 1024-65535 - - 0 1, SHARDS 4);
+  b -> rw -> b;
+  rw[1] -> Discard;
+
+A rewriter without SHARDS must only be benchmarked with one thread.
+
+=a UDPRewriter, IPRewriter, QueueStressSource */
+
+class IPRewriterBench : public Element { public:
+
+    IPRewriterBench();
+    ~IPRewriterBench();
+
+    const char *class_name() const		{ return "IPRewriterBench"; }
+    const char *port_count() const		{ return PORTS_1_1; }
+    const char *processing() const		{ return PUSH; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void push(int port, Packet *p);
+
+    static void *worker_thread(void *arg);
+
+  private:
+
+    struct Worker {
+	IPRewriterBench *bench;
+	uint32_t id;
+	pthread_t thread;
+	bool started;
+    };
+
+    uint32_t _nthreads;
+    uint32_t _nflows;
+    uint32_t _npackets;
+    Worker *_workers;
+    uint64_t *_mapping;
+    volatile bool _stopping;
+
+    atomic_uint32_t _arrived[2];
+    atomic_uint32_t _finished[2];
+    atomic_uint32_t _received[2];
+    atomic_uint32_t _errors;
+    Timestamp _start[2];
+    Timestamp _end[2];
+
+    Packet *make_packet(uint32_t flow, int phase);
+    void run_phase(int phase, uint32_t id);
+    void check_mappings();
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
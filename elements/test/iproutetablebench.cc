@@ -0,0 +1,238 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * iproutetablebench.{cc,hh} -- benchmark IP routing tables
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "iproutetablebench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+#include "elements/ip/iproutetable.hh"
+CLICK_DECLS
+
+// Cumulative prefix length distribution, in parts per 10000, roughly that of
+// a 2020s full IPv4 BGP view.
+static const struct {
+    int plen;
+    int cumulative;
+} prefix_lengths[] = {
+    { 8, 5 }, { 10, 10 }, { 12, 25 }, { 13, 40 }, { 14, 60 }, { 15, 90 },
+    { 16, 220 }, { 17, 320 }, { 18, 470 }, { 19, 820 }, { 20, 1270 },
+    { 21, 1770 }, { 22, 2970 }, { 23, 3920 }, { 24, 9950 }, { 25, 9965 },
+    { 26, 9975 }, { 27, 9983 }, { 28, 9990 }, { 29, 9995 }, { 30, 9998 },
+    { 32, 10000 }
+};
+
+IPRouteTableBench::IPRouteTableBench()
+    : _timer(this), _added(0), _lookup_rate(0), _update_rate(0), _errors(0)
+{
+}
+
+IPRouteTableBench::~IPRouteTableBench()
+{
+}
+
+int
+IPRouteTableBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    Element *table, *reference = 0;
+    _nroutes = 800000;
+    _nnexthops = 64;
+    _nlookups = 10000000;
+    _nupdates = 100000;
+    _seed = 1;
+    _stop = false;
+    if (cp_va_kparse(conf, this, errh,
+		     "TABLE", cpkP+cpkM, cpElement, &table,
+		     "ROUTES", 0, cpUnsigned, &_nroutes,
+		     "NEXTHOPS", 0, cpUnsigned, &_nnexthops,
+		     "LOOKUPS", 0, cpUnsigned, &_nlookups,
+		     "UPDATES", 0, cpUnsigned, &_nupdates,
+		     "REFERENCE", 0, cpElement, &reference,
+		     "SEED", 0, cpUnsigned, &_seed,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+    if (!(_table = static_cast<IPRouteTable *>(table->cast("IPRouteTable"))))
+	return errh->error("%s is not an IPRouteTable", table->name().c_str());
+    if (!reference)
+	_reference = 0;
+    else if (!(_reference = static_cast<IPRouteTable *>(reference->cast("IPRouteTable"))))
+	return errh->error("%s is not an IPRouteTable", reference->name().c_str());
+    if (_table->noutputs() == 0 || (_reference && _reference->noutputs() < _table->noutputs()))
+	return errh->error("routing tables have too few outputs");
+    if (_nnexthops == 0)
+	return errh->error("NEXTHOPS must be positive");
+    if (_seed == 0)
+	_seed = 1;
+    return 0;
+}
+
+int
+IPRouteTableBench::initialize(ErrorHandler *)
+{
+    _timer.initialize(this);
+    _timer.schedule_now();
+    return 0;
+}
+
+inline uint32_t
+IPRouteTableBench::random()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+void
+IPRouteTableBench::random_route(IPAddress &addr, int &plen)
+{
+    int x = random() % 10000, i = 0;
+    while (prefix_lengths[i].cumulative <= x)
+	++i;
+    plen = prefix_lengths[i].plen;
+    // Avoid 0/8, multicast, and reserved space, like real tables.
+    uint32_t a;
+    do {
+	a = random();
+    } while ((a >> 24) == 0 || (a >> 24) >= 224);
+    addr = IPAddress(htonl(a & ntohl(IPAddress::make_prefix(plen).addr())));
+}
+
+int
+IPRouteTableBench::add_route(IPAddress addr, int plen, ErrorHandler *errh)
+{
+    uint32_t nh = random() % _nnexthops;
+    IPRoute r(addr, IPAddress::make_prefix(plen), IPAddress(htonl(0x0A000001 + nh)),
+	      nh % _table->noutputs());
+    int x = _table->add_route(r, true, 0, errh);
+    if (x >= 0 && _reference)
+	x = _reference->add_route(r, true, 0, errh);
+    return x;
+}
+
+void
+IPRouteTableBench::check(uint32_t addr)
+{
+    IPAddress gw1, gw2;
+    int port1 = _table->lookup_route(IPAddress(addr), gw1);
+    int port2 = _reference->lookup_route(IPAddress(addr), gw2);
+    if (port1 != port2 || (port1 >= 0 && gw1 != gw2)) {
+	if (++_errors <= 5)
+	    click_chatter("%{element}: %s: got %d %s, expected %d %s", this,
+			  IPAddress(addr).unparse().c_str(),
+			  port1, gw1.unparse().c_str(), port2, gw2.unparse().c_str());
+    }
+}
+
+void
+IPRouteTableBench::run_timer(Timer *)
+{
+    ErrorHandler *errh = ErrorHandler::default_handler();
+    Vector<IPAddress> addrs;
+    Vector<int> plens;
+
+    // fill the table
+    Timestamp t0 = Timestamp::now();
+    for (uint32_t i = 0; i < _nroutes; ++i) {
+	IPAddress addr;
+	int plen;
+	random_route(addr, plen);
+	if (add_route(addr, plen, errh) >= 0) {
+	    addrs.push_back(addr);
+	    plens.push_back(plen);
+	}
+    }
+    _add_time = Timestamp::now() - t0;
+    _added = addrs.size();
+
+    // look up addresses inside random routes
+    if (_nlookups && addrs.size()) {
+	Vector<uint32_t> dst;
+	uint32_t n = 1;
+	while (n < _nlookups && n < (1U << 20))
+	    n <<= 1;
+	for (uint32_t i = 0; i < n; ++i) {
+	    int r = random() % addrs.size();
+	    uint32_t host = plens[r] == 32 ? 0 : random() & (0xFFFFFFFFU >> plens[r]);
+	    dst.push_back(addrs[r].addr() | htonl(host));
+	}
+
+	IPAddress gw;
+	int sum = 0;
+	t0 = Timestamp::now();
+	if (_reference)
+	    for (uint32_t i = 0; i < _nlookups; ++i)
+		check(dst[i & (n - 1)]);
+	else
+	    for (uint32_t i = 0; i < _nlookups; ++i)
+		sum += _table->lookup_route(IPAddress(dst[i & (n - 1)]), gw);
+	double elapsed = (Timestamp::now() - t0).doubleval();
+	_lookup_rate = elapsed > 0 ? _nlookups / elapsed : 0;
+	if (sum == 0x7FFFFFFF)	// keep the compiler from dropping lookups
+	    click_chatter("%d", sum);
+    }
+
+    // replace random routes with new ones
+    if (_nupdates && addrs.size()) {
+	t0 = Timestamp::now();
+	for (uint32_t i = 0; i < _nupdates; ++i) {
+	    int r = random() % addrs.size();
+	    IPRoute old(addrs[r], IPAddress::make_prefix(plens[r]), IPAddress(), -1);
+	    _table->remove_route(old, 0, errh);
+	    if (_reference)
+		_reference->remove_route(old, 0, errh);
+	    random_route(addrs[r], plens[r]);
+	    add_route(addrs[r], plens[r], errh);
+	    if (_reference) {
+		check(old.addr.addr());
+		check(addrs[r].addr());
+		check(addrs[r].addr() | htonl(0xFFFFFFFFU >> plens[r]));
+	    }
+	}
+	double elapsed = (Timestamp::now() - t0).doubleval();
+	_update_rate = elapsed > 0 ? _nupdates / elapsed : 0;
+    }
+
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+String
+IPRouteTableBench::read_handler(Element *e, void *thunk)
+{
+    IPRouteTableBench *b = static_cast<IPRouteTableBench *>(e);
+    if (thunk)
+	return String(b->_errors);
+    StringAccum sa;
+    sa << "routes " << b->_added << '\n'
+       << "add_time " << b->_add_time << '\n'
+       << "lookups_per_sec " << (uint64_t) b->_lookup_rate << '\n'
+       << "updates_per_sec " << (uint64_t) b->_update_rate << '\n';
+    return sa.take_string();
+}
+
+void
+IPRouteTableBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("errors", read_handler, (void *) 1);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel IPRouteTable)
+EXPORT_ELEMENT(IPRouteTableBench)
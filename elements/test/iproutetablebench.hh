@@ -0,0 +1,132 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPROUTETABLEBENCH_HH
+#define CLICK_IPROUTETABLEBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+CLICK_DECLS
+class IPRouteTable;
+
+/*
+=c
+
+IPRouteTableBench(TABLE, [I<keywords> ROUTES, NEXTHOPS, LOOKUPS, UPDATES, REFERENCE, SEED, STOP])
+
+=s test
+
+measures IP routing table lookup and update speed on synthetic tables
+
+=d
+
+IPRouteTableBench fills the IPRouteTable element TABLE with a synthetic
+routing table, then measures how fast TABLE looks up addresses and changes
+routes.  It runs once, just after the router is initialized.
+
+The synthetic table has ROUTES random prefixes whose lengths follow the
+distribution of a recent full BGP view: about 60% /24s, most of the rest /16
+through /23, and a few shorter and longer prefixes.  Routes are spread over
+NEXTHOPS gateways on TABLE's outputs.  IPRouteTableBench then looks up
+LOOKUPS addresses, each inside a randomly chosen route, and finally makes
+UPDATES changes, each removing a random route and adding a new one.
+
+If REFERENCE names another IPRouteTable element, IPRouteTableBench makes the
+same changes to REFERENCE and compares every lookup result, in the filled
+table and after each update, with REFERENCE's.  The C<errors> handler counts
+the differences.
+
+Keyword arguments are:
+
+=over 8
+
+=item ROUTES
+
+Integer.  Number of routes.  Default is 800000.
+
+=item NEXTHOPS
+
+Integer.  Number of gateways.  Default is 64.
+
+=item LOOKUPS
+
+Integer.  Number of lookups to time.  Default is 10000000.
+
+=item UPDATES
+
+Integer.  Number of route changes to time.  Default is 100000.
+
+=item REFERENCE
+
+Element.  An IPRouteTable to check TABLE against.  Lookups and updates in
+REFERENCE are included in the timings.
+
+=item SEED
+
+Integer.  Random seed; a given SEED always produces the same routes and
+addresses.  Default is 1.
+
+=item STOP
+
+Boolean.  If true, stop the driver when done.  Default is false.
+
+=back
+
+=h results read-only
+
+Returns the number of routes added, the time taken to add them, the lookup
+rate, and the update rate.
+
+=h errors read-only
+
+Returns the number of lookups that disagreed with REFERENCE.
+
+=e
+
+  r :: PoptrieIPLookup;
+  Idle -> r; r[0] -> Discard; r[1] -> Discard;
+  b :: IPRouteTableBench(r, STOP true);
+
+Run with "click -h b.results".  Compare different routing
+table elements by replacing PoptrieIPLookup.
+
+=a PoptrieIPLookup, DirectIPLookup, RadixIPLookup, RangeIPLookup */
+
+class IPRouteTableBench : public Element { public:
+
+    IPRouteTableBench();
+    ~IPRouteTableBench();
+
+    const char *class_name() const	{ return "IPRouteTableBench"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void add_handlers();
+
+    void run_timer(Timer *timer);
+
+  private:
+
+    IPRouteTable *_table;
+    IPRouteTable *_reference;
+    uint32_t _nroutes;
+    uint32_t _nnexthops;
+    uint32_t _nlookups;
+    uint32_t _nupdates;
+    uint32_t _seed;
+    bool _stop;
+    Timer _timer;
+
+    uint32_t _added;
+    Timestamp _add_time;
+    double _lookup_rate;
+    double _update_rate;
+    uint32_t _errors;
+
+    inline uint32_t random();
+    void random_route(IPAddress &addr, int &plen);
+    int add_route(IPAddress addr, int plen, ErrorHandler *errh);
+    void check(uint32_t addr);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,420 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * ipseccipherbench.{cc,hh} -- benchmark and check IPsec ESP ciphers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "ipseccipherbench.hh"
+#include <click/confparse.hh>
+#include <click/straccum.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+#include "elements/ipsec/ipseccipher.hh"
+CLICK_DECLS
+
+static const char * const kernel_names[] = { "generic", "aesni" };
+enum { nkernel_names = sizeof(kernel_names) / sizeof(kernel_names[0]) };
+
+// FIPS-197 appendix C.1; GCM specification test case 4; FIPS 180-2
+// "abc"; RFC 4231 test case 2.
+static const char aes_key_hex[] = "000102030405060708090a0b0c0d0e0f";
+static const char aes_plain_hex[] = "00112233445566778899aabbccddeeff";
+static const char aes_cipher_hex[] = "69c4e0d86a7b0430d8cdb78070b4c55a";
+static const char gcm_key_hex[] = "feffe9928665731c6d6a8f9467308308";
+static const char gcm_nonce_hex[] = "cafebabefacedbaddecaf888";
+static const char gcm_aad_hex[] = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+static const char gcm_plain_hex[] = "d9313225f88406e5a55909c5aff5269a"
+    "86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525"
+    "b16aedf5aa0de657ba637b39";
+static const char gcm_cipher_hex[] = "42831ec2217774244b7221b784d0d49c"
+    "e3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa05"
+    "1ba30b396a0aac973d58e091";
+static const char gcm_tag_hex[] = "5bc94fbc3221a5db94fae95ae7121a47";
+static const char sha256_abc_hex[] =
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+static const char hmac_hex[] =
+    "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843";
+
+static int
+unhex(const char *s, uint8_t *out)
+{
+    int n = 0;
+    for (; s[0] && s[1]; s += 2, ++n) {
+	int hi = (s[0] <= '9' ? s[0] - '0' : s[0] - 'a' + 10);
+	int lo = (s[1] <= '9' ? s[1] - '0' : s[1] - 'a' + 10);
+	out[n] = (hi << 4) | lo;
+    }
+    return n;
+}
+
+IPsecCipherBench::IPsecCipherBench()
+    : _timer(this), _errors(0)
+{
+}
+
+IPsecCipherBench::~IPsecCipherBench()
+{
+}
+
+int
+IPsecCipherBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    String transform = "aes-gcm";
+    String lengths = "64 128 256 512 1024 1500";
+    _nbytes = 100000000;
+    _batch = 16;
+    _seed = 1;
+    _stop = false;
+    if (cp_va_kparse(conf, this, errh,
+		     "TRANSFORM", 0, cpWord, &transform,
+		     "LENGTHS", 0, cpArgument, &lengths,
+		     "BYTES", 0, cpUnsigned64, &_nbytes,
+		     "BATCH", 0, cpInteger, &_batch,
+		     "KERNEL", 0, cpWord, &_kernel,
+		     "SEED", 0, cpUnsigned, &_seed,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+
+    if (transform == "aes-gcm")
+	_gcm = true;
+    else if (transform == "aes-cbc-hmac-sha256")
+	_gcm = false;
+    else
+	return errh->error("unknown TRANSFORM %<%s%>", transform.c_str());
+
+    Vector<String> words;
+    cp_spacevec(lengths, words);
+    _lengths.clear();
+    for (String *it = words.begin(); it != words.end(); ++it) {
+	int len;
+	if (!cp_integer(*it, &len) || len <= 0 || len > 65536)
+	    return errh->error("LENGTHS must contain integers between 1 and 65536");
+	_lengths.push_back(len);
+    }
+
+    if (_batch < 1 || _batch > max_batch)
+	return errh->error("BATCH must be between 1 and %d", (int) max_batch);
+
+    String original = IPsecCipher::kernel();
+    if (_kernel) {
+	if (IPsecCipher::set_kernel(_kernel.c_str()) < 0)
+	    return errh->error("KERNEL %<%s%> not available on this CPU", _kernel.c_str());
+	IPsecCipher::set_kernel(original.c_str());
+    } else if (original == "generic")
+	_kernel = "generic";
+    else
+	_kernel = "aesni";
+
+    if (_seed == 0)
+	_seed = 1;
+    return 0;
+}
+
+int
+IPsecCipherBench::initialize(ErrorHandler *)
+{
+    _timer.initialize(this);
+    _timer.schedule_now();
+    return 0;
+}
+
+inline uint32_t
+IPsecCipherBench::random()
+{
+    // xorshift32
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+void
+IPsecCipherBench::fill(uint8_t *data, int len)
+{
+    for (int i = 0; i < len; ++i)
+	data[i] = random() >> 24;
+}
+
+void
+IPsecCipherBench::error(const char *kernel, const char *what, int len)
+{
+    if (++_errors <= 5)
+	click_chatter("%{element}: %s: %s length %d failed", this, kernel, what, len);
+}
+
+void
+IPsecCipherBench::check_vectors(const char *kernel)
+{
+    uint8_t key[16], in[64], expected[64], out[64], nonce[12], aad[20], tag[16];
+
+    IPsecCipher::aes_key ak;
+    unhex(aes_key_hex, key);
+    unhex(aes_plain_hex, in);
+    unhex(aes_cipher_hex, expected);
+    IPsecCipher::aes_setup(ak, key);
+    IPsecCipher::aes_encrypt_block(ak, in, out);
+    if (memcmp(out, expected, 16) != 0)
+	error(kernel, "AES test vector", 16);
+
+    IPsecCipher::gcm_key gk;
+    unhex(gcm_key_hex, key);
+    unhex(gcm_nonce_hex, nonce);
+    int aad_len = unhex(gcm_aad_hex, aad);
+    int len = unhex(gcm_plain_hex, in);
+    unhex(gcm_cipher_hex, expected);
+    IPsecCipher::gcm_setup(gk, key);
+    memcpy(out, in, len);
+    IPsecCipher::gcm_encrypt(gk, nonce, aad, aad_len, out, len, tag);
+    if (memcmp(out, expected, len) != 0)
+	error(kernel, "GCM test vector", len);
+    unhex(gcm_tag_hex, expected);
+    if (memcmp(tag, expected, 16) != 0)
+	error(kernel, "GCM test vector tag", len);
+    if (!IPsecCipher::gcm_decrypt(gk, nonce, aad, aad_len, out, len, tag)
+	|| memcmp(out, in, len) != 0)
+	error(kernel, "GCM test vector decryption", len);
+
+    uint8_t digest[32];
+    IPsecCipher::sha256((const uint8_t *) "abc", 3, digest);
+    unhex(sha256_abc_hex, expected);
+    if (memcmp(digest, expected, 32) != 0)
+	error(kernel, "SHA-256 test vector", 3);
+
+    IPsecCipher::hmac_key hk;
+    IPsecCipher::hmac_sha256_setup(hk, (const uint8_t *) "Jefe", 4);
+    IPsecCipher::hmac_sha256(hk, (const uint8_t *) "what do ya want for nothing?", 28, digest);
+    unhex(hmac_hex, expected);
+    if (memcmp(digest, expected, 32) != 0)
+	error(kernel, "HMAC-SHA-256 test vector", 28);
+}
+
+void
+IPsecCipherBench::check_random(const char *kernel)
+{
+    enum { maxlen = 300 };
+    uint8_t key[16], nonce[12], aad[12], plain[maxlen], ref[maxlen], out[maxlen];
+    uint8_t ref_tag[32], tag[32];
+    IPsecCipher::gcm_key gk;
+    IPsecCipher::hmac_key hk;
+
+    for (int len = 0; len <= maxlen; ++len) {
+	fill(key, 16);
+	fill(nonce, 12);
+	fill(aad, 12);
+	fill(plain, len);
+	int aad_len = 8 + len % 5;
+
+	IPsecCipher::set_kernel("generic");
+	IPsecCipher::gcm_setup(gk, key);
+	memcpy(ref, plain, len);
+	IPsecCipher::gcm_encrypt(gk, nonce, aad, aad_len, ref, len, ref_tag);
+	IPsecCipher::set_kernel(kernel);
+	memcpy(out, plain, len);
+	IPsecCipher::gcm_encrypt(gk, nonce, aad, aad_len, out, len, tag);
+	if (memcmp(out, ref, len) != 0 || memcmp(tag, ref_tag, 16) != 0)
+	    error(kernel, "GCM encryption", len);
+	if (!IPsecCipher::gcm_decrypt(gk, nonce, aad, aad_len, out, len, tag)
+	    || memcmp(out, plain, len) != 0)
+	    error(kernel, "GCM decryption", len);
+	memcpy(out, ref, len);
+	tag[len % 16] ^= 1;
+	if (IPsecCipher::gcm_decrypt(gk, nonce, aad, aad_len, out, len, tag)
+	    || memcmp(out, ref, len) != 0)
+	    error(kernel, "GCM forgery check", len);
+
+	IPsecCipher::set_kernel("generic");
+	IPsecCipher::sha256(plain, len, ref_tag);
+	IPsecCipher::hmac_sha256_setup(hk, key, len % 100);
+	IPsecCipher::hmac_sha256(hk, plain, len, ref_tag + 16);
+	IPsecCipher::set_kernel(kernel);
+	IPsecCipher::sha256(plain, len, tag);
+	IPsecCipher::hmac_sha256(hk, plain, len, tag + 16);
+	if (memcmp(tag, ref_tag, 32) != 0)
+	    error(kernel, "SHA-256 or HMAC-SHA-256", len);
+    }
+
+    // CBC batches mixing keys and lengths
+    IPsecCipher::aes_key keys[9];
+    IPsecCipher::cbc_job jobs[9];
+    uint8_t ivs[9][16], data[9][640], orig[9][640], expected[9][640];
+    for (int round = 0; round < 50; ++round) {
+	int njobs = 1 + random() % 9;
+	IPsecCipher::set_kernel("generic");
+	for (int j = 0; j < njobs; ++j) {
+	    fill(key, 16);
+	    IPsecCipher::aes_setup(keys[j], key);
+	    fill(ivs[j], 16);
+	    jobs[j].key = &keys[j];
+	    jobs[j].iv = ivs[j];
+	    jobs[j].data = data[j];
+	    jobs[j].len = 16 * (random() % 40);
+	    fill(orig[j], jobs[j].len);
+	    memcpy(expected[j], orig[j], jobs[j].len);
+	    IPsecCipher::aes_cbc_encrypt(keys[j], ivs[j], expected[j], jobs[j].len);
+	    memcpy(data[j], orig[j], jobs[j].len);
+	}
+	IPsecCipher::set_kernel(kernel);
+	IPsecCipher::aes_cbc_encrypt_batch(jobs, njobs);
+	for (int j = 0; j < njobs; ++j) {
+	    if (memcmp(data[j], expected[j], jobs[j].len) != 0)
+		error(kernel, "CBC batch encryption", jobs[j].len);
+	    IPsecCipher::aes_cbc_decrypt(keys[j], ivs[j], data[j], jobs[j].len);
+	    if (memcmp(data[j], orig[j], jobs[j].len) != 0)
+		error(kernel, "CBC decryption", jobs[j].len);
+	}
+    }
+}
+
+void
+IPsecCipherBench::time_length(int len)
+{
+    enum { header = 8, iv_len = 16, icv = 16 };
+    int plen = (_gcm ? len : (len + 15) & ~15);
+    int stride = header + iv_len + plen + icv;
+    uint8_t *buf = new uint8_t[stride * _batch];
+    uint8_t *plain = new uint8_t[plen * _batch];
+    fill(buf, stride * _batch);
+    for (int b = 0; b < _batch; ++b)
+	memcpy(plain + b * plen, buf + b * stride + header + iv_len, plen);
+
+    uint8_t key[16], salt[4];
+    IPsecCipher::gcm_key gk;
+    IPsecCipher::hmac_key hk;
+    fill(key, 16);
+    fill(salt, 4);
+    IPsecCipher::gcm_setup(gk, key);
+    IPsecCipher::hmac_sha256_setup(hk, key, 16);
+
+    IPsecCipher::cbc_job jobs[max_batch];
+    uint8_t nonce[IPsecCipher::gcm_nonce_size], digest[32];
+    memcpy(nonce, salt, 4);
+    uint64_t n = _nbytes / ((uint64_t) plen * _batch) + 1, counter = 0;
+    double encrypt_time = 0, decrypt_time = 0;
+
+    for (uint64_t i = 0; i < n; ++i) {
+	Timestamp t0 = Timestamp::now();
+	for (int b = 0; b < _batch; ++b) {
+	    uint8_t *esp = buf + b * stride, *iv = esp + header,
+		*payload = iv + iv_len;
+	    memcpy(iv + iv_len - 8, &counter, 8);
+	    ++counter;
+	    if (_gcm) {
+		memcpy(nonce + 4, iv + iv_len - 8, 8);
+		IPsecCipher::gcm_encrypt(gk, nonce, esp, header, payload, plen, payload + plen);
+	    } else {
+		IPsecCipher::aes_encrypt_block(gk.aes, iv, iv);
+		jobs[b].key = &gk.aes;
+		jobs[b].iv = iv;
+		jobs[b].data = payload;
+		jobs[b].len = plen;
+	    }
+	}
+	if (!_gcm) {
+	    IPsecCipher::aes_cbc_encrypt_batch(jobs, _batch);
+	    for (int b = 0; b < _batch; ++b) {
+		uint8_t *esp = buf + b * stride;
+		IPsecCipher::hmac_sha256(hk, esp, stride - icv, digest);
+		memcpy(esp + stride - icv, digest, icv);
+	    }
+	}
+	Timestamp t1 = Timestamp::now();
+
+	for (int b = 0; b < _batch; ++b) {
+	    uint8_t *esp = buf + b * stride, *iv = esp + header,
+		*payload = iv + iv_len;
+	    bool ok;
+	    if (_gcm) {
+		memcpy(nonce + 4, iv + iv_len - 8, 8);
+		ok = IPsecCipher::gcm_decrypt(gk, nonce, esp, header, payload, plen, payload + plen);
+	    } else {
+		IPsecCipher::hmac_sha256(hk, esp, stride - icv, digest);
+		ok = IPsecCipher::equal_tags(digest, esp + stride - icv, icv);
+		if (ok)
+		    IPsecCipher::aes_cbc_decrypt(gk.aes, iv, payload, plen);
+	    }
+	    if (!ok || (i == 0 && memcmp(payload, plain + b * plen, plen) != 0))
+		error(_kernel.c_str(), "round trip", plen);
+	}
+	Timestamp t2 = Timestamp::now();
+	encrypt_time += (t1 - t0).doubleval();
+	decrypt_time += (t2 - t1).doubleval();
+    }
+
+    double total = (double) n * _batch * plen;
+    _encrypt_rates.push_back(encrypt_time > 0 ? total / encrypt_time : 0);
+    _decrypt_rates.push_back(decrypt_time > 0 ? total / decrypt_time : 0);
+    delete[] buf;
+    delete[] plain;
+}
+
+void
+IPsecCipherBench::run_timer(Timer *)
+{
+    String original = IPsecCipher::kernel();
+    original = (original == "generic" ? "generic" : "aesni");
+
+    StringAccum sa;
+    for (int k = 0; k < nkernel_names; ++k)
+	if (IPsecCipher::set_kernel(kernel_names[k]) >= 0) {
+	    sa << (sa.length() ? " " : "") << kernel_names[k];
+	    check_vectors(kernel_names[k]);
+	    check_random(kernel_names[k]);
+	}
+    _kernels = sa.take_string();
+
+    IPsecCipher::set_kernel(_kernel.c_str());
+    _encrypt_rates.clear();
+    _decrypt_rates.clear();
+    for (int *lp = _lengths.begin(); lp != _lengths.end(); ++lp)
+	time_length(*lp);
+    IPsecCipher::set_kernel(original.c_str());
+
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+String
+IPsecCipherBench::read_handler(Element *e, void *thunk)
+{
+    IPsecCipherBench *b = static_cast<IPsecCipherBench *>(e);
+    switch ((intptr_t) thunk) {
+    case 1:
+	return String(b->_errors);
+    case 2:
+	return b->_kernels;
+    default: {
+	StringAccum sa;
+	sa << "kernel " << b->_kernel << '\n'
+	   << "transform " << (b->_gcm ? "aes-gcm" : "aes-cbc-hmac-sha256") << '\n';
+	for (int i = 0; i < b->_encrypt_rates.size(); ++i)
+	    sa << "encrypt_bytes_per_sec_" << b->_lengths[i] << ' '
+	       << (uint64_t) b->_encrypt_rates[i] << '\n'
+	       << "decrypt_bytes_per_sec_" << b->_lengths[i] << ' '
+	       << (uint64_t) b->_decrypt_rates[i] << '\n';
+	return sa.take_string();
+    }
+    }
+}
+
+void
+IPsecCipherBench::add_handlers()
+{
+    add_read_handler("results", read_handler, (void *) 0);
+    add_read_handler("errors", read_handler, (void *) 1);
+    add_read_handler("kernels", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel IPsecCipher)
+EXPORT_ELEMENT(IPsecCipherBench)
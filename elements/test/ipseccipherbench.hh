@@ -0,0 +1,133 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_IPSECCIPHERBENCH_HH
+#define CLICK_IPSECCIPHERBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+CLICK_DECLS
+
+/*
+=c
+
+IPsecCipherBench([I<keywords> TRANSFORM, LENGTHS, BYTES, BATCH, KERNEL, SEED, STOP])
+
+=s test
+
+measures and checks IPsec ESP cipher speed
+
+=d
+
+IPsecCipherBench measures how fast the ciphers behind IPsecCrypt encrypt and
+decrypt ESP payloads, and checks them.  It runs once, just after the router
+is initialized.
+
+IPsecCipherBench first checks every implementation this CPU can run, portable
+and accelerated, against published test vectors for AES, AES-GCM, SHA-256,
+and HMAC-SHA-256, and against the portable implementation on random inputs of
+many lengths.  The C<errors> handler counts the failures.  IPsecCipherBench
+then times the TRANSFORM transform on payloads of each length in LENGTHS,
+processing BATCH payloads at a time as IPsecCrypt does.  Decryption times
+include checking the ICV.
+
+Keyword arguments are:
+
+=over 8
+
+=item TRANSFORM
+
+Word.  C<aes-gcm> or C<aes-cbc-hmac-sha256>.  Default is C<aes-gcm>.
+
+=item LENGTHS
+
+Space-separated list of integers.  Payload lengths to time.  For
+aes-cbc-hmac-sha256, lengths are rounded up to a multiple of 16.  Default is
+"64 128 256 512 1024 1500".
+
+=item BYTES
+
+Integer.  Number of payload bytes to encrypt and decrypt for each length.
+Default is 100000000.
+
+=item BATCH
+
+Integer between 1 and 64.  Number of payloads processed together.  Default is
+16.
+
+=item KERNEL
+
+Word.  The implementation to time: "generic" or "aesni".  It is an error if
+this CPU cannot run KERNEL.  Default is the implementation IPsecCrypt uses.
+
+=item SEED
+
+Integer.  Random seed.  Default is 1.
+
+=item STOP
+
+Boolean.  If true, stop the driver when done.  Default is false.
+
+=back
+
+=h results read-only
+
+Returns the implementation and transform timed, and for each length, the
+number of payload bytes encrypted and decrypted per second.
+
+=h errors read-only
+
+Returns the number of failed checks.
+
+=h kernels read-only
+
+Returns the implementations this CPU can run, and hence those checked.
+
+=e
+
+  b :: IPsecCipherBench(TRANSFORM aes-cbc-hmac-sha256, STOP true);
+
+Run with "click -h b.results".
+
+=a IPsecCrypt */
+
+class IPsecCipherBench : public Element { public:
+
+    IPsecCipherBench();
+    ~IPsecCipherBench();
+
+    const char *class_name() const	{ return "IPsecCipherBench"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void add_handlers();
+
+    void run_timer(Timer *timer);
+
+  private:
+
+    enum { max_batch = 64 };
+
+    bool _gcm;
+    Vector<int> _lengths;
+    uint64_t _nbytes;
+    int _batch;
+    String _kernel;
+    uint32_t _seed;
+    bool _stop;
+    Timer _timer;
+
+    String _kernels;
+    Vector<double> _encrypt_rates;
+    Vector<double> _decrypt_rates;
+    uint32_t _errors;
+
+    inline uint32_t random();
+    void fill(uint8_t *data, int len);
+    void error(const char *kernel, const char *what, int len);
+    void check_vectors(const char *kernel);
+    void check_random(const char *kernel);
+    void time_length(int len);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,243 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * queuestresstest.{cc,hh} -- stress and benchmark elements for
+ * cross-thread queues
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "queuestresstest.hh"
+#include <click/confparse.hh>
+#include <click/router.hh>
+#include <click/error.hh>
+CLICK_DECLS
+
+QueueStressSource::QueueStressSource()
+    : _pushers(0), _stopping(false)
+{
+    _count = 0;
+    _ndone = 0;
+}
+
+QueueStressSource::~QueueStressSource()
+{
+}
+
+int
+QueueStressSource::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _nthreads = 1;
+    _limit = 1000000;
+    _batch = 1;
+    if (cp_va_kparse(conf, this, errh,
+		     "THREADS", 0, cpUnsigned, &_nthreads,
+		     "LIMIT", 0, cpUnsigned, &_limit,
+		     "BATCH", 0, cpUnsigned, &_batch,
+		     cpEnd) < 0)
+	return -1;
+    if (_nthreads == 0 || _batch == 0)
+	return errh->error("THREADS and BATCH must be positive");
+    return 0;
+}
+
+extern "C" {
+static void *queue_stress_pusher(void *arg)
+{
+    return QueueStressSource::pusher_thread(arg);
+}
+}
+
+void *
+QueueStressSource::pusher_thread(void *arg)
+{
+    Pusher *pusher = static_cast<Pusher *>(arg);
+    QueueStressSource *src = pusher->source;
+    while (!src->router()->running() && !src->_stopping)
+	/* do nothing */;
+
+    uint32_t seq = 0;
+    while (seq < src->_limit && !src->_stopping) {
+	PacketBatch batch;
+	for (uint32_t i = 0; i < src->_batch && seq < src->_limit; ++i, ++seq)
+	    if (WritablePacket *p = Packet::make(8)) {
+		uint32_t *data = reinterpret_cast<uint32_t *>(p->data());
+		data[0] = pusher->id;
+		data[1] = seq;
+		batch.append(p);
+	    }
+	uint32_t n = batch.count();
+	if (src->_batch == 1 && n == 1)
+	    src->output(0).push(batch.pop_front());
+	else
+	    src->output(0).push_batch(batch);
+	src->_count += n;
+    }
+
+    src->_ndone++;
+    return 0;
+}
+
+int
+QueueStressSource::initialize(ErrorHandler *errh)
+{
+    _pushers = new Pusher[_nthreads];
+    for (uint32_t i = 0; i < _nthreads; ++i) {
+	_pushers[i].source = this;
+	_pushers[i].id = i;
+	_pushers[i].started = false;
+    }
+    for (uint32_t i = 0; i < _nthreads; ++i) {
+	int err = pthread_create(&_pushers[i].thread, 0, queue_stress_pusher, &_pushers[i]);
+	if (err != 0)
+	    return errh->error("cannot start thread: %s", strerror(err));
+	_pushers[i].started = true;
+    }
+    return 0;
+}
+
+void
+QueueStressSource::cleanup(CleanupStage)
+{
+    if (_pushers) {
+	_stopping = true;
+	for (uint32_t i = 0; i < _nthreads; ++i)
+	    if (_pushers[i].started)
+		pthread_join(_pushers[i].thread, 0);
+	delete[] _pushers;
+	_pushers = 0;
+    }
+}
+
+String
+QueueStressSource::read_handler(Element *e, void *thunk)
+{
+    QueueStressSource *src = static_cast<QueueStressSource *>(e);
+    if (thunk)
+	return cp_unparse_bool(src->_ndone == src->_nthreads);
+    else
+	return String(src->_count.value());
+}
+
+void
+QueueStressSource::add_handlers()
+{
+    add_read_handler("count", read_handler, (void *) 0);
+    add_read_handler("done", read_handler, (void *) 1);
+}
+
+
+QueueStressSink::QueueStressSink()
+    : _task(this)
+{
+}
+
+QueueStressSink::~QueueStressSink()
+{
+}
+
+int
+QueueStressSink::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _batch = 1;
+    if (cp_va_kparse(conf, this, errh,
+		     "BATCH", 0, cpUnsigned, &_batch,
+		     cpEnd) < 0)
+	return -1;
+    if (_batch == 0)
+	return errh->error("BATCH must be positive");
+    return 0;
+}
+
+int
+QueueStressSink::initialize(ErrorHandler *)
+{
+    _task.initialize(this, true);
+    _signal = Notifier::upstream_empty_signal(this, 0, &_task);
+    _count = _errors = 0;
+    return 0;
+}
+
+void
+QueueStressSink::check(Packet *p)
+{
+    const uint32_t *data = reinterpret_cast<const uint32_t *>(p->data());
+    if (p->length() != 8 || data[0] > 0xFFFF)
+	++_errors;
+    else {
+	if ((int) data[0] >= _last_seq.size())
+	    _last_seq.resize(data[0] + 1, -1);
+	if ((int64_t) data[1] <= _last_seq[data[0]])
+	    ++_errors;
+	else
+	    _last_seq[data[0]] = data[1];
+    }
+    p->kill();
+}
+
+bool
+QueueStressSink::run_task(Task *)
+{
+    unsigned n = 0;
+    for (int i = 0; i < 8; ++i) {
+	if (_batch == 1) {
+	    if (Packet *p = input(0).pull()) {
+		check(p);
+		++n;
+	    } else
+		break;
+	} else {
+	    PacketBatch batch = input(0).pull_batch(_batch);
+	    if (!batch)
+		break;
+	    n += batch.count();
+	    while (Packet *p = batch.pop_front())
+		check(p);
+	}
+    }
+    if (n) {
+	_last = Timestamp::now();
+	if (!_count)
+	    _first = _last;
+	_count += n;
+    }
+    if (n || _signal)
+	_task.fast_reschedule();
+    return n > 0;
+}
+
+String
+QueueStressSink::read_handler(Element *e, void *thunk)
+{
+    QueueStressSink *sink = static_cast<QueueStressSink *>(e);
+    switch ((uintptr_t) thunk) {
+      case 0:
+	return String(sink->_count);
+      case 1:
+	return String(sink->_errors);
+      default: {
+	  double elapsed = (sink->_last - sink->_first).doubleval();
+	  return String(elapsed > 0 ? (uint64_t) (sink->_count / elapsed) : 0);
+      }
+    }
+}
+
+void
+QueueStressSink::add_handlers()
+{
+    add_read_handler("count", read_handler, (void *) 0);
+    add_read_handler("errors", read_handler, (void *) 1);
+    add_read_handler("rate", read_handler, (void *) 2);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel umultithread)
+EXPORT_ELEMENT(QueueStressSource QueueStressSink)
@@ -0,0 +1,164 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_QUEUESTRESSTEST_HH
+#define CLICK_QUEUESTRESSTEST_HH
+#include <click/element.hh>
+#include <click/task.hh>
+#include <click/notifier.hh>
+#include <click/atomic.hh>
+#include <pthread.h>
+CLICK_DECLS
+
+/*
+=c
+
+QueueStressSource([I<keywords> THREADS, LIMIT, BATCH])
+
+=s test
+
+pushes numbered packets from many threads, for queue stress tests
+
+=d
+
+QueueStressSource starts THREADS POSIX threads, separate from Click's own
+threads, once the router is running.  Each thread makes LIMIT 8-byte packets
+and pushes them to QueueStressSource's output as fast as it can, BATCH
+packets at a time.  Packet data holds the thread's number (0 to THREADS-1)
+followed by a sequence number, both in host byte order.  Connect the output
+to the queue under test, and pull the queue with QueueStressSink.
+
+Keyword arguments are:
+
+=over 8
+
+=item THREADS
+
+Integer.  Number of pushing threads.  Default is 1.
+
+=item LIMIT
+
+Integer.  Number of packets each thread pushes.  Default is 1000000.
+
+=item BATCH
+
+Integer.  Number of packets per push.  If 1, threads call push(); otherwise
+they call push_batch().  Default is 1.
+
+=back
+
+=h count read-only
+
+Returns the number of packets pushed so far.
+
+=h done read-only
+
+Returns true iff all threads have pushed LIMIT packets.
+
+=e
+
+  QueueStressSource(THREADS 4, BATCH 32) -> q :: MPSCQueue -> QueueStressSink;
+
+=a QueueStressSink, QueueThreadTest1 */
+
+class QueueStressSource : public Element { public:
+
+    QueueStressSource();
+    ~QueueStressSource();
+
+    const char *class_name() const		{ return "QueueStressSource"; }
+    const char *port_count() const		{ return PORTS_0_1; }
+    const char *processing() const		{ return PUSH; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    static void *pusher_thread(void *arg);
+
+  private:
+
+    struct Pusher {
+	QueueStressSource *source;
+	uint32_t id;
+	pthread_t thread;
+	bool started;
+    };
+
+    uint32_t _nthreads;
+    uint32_t _limit;
+    uint32_t _batch;
+    Pusher *_pushers;
+    atomic_uint32_t _count;
+    atomic_uint32_t _ndone;
+    volatile bool _stopping;
+
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+
+/*
+=c
+
+QueueStressSink([I<keywords> BATCH])
+
+=s test
+
+pulls and checks packets from QueueStressSource
+
+=d
+
+QueueStressSink pulls packets made by QueueStressSource, BATCH at a time,
+and checks that each pushing thread's packets arrive in increasing sequence
+order.  Dropped packets leave gaps in the sequence, but a duplicated,
+reordered, or corrupted packet counts as an error.  QueueStressSink uses
+notification to sleep when its input is empty.
+
+=h count read-only
+
+Returns the number of packets pulled.
+
+=h errors read-only
+
+Returns the number of packets that failed the checks.
+
+=h rate read-only
+
+Returns the number of packets pulled per second between the first and the
+most recent packet.
+
+=a QueueStressSource */
+
+class QueueStressSink : public Element { public:
+
+    QueueStressSink();
+    ~QueueStressSink();
+
+    const char *class_name() const		{ return "QueueStressSink"; }
+    const char *port_count() const		{ return PORTS_1_0; }
+    const char *processing() const		{ return PULL; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void add_handlers();
+
+    bool run_task(Task *task);
+
+  private:
+
+    Task _task;
+    NotifierSignal _signal;
+    unsigned _batch;
+    uint64_t _count;
+    uint64_t _errors;
+    Vector<int64_t> _last_seq;
+    Timestamp _first;
+    Timestamp _last;
+
+    void check(Packet *p);
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -0,0 +1,156 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * selectbench.{cc,hh} -- measure driver overhead versus selected fd count
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "selectbench.hh"
+#include <click/confparse.hh>
+#include <click/error.hh>
+#include <click/router.hh>
+#include <unistd.h>
+#include <fcntl.h>
+CLICK_DECLS
+
+SelectBench::SelectBench()
+    : _timer(this), _count(0)
+{
+    _ready_pipe[0] = _ready_pipe[1] = -1;
+}
+
+SelectBench::~SelectBench()
+{
+}
+
+int
+SelectBench::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    _nfds = 100;
+    _duration = Timestamp(1, 0);
+    _stop = false;
+    if (cp_va_kparse(conf, this, errh,
+		     "FDS", cpkP, cpInteger, &_nfds,
+		     "DURATION", 0, cpTimestamp, &_duration,
+		     "STOP", 0, cpBool, &_stop,
+		     cpEnd) < 0)
+	return -1;
+    if (_nfds < 0)
+	return errh->error("FDS must be >= 0");
+    return 0;
+}
+
+int
+SelectBench::initialize(ErrorHandler *errh)
+{
+    // The idle file descriptors are duplicates of one pipe's read end, so
+    // FDS idle descriptors cost FDS + 2 descriptors in all.
+    int idle_pipe[2];
+    if (pipe(idle_pipe) < 0 || pipe(_ready_pipe) < 0)
+	return errh->error("pipe: %s", strerror(errno));
+    for (int i = 0; i < _nfds; ++i) {
+	int fd = dup(idle_pipe[0]);
+	if (fd < 0) {
+	    close(idle_pipe[0]);
+	    close(idle_pipe[1]);
+	    return errh->error("dup: %s (%d file descriptors open)", strerror(errno), _fds.size());
+	}
+	_fds.push_back(fd);
+	add_select(fd, SELECT_READ);
+    }
+    // Keep idle_pipe[1] open so the duplicates never report end-of-file.
+    _fds.push_back(idle_pipe[0]);
+    _fds.push_back(idle_pipe[1]);
+
+    // The ready pipe always holds one unread byte.
+    if (write(_ready_pipe[1], "", 1) != 1)
+	return errh->error("write: %s", strerror(errno));
+    add_select(_ready_pipe[0], SELECT_READ);
+
+    _timer.initialize(this);
+    _start = Timestamp::now();
+    _timer.schedule_at(_start + _duration);
+    return 0;
+}
+
+void
+SelectBench::close_fds()
+{
+    for (int *fdp = _fds.begin(); fdp != _fds.end(); ++fdp) {
+	remove_select(*fdp, SELECT_READ);
+	close(*fdp);
+    }
+    _fds.clear();
+    if (_ready_pipe[0] >= 0) {
+	remove_select(_ready_pipe[0], SELECT_READ);
+	close(_ready_pipe[0]);
+	close(_ready_pipe[1]);
+	_ready_pipe[0] = _ready_pipe[1] = -1;
+    }
+}
+
+void
+SelectBench::cleanup(CleanupStage)
+{
+    close_fds();
+}
+
+void
+SelectBench::selected(int, int)
+{
+    ++_count;
+}
+
+void
+SelectBench::run_timer(Timer *)
+{
+    _end = Timestamp::now();
+    close_fds();
+    if (_stop)
+	router()->please_stop_driver();
+}
+
+String
+SelectBench::read_handler(Element *e, void *thunk)
+{
+    SelectBench *sb = static_cast<SelectBench *>(e);
+    Timestamp elapsed = (sb->_end ? sb->_end : Timestamp::now()) - sb->_start;
+    switch ((uintptr_t) thunk) {
+      case H_COUNT:
+	return String(sb->_count);
+      case H_RATE:
+	if (elapsed.doubleval() <= 0)
+	    return String(0);
+	return String((uint64_t) (sb->_count / elapsed.doubleval()));
+      case H_NS_PER_EVENT:
+	if (sb->_count == 0)
+	    return String(0);
+	return String((uint64_t) (elapsed.doubleval() * 1000000000 / sb->_count));
+      case H_DONE:
+	return cp_unparse_bool(sb->_end);
+      default:
+	return "<error>";
+    }
+}
+
+void
+SelectBench::add_handlers()
+{
+    add_read_handler("count", read_handler, (void *) H_COUNT);
+    add_read_handler("rate", read_handler, (void *) H_RATE);
+    add_read_handler("ns_per_event", read_handler, (void *) H_NS_PER_EVENT);
+    add_read_handler("done", read_handler, (void *) H_DONE);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel)
+EXPORT_ELEMENT(SelectBench)
@@ -0,0 +1,113 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_SELECTBENCH_HH
+#define CLICK_SELECTBENCH_HH
+#include <click/element.hh>
+#include <click/timer.hh>
+CLICK_DECLS
+
+/*
+=c
+
+SelectBench([FDS, I<keywords> DURATION, STOP])
+
+=s test
+
+measures driver loop overhead versus selected file descriptor count
+
+=d
+
+SelectBench measures how the cost of waiting for file descriptor events
+grows with the number of file descriptors a thread watches.
+
+At initialization time, SelectBench registers FDS idle file descriptors for
+readability, plus one more file descriptor that is always readable.  Every
+time the driver waits for file descriptor events, it therefore returns
+immediately with one ready file descriptor.  SelectBench counts these
+events for DURATION, then unregisters its file descriptors and reports the
+event rate.  With poll() or select(), each wait costs time proportional to
+FDS; with epoll or kqueue, it should cost roughly the same for any FDS.
+
+Keyword arguments are:
+
+=over 8
+
+=item FDS
+
+Integer.  The number of idle file descriptors.  Default is 100.
+
+=item DURATION
+
+Time.  How long to count.  Default is 1 second.
+
+=item STOP
+
+Boolean.  If true, stop the driver after DURATION.  Default is false.
+
+=back
+
+SelectBench is only available at user level.
+
+=h count read-only
+
+Returns the number of events counted.
+
+=h rate read-only
+
+Returns the number of events counted per second.
+
+=h ns_per_event read-only
+
+Returns the average driver time in nanoseconds between events.
+
+=h done read-only
+
+Returns true iff DURATION has elapsed.
+
+=e
+
+  SelectBench(FDS 1000, DURATION 2s, STOP true);
+
+Run with "click -h sb.rate" to print the event rate.  Compare rates for
+different FDS values, and for Click builds configured with different
+--enable-select options.
+
+*/
+
+class SelectBench : public Element { public:
+
+    SelectBench();
+    ~SelectBench();
+
+    const char *class_name() const	{ return "SelectBench"; }
+
+    int configure(Vector<String> &conf, ErrorHandler *errh);
+    int initialize(ErrorHandler *errh);
+    void cleanup(CleanupStage stage);
+    void add_handlers();
+
+    void selected(int fd, int mask);
+    void run_timer(Timer *timer);
+
+  private:
+
+    int _nfds;
+    bool _stop;
+    Timestamp _duration;
+    Timer _timer;
+
+    Vector<int> _fds;
+    int _ready_pipe[2];
+
+    uint64_t _count;
+    Timestamp _start;
+    Timestamp _end;
+
+    void close_fds();
+
+    enum { H_COUNT, H_RATE, H_NS_PER_EVENT, H_DONE };
+    static String read_handler(Element *e, void *thunk);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -24,6 +24,7 @@
 CLICK_DECLS
 
 TimerTest::TimerTest()
+    : _benchmark(0), _timers(0)
 {
 }
 
@@ -31,6 +32,77 @@ TimerTest::~TimerTest()
 {
 }
 
+int
+TimerTest::configure(Vector<String> &conf, ErrorHandler *errh)
+{
+    return cp_va_kparse(conf, this, errh,
+			"BENCHMARK", 0, cpUnsigned, &_benchmark,
+			cpEnd);
+}
+
+void
+TimerTest::benchmark_hook(Timer *t, void *user_data)
+{
+    TimerTest *tt = static_cast<TimerTest *>(user_data);
+    if (t->expiry() < tt->_last_expiry)
+	++tt->_nmisordered;
+    tt->_last_expiry = t->expiry();
+    if (++tt->_nfired == tt->_benchmark) {
+	Timestamp elapsed = Timestamp::now() - tt->_bench_start;
+	click_chatter("%s: run %u timers: %{timestamp}, %u out of order", tt->declaration().c_str(), tt->_benchmark, &elapsed, tt->_nmisordered);
+    }
+}
+
+void
+TimerTest::benchmark()
+{
+#if HAVE_TIMER_WHEEL
+    const char *impl = "wheel";
+#else
+    const char *impl = "heap";
+#endif
+    _timers = new Timer[_benchmark];
+    for (uint32_t i = 0; i < _benchmark; ++i) {
+	_timers[i].assign(benchmark_hook, this);
+	_timers[i].initialize(this, true);
+    }
+
+    Timestamp now = Timestamp::now(), t0, t1;
+    t0 = Timestamp::now();
+    for (uint32_t i = 0; i < _benchmark; ++i)
+	_timers[i].schedule_at(now + Timestamp::make_usec(0, click_random(0, 9999999)));
+    t1 = Timestamp::now() - t0;
+    click_chatter("%s: %s schedule %u timers: %{timestamp}", declaration().c_str(), impl, _benchmark, &t1);
+
+    t0 = Timestamp::now();
+    for (uint32_t i = 0; i < _benchmark; ++i)
+	_timers[i].schedule_at(now + Timestamp::make_usec(0, click_random(0, 9999999)));
+    t1 = Timestamp::now() - t0;
+    click_chatter("%s: %s reschedule %u timers: %{timestamp}", declaration().c_str(), impl, _benchmark, &t1);
+
+    t0 = Timestamp::now();
+    for (uint32_t i = 0; i < _benchmark; ++i)
+	_timers[i].unschedule();
+    t1 = Timestamp::now() - t0;
+    click_chatter("%s: %s unschedule %u timers: %{timestamp}", declaration().c_str(), impl, _benchmark, &t1);
+
+    // expire all timers at once, with distinct expiry times spread over the
+    // last 10 milliseconds; benchmark_hook reports the time, and checks that
+    // the timers run in expiry order
+    _nfired = _nmisordered = 0;
+    _last_expiry = Timestamp();
+    _bench_start = Timestamp::now();
+    for (uint32_t i = 0; i < _benchmark; ++i)
+	_timers[i].schedule_at(_bench_start - Timestamp::make_usec(0, click_random(0, 9999)));
+}
+
+void
+TimerTest::cleanup(CleanupStage)
+{
+    delete[] _timers;
+    _timers = 0;
+}
+
 int
 TimerTest::initialize(ErrorHandler *)
 {
@@ -42,6 +114,8 @@ TimerTest::initialize(ErrorHandler *)
     click_chatter("Initializing explicit_do_nothing_timer");
     explicit_do_nothing_timer.initialize(this);
 
+    if (_benchmark)
+	benchmark();
     return 0;
 }
 
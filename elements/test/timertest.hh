@@ -8,7 +8,7 @@ CLICK_DECLS
 /*
 =c
 
-TimerTest()
+TimerTest([I<keywords> BENCHMARK])
 
 =s test
 
@@ -19,6 +19,28 @@ runs regression tests for Timer
 TimerTest runs regression tests for Click's Timer class at initialization
 time. It does not route packets.
 
+Keyword arguments are:
+
+=over 8
+
+=item BENCHMARK
+
+Integer.  If positive, also benchmark the timer implementation with this
+many timers.  TimerTest schedules the timers at random expiry times within
+the next ten seconds, reschedules each of them, and unschedules them,
+reporting the time each phase took.  It then schedules them all to expire at
+once, at distinct times in the recent past, and reports how long the driver
+takes to run them and how many ran out of expiry order.  Default is 0.
+
+=back
+
+=e
+
+  TimerTest(BENCHMARK 1000000);
+
+Compare the results for Click builds configured with and without
+--enable-timer-wheel.
+
 */
 
 class TimerTest : public Element { public:
@@ -28,7 +50,21 @@ class TimerTest : public Element { public:
 
     const char *class_name() const		{ return "TimerTest"; }
 
+    int configure(Vector<String> &conf, ErrorHandler *errh);
     int initialize(ErrorHandler *);
+    void cleanup(CleanupStage stage);
+
+  private:
+
+    uint32_t _benchmark;
+    Timer *_timers;
+    uint32_t _nfired;
+    uint32_t _nmisordered;
+    Timestamp _last_expiry;
+    Timestamp _bench_start;
+
+    void benchmark();
+    static void benchmark_hook(Timer *t, void *user_data);
 
 };
 
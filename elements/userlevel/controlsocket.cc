@@ -24,6 +24,7 @@
 #include <click/error.hh>
 #include <click/timer.hh>
 #include <click/router.hh>
+#include <click/perthread.hh>
 #include <click/straccum.hh>
 #include <click/llrpc.h>
 #include <unistd.h>
@@ -33,7 +34,7 @@
 #include <fcntl.h>
 CLICK_DECLS
 
-const char ControlSocket::protocol_version[] = "1.3";
+const char ControlSocket::protocol_version[] = "1.4";
 
 struct ControlSocketErrorHandler : public ErrorHandler { public:
 
@@ -70,7 +71,8 @@ ControlSocketErrorHandler::emit(const String &str, void *, bool)
 
 
 ControlSocket::ControlSocket()
-  : _socket_fd(-1), _proxy(0), _full_proxy(0), _retry_timer(0)
+  : _socket_fd(-1), _proxy(0), _full_proxy(0), _retry_timer(0),
+    _sample_stamp(0), _sample_timer(0), _binary_code(CSERR_OK)
 {
 }
 
@@ -314,13 +316,25 @@ ControlSocket::cleanup(CleanupStage)
     delete _retry_timer;
     _retry_timer = 0;
   }
+  while (_subscriptions.size())
+    unsubscribe(_subscriptions.size() - 1);
+  if (_sample_timer) {
+    delete _sample_timer;
+    _sample_timer = 0;
+  }
 }
 
 int
 ControlSocket::message(int fd, int code, const String &s, bool continuation)
 {
   assert(code >= 100 && code <= 999);
-  if (fd >= 0 && !(_flags[fd] & WRITE_CLOSED))
+  if (fd >= 0 && (_flags[fd] & BINARY)) {
+    // binary_message_record() sends the collected messages
+    if (_binary_message)
+      _binary_message += "\n";
+    _binary_message += s;
+    _binary_code = code;
+  } else if (fd >= 0 && !(_flags[fd] & WRITE_CLOSED))
     _out_texts[fd] += String(code) + (continuation ? "-" : " ") + s.printable() + "\r\n";
   return ANY_ERR;
 }
@@ -703,6 +717,13 @@ ControlSocket::parse_command(int fd, const String &line)
     _in_texts[fd] = _in_texts[fd].substring(datalen);
     return llrpc_command(fd, words[1], data);
 
+  } else if (command == "BINARY") {
+    if (words.size() != 1)
+      return message(fd, CSERR_SYNTAX, "Wrong number of arguments");
+    message(fd, CSERR_OK, "Switching to binary protocol");
+    _flags[fd] |= BINARY;
+    return 0;
+
   } else if (command == "CLOSE" || command == "QUIT") {
     if (words.size() != 1)
       message(fd, CSERR_SYNTAX, "Bad command syntax");
@@ -722,6 +743,7 @@ ControlSocket::parse_command(int fd, const String &line)
     message(fd, CSERR_OK, "CHECKREAD handler       check if read handler is valid", true);
     message(fd, CSERR_OK, "CHECKWRITE handler      check if write handler is valid", true);
     message(fd, CSERR_OK, "LLRPC elt#number [len]  call LLRPC, pass len data bytes, return DATA", true);
+    message(fd, CSERR_OK, "BINARY                  switch to binary protocol", true);
     message(fd, CSERR_OK, "QUIT                    close connection");
     return 0;
 
@@ -729,6 +751,461 @@ ControlSocket::parse_command(int fd, const String &line)
     return message(fd, CSERR_UNIMPLEMENTED, "Command '" + command + "' unimplemented");
 }
 
+static inline void
+append_uint16(StringAccum &sa, uint16_t x)
+{
+    x = htons(x);
+    memcpy(sa.extend(2), &x, 2);
+}
+
+static inline void
+store_uint32(char *s, uint32_t x)
+{
+    x = htonl(x);
+    memcpy(s, &x, 4);
+}
+
+static inline uint16_t
+extract_uint16(const char *s)
+{
+    uint16_t x;
+    memcpy(&x, s, 2);
+    return ntohs(x);
+}
+
+static inline uint32_t
+extract_uint32(const char *s)
+{
+    uint32_t x;
+    memcpy(&x, s, 4);
+    return ntohl(x);
+}
+
+void
+ControlSocket::binary_record(StringAccum &sa, int code, int type,
+			     const char *data, int len)
+{
+    append_uint16(sa, code);
+    append_uint16(sa, type);
+    char *s = sa.extend(4 + len);
+    store_uint32(s, len);
+    memcpy(s + 4, data, len);
+}
+
+void
+ControlSocket::binary_message_record(StringAccum &sa)
+{
+    binary_record(sa, _binary_code, BINARY_TYPE_TEXT,
+		  _binary_message.data(), _binary_message.length());
+    _binary_code = CSERR_OK;
+    _binary_message = String();
+}
+
+void
+ControlSocket::binary_read(StringAccum &sa, int fd, const String &handlername,
+			   const String &param, bool typed)
+{
+  Element *e;
+  const Handler* h = parse_handler(fd, handlername, &e);
+  if (!h)
+    return binary_message_record(sa);
+  else if (!h->read_visible()) {
+    message(fd, CSERR_PERMISSION, "Handler '" + handlername + "' write-only");
+    return binary_message_record(sa);
+  }
+
+  // collect errors from proxy
+  ControlSocketErrorHandler errh;
+  _proxied_handler = h->name();
+  _proxied_errh = &errh;
+  String data = h->call_read(e, param, &errh);
+  _proxied_errh = 0;
+
+  if (errh.nerrors() > 0) {
+    transfer_messages(fd, CSERR_UNSPECIFIED, "Read handler '" + handlername + "' error", &errh);
+    return binary_message_record(sa);
+  }
+
+  binary_value_record(sa, data, typed);
+}
+
+void
+ControlSocket::binary_value_record(StringAccum &sa, const String &data,
+				   bool typed)
+{
+  if (typed) {
+    // send decimal integers, such as counts, without their text
+    const char *end = data.end();
+    while (end != data.begin() && isspace((unsigned char) end[-1]))
+      --end;
+    uint64_t u;
+    int64_t i;
+    if (cp_integer(data.begin(), end, 10, &u) == end && cp_errno == CPE_OK)
+      return binary_uint_record(sa, u);
+    else if (cp_integer(data.begin(), end, 10, &i) == end && cp_errno == CPE_OK) {
+      char buf[8];
+      store_uint32(buf, (uint64_t) i >> 32);
+      store_uint32(buf + 4, i);
+      return binary_record(sa, CSERR_OK, BINARY_TYPE_INT, buf, 8);
+    }
+  }
+
+  binary_record(sa, CSERR_OK, BINARY_TYPE_TEXT, data.data(), data.length());
+}
+
+void
+ControlSocket::binary_uint_record(StringAccum &sa, uint64_t u)
+{
+  char buf[8];
+  store_uint32(buf, u >> 32);
+  store_uint32(buf + 4, u);
+  binary_record(sa, CSERR_OK, BINARY_TYPE_UINT, buf, 8);
+}
+
+int
+ControlSocket::binary_command(StringAccum &sa, int fd, uint32_t id, int op,
+			      int flags, const Vector<String> &args)
+{
+    switch (op) {
+    case BINARY_READ:
+	if (args.size() < 1 || args.size() > 2)
+	    break;
+	binary_read(sa, fd, args[0], args.size() > 1 ? args[1] : String(),
+		    flags & BINARY_FLAG_TYPED);
+	return 1;
+    case BINARY_READMANY:
+	if (args.size() > 0xFFFF)
+	    break;
+	for (const String *a = args.begin(); a != args.end(); ++a)
+	    binary_read(sa, fd, *a, String(), flags & BINARY_FLAG_TYPED);
+	return args.size();
+    case BINARY_WRITE:
+	if (args.size() < 1 || args.size() > 2)
+	    break;
+	write_command(fd, args[0], args.size() > 1 ? args[1] : String());
+	binary_message_record(sa);
+	return 1;
+    case BINARY_CHECKREAD:
+    case BINARY_CHECKWRITE:
+	if (args.size() != 1)
+	    break;
+	check_command(fd, args[0], op == BINARY_CHECKWRITE);
+	binary_message_record(sa);
+	return 1;
+    case BINARY_SUBSCRIBE:
+	if (args.size() < 1 || args.size() > BINARY_MAX_SUBSCRIBE + 1)
+	    break;
+	return subscribe_command(sa, fd, id, flags, args);
+    case BINARY_UNSUBSCRIBE:
+	if (args.size() != 1)
+	    break;
+	return unsubscribe_command(sa, fd, args);
+    case BINARY_QUIT:
+	message(fd, CSERR_OK, "Goodbye!");
+	binary_message_record(sa);
+	_flags[fd] |= READ_CLOSED;
+	_in_texts[fd] = String();
+	return 1;
+    default:
+	message(fd, CSERR_UNIMPLEMENTED, "Operation " + String(op) + " unimplemented");
+	binary_message_record(sa);
+	return 1;
+    }
+    message(fd, CSERR_SYNTAX, "Wrong number of arguments");
+    binary_message_record(sa);
+    return 1;
+}
+
+int
+ControlSocket::parse_binary(int fd)
+{
+    // Returns 1 if a request was processed, 0 if none is complete.
+    String in = _in_texts[fd];
+    uint32_t len = (in.length() >= 4 ? extract_uint32(in.data()) : 0);
+    if (in.length() >= 4
+	&& (len < BINARY_HEADER_LEN - 4 || len > BINARY_MAX_FRAME)) {
+	if (_verbose)
+	    click_chatter("%s: bad frame length on connection %d", declaration().c_str(), fd);
+	_flags[fd] |= READ_CLOSED;
+	_in_texts[fd] = String();
+	return 0;
+    } else if (in.length() < 4 || (uint32_t) in.length() - 4 < len) {
+	if (_flags[fd] & READ_CLOSED)	// incomplete request
+	    _in_texts[fd] = String();
+	return 0;
+    }
+
+    const char *s = in.data() + 4, *end = s + len;
+    uint32_t id = extract_uint32(s);
+    int op = extract_uint16(s + 4);
+    int flags = extract_uint16(s + 6);
+    _in_texts[fd] = in.substring(end, in.end());
+
+    Vector<String> args;
+    bool ok = true;
+    for (s += 8; s != end; ) {
+	uint32_t alen;
+	if (end - s < 4 || (alen = extract_uint32(s)) > (uint32_t) (end - s - 4)) {
+	    ok = false;
+	    break;
+	}
+	args.push_back(in.substring(s + 4, s + 4 + alen));
+	s += 4 + alen;
+    }
+
+    StringAccum sa;
+    sa.extend(BINARY_HEADER_LEN);
+    int nrecords;
+    if (!ok) {
+	message(fd, CSERR_SYNTAX, "Syntax error in arguments");
+	binary_message_record(sa);
+	nrecords = 1;
+    } else
+	nrecords = binary_command(sa, fd, id, op, flags, args);
+
+    char *h = sa.data();
+    store_uint32(h, sa.length() - 4);
+    store_uint32(h + 4, id);
+    h[8] = op >> 8;
+    h[9] = op;
+    h[10] = nrecords >> 8;
+    h[11] = nrecords;
+    if (!(_flags[fd] & WRITE_CLOSED))
+	_out_texts[fd].append(sa.data(), sa.length());
+    return 1;
+}
+
+int
+ControlSocket::find_sample(int fd, const String &name)
+{
+    HashTable<String, int>::iterator it = _sample_map.find(name);
+    if (it)
+	return it.value();
+
+    Element *e;
+    const Handler *h = parse_handler(fd, name, &e);
+    if (!h)
+	return -1;
+    else if (!h->read_visible()) {
+	message(fd, CSERR_PERMISSION, "Handler '" + name + "' write-only");
+	return -1;
+    }
+
+    int si;
+    if (_samples_free.size()) {
+	si = _samples_free.back();
+	_samples_free.pop_back();
+    } else {
+	si = _samples.size();
+	_samples.push_back(Sample());
+    }
+    Sample &x = _samples[si];
+    x.name = name;
+    x.e = e;
+    x.h = h;
+    x.counter = h->read_counter(e);
+    x.count = 0;
+    x.refcount = 0;
+    x.stamp = _sample_stamp - 1;
+    _sample_map.set(name, si);
+    return si;
+}
+
+void
+ControlSocket::read_sample(Sample &x)
+{
+    if (x.stamp == _sample_stamp)
+	return;
+    x.stamp = _sample_stamp;
+    if (x.counter) {
+	// sum the counter's per-thread slots; don't call the handler
+	x.count = x.counter->value();
+	x.code = CSERR_OK;
+	return;
+    }
+    ControlSocketErrorHandler errh;
+    _proxied_handler = x.h->name();
+    _proxied_errh = &errh;
+    x.value = x.h->call_read(x.e, String(), &errh);
+    _proxied_errh = 0;
+    if (errh.nerrors() > 0) {
+	x.code = errh.error_code();
+	if (x.code == CSERR_OK)
+	    x.code = CSERR_UNSPECIFIED;
+	StringAccum sa;
+	for (const String *m = errh.messages().begin(); m != errh.messages().end(); ++m)
+	    sa << (m == errh.messages().begin() ? "" : "\n") << *m;
+	x.value = sa.take_string();
+    } else
+	x.code = CSERR_OK;
+}
+
+void
+ControlSocket::binary_sample_record(StringAccum &sa, const Sample &x,
+				    bool typed)
+{
+    if (x.code != CSERR_OK)
+	binary_record(sa, x.code, BINARY_TYPE_TEXT, x.value.data(), x.value.length());
+    else if (!x.counter)
+	binary_value_record(sa, x.value, typed);
+    else if (typed)
+	binary_uint_record(sa, x.count);
+    else {
+	String value(x.count);
+	binary_record(sa, CSERR_OK, BINARY_TYPE_TEXT, value.data(), value.length());
+    }
+}
+
+int
+ControlSocket::subscribe_command(StringAccum &sa, int fd, uint32_t id,
+				 int flags, const Vector<String> &args)
+{
+    Timestamp interval;
+    if (!cp_time(args[0], &interval) || interval < Timestamp::make_msec(0, 1)) {
+	message(fd, CSERR_SYNTAX, "Bad interval '" + args[0] + "'");
+	binary_message_record(sa);
+	return 1;
+    }
+
+    // replace any subscription with the same ID
+    for (int i = 0; i < _subscriptions.size(); ++i)
+	if (_subscriptions[i]->fd == fd && _subscriptions[i]->id == id) {
+	    unsubscribe(i);
+	    break;
+	}
+
+    Subscription *sub = new Subscription;
+    sub->fd = fd;
+    sub->id = id;
+    sub->typed = flags & BINARY_FLAG_TYPED;
+    sub->interval = interval;
+    sub->next = Timestamp::now() + interval;
+    // fresh values for the initial response
+    ++_sample_stamp;
+    for (const String *a = args.begin() + 1; a != args.end(); ++a) {
+	int si = find_sample(fd, *a);
+	sub->samples.push_back(si);
+	if (si < 0) {
+	    binary_message_record(sa);
+	    sub->values.push_back(String());
+	    sub->counts.push_back(0);
+	    continue;
+	}
+	Sample &x = _samples[si];
+	x.refcount++;
+	read_sample(x);
+	binary_sample_record(sa, x, sub->typed);
+	sub->values.push_back(x.value);
+	sub->counts.push_back(x.count);
+    }
+    _subscriptions.push_back(sub);
+
+    if (!_sample_timer) {
+	_sample_timer = new Timer(sample_hook, this);
+	_sample_timer->initialize(this);
+    }
+    if (!_sample_timer->scheduled() || sub->next < _sample_timer->expiry())
+	_sample_timer->schedule_at(sub->next);
+    return args.size() - 1;
+}
+
+int
+ControlSocket::unsubscribe_command(StringAccum &sa, int fd,
+				   const Vector<String> &args)
+{
+    uint32_t id;
+    int i = 0;
+    if (cp_integer(args[0], &id))
+	for (; i < _subscriptions.size(); ++i)
+	    if (_subscriptions[i]->fd == fd && _subscriptions[i]->id == id)
+		break;
+    if (i < _subscriptions.size()) {
+	unsubscribe(i);
+	message(fd, CSERR_OK, "Unsubscribed");
+    } else
+	message(fd, CSERR_SYNTAX, "No subscription '" + args[0] + "'");
+    binary_message_record(sa);
+    return 1;
+}
+
+void
+ControlSocket::unsubscribe(int i)
+{
+    Subscription *sub = _subscriptions[i];
+    for (int *sip = sub->samples.begin(); sip != sub->samples.end(); ++sip)
+	if (*sip >= 0 && --_samples[*sip].refcount == 0) {
+	    Sample &x = _samples[*sip];
+	    _sample_map.erase(x.name);
+	    x.name = x.value = String();
+	    _samples_free.push_back(*sip);
+	}
+    _subscriptions[i] = _subscriptions.back();
+    _subscriptions.pop_back();
+    delete sub;
+}
+
+void
+ControlSocket::send_update(Subscription *sub)
+{
+    int fd = sub->fd;
+    if ((_flags[fd] & WRITE_CLOSED) || _out_texts[fd].length() > (1 << 20))
+	return;			// values not sent will be compared next time
+
+    StringAccum sa;
+    sa.extend(BINARY_HEADER_LEN);
+    int nrecords = 0;
+    for (int i = 0; i < sub->samples.size(); ++i)
+	if (sub->samples[i] >= 0) {
+	    Sample &x = _samples[sub->samples[i]];
+	    read_sample(x);
+	    if (x.counter ? x.count == sub->counts[i] : x.value == sub->values[i])
+		continue;
+	    char buf[4];
+	    store_uint32(buf, i);
+	    binary_record(sa, CSERR_OK, BINARY_TYPE_INDEX, buf, 4);
+	    binary_sample_record(sa, x, sub->typed);
+	    sub->values[i] = x.value;
+	    sub->counts[i] = x.count;
+	    nrecords += 2;
+	}
+    if (!nrecords)
+	return;
+
+    char *h = sa.data();
+    store_uint32(h, sa.length() - 4);
+    store_uint32(h + 4, sub->id);
+    h[8] = 0;
+    h[9] = BINARY_UPDATE;
+    h[10] = nrecords >> 8;
+    h[11] = nrecords;
+    _out_texts[fd].append(sa.data(), sa.length());
+    flush_write(fd, _in_texts[fd].length() > 0);
+}
+
+void
+ControlSocket::sample_hook(Timer *t, void *thunk)
+{
+    // Handlers are read on this element's thread, except that per-thread
+    // counters are summed directly.  Each handler is read at most once per
+    // firing, however many due subscriptions name it.
+    ControlSocket *cs = static_cast<ControlSocket *>(thunk);
+    Timestamp now = Timestamp::now(), next;
+    ++cs->_sample_stamp;
+    for (int i = 0; i < cs->_subscriptions.size(); ++i) {
+	Subscription *sub = cs->_subscriptions[i];
+	if (sub->next <= now) {
+	    cs->send_update(sub);
+	    sub->next += sub->interval;
+	    if (sub->next <= now)	// fell behind; skip missed intervals
+		sub->next = now + sub->interval;
+	}
+	if (!next || sub->next < next)
+	    next = sub->next;
+    }
+    if (next)
+	t->schedule_at(next);
+}
+
 void
 ControlSocket::flush_write(int fd, bool read_needs_processing)
 {
@@ -803,8 +1280,8 @@ ControlSocket::selected(int fd, int)
 
     // read commands from socket (but only a bit on each select)
     if (!(_flags[fd] & READ_CLOSED)) {
-	char buf[2048];
-	int r = read(fd, buf, 2048);
+	char buf[16384];
+	int r = read(fd, buf, (_flags[fd] & BINARY ? 16384 : 2048));
 	if (r > 0)
 	    _in_texts[fd].append(buf, r);
 	else if (r == 0 || (r < 0 && errno != EAGAIN && errno != EINTR))
@@ -813,8 +1290,14 @@ ControlSocket::selected(int fd, int)
 
     // parse commands
     // 16.Jun.2004: process only one command each time through
+    // binary requests are pipelined, so process several at a time
     bool blocked = false;
-    if (_in_texts[fd].length()) {
+    if (_flags[fd] & BINARY) {
+	int n = 0;
+	while (n < 64 && parse_binary(fd))
+	    ++n;
+	blocked = (n < 64);
+    } else if (_in_texts[fd].length()) {
 	const char *in_text = _in_texts[fd].data();
 	int len = _in_texts[fd].length();
 	int pos = 0;
@@ -858,6 +1341,9 @@ ControlSocket::selected(int fd, int)
 	if (_verbose)
 	    click_chatter("%s: closed connection %d", declaration().c_str(), fd);
 	_flags[fd] = -1;
+	for (int i = _subscriptions.size() - 1; i >= 0; --i)
+	    if (_subscriptions[i]->fd == fd)
+		unsubscribe(i);
     }
 }
 
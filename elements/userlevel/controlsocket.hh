@@ -1,10 +1,14 @@
 #ifndef CLICK_CONTROLSOCKET_HH
 #define CLICK_CONTROLSOCKET_HH
 #include "elements/userlevel/handlerproxy.hh"
+#include <click/hashtable.hh>
+#include <click/timestamp.hh>
 CLICK_DECLS
 class ControlSocketErrorHandler;
+class StringAccum;
 class Timer;
 class Handler;
+class PerThreadCounter;
 
 /*
 =c
@@ -38,8 +42,8 @@ The server will accept lines terminated by CR, LF, or CRLF. Its response
 lines are always terminated by CRLF.
 
 When a connection is opened, the server responds by stating its protocol
-version number with a line like "Click::ControlSocket/1.3". The current
-version number is 1.3. Changes in minor version number will only add commands
+version number with a line like "Click::ControlSocket/1.4". The current
+version number is 1.4. Changes in minor version number will only add commands
 and functionality to this specification, not change existing functionality.
 
 ControlSocket supports hot-swapping, meaning you can change configurations
@@ -174,6 +178,13 @@ ControlSocket will not call an LLRPC unless it can determine (from the command
 number) how much data the LLRPC expects and returns. (Only "flat" LLRPCs may
 be called; they are declared using the _CLICK_IOC_[RWS]F macros.)
 
+=item BINARY
+
+Switch the connection to the binary protocol, described below.  The server
+responds with a single "200" line, after which all further input and output
+are binary frames.  The client need not wait for this response before
+sending frames.  Introduced in version 1.4 of the ControlSocket protocol.
+
 =item QUIT
 
 Close the connection.
@@ -204,6 +215,80 @@ Here are some of the particular error messages:
   530 Permission denied.
   540 No router installed.
 
+=head1 BINARY PROTOCOL
+
+The binary protocol lets a client pipeline requests and read many handlers
+with one request, and avoids most of the text protocol's parsing and
+formatting.  All integers are in network byte order.
+
+Each request is a frame consisting of a 12-byte header and a list of
+arguments.  The header holds a 4-byte frame length, which counts the bytes
+following the length field itself; a 4-byte request ID, chosen by the client;
+a 2-byte operation code; and 2 bytes of flags.  Each argument is a 4-byte
+length followed by that many bytes.  The operations are:
+
+=over 5
+
+=item 1 (READ): I<handler> [I<params>]
+
+Call a read handler.
+
+=item 2 (WRITE): I<handler> [I<data>]
+
+Call a write handler.
+
+=item 3 (READMANY): I<handler>...
+
+Call each of the read handlers, without parameters.
+
+=item 4 (CHECKREAD), 5 (CHECKWRITE): I<handler>
+
+Check whether a handler exists and is readable or writable.
+
+=item 6 (QUIT)
+
+Close the connection.
+
+=item 7 (SUBSCRIBE): I<interval> I<handler>...
+
+Subscribe to the read handlers' values.  I<Interval> is a time, such as
+"100ms", of at least one millisecond.  The response holds each handler's
+current value, as for READMANY.  After that, every I<interval>, the server
+sends an UPDATE frame with the request's ID if any handler's value has
+changed.  A second SUBSCRIBE with the same ID replaces the first.
+
+=item 8 (UNSUBSCRIBE): I<id>
+
+End the subscription whose SUBSCRIBE request had ID I<id>, given in decimal.
+
+=back
+
+UPDATE frames have operation code 9.  For each changed handler, an UPDATE
+holds a record of type 3, whose data is the handler's 4-byte index in the
+SUBSCRIBE request, followed by a record with the handler's new value.
+Handlers that could not be read when subscribing are never reported.  Each
+handler is read at most once per interval, however many subscriptions name
+it.  Handlers backed by per-thread counters, such as Queue's "drops", are
+not called at all: the server sums the counter's per-thread slots itself,
+without locking or formatting text.  Other handlers are called on
+ControlSocket's thread.  UPDATE frames are skipped while a connection has
+more than a megabyte of unsent output.  Subscriptions end when their
+connection closes, and do not survive hot-swapping.
+
+The server responds to every request with exactly one frame, in request
+order.  Its header holds the frame length, the request's ID and operation
+code, and a 2-byte record count.  Each record consists of a 2-byte response
+code, as in the text protocol; a 2-byte type; a 4-byte length; and that many
+bytes of data.  READMANY responses have one record per handler, in order;
+other responses have one record.  Records of type 0 hold text: a handler's
+value on success, or a message.  If a READ or READMANY request has flag 1
+set, then handler values that are decimal integers are returned as
+records of type 1 (8-byte signed integer, for negative values) or type 2
+(8-byte unsigned integer, for counters and other nonnegative values).
+
+A request whose length is less than 8 or more than 16 megabytes ends the
+connection.  LLRPCs are available only in the text protocol.
+
 ControlSocket is only available in user-level processes.
 
 =e
@@ -219,7 +304,7 @@ Returns the ControlSocket's port number.  Only available for TYPE TCP.
 Returns the ControlSocket's UNIX socket filename.  Only available for TYPE
 UNIX.
 
-=a ChatterSocket, KernelHandlerProxy */
+=a ChatterSocket, KernelHandlerProxy, ControlSocketBench */
 
 class ControlSocket : public Element { public:
 
@@ -252,6 +337,18 @@ class ControlSocket : public Element { public:
     CSERR_UNSPECIFIED		= HandlerProxy::CSERR_UNSPECIFIED      // 590
   };
 
+    // binary protocol
+    enum {
+	BINARY_READ = 1, BINARY_WRITE = 2, BINARY_READMANY = 3,
+	BINARY_CHECKREAD = 4, BINARY_CHECKWRITE = 5, BINARY_QUIT = 6,
+	BINARY_SUBSCRIBE = 7, BINARY_UNSUBSCRIBE = 8, BINARY_UPDATE = 9,
+	BINARY_FLAG_TYPED = 1,
+	BINARY_TYPE_TEXT = 0, BINARY_TYPE_INT = 1, BINARY_TYPE_UINT = 2,
+	BINARY_TYPE_INDEX = 3,
+	BINARY_HEADER_LEN = 12, BINARY_RECORD_HEADER_LEN = 8,
+	BINARY_MAX_FRAME = 1 << 24, BINARY_MAX_SUBSCRIBE = 32767
+    };
+
  private:
 
   String _unix_pathname;
@@ -274,7 +371,40 @@ class ControlSocket : public Element { public:
   int _retries;
   Timer *_retry_timer;
 
-  enum { READ_CLOSED = 1, WRITE_CLOSED = 2, ANY_ERR = -1 };
+  // handler subscriptions; samples are shared among subscriptions
+  struct Sample {
+    String name;
+    Element *e;
+    const Handler *h;
+    PerThreadCounter *counter;	// nonnull: read directly, not through h
+    int refcount;
+    unsigned stamp;
+    int code;
+    String value;
+    uint64_t count;		// counter's value, if counter
+  };
+  struct Subscription {
+    int fd;
+    uint32_t id;
+    bool typed;
+    Timestamp interval;
+    Timestamp next;
+    Vector<int> samples;	// indexes into _samples, -1 if unreadable
+    Vector<String> values;	// last values sent
+    Vector<uint64_t> counts;	// last counter values sent
+  };
+  Vector<Sample> _samples;
+  Vector<int> _samples_free;
+  HashTable<String, int> _sample_map;
+  Vector<Subscription *> _subscriptions;
+  unsigned _sample_stamp;
+  Timer *_sample_timer;
+
+  enum { READ_CLOSED = 1, WRITE_CLOSED = 2, BINARY = 4, ANY_ERR = -1 };
+
+  // messages for the current binary request
+  int _binary_code;
+  String _binary_message;
 
   static const char protocol_version[];
 
@@ -293,6 +423,21 @@ class ControlSocket : public Element { public:
     int check_command(int fd, const String &, bool write);
     int llrpc_command(int fd, const String &, String);
     int parse_command(int fd, const String &);
+    void binary_record(StringAccum &, int code, int type, const char *, int);
+    void binary_message_record(StringAccum &);
+    void binary_value_record(StringAccum &, const String &, bool typed);
+    void binary_uint_record(StringAccum &, uint64_t);
+    void binary_sample_record(StringAccum &, const Sample &, bool typed);
+    void binary_read(StringAccum &, int fd, const String &, const String &, bool typed);
+    int subscribe_command(StringAccum &, int fd, uint32_t id, int flags, const Vector<String> &);
+    int unsubscribe_command(StringAccum &, int fd, const Vector<String> &);
+    int find_sample(int fd, const String &);
+    void read_sample(Sample &);
+    void unsubscribe(int i);
+    void send_update(Subscription *);
+    static void sample_hook(Timer *, void *);
+    int binary_command(StringAccum &, int fd, uint32_t id, int op, int flags, const Vector<String> &);
+    int parse_binary(int fd);
     void flush_write(int fd, bool read_needs_processing);
 
   int report_proxy_errors(int fd, const String &);
@@ -6,6 +6,7 @@ CLICK_DECLS
 
 #define FAKE_PCAP_MAGIC			0xA1B2C3D4
 #define	FAKE_MODIFIED_PCAP_MAGIC	0xA1B2CD34
+#define FAKE_PCAP_MAGIC_NSEC		0xA1B23C4D	/* nanosecond timestamps */
 #define FAKE_PCAP_VERSION_MAJOR		2
 #define FAKE_PCAP_VERSION_MINOR		4
 
@@ -29,6 +30,19 @@ CLICK_DECLS
 /* Host data link types */
 #define FAKE_DLT_HOST_RAW		12	/* raw IP */
 
+/* pcapng block types */
+#define FAKE_PCAPNG_SHB			0x0A0D0D0A	/* section header */
+#define FAKE_PCAPNG_IDB			0x00000001	/* interface description */
+#define FAKE_PCAPNG_PB			0x00000002	/* packet (obsolete) */
+#define FAKE_PCAPNG_SPB			0x00000003	/* simple packet */
+#define FAKE_PCAPNG_EPB			0x00000006	/* enhanced packet */
+#define FAKE_PCAPNG_BYTE_ORDER_MAGIC	0x1A2B3C4D
+
+/* pcapng interface description options */
+#define FAKE_PCAPNG_OPT_ENDOFOPT	0
+#define FAKE_PCAPNG_OPT_IF_TSRESOL	9
+#define FAKE_PCAPNG_OPT_IF_TSOFFSET	14
+
 /*
  * The first record in the file contains saved values for some
  * of the flags used in the printout phases of tcpdump.
@@ -58,6 +58,9 @@ FromDevice::FromDevice()
 #if FROMDEVICE_LINUX
       _linux_fd(-1),
 #endif
+#if FROMDEVICE_RING
+      _ring(0), _ring_drops(0), _ring_timer(this),
+#endif
 #if FROMDEVICE_PCAP
       _pcap(0), _pcap_task(this), _pcap_complaints(0),
 #endif
@@ -77,8 +80,11 @@ FromDevice::configure(Vector<String> &conf, ErrorHandler *errh)
     _headroom = Packet::default_headroom;
     _headroom += (4 - (_headroom + 2) % 4) % 4; // default 4/2 alignment
     _force_ip = false;
-    String bpf_filter, capture, encap_type;
+    _burst = 1;
+    String bpf_filter, capture, encap_type, fanout_type;
     bool has_encap;
+    int fanout_group = -1;
+    uint32_t ring_size = 4 << 20;
     if (cp_va_kparse(conf, this, errh,
 		     "DEVNAME", cpkP+cpkM, cpString, &_ifname,
 		     "PROMISC", cpkP, cpBool, &promisc,
@@ -89,13 +95,19 @@ FromDevice::configure(Vector<String> &conf, ErrorHandler *errh)
 		     "BPF_FILTER", 0, cpString, &bpf_filter,
 		     "OUTBOUND", 0, cpBool, &outbound,
 		     "HEADROOM", 0, cpUnsigned, &_headroom,
+		     "BURST", 0, cpUnsigned, &_burst,
 		     "ENCAP", cpkC, &has_encap, cpWord, &encap_type,
+		     "RING_SIZE", 0, cpUnsigned, &ring_size,
+		     "FANOUT", 0, cpInteger, &fanout_group,
+		     "FANOUT_TYPE", 0, cpWord, &fanout_type,
 		     cpEnd) < 0)
 	return -1;
     if (_snaplen > 8190 || _snaplen < 14)
 	return errh->error("SNAPLEN out of range");
     if (_headroom > 8190)
 	return errh->error("HEADROOM out of range");
+    if (_burst == 0)
+	return errh->error("BURST must be positive");
 
 #if FROMDEVICE_PCAP
     _bpf_filter = bpf_filter;
@@ -122,6 +134,10 @@ FromDevice::configure(Vector<String> &conf, ErrorHandler *errh)
     else if (capture == "LINUX")
 	_capture = CAPTURE_LINUX;
 #endif
+#if FROMDEVICE_RING
+    else if (capture == "RING")
+	_capture = CAPTURE_RING;
+#endif
 #if FROMDEVICE_PCAP
     else if (capture == "PCAP")
 	_capture = CAPTURE_PCAP;
@@ -132,6 +148,32 @@ FromDevice::configure(Vector<String> &conf, ErrorHandler *errh)
     if (bpf_filter && _capture != CAPTURE_PCAP)
 	errh->warning("not using PCAP capture method, BPF filter ignored");
 
+#if FROMDEVICE_RING
+    if (ring_size == 0 || ring_size > 0x40000000)
+	return errh->error("RING_SIZE out of range");
+    _ring_size = ring_size;
+#endif
+#if FROMDEVICE_LINUX
+    _fanout_group = fanout_group;
+    _fanout_type = -1;
+    if (fanout_group >= 0 || fanout_type) {
+# if HAVE_PACKET_FANOUT
+	if (fanout_group < 0 || fanout_group > 65535)
+	    return errh->error("FANOUT must be between 0 and 65535");
+	if (_capture == CAPTURE_PCAP)
+	    return errh->error("FANOUT requires the LINUX or RING capture method");
+	_fanout_type = PacketRing::parse_fanout_type(fanout_type ? fanout_type : String("HASH"));
+	if (_fanout_type < 0)
+	    return errh->error("unknown FANOUT_TYPE %<%s%>", fanout_type.c_str());
+# else
+	return errh->error("FANOUT not supported on this platform");
+# endif
+    }
+#else
+    if (fanout_group >= 0 || fanout_type)
+	return errh->error("FANOUT not supported on this platform");
+#endif
+
     _sniffer = sniffer;
     _promisc = promisc;
     _outbound = outbound;
@@ -140,9 +182,11 @@ FromDevice::configure(Vector<String> &conf, ErrorHandler *errh)
 
 #if FROMDEVICE_LINUX
 int
-FromDevice::open_packet_socket(String ifname, ErrorHandler *errh)
+FromDevice::open_packet_socket(String ifname, ErrorHandler *errh, bool receive)
 {
-    int fd = socket(PF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    // A socket bound to protocol 0 receives no packets, only sends them.
+    int protocol = (receive ? htons(ETH_P_ALL) : 0);
+    int fd = socket(PF_PACKET, SOCK_RAW, protocol);
     if (fd == -1)
 	return errh->error("%s: socket: %s", ifname.c_str(), strerror(errno));
 
@@ -163,7 +207,7 @@ FromDevice::open_packet_socket(String ifname, ErrorHandler *errh)
     sockaddr_ll sa;
     memset(&sa, 0, sizeof(sa));
     sa.sll_family = AF_PACKET;
-    sa.sll_protocol = htons(ETH_P_ALL);
+    sa.sll_protocol = protocol;
     sa.sll_ifindex = ifindex;
     res = bind(fd, (struct sockaddr *)&sa, sizeof(sa));
     if (res != 0) {
@@ -292,11 +336,25 @@ FromDevice::initialize(ErrorHandler *errh)
 #endif
 
 #if FROMDEVICE_LINUX
-    if (_capture == CAPTURE_LINUX) {
+    if (_capture == CAPTURE_LINUX || _capture == CAPTURE_RING) {
 	_linux_fd = open_packet_socket(_ifname, errh);
 	if (_linux_fd < 0)
 	    return -1;
 
+# if FROMDEVICE_RING
+	if (_capture == CAPTURE_RING) {
+	    PrefixErrorHandler perrh(errh, _ifname + ": ");
+	    if (!(_ring = PacketRing::open_rx(_linux_fd, _ring_size, &perrh)))
+		return -1;
+	    _ring_timer.initialize(this);
+	}
+# endif
+# if HAVE_PACKET_FANOUT
+	if (_fanout_group >= 0
+	    && PacketRing::set_fanout(_linux_fd, _fanout_group, _fanout_type, errh) < 0)
+	    return -1;
+# endif
+
 	int promisc_ok = set_promiscuous(_linux_fd, _ifname, _promisc);
 	if (promisc_ok < 0) {
 	    if (_promisc)
@@ -323,6 +381,12 @@ FromDevice::cleanup(CleanupStage stage)
 {
     if (stage >= CLEANUP_INITIALIZED && !_sniffer)
 	KernelFilter::device_filter(_ifname, false, ErrorHandler::default_handler());
+#if FROMDEVICE_RING
+    if (_ring) {
+	_ring->release();
+	_ring = 0;
+    }
+#endif
 #if FROMDEVICE_LINUX
     if (_linux_fd >= 0) {
 	if (_was_promisc >= 0)
@@ -367,7 +431,7 @@ FromDevice_get_packet(u_char* clientdata,
     SET_EXTRA_LENGTH_ANNO(p, pkthdr->len - length);
 
     if (!fd->_force_ip || fake_pcap_force_ip(p, fd->_datalink))
-	fd->output(0).push(p);
+	fd->_batch.append(p);
     else
 	fd->checked_output_push(1, p);
 }
@@ -380,8 +444,9 @@ FromDevice::selected(int, int)
 {
 #if FROMDEVICE_PCAP
     if (_capture == CAPTURE_PCAP) {
-	// Read and push() at most one packet.
-	int r = pcap_dispatch(_pcap, 1, FromDevice_get_packet, (u_char *) this);
+	// Read and push() at most _burst packets.
+	int r = pcap_dispatch(_pcap, _burst, FromDevice_get_packet, (u_char *) this);
+	push_batch_out();
 	if (r > 0)
 	    _pcap_task.reschedule();
 	else if (r < 0 && ++_pcap_complaints < 5)
@@ -390,38 +455,85 @@ FromDevice::selected(int, int)
 #endif
 #if FROMDEVICE_LINUX
     if (_capture == CAPTURE_LINUX) {
-	struct sockaddr_ll sa;
-	socklen_t fromlen = sizeof(sa);
-	WritablePacket *p = Packet::make(_headroom, 0, _snaplen, 0);
-	int len = recvfrom(_linux_fd, p->data(), p->length(), MSG_TRUNC, (sockaddr *)&sa, &fromlen);
-	if (len > 0 && (sa.sll_pkttype != PACKET_OUTGOING || _outbound)) {
-	    if (len > _snaplen) {
-		assert(p->length() == (uint32_t)_snaplen);
-		SET_EXTRA_LENGTH_ANNO(p, len - _snaplen);
-	    } else
-		p->take(_snaplen - len);
-	    p->set_packet_type_anno((Packet::PacketType)sa.sll_pkttype);
-	    p->timestamp_anno().set_timeval_ioctl(_linux_fd, SIOCGSTAMP);
-	    p->set_mac_header(p->data());
-	    if (!_force_ip || fake_pcap_force_ip(p, _datalink))
-		output(0).push(p);
+	// Read at most _burst packets, then push() them as one batch.
+	for (unsigned n = 0; n < _burst; n++) {
+	    struct sockaddr_ll sa;
+	    socklen_t fromlen = sizeof(sa);
+	    WritablePacket *p = Packet::make(_headroom, 0, _snaplen, 0);
+	    int len = recvfrom(_linux_fd, p->data(), p->length(), MSG_TRUNC, (sockaddr *)&sa, &fromlen);
+	    if (len > 0 && (sa.sll_pkttype != PACKET_OUTGOING || _outbound)) {
+		if (len > _snaplen) {
+		    assert(p->length() == (uint32_t)_snaplen);
+		    SET_EXTRA_LENGTH_ANNO(p, len - _snaplen);
+		} else
+		    p->take(_snaplen - len);
+		p->set_packet_type_anno((Packet::PacketType)sa.sll_pkttype);
+		p->timestamp_anno().set_timeval_ioctl(_linux_fd, SIOCGSTAMP);
+		p->set_mac_header(p->data());
+		if (!_force_ip || fake_pcap_force_ip(p, _datalink))
+		    _batch.append(p);
+		else
+		    checked_output_push(1, p);
+	    } else {
+		p->kill();
+		if (len <= 0 && errno != EAGAIN)
+		    click_chatter("FromDevice(%s): recvfrom: %s", _ifname.c_str(), strerror(errno));
+		if (len <= 0)
+		    break;
+	    }
+	}
+	push_batch_out();
+    }
+#endif
+#if FROMDEVICE_RING
+    if (_capture == CAPTURE_RING) {
+	unsigned n;
+	for (n = 0; n < _burst; n++) {
+	    WritablePacket *p = _ring->rx();
+	    if (!p)
+		break;
+	    if (p->packet_type_anno() == Packet::OUTGOING && !_outbound)
+		p->kill();
+	    else if (!_force_ip || fake_pcap_force_ip(p, _datalink))
+		_batch.append(p);
 	    else
 		checked_output_push(1, p);
-	} else {
-	    p->kill();
-	    if (len <= 0 && errno != EAGAIN)
-		click_chatter("FromDevice(%s): recvfrom: %s", _ifname.c_str(), strerror(errno));
+	}
+	push_batch_out();
+	// The socket stays readable while we hold packets from the most
+	// recently filled block.  Rather than spin, poll the ring briefly.
+	if (n == 0) {
+	    remove_select(_linux_fd, SELECT_READ);
+	    _ring_timer.schedule_after_msec(1);
 	}
     }
 #endif
 }
 
+#if FROMDEVICE_RING
+void
+FromDevice::run_timer(Timer *)
+{
+    add_select(_linux_fd, SELECT_READ);
+}
+#endif
+
+void
+FromDevice::push_batch_out()
+{
+    if (_batch) {
+	_count += _batch.count();
+	output(0).push_batch(_batch);
+    }
+}
+
 #if FROMDEVICE_PCAP
 bool
 FromDevice::run_task(Task *)
 {
-    // Read and push() at most one packet.
-    int r = pcap_dispatch(_pcap, 1, FromDevice_get_packet, (u_char *) this);
+    // Read and push() at most _burst packets.
+    int r = pcap_dispatch(_pcap, _burst, FromDevice_get_packet, (u_char *) this);
+    push_batch_out();
     if (r > 0)
 	_pcap_task.fast_reschedule();
     else if (r < 0 && ++_pcap_complaints < 5)
@@ -438,6 +550,17 @@ FromDevice::kernel_drops(bool& known, int& max_drops) const
     // but for now, we just give up.
 #endif
     known = false, max_drops = -1;
+#if FROMDEVICE_RING
+    if (_capture == CAPTURE_RING) {
+	// PACKET_STATISTICS resets the kernel's counters on each read.
+	int d = _ring->rx_drops();
+	if (d >= 0) {
+	    FromDevice *mutable_this = const_cast<FromDevice *>(this);
+	    mutable_this->_ring_drops += d;
+	    known = true, max_drops = _ring_drops;
+	}
+    }
+#endif
 #if FROMDEVICE_PCAP
     if (_capture == CAPTURE_PCAP) {
 	struct pcap_stat stats;
@@ -485,5 +608,5 @@ FromDevice::add_handlers()
 }
 
 CLICK_ENDDECLS
-ELEMENT_REQUIRES(userlevel FakePcap KernelFilter)
+ELEMENT_REQUIRES(userlevel FakePcap KernelFilter PacketRing)
 EXPORT_ELEMENT(FromDevice)
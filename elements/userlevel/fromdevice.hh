@@ -4,6 +4,11 @@
 #include "elements/userlevel/kernelfilter.hh"
 #ifdef __linux__
 # define FROMDEVICE_LINUX 1
+# if HAVE_TPACKET_V3
+#  define FROMDEVICE_RING 1
+#  include <click/timer.hh>
+#  include "elements/userlevel/packetring.hh"
+# endif
 #endif
 #if HAVE_PCAP
 # define FROMDEVICE_PCAP 1
@@ -24,7 +29,7 @@ CLICK_DECLS
 
 =c
 
-FromDevice(DEVNAME [, I<keywords> SNIFFER, PROMISC, SNAPLEN, FORCE_IP, CAPTURE, BPF_FILTER, OUTBOUND, HEADROOM])
+FromDevice(DEVNAME [, I<keywords> SNIFFER, PROMISC, SNAPLEN, FORCE_IP, CAPTURE, BPF_FILTER, OUTBOUND, HEADROOM, BURST, RING_SIZE, FANOUT, FANOUT_TYPE])
 
 =s netdevices
 
@@ -82,9 +87,17 @@ but the IP header annotation has been set appropriately.) Default is false.
 =item CAPTURE
 
 Word.  Defines the capture method FromDevice will use to read packets from the
-kernel.  Linux targets generally support PCAP and LINUX; other targets support
-only PCAP.  Defaults to LINUX on Linux targets (unless you give a BPF_FILTER),
-and PCAP elsewhere.
+kernel.  Linux targets generally support PCAP, LINUX, and RING; other targets
+support only PCAP.  Defaults to LINUX on Linux targets (unless you give a
+BPF_FILTER), and PCAP elsewhere.
+
+The RING method reads packets from a TPACKET_V3 memory-mapped ring that the
+kernel shares with Click, without a system call or a copy per packet.  Emitted
+packets point directly into the ring.  A ring block is handed back to the
+kernel only after every packet from it has been killed, so downstream elements
+should not hold many packets for long; the kernel drops arriving packets when
+no ring block is free.  Packets have limited headroom, so elements that
+prepend headers will copy them.
 
 =item BPF_FILTER
 
@@ -108,12 +121,41 @@ false.
 Integer. Amount of bytes of headroom to leave before the packet data. Defaults
 to roughly 28.
 
+=item BURST
+
+Integer. Maximum number of packets to read each time the device is ready.
+Packets read together are pushed downstream as one batch. Defaults to 1.
+
+=item RING_SIZE
+
+Integer. Size in bytes of the receive ring used by the RING capture method.
+Rounded up to a multiple of 128 KiB. Defaults to 4 MiB.
+
+=item FANOUT
+
+Integer between 0 and 65535.  If given, join PACKET_FANOUT group FANOUT.  The
+kernel divides an interface's packets among the LINUX or RING FromDevice
+elements in the same group, rather than giving each of them a copy.  Give
+several FromDevice elements for one interface the same FANOUT, and assign them
+to different threads with StaticThreadSched, to spread receive processing over
+threads.  Linux only.
+
+=item FANOUT_TYPE
+
+Word.  How the kernel divides packets among a FANOUT group: HASH (by flow
+hash, so a flow stays on one element), LB (round robin), CPU (by receiving
+CPU), ROLLOVER, RND, or QM.  Defaults to HASH.
+
 =back
 
 =e
 
   FromDevice(eth0) -> ...
 
+  StaticThreadSched(fd0 0, fd1 1);
+  fd0 :: FromDevice(eth0, CAPTURE RING, FANOUT 7, BURST 32) -> ...
+  fd1 :: FromDevice(eth0, CAPTURE RING, FANOUT 7, BURST 32) -> ...
+
 =n
 
 FromDevice sets packets' extra length annotations as appropriate.
@@ -129,7 +171,7 @@ Resets "count" to zero.
 =h kernel_drops read-only
 
 Returns the number of packets dropped by the kernel, probably due to memory
-constraints, before FromDevice could get them. This may be an integer; the
+constraints or a full ring, before FromDevice could get them. This may be an integer; the
 notation C<"<I<d>">, meaning at most C<I<d>> drops; or C<"??">, meaning the
 number of drops is not known.
 
@@ -159,12 +201,15 @@ class FromDevice : public Element { public:
     inline int fd() const;
 
     void selected(int fd, int mask);
+#if FROMDEVICE_RING
+    void run_timer(Timer *);
+#endif
 #if FROMDEVICE_PCAP
     bool run_task(Task *);
 #endif
 
 #if FROMDEVICE_LINUX
-    static int open_packet_socket(String, ErrorHandler *);
+    static int open_packet_socket(String, ErrorHandler *, bool receive = true);
     static int set_promiscuous(int, String, bool);
 #endif
 
@@ -172,9 +217,19 @@ class FromDevice : public Element { public:
 
   private:
 
+    void push_batch_out();
+
 #if FROMDEVICE_LINUX
     int _linux_fd;
     unsigned char *_linux_packetbuf;
+    int _fanout_group;
+    int _fanout_type;
+#endif
+#if FROMDEVICE_RING
+    PacketRing *_ring;
+    uint32_t _ring_size;
+    unsigned _ring_drops;
+    Timer _ring_timer;
 #endif
 #if FROMDEVICE_PCAP
     pcap_t* _pcap;
@@ -200,7 +255,9 @@ class FromDevice : public Element { public:
     int _was_promisc : 2;
     int _snaplen;
     unsigned _headroom;
-    enum { CAPTURE_PCAP, CAPTURE_LINUX };
+    unsigned _burst;
+    PacketBatch _batch;
+    enum { CAPTURE_PCAP, CAPTURE_LINUX, CAPTURE_RING };
     int _capture;
 #if FROMDEVICE_PCAP
     String _bpf_filter;
@@ -28,6 +28,7 @@
 #include <click/handlercall.hh>
 #include <click/packet_anno.hh>
 #include <click/userutils.hh>
+#include <click/algorithm.hh>
 #if CLICK_NS
 # include <click/master.hh>
 #endif
@@ -47,7 +48,12 @@ CLICK_DECLS
 	( (((y)&0xff)<<8) | ((u_short)((y)&0xff00)>>8) )
 
 FromDump::FromDump()
-    : _packet(0), _end_h(0), _count(0), _timer(this), _task(this)
+    : _packet(0), _end_h(0), _count(0), _timer(this), _task(this),
+      _shard_end(0), _shard_stop(false), _shard_done(false),
+      _ng_pending(false), _index_dirty(false), _ring_wait(false)
+#if CLICK_FROMDUMP_READER
+    , _ring(0), _reader_started(false)
+#endif
 {
 }
 
@@ -85,6 +91,9 @@ FromDump::configure(Vector<String> &conf, ErrorHandler *errh)
     bool per_node = false;
 #endif
     _packet_filepos = 0;
+    _readahead = 0;
+    _shard = 0;
+    _nshards = 1;
 
     if (_ff.configure_keywords(conf, this, errh) < 0)
 	return -1;
@@ -105,9 +114,26 @@ FromDump::configure(Vector<String> &conf, ErrorHandler *errh)
 		     "PER_NODE", 0, cpBool, &per_node,
 #endif
 		     "FILEPOS", 0, cpFileOffset, &_packet_filepos,
+		     "READAHEAD", 0, cpUnsigned, &_readahead,
+		     "SHARD", 0, cpUnsigned, &_shard,
+		     "SHARDS", 0, cpUnsigned, &_nshards,
+		     "INDEX", 0, cpFilename, &_index_filename,
 		     cpEnd) < 0)
 	return -1;
 
+    // check reading modes
+    if (_shard >= _nshards)
+	return errh->error("'SHARD' must be less than 'SHARDS'");
+    if ((_nshards > 1) + (_packet_filepos != 0) + (bool) _index_filename > 1)
+	return errh->error("'SHARDS', 'FILEPOS', and 'INDEX' are mutually exclusive");
+#if CLICK_FROMDUMP_READER
+    if (_readahead > (1U << 24))
+	return errh->error("'READAHEAD' too large");
+#else
+    if (_readahead)
+	return errh->error("'READAHEAD' requires multithreading support");
+#endif
+
     // check sampling rate
     if (_sampling_prob > (1 << SAMPLING_SHIFT)) {
 	errh->warning("SAMPLE probability reduced to 1");
@@ -141,8 +167,10 @@ FromDump::configure(Vector<String> &conf, ErrorHandler *errh)
 
     if (stop && _end_h)
 	return errh->error("'END_CALL' and 'STOP' are mutually exclusive");
-    else if (stop)
+    else if (stop) {
 	_end_h = new HandlerCall(name() + ".stop");
+	_shard_stop = _nshards > 1;
+    }
     else if (_have_last_time && !_end_h)
 	_end_h = new HandlerCall(name() + ".active false");
 
@@ -185,12 +213,72 @@ swap_packet_header(const fake_pcap_pkthdr *hp, fake_pcap_pkthdr *outp)
     outp->len = SWAPLONG(hp->len);
 }
 
+static inline void
+packet_lengths(const fake_pcap_pkthdr *ph, int minor_version,
+	       uint32_t &len, uint32_t &caplen)
+{
+    // may need to swap 'caplen' and 'len' fields at or before version 2.3
+    if (minor_version > 3 || (minor_version == 3 && ph->caplen <= ph->len)) {
+	len = ph->len;
+	caplen = ph->caplen;
+    } else {
+	len = ph->caplen;
+	caplen = ph->len;
+    }
+}
+
+static inline Timestamp
+pcap_timestamp(const fake_bpf_timeval_union *ts, bool nsec)
+{
+    if (nsec)
+	return Timestamp::make_nsec(ts->tv.tv_sec, ts->tv.tv_usec);
+    else
+	return fake_bpf_timeval_union::make_timestamp(ts);
+}
+
+static Timestamp
+pcapng_timestamp(uint64_t t, int tsresol, int64_t tsoffset)
+{
+    // tsresol is the exponent of a negative power of 10, or, if its high bit
+    // is set, of 2
+    static const uint64_t pow10[] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL,
+	10000000000000000000ULL
+    };
+    int n = tsresol & 0x7F;
+    uint64_t sec, nsec;
+    if (tsresol & 0x80) {
+	if (n > 63)
+	    n = 63;
+	sec = t >> n;
+	uint64_t frac = t & ((1ULL << n) - 1);
+	if (n > 34)		// keep frac * 10^9 within 64 bits
+	    frac >>= n - 34, n = 34;
+	nsec = (frac * 1000000000ULL) >> n;
+    } else {
+	if (n > 19)
+	    n = 19;
+	sec = t / pow10[n];
+	uint64_t frac = t % pow10[n];
+	nsec = (n <= 9 ? frac * pow10[9 - n] : frac / pow10[n - 9]);
+    }
+    return Timestamp::make_nsec(sec + tsoffset, nsec);
+}
+
 FromDump *
 FromDump::hotswap_element() const
 {
+    // a reader thread, a shard, or an index can't hand its file over
+    if (_readahead || _nshards > 1 || _index_filename)
+	return 0;
     if (Element *e = Element::hotswap_element())
 	if (FromDump *fd = static_cast<FromDump *>(e->cast("FromDump")))
-	    if (fd->_ff.filename() == _ff.filename())
+	    if (fd->_ff.filename() == _ff.filename()
+		&& !fd->_readahead && fd->_nshards == 1 && !fd->_index_filename)
 		return fd;
     return 0;
 }
@@ -223,23 +311,49 @@ FromDump::initialize(ErrorHandler *errh)
     if (!fh)
 	return _ff.error(errh, "not a tcpdump file (too short)");
 
-    if (fh->magic == FAKE_PCAP_MAGIC || fh->magic == FAKE_MODIFIED_PCAP_MAGIC)
-	_swapped = false;
-    else {
-	swap_file_header(fh, &swapped_fh);
-	_swapped = true;
-	fh = &swapped_fh;
-    }
-    if (fh->magic != FAKE_PCAP_MAGIC && fh->magic != FAKE_MODIFIED_PCAP_MAGIC)
-	return _ff.error(errh, "not a tcpdump file (bad magic number)");
-    // compensate for extra crap appended to packet headers
-    _extra_pkthdr_crap = (fh->magic == FAKE_PCAP_MAGIC ? 0 : sizeof(fake_modified_pcap_pkthdr) - sizeof(fake_pcap_pkthdr));
+    _linktype = FAKE_DLT_NONE;
+    _pcapng = _nsec = false;
+    if (fh->magic == FAKE_PCAPNG_SHB) {
+	// pcapng: read the first section's interfaces
+	_pcapng = true;
+	_ff.shift_pos(-(int) sizeof(fake_pcap_file_header));
+	_extra_pkthdr_crap = 0;
+	_interfaces.clear();
+	_index_end = _ff.file_pos();
+	if (_index_filename && read_index(errh) < 0)
+	    return -1;
+	Record r;
+	int before = errh->nerrors();
+	(void) read_ng_record(r, errh, true);
+	if (errh->nerrors() != before)
+	    return -1;
+	_linktype = (_interfaces.size() ? _interfaces[0].linktype : FAKE_DLT_EN10MB);
+    } else {
+	if (fh->magic == FAKE_PCAP_MAGIC || fh->magic == FAKE_MODIFIED_PCAP_MAGIC
+	    || fh->magic == FAKE_PCAP_MAGIC_NSEC)
+	    _swapped = false;
+	else {
+	    swap_file_header(fh, &swapped_fh);
+	    _swapped = true;
+	    fh = &swapped_fh;
+	}
+	if (fh->magic != FAKE_PCAP_MAGIC && fh->magic != FAKE_MODIFIED_PCAP_MAGIC
+	    && fh->magic != FAKE_PCAP_MAGIC_NSEC)
+	    return _ff.error(errh, "not a tcpdump file (bad magic number)");
+	_nsec = (fh->magic == FAKE_PCAP_MAGIC_NSEC);
+	// compensate for extra crap appended to packet headers
+	_extra_pkthdr_crap = (fh->magic != FAKE_MODIFIED_PCAP_MAGIC ? 0 : sizeof(fake_modified_pcap_pkthdr) - sizeof(fake_pcap_pkthdr));
 
-    if (fh->version_major != FAKE_PCAP_VERSION_MAJOR)
-	return _ff.error(errh, "unknown major version %d", fh->version_major);
-    _minor_version = fh->version_minor;
-    // map possible host link types to global link types
-    _linktype = fake_pcap_canonical_dlt(fh->linktype, true);
+	if (fh->version_major != FAKE_PCAP_VERSION_MAJOR)
+	    return _ff.error(errh, "unknown major version %d", fh->version_major);
+	_minor_version = fh->version_minor;
+	// map possible host link types to global link types
+	_linktype = fake_pcap_canonical_dlt(fh->linktype, true);
+	_index_end = _ff.file_pos();
+	if (_index_filename && read_index(errh) < 0)
+	    return -1;
+    }
+    _packet_linktype = _linktype;
 
     // if forcing IP packets, check datalink type to ensure we understand it
     if (_force_ip) {
@@ -250,12 +364,268 @@ FromDump::initialize(ErrorHandler *errh)
 	_force_ip = true;
 
     // maybe skip ahead in the file
-    if (_packet_filepos != 0) {
-	int result = _ff.seek(_packet_filepos, errh);
+    int result = 0;
+    if (_nshards > 1)
+	result = find_shard(errh);
+    else if (_packet_filepos != 0) {
+	result = _ff.seek(_packet_filepos, errh);
 	_packet_filepos = 0;
-	return result;
-    } else
+    } else if (_index.size())
+	result = index_seek(errh);
+
+#if CLICK_FROMDUMP_READER
+    if (result >= 0 && _readahead)
+	result = start_reader(errh);
+#endif
+    return result;
+}
+
+bool
+FromDump::plausible_header(const uint8_t *data, Record &r) const
+{
+    fake_pcap_pkthdr ph;
+    memcpy(&ph, data, sizeof(ph));
+    if (_swapped)
+	swap_packet_header(&ph, &ph);
+    uint32_t len, caplen;
+    packet_lengths(&ph, _minor_version, len, caplen);
+    r.ts = pcap_timestamp(&ph.ts, _nsec);
+    r.len = len;
+    r.caplen = caplen;
+    r.skiplen = 0;
+    return (uint32_t) ph.ts.tv.tv_usec < (_nsec ? 1000000000U : 1000000U)
+	&& caplen <= 65535 && caplen <= len + 1 && len < (1U << 24);
+}
+
+int
+FromDump::find_shard(ErrorHandler *errh)
+{
+    off_t size = _ff.file_size();
+    if (size < 0)
+	return _ff.error(errh, "'SHARDS' requires an uncompressed regular file");
+    if (_pcapng)
+	return _ff.error(errh, "'SHARDS' requires a classic tcpdump file");
+    off_t first = _ff.file_pos();
+    off_t start = first + (size - first) * _shard / _nshards;
+    if (_shard + 1 < _nshards)
+	_shard_end = first + (size - first) * (_shard + 1) / _nshards;
+    if (_shard == 0)
 	return 0;
+
+    // Scan forward from 'start' for a record header that begins a chain of
+    // SHARD_CHAIN plausible headers.  A record begins within one maximum
+    // record length of any offset.  Times must be within a year of the first
+    // packet's, which rules out most headers that packet data could fake.  A
+    // shorter chain counts only if its last record ends exactly at EOF.
+    uint32_t hsize = sizeof(fake_pcap_pkthdr) + _extra_pkthdr_crap;
+    uint32_t max_record = hsize + 65535;
+    uint32_t want = (SHARD_CHAIN + 1) * max_record;
+    uint8_t *buf = new uint8_t[want];
+    Record r0, r;
+    int got = _ff.read_at(buf, hsize, first, errh);
+    if (got >= 0 && (got < (int) hsize || !plausible_header(buf, r0)))
+	start = size;		// no packets at all
+    else if (got >= 0)
+	got = _ff.read_at(buf, want, start, errh);
+    if (got < 0) {
+	delete[] buf;
+	return -1;
+    }
+
+    off_t found = -1;
+    for (uint32_t o = 0; o < max_record && found < 0; ++o) {
+	if (start + o >= size) {
+	    found = size;
+	    break;
+	}
+	uint32_t x = o;
+	int k;
+	for (k = 0; k < SHARD_CHAIN; ++k) {
+	    if (start + x == size)
+		k = SHARD_CHAIN - 1;	// chain ends exactly at the end of the file
+	    else if (start + x > size)
+		break;
+	    else if (x + hsize > (uint32_t) got
+		     || !plausible_header(buf + x, r)
+		     || (r.ts.sec() > r0.ts.sec() ? r.ts.sec() - r0.ts.sec() : r0.ts.sec() - r.ts.sec()) > 366 * 86400)
+		break;
+	    else
+		x += hsize + r.caplen;
+	}
+	if (k == SHARD_CHAIN)
+	    found = start + o;
+    }
+    delete[] buf;
+
+    if (found < 0)
+	return _ff.error(errh, "no packet boundary near offset %lld", (long long) start);
+    return _ff.seek(found, errh);
+}
+
+inline void
+FromDump::index_record(const Record &r, off_t end)
+{
+    // Extend the index only with records that continue where it ends.
+    if (r.filepos != _index_end)
+	return;
+    if (!_index.size() || r.filepos - _index.back().filepos >= INDEX_STEP)
+	_index.push_back(IndexEntry(r.filepos, _index_max));
+    if (!_index_have_first) {
+	_index_first = r.ts;
+	_index_have_first = true;
+    }
+    if (r.ts > _index_max)
+	_index_max = r.ts;
+    _index_end = end;
+    _index_dirty = true;
+}
+
+void
+FromDump::index_skip(off_t filepos, off_t end, const String &block)
+{
+    // Extend the index past a block without packets, remembering the
+    // section and interface blocks that later packets depend on.
+    if (filepos != _index_end)
+	return;
+    if (block) {
+	_index_block_pos.push_back(filepos);
+	_index_blocks.push_back(block);
+    }
+    _index_end = end;
+    _index_dirty = true;
+}
+
+int
+FromDump::read_index(ErrorHandler *errh)
+{
+    struct stat st;
+    if (!_ff.filename() || _ff.filename() == "-"
+	|| stat(_ff.filename().c_str(), &st) < 0)
+	return _ff.error(errh, "'INDEX' requires a named file");
+    _trace_size = st.st_size;
+    _trace_mtime = st.st_mtime;
+    _index_have_first = false;
+    if (access(_index_filename.c_str(), F_OK) < 0)
+	return 0;
+
+    // An index made for a different trace is ignored and rebuilt.
+    String text = file_string(_index_filename, errh);
+    Vector<String> words;
+    Vector<IndexEntry> index;
+    Vector<off_t> block_pos;
+    Vector<String> blocks;
+    off_t end = -1, pos;
+    Timestamp max, ts, first;
+    bool trace_ok = false, have_first = false, ok = true;
+    for (const char *s = text.begin(); s != text.end() && ok; ) {
+	const char *nl = find(s, text.end(), '\n');
+	words.clear();
+	cp_spacevec(text.substring(s, nl), words);
+	s = (nl == text.end() ? nl : nl + 1);
+	if (!words.size())
+	    continue;
+	else if (words[0] == "!trace") {
+	    int64_t size, mtime;
+	    trace_ok = (words.size() == 3 && cp_integer(words[1], &size)
+			&& cp_integer(words[2], &mtime)
+			&& size == (int64_t) _trace_size
+			&& mtime == (int64_t) _trace_mtime);
+	    ok = trace_ok;
+	} else if (words[0] == "!first")
+	    ok = have_first = (words.size() == 2 && cp_time(words[1], &first));
+	else if (words[0] == "!end")
+	    ok = (words.size() == 3 && cp_file_offset(words[1], &end)
+		  && cp_time(words[2], &max));
+	else if (words[0] == "!block") {
+	    ok = (words.size() == 3 && cp_file_offset(words[1], &pos));
+	    if (ok) {
+		block_pos.push_back(pos);
+		blocks.push_back(cp_unquote(words[2]));
+	    }
+	} else if (words[0][0] == '!')
+	    /* ignore other comments */;
+	else {
+	    ok = (words.size() == 2 && cp_file_offset(words[0], &pos)
+		  && cp_time(words[1], &ts));
+	    if (ok)
+		index.push_back(IndexEntry(pos, ts));
+	}
+    }
+
+    if (ok && trace_ok && end >= 0) {
+	_index.swap(index);
+	_index_block_pos.swap(block_pos);
+	_index_blocks.swap(blocks);
+	_index_end = end;
+	_index_max = max;
+	_index_first = first;
+	_index_have_first = have_first;
+    }
+    return 0;
+}
+
+int
+FromDump::index_seek(ErrorHandler *errh)
+{
+    if (!_have_first_time || !_index_have_first)
+	return 0;
+    Timestamp start = _first_time;
+    if (_first_time_relative)
+	start += _index_first;
+
+    // Find the last indexed position before which every record precedes
+    // START.  Max_before never decreases, so binary search works.
+    int l = 0, r = _index.size();
+    while (l < r) {
+	int m = (l + r) / 2;
+	if (_index[m].max_before < start)
+	    l = m + 1;
+	else
+	    r = m;
+    }
+    off_t pos = (l ? _index[l - 1].filepos : 0);
+    if (l == _index.size() && _index_max < start)
+	pos = _index_end;
+    if (pos <= _ff.file_pos())
+	return 0;
+
+    // Set times as if the first packet had been read.
+    prepare_times(_index_first);
+    if (_pcapng) {
+	_interfaces.clear();
+	for (int i = 0; i < _index_blocks.size() && _index_block_pos[i] < pos; ++i)
+	    if (!read_ng_block(_index_blocks[i], errh))
+		return -1;
+	_ng_pending = false;
+    }
+    return _ff.seek(pos, errh);
+}
+
+void
+FromDump::write_index()
+{
+    StringAccum sa;
+    sa << "!FromDump index 1\n"
+       << "!trace " << String((int64_t) _trace_size) << ' ' << String((int64_t) _trace_mtime) << '\n';
+    if (_index_have_first)
+	sa << "!first " << _index_first << '\n';
+    sa << "!end " << String((int64_t) _index_end) << ' ' << _index_max << '\n';
+    for (int i = 0; i < _index_blocks.size(); ++i)
+	sa << "!block " << String((int64_t) _index_block_pos[i]) << ' ' << cp_quote(_index_blocks[i]) << '\n';
+    for (const IndexEntry *it = _index.begin(); it != _index.end(); ++it)
+	sa << String((int64_t) it->filepos) << ' ' << it->max_before << '\n';
+
+    // write a new file, then replace the old one
+    String tmp = _index_filename + ".tmp";
+    FILE *f = fopen(tmp.c_str(), "w");
+    bool ok = f && fwrite(sa.data(), 1, sa.length(), f) == (size_t) sa.length();
+    if (f && fclose(f) != 0)
+	ok = false;
+    if (!ok || rename(tmp.c_str(), _index_filename.c_str()) < 0) {
+	click_chatter("%s: %s: %s", declaration().c_str(), _index_filename.c_str(), strerror(errno));
+	(void) unlink(tmp.c_str());
+    }
+    _index_dirty = false;
 }
 
 void
@@ -271,8 +641,15 @@ FromDump::take_state(Element *e, ErrorHandler *errh)
     _swapped = o->_swapped;
     _extra_pkthdr_crap = o->_extra_pkthdr_crap;
     _minor_version = o->_minor_version;
+    _pcapng = o->_pcapng;
+    _nsec = o->_nsec;
+    _interfaces = o->_interfaces;
+    _ng_pending = o->_ng_pending;
+    _ng_pending_pos = o->_ng_pending_pos;
+    _ng_pending_type = o->_ng_pending_type;
+    _ng_pending_length = o->_ng_pending_length;
 
-    _linktype = o->_linktype;
+    _linktype = _packet_linktype = o->_linktype;
     if (_linktype == FAKE_DLT_RAW)
 	_force_ip = true;
     else if (_force_ip && !fake_pcap_dlt_force_ipable(_linktype))
@@ -285,6 +662,11 @@ FromDump::take_state(Element *e, ErrorHandler *errh)
 void
 FromDump::cleanup(CleanupStage)
 {
+#if CLICK_FROMDUMP_READER
+    stop_reader();
+#endif
+    if (_index_dirty)
+	write_index();
     _ff.cleanup();
     if (_packet)
 	_packet->kill();
@@ -318,17 +700,18 @@ FromDump::prepare_times(const Timestamp &ts)
 }
 
 bool
-FromDump::read_packet(ErrorHandler *errh)
+FromDump::read_record(Record &r, ErrorHandler *errh)
 {
     fake_pcap_pkthdr swapped_ph;
     const fake_pcap_pkthdr *ph;
-    Timestamp ts = Timestamp::uninitialized_t();
-    int len, caplen, skiplen = 0;
-    Packet *p;
-    assert(!_packet);
 
-    // record file position
-    _packet_filepos = _ff.file_pos();
+    if (_pcapng)
+	return read_ng_record(r, errh);
+
+    // stop at the end of the shard
+    r.filepos = _ff.file_pos();
+    if (_shard_end && r.filepos >= _shard_end)
+	return false;
 
     // read the packet header
     if (!(ph = reinterpret_cast<const fake_pcap_pkthdr *>(_ff.get_aligned(sizeof(*ph), &swapped_ph))))
@@ -338,73 +721,458 @@ FromDump::read_packet(ErrorHandler *errh)
 	ph = &swapped_ph;
     }
 
-    // may need to swap 'caplen' and 'len' fields at or before version 2.3
-    if (_minor_version > 3 || (_minor_version == 3 && ph->caplen <= ph->len)) {
-	len = ph->len;
-	caplen = ph->caplen;
-    } else {
-	len = ph->caplen;
-	caplen = ph->len;
-    }
+    uint32_t len, caplen;
+    packet_lengths(ph, _minor_version, len, caplen);
 
     // check for errors
     // 3.Jul.2002 -- Angelos Stavrou discovered that tcptrace-generated
     // tcpdump files store an incorrect caplen. It's only off by one. Tcptrace
     // should be fixed, but we hack around the problem here, as does
     // tcpdump itself.
+    r.skiplen = 0;
     if (caplen > 65535) {
 	_ff.error(errh, "bad packet header; giving up");
 	return false;
     } else if (caplen > len) {
-	skiplen = caplen - len;
+	r.skiplen = caplen - len;
 	caplen = len;
     }
+    r.len = len;
+    r.caplen = caplen;
+    r.ts = pcap_timestamp(&ph->ts, _nsec);
+    r.linktype = _linktype;
 
     // compensate for modified pcap versions
     _ff.shift_pos(_extra_pkthdr_crap);
+    if (_index_filename)
+	index_record(r, _ff.file_pos() + r.caplen + r.skiplen);
+    return true;
+}
 
-    // check times
+inline uint16_t
+FromDump::ng16(const uint8_t *data) const
+{
+    uint16_t x;
+    memcpy(&x, data, 2);
+    return _swapped ? SWAPSHORT(x) : x;
+}
+
+inline uint32_t
+FromDump::ng32(const uint8_t *data) const
+{
+    uint32_t x;
+    memcpy(&x, data, 4);
+    return _swapped ? SWAPLONG(x) : x;
+}
+
+int64_t
+FromDump::ng64(const uint8_t *data) const
+{
+    uint8_t x[8];
+    for (int i = 0; i < 8; ++i)
+	x[i] = data[_swapped ? 7 - i : i];
+    int64_t v;
+    memcpy(&v, x, 8);
+    return v;
+}
+
+bool
+FromDump::read_ng_block(const String &block, ErrorHandler *errh)
+{
+    // Process a section header or interface description block.
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(block.data());
+    uint32_t type, bom;
+    memcpy(&type, data, 4);
+    if (type == FAKE_PCAPNG_SHB) {
+	memcpy(&bom, data + 8, 4);
+	_swapped = (bom != FAKE_PCAPNG_BYTE_ORDER_MAGIC);
+	if (ng16(data + 12) != 1) {
+	    _ff.error(errh, "unknown pcapng major version %d", ng16(data + 12));
+	    return false;
+	}
+	// interface numbers start over in each section
+	_interfaces.clear();
+	return true;
+    }
+
+    Interface i;
+    i.linktype = fake_pcap_canonical_dlt(ng16(data + 8), true);
+    i.snaplen = ng32(data + 12);
+    i.tsresol = 6;
+    i.tsoffset = 0;
+    for (int pos = 16; pos + 4 <= block.length() - 4; ) {
+	int code = ng16(data + pos), len = ng16(data + pos + 2);
+	if (code == FAKE_PCAPNG_OPT_ENDOFOPT || pos + 4 + len > block.length() - 4)
+	    break;
+	if (code == FAKE_PCAPNG_OPT_IF_TSRESOL && len == 1)
+	    i.tsresol = data[pos + 4];
+	else if (code == FAKE_PCAPNG_OPT_IF_TSOFFSET && len == 8)
+	    i.tsoffset = ng64(data + pos + 4);
+	pos += 4 + ((len + 3) & ~3);
+    }
+    _interfaces.push_back(i);
+    return true;
+}
+
+bool
+FromDump::read_ng_record(Record &r, ErrorHandler *errh, bool metadata_only)
+{
+    uint8_t hbuf[20];
+    const uint8_t *h;
+    while (1) {
+	uint32_t type, length;
+	r.filepos = _ff.file_pos();
+	if (_ng_pending && r.filepos == _ng_pending_pos + 8) {
+	    // initialize() stopped after this block's header
+	    r.filepos = _ng_pending_pos;
+	    type = _ng_pending_type;
+	    length = _ng_pending_length;
+	    _ng_pending = false;
+	} else {
+	    uint8_t raw[12];
+	    if (!(h = _ff.get_unaligned(8, hbuf, errh)))
+		return false;
+	    memcpy(raw, h, 8);
+	    memcpy(&type, raw, 4);
+
+	    if (type == FAKE_PCAPNG_SHB) {
+		// the byte-order magic sets the byte order of the section
+		if (!(h = _ff.get_unaligned(4, hbuf, errh)))
+		    return false;
+		memcpy(raw + 8, h, 4);
+		uint32_t bom;
+		memcpy(&bom, raw + 8, 4);
+		if (bom != FAKE_PCAPNG_BYTE_ORDER_MAGIC
+		    && bom != SWAPLONG(FAKE_PCAPNG_BYTE_ORDER_MAGIC)) {
+		    _ff.error(errh, "bad pcapng byte-order magic");
+		    return false;
+		}
+		bool swapped = (bom != FAKE_PCAPNG_BYTE_ORDER_MAGIC);
+		memcpy(&length, raw + 4, 4);
+		if (swapped)
+		    length = SWAPLONG(length);
+		if (length < 28 || (length & 3) || length > PCAPNG_MAX_BLOCK) {
+		    _ff.error(errh, "bad pcapng section header");
+		    return false;
+		}
+		String block = String((const char *) raw, 12) + _ff.get_string(length - 12, errh);
+		if (block.length() != (int) length || !read_ng_block(block, errh))
+		    return false;
+		if (_index_filename)
+		    index_skip(r.filepos, _ff.file_pos(), block);
+		continue;
+	    }
+
+	    type = ng32(raw);
+	    length = ng32(raw + 4);
+	    if (length < 12 || (length & 3) || length > PCAPNG_MAX_BLOCK) {
+		_ff.error(errh, "bad pcapng block header");
+		return false;
+	    }
+	    if (type == FAKE_PCAPNG_IDB) {
+		String block = String((const char *) raw, 8) + _ff.get_string(length - 8, errh);
+		if (block.length() != (int) length || length < 20
+		    || !read_ng_block(block, errh))
+		    return false;
+		if (_index_filename)
+		    index_skip(r.filepos, _ff.file_pos(), block);
+		continue;
+	    }
+	}
+
+	uint32_t len, caplen;
+	if (type == FAKE_PCAPNG_EPB || type == FAKE_PCAPNG_PB
+	    || type == FAKE_PCAPNG_SPB) {
+	    if (metadata_only) {
+		// leave the packet for read_record()
+		_ng_pending = true;
+		_ng_pending_pos = r.filepos;
+		_ng_pending_type = type;
+		_ng_pending_length = length;
+		return true;
+	    }
+	} else {
+	    // skip other blocks
+	    _ff.shift_pos(length - 8);
+	    if (_index_filename)
+		index_skip(r.filepos, r.filepos + length, String());
+	    continue;
+	}
+
+	if (type == FAKE_PCAPNG_SPB) {
+	    if (length < 16 || _interfaces.empty()
+		|| !(h = _ff.get_unaligned(4, hbuf, errh)))
+		goto bad_block;
+	    len = ng32(h);
+	    caplen = length - 16;
+	    if (caplen > len)
+		caplen = len;
+	    if (_interfaces[0].snaplen && caplen > _interfaces[0].snaplen)
+		caplen = _interfaces[0].snaplen;
+	    r.ts = Timestamp();
+	    r.linktype = _interfaces[0].linktype;
+	    r.skiplen = length - 12 - caplen;
+	} else {
+	    // enhanced and obsolete packet blocks differ in interface ID size
+	    if (length < 32 || !(h = _ff.get_unaligned(20, hbuf, errh)))
+		goto bad_block;
+	    uint32_t ifid = (type == FAKE_PCAPNG_EPB ? ng32(h) : ng16(h));
+	    uint64_t t = ((uint64_t) ng32(h + 4) << 32) | ng32(h + 8);
+	    caplen = ng32(h + 12);
+	    len = ng32(h + 16);
+	    if (ifid >= (uint32_t) _interfaces.size() || caplen > length - 32)
+		goto bad_block;
+	    const Interface &i = _interfaces[ifid];
+	    r.ts = pcapng_timestamp(t, i.tsresol, i.tsoffset);
+	    r.linktype = i.linktype;
+	    r.skiplen = length - 28 - caplen;
+	}
+	if (caplen > len) {
+	    r.skiplen += caplen - len;
+	    caplen = len;
+	}
+	r.len = len;
+	r.caplen = caplen;
+	if (_index_filename)
+	    index_record(r, _ff.file_pos() + r.caplen + r.skiplen);
+	return true;
+
+      bad_block:
+	_ff.error(errh, "bad pcapng packet block; giving up");
+	return false;
+    }
+}
+
+Packet *
+FromDump::record_packet(const Record &r, ErrorHandler *errh)
+{
+    Packet *p = _ff.get_packet(r.caplen, r.ts.sec(), r.ts.subsec(), errh);
+    if (p) {
+	SET_EXTRA_LENGTH_ANNO(p, r.len - r.caplen);
+	_ff.shift_pos(r.skiplen);
+	p->set_mac_header(p->data());
+    }
+    return p;
+}
+
+int
+FromDump::check_times(const Timestamp &ts, ErrorHandler *errh)
+{
+    // Returns 1 to emit the packet, 0 to skip it, or -1 to stop.
   check_times:
-    ts = fake_bpf_timeval_union::make_timestamp(&ph->ts);
     if (!_have_any_times)
 	prepare_times(ts);
     if (_have_first_time) {
-	if (ts < _first_time) {
-	    _ff.shift_pos(caplen + skiplen);
-	    return true;
-	} else
+	if (ts < _first_time)
+	    return 0;
+	else
 	    _have_first_time = false;
     }
     if (_have_last_time && ts >= _last_time) {
 	_have_last_time = false;
 	(void) _end_h->call_write(errh);
-	if (!_active) {
-	    _ff.shift_pos(caplen + skiplen);
-	    return false;
-	}
+	if (!_active)
+	    return -1;
 	// retry _last_time in case someone changed it
 	goto check_times;
     }
 
     // checking sampling probability
     if (_sampling_prob < (1 << SAMPLING_SHIFT)
-	&& (click_random() & ((1<<SAMPLING_SHIFT)-1)) >= _sampling_prob) {
-	_ff.shift_pos(caplen + skiplen);
-	return true;
+	&& (click_random() & ((1<<SAMPLING_SHIFT)-1)) >= _sampling_prob)
+	return 0;
+    return 1;
+}
+
+bool
+FromDump::read_packet(ErrorHandler *errh)
+{
+    Record r;
+    assert(!_packet);
+#if CLICK_FROMDUMP_READER
+    if (_ring)
+	return read_ring_packet(errh);
+#endif
+
+    // record file position
+    _packet_filepos = _ff.file_pos();
+
+    if (!read_record(r, errh))
+	return false;
+    int action = check_times(r.ts, errh);
+    if (action <= 0) {
+	_ff.shift_pos(r.caplen + r.skiplen);
+	return action == 0;
     }
 
     // create packet
-    p = _ff.get_packet(caplen, ts.sec(), ts.subsec(), errh);
-    if (!p)
-	return false;
-    SET_EXTRA_LENGTH_ANNO(p, len - caplen);
-    _ff.shift_pos(skiplen);
+    _packet = record_packet(r, errh);
+    _packet_linktype = r.linktype;
+    return _packet != 0;
+}
 
-    p->set_mac_header(p->data());
-    _packet = p;
-    return true;
+#if CLICK_FROMDUMP_READER
+extern "C" {
+static void *fromdump_reader_thread(void *arg)
+{
+    return FromDump::reader_thread(arg);
+}
+}
+
+int
+FromDump::start_reader(ErrorHandler *errh)
+{
+    uint32_t capacity = 2 * READER_BATCH;
+    while (capacity < _readahead)
+	capacity *= 2;
+    _ring = new RingSlot[capacity];
+    _ring_mask = capacity - 1;
+    _ring_head = _ring_tail = _ring_tail_cache = 0;
+    _reader_done = _reader_stop = false;
+    _ring_sleeping = _reader_sleeping = 0;
+    pthread_mutex_init(&_reader_lock, 0);
+    pthread_cond_init(&_reader_cond, 0);
+    int err = pthread_create(&_reader, 0, fromdump_reader_thread, this);
+    if (err != 0)
+	return _ff.error(errh, "cannot start reader thread: %s", strerror(err));
+    _reader_started = true;
+    return 0;
 }
 
+void
+FromDump::stop_reader()
+{
+    if (_reader_started) {
+	pthread_mutex_lock(&_reader_lock);
+	_reader_stop = true;
+	pthread_cond_signal(&_reader_cond);
+	pthread_mutex_unlock(&_reader_lock);
+	pthread_join(_reader, 0);
+	_reader_started = false;
+    }
+    if (_ring) {
+	for (uint32_t i = _ring_head; i != _ring_tail; ++i)
+	    _ring[i & _ring_mask].packet->kill();
+	delete[] _ring;
+	_ring = 0;
+	pthread_mutex_destroy(&_reader_lock);
+	pthread_cond_destroy(&_reader_cond);
+    }
+}
+
+void *
+FromDump::reader_thread(void *arg)
+{
+    static_cast<FromDump *>(arg)->run_reader();
+    return 0;
+}
+
+void
+FromDump::run_reader()
+{
+    // The reader thread owns _ff.  It fills the ring a batch at a time, and
+    // once the ring is nearly full, sleeps until the router thread has
+    // emptied half of it.
+    uint32_t capacity = _ring_mask + 1, tail = _ring_tail;
+    bool more = true;
+    while (more && !_reader_stop) {
+	if (capacity - (tail - _ring_head) < READER_BATCH) {
+	    pthread_mutex_lock(&_reader_lock);
+	    while (!_reader_stop) {
+		_reader_sleeping.swap(1);
+		if (capacity - (tail - _ring_head) >= capacity / 2)
+		    break;
+		pthread_cond_wait(&_reader_cond, &_reader_lock);
+	    }
+	    _reader_sleeping = 0;
+	    pthread_mutex_unlock(&_reader_lock);
+	    continue;
+	}
+
+	uint32_t n;
+	for (n = 0; n < READER_BATCH; ++n) {
+	    Record r;
+	    Packet *p;
+	    if (!read_record(r, 0) || !(p = record_packet(r, 0))) {
+		more = false;
+		break;
+	    }
+	    RingSlot &slot = _ring[(tail + n) & _ring_mask];
+	    slot.packet = p;
+	    slot.filepos = r.filepos;
+	    slot.linktype = r.linktype;
+	}
+	tail += n;
+	click_order_fence();
+	_ring_tail = tail;
+	if (!more) {
+	    click_order_fence();
+	    _reader_done = true;
+	}
+
+	if (_ring_sleeping.compare_and_swap(1, 0)) {
+	    if (output_is_push(0))
+		_task.reschedule();
+	    else
+		_notifier.wake();
+	}
+    }
+}
+
+bool
+FromDump::read_ring_packet(ErrorHandler *errh)
+{
+    _ring_wait = false;
+  again:
+    uint32_t head = _ring_head;
+    if (head == _ring_tail_cache) {
+	bool done = _reader_done;
+	click_order_fence();
+	if (head == (_ring_tail_cache = _ring_tail)) {
+	    if (done)
+		return false;
+	    // Sleep, then look once more in case the reader published packets
+	    // before it could see _ring_sleeping.
+	    if (!output_is_push(0))
+		_notifier.sleep();
+	    _ring_sleeping.swap(1);
+	    if (head == _ring_tail && !_reader_done) {
+		_ring_wait = true;
+		return true;
+	    }
+	    _ring_sleeping = 0;
+	    if (!output_is_push(0))
+		_notifier.wake();
+	    goto again;
+	}
+    }
+
+    RingSlot &slot = _ring[head & _ring_mask];
+    Packet *p = slot.packet;
+    _packet_filepos = slot.filepos;
+    _packet_linktype = slot.linktype;
+    click_order_fence();
+    _ring_head = ++head;
+
+    // wake the reader once the ring is half empty
+    if ((head & (READER_BATCH - 1)) == 0
+	&& _ring_tail_cache - head <= (_ring_mask + 1) / 2
+	&& _reader_sleeping.compare_and_swap(1, 0)) {
+	pthread_mutex_lock(&_reader_lock);
+	pthread_cond_signal(&_reader_cond);
+	pthread_mutex_unlock(&_reader_lock);
+    }
+
+    int action = check_times(p->timestamp_anno(), errh);
+    if (action > 0) {
+	_packet = p;
+	return true;
+    }
+    p->kill();
+    return action == 0;
+}
+#endif
+
 void
 FromDump::run_timer(Timer *)
 {
@@ -441,14 +1209,16 @@ FromDump::run_task(Task *)
 	    return false;
 	}
     }
-    if (_packet && _force_ip && !fake_pcap_force_ip(_packet, _linktype)) {
+    if (_packet && _force_ip && !fake_pcap_force_ip(_packet, _packet_linktype)) {
 	checked_output_push(1, _packet);
 	_packet = 0;
     }
-    if (!_packet && ++retry_count < 16)
+    if (!_packet && !_ring_wait && ++retry_count < 16)
 	goto again;
 
-    _task.fast_reschedule();
+    // with READAHEAD, the reader reschedules us when packets arrive
+    if (!_ring_wait)
+	_task.fast_reschedule();
     if (_packet) {
 	output(0).push(_packet);
 	_count++;
@@ -467,8 +1237,11 @@ FromDump::pull(int)
     }
 
     bool more = true;
-    if (!_packet)
+    if (!_packet) {
 	more = read_packet(0);
+	if (_ring_wait)		// the reader will wake us
+	    return 0;
+    }
     if (_packet && _timing) {
 	Timestamp now = Timestamp::now();
 	Timestamp t = _packet->timestamp_anno() + _time_offset;
@@ -481,7 +1254,7 @@ FromDump::pull(int)
 	    return 0;
 	}
     }
-    if (_packet && _force_ip && !fake_pcap_force_ip(_packet, _linktype)) {
+    if (_packet && _force_ip && !fake_pcap_force_ip(_packet, _packet_linktype)) {
 	checked_output_push(1, _packet);
 	_packet = 0;
     }
@@ -518,6 +1291,23 @@ FromDump::read_handler(Element *e, void *thunk)
     }
 }
 
+bool
+FromDump::last_shard_done()
+{
+    // Shards run on different threads and may finish together.  Each marks
+    // itself done before looking at the others, so at least one of the last
+    // two to finish sees that all are done.
+    _shard_done = true;
+    click_fence();
+    for (int i = 0; i < router()->nelements(); ++i)
+	if (FromDump *fd = static_cast<FromDump *>(router()->element(i)->cast("FromDump")))
+	    if (fd->_shard_stop && !fd->_shard_done
+		&& fd->_nshards == _nshards
+		&& fd->_ff.filename() == _ff.filename())
+		return false;
+    return true;
+}
+
 int
 FromDump::write_handler(const String &s_in, Element *e, void *thunk, ErrorHandler *errh)
 {
@@ -534,7 +1324,8 @@ FromDump::write_handler(const String &s_in, Element *e, void *thunk, ErrorHandle
       }
       case H_STOP:
 	fd->set_active(false);
-	fd->router()->please_stop_driver();
+	if (!fd->_shard_stop || fd->last_shard_done())
+	    fd->router()->please_stop_driver();
 	return 0;
       case H_EXTEND_INTERVAL: {
 	  Timestamp ts;
@@ -562,7 +1353,7 @@ FromDump::write_handler(const String &s_in, Element *e, void *thunk, ErrorHandle
 void
 FromDump::add_handlers()
 {
-    _ff.add_handlers(this, true);
+    _ff.add_handlers(this, !_readahead);
     add_read_handler("sampling_prob", read_handler, (void *)H_SAMPLING_PROB);
     add_data_handlers("active", Handler::OP_READ | Handler::CHECKBOX, &_active);
     add_write_handler("active", write_handler, (void *)H_ACTIVE);
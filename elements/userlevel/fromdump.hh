@@ -6,13 +6,18 @@
 #include <click/timer.hh>
 #include <click/notifier.hh>
 #include "fromfile.hh"
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+# include <click/atomic.hh>
+# include <pthread.h>
+# define CLICK_FROMDUMP_READER 1
+#endif
 CLICK_DECLS
 class HandlerCall;
 
 /*
 =c
 
-FromDump(FILENAME [, I<keywords> STOP, TIMING, SAMPLE, FORCE_IP, START, START_AFTER, END, END_AFTER, INTERVAL, END_CALL, FILEPOS, MMAP])
+FromDump(FILENAME [, I<keywords> STOP, TIMING, SAMPLE, FORCE_IP, START, START_AFTER, END, END_AFTER, INTERVAL, END_CALL, FILEPOS, MMAP, READAHEAD, SHARD, SHARDS, INDEX])
 
 =s traces
 
@@ -24,8 +29,14 @@ Reads packets from a file produced by `tcpdump -w FILENAME' or ToDump and
 emits them from the output, optionally stopping the driver when there are no
 more packets.
 
-FromDump also transparently reads gzip- and bzip2-compressed tcpdump files, if
-you have zcat(1) and bzcat(1) installed.
+FromDump reads classic tcpdump files, with microsecond or nanosecond
+timestamps, and pcapng files.  A pcapng file may contain several sections and
+interfaces, each with its own encapsulation and timestamp resolution.
+
+FromDump also transparently reads gzip-, bzip2-, and zstd-compressed files.
+If Click was built with zlib or libzstd, gzip or zstd data is decompressed
+within Click, even from the standard input.  Otherwise FromDump runs zcat(1),
+bzcat(1), or zstd(1).
 
 Keyword arguments are:
 
@@ -108,10 +119,45 @@ This can result in slightly better performance on some machines. FromDump's
 regular file discipline is pretty optimized, so the difference is often small
 in practice. Default is true on most operating systems, but false on Linux.
 
+=item READAHEAD
+
+Unsigned integer. If nonzero, FromDump starts a reader thread that parses
+tcpdump records into packets ahead of the router, keeping up to READAHEAD
+packets ready. The router thread then only checks times and sampling and emits
+the packets, so trace reading overlaps with the rest of the configuration.
+Requires multithreading support. Default is 0, which reads packets on the
+router thread.
+
+=item SHARDS
+
+Unsigned integer. Split the file into SHARDS byte ranges of roughly equal size,
+and read only the packets whose records start in the range selected by SHARD.
+Each shard finds its first record by scanning forward from the start of its
+range for a run of plausible record headers, so SHARDS FromDump elements with
+SHARD 0 through SHARDS-1 together read every packet in the file exactly once.
+The file must be a regular, uncompressed file. Default is 1.
+
+=item SHARD
+
+Unsigned integer less than SHARDS. The byte range to read. Default is 0.
+
+=item INDEX
+
+Filename.  A time index for the dump, which lets START and START_AFTER seek
+directly to the first wanted packet instead of reading every earlier record.
+If the index file does not exist, or was made for a different version of the
+dump, FromDump builds a new index as it reads and writes it when the router
+is cleaned up.  An index built by a run that stopped early covers the part of
+the dump that run read; later runs extend it.  Offsets are positions in the
+uncompressed dump, so seeking in a compressed dump still decompresses the data
+it skips, but does not parse it.
+
 =back
 
 You can supply at most one of START and START_AFTER, and at most one of END,
-END_AFTER, and INTERVAL.
+END_AFTER, and INTERVAL. SHARDS, FILEPOS, and INDEX are mutually exclusive.
+START_AFTER and END_AFTER count from the first packet in the shard. SHARDS
+requires a classic tcpdump file.
 
 Only available in user-level processes.
 
@@ -130,6 +176,19 @@ contains more packets.
 If FromDump uses mmap, then a corrupt file might cause Click to crash with a
 segmentation violation.
 
+To analyze one large trace on several cores, give each thread a shard and its
+own copy of the analysis path. A shard with STOP stops the driver once every
+FromDump in the router that reads the same file, with the same SHARDS and with
+STOP, has finished; the shards need not all be present. For example, with C<click --threads=4>:
+
+  FromDump(big.pcap, SHARD 0, SHARDS 4, STOP true, FORCE_IP true)
+      -> AggregateIPFlows -> ToIPSummaryDump(part0, CONTENTS ...);
+  ... likewise for SHARD 1, 2, and 3 ...
+  StaticThreadSched(...)
+
+Concatenating the shards' outputs in shard order gives the same packets, in the
+same order, as a single FromDump would.
+
 =h count read-only
 
 Returns the number of packets output so far.
@@ -148,7 +207,8 @@ Value is a Boolean.
 
 =h encap read-only
 
-Returns the file's encapsulation type.
+Returns the file's encapsulation type.  For a pcapng file, this is the first
+interface's encapsulation type.
 
 =h filename read-only
 
@@ -162,6 +222,7 @@ cannot be determined (because the file was compressed, for example).
 =h filepos read/write
 
 Returns or sets FromDump's position in the (uncompressed) file, in bytes.
+With READAHEAD, this is the reader thread's position, and is read-only.
 
 =h packet_filepos read-only
 
@@ -209,10 +270,14 @@ class FromDump : public Element { public:
     Packet *pull(int);
 
     void set_active(bool);
+#if CLICK_FROMDUMP_READER
+    static void *reader_thread(void *);
+#endif
 
   private:
 
-    enum { BUFFER_SIZE = 32768, SAMPLING_SHIFT = 28 };
+    enum { BUFFER_SIZE = 32768, SAMPLING_SHIFT = 28, SHARD_CHAIN = 4,
+	   PCAPNG_MAX_BLOCK = 16777216, INDEX_STEP = 1048576 };
 
     FromFile _ff;
 
@@ -227,11 +292,14 @@ class FromDump : public Element { public:
     bool _first_time_relative : 1;
     bool _last_time_relative : 1;
     bool _last_time_interval : 1;
+    bool _pcapng : 1;
+    bool _nsec : 1;
     bool _active;
     unsigned _extra_pkthdr_crap;
     unsigned _sampling_prob;
     int _minor_version;
     int _linktype;
+    int _packet_linktype;
 
     Timestamp _first_time;
     Timestamp _last_time;
@@ -251,8 +319,103 @@ class FromDump : public Element { public:
     Timestamp _time_offset;
     off_t _packet_filepos;
 
+    uint32_t _shard;
+    uint32_t _nshards;
+    off_t _shard_end;		// stop at records starting here; 0 means EOF
+    bool _shard_stop;		// STOP with SHARDS: wait for sibling shards
+    volatile bool _shard_done;
+
+    // pcapng state
+    struct Interface {
+	int linktype;
+	uint32_t snaplen;
+	int tsresol;
+	int64_t tsoffset;
+    };
+    Vector<Interface> _interfaces;
+    off_t _ng_pending_pos;	// block whose header initialize() read
+    uint32_t _ng_pending_type;
+    uint32_t _ng_pending_length;
+    bool _ng_pending;
+
+    // time index
+    struct IndexEntry {
+	off_t filepos;
+	Timestamp max_before;	// latest timestamp before filepos
+	IndexEntry(off_t f, const Timestamp &ts) : filepos(f), max_before(ts) {}
+    };
+    String _index_filename;
+    Vector<IndexEntry> _index;
+    Vector<off_t> _index_block_pos;	// pcapng section and interface blocks
+    Vector<String> _index_blocks;
+    off_t _index_end;		// the index covers records before this
+    Timestamp _index_max;
+    Timestamp _index_first;
+    bool _index_have_first;
+    bool _index_dirty;
+    off_t _trace_size;
+    time_t _trace_mtime;
+
+    uint32_t _readahead;
+    bool _ring_wait;		// no packet ready, but the reader isn't done
+#if CLICK_FROMDUMP_READER
+    enum { READER_BATCH = 32 };
+    struct RingSlot {
+	Packet *packet;
+	off_t filepos;
+	int linktype;
+    };
+    RingSlot *_ring;
+    uint32_t _ring_mask;
+    uint32_t _ring_tail_cache;	// router thread's copy of _ring_tail
+    volatile uint32_t _ring_head;	// written by the router thread
+    volatile uint32_t _ring_tail;	// written by the reader thread
+    volatile bool _reader_done;
+    volatile bool _reader_stop;
+    atomic_uint32_t _ring_sleeping;	// router thread is waiting for packets
+    atomic_uint32_t _reader_sleeping;	// reader is waiting for room
+    bool _reader_started;
+    pthread_t _reader;
+    pthread_mutex_t _reader_lock;
+    pthread_cond_t _reader_cond;
+#endif
+
+    struct Record {
+	Timestamp ts;
+	off_t filepos;
+	int len;
+	int caplen;
+	int skiplen;
+	int linktype;
+    };
+
+    inline uint16_t ng16(const uint8_t *) const;
+    inline uint32_t ng32(const uint8_t *) const;
+    int64_t ng64(const uint8_t *) const;
+    bool read_ng_block(const String &, ErrorHandler *);
+    bool read_ng_record(Record &, ErrorHandler *, bool metadata_only = false);
+    bool read_record(Record &, ErrorHandler *);
+    Packet *record_packet(const Record &, ErrorHandler *);
+    int check_times(const Timestamp &, ErrorHandler *);
     bool read_packet(ErrorHandler *);
 
+    bool plausible_header(const uint8_t *, Record &) const;
+    int find_shard(ErrorHandler *);
+    bool last_shard_done();
+
+    inline void index_record(const Record &, off_t end);
+    void index_skip(off_t filepos, off_t end, const String &block);
+    int read_index(ErrorHandler *);
+    int index_seek(ErrorHandler *);
+    void write_index();
+
+#if CLICK_FROMDUMP_READER
+    int start_reader(ErrorHandler *);
+    void stop_reader();
+    void run_reader();
+    bool read_ring_packet(ErrorHandler *);
+#endif
+
     void prepare_times(const Timestamp &);
 
     static String read_handler(Element *, void *);
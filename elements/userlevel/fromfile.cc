@@ -33,12 +33,21 @@
 #ifdef ALLOW_MMAP
 # include <sys/mman.h>
 #endif
+#if HAVE_ZLIB
+# include <zlib.h>
+#endif
+#if HAVE_ZSTD
+# include <zstd.h>
+#endif
 CLICK_DECLS
 
 FromFile::FromFile()
     : _fd(-1), _buffer(0), _data_packet(0),
 #ifdef ALLOW_MMAP
       _mmap(true),
+#endif
+#if CLICK_FROMFILE_DECOMPRESS
+      _zformat(Z_NONE), _zstream(0), _zbuffer(0),
 #endif
       _filename(), _pipe(0), _landmark_pattern("%f"), _lineno(0)
 {
@@ -166,6 +175,10 @@ FromFile::read_buffer_mmap(ErrorHandler *errh)
 # ifdef HAVE_MADVISE
     // don't care about errors
     (void) madvise((caddr_t)mmap_data, _len, MADV_SEQUENTIAL);
+#  ifdef MADV_WILLNEED
+    // start reading the whole unit now, rather than a page per fault
+    (void) madvise((caddr_t)mmap_data, _len, MADV_WILLNEED);
+#  endif
 # endif
 
     return 1;
@@ -184,6 +197,11 @@ FromFile::read_buffer(ErrorHandler *errh)
 				// beyond _len
     _len = 0;
 
+#if CLICK_FROMFILE_DECOMPRESS
+    if (_zformat)
+	return read_buffer_decompress(errh);
+#endif
+
 #ifdef ALLOW_MMAP
     if (_mmap) {
 	int result = read_buffer_mmap(errh);
@@ -216,6 +234,148 @@ FromFile::read_buffer(ErrorHandler *errh)
     return _len;
 }
 
+#if CLICK_FROMFILE_DECOMPRESS
+int
+FromFile::decompress_format(const uint8_t *data, uint32_t len)
+{
+# if HAVE_ZLIB
+    if (len >= 2 && data[0] == 037 && data[1] == 0213)
+	return Z_GZIP;
+# endif
+# if HAVE_ZSTD
+    if (len >= 4 && memcmp(data, "\x28\xB5\x2F\xFD", 4) == 0)
+	return Z_ZSTD;
+# endif
+    (void) data, (void) len;
+    return Z_NONE;
+}
+
+int
+FromFile::start_decompress(int format, ErrorHandler *errh)
+{
+    // Decompress from the start of the file: reuse the data already read,
+    // or reread the file if it was mapped.
+    _zbuffer = new uint8_t[ZBUFFER_SIZE];
+    _zpos = _zlen = 0;
+    _zeof = false;
+# ifdef ALLOW_MMAP
+    if (_mmap) {
+	if (lseek(_fd, 0, SEEK_SET) == (off_t) -1)
+	    return error(errh, "lseek: %s", strerror(errno));
+	_mmap = false;
+    } else
+# endif
+    {
+	assert(_file_offset == 0 && _len <= ZBUFFER_SIZE);
+	memcpy(_zbuffer, _buffer, _len);
+	_zlen = _len;
+    }
+
+# if HAVE_ZLIB
+    if (format == Z_GZIP) {
+	z_stream *zs = new z_stream;
+	memset(zs, 0, sizeof(z_stream));
+	// 15 + 32: maximum window, detect the gzip header
+	if (inflateInit2(zs, 15 + 32) != Z_OK) {
+	    delete zs;
+	    return error(errh, "gzip: %s", strerror(ENOMEM));
+	}
+	_zstream = zs;
+    }
+# endif
+# if HAVE_ZSTD
+    if (format == Z_ZSTD) {
+	ZSTD_DStream *ds = ZSTD_createDStream();
+	if (!ds || ZSTD_isError(ZSTD_initDStream(ds))) {
+	    ZSTD_freeDStream(ds);
+	    return error(errh, "zstd: %s", strerror(ENOMEM));
+	}
+	_zstream = ds;
+    }
+# endif
+    _zformat = format;
+    return 0;
+}
+
+int
+FromFile::read_buffer_decompress(ErrorHandler *errh)
+{
+    _data_packet = Packet::make(0, 0, BUFFER_SIZE, 0);
+    if (!_data_packet)
+	return error(errh, strerror(ENOMEM));
+    _buffer = _data_packet->data();
+    unsigned char *data = _data_packet->data();
+
+    while (_len < BUFFER_SIZE) {
+	if (_zpos == _zlen && !_zeof) {
+	    ssize_t got = ::read(_fd, _zbuffer, ZBUFFER_SIZE);
+	    if (got > 0)
+		_zpos = 0, _zlen = got;
+	    else if (got == 0)
+		_zeof = true;
+	    else if (errno != EINTR && errno != EAGAIN)
+		return error(errh, strerror(errno));
+	    continue;
+	}
+
+	uint32_t consumed = 0, produced = 0;
+# if HAVE_ZLIB
+	if (_zformat == Z_GZIP) {
+	    z_stream *zs = static_cast<z_stream *>(_zstream);
+	    zs->next_in = _zbuffer + _zpos;
+	    zs->avail_in = _zlen - _zpos;
+	    zs->next_out = data + _len;
+	    zs->avail_out = BUFFER_SIZE - _len;
+	    int r = inflate(zs, Z_NO_FLUSH);
+	    consumed = (_zlen - _zpos) - zs->avail_in;
+	    produced = (BUFFER_SIZE - _len) - zs->avail_out;
+	    if (r == Z_STREAM_END)
+		// a gzip file may hold several members
+		inflateReset(zs);
+	    else if (r != Z_OK && r != Z_BUF_ERROR)
+		return error(errh, "gzip: %s", zs->msg ? zs->msg : "corrupt data");
+	}
+# endif
+# if HAVE_ZSTD
+	if (_zformat == Z_ZSTD) {
+	    ZSTD_inBuffer in = { _zbuffer + _zpos, _zlen - _zpos, 0 };
+	    ZSTD_outBuffer out = { data + _len, BUFFER_SIZE - _len, 0 };
+	    size_t r = ZSTD_decompressStream(static_cast<ZSTD_DStream *>(_zstream), &out, &in);
+	    if (ZSTD_isError(r))
+		return error(errh, "zstd: %s", ZSTD_getErrorName(r));
+	    consumed = in.pos;
+	    produced = out.pos;
+	}
+# endif
+	_zpos += consumed;
+	_len += produced;
+	if (!consumed && !produced && _zeof && _zpos == _zlen)
+	    break;		// end of file
+    }
+
+    return _len;
+}
+
+void
+FromFile::end_decompress()
+{
+# if HAVE_ZLIB
+    if (_zformat == Z_GZIP) {
+	inflateEnd(static_cast<z_stream *>(_zstream));
+	delete static_cast<z_stream *>(_zstream);
+    }
+# endif
+# if HAVE_ZSTD
+    if (_zformat == Z_ZSTD)
+	ZSTD_freeDStream(static_cast<ZSTD_DStream *>(_zstream));
+# endif
+    delete[] _zbuffer;
+    _zformat = Z_NONE;
+    _zstream = 0;
+    _zbuffer = 0;
+}
+#endif
+
 int
 FromFile::read(void *vdata, uint32_t dlen, ErrorHandler *errh)
 {
@@ -238,6 +398,26 @@ FromFile::read(void *vdata, uint32_t dlen, ErrorHandler *errh)
     return dlen;
 }
 
+int
+FromFile::read_at(void *vdata, uint32_t dlen, off_t offset, ErrorHandler *errh)
+{
+    // Read without disturbing the current position; regular files only.
+    if (file_size() < 0)
+	return error(errh, "can't read at offsets in this file");
+    unsigned char *data = reinterpret_cast<unsigned char *>(vdata);
+    uint32_t dpos = 0;
+    while (dpos < dlen) {
+	ssize_t got = ::pread(_fd, data + dpos, dlen - dpos, offset + dpos);
+	if (got > 0)
+	    dpos += got;
+	else if (got == 0)
+	    break;
+	else if (errno != EINTR && errno != EAGAIN)
+	    return error(errh, strerror(errno));
+    }
+    return dpos;
+}
+
 int
 FromFile::read_line(String &result, ErrorHandler *errh, bool temporary)
 {
@@ -315,9 +495,22 @@ int
 FromFile::seek(off_t want, ErrorHandler* errh)
 {
     if (want >= _file_offset && want < (off_t) (_file_offset + _len)) {
-	_pos = want;
+	_pos = want - _file_offset;
+	return 0;
+    }
+
+#if CLICK_FROMFILE_DECOMPRESS
+    // decompressed data can only be skipped
+    if (_zformat) {
+	if (want < _file_offset)
+	    return error(errh, "can't seek backward in a compressed file");
+	while ((off_t) (_file_offset + _len) <= want && _len)
+	    if (read_buffer(errh) < 0)
+		return -1;
+	_pos = want - _file_offset;
 	return 0;
     }
+#endif
 
 #ifdef ALLOW_MMAP
     if (_mmap) {
@@ -373,6 +566,15 @@ FromFile::initialize(ErrorHandler *errh)
 	return error(errh, "empty file");
 
     // check for a gziped or bzip2d dump
+#if CLICK_FROMFILE_DECOMPRESS
+    if (_zformat || _pipe)
+	/* already uncompressing */;
+    else if (int format = decompress_format(_buffer, _len)) {
+	if (start_decompress(format, errh) < 0)
+	    return -1;
+	goto retry_file;
+    } else
+#endif
     if (_fd == STDIN_FILENO || _pipe)
 	/* cannot handle gzip or bzip2 */;
     else if (compressed_data(_buffer, _len)) {
@@ -411,6 +613,18 @@ FromFile::take_state(FromFile &o, ErrorHandler *errh)
 #endif
 
     _file_offset = o._file_offset;
+
+#if CLICK_FROMFILE_DECOMPRESS
+    _zformat = o._zformat;
+    _zstream = o._zstream;
+    _zbuffer = o._zbuffer;
+    _zpos = o._zpos;
+    _zlen = o._zlen;
+    _zeof = o._zeof;
+    o._zformat = Z_NONE;
+    o._zstream = 0;
+    o._zbuffer = 0;
+#endif
 }
 
 void
@@ -425,6 +639,9 @@ FromFile::cleanup()
     if (_data_packet)
 	_data_packet->kill();
     _data_packet = 0;
+#if CLICK_FROMFILE_DECOMPRESS
+    end_decompress();
+#endif
 }
 
 const uint8_t *
@@ -540,13 +757,27 @@ FromFile::filename_handler(Element *e, void *thunk)
     return fd->print_filename();
 }
 
+off_t
+FromFile::file_size() const
+{
+    struct stat s;
+#if CLICK_FROMFILE_DECOMPRESS
+    if (_zformat)
+	return -1;
+#endif
+    if (_fd >= 0 && !_pipe && fstat(_fd, &s) >= 0 && S_ISREG(s.st_mode))
+	return s.st_size;
+    else
+	return -1;
+}
+
 String
 FromFile::filesize_handler(Element *e, void *thunk)
 {
     FromFile *fd = reinterpret_cast<FromFile *>((uint8_t *)e + (intptr_t)thunk);
-    struct stat s;
-    if (fd->_fd >= 0 && fstat(fd->_fd, &s) >= 0 && S_ISREG(s.st_mode))
-	return String(s.st_size);
+    off_t size = fd->file_size();
+    if (size >= 0)
+	return String(size);
     else
 	return "-";
 }
@@ -4,6 +4,9 @@
 #include <click/string.hh>
 #include <click/vector.hh>
 #include <stdio.h>
+#if CLICK_USERLEVEL && (HAVE_ZLIB || HAVE_ZSTD)
+# define CLICK_FROMFILE_DECOMPRESS 1
+#endif
 CLICK_DECLS
 class ErrorHandler;
 class Element;
@@ -27,6 +30,7 @@ class FromFile { public:
     void set_lineno(int lineno)		{ _lineno = lineno; }
 
     off_t file_pos() const		{ return _file_offset + _pos; }
+    off_t file_size() const;
 
     int configure_keywords(Vector<String> &conf, Element *, ErrorHandler *);
     int initialize(ErrorHandler *);
@@ -37,6 +41,7 @@ class FromFile { public:
     int seek(off_t want, ErrorHandler *);
 
     int read(void *, uint32_t, ErrorHandler * = 0);
+    int read_at(void *, uint32_t, off_t, ErrorHandler * = 0);
     const uint8_t *get_unaligned(size_t, void *, ErrorHandler * = 0);
     const uint8_t *get_aligned(size_t, void *, ErrorHandler * = 0);
     String get_string(size_t, ErrorHandler * = 0);
@@ -71,6 +76,17 @@ class FromFile { public:
     off_t _mmap_off;
 #endif
 
+#if CLICK_FROMFILE_DECOMPRESS
+    // gzip and zstd files are decompressed in process
+    enum { Z_NONE = 0, Z_GZIP = 1, Z_ZSTD = 2, ZBUFFER_SIZE = 65536 };
+    int _zformat;
+    void *_zstream;
+    uint8_t *_zbuffer;		// compressed data read from _fd
+    uint32_t _zpos;
+    uint32_t _zlen;
+    bool _zeof;
+#endif
+
     String _filename;
     FILE *_pipe;
     off_t _file_offset;
@@ -81,6 +97,12 @@ class FromFile { public:
     int read_buffer_mmap(ErrorHandler *);
 #endif
     int read_buffer(ErrorHandler *);
+#if CLICK_FROMFILE_DECOMPRESS
+    static int decompress_format(const uint8_t *, uint32_t);
+    int start_decompress(int format, ErrorHandler *);
+    int read_buffer_decompress(ErrorHandler *);
+    void end_decompress();
+#endif
     bool read_packet(ErrorHandler *);
     int skip_ahead(ErrorHandler *);
 
@@ -0,0 +1,321 @@
+// -*- c-basic-offset: 4 -*-
+/*
+ * packetring.{cc,hh} -- Linux TPACKET_V3 memory-mapped packet rings
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "packetring.hh"
+#include <click/error.hh>
+#include <click/packet_anno.hh>
+#if HAVE_TPACKET_V3 || HAVE_PACKET_FANOUT
+# include <sys/types.h>
+# include <sys/socket.h>
+# include <sys/mman.h>
+# include <linux/if_packet.h>
+# include <unistd.h>
+#endif
+CLICK_DECLS
+
+#if HAVE_TPACKET_V3
+
+namespace {
+// rx() hands out packets whose head starts just past this record, which it
+// writes over the start of the frame's tpacket3_hdr.  rx_destructor() uses
+// it to find the frame's ring and block.
+struct RxStash {
+    PacketRing *ring;
+    uint32_t block;
+};
+enum { rx_stash_size = 16 };
+}
+
+PacketRing::PacketRing()
+    : _fd(-1), _map(0), _map_size(0), _nblocks(0), _block_size(0),
+      _nframes(0), _rx_block(0), _rx_left(0), _rx_frame(0), _rx_seq(0),
+      _block_refs(0),
+      _tx_frame(0), _tx_pending(0)
+{
+    _users = 1;
+}
+
+PacketRing::~PacketRing()
+{
+    if (_map)
+	munmap(_map, _map_size);
+    delete[] _block_refs;
+}
+
+inline unsigned char *
+PacketRing::block(uint32_t i) const
+{
+    return _map + (size_t) i * _block_size;
+}
+
+inline unsigned char *
+PacketRing::tx_frame(uint32_t i) const
+{
+    uint32_t per_block = _block_size / tx_frame_size;
+    return block(i / per_block) + (i % per_block) * tx_frame_size;
+}
+
+PacketRing *
+PacketRing::open(int fd, bool tx, uint32_t size, ErrorHandler *errh)
+{
+    int version = TPACKET_V3;
+    if (setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+	errh->error("PACKET_VERSION: %s", strerror(errno));
+	return 0;
+    }
+
+    PacketRing *r = new PacketRing;
+    r->_fd = fd;
+    r->_block_size = rx_block_size;
+    r->_nblocks = (size + rx_block_size - 1) / rx_block_size;
+    if (r->_nblocks < 2)
+	r->_nblocks = 2;
+    r->_nframes = r->_nblocks * (rx_block_size / tx_frame_size);
+
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = r->_block_size;
+    req.tp_block_nr = r->_nblocks;
+    req.tp_frame_size = tx_frame_size;
+    req.tp_frame_nr = r->_nframes;
+    if (!tx)
+	req.tp_retire_blk_tov = 1;	// ms before a partly full block is handed over
+    if (setsockopt(fd, SOL_PACKET, tx ? PACKET_TX_RING : PACKET_RX_RING, &req, sizeof(req)) < 0) {
+	errh->error("%s: %s", tx ? "PACKET_TX_RING" : "PACKET_RX_RING", strerror(errno));
+	delete r;
+	return 0;
+    }
+
+    r->_map_size = (size_t) r->_nblocks * r->_block_size;
+    void *map = mmap(0, r->_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+	errh->error("mmap: %s", strerror(errno));
+	delete r;
+	return 0;
+    }
+    r->_map = (unsigned char *) map;
+
+    if (!tx) {
+	r->_block_refs = new atomic_uint32_t[r->_nblocks];
+	for (uint32_t i = 0; i < r->_nblocks; ++i)
+	    r->_block_refs[i] = 0;
+    }
+    return r;
+}
+
+PacketRing *
+PacketRing::open_rx(int fd, uint32_t size, ErrorHandler *errh)
+{
+    return open(fd, false, size, errh);
+}
+
+PacketRing *
+PacketRing::open_tx(int fd, uint32_t size, ErrorHandler *errh)
+{
+    return open(fd, true, size, errh);
+}
+
+void
+PacketRing::unuse()
+{
+    if (_users.dec_and_test())
+	delete this;
+}
+
+/** @brief Give up the owner's reference to the ring.
+ *
+ * The mapping is removed once all received packets have been killed.  The
+ * caller should close the socket itself. */
+void
+PacketRing::release()
+{
+    if (_block_refs && _rx_left) {
+	_rx_left = 0;
+	unref_block(_rx_block);
+    }
+    _fd = -1;
+    unuse();
+}
+
+void
+PacketRing::unref_block(uint32_t i)
+{
+    if (_block_refs[i].dec_and_test()) {
+	struct tpacket_block_desc *bd = (struct tpacket_block_desc *) block(i);
+	click_fence();
+	bd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+    }
+}
+
+void
+PacketRing::rx_destructor(unsigned char *head, size_t)
+{
+    RxStash *stash = reinterpret_cast<RxStash *>(head - rx_stash_size);
+    PacketRing *r = stash->ring;
+    r->unref_block(stash->block);
+    r->unuse();
+}
+
+WritablePacket *
+PacketRing::rx()
+{
+    if (!_rx_left) {
+	struct tpacket_block_desc *bd = (struct tpacket_block_desc *) block(_rx_block);
+	if (!(bd->hdr.bh1.block_status & TP_STATUS_USER))
+	    return 0;
+	click_fence();
+	// A block we read on the previous lap stays TP_STATUS_USER while its
+	// packets are alive.  The kernel numbers blocks consecutively as it
+	// fills them, so only the successor of the last block read is new.
+	if (_rx_seq && bd->hdr.bh1.seq_num != _rx_seq + 1)
+	    return 0;
+	_rx_seq = bd->hdr.bh1.seq_num;
+	_rx_left = bd->hdr.bh1.num_pkts;
+	_rx_frame = (unsigned char *) bd + bd->hdr.bh1.offset_to_first_pkt;
+	// the reader's reference lasts until it moves past the block
+	_block_refs[_rx_block] = 1;
+	if (!_rx_left) {
+	    unref_block(_rx_block);
+	    _rx_block = (_rx_block + 1) % _nblocks;
+	    return 0;
+	}
+    }
+
+    unsigned char *frame = _rx_frame;
+    struct tpacket3_hdr *h = (struct tpacket3_hdr *) frame;
+    uint32_t block = _rx_block;
+    if (--_rx_left)
+	_rx_frame = frame + h->tp_next_offset;
+    else
+	_rx_block = (_rx_block + 1) % _nblocks;
+
+    const struct sockaddr_ll *sll = (const struct sockaddr_ll *) (frame + TPACKET_ALIGN(sizeof(*h)));
+    uint32_t mac = h->tp_mac, snaplen = h->tp_snaplen, len = h->tp_len;
+    Timestamp ts = Timestamp::make_nsec(h->tp_sec, h->tp_nsec);
+    Packet::PacketType ptype = (Packet::PacketType) sll->sll_pkttype;
+
+    // The frame header is no longer needed; the stash overwrites its start.
+    RxStash *stash = reinterpret_cast<RxStash *>(frame);
+    stash->ring = this;
+    stash->block = block;
+    _block_refs[block]++;
+    _users++;
+    WritablePacket *p = Packet::make(frame + rx_stash_size, mac - rx_stash_size + snaplen, rx_destructor);
+    if (!p) {
+	rx_destructor(frame + rx_stash_size, 0);
+	if (!_rx_left)
+	    unref_block(block);
+	return 0;
+    }
+    p->pull(mac - rx_stash_size);
+    p->set_timestamp_anno(ts);
+    p->set_packet_type_anno(ptype);
+    p->set_mac_header(p->data());
+    SET_EXTRA_LENGTH_ANNO(p, len - snaplen);
+
+    if (!_rx_left)
+	unref_block(block);
+    return p;
+}
+
+int
+PacketRing::rx_drops()
+{
+    struct tpacket_stats_v3 stats;
+    socklen_t len = sizeof(stats);
+    if (_fd < 0 || getsockopt(_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &len) < 0)
+	return -1;
+    return stats.tp_drops;
+}
+
+int
+PacketRing::tx(const Packet *p)
+{
+    enum { data_offset = TPACKET_ALIGN(sizeof(struct tpacket3_hdr)) };
+    if (p->length() > tx_frame_size - data_offset)
+	return -1;
+    struct tpacket3_hdr *h = (struct tpacket3_hdr *) tx_frame(_tx_frame);
+    if (h->tp_status != TP_STATUS_AVAILABLE) {
+	if (h->tp_status & TP_STATUS_WRONG_FORMAT)
+	    h->tp_status = TP_STATUS_AVAILABLE;
+	else
+	    return 0;
+    }
+    memcpy((unsigned char *) h + data_offset, p->data(), p->length());
+    h->tp_next_offset = 0;
+    h->tp_len = h->tp_snaplen = p->length();
+    click_fence();
+    h->tp_status = TP_STATUS_SEND_REQUEST;
+    _tx_frame = (_tx_frame + 1) % _nframes;
+    ++_tx_pending;
+    return 1;
+}
+
+int
+PacketRing::tx_flush()
+{
+    if (!_tx_pending)
+	return 0;
+    _tx_pending = 0;
+    return send(_fd, 0, 0, MSG_DONTWAIT);
+}
+
+#endif /* HAVE_TPACKET_V3 */
+
+#if HAVE_PACKET_FANOUT
+/** @brief Parse a PACKET_FANOUT type name, returning -1 if unknown. */
+int
+PacketRing::parse_fanout_type(const String &str)
+{
+    if (str == "HASH")
+	return PACKET_FANOUT_HASH;
+    else if (str == "LB")
+	return PACKET_FANOUT_LB;
+    else if (str == "CPU")
+	return PACKET_FANOUT_CPU;
+# ifdef PACKET_FANOUT_ROLLOVER
+    else if (str == "ROLLOVER")
+	return PACKET_FANOUT_ROLLOVER;
+# endif
+# ifdef PACKET_FANOUT_RND
+    else if (str == "RND")
+	return PACKET_FANOUT_RND;
+# endif
+# ifdef PACKET_FANOUT_QM
+    else if (str == "QM")
+	return PACKET_FANOUT_QM;
+# endif
+    else
+	return -1;
+}
+
+/** @brief Join @a fd to fanout group @a group.
+ *
+ * Sockets on the same interface in the same group share its packets
+ * according to @a type, rather than each receiving a copy. */
+int
+PacketRing::set_fanout(int fd, uint16_t group, int type, ErrorHandler *errh)
+{
+    int arg = group | (type << 16);
+    if (setsockopt(fd, SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) < 0)
+	return errh->error("PACKET_FANOUT: %s", strerror(errno));
+    return 0;
+}
+#endif
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel)
+ELEMENT_PROVIDES(PacketRing)
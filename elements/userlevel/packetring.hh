@@ -0,0 +1,92 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_PACKETRING_HH
+#define CLICK_PACKETRING_HH
+#include <click/packet.hh>
+#include <click/atomic.hh>
+#include <click/string.hh>
+CLICK_DECLS
+class ErrorHandler;
+
+/*
+ * PacketRing manages a Linux TPACKET_V3 memory-mapped ring on a PF_PACKET
+ * socket, for FromDevice CAPTURE RING and ToDevice RING.
+ *
+ * A receive ring is divided into blocks that the kernel fills with frames
+ * and hands to user space one block at a time.  rx() wraps each frame in a
+ * Packet without copying it.  The frame's block returns to the kernel only
+ * after rx() has moved past it and every Packet made from it has been
+ * killed, on whatever thread.  Packets held for a long time therefore keep
+ * ring blocks from the kernel; receive drops follow if too many are held.
+ *
+ * A transmit ring is an array of fixed-size frames.  tx() copies a packet
+ * into the next free frame, and tx_flush() asks the kernel to send all
+ * filled frames with one system call.
+ *
+ * The ring's mapping outlives release() while Packets made from it are
+ * still alive, so FromDevice can be cleaned up before downstream queues.
+ */
+
+class PacketRing { public:
+
+    enum { rx_block_size = 1 << 17, tx_frame_size = 2048 };
+
+    static PacketRing *open_rx(int fd, uint32_t size, ErrorHandler *errh);
+    static PacketRing *open_tx(int fd, uint32_t size, ErrorHandler *errh);
+    void release();
+
+    /** @brief Return the next received packet, or null if none is ready.
+     *
+     * Sets the packet's timestamp, packet type, MAC header, and extra length
+     * annotations. */
+    WritablePacket *rx();
+
+    /** @brief Copy @a p into the next free transmit frame.
+     *
+     * Returns 1 on success, 0 if every frame is busy, and -1 if @a p is too
+     * long for a frame. */
+    int tx(const Packet *p);
+    int tx_flush();
+
+    /** @brief Return the number of packets the kernel dropped for lack of
+     * ring space since the last call, or -1 if unknown. */
+    int rx_drops();
+
+#if HAVE_PACKET_FANOUT
+    static int parse_fanout_type(const String &str);
+    static int set_fanout(int fd, uint16_t group, int type, ErrorHandler *errh);
+#endif
+
+  private:
+
+    int _fd;
+    unsigned char *_map;
+    size_t _map_size;
+    uint32_t _nblocks;
+    uint32_t _block_size;
+    uint32_t _nframes;
+
+    // receive state
+    uint32_t _rx_block;
+    uint32_t _rx_left;
+    unsigned char *_rx_frame;
+    uint64_t _rx_seq;
+    atomic_uint32_t *_block_refs;
+    atomic_uint32_t _users;
+
+    // transmit state
+    uint32_t _tx_frame;
+    uint32_t _tx_pending;
+
+    PacketRing();
+    ~PacketRing();
+    static PacketRing *open(int fd, bool tx, uint32_t size, ErrorHandler *errh);
+    inline unsigned char *block(uint32_t i) const;
+    inline unsigned char *tx_frame(uint32_t i) const;
+    void unref_block(uint32_t i);
+    void unuse();
+    static void rx_destructor(unsigned char *head, size_t length);
+
+};
+
+CLICK_ENDDECLS
+#endif
@@ -30,6 +30,9 @@
 #include <sys/un.h>
 #include <arpa/inet.h>
 #include <netinet/tcp.h>
+#if HAVE_RECVMMSG || HAVE_SENDMMSG
+# include <netinet/udp.h>
+#endif
 #include <fcntl.h>
 #include "socket.hh"
 
@@ -39,13 +42,22 @@
 
 CLICK_DECLS
 
+#if HAVE_RECVMMSG && HAVE_SENDMMSG
+// control data space per message: an int for UDP_GRO (plus room for the
+// SO_TIMESTAMP timeval that comes with it), or a uint16_t for UDP_SEGMENT
+# define SOCKET_CMSG_SPACE	(CMSG_SPACE(sizeof(struct timeval)) + CMSG_SPACE(sizeof(int)))
+enum { udp_gso_max_segments = 64, udp_gso_max_bytes = 65507 };
+#endif
+
 Socket::Socket()
   : _task(this), _timer(this),
     _fd(-1), _active(-1), _rq(0), _wq(0),
     _local_port(0), _local_pathname(""),
     _timestamp(true), _sndbuf(-1), _rcvbuf(-1),
     _snaplen(2048), _headroom(Packet::default_headroom), _nodelay(1),
-    _verbose(false), _client(false), _proper(false), _allow(0), _deny(0)
+    _verbose(false), _client(false), _proper(false), _allow(0), _deny(0),
+    _burst(1), _gso(false), _gro(false), _msgs(0), _iovs(0), _addrs(0),
+    _msg_npackets(0), _cmsgs(0), _rqs(0)
 {
 }
 
@@ -78,6 +90,9 @@ Socket::configure(Vector<String> &conf, ErrorHandler *errh)
 		"PROPER", 0, cpBool, &_proper,
 		"ALLOW", 0, cpElement, &allow,
 		"DENY", 0, cpElement, &deny,
+		"BURST", 0, cpUnsigned, &_burst,
+		"GSO", 0, cpBool, &_gso,
+		"GRO", 0, cpBool, &_gro,
 		cpEnd) < 0)
     return -1;
 
@@ -126,6 +141,19 @@ Socket::configure(Vector<String> &conf, ErrorHandler *errh)
   else
     return errh->error("unknown socket type `%s'", socktype.c_str());
 
+  if (_burst == 0)
+    return errh->error("BURST must be positive");
+  if (_socktype != SOCK_DGRAM)
+    _burst = 1;
+  if ((_gso || _gro) && (_protocol != IPPROTO_UDP || _burst < 2))
+    return errh->error("GSO and GRO require a UDP socket with BURST greater than 1");
+#if !HAVE_RECVMMSG || !HAVE_SENDMMSG
+  if (_burst > 1) {
+    errh->warning("BURST not supported on this platform, using 1");
+    _burst = 1;
+  }
+#endif
+
   return 0;
 }
 
@@ -259,6 +287,9 @@ Socket::initialize(ErrorHandler *errh)
   fcntl(_fd, F_SETFL, O_NONBLOCK);
   fcntl(_fd, F_SETFD, FD_CLOEXEC);
 
+  if (_burst > 1 && initialize_burst(errh) < 0)
+    return -1;
+
   if (noutputs())
     add_select(_fd, SELECT_READ);
 
@@ -272,6 +303,39 @@ Socket::initialize(ErrorHandler *errh)
   return 0;
 }
 
+int
+Socket::initialize_burst(ErrorHandler *errh)
+{
+#if HAVE_RECVMMSG && HAVE_SENDMMSG
+  if (_gro) {
+# ifdef UDP_GRO
+    int one = 1;
+    if (setsockopt(_fd, IPPROTO_UDP, UDP_GRO, &one, sizeof(one)) < 0)
+      return initialize_socket_error(errh, "setsockopt(UDP_GRO)");
+# else
+    return errh->error("GRO not supported on this platform");
+# endif
+  }
+# ifndef UDP_SEGMENT
+  if (_gso)
+    return errh->error("GSO not supported on this platform");
+# endif
+
+  _msgs = new struct mmsghdr[_burst];
+  _iovs = new struct iovec[_burst];
+  _addrs = new sockaddr_any[_burst];
+  _msg_npackets = new unsigned[_burst];
+  _cmsgs = new char[_burst * SOCKET_CMSG_SPACE];
+  _rqs = new WritablePacket *[_burst];
+  memset(_msgs, 0, sizeof(struct mmsghdr) * _burst);
+  for (unsigned i = 0; i < _burst; i++)
+    _rqs[i] = 0;
+#else
+  (void) errh;
+#endif
+  return 0;
+}
+
 void
 Socket::cleanup(CleanupStage)
 {
@@ -283,6 +347,19 @@ Socket::cleanup(CleanupStage)
     _rq->kill();
   if (_wq)
     _wq->kill();
+  _wqb.kill();
+  if (_rqs)
+    for (unsigned i = 0; i < _burst; i++)
+      if (_rqs[i])
+	_rqs[i]->kill();
+  delete[] _msgs;
+  delete[] _iovs;
+  delete[] _addrs;
+  delete[] _msg_npackets;
+  delete[] _cmsgs;
+  delete[] _rqs;
+  _msgs = 0;
+  _rqs = 0;
   if (_fd >= 0) {
     // shut down the listening socket in case we forked
 #ifdef SHUT_RDWR
@@ -326,7 +403,7 @@ void
 Socket::selected(int fd, int)
 {
   int len;
-  union { struct sockaddr_in in; struct sockaddr_un un; } from;
+  sockaddr_any from;
   socklen_t from_len = sizeof(from);
   bool allow;
 
@@ -367,9 +444,17 @@ Socket::selected(int fd, int)
     }
 
     // read data from socket
-    if (!_rq)
+    if (!_msgs && !_rq)
       _rq = Packet::make(_headroom, 0, _snaplen, 0);
-    if (_rq) {
+    if (_msgs) {
+      // read a burst of datagrams
+      if (read_burst() < 0 && errno != EAGAIN) {
+	if (_verbose)
+	  click_chatter("%s: %s", declaration().c_str(), strerror(errno));
+	close_active();
+	return;
+      }
+    } else if (_rq) {
       if (_socktype == SOCK_STREAM)
 	len = read(_active, _rq->data(), _rq->length());
       else if (_client)
@@ -387,6 +472,8 @@ Socket::selected(int fd, int)
 	} else if (len > 0) {
 	  memcpy(&_remote, &from, from_len);
 	  _remote_len = from_len;
+	  if (_family == AF_INET)
+	    annotate_remote(_rq, from);
 	}
       }
 
@@ -424,6 +511,108 @@ Socket::selected(int fd, int)
     run_task(0);
 }
 
+void
+Socket::annotate_remote(Packet *p, const sockaddr_any &from)
+{
+  p->set_dst_ip_anno(IPAddress(from.in.sin_addr));
+  SET_DST_PORT_ANNO(p, from.in.sin_port);
+}
+
+int
+Socket::read_burst()
+{
+#if HAVE_RECVMMSG && HAVE_SENDMMSG
+  // GRO can coalesce up to 64 kilobytes of datagrams into one receive
+  uint32_t buflen = _gro ? 65535 : _snaplen;
+  unsigned n;
+  for (n = 0; n < _burst; n++) {
+    if (!_rqs[n] && !(_rqs[n] = Packet::make(_headroom, 0, buflen, 0)))
+      break;
+    _iovs[n].iov_base = _rqs[n]->data();
+    _iovs[n].iov_len = buflen;
+    struct msghdr *m = &_msgs[n].msg_hdr;
+    m->msg_name = &_addrs[n];
+    m->msg_namelen = sizeof(sockaddr_any);
+    m->msg_iov = &_iovs[n];
+    m->msg_iovlen = 1;
+    m->msg_control = _gro ? _cmsgs + n * SOCKET_CMSG_SPACE : 0;
+    m->msg_controllen = _gro ? SOCKET_CMSG_SPACE : 0;
+    m->msg_flags = 0;
+  }
+  if (n == 0)
+    return 0;
+
+  // MSG_TRUNC makes msg_len the datagram's full length
+  int r = recvmmsg(_active, _msgs, n, MSG_TRUNC, 0);
+  if (r <= 0)
+    return r;
+
+  Timestamp now;
+  if (_timestamp)
+    now.assign_now();
+  PacketBatch batch;
+  for (int i = 0; i < r; i++) {
+    WritablePacket *p = _rqs[i];
+    _rqs[i] = 0;
+    const sockaddr_any &from = _addrs[i];
+
+    if (!_client) {
+      if (_family == AF_INET && !allowed(IPAddress(from.in.sin_addr))) {
+	if (_verbose)
+	  click_chatter("%s: dropped datagram from %s:%d", declaration().c_str(),
+			IPAddress(from.in.sin_addr).unparse().c_str(), ntohs(from.in.sin_port));
+	p->kill();
+	continue;
+      }
+      memcpy(&_remote, &from, _msgs[i].msg_hdr.msg_namelen);
+      _remote_len = _msgs[i].msg_hdr.msg_namelen;
+    }
+
+    uint32_t len = _msgs[i].msg_len;
+    if (len > buflen)
+      SET_EXTRA_LENGTH_ANNO(p, len - buflen);
+    else
+      p->take(buflen - len);
+    if (_family == AF_INET)
+      annotate_remote(p, from);
+    if (_timestamp)
+      p->timestamp_anno() = now;
+
+# ifdef UDP_GRO
+    // split a coalesced receive into its datagrams, which share p's buffer
+    int gso_size = 0;
+    if (_gro)
+      for (struct cmsghdr *c = CMSG_FIRSTHDR(&_msgs[i].msg_hdr); c;
+	   c = CMSG_NXTHDR(&_msgs[i].msg_hdr, c))
+	if (c->cmsg_level == IPPROTO_UDP && c->cmsg_type == UDP_GRO)
+	  memcpy(&gso_size, CMSG_DATA(c), sizeof(gso_size));
+    if (gso_size > 0 && p->length() > (uint32_t) gso_size) {
+      PacketBatch segments;
+      for (uint32_t off = gso_size; off < p->length(); off += gso_size)
+	if (Packet *q = p->clone()) {
+	  q->pull(off);
+	  if (q->length() > (uint32_t) gso_size)
+	    q->take(q->length() - gso_size);
+	  segments.append(q);
+	}
+      p->take(p->length() - gso_size);
+      batch.append(p);
+      batch.append(segments);
+      continue;
+    }
+# endif
+
+    batch.append(p);
+  }
+
+  if (batch)
+    output(0).push_batch(batch);
+  return r;
+#else
+  return 0;
+#endif
+}
+
 int
 Socket::write_packet(Packet *p)
 {
@@ -432,10 +621,14 @@ Socket::write_packet(Packet *p)
   assert(_active >= 0);
 
   while (p->length()) {
-    if (!IPAddress(_remote_ip) && _client && _family == AF_INET && _socktype != SOCK_STREAM) {
+    if (_client && _family == AF_INET && _socktype != SOCK_STREAM) {
       // If the IP address specified when the element was created is 0.0.0.0,
-      // send the packet to its IP destination annotation address
-      _remote.in.sin_addr = p->dst_ip_anno();
+      // send the packet to its IP destination annotation address; likewise
+      // for a zero port
+      if (!IPAddress(_remote_ip))
+	_remote.in.sin_addr = p->dst_ip_anno();
+      if (!_remote_port)
+	_remote.in.sin_port = DST_PORT_ANNO(p);
     }
 
     // write segment
@@ -471,6 +664,103 @@ Socket::write_packet(Packet *p)
   return 0;
 }
 
+int
+Socket::write_burst(PacketBatch &batch)
+{
+#if HAVE_RECVMMSG && HAVE_SENDMMSG
+  bool per_packet = _client && _family == AF_INET
+    && (!IPAddress(_remote_ip) || !_remote_port);
+
+  while (batch) {
+    // One message per packet, or with GSO, one message per run of
+    // equal-sized packets to the same destination (the last may be shorter).
+    unsigned nmsg = 0, niov = 0;
+    Packet *p = batch.front();
+    while (p && nmsg < _burst && niov < _burst) {
+      struct msghdr *m = &_msgs[nmsg].msg_hdr;
+      if (per_packet) {
+	_addrs[nmsg].in = _remote.in;
+	if (!IPAddress(_remote_ip))
+	  _addrs[nmsg].in.sin_addr = p->dst_ip_anno();
+	if (!_remote_port)
+	  _addrs[nmsg].in.sin_port = DST_PORT_ANNO(p);
+	m->msg_name = &_addrs[nmsg];
+      } else
+	m->msg_name = &_remote;
+      m->msg_namelen = _remote_len;
+      m->msg_iov = &_iovs[niov];
+      m->msg_control = 0;
+      m->msg_controllen = 0;
+      m->msg_flags = 0;
+
+      uint32_t seglen = p->length(), last, total = 0;
+      unsigned npackets = 0;
+      do {
+	_iovs[niov].iov_base = const_cast<unsigned char *>(p->data());
+	_iovs[niov].iov_len = last = p->length();
+	total += last;
+	niov++;
+	npackets++;
+	p = p->next();
+      } while (_gso && p && seglen && last == seglen && niov < _burst
+	       && npackets < udp_gso_max_segments
+	       && p->length() <= seglen && total + p->length() <= udp_gso_max_bytes
+	       && (!per_packet || (p->dst_ip_anno() == IPAddress(_addrs[nmsg].in.sin_addr)
+				   && (_remote_port || DST_PORT_ANNO(p) == _addrs[nmsg].in.sin_port))));
+
+# ifdef UDP_SEGMENT
+      if (npackets > 1) {
+	m->msg_control = _cmsgs + nmsg * SOCKET_CMSG_SPACE;
+	m->msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+	struct cmsghdr *c = CMSG_FIRSTHDR(m);
+	c->cmsg_level = IPPROTO_UDP;
+	c->cmsg_type = UDP_SEGMENT;
+	c->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+	uint16_t gso_size = seglen;
+	memcpy(CMSG_DATA(c), &gso_size, sizeof(gso_size));
+      }
+# endif
+      m->msg_iovlen = npackets;
+      _msg_npackets[nmsg] = npackets;
+      nmsg++;
+    }
+
+    int r = sendmmsg(_active, _msgs, nmsg, 0);
+    if (r < 0) {
+      // out of memory or would block
+      if (errno == ENOBUFS || errno == EAGAIN)
+	return -1;
+      // interrupted by signal, try again immediately
+      else if (errno == EINTR)
+	continue;
+      // the route or device cannot segment, so stop using GSO
+      else if (_gso && _msg_npackets[0] > 1 && (errno == EINVAL || errno == EIO)) {
+	click_chatter("%s: GSO send: %s, disabling GSO", declaration().c_str(), strerror(errno));
+	_gso = false;
+	continue;
+      }
+      // connection probably terminated or other fatal error
+      if (_verbose)
+	click_chatter("%s: %s", declaration().c_str(), strerror(errno));
+      close_active();
+      batch.kill();
+      return 0;
+    }
+
+    for (int i = 0; i < r; i++)
+      for (unsigned j = 0; j < _msg_npackets[i]; j++)
+	batch.pop_front()->kill();
+    if ((unsigned) r < nmsg) {
+      errno = EAGAIN;
+      return -1;
+    }
+  }
+#else
+  batch.kill();
+#endif
+  return 0;
+}
+
 void
 Socket::push(int, Packet *p)
 {
@@ -501,13 +791,70 @@ Socket::push(int, Packet *p)
     p->kill();
 }
 
+void
+Socket::push_batch(int port, PacketBatch &batch)
+{
+  fd_set fds;
+  int err;
+
+  if (!_msgs) {
+    Element::push_batch(port, batch);
+    return;
+  }
+
+  while (batch && _active >= 0) {
+    // block
+    do {
+      FD_ZERO(&fds);
+      FD_SET(_active, &fds);
+      err = select(_active + 1, NULL, &fds, NULL, NULL);
+    } while (err < 0 && errno == EINTR);
+
+    if (err < 0) {
+      if (_verbose)
+	click_chatter("%s: %s, dropping packets", declaration().c_str(), strerror(errno));
+      break;
+    }
+
+    // write; returns -1 if the socket would block
+    write_burst(batch);
+  }
+
+  batch.kill();
+}
+
 bool
 Socket::run_task(Task *)
 {
   assert(ninputs() && input_is_pull(0));
   bool any = false;
 
-  if (_active >= 0) {
+  if (_active >= 0 && _msgs) {
+    bool pulled;
+    int err = 0;
+
+    // write as much as we can, a burst at a time; unsent packets wait in
+    // _wqb until the socket becomes available
+    do {
+      pulled = false;
+      if (_wqb.count() < _burst) {
+	PacketBatch batch = input(0).pull_batch(_burst - _wqb.count());
+	pulled = batch;
+	_wqb.append(batch);
+      }
+      if (_wqb) {
+	any = true;
+	err = write_burst(_wqb);
+      }
+    } while (pulled && err >= 0 && _active >= 0);
+
+    if (err < 0)
+      add_select(_active, SELECT_WRITE);
+    else if (_signal)
+      _task.fast_reschedule();
+    else
+      remove_select(_active, SELECT_WRITE);
+  } else if (_active >= 0) {
     Packet *p = 0;
     int err = 0;
 
@@ -8,6 +8,7 @@
 #include <click/notifier.hh>
 #include "../ip/iproutetable.hh"
 #include <sys/un.h>
+#include <netinet/in.h>
 CLICK_DECLS
 
 /*
@@ -46,7 +47,13 @@ address/port/file.
 
 For convenience, if a client UDP Socket is configured with a zero IP
 address, the Socket will send input packets to the destination IP
-annotation of each packet.
+annotation of each packet.  Likewise, if it is configured with a zero
+port number, it sends to each packet's destination port annotation.
+
+Packets received by a UDP server Socket, or by any UDP Socket with BURST
+greater than 1, carry the sender's address and port in their destination
+IP and destination port annotations.  A client UDP Socket with zero address
+and port can thus send replies back to their senders.
 
 If "LOCALIP"/"LOCALPORTNUMBER" or "LOCALFILENAME" is specified, CLIENT
 is assumed if not set and the specified local address/port/file will
@@ -142,6 +149,30 @@ Boolean. PlanetLab specific. If true and Click has been configured
 
 Integer. Per-packet headroom. Defaults to 28.
 
+=item BURST
+
+Unsigned integer. Applies to datagram sockets only. The maximum number of
+datagrams to receive or send per system call. If greater than 1, Socket
+uses recvmmsg() to read up to BURST datagrams at a time and pushes them
+downstream as a batch, and pulls up to BURST packets at a time for
+sendmmsg(). Default is 1, which uses one recvfrom() or sendto() per packet.
+
+=item GSO
+
+Boolean. Applies to UDP sockets with BURST greater than 1, on Linux. If
+true, consecutive equal-sized packets for the same destination are handed
+to the kernel as a single UDP generic segmentation offload (GSO) send,
+which the kernel or NIC splits into datagrams. Default is false.
+
+=item GRO
+
+Boolean. Applies to UDP sockets with BURST greater than 1, on Linux. If
+true, the kernel may coalesce consecutive datagrams from one sender into a
+single large receive (UDP generic receive offload, GRO). Socket splits
+these back into one packet per datagram, sharing the receive buffer
+between them. Receive buffers are 64 kilobytes regardless of SNAPLEN.
+Default is false.
+
 =back
 
 =e
@@ -161,6 +192,10 @@ Integer. Per-packet headroom. Defaults to 28.
   // A bi-directional client socket bound to a particular local port
   ... -> Socket(TCP, 1.2.3.4, 80, 0.0.0.0, 54321) -> ...
 
+  // A UDP echo server that moves up to 32 datagrams per system call
+  Socket(UDP, 0.0.0.0, 5000, BURST 32) -> Queue
+    -> Socket(UDP, 0.0.0.0, 0, 0.0.0.0, 5001, BURST 32);
+
   // A localhost server socket
   allow :: RadixIPLookup(127.0.0.1 0);
   deny :: RadixIPLookup(0.0.0.0/0	0);
@@ -188,6 +223,7 @@ class Socket : public Element { public:
   bool run_task(Task *);
   void selected(int fd, int mask);
   void push(int port, Packet*);
+  void push_batch(int port, PacketBatch &batch);
 
   bool allowed(IPAddress);
   void close_active(void);
@@ -238,7 +274,25 @@ private:
   IPRouteTable *_allow;		// lookup table of good hosts
   IPRouteTable *_deny;		// lookup table of bad hosts
 
+  unsigned _burst;		// maximum datagrams per recvmmsg()/sendmmsg()
+  bool _gso;			// send with UDP generic segmentation offload
+  bool _gro;			// receive with UDP generic receive offload
+
+  // burst mode state, allocated if _burst > 1
+  typedef union { struct sockaddr_in in; struct sockaddr_un un; } sockaddr_any;
+  struct mmsghdr *_msgs;	// message headers, one per datagram
+  struct iovec *_iovs;		// data vectors, one per packet
+  sockaddr_any *_addrs;		// per-message remote addresses
+  unsigned *_msg_npackets;	// packets in each sent message (GSO)
+  char *_cmsgs;			// per-message control data (GSO/GRO)
+  WritablePacket **_rqs;	// packets waiting to receive datagrams
+  PacketBatch _wqb;		// pulled packets waiting to be sent
+
   int initialize_socket_error(ErrorHandler *, const char *);
+  int initialize_burst(ErrorHandler *);
+  void annotate_remote(Packet *, const sockaddr_any &);
+  int read_burst();
+  int write_burst(PacketBatch &);
 
 };
 
@@ -57,8 +57,10 @@ CLICK_DECLS
 
 ToDevice::ToDevice()
   : _task(this), _timer(&_task), _fd(-1), _my_fd(false),
-    _q(0),
-    _pulls(0)
+#if FROMDEVICE_RING
+    _ring(0), _ring_size(1 << 20),
+#endif
+    _burst(1), _pulls(0)
 {
 }
 
@@ -70,13 +72,28 @@ int
 ToDevice::configure(Vector<String> &conf, ErrorHandler *errh)
 {
 
+  bool ring = false;
+  uint32_t ring_size = 1 << 20;
   if (cp_va_kparse(conf, this, errh,
 		   "DEVNAME", cpkP+cpkM, cpString, &_ifname,
 		   "DEBUG", 0, cpBool, &_debug,
+		   "BURST", 0, cpUnsigned, &_burst,
+		   "RING", 0, cpBool, &ring,
+		   "RING_SIZE", 0, cpUnsigned, &ring_size,
 		   cpEnd) < 0)
     return -1;
+#if FROMDEVICE_RING
+  if (ring && (ring_size == 0 || ring_size > 0x40000000))
+    return errh->error("RING_SIZE out of range");
+  _ring_size = ring ? ring_size : 0;
+#else
+  if (ring)
+    return errh->error("RING not supported on this platform");
+#endif
   if (!_ifname)
     return errh->error("interface not set");
+  if (_burst == 0)
+    return errh->error("BURST must be positive");
   return 0;
 }
 
@@ -111,6 +128,19 @@ ToDevice::initialize(ErrorHandler *errh)
 
 #elif TODEVICE_LINUX || TODEVICE_PCAP
 
+# if FROMDEVICE_RING
+  // a transmit ring needs a socket of its own
+  if (_ring_size) {
+    _fd = FromDevice::open_packet_socket(_ifname, errh, false);
+    if (_fd < 0)
+      return -1;
+    _my_fd = true;
+    PrefixErrorHandler perrh(errh, _ifname + ": ");
+    if (!(_ring = PacketRing::open_tx(_fd, _ring_size, &perrh)))
+      return -1;
+  }
+# endif
+
   // find a FromDevice and reuse its socket if possible
   for (int ei = 0; ei < router()->nelements() && _fd < 0; ei++) {
     Element *e = router()->element(ei);
@@ -151,6 +181,13 @@ ToDevice::initialize(ErrorHandler *errh)
 void
 ToDevice::cleanup(CleanupStage)
 {
+  _q.kill();
+#if FROMDEVICE_RING
+  if (_ring) {
+    _ring->release();
+    _ring = 0;
+  }
+#endif
   if (_fd >= 0 && _my_fd)
     close(_fd);
   _fd = -1;
@@ -170,17 +207,34 @@ ToDevice::cleanup(CleanupStage)
 bool
 ToDevice::run_task(Task *)
 {
-    Packet *p = _q;
-    _q = 0;
-    if (!p) {
-	p = input(0).pull();
+    // _q holds packets left over from an earlier run that hit ENOBUFS.
+    if (!_q) {
+	_q = input(0).pull_batch(_burst);
 	_pulls++;
     }
+    bool worked = !_q.empty();
 
-    if (p) {
+    PacketBatch sent;
+    while (Packet *p = _q.front()) {
 	int retval;
 	const char *syscall;
 
+#if FROMDEVICE_RING
+	if (_ring) {
+	    // A full ring behaves like ENOBUFS from send().
+	    int r = _ring->tx(p);
+	    if (r < 0) {
+		click_chatter("ToDevice(%s): packet too long for ring", _ifname.c_str());
+		checked_output_push(1, _q.pop_front());
+		continue;
+	    }
+	    retval = (r > 0 ? 0 : -1);
+	    errno = (r > 0 ? 0 : ENOBUFS);
+	    syscall = "ring";
+	    if (r == 0)
+		_ring->tx_flush();
+	} else
+#endif
 #if TODEVICE_WRITE
 	retval = ((uint32_t) write(_fd, p->data(), p->length()) == p->length() ? 0 : -1);
 	syscall = "write";
@@ -193,12 +247,9 @@ ToDevice::run_task(Task *)
 
 	if (retval >= 0) {
 	    _backoff = 0;
-	    checked_output_push(0, p);
+	    sent.append(_q.pop_front());
 
 	} else if (errno == ENOBUFS || errno == EAGAIN) {
-	    assert(!_q);
-	    _q = p;
-
 	    if (!_backoff) {
 		_backoff = 1;
 		add_select(_fd, SELECT_WRITE);
@@ -212,18 +263,24 @@ ToDevice::run_task(Task *)
 		}
 	    }
 
+	    checked_output_push_batch(0, sent);
 	    return false;
 
 	} else {
 	    click_chatter("ToDevice(%s) %s: %s", _ifname.c_str(), syscall, strerror(errno));
-	    checked_output_push(1, p);
+	    checked_output_push(1, _q.pop_front());
 	}
     }
 
-    if (!p && !_signal)
+#if FROMDEVICE_RING
+    if (_ring && _ring->tx_flush() < 0 && errno != ENOBUFS && errno != EAGAIN)
+	click_chatter("ToDevice(%s) send: %s", _ifname.c_str(), strerror(errno));
+#endif
+    checked_output_push_batch(0, sent);
+    if (!worked && !_signal)
 	return false;
     _task.fast_reschedule();
-    return p != 0;
+    return worked;
 }
 
 void
@@ -248,7 +305,7 @@ ToDevice::read_param(Element *e, void *thunk)
   case H_PULLS:
       return String(td->_pulls);
   case H_Q:
-      return String((bool) td->_q);
+      return String(!td->_q.empty());
   default:
       return String();
   }
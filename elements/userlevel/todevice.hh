@@ -26,6 +26,24 @@ CLICK_DECLS
  *
  * =over 8
  *
+ * =item BURST
+ *
+ * Integer.  Maximum number of packets to pull and send each time the element
+ * is scheduled.  Packets are pulled as one batch.  Default is 1.
+ *
+ * =item RING
+ *
+ * Boolean.  If true, send packets through a TPACKET_V3 memory-mapped transmit
+ * ring: ToDevice copies each packet of a batch into a ring frame and sends
+ * the whole batch with one system call.  Packets longer than about 2000
+ * bytes cannot be sent this way and are emitted on output 1.  Linux only.
+ * Default is false.
+ *
+ * =item RING_SIZE
+ *
+ * Integer.  Size in bytes of the transmit ring.  Rounded up to a multiple of
+ * 128 KiB.  Defaults to 1 MiB.
+ *
  * =item DEBUG
  *
  * Boolean.  If true, print out debug messages.
@@ -100,10 +118,15 @@ private:
   String _ifname;
   int _fd;
   bool _my_fd;
+#if FROMDEVICE_RING
+  PacketRing *_ring;
+  uint32_t _ring_size;
+#endif
   NotifierSignal _signal;
 
 
-  Packet *_q;
+  PacketBatch _q;
+  unsigned _burst;
 public:
   bool _debug;
   bool _backoff;
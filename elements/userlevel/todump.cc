@@ -30,11 +30,10 @@
 #include <click/standard/scheduleinfo.hh>
 #include <click/packet_anno.hh>
 #include "fakepcap.hh"
-#include <click/userutils.hh>
 CLICK_DECLS
 
 ToDump::ToDump()
-    : _fp(0), _count(0), _task(this), _use_encap_from(0)
+    : _count(0), _task(this), _use_encap_from(0)
 {
 }
 
@@ -53,8 +52,10 @@ ToDump::configure(Vector<String> &conf, ErrorHandler *errh)
     bool per_node = false;
 #endif
 
+    if (_tf.configure_keywords(conf, this, errh) < 0)
+	return -1;
     if (cp_va_kparse(conf, this, errh,
-		     "FILENAME", cpkP+cpkM, cpFilename, &_filename,
+		     "FILENAME", cpkP+cpkM, cpFilename, &_tf.filename(),
 		     "SNAPLEN", cpkP, cpUnsigned, &_snaplen,
 		     "ENCAP", cpkP, cpWord, &encap_type,
 		     "USE_ENCAP_FROM", 0, cpArgument, &use_encap_from,
@@ -90,7 +91,7 @@ ToDump::configure(Vector<String> &conf, ErrorHandler *errh)
 	char tmp[255];
 	int r = simclick_sim_command(router()->simnode(), SIMCLICK_GET_NODE_NAME,tmp,255);
 	if (r >= 0)
-	    _filename = String(tmp) + String("_") + _filename;
+	    _tf.filename() = String(tmp) + String("_") + _tf.filename();
     }
 #endif
 
@@ -102,8 +103,9 @@ ToDump::hotswap_element() const
 {
     if (Element *e = Element::hotswap_element())
 	if (ToDump *td = (ToDump *)e->cast("ToDump"))
-	    if (td->_filename == _filename
-		&& td->_linktype == _linktype)
+	    if (td->_tf.filename() == _tf.filename()
+		&& td->_linktype == _linktype
+		&& !td->_tf.async() && !_tf.async())
 		return td;
     return 0;
 }
@@ -140,20 +142,7 @@ ToDump::initialize(ErrorHandler *errh)
     // skip initialization if we're hotswapping later
     if (!hotswap_element()) {
 
-	// prepare files
-	assert(!_fp);
-	if (_filename != "-") {
-	    if (compressed_filename(_filename) > 0)
-		_fp = open_compress_pipe(_filename, errh);
-	    else
-		_fp = fopen(_filename.c_str(), "wb");
-	    if (!_fp)
-		return errh->error("%s: %s", _filename.c_str(), strerror(errno));
-	} else {
-	    _fp = stdout;
-	    _filename = "<stdout>";
-	}
-
+	// every file, including rotated files, starts with this header
 	struct fake_pcap_file_header h;
 
 	h.magic = FAKE_PCAP_MAGIC;
@@ -165,9 +154,9 @@ ToDump::initialize(ErrorHandler *errh)
 	h.snaplen = _snaplen;
 	h.linktype = _linktype;
 
-	size_t wrote_header = fwrite(&h, sizeof(h), 1, _fp);
-	if (wrote_header != 1)
-	    return errh->error("%s: unable to write file header", _filename.c_str());
+	_tf.set_header(String((const char *) &h, sizeof(h)));
+	if (_tf.initialize(errh) < 0)
+	    return -1;
     }
 
     if (input_is_pull(0) && noutputs() == 0) {
@@ -179,19 +168,16 @@ ToDump::initialize(ErrorHandler *errh)
 }
 
 void
-ToDump::take_state(Element *e, ErrorHandler *)
+ToDump::take_state(Element *e, ErrorHandler *errh)
 {
     ToDump *td = static_cast<ToDump *>(e); // result of hotswap_element()
-    _fp = td->_fp;
-    td->_fp = 0;
+    _tf.take_state(td->_tf, errh);
 }
 
 void
 ToDump::cleanup(CleanupStage)
 {
-    if (_fp && _fp != stdout)
-	fclose(_fp);
-    _fp = 0;
+    _tf.cleanup();
 }
 
 void
@@ -215,12 +201,13 @@ ToDump::write_packet(Packet *p)
 	to_write = _snaplen;
     ph.caplen = to_write;
 
-    // XXX writing to pipe?
-    if (fwrite(&ph, sizeof(ph), 1, _fp) == 0
-	|| fwrite(p->data(), 1, to_write, _fp) == 0) {
-	if (errno != EAGAIN) {
+    if (!_tf.begin_record(sizeof(ph) + to_write))
+	/* file full or buffers busy */;
+    else if (!_tf.write(&ph, sizeof(ph))
+	     || !_tf.write(p->data(), to_write)) {
+	if (_tf.last_errno()) {
 	    _active = false;
-	    click_chatter("ToDump(%s): %s", _filename.c_str(), strerror(errno));
+	    click_chatter("ToDump(%s): %s", _tf.print_filename().c_str(), strerror(_tf.last_errno()));
 	}
     } else
 	_count++;
@@ -266,7 +253,7 @@ ToDump::read_handler(Element *e, void *thunk)
     ToDump *td = static_cast<ToDump *>(e);
     switch ((uintptr_t) thunk) {
     case H_FILENAME:
-	return td->_filename;
+	return td->_tf.print_filename();
     case H_COUNT:
 	return String(td->_count);
     default:
@@ -288,10 +275,11 @@ ToDump::add_handlers()
     add_read_handler("filename", read_handler, (void *)H_FILENAME);
     add_read_handler("count", read_handler, (void *)H_COUNT);
     add_write_handler("reset_counts", write_handler, (void *)H_RESET_COUNTS, Handler::BUTTON);
+    _tf.add_handlers(this);
     if (input_is_pull(0) && noutputs() == 0)
 	add_task_handlers(&_task);
 }
 
 CLICK_ENDDECLS
-ELEMENT_REQUIRES(userlevel|ns FakePcap)
+ELEMENT_REQUIRES(userlevel|ns FakePcap ToFile)
 EXPORT_ELEMENT(ToDump)
@@ -5,13 +5,14 @@
 #include <click/element.hh>
 #include <click/task.hh>
 #include <click/notifier.hh>
-#include <stdio.h>
+#include "elements/userlevel/tofile.hh"
 CLICK_DECLS
 
 /*
 =c
 
-ToDump(FILENAME [, I<keywords> SNAPLEN, ENCAP, USE_ENCAP_FROM, EXTRA_LENGTH])
+ToDump(FILENAME [, I<keywords> SNAPLEN, ENCAP, USE_ENCAP_FROM, EXTRA_LENGTH,
+ASYNC, BUFFER_SIZE, BUFFERS, BLOCKING, DIRECT, ROTATE_SIZE, ROTATE_INTERVAL])
 
 =s traces
 
@@ -60,6 +61,50 @@ USE_ENCAP_FROM. FromDump and FromDevice.u have `encap' handlers.
 Boolean. Set to true if you want ToDump to store any extra length as recorded
 in packets' extra length annotations. Default is true.
 
+=item ASYNC
+
+Boolean.  If true, ToDump copies packets into large memory buffers, and a
+separate writer thread writes full buffers to the file.  A slow disk or
+compression pipe then delays the writer thread rather than the router.
+Requires multithreading support.  Default is false.
+
+=item BUFFER_SIZE
+
+Integer.  Size of each ASYNC buffer in bytes, rounded up to a multiple of
+4096.  Default is 1048576 (1MB).
+
+=item BUFFERS
+
+Integer.  Number of ASYNC buffers; at least 2.  Default is 2.
+
+=item BLOCKING
+
+Boolean.  Determines what ToDump does with a packet when every ASYNC buffer
+is waiting for the writer thread.  If true, ToDump waits for the writer
+thread (the "stalls" handler counts these waits).  If false, ToDump drops
+the packet from the file (the "drops" handler counts these packets), but
+still emits it.  Default is true.
+
+=item DIRECT
+
+Boolean.  If true, the writer thread opens the file with O_DIRECT, bypassing
+the operating system's page cache, where the file system supports it.
+Default is false.
+
+=item ROTATE_SIZE
+
+Integer.  If nonzero, ToDump starts a new file before a file would grow
+beyond ROTATE_SIZE bytes.  Every file starts with its own file header and
+holds at least one packet.  If FILENAME contains "%n", the file number
+replaces the "%n"; otherwise the first file is FILENAME and later files are
+FILENAME.1, FILENAME.2, and so forth.  Default is 0.
+
+=item ROTATE_INTERVAL
+
+Timestamp.  If nonzero, ToDump starts a new file at the first packet after
+ROTATE_INTERVAL has passed since the current file was opened.  Files are
+named as for ROTATE_SIZE.  Default is 0.
+
 =back
 
 This element is only available at user level.
@@ -80,6 +125,15 @@ Resets "count" to 0.
 
 Returns the filename.
 
+=h drops read-only
+
+Returns the number of packets left out of the file because every ASYNC buffer
+was full.
+
+=h stalls read-only
+
+Returns the number of times ToDump waited for the ASYNC writer thread.
+
 =a
 
 FromDump, FromDevice.u, ToDevice.u, tcpdump(1) */
@@ -109,8 +163,7 @@ class ToDump : public Element { public:
 
   private:
 
-    String _filename;
-    FILE *_fp;
+    ToFile _tf;
     unsigned _snaplen;
     int _linktype;
     bool _active;
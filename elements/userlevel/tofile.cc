@@ -0,0 +1,472 @@
+// -*- mode: c++; c-basic-offset: 4 -*-
+/*
+ * tofile.{cc,hh} -- writes dump files, optionally from a writer thread
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include "tofile.hh"
+#include <click/confparse.hh>
+#include <click/error.hh>
+#include <click/element.hh>
+#include <click/userutils.hh>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdlib.h>
+CLICK_DECLS
+
+ToFile::ToFile()
+    : _initialized(false), _async(false), _blocking(true), _direct(false),
+      _buffer_size(1 << 20), _nbuffers(2), _f(0), _fd(-1), _pipe(false),
+      _fileno(0), _rotate_size(0), _file_bytes(0), _errno(0),
+      _drops(0), _stalls(0)
+#if CLICK_TOFILE_ASYNC
+    , _bufs(0), _writer_started(false)
+#endif
+{
+}
+
+int
+ToFile::configure_keywords(Vector<String> &conf, Element *e, ErrorHandler *errh)
+{
+    bool async = _async, blocking = _blocking, direct = _direct;
+    uint32_t buffer_size = _buffer_size, nbuffers = _nbuffers;
+    uint64_t rotate_size = _rotate_size;
+    Timestamp rotate_interval = _rotate_interval;
+    if (cp_va_kparse_remove_keywords(conf, e, errh,
+		    "ASYNC", 0, cpBool, &async,
+		    "BUFFER_SIZE", 0, cpUnsigned, &buffer_size,
+		    "BUFFERS", 0, cpUnsigned, &nbuffers,
+		    "BLOCKING", 0, cpBool, &blocking,
+		    "DIRECT", 0, cpBool, &direct,
+		    "ROTATE_SIZE", 0, cpUnsigned64, &rotate_size,
+		    "ROTATE_INTERVAL", 0, cpTimestamp, &rotate_interval,
+		    cpEnd) < 0)
+	return -1;
+#if !CLICK_TOFILE_ASYNC
+    if (async)
+	return errh->error("'ASYNC' requires multithreading support");
+#endif
+    if (nbuffers < 2)
+	return errh->error("'BUFFERS' must be at least 2");
+    if (buffer_size > (1U << 30))
+	return errh->error("'BUFFER_SIZE' too large");
+    // whole pages keep O_DIRECT writes aligned
+    _buffer_size = (buffer_size + ALIGN - 1) & ~(ALIGN - 1);
+    if (_buffer_size == 0)
+	_buffer_size = ALIGN;
+    _async = async;
+    _blocking = blocking;
+    _direct = direct;
+    _nbuffers = nbuffers;
+    _rotate_size = rotate_size;
+    _rotate_interval = rotate_interval;
+    return 0;
+}
+
+String
+ToFile::print_filename() const
+{
+    if (!_filename || _filename == "-")
+	return String::make_stable("<stdout>", 8);
+    else
+	return _filename;
+}
+
+String
+ToFile::file_name(uint32_t fileno) const
+{
+    // "%n" in the filename becomes the file number; otherwise, later files
+    // get a numeric suffix
+    int pct = _filename.find_left("%n");
+    if (pct >= 0)
+	return _filename.substring(0, pct) + String(fileno) + _filename.substring(pct + 2);
+    else if (fileno == 0)
+	return _filename;
+    else
+	return _filename + "." + String(fileno);
+}
+
+int
+ToFile::open_file(ErrorHandler *errh)
+{
+    String name = file_name(_fileno);
+    _f = 0;
+    _fd = -1;
+    _pipe = false;
+    if (!_filename || _filename == "-") {
+	_f = stdout;
+	_fd = STDOUT_FILENO;
+    } else if (compressed_filename(name) > 0) {
+	if (!(_f = open_compress_pipe(name, errh)))
+	    return -1;
+	_fd = fileno(_f);
+	_pipe = true;
+    } else if (_async) {
+	int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+	// not every file system supports O_DIRECT
+	if (_direct)
+	    _fd = open(name.c_str(), flags | O_DIRECT, 0666);
+	if (_fd < 0)
+#endif
+	    _fd = open(name.c_str(), flags, 0666);
+    } else if ((_f = fopen(name.c_str(), "wb")))
+	_fd = fileno(_f);
+    if (_fd < 0)
+	return errh->error("%s: %s", name.c_str(), strerror(errno));
+
+    _file_bytes = 0;
+    if (_rotate_interval)
+	_rotate_at = Timestamp::now() + _rotate_interval;
+    if (_header && !write(_header))
+	return errh->error("%s: unable to write file header", name.c_str());
+    return 0;
+}
+
+void
+ToFile::close_file()
+{
+    if (_pipe)
+	pclose(_f);
+    else if (_f == stdout)
+	fflush(stdout);
+    else if (_f)
+	fclose(_f);
+    else if (_fd >= 0)
+	close(_fd);
+    _f = 0;
+    _fd = -1;
+    _pipe = false;
+}
+
+#if CLICK_TOFILE_ASYNC
+extern "C" {
+static void *tofile_writer_thread(void *arg)
+{
+    return ToFile::writer_thread(arg);
+}
+}
+#endif
+
+int
+ToFile::initialize(ErrorHandler *errh)
+{
+    if ((_rotate_size || _rotate_interval) && (!_filename || _filename == "-"))
+	return errh->error("can't rotate the standard output");
+
+    _fileno = 0;
+    _errno = 0;
+#if CLICK_TOFILE_ASYNC
+    if (_async) {
+	_bufs = new Buffer[_nbuffers];
+	for (uint32_t i = 0; i < _nbuffers; ++i) {
+	    void *data;
+	    if (posix_memalign(&data, ALIGN, _buffer_size) != 0)
+		data = 0;
+	    _bufs[i].data = reinterpret_cast<char *>(data);
+	    _bufs[i].len = 0;
+	}
+	_fill = _drain = _nfull = 0;
+	_writer_stop = _router_waiting = false;
+	pthread_mutex_init(&_lock, 0);
+	pthread_cond_init(&_writer_cond, 0);
+	pthread_cond_init(&_router_cond, 0);
+	_initialized = true;
+	for (uint32_t i = 0; i < _nbuffers; ++i)
+	    if (!_bufs[i].data)
+		return errh->error("out of memory");
+    }
+#endif
+
+    if (open_file(errh) < 0)
+	return -1;
+    _initialized = true;
+
+#if CLICK_TOFILE_ASYNC
+    if (_async) {
+	int err = pthread_create(&_writer, 0, tofile_writer_thread, this);
+	if (err != 0)
+	    return errh->error("cannot start writer thread: %s", strerror(err));
+	_writer_started = true;
+    }
+#endif
+    return 0;
+}
+
+void
+ToFile::cleanup()
+{
+    if (!_initialized)
+	return;
+#if CLICK_TOFILE_ASYNC
+    if (_async) {
+	if (_writer_started) {
+	    // the writer closes the file after the last buffer
+	    hand_off(true);
+	    pthread_mutex_lock(&_lock);
+	    _writer_stop = true;
+	    pthread_cond_signal(&_writer_cond);
+	    pthread_mutex_unlock(&_lock);
+	    pthread_join(_writer, 0);
+	    _writer_started = false;
+	    _f = 0;
+	    _fd = -1;
+	}
+	for (uint32_t i = 0; i < _nbuffers; ++i)
+	    free(_bufs[i].data);
+	delete[] _bufs;
+	_bufs = 0;
+	pthread_mutex_destroy(&_lock);
+	pthread_cond_destroy(&_writer_cond);
+	pthread_cond_destroy(&_router_cond);
+    }
+#endif
+    close_file();
+    _initialized = false;
+}
+
+void
+ToFile::take_state(ToFile &o, ErrorHandler *)
+{
+    // Only synchronous ToFiles are hotswapped.
+    assert(!_async && !o._async && !_initialized);
+    _f = o._f;
+    _fd = o._fd;
+    _pipe = o._pipe;
+    _fileno = o._fileno;
+    _file_bytes = o._file_bytes;
+    _rotate_at = o._rotate_at;
+    _initialized = o._initialized;
+    o._f = 0;
+    o._fd = -1;
+    o._pipe = false;
+    o._initialized = false;
+}
+
+bool
+ToFile::need_rotate(size_t len)
+{
+    // never leave a file with nothing but its header
+    if (_file_bytes <= (uint64_t) _header.length())
+	return false;
+    if (_rotate_size && _file_bytes + len > _rotate_size)
+	return true;
+    return _rotate_interval && Timestamp::now() >= _rotate_at;
+}
+
+bool
+ToFile::rotate()
+{
+#if CLICK_TOFILE_ASYNC
+    if (_async)
+	hand_off(true);
+    else
+#endif
+	close_file();
+    ++_fileno;
+    if (open_file(ErrorHandler::default_handler()) < 0) {
+	if (!_errno)
+	    _errno = (errno ? errno : EIO);
+	return false;
+    }
+    return true;
+}
+
+bool
+ToFile::write(const void *data, size_t len)
+{
+    if (_errno)
+	return false;
+    _file_bytes += len;
+#if CLICK_TOFILE_ASYNC
+    if (_async)
+	return async_write(reinterpret_cast<const char *>(data), len);
+#endif
+    if (len && fwrite(data, 1, len, _f) != len) {
+	if (errno != EAGAIN)
+	    _errno = errno;
+	return false;
+    }
+    return true;
+}
+
+int
+ToFile::flush()
+{
+#if CLICK_TOFILE_ASYNC
+    if (_async) {
+	if (_bufs[_fill].len)
+	    hand_off(false);
+	pthread_mutex_lock(&_lock);
+	_router_waiting = true;
+	while (_nfull)
+	    pthread_cond_wait(&_router_cond, &_lock);
+	_router_waiting = false;
+	pthread_mutex_unlock(&_lock);
+	return _errno ? -1 : 0;
+    }
+#endif
+    return _f ? fflush(_f) : 0;
+}
+
+#if CLICK_TOFILE_ASYNC
+bool
+ToFile::have_room(size_t len)
+{
+    // Can the current buffer and the free ones hold len more bytes?
+    size_t spill = len - (_buffer_size - _bufs[_fill].len);
+    uint32_t need = (spill + _buffer_size - 1) / _buffer_size;
+    pthread_mutex_lock(&_lock);
+    bool ok = _nbuffers - 1 - _nfull >= need;
+    pthread_mutex_unlock(&_lock);
+    return ok;
+}
+
+void
+ToFile::hand_off(bool close)
+{
+    Buffer &b = _bufs[_fill];
+    b.fd = _fd;
+    b.f = _f;
+    b.pipe = _pipe;
+    b.close = close && _f != stdout;
+    pthread_mutex_lock(&_lock);
+    ++_nfull;
+    pthread_cond_signal(&_writer_cond);
+    if (_nfull == _nbuffers) {
+	// every buffer is full: wait for the writer
+	++_stalls;
+	_router_waiting = true;
+	while (_nfull == _nbuffers)
+	    pthread_cond_wait(&_router_cond, &_lock);
+	_router_waiting = false;
+    }
+    pthread_mutex_unlock(&_lock);
+    _fill = (_fill + 1) % _nbuffers;
+}
+
+bool
+ToFile::async_write(const char *data, size_t len)
+{
+    while (len) {
+	Buffer &b = _bufs[_fill];
+	size_t n = _buffer_size - b.len;
+	if (n > len)
+	    n = len;
+	memcpy(b.data + b.len, data, n);
+	b.len += n;
+	data += n;
+	len -= n;
+	if (b.len == _buffer_size)
+	    hand_off(false);
+    }
+    return !_errno;
+}
+
+void
+ToFile::write_buffer(Buffer &b)
+{
+    const char *data = b.data;
+    size_t len = b.len;
+#ifdef O_DIRECT
+    // O_DIRECT needs whole pages; a partial buffer ends the aligned stream
+    if (len % ALIGN) {
+	int flags = fcntl(b.fd, F_GETFL);
+	if (flags >= 0 && (flags & O_DIRECT))
+	    (void) fcntl(b.fd, F_SETFL, flags & ~O_DIRECT);
+    }
+#endif
+    while (len && !_errno) {
+	ssize_t w = ::write(b.fd, data, len);
+	if (w > 0) {
+	    data += w;
+	    len -= w;
+	} else if (w < 0 && errno != EINTR && errno != EAGAIN) {
+#ifdef O_DIRECT
+	    int flags = fcntl(b.fd, F_GETFL);
+	    if (errno == EINVAL && flags >= 0 && (flags & O_DIRECT)) {
+		(void) fcntl(b.fd, F_SETFL, flags & ~O_DIRECT);
+		continue;
+	    }
+#endif
+	    _errno = errno;
+	}
+    }
+
+    if (b.close) {
+	if (b.pipe)
+	    pclose(b.f);
+	else if (b.f)
+	    fclose(b.f);
+	else
+	    close(b.fd);
+    }
+}
+
+void *
+ToFile::writer_thread(void *arg)
+{
+    static_cast<ToFile *>(arg)->run_writer();
+    return 0;
+}
+
+void
+ToFile::run_writer()
+{
+    pthread_mutex_lock(&_lock);
+    while (1) {
+	while (_nfull == 0 && !_writer_stop)
+	    pthread_cond_wait(&_writer_cond, &_lock);
+	if (_nfull == 0)
+	    break;
+	Buffer &b = _bufs[_drain];
+	pthread_mutex_unlock(&_lock);
+
+	write_buffer(b);
+
+	pthread_mutex_lock(&_lock);
+	b.len = 0;
+	_drain = (_drain + 1) % _nbuffers;
+	--_nfull;
+	if (_router_waiting)
+	    pthread_cond_signal(&_router_cond);
+    }
+    pthread_mutex_unlock(&_lock);
+}
+#endif
+
+String
+ToFile::drops_handler(Element *e, void *thunk)
+{
+    ToFile *tf = reinterpret_cast<ToFile *>((uint8_t *)e + (intptr_t)thunk);
+    return String(tf->_drops);
+}
+
+String
+ToFile::stalls_handler(Element *e, void *thunk)
+{
+    ToFile *tf = reinterpret_cast<ToFile *>((uint8_t *)e + (intptr_t)thunk);
+    return String(tf->_stalls);
+}
+
+void
+ToFile::add_handlers(Element *e) const
+{
+    intptr_t offset = (const uint8_t *)this - (const uint8_t *)e;
+    e->add_read_handler("drops", drops_handler, (void *)offset);
+    e->add_read_handler("stalls", stalls_handler, (void *)offset);
+}
+
+CLICK_ENDDECLS
+ELEMENT_REQUIRES(userlevel|ns)
+ELEMENT_PROVIDES(ToFile)
@@ -0,0 +1,148 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_TOFILE_HH
+#define CLICK_TOFILE_HH
+#include <click/string.hh>
+#include <click/vector.hh>
+#include <click/timestamp.hh>
+#include <stdio.h>
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+# include <pthread.h>
+# define CLICK_TOFILE_ASYNC 1
+#endif
+CLICK_DECLS
+class ErrorHandler;
+class Element;
+
+/*
+ * ToFile writes a stream of records to a file for ToDump, ToIPSummaryDump,
+ * and similar elements.  Records are never split across files, so the file
+ * can be rotated between any two records; each new file starts with the
+ * header set by set_header().
+ *
+ * By default ToFile writes through stdio on the router thread.  With ASYNC,
+ * it copies records into a ring of large, page-aligned buffers, and a writer
+ * thread writes full buffers to the file with write(2), optionally using
+ * O_DIRECT.  When every buffer is waiting to be written, the router thread
+ * either waits for the writer (a "stall") or drops the record.
+ */
+
+class ToFile { public:
+
+    ToFile();
+    ~ToFile()				{ cleanup(); }
+
+    const String &filename() const	{ return _filename; }
+    String &filename()			{ return _filename; }
+    String print_filename() const;
+    bool initialized() const		{ return _initialized; }
+    bool async() const			{ return _async; }
+
+    void set_header(const String &header) { _header = header; }
+
+    int configure_keywords(Vector<String> &conf, Element *, ErrorHandler *);
+    int initialize(ErrorHandler *);
+    void add_handlers(Element *) const;
+    void cleanup();
+    void take_state(ToFile &, ErrorHandler *);
+
+    inline bool begin_record(size_t len);
+    bool write(const void *data, size_t len);
+    bool write(const String &s)		{ return write(s.data(), s.length()); }
+    int flush();
+
+    int last_errno() const		{ return _errno; }
+
+#if CLICK_TOFILE_ASYNC
+    static void *writer_thread(void *);
+#endif
+
+  private:
+
+    enum { ALIGN = 4096 };
+
+    String _filename;
+    String _header;
+    bool _initialized;
+    bool _async;
+    bool _blocking;
+    bool _direct;
+    uint32_t _buffer_size;
+    uint32_t _nbuffers;
+
+    FILE *_f;
+    int _fd;
+    bool _pipe;
+
+    uint32_t _fileno;		// number of the current file
+    uint64_t _rotate_size;
+    uint64_t _file_bytes;	// bytes written to the current file
+    Timestamp _rotate_interval;
+    Timestamp _rotate_at;
+
+    volatile int _errno;
+
+#if HAVE_INT64_TYPES
+    typedef uint64_t counter_t;
+#else
+    typedef uint32_t counter_t;
+#endif
+    counter_t _drops;
+    counter_t _stalls;
+
+#if CLICK_TOFILE_ASYNC
+    struct Buffer {
+	char *data;
+	uint32_t len;
+	int fd;
+	FILE *f;
+	bool pipe;
+	bool close;		// close the file after writing this buffer
+    };
+    Buffer *_bufs;
+    uint32_t _fill;		// buffer the router thread is filling
+    uint32_t _drain;		// next buffer for the writer thread
+    uint32_t _nfull;		// buffers waiting for the writer
+    bool _writer_stop;
+    bool _router_waiting;
+    bool _writer_started;
+    pthread_t _writer;
+    pthread_mutex_t _lock;
+    pthread_cond_t _writer_cond;
+    pthread_cond_t _router_cond;
+
+    bool have_room(size_t len);
+    void hand_off(bool close);
+    bool async_write(const char *data, size_t len);
+    void write_buffer(Buffer &b);
+    void run_writer();
+#endif
+
+    String file_name(uint32_t fileno) const;
+    int open_file(ErrorHandler *);
+    void close_file();
+    bool need_rotate(size_t len);
+    bool rotate();
+
+    static String drops_handler(Element *, void *);
+    static String stalls_handler(Element *, void *);
+
+};
+
+inline bool
+ToFile::begin_record(size_t len)
+{
+    if (unlikely(_rotate_size || _rotate_interval) && need_rotate(len)
+	&& !rotate())
+	return false;
+#if CLICK_TOFILE_ASYNC
+    if (_async && !_blocking && len > _buffer_size - _bufs[_fill].len
+	&& !have_room(len)) {
+	++_drops;
+	return false;
+    }
+#endif
+    return true;
+}
+
+CLICK_ENDDECLS
+#endif
@@ -529,5 +529,142 @@ operator<=(const atomic_uint32_t &a, const atomic_uint32_t &b)
 
 typedef atomic_uint32_t uatomic32_t;
 
+
+/** @class atomic_pointer
+ * @brief A pointer with support for atomic operations.
+ *
+ * The atomic_pointer<T> template represents a pointer to T with atomic
+ * swap() and compare_and_swap() operations.  Lock-free data structures, such
+ * as free lists shared between threads, use it to publish and claim nodes.
+ *
+ * Like atomic_uint32_t, atomic_pointer has no explicit constructor; use
+ * operator= to set its value.  It provides true atomic semantics in the same
+ * situations as atomic_uint32_t.
+ */
+template <typename T>
+class atomic_pointer { public:
+
+    /** @brief Return the value. */
+    inline T *value() const {
+	return _val;
+    }
+
+    /** @brief Return the value. */
+    inline operator T *() const {
+	return _val;
+    }
+
+    /** @brief Set the value to @a x. */
+    inline atomic_pointer<T> &operator=(T *x) {
+	_val = x;
+	return *this;
+    }
+
+    inline T *swap(T *x);
+    inline bool compare_and_swap(T *test_value, T *new_value);
+
+  private:
+
+    T * volatile _val;
+
+};
+
+/** @brief Atomically assign the value to @a x, returning the old value.
+ *
+ * Also acts as a memory barrier. */
+template <typename T>
+inline T *
+atomic_pointer<T>::swap(T *x)
+{
+#if CLICK_ATOMIC_X86
+    asm volatile ("xchg %0,%1"
+		  : "=r" (x), "=m" (_val)
+		  : "0" (x), "m" (_val)
+		  : "memory");
+    return x;
+#elif CLICK_LINUXMODULE && defined(xchg)
+    return xchg(&_val, x);
+#elif HAVE_MULTITHREAD
+    return __sync_lock_test_and_set(&_val, x);
+#else
+    T *old_value = _val;
+    _val = x;
+    return old_value;
+#endif
+}
+
+/** @brief Perform a compare-and-swap operation.
+ * @param test_value test value
+ * @param new_value new value
+ * @return True if the old value equaled @a test_value (in which case the
+ *	   value was set to @a new_value), false otherwise.
+ *
+ * Also acts as a memory barrier. */
+template <typename T>
+inline bool
+atomic_pointer<T>::compare_and_swap(T *test_value, T *new_value)
+{
+#if CLICK_ATOMIC_X86
+    T *old_value;
+    asm volatile (CLICK_ATOMIC_LOCK "cmpxchg %2,%1"
+		  : "=a" (old_value), "=m" (_val)
+		  : "r" (new_value), "m" (_val), "0" (test_value)
+		  : "cc", "memory");
+    return old_value == test_value;
+#elif CLICK_LINUXMODULE && defined(cmpxchg)
+    return cmpxchg(&_val, test_value, new_value) == test_value;
+#elif HAVE_MULTITHREAD
+    return __sync_bool_compare_and_swap(&_val, test_value, new_value);
+#else
+    T *old_value = _val;
+    if (old_value == test_value)
+	_val = new_value;
+    return old_value == test_value;
+#endif
+}
+
+/** @brief Prevent the compiler from moving memory accesses across this
+ * point.  Generates no instructions. */
+inline void
+click_compiler_fence()
+{
+    asm volatile ("" : : : "memory");
+}
+
+/** @brief Full memory barrier.
+ *
+ * No load or store moves across the fence, in either direction, including
+ * stores followed by loads.  Use this for handshakes where a thread stores a
+ * flag and then loads another thread's flag, such as epoch announcements, and
+ * for memory shared with the kernel or devices. */
+inline void
+click_fence()
+{
+#if CLICK_LINUXMODULE
+    smp_mb();
+#elif HAVE___SYNC_SYNCHRONIZE
+    __sync_synchronize();
+#else
+    click_compiler_fence();
+#endif
+}
+
+/** @brief Order loads before later loads and stores before later stores.
+ *
+ * Use this to publish data before the index or pointer that makes it
+ * visible, and on the reader side, to read that index or pointer before the
+ * data.  It does not order a store before a later load; use click_fence()
+ * for that.  x86 processors never make those reorderings, so there this is
+ * only a compiler barrier. */
+inline void
+click_order_fence()
+{
+#if defined(__i386__) || defined(__arch_um__) || defined(__x86_64__)
+    click_compiler_fence();
+#else
+    click_fence();
+#endif
+}
+
 CLICK_ENDDECLS
 #endif
@@ -5,6 +5,7 @@
 #include <click/vector.hh>
 #include <click/string.hh>
 #include <click/packet.hh>
+#include <click/packetbatch.hh>
 #include <click/handler.hh>
 CLICK_DECLS
 class Router;
@@ -16,6 +17,7 @@ class Element;
 class ErrorHandler;
 class Bitvector;
 class EtherAddress;
+class PerThreadCounter;
 
 /** @file <click/element.hh>
  * @brief Click's Element class.
@@ -36,6 +38,9 @@ class Element { public:
     virtual Packet *pull(int port) CLICK_WARN_UNUSED_RESULT;
     virtual Packet *simple_action(Packet *p);
 
+    virtual void push_batch(int port, PacketBatch &batch);
+    virtual PacketBatch pull_batch(int port, unsigned max);
+
     virtual bool run_task(Task *task);	// return true iff did useful work
     virtual void run_timer(Timer *timer);
 #if CLICK_USERLEVEL
@@ -45,6 +50,7 @@ class Element { public:
 #endif
 
     inline void checked_output_push(int port, Packet *p) const;
+    inline void checked_output_push_batch(int port, PacketBatch &batch) const;
 
     // ELEMENT CHARACTERISTICS
     virtual const char *class_name() const = 0;
@@ -172,6 +178,7 @@ class Element { public:
     void add_data_handlers(const String &name, int flags, int *data);
     void add_data_handlers(const String &name, int flags, unsigned *data);
     void add_data_handlers(const String &name, int flags, atomic_uint32_t *data);
+    void add_data_handlers(const String &name, int flags, PerThreadCounter *data);
     void add_data_handlers(const String &name, int flags, long *data);
     void add_data_handlers(const String &name, int flags, unsigned long *data);
 #if HAVE_LONG_LONG
@@ -205,6 +212,9 @@ class Element { public:
 	inline void push(Packet* p) const;
 	inline Packet* pull() const;
 
+	inline void push_batch(PacketBatch &batch) const;
+	inline PacketBatch pull_batch(unsigned max) const;
+
 #if CLICK_STATS >= 1
 	unsigned npackets() const	{ return _packets; }
 #endif
@@ -288,6 +298,7 @@ class Element { public:
 #if CLICK_STATS >= 2
     friend class Task;
     friend class Master;
+    friend class TimerSet;
 #endif
 
 };
@@ -619,6 +630,66 @@ Element::Port::pull() const
     return p;
 }
 
+/** @brief Push the packets in @a batch over this port.
+ *
+ * Pushes every packet in @a batch downstream with a single call to the next
+ * element's @link Element::push_batch() push_batch() @endlink function.
+ * When push_batch() returns, @a batch is empty.
+ *
+ * This port must be an active() push output port.  As with push(), element
+ * code relinquishes control of the batch's packets when it calls
+ * push_batch().
+ */
+inline void
+Element::Port::push_batch(PacketBatch &batch) const
+{
+    assert(_e);
+#if CLICK_STATS >= 1
+    _packets += batch.count();
+#endif
+#if CLICK_STATS >= 2
+    _e->input(_port)._packets += batch.count();
+    click_cycles_t c0 = click_get_cycles();
+    _e->push_batch(_port, batch);
+    click_cycles_t x = click_get_cycles() - c0;
+    ++_e->_calls;
+    _e->_self_cycles += x;
+    _owner->_child_cycles += x;
+#else
+    _e->push_batch(_port, batch);
+#endif
+    assert(batch.empty());
+}
+
+/** @brief Pull at most @a max packets over this port and return them.
+ *
+ * Pulls a batch of packets from upstream with a single call to the previous
+ * element's @link Element::pull_batch() pull_batch() @endlink function.  The
+ * returned batch may be empty, and contains at most @a max packets.
+ *
+ * This port must be an active() pull input port.
+ */
+inline PacketBatch
+Element::Port::pull_batch(unsigned max) const
+{
+    assert(_e);
+#if CLICK_STATS >= 2
+    click_cycles_t c0 = click_get_cycles();
+    PacketBatch batch = _e->pull_batch(_port, max);
+    click_cycles_t x = click_get_cycles() - c0;
+    ++_e->_calls;
+    _e->_self_cycles += x;
+    _owner->_child_cycles += x;
+    _e->output(_port)._packets += batch.count();
+#else
+    PacketBatch batch = _e->pull_batch(_port, max);
+#endif
+#if CLICK_STATS >= 1
+    _packets += batch.count();
+#endif
+    return batch;
+}
+
 /** @brief Push packet @a p to output @a port, or kill it if @a port is out of
  * range.
  *
@@ -640,6 +711,24 @@ Element::checked_output_push(int port, Packet* p) const
 	p->kill();
 }
 
+/** @brief Push @a batch to output @a port, or kill its packets if @a port
+ * is out of range.
+ *
+ * @param port output port number
+ * @param batch packets to push
+ *
+ * The batch analogue of checked_output_push().  When this function returns,
+ * @a batch is empty.
+ */
+inline void
+Element::checked_output_push_batch(int port, PacketBatch &batch) const
+{
+    if ((unsigned) port < (unsigned) noutputs())
+	_ports[1][port].push_batch(batch);
+    else
+	batch.kill();
+}
+
 #undef PORT_ASSIGN
 CLICK_ENDDECLS
 #endif
@@ -0,0 +1,591 @@
+#ifndef CLICK_FLOWHASHTABLE_HH
+#define CLICK_FLOWHASHTABLE_HH
+#include <click/glue.hh>
+#include <click/hashcode.hh>
+#include <click/integers.hh>
+#if defined(__SSE2__) && !CLICK_LINUXMODULE && !CLICK_BSDMODULE
+# include <emmintrin.h>
+# define CLICK_FLOWHASHTABLE_SSE2 1
+#endif
+CLICK_DECLS
+
+template <typename K, typename V> class FlowHashTable;
+template <typename K, typename V> class FlowHashTable_const_iterator;
+template <typename K, typename V> class FlowHashTable_iterator;
+
+/** @cond never */
+class FlowHashTable_group { public:
+
+    // A group is a window of control bytes examined at once.  Each control
+    // byte is empty, deleted, or a 7-bit tag taken from a full slot's hash.
+    enum {
+	ctrl_empty = -128,
+	ctrl_deleted = -2
+    };
+
+#if CLICK_FLOWHASHTABLE_SSE2
+    enum { width = 16 };
+    typedef unsigned mask_type;
+
+    explicit FlowHashTable_group(const int8_t *ctrl)
+	: _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {
+    }
+    mask_type match(int8_t tag) const {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), _ctrl));
+    }
+    mask_type match_empty() const {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), _ctrl));
+    }
+    mask_type match_free() const {
+	return _mm_movemask_epi8(_ctrl);
+    }
+    static int lowest(mask_type m) {
+	return ffs_lsb(m) - 1;
+    }
+    static int highest(mask_type m) {
+	return 32 - ffs_msb(m);
+    }
+
+  private:
+    __m128i _ctrl;
+#else
+    enum { width = 8 };
+    typedef uint64_t mask_type;
+
+    // Portable version: examine 8 control bytes in a 64-bit word.  match()
+    // may report false positives, but only for full slots, whose keys are
+    // compared anyway.
+    explicit FlowHashTable_group(const int8_t *ctrl) {
+	memcpy(&_ctrl, ctrl, sizeof(_ctrl));
+# if CLICK_BYTE_ORDER == CLICK_BIG_ENDIAN
+	_ctrl = __builtin_bswap64(_ctrl);
+# endif
+    }
+    mask_type match(int8_t tag) const {
+	uint64_t x = _ctrl ^ (lsbs * (uint8_t) tag);
+	return (x - lsbs) & ~x & msbs;
+    }
+    mask_type match_empty() const {
+	return _ctrl & (~_ctrl << 6) & msbs;
+    }
+    mask_type match_free() const {
+	return _ctrl & msbs;
+    }
+    static int lowest(mask_type m) {
+	return (ffs_lsb(m) - 1) >> 3;
+    }
+    static int highest(mask_type m) {
+	return (64 - ffs_msb(m)) >> 3;
+    }
+
+  private:
+    static const uint64_t lsbs = 0x0101010101010101ULL;
+    static const uint64_t msbs = 0x8080808080808080ULL;
+    uint64_t _ctrl;
+#endif
+
+};
+/** @endcond never */
+
+/** @class FlowHashTable
+  @brief Open-addressing hash table for flow lookups.
+
+  The FlowHashTable template implements an associative array optimized for large
+  tables of small keys, such as IPFlowID, that are looked up once per packet.
+  Its interface resembles HashTable<K, V>.
+
+  FlowHashTable stores keys and values inline in a single array of slots, so a
+  lookup never chases pointers.  A parallel array holds one control byte per
+  slot: 7 bits of the slot's hash, or a marker for an empty or deleted slot.
+  A lookup examines a group of 16 control bytes at once with SSE2
+  instructions (8 bytes at once with portable 64-bit arithmetic when SSE2 is
+  not available), and compares keys only for the rare slots whose hash bits
+  match.  Usually a lookup touches one control group and one slot.  Code that
+  processes packets in batches can hide even those cache misses by calling
+  prefetch() for each packet's key before looking any of them up.
+
+  The table grows automatically, keeping at least one slot in eight free.
+  Erasing a slot leaves a marker only when some probe sequence may pass over
+  it; the markers are cleaned up when the table next grows.
+
+  K must support equality and have a hashcode() function.  Values are copied
+  into the table, so V should be small.
+
+  @note Inserting an element into a FlowHashTable invalidates all iterators and
+  pointers to values.  Erasing an element invalidates only that element's
+  iterators and pointers. */
+template <typename K, typename V>
+class FlowHashTable { public:
+
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef size_t size_type;
+
+    enum {
+	group_width = FlowHashTable_group::width,
+	initial_capacity = 16
+    };
+
+    /** @brief Construct an empty flow table. */
+    FlowHashTable()
+	: _default_value() {
+	initialize(initial_capacity);
+    }
+
+    /** @brief Construct an empty flow table with default value @a d. */
+    explicit FlowHashTable(const mapped_type &d)
+	: _default_value(d) {
+	initialize(initial_capacity);
+    }
+
+    /** @brief Destroy the flow table, freeing its memory. */
+    ~FlowHashTable();
+
+
+    /** @brief Return the number of elements. */
+    size_type size() const {
+	return _size;
+    }
+
+    /** @brief Return true iff size() == 0. */
+    bool empty() const {
+	return _size == 0;
+    }
+
+    /** @brief Return the number of slots. */
+    size_type bucket_count() const {
+	return _capacity;
+    }
+
+    /** @brief Return the number of bytes used by slots and control bytes. */
+    size_t memory_size() const {
+	return alloc_size(_capacity);
+    }
+
+    /** @brief Return the default value. */
+    const mapped_type &default_value() const {
+	return _default_value;
+    }
+
+
+    typedef FlowHashTable_const_iterator<K, V> const_iterator;
+    typedef FlowHashTable_iterator<K, V> iterator;
+
+    /** @brief Return an iterator for the first element in the table.
+     *
+     * @note FlowHashTable iterators return elements in undefined order. */
+    inline iterator begin();
+    /** @overload */
+    inline const_iterator begin() const;
+
+    /** @brief Return an iterator for the end of the table.
+     * @invariant end().live() == false */
+    inline iterator end();
+    /** @overload */
+    inline const_iterator end() const;
+
+    /** @brief Return an iterator for the element with key @a key, if any.
+     *
+     * Returns end() if no such element exists. */
+    inline iterator find(const key_type &key);
+    /** @overload */
+    inline const_iterator find(const key_type &key) const;
+
+    /** @brief Return the value for @a key, or default_value() if no element
+     * for @a key exists. */
+    const mapped_type &get(const key_type &key) const {
+	size_type i = find_index(key, hash(key));
+	return i == _capacity ? _default_value : _slots[i].value;
+    }
+
+    /** @brief Return a pointer to the value for @a key, or null if no
+     * element for @a key exists. */
+    mapped_type *get_pointer(const key_type &key) {
+	size_type i = find_index(key, hash(key));
+	return i == _capacity ? 0 : &_slots[i].value;
+    }
+    /** @overload */
+    const mapped_type *get_pointer(const key_type &key) const {
+	size_type i = find_index(key, hash(key));
+	return i == _capacity ? 0 : &_slots[i].value;
+    }
+
+    /** @brief Return a reference to the value for @a key.
+     *
+     * If no element for @a key exists, adds a new element with
+     * default_value() and returns a reference to that value. */
+    mapped_type &operator[](const key_type &key) {
+	size_type i = find_insert_index(key, _default_value);
+	return _slots[i].value;
+    }
+
+    /** @brief Ensure an element for key @a key and return its iterator.
+     *
+     * If no element for @a key exists, adds a new element mapping @a key to
+     * @a value. */
+    inline iterator find_insert(const key_type &key, const mapped_type &value);
+
+    /** @brief Set the mapping for @a key to @a value.
+     * @return true if a new element was added, false if an existing
+     * element's value was assigned */
+    bool set(const key_type &key, const mapped_type &value) {
+	size_type old_size = _size;
+	size_type i = find_insert_index(key, value);
+	_slots[i].value = value;
+	return _size != old_size;
+    }
+
+    /** @brief Remove the element indicated by @a it.
+     * @return an iterator for the next element */
+    inline iterator erase(const iterator &it);
+
+    /** @brief Remove any element with @a key.
+     * @return the number of elements removed, which is always 0 or 1 */
+    size_type erase(const key_type &key) {
+	size_type i = find_index(key, hash(key));
+	if (i == _capacity)
+	    return 0;
+	erase_index(i);
+	return 1;
+    }
+
+    /** @brief Remove all elements.
+     * @post size() == 0 */
+    void clear();
+
+    /** @brief Prefetch the memory a lookup of @a key would touch.
+     *
+     * Call prefetch() for a batch of keys before looking any of them up to
+     * overlap the lookups' cache misses. */
+    void prefetch(const key_type &key) const {
+#ifdef __GNUC__
+	size_type i = (hash(key) >> 7) & (_capacity - 1);
+	__builtin_prefetch(_ctrl + i);
+	__builtin_prefetch(_slots + i);
+#else
+	(void) key;
+#endif
+    }
+
+  private:
+
+    struct slot_type {
+	K key;
+	V value;
+	slot_type(const K &k, const V &v)
+	    : key(k), value(v) {
+	}
+    };
+
+    slot_type *_slots;
+    int8_t *_ctrl;
+    size_type _capacity;
+    size_type _size;
+    size_type _growth_left;
+    V _default_value;
+
+    static inline uint64_t hash(const key_type &key) {
+	uint64_t h = (uint64_t) hashcode(key) * 0x9E3779B97F4A7C15ULL;
+	return h ^ (h >> 32);
+    }
+    static size_type growth_limit(size_type capacity) {
+	return capacity - capacity / 8;
+    }
+    static size_t alloc_size(size_type capacity) {
+	return capacity * (sizeof(slot_type) + 1) + group_width;
+    }
+
+    void initialize(size_type capacity);
+    void set_ctrl(size_type i, int8_t c) {
+	_ctrl[i] = c;
+	if (i < (size_type) group_width)
+	    _ctrl[_capacity + i] = c;
+    }
+    inline size_type find_index(const key_type &key, uint64_t h) const;
+    inline size_type find_free(uint64_t h) const;
+    size_type find_insert_index(const key_type &key, const mapped_type &value);
+    void erase_index(size_type i);
+    void rehash(size_type capacity);
+
+    FlowHashTable(const FlowHashTable<K, V> &);
+    FlowHashTable<K, V> &operator=(const FlowHashTable<K, V> &);
+
+    friend class FlowHashTable_const_iterator<K, V>;
+    friend class FlowHashTable_iterator<K, V>;
+
+};
+
+template <typename K, typename V>
+class FlowHashTable_const_iterator { public:
+
+    typedef typename FlowHashTable<K, V>::size_type size_type;
+
+    /** @brief Construct an uninitialized iterator. */
+    FlowHashTable_const_iterator() {
+    }
+
+    /** @brief Return true iff this iterator points to a valid element. */
+    bool live() const {
+	return _pos < _t->_capacity;
+    }
+
+    typedef bool (FlowHashTable_const_iterator::*unspecified_bool_type)() const;
+    /** @brief Return true iff this iterator points to a valid element. */
+    operator unspecified_bool_type() const {
+	return live() ? &FlowHashTable_const_iterator::live : 0;
+    }
+
+    /** @brief Return the current element's key. */
+    const K &key() const {
+	return _t->_slots[_pos].key;
+    }
+
+    /** @brief Return the current element's value. */
+    const V &value() const {
+	return _t->_slots[_pos].value;
+    }
+
+    /** @brief Advance this iterator to the next element. */
+    void operator++() {
+	for (++_pos; _pos < _t->_capacity && _t->_ctrl[_pos] < 0; ++_pos)
+	    /* skip free slots */;
+    }
+    /** @brief Advance this iterator to the next element. */
+    void operator++(int) {
+	++*this;
+    }
+
+  protected:
+
+    const FlowHashTable<K, V> *_t;
+    size_type _pos;
+
+    FlowHashTable_const_iterator(const FlowHashTable<K, V> *t, size_type pos)
+	: _t(t), _pos(pos) {
+    }
+
+    friend class FlowHashTable<K, V>;
+
+};
+
+template <typename K, typename V>
+class FlowHashTable_iterator : public FlowHashTable_const_iterator<K, V> { public:
+
+    typedef FlowHashTable_const_iterator<K, V> inherited;
+
+    /** @brief Construct an uninitialized iterator. */
+    FlowHashTable_iterator() {
+    }
+
+    /** @brief Return the current element's value. */
+    V &value() const {
+	return const_cast<FlowHashTable<K, V> *>(this->_t)->_slots[this->_pos].value;
+    }
+
+  private:
+
+    FlowHashTable_iterator(FlowHashTable<K, V> *t, typename inherited::size_type pos)
+	: inherited(t, pos) {
+    }
+
+    friend class FlowHashTable<K, V>;
+
+};
+
+template <typename K, typename V>
+void
+FlowHashTable<K, V>::initialize(size_type capacity)
+{
+    _capacity = capacity;
+    _size = 0;
+    _growth_left = growth_limit(capacity);
+    _slots = reinterpret_cast<slot_type *>(CLICK_LALLOC(alloc_size(capacity)));
+    _ctrl = reinterpret_cast<int8_t *>(_slots + capacity);
+    memset(_ctrl, FlowHashTable_group::ctrl_empty, capacity + group_width);
+}
+
+template <typename K, typename V>
+FlowHashTable<K, V>::~FlowHashTable()
+{
+    clear();
+    CLICK_LFREE(_slots, alloc_size(_capacity));
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::size_type
+FlowHashTable<K, V>::find_index(const key_type &key, uint64_t h) const
+{
+    size_type mask = _capacity - 1, pos = (h >> 7) & mask, step = 0;
+    int8_t tag = h & 0x7F;
+    while (1) {
+	FlowHashTable_group g(_ctrl + pos);
+	for (typename FlowHashTable_group::mask_type m = g.match(tag); m; m &= m - 1) {
+	    size_type i = (pos + FlowHashTable_group::lowest(m)) & mask;
+	    if (_slots[i].key == key)
+		return i;
+	}
+	if (g.match_empty())
+	    return _capacity;
+	// Triangular probing visits every group exactly once.
+	step += group_width;
+	pos = (pos + step) & mask;
+    }
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::size_type
+FlowHashTable<K, V>::find_free(uint64_t h) const
+{
+    size_type mask = _capacity - 1, pos = (h >> 7) & mask, step = 0;
+    while (1) {
+	FlowHashTable_group g(_ctrl + pos);
+	if (typename FlowHashTable_group::mask_type m = g.match_free())
+	    return (pos + FlowHashTable_group::lowest(m)) & mask;
+	step += group_width;
+	pos = (pos + step) & mask;
+    }
+}
+
+template <typename K, typename V>
+typename FlowHashTable<K, V>::size_type
+FlowHashTable<K, V>::find_insert_index(const key_type &key, const mapped_type &value)
+{
+    uint64_t h = hash(key);
+    size_type i = find_index(key, h);
+    if (i != _capacity)
+	return i;
+    i = find_free(h);
+    if (_growth_left == 0 && _ctrl[i] == FlowHashTable_group::ctrl_empty) {
+	// Grow if the table is mostly full; otherwise just clear the
+	// deleted markers.
+	rehash(_size >= growth_limit(_capacity) / 2 ? _capacity * 2 : _capacity);
+	i = find_free(h);
+    }
+    if (_ctrl[i] == FlowHashTable_group::ctrl_empty)
+	--_growth_left;
+    set_ctrl(i, h & 0x7F);
+    new((void *) &_slots[i]) slot_type(key, value);
+    ++_size;
+    return i;
+}
+
+template <typename K, typename V>
+void
+FlowHashTable<K, V>::erase_index(size_type i)
+{
+    _slots[i].~slot_type();
+    --_size;
+    // If no group that covers slot i was ever full, no probe sequence has
+    // passed over slot i, and it can be marked empty.
+    size_type mask = _capacity - 1;
+    typename FlowHashTable_group::mask_type
+	after = FlowHashTable_group(_ctrl + i).match_empty(),
+	before = FlowHashTable_group(_ctrl + ((i - group_width) & mask)).match_empty();
+    if (after && before
+	&& FlowHashTable_group::lowest(after) + group_width - 1 - FlowHashTable_group::highest(before) < group_width) {
+	set_ctrl(i, FlowHashTable_group::ctrl_empty);
+	++_growth_left;
+    } else
+	set_ctrl(i, FlowHashTable_group::ctrl_deleted);
+}
+
+template <typename K, typename V>
+void
+FlowHashTable<K, V>::rehash(size_type capacity)
+{
+    slot_type *old_slots = _slots;
+    int8_t *old_ctrl = _ctrl;
+    size_type old_capacity = _capacity, size = _size;
+    initialize(capacity);
+    for (size_type i = 0; i < old_capacity; ++i)
+	if (old_ctrl[i] >= 0) {
+	    uint64_t h = hash(old_slots[i].key);
+	    size_type j = find_free(h);
+	    set_ctrl(j, h & 0x7F);
+	    new((void *) &_slots[j]) slot_type(old_slots[i]);
+	    old_slots[i].~slot_type();
+	}
+    _size = size;
+    _growth_left -= size;
+    CLICK_LFREE(old_slots, alloc_size(old_capacity));
+}
+
+template <typename K, typename V>
+void
+FlowHashTable<K, V>::clear()
+{
+    for (size_type i = 0; i < _capacity; ++i)
+	if (_ctrl[i] >= 0)
+	    _slots[i].~slot_type();
+    memset(_ctrl, FlowHashTable_group::ctrl_empty, _capacity + group_width);
+    _size = 0;
+    _growth_left = growth_limit(_capacity);
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::iterator
+FlowHashTable<K, V>::begin()
+{
+    iterator it(this, 0);
+    if (_ctrl[0] < 0)
+	++it;
+    return it;
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::const_iterator
+FlowHashTable<K, V>::begin() const
+{
+    const_iterator it(this, 0);
+    if (_ctrl[0] < 0)
+	++it;
+    return it;
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::iterator
+FlowHashTable<K, V>::end()
+{
+    return iterator(this, _capacity);
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::const_iterator
+FlowHashTable<K, V>::end() const
+{
+    return const_iterator(this, _capacity);
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::iterator
+FlowHashTable<K, V>::find(const key_type &key)
+{
+    return iterator(this, find_index(key, hash(key)));
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::const_iterator
+FlowHashTable<K, V>::find(const key_type &key) const
+{
+    return const_iterator(this, find_index(key, hash(key)));
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::iterator
+FlowHashTable<K, V>::find_insert(const key_type &key, const mapped_type &value)
+{
+    return iterator(this, find_insert_index(key, value));
+}
+
+template <typename K, typename V>
+inline typename FlowHashTable<K, V>::iterator
+FlowHashTable<K, V>::erase(const iterator &it)
+{
+    iterator next(it);
+    ++next;
+    erase_index(it._pos);
+    return next;
+}
+
+CLICK_ENDDECLS
+#endif
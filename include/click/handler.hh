@@ -5,6 +5,7 @@ CLICK_DECLS
 class Element;
 class ErrorHandler;
 class Handler;
+class PerThreadCounter;
 
 /** @file <click/handler.hh>
  * @brief The Handler class for router handlers.
@@ -55,7 +56,9 @@ class Handler { public:
 
 	h_read_comprehensive = 0x0008,
 	h_write_comprehensive = 0x0010,
-	h_special_flags = h_read | h_write | h_read_param | h_read_comprehensive | h_write_comprehensive
+	h_read_counter = 0x8000,///< @brief Read handler returns the value of
+				///  a PerThreadCounter; see read_counter().
+	h_special_flags = h_read | h_write | h_read_param | h_read_comprehensive | h_write_comprehensive | h_read_counter
 				///< @brief These flags may not be set by
 				///  Router::set_handler_flags().
     };
@@ -88,6 +91,19 @@ class Handler { public:
 	return _write_user_data;
     }
 
+    /** @brief Return the PerThreadCounter this read handler reports.
+     * @param e the handler's element
+     *
+     * Returns null unless the handler was registered by
+     * Element::add_data_handlers() for a PerThreadCounter.  Callers may read
+     * the counter's value() directly, from any thread, instead of calling
+     * the handler. */
+    inline PerThreadCounter *read_counter(const Element *e) const {
+	if (!(_flags & h_read_counter))
+	    return 0;
+	return reinterpret_cast<PerThreadCounter *>(reinterpret_cast<uintptr_t>(e) + reinterpret_cast<uintptr_t>(_read_user_data));
+    }
+
     /** @cond never */
     inline void *user_data1() const CLICK_DEPRECATED;
     inline void *user_data2() const CLICK_DEPRECATED;
@@ -6,14 +6,6 @@
 #if CLICK_USERLEVEL
 # include <unistd.h>
 # include <signal.h>
-# if HAVE_POLL_H && !HAVE_USE_SELECT
-#  include <poll.h>
-# endif
-# if HAVE_SYS_EVENT_H && HAVE_KQUEUE && !HAVE_USE_SELECT && !HAVE_USE_POLL && !defined(HAVE_USE_KQUEUE)
-#  define HAVE_USE_KQUEUE 1
-# elif (!HAVE_SYS_EVENT_H || !HAVE_KQUEUE) && HAVE_USE_KQUEUE
-#  error "--enable-select=kqueue is not supported on this system"
-# endif
 #endif
 #if CLICK_NS
 # include <click/simclick.h>
@@ -32,24 +24,21 @@ class Master { public:
 
     void pause();
     inline void unpause();
+    inline bool paused() const;
 
     inline int nthreads() const;
     inline RouterThread* thread(int id) const;
 
     const volatile int* stopper_ptr() const	{ return &_stopper; }
 
-    Timestamp next_timer_expiry() const		{ return _timer_expiry; }
-    const Timestamp &timer_check() const	{ return _timer_check; }
-    void run_timers(RouterThread *thread);
-    unsigned max_timer_stride() const		{ return _max_timer_stride; }
-    unsigned timer_stride() const		{ return _timer_stride; }
+    inline unsigned max_timer_stride() const;
     void set_max_timer_stride(unsigned timer_stride);
 
-#if CLICK_USERLEVEL
-    int add_select(int fd, Element *element, int mask);
-    int remove_select(int fd, Element *element, int mask);
-    void run_selects(RouterThread *thread);
+    inline uint32_t epoch() const;
+    uint32_t advance_epoch();
+    uint32_t oldest_epoch() const;
 
+#if CLICK_USERLEVEL
     int add_signal_handler(int signo, Router *router, String handler);
     int remove_signal_handler(int signo, Router *router, String handler);
 #endif
@@ -71,10 +60,6 @@ class Master { public:
 
   private:
 
-    // stick _timer_expiry here so it will most likely fit in a cache line,
-    // & we don't have to worry about its parts being updated separately
-    Timestamp _timer_expiry;
-
 #if CLICK_LINUXMODULE
     spinlock_t _master_lock;
     struct task_struct *_master_lock_task;
@@ -102,99 +87,12 @@ class Master { public:
     inline void set_stopper(int);
     bool check_driver();
 
-    // PENDING TASKS
-    uintptr_t _pending_head;
-    volatile uintptr_t *_pending_tail;
-    SpinlockIRQ _master_task_lock;
-    void process_pending(RouterThread*);
-
-    // TIMERS
-    unsigned _max_timer_stride;
-    unsigned _timer_stride;
-    unsigned _timer_count;
-    Vector<Timer *> _timer_heap;
-    Vector<Timer *> _timer_runchunk;
-#if CLICK_LINUXMODULE
-    spinlock_t _timer_lock;
-    struct task_struct *_timer_task;
-#elif HAVE_MULTITHREAD
-    Spinlock _timer_lock;
-#endif
-    Timestamp _timer_check;
-    uint32_t _timer_check_reports;
-    inline Timestamp next_timer_expiry_adjusted() const;
-#if CLICK_USERLEVEL
-    inline int next_timer_delay(bool more_tasks, Timestamp &t) const;
-#endif
-    void lock_timers();
-    bool attempt_lock_timers();
-    void unlock_timers();
-    inline void run_one_timer(Timer *);
-
-    void set_timer_expiry() {
-	if (_timer_heap.size())
-	    _timer_expiry = _timer_heap.at_u(0)->_expiry;
-	else
-	    _timer_expiry = Timestamp();
-    }
-    void check_timer_expiry(Timer *t);
-    static inline void place_timer(Timer **t, Timer **tbegin) {
-	(*t)->_schedpos1 = (t - tbegin) + 1;
-    }
-
-    struct timer_less {
-	bool operator()(Timer *a, Timer *b) {
-	    return a->expiry() < b->expiry();
-	}
-    };
-    struct timer_place {
-	Timer **_begin;
-	timer_place(Timer **begin)
-	    : _begin(begin) {
-	}
-	void operator()(Timer **t) {
-	    Master::place_timer(t, _begin);
-	}
-    };
+    // EPOCHS
+    atomic_uint32_t _epoch;
+    inline void epoch_quiescent(RouterThread *thread);
+    inline void epoch_offline(RouterThread *thread);
 
 #if CLICK_USERLEVEL
-    // SELECT
-    struct ElementSelector {
-	Element *read;
-	Element *write;
-	ElementSelector()
-	    : read(0), write(0)
-	{
-	}
-    };
-# if HAVE_USE_KQUEUE
-    int _kqueue;
-# endif
-# if !HAVE_POLL_H || HAVE_USE_SELECT
-    struct pollfd {
-	int fd;
-	int events;
-    };
-    fd_set _read_select_fd_set;
-    fd_set _write_select_fd_set;
-    int _max_select_fd;
-# endif /* !HAVE_POLL_H || HAVE_USE_SELECT */
-    Vector<struct pollfd> _pollfds;
-    Vector<ElementSelector> _element_selectors;
-    Vector<int> _fd_to_pollfd;
-    Spinlock _select_lock;
-    void register_select(int fd, bool add_read, bool add_write);
-    void remove_pollfd(int pi, int event);
-    inline void call_selected(int fd, int mask) const;
-# if HAVE_USE_KQUEUE
-    void run_selects_kqueue(RouterThread *thread, bool more_tasks);
-# endif
-# if HAVE_POLL_H && !HAVE_USE_SELECT
-    void run_selects_poll(RouterThread *thread, bool more_tasks);
-# else
-    void run_selects_select(RouterThread *thread, bool more_tasks);
-# endif
-
     // SIGNALS
     struct SignalInfo {
 	int signo;
@@ -226,6 +124,9 @@ class Master { public:
     friend class Timer;
     friend class RouterThread;
     friend class Router;
+#if CLICK_USERLEVEL
+    friend class SelectSet;
+#endif
 
 };
 
@@ -266,6 +167,48 @@ Master::set_stopper(int s)
     _stopper = s;
 }
 
+/** @brief Return the current epoch.
+ *
+ * Epochs let tables free objects that lock-free readers might still be
+ * using.  A writer that unlinks an object calls advance_epoch() and tags
+ * the object with the result.  Each thread records the current epoch
+ * whenever it is between elements, which is a quiescent point: it can hold
+ * no references into element state.  Once oldest_epoch() has reached an
+ * object's tag, every thread has passed a quiescent point since the object
+ * was unlinked, so the object can be freed.  EpochReclaimer implements this
+ * protocol.
+ *
+ * Epochs are never zero. */
+inline uint32_t
+Master::epoch() const
+{
+    return _epoch.value();
+}
+
+inline void
+Master::epoch_quiescent(RouterThread *thread)
+{
+    // Readers pay only this load and comparison: the epoch changes only
+    // when a writer retires an object.  When it changes, order this
+    // thread's earlier reads before the store, and the store before its
+    // later reads.
+    uint32_t e = _epoch.value();
+    if (thread->_epoch != e) {
+	click_fence();
+	thread->_epoch = e;
+	click_fence();
+    }
+}
+
+inline void
+Master::epoch_offline(RouterThread *thread)
+{
+    // Called when thread stops running element code, such as before it
+    // blocks.  An offline thread never delays reclamation.
+    click_fence();
+    thread->_epoch = 0;
+}
+
 inline void
 Master::lock_master()
 {
@@ -301,57 +244,24 @@ Master::unpause()
     _master_paused--;
 }
 
-inline Timestamp
-Master::next_timer_expiry_adjusted() const
-{
-    Timestamp e = _timer_expiry;
-#if CLICK_USERLEVEL
-    if (likely(!Timestamp::warp_jumping())) {
-#endif
-    if (_timer_stride >= 8 || e.sec() == 0)
-	/* do nothing */;
-    else if (_timer_stride >= 4)
-	e -= Timer::adjustment();
-    else
-	e -= Timer::adjustment() + Timer::adjustment();
-#if CLICK_USERLEVEL
-    }
-#endif
-    return e;
-}
-
-inline void
-Master::lock_timers()
-{
-#if CLICK_LINUXMODULE
-    if (current != _timer_task)
-	spin_lock(&_timer_lock);
-#elif HAVE_MULTITHREAD
-    _timer_lock.acquire();
-#endif
-}
-
+/** @brief Return true iff the master is paused.
+ *
+ * While paused, threads run no timers, selects, or pending task
+ * operations. */
 inline bool
-Master::attempt_lock_timers()
+Master::paused() const
 {
-#if CLICK_LINUXMODULE
-    return spin_trylock(&_timer_lock);
-#elif HAVE_MULTITHREAD
-    return _timer_lock.attempt();
-#else
-    return true;
-#endif
+    return _master_paused > 0;
 }
 
-inline void
-Master::unlock_timers()
+/** @brief Return the maximum timer stride.
+ *
+ * All threads share the same maximum stride; see
+ * set_max_timer_stride(). */
+inline unsigned
+Master::max_timer_stride() const
 {
-#if CLICK_LINUXMODULE
-    if (current != _timer_task)
-	spin_unlock(&_timer_lock);
-#elif HAVE_MULTITHREAD
-    _timer_lock.release();
-#endif
+    return thread(0)->timer_set().max_timer_stride();
 }
 
 inline Master *
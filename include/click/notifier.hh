@@ -302,8 +302,8 @@ NotifierSignal::uninitialized_signal()
 inline bool
 NotifierSignal::active() const
 {
-#if HAVE_MULTITHREAD && HAVE___SYNC_SYNCHRONIZE
-    __sync_synchronize();
+#if HAVE_MULTITHREAD
+    click_fence();
 #endif
     if (likely(_mask))
 	return (*_v.v1 & _mask) != 0;
@@ -535,8 +535,8 @@ ActiveNotifier::set_active(bool active, bool schedule)
 	// would go to sleep forever.
 	Notifier::set_active(active);
 
-#if HAVE_MULTITHREAD && HAVE___SYNC_SYNCHRONIZE
-	__sync_synchronize();
+#if HAVE_MULTITHREAD
+	click_fence();
 #endif
 
 	if (active && schedule) {
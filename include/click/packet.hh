@@ -27,6 +27,10 @@ CLICK_DECLS
 
 class IP6Address;
 class WritablePacket;
+class StringAccum;
+#if HAVE_CLICK_PACKET_POOL
+struct PacketPool;
+#endif
 
 class Packet { public:
 
@@ -57,11 +61,15 @@ class Packet { public:
     static WritablePacket *make(unsigned char *data, uint32_t length,
 				void (*destructor)(unsigned char *, size_t)) CLICK_WARN_UNUSED_RESULT;
 #endif
+#if HAVE_CLICK_PACKET_POOL
+    static void pool_report(StringAccum &sa);
+#endif
 
     inline void kill();
 
     inline bool shared() const;
     Packet *clone() CLICK_WARN_UNUSED_RESULT;
+    int clone(Packet **clones, int n);
     inline WritablePacket *uniqueify() CLICK_WARN_UNUSED_RESULT;
 
     inline const unsigned char *data() const;
@@ -652,6 +660,9 @@ class Packet { public:
     unsigned char *_end;  /* one beyond end of allocated buffer */
 # if CLICK_USERLEVEL
     void (*_destructor)(unsigned char *, size_t);
+# endif
+# if HAVE_CLICK_PACKET_POOL
+    PacketPool *_pool;	/* pool that allocated this packet */
 # endif
     unsigned char _cb[48];
     unsigned char *_mac;
@@ -679,6 +690,9 @@ class Packet { public:
     static WritablePacket *make(int, int, int);
     bool alloc_data(uint32_t, uint32_t, uint32_t);
 #endif
+#if HAVE_CLICK_PACKET_POOL
+    static void recycle(Packet *p);
+#endif
 #if CLICK_BSDMODULE
     static void assimilate_mbuf(Packet *p);
     void assimilate_mbuf();
@@ -690,6 +704,9 @@ class Packet { public:
     WritablePacket *expensive_put(uint32_t nbytes);
 
     friend class WritablePacket;
+#if HAVE_CLICK_PACKET_POOL
+    friend struct PacketPool;
+#endif
 
 };
 
@@ -739,6 +756,9 @@ Packet::Packet()
     _destructor = 0;
 # elif CLICK_BSDMODULE
     _m = 0;
+# endif
+# if HAVE_CLICK_PACKET_POOL
+    _pool = 0;
 # endif
     clear_annotations();
 #endif
@@ -1274,7 +1294,11 @@ Packet::kill()
     skbmgr_recycle_skbs(b);
 #else
     if (_use_count.dec_and_test())
+# if HAVE_CLICK_PACKET_POOL
+	recycle(this);
+# else
 	delete this;
+# endif
 #endif
 }
 
@@ -11,6 +11,12 @@
 #define DST_IP6_ANNO_OFFSET		0
 #define DST_IP6_ANNO_SIZE		16
 
+// bytes 4-5
+#define DST_PORT_ANNO_OFFSET		4
+#define DST_PORT_ANNO_SIZE		2
+#define DST_PORT_ANNO(p)		((p)->anno_u16(DST_PORT_ANNO_OFFSET))
+#define SET_DST_PORT_ANNO(p, v)		((p)->set_anno_u16(DST_PORT_ANNO_OFFSET, (v)))
+
 // bytes 16-31
 #define WIFI_EXTRA_ANNO_OFFSET		16
 #define WIFI_EXTRA_ANNO_SIZE		24
@@ -0,0 +1,157 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_PACKETBATCH_HH
+#define CLICK_PACKETBATCH_HH
+#include <click/packet.hh>
+CLICK_DECLS
+
+/** @file <click/packetbatch.hh>
+ * @brief A list of packets moved through the router with a single call.
+ */
+
+/** @class PacketBatch include/click/packetbatch.hh <click/packetbatch.hh>
+ * @brief A FIFO list of packets.
+ *
+ * A PacketBatch holds a sequence of packets linked through their next()
+ * annotations.  Elements use batches to move many packets across a
+ * connection with one Element::push_batch() or Element::pull_batch() call
+ * instead of one push() or pull() call per packet.
+ *
+ * A PacketBatch is a small value object (a head pointer, a tail pointer, and
+ * a count).  It does not own its packets in the C++ sense: destroying a
+ * nonempty batch leaks its packets.  Use kill() to free them.
+ *
+ * While a packet is in a batch, its next() annotation is reserved for the
+ * batch.  Packets removed with pop_front() have a null next() annotation.
+ *
+ * @sa Element::push_batch, Element::pull_batch */
+class PacketBatch { public:
+
+    /** @brief Construct an empty batch. */
+    PacketBatch()
+	: _head(0), _tail(0), _count(0) {
+    }
+
+    /** @brief Construct a batch containing the single packet @a p. */
+    explicit PacketBatch(Packet *p)
+	: _head(p), _tail(p), _count(1) {
+	p->set_next(0);
+    }
+
+    /** @brief Return the number of packets in the batch. */
+    unsigned count() const {
+	return _count;
+    }
+
+    /** @brief Return true iff the batch is empty. */
+    bool empty() const {
+	return _count == 0;
+    }
+
+    typedef unsigned (PacketBatch::*unspecified_bool_type)() const;
+    /** @brief Return true iff the batch is nonempty. */
+    operator unspecified_bool_type() const {
+	return _count ? &PacketBatch::count : 0;
+    }
+
+    /** @brief Return the first packet in the batch, or null if empty. */
+    Packet *front() const {
+	return _head;
+    }
+
+    /** @brief Return the last packet in the batch, or null if empty. */
+    Packet *back() const {
+	return _tail;
+    }
+
+    /** @brief Append packet @a p to the batch. */
+    inline void append(Packet *p);
+
+    /** @brief Append all packets in @a x to the batch, leaving @a x empty. */
+    inline void append(PacketBatch &x);
+
+    /** @brief Remove and return the first packet in the batch.
+     *
+     * Returns null if the batch is empty.  The returned packet's next()
+     * annotation is null. */
+    inline Packet *pop_front();
+
+    /** @brief Forget the batch's packets without freeing them.
+     *
+     * Use this after handing the packets off some other way. */
+    void clear() {
+	_head = _tail = 0;
+	_count = 0;
+    }
+
+    /** @brief Kill every packet in the batch, leaving it empty. */
+    inline void kill();
+
+    /** @brief Return the total length of the packets in the batch. */
+    inline uint32_t total_length() const;
+
+  private:
+
+    Packet *_head;
+    Packet *_tail;
+    unsigned _count;
+
+};
+
+inline void
+PacketBatch::append(Packet *p)
+{
+    p->set_next(0);
+    if (_tail)
+	_tail->set_next(p);
+    else
+	_head = p;
+    _tail = p;
+    ++_count;
+}
+
+inline void
+PacketBatch::append(PacketBatch &x)
+{
+    if (x._head) {
+	if (_tail)
+	    _tail->set_next(x._head);
+	else
+	    _head = x._head;
+	_tail = x._tail;
+	_count += x._count;
+	x.clear();
+    }
+}
+
+inline Packet *
+PacketBatch::pop_front()
+{
+    Packet *p = _head;
+    if (p) {
+	_head = p->next();
+	if (!_head)
+	    _tail = 0;
+	--_count;
+	p->set_next(0);
+    }
+    return p;
+}
+
+inline void
+PacketBatch::kill()
+{
+    while (Packet *p = pop_front())
+	p->kill();
+}
+
+inline uint32_t
+PacketBatch::total_length() const
+{
+    uint32_t len = 0;
+    for (Packet *p = _head; p; p = p->next())
+	len += p->length();
+    return len;
+}
+
+CLICK_ENDDECLS
+#endif
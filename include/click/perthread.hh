@@ -0,0 +1,308 @@
+// -*- c-basic-offset: 4 -*-
+#ifndef CLICK_PERTHREAD_HH
+#define CLICK_PERTHREAD_HH
+#include <click/glue.hh>
+#include <click/sync.hh>
+#include <click/task.hh>
+#include <click/routerthread.hh>
+#include <click/master.hh>
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+# define CLICK_PERTHREAD_SLOTS 1
+#endif
+CLICK_DECLS
+
+#ifndef CLICK_CACHE_LINE_SIZE
+# define CLICK_CACHE_LINE_SIZE 64
+#endif
+
+/** @file <click/perthread.hh>
+ * @brief Statistics kept separately for each RouterThread.
+ */
+
+/** @class PerThread include/click/perthread.hh <click/perthread.hh>
+ * @brief Per-thread statistics slots.
+ *
+ * A PerThread<T> keeps one T for each RouterThread, each in its own cache
+ * lines, so that threads updating the same statistics do not pass a cache
+ * line back and forth.  Writers update the calling thread's slot through a
+ * PerThread<T>::writer.  Readers copy each slot with read() and combine the
+ * copies; read() returns a consistent copy of a slot without blocking its
+ * writer.
+ *
+ * Before initialize(), and in drivers without user-level threads, a PerThread
+ * has a single slot shared by all writers, which take its spinlock.  (The
+ * spinlock costs nothing in single-threaded drivers.)  In multithreaded
+ * user-level drivers, threads that are not running a RouterThread, such as
+ * threads started by elements, share an extra slot protected by a
+ * spinlock.
+ *
+ * T must be copyable with its assignment operator and default
+ * constructible.  Readers may copy a slot while its writer is changing it,
+ * but then retry, so T's assignment operator must not depend on the copied
+ * value being consistent.
+ */
+template <typename T>
+class PerThread { public:
+
+    /** @brief Construct a PerThread with a single slot holding T(). */
+    PerThread();
+    ~PerThread();
+
+    /** @brief Give each of @a master's threads its own slot.
+     * @return 0 on success, -ENOMEM if out of memory
+     *
+     * Discards existing slot contents.  Call from an element's initialize()
+     * method, before any thread writes. */
+    int initialize(Master *master);
+
+    /** @brief Return the number of slots. */
+    int nslots() const {
+	return _nslots;
+    }
+
+    /** @brief Copy slot @a i into @a x.
+     *
+     * The copy is consistent: it reflects no partial update. */
+    void read(int i, T &x) const;
+
+    class writer;
+
+  private:
+
+    struct slot_type {
+	volatile uint32_t seq;	// odd while a writer updates value
+	Spinlock lock;		// used only by shared slots
+	T value;
+	slot_type()
+	    : seq(0), value() {
+	}
+    };
+
+    enum { slot_size = ((sizeof(slot_type) + CLICK_CACHE_LINE_SIZE - 1)
+			/ CLICK_CACHE_LINE_SIZE) * CLICK_CACHE_LINE_SIZE };
+
+    char *_mem;
+    char *_slots;
+    int _nslots;
+
+    slot_type *slot(int i) const {
+	return reinterpret_cast<slot_type *>(_slots + i * slot_size);
+    }
+    int allocate(int n);
+    void deallocate();
+
+    PerThread(const PerThread<T> &);
+    PerThread<T> &operator=(const PerThread<T> &);
+
+};
+
+/** @class PerThread::writer
+ * @brief Write access to the calling thread's slot.
+ *
+ * A writer object gives access to the calling thread's slot for the
+ * writer's lifetime.  Keep writers short-lived; in particular, do not call
+ * other elements while holding one.
+ * @code
+ * PerThread<stats>::writer w(_stats);
+ * w->count++;
+ * w->byte_count += p->length();
+ * @endcode */
+template <typename T>
+class PerThread<T>::writer { public:
+
+    inline writer(PerThread<T> &pt);
+    inline ~writer();
+
+    T &operator*() const {
+	return _s->value;
+    }
+    T *operator->() const {
+	return &_s->value;
+    }
+
+  private:
+
+    slot_type *_s;
+#if CLICK_PERTHREAD_SLOTS
+    bool _shared;
+#endif
+
+    writer(const writer &);
+    writer &operator=(const writer &);
+
+};
+
+template <typename T>
+inline
+PerThread<T>::writer::writer(PerThread<T> &pt)
+{
+#if CLICK_PERTHREAD_SLOTS
+    RouterThread *t = RouterThread::current();
+    int i = (t ? t->thread_id() : -1);
+    // The last slot is shared by threads without a slot of their own.
+    if ((unsigned) i < (unsigned) (pt._nslots - 1))
+	_shared = false;
+    else {
+	i = pt._nslots - 1;
+	_shared = true;
+    }
+    _s = pt.slot(i);
+    if (_shared)
+	_s->lock.acquire();
+#else
+    // Unlocked concurrent writers could lose a seq increment and leave it
+    // odd, and then read() would spin forever.
+    _s = pt.slot(0);
+    _s->lock.acquire();
+#endif
+    _s->seq = _s->seq + 1;
+    click_order_fence();
+}
+
+template <typename T>
+inline
+PerThread<T>::writer::~writer()
+{
+    click_order_fence();
+    _s->seq = _s->seq + 1;
+#if CLICK_PERTHREAD_SLOTS
+    if (_shared)
+	_s->lock.release();
+#else
+    _s->lock.release();
+#endif
+}
+
+template <typename T>
+PerThread<T>::PerThread()
+    : _mem(0), _slots(0), _nslots(0)
+{
+    allocate(1);
+}
+
+template <typename T>
+PerThread<T>::~PerThread()
+{
+    deallocate();
+}
+
+template <typename T>
+int
+PerThread<T>::allocate(int n)
+{
+    char *mem = new char[n * slot_size + CLICK_CACHE_LINE_SIZE];
+    if (!mem)
+	return -ENOMEM;
+    deallocate();
+    _mem = mem;
+    uintptr_t x = reinterpret_cast<uintptr_t>(mem);
+    _slots = mem + ((CLICK_CACHE_LINE_SIZE - x % CLICK_CACHE_LINE_SIZE)
+		    % CLICK_CACHE_LINE_SIZE);
+    _nslots = n;
+    for (int i = 0; i < n; ++i)
+	new((void *) slot(i)) slot_type;
+    return 0;
+}
+
+template <typename T>
+void
+PerThread<T>::deallocate()
+{
+    for (int i = 0; i < _nslots; ++i)
+	slot(i)->~slot_type();
+    delete[] _mem;
+    _mem = _slots = 0;
+    _nslots = 0;
+}
+
+template <typename T>
+int
+PerThread<T>::initialize(Master *master)
+{
+#if CLICK_PERTHREAD_SLOTS
+    return allocate(master->nthreads() + 1);
+#else
+    (void) master;
+    return allocate(1);
+#endif
+}
+
+template <typename T>
+void
+PerThread<T>::read(int i, T &x) const
+{
+    const slot_type *s = slot(i);
+    while (1) {
+	uint32_t seq = s->seq;
+	click_order_fence();
+	x = s->value;
+	click_order_fence();
+	if (!(seq & 1) && seq == s->seq)
+	    return;
+    }
+}
+
+
+/** @class PerThreadCounter include/click/perthread.hh <click/perthread.hh>
+ * @brief A counter kept separately for each RouterThread.
+ *
+ * PerThreadCounter is a PerThread counter whose value is the sum of its
+ * slots.  clear() records the current sum rather than touching the slots,
+ * so it is safe while other threads count. */
+class PerThreadCounter { public:
+
+#if HAVE_INT64_TYPES
+    typedef uint64_t value_type;
+#else
+    typedef uint32_t value_type;
+#endif
+
+    PerThreadCounter()
+	: _base(0) {
+    }
+
+    /** @brief Give each of @a master's threads its own slot.
+     *
+     * Resets the counter to zero. */
+    int initialize(Master *master) {
+	_base = 0;
+	return _slots.initialize(master);
+    }
+
+    /** @brief Add @a delta to the counter. */
+    inline void add(value_type delta) {
+	PerThread<value_type>::writer w(_slots);
+	*w += delta;
+    }
+    PerThreadCounter &operator+=(value_type delta) {
+	add(delta);
+	return *this;
+    }
+    void operator++(int) {
+	add(1);
+    }
+
+    /** @brief Return the counter's value, summing the slots. */
+    value_type value() const {
+	value_type sum = 0, x;
+	for (int i = 0; i < _slots.nslots(); ++i) {
+	    _slots.read(i, x);
+	    sum += x;
+	}
+	return sum - _base;
+    }
+
+    /** @brief Reset the counter to zero. */
+    void clear() {
+	_base += value();
+    }
+
+  private:
+
+    PerThread<value_type> _slots;
+    value_type _base;
+
+};
+
+CLICK_ENDDECLS
+#endif
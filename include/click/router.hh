@@ -89,6 +89,7 @@ class Router { public:
     inline void set_thread_sched(ThreadSched* scheduler);
     inline int initial_home_thread_id(Element *owner, Task *task,
 				      bool scheduled) const;
+    RouterThread *home_thread(Element *owner) const;
 
     /** @cond never */
     // Needs to be public for NameInfo, but not useful outside
@@ -3,6 +3,10 @@
 #define CLICK_ROUTERTHREAD_HH
 #include <click/sync.hh>
 #include <click/vector.hh>
+#include <click/timerset.hh>
+#if CLICK_USERLEVEL
+# include <click/selectset.hh>
+#endif
 #if CLICK_LINUXMODULE
 # include <click/cxxprotect.h>
 CLICK_CXX_PROTECT
@@ -34,6 +38,9 @@ class RouterThread
 	   THREAD_UNKNOWN = -1000 };
 
     inline int thread_id() const;
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+    static inline RouterThread *current();
+#endif
 
     // Task list functions
     inline bool active() const;
@@ -50,6 +57,11 @@ class RouterThread
     inline void unblock_tasks();
 
     inline Master* master() const;
+    inline TimerSet &timer_set();
+    inline const TimerSet &timer_set() const;
+#if CLICK_USERLEVEL
+    inline SelectSet &select_set();
+#endif
     void driver();
     void driver_once();
 
@@ -110,6 +122,7 @@ class RouterThread
     struct task_struct *_linux_task;
 #elif HAVE_MULTITHREAD
     click_processor_t _running_processor;
+    static __thread RouterThread *_current;
     volatile bool _select_blocked;
     int _wake_pipe[2];
     volatile bool _wake_pipe_pending;
@@ -118,7 +131,18 @@ class RouterThread
     atomic_uint32_t _task_blocker;
     atomic_uint32_t _task_blocker_waiting;
 
-    uint32_t _any_pending;
+    // The Master epoch this thread last saw while quiescent, or 0 if the
+    // thread is not running element code.  See EpochReclaimer.
+    volatile uint32_t _epoch;
+
+    // Tasks whose scheduling status changed on another thread.  Any thread
+    // may push onto the list; only this thread pops it.
+    atomic_pointer<Task> _pending_head;
+
+    TimerSet _timers;
+#if CLICK_USERLEVEL
+    SelectSet _selects;
+#endif
 
 #if CLICK_LINUXMODULE
     bool _greedy;
@@ -166,7 +190,9 @@ class RouterThread
     ~RouterThread();
 
     // task requests
-    inline void add_pending();
+    inline void add_pending(Task *task);
+    void remove_pending(Task *task);
+    void process_pending();
 
     // task running functions
     inline void driver_lock_tasks();
@@ -185,6 +211,9 @@ class RouterThread
 
     friend class Task;
     friend class Master;
+#if CLICK_USERLEVEL
+    friend class SelectSet;
+#endif
 
 };
 
@@ -200,6 +229,19 @@ RouterThread::thread_id() const
     return _id;
 }
 
+#if CLICK_USERLEVEL && HAVE_MULTITHREAD
+/** @brief Returns the RouterThread running on the calling OS thread.
+ *
+ * Returns null if the calling thread is not running a RouterThread's driver,
+ * as for threads that elements start themselves.
+ */
+inline RouterThread *
+RouterThread::current()
+{
+    return _current;
+}
+#endif
+
 /** @brief Returns this thread's associated Master. */
 inline Master*
 RouterThread::master() const
@@ -207,6 +249,35 @@ RouterThread::master() const
     return _master;
 }
 
+/** @brief Returns this thread's timer set.
+ *
+ * The timer set holds the Timers whose owning elements call this thread
+ * home.  @sa Router::home_thread */
+inline TimerSet &
+RouterThread::timer_set()
+{
+    return _timers;
+}
+
+/** @overload */
+inline const TimerSet &
+RouterThread::timer_set() const
+{
+    return _timers;
+}
+
+#if CLICK_USERLEVEL
+/** @brief Returns this thread's select set.
+ *
+ * The select set holds the file descriptors registered by elements whose
+ * home thread is this thread.  @sa Element::add_select */
+inline SelectSet &
+RouterThread::select_set()
+{
+    return _selects;
+}
+#endif
+
 /** @brief Returns whether any tasks are scheduled.
  *
  * Returns false iff no tasks are scheduled and no events are pending.  Since
@@ -218,9 +289,9 @@ inline bool
 RouterThread::active() const
 {
 #if HAVE_TASK_HEAP
-    return _task_heap.size() != 0 || _any_pending;
+    return _task_heap.size() != 0 || _pending_head.value();
 #else
-    return ((const Task *)_next != this) || _any_pending;
+    return ((const Task *)_next != this) || _pending_head.value();
 #endif
 }
 
@@ -387,10 +458,8 @@ RouterThread::wake()
     if (task)
 	wake_up_process(task);
 #elif CLICK_USERLEVEL && HAVE_MULTITHREAD
-    // see also Master::add_select()
-# if HAVE___SYNC_SYNCHRONIZE
-    __sync_synchronize();
-# endif
+    // see also SelectSet::run_selects()
+    click_fence();
     if (_select_blocked) {
 	_wake_pipe_pending = true;
 	ignore_result(write(_wake_pipe[1], "", 1));
@@ -402,9 +471,15 @@ RouterThread::wake()
 }
 
 inline void
-RouterThread::add_pending()
+RouterThread::add_pending(Task *task)
 {
-    _any_pending = 1;
+    // The caller has claimed @a task by setting its _pending flag, so no
+    // other thread pushes it concurrently.
+    Task *head;
+    do {
+	head = _pending_head.value();
+	task->_pending_next = head;
+    } while (!_pending_head.compare_and_swap(head, task));
     wake();
 }
 
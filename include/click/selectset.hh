@@ -0,0 +1,131 @@
+// -*- c-basic-offset: 4; related-file-name: "../../lib/selectset.cc" -*-
+#ifndef CLICK_SELECTSET_HH
+#define CLICK_SELECTSET_HH 1
+#if !CLICK_USERLEVEL
+# error "<click/selectset.hh> only meaningful at user level"
+#endif
+#include <click/vector.hh>
+#include <click/sync.hh>
+#include <unistd.h>
+#if HAVE_POLL_H && !HAVE_USE_SELECT
+# include <poll.h>
+#endif
+#if HAVE_SYS_EVENT_H && HAVE_KQUEUE && !HAVE_USE_SELECT && !HAVE_USE_POLL && !HAVE_USE_EPOLL && !defined(HAVE_USE_KQUEUE)
+# define HAVE_USE_KQUEUE 1
+#elif (!HAVE_SYS_EVENT_H || !HAVE_KQUEUE) && HAVE_USE_KQUEUE
+# error "--enable-select=kqueue is not supported on this system"
+#endif
+#if HAVE_SYS_EPOLL_H && HAVE_EPOLL_CREATE && !HAVE_USE_SELECT && !HAVE_USE_POLL && !HAVE_USE_KQUEUE && !defined(HAVE_USE_EPOLL)
+# define HAVE_USE_EPOLL 1
+#elif (!HAVE_SYS_EPOLL_H || !HAVE_EPOLL_CREATE) && HAVE_USE_EPOLL
+# error "--enable-select=epoll is not supported on this system"
+#endif
+CLICK_DECLS
+class Element;
+class Router;
+class RouterThread;
+class Timestamp;
+
+/** @class SelectSet
+ * @brief The set of file descriptors selected by one RouterThread.
+ *
+ * Each RouterThread has its own SelectSet, which holds the file descriptors
+ * registered with Element::add_select() by elements whose home thread is
+ * that RouterThread.  Each thread waits only on its own file descriptors, so
+ * threads never contend for a shared select set.  Other threads may still
+ * add or remove file descriptors; the SelectSet's lock serializes those
+ * changes, and the owning thread is woken so it can wait on the new set.
+ *
+ * The wait mechanism is chosen at configure time with --enable-select.  The
+ * kqueue (BSD) and epoll (Linux) mechanisms cost O(1) per ready file
+ * descriptor, rather than O(n) per registered file descriptor for poll()
+ * and select(), and are used by default where available.  If the kernel
+ * refuses to watch some file descriptor (for example, epoll and regular
+ * files), the SelectSet falls back to poll(). */
+class SelectSet { public:
+
+    SelectSet(RouterThread *thread);
+    ~SelectSet();
+
+    int add_select(int fd, Element *element, int mask);
+    int remove_select(int fd, Element *element, int mask);
+    void run_selects();
+
+    void kill_router(Router *router);
+
+    inline void lock();
+    inline void unlock();
+
+  private:
+
+    struct ElementSelector {
+	Element *read;
+	Element *write;
+	ElementSelector()
+	    : read(0), write(0)
+	{
+	}
+    };
+
+    RouterThread *_thread;
+#if HAVE_USE_KQUEUE
+    int _kqueue;
+#endif
+#if HAVE_USE_EPOLL
+    int _epoll;
+# if HAVE_MULTITHREAD
+    bool _epoll_wake_registered;
+# endif
+#endif
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+    struct pollfd {
+	int fd;
+	int events;
+    };
+    fd_set _read_select_fd_set;
+    fd_set _write_select_fd_set;
+    int _max_select_fd;
+#endif /* !HAVE_POLL_H || HAVE_USE_SELECT */
+    Vector<struct pollfd> _pollfds;
+    Vector<ElementSelector> _element_selectors;
+    Vector<int> _fd_to_pollfd;
+    Spinlock _select_lock;
+
+    void register_select(int fd, bool add_read, bool add_write);
+    void remove_pollfd(int pi, int event);
+    inline void call_selected(int fd, int mask) const;
+    inline int next_timer_delay(bool more_tasks, Timestamp &t) const;
+#if HAVE_USE_KQUEUE
+    void run_selects_kqueue(bool more_tasks);
+#endif
+#if HAVE_USE_EPOLL
+    void epoll_update(int fd, int old_events, int new_events);
+    void run_selects_epoll(bool more_tasks);
+#endif
+#if HAVE_POLL_H && !HAVE_USE_SELECT
+    void run_selects_poll(bool more_tasks);
+#else
+    void run_selects_select(bool more_tasks);
+#endif
+
+    SelectSet(const SelectSet &);
+    SelectSet &operator=(const SelectSet &);
+
+    friend class Master;
+
+};
+
+inline void
+SelectSet::lock()
+{
+    _select_lock.acquire();
+}
+
+inline void
+SelectSet::unlock()
+{
+    _select_lock.release();
+}
+
+CLICK_ENDDECLS
+#endif
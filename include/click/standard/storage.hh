@@ -27,6 +27,8 @@ class Storage { public:
 
     static inline void packet_memory_barrier(Packet * volatile &packet,
 					     volatile int &index);
+    // orders all preceding slot writes; used when a batch fills many slots
+    static inline void packet_memory_barrier();
 
   protected:
 
@@ -55,5 +57,11 @@ Storage::packet_memory_barrier(Packet * volatile &packet, volatile int &index)
     __asm__ volatile("" : : "m" (packet), "m" (index));
 }
 
+inline void
+Storage::packet_memory_barrier()
+{
+    __asm__ volatile("" : : : "memory");
+}
+
 CLICK_ENDDECLS
 #endif
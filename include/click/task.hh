@@ -3,8 +3,8 @@
 #define CLICK_TASK_HH
 #include <click/element.hh>
 #include <click/sync.hh>
+#include <click/atomic.hh>
 #if HAVE_MULTITHREAD
-# include <click/atomic.hh>
 # include <click/ewma.hh>
 #endif
 CLICK_DECLS
@@ -262,7 +262,8 @@ class Task { public:
 
     Element *_owner;
 
-    volatile uintptr_t _pending_nextptr;
+    atomic_uint32_t _pending;	// nonzero iff on a thread's pending list
+    Task *_pending_next;
 
     Task(const Task&);
     Task& operator=(const Task&);
@@ -279,8 +280,7 @@ class Task { public:
 
     inline void fast_unschedule(bool should_be_scheduled);
 
-    static inline Task *pending_to_task(uintptr_t);
-    inline Task *pending_to_task() const;
+    RouterThread *pending_thread() const;
 
     friend class RouterThread;
     friend class Master;
@@ -313,8 +313,9 @@ Task::Task(TaskCallback f, void *user_data)
       _cycle_runs(0),
 #endif
       _thread(0), _home_thread_id(-1),
-      _owner(0), _pending_nextptr(0)
+      _owner(0), _pending_next(0)
 {
+    _pending = 0;
 }
 
 inline
@@ -336,8 +337,9 @@ Task::Task(Element* e)
       _cycle_runs(0),
 #endif
       _thread(0), _home_thread_id(-1),
-      _owner(0), _pending_nextptr(0)
+      _owner(0), _pending_next(0)
 {
+    _pending = 0;
 }
 
 inline bool
@@ -641,17 +643,5 @@ Task::update_cycles(unsigned c)
 }
 #endif
 
-inline Task *
-Task::pending_to_task(uintptr_t ptr)
-{
-    return reinterpret_cast<Task *>(ptr & ~(uintptr_t) 3);
-}
-
-inline Task *
-Task::pending_to_task() const
-{
-    return pending_to_task(_pending_nextptr);
-}
-
 CLICK_ENDDECLS
 #endif
@@ -6,6 +6,7 @@
 #include <click/element.hh>
 #include <click/timestamp.hh>
 CLICK_DECLS
+class RouterThread;
 
 typedef void (*TimerCallback)(Timer *timer, void *user_data);
 typedef TimerCallback TimerHook CLICK_DEPRECATED;
@@ -125,14 +126,12 @@ class Timer { public:
      * If Click is compiled with statistics support, time spent in this
      * Timer will be charged to the @a owner element.
      *
+     * The timer is run by the @a owner element's home thread, as reported
+     * by Router::home_thread().
+     *
      * Initializing a Timer constructed by the default constructor, Timer(),
      * will produce a warning. */
-    inline void initialize(Element *owner, bool quiet = false) {
-	assert(!initialized() || _owner->router() == owner->router());
-	_owner = owner;
-	if (unlikely(_hook.callback == do_nothing_hook && !_thunk) && !quiet)
-	    click_chatter("initializing Timer %{element} [%p], which does nothing", _owner, this);
-    }
+    void initialize(Element *owner, bool quiet = false);
 
     /** @brief Initialize the timer.
      * @param router the owner router
@@ -290,6 +289,11 @@ class Timer { public:
     } _hook;
     void *_thunk;
     Element *_owner;
+    RouterThread *_thread;
+#if HAVE_TIMER_WHEEL
+    Timer *_wheel_next;
+    Timer **_wheel_pprev;
+#endif
 
     Timer &operator=(const Timer &x);
 
@@ -297,7 +301,7 @@ class Timer { public:
     static void element_hook(Timer *t, void *user_data);
     static void task_hook(Timer *t, void *user_data);
 
-    friend class Master;
+    friend class TimerSet;
 
 };
 
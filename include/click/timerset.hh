@@ -0,0 +1,183 @@
+// -*- c-basic-offset: 4; related-file-name: "../../lib/timerset.cc" -*-
+#ifndef CLICK_TIMERSET_HH
+#define CLICK_TIMERSET_HH 1
+#include <click/timer.hh>
+#include <click/sync.hh>
+#include <click/vector.hh>
+CLICK_DECLS
+class Master;
+class Router;
+class RouterThread;
+
+/** @class TimerSet
+ * @brief The set of Timers scheduled on one RouterThread.
+ *
+ * Each RouterThread has its own TimerSet, which holds the timers initialized
+ * by elements whose home thread is that RouterThread.  Only that thread runs
+ * the timers, so threads never contend for a shared timer heap.  Other
+ * threads may still schedule or unschedule the timers; the TimerSet's lock
+ * serializes those changes.
+ *
+ * By default, a TimerSet keeps its timers in a heap ordered by expiry time,
+ * so scheduling or unscheduling a timer costs O(log n).  If Click was
+ * configured with --enable-timer-wheel, a TimerSet instead keeps its timers
+ * in a hierarchical timing wheel, where scheduling and unscheduling cost
+ * O(1) and expired timers are collected in batches.  The wheel has four
+ * levels of 256 slots each.  A level-0 slot covers one tick of 1/1024
+ * second, which is only a bucket size: timers still run at their exact
+ * expiry times, and in expiry order, as with the heap. */
+class TimerSet { public:
+
+    TimerSet();
+
+    Timestamp timer_expiry() const	{ return _timer_expiry; }
+    const Timestamp &timer_check() const { return _timer_check; }
+    unsigned max_timer_stride() const	{ return _max_timer_stride; }
+    unsigned timer_stride() const	{ return _timer_stride; }
+    void set_max_timer_stride(unsigned timer_stride);
+
+    inline Timestamp timer_expiry_adjusted() const;
+    void run_timers(RouterThread *thread, Master *master);
+
+    inline void lock_timers();
+    inline bool attempt_lock_timers();
+    inline void unlock_timers();
+
+    void kill_router(Router *router);
+
+  private:
+
+    // stick _timer_expiry here so it will most likely fit in a cache line,
+    // & we don't have to worry about its parts being updated separately
+    Timestamp _timer_expiry;
+
+    unsigned _max_timer_stride;
+    unsigned _timer_stride;
+    unsigned _timer_count;
+#if HAVE_TIMER_WHEEL
+    enum { wheel_levels = 4, wheel_bits = 8, wheel_size = 1 << wheel_bits,
+	   wheel_mask = wheel_size - 1, wheel_words = wheel_size / 32 };
+    typedef uint64_t wheel_tick_t;
+    Timer *_wheel[wheel_levels][wheel_size];
+    uint32_t _wheel_live[wheel_levels][wheel_words];
+    wheel_tick_t _wheel_now;
+    wheel_tick_t _wheel_cascaded;
+    uint32_t _wheel_count;
+#else
+    Vector<Timer *> _timer_heap;
+#endif
+    Vector<Timer *> _timer_runchunk;
+#if CLICK_LINUXMODULE
+    spinlock_t _timer_lock;
+    struct task_struct *_timer_task;
+#elif HAVE_MULTITHREAD
+    Spinlock _timer_lock;
+#endif
+    Timestamp _timer_check;
+    uint32_t _timer_check_reports;
+
+    inline void run_one_timer(Timer *);
+
+#if HAVE_TIMER_WHEEL
+    static inline wheel_tick_t wheel_tick(const Timestamp &t) {
+	return ((wheel_tick_t) t.sec() << 10) | (t.usec() >> 10);
+    }
+    static inline Timestamp wheel_tick_time(wheel_tick_t tick) {
+	return Timestamp::make_usec(tick >> 10, (tick & 1023) << 10);
+    }
+    void wheel_insert(Timer *t);
+    void wheel_remove(Timer *t);
+    int wheel_next_slot(int level, int start) const;
+    void wheel_collect(Timer **slot);
+    void wheel_sort_runchunk();
+    void wheel_cascade(int level, int index);
+    void wheel_advance();
+    void set_timer_expiry();
+#else
+    void set_timer_expiry() {
+	if (_timer_heap.size())
+	    _timer_expiry = _timer_heap.at_u(0)->_expiry;
+	else
+	    _timer_expiry = Timestamp();
+    }
+#endif
+    void check_timer_expiry(Timer *t);
+
+    static inline void place_timer(Timer **t, Timer **tbegin) {
+	(*t)->_schedpos1 = (t - tbegin) + 1;
+    }
+
+    struct timer_less {
+	bool operator()(Timer *a, Timer *b) {
+	    return a->expiry() < b->expiry();
+	}
+    };
+    struct timer_place {
+	Timer **_begin;
+	timer_place(Timer **begin)
+	    : _begin(begin) {
+	}
+	void operator()(Timer **t) {
+	    TimerSet::place_timer(t, _begin);
+	}
+    };
+
+    friend class Timer;
+
+};
+
+inline Timestamp
+TimerSet::timer_expiry_adjusted() const
+{
+    Timestamp e = _timer_expiry;
+#if CLICK_USERLEVEL
+    if (likely(!Timestamp::warp_jumping())) {
+#endif
+    if (_timer_stride >= 8 || e.sec() == 0)
+	/* do nothing */;
+    else if (_timer_stride >= 4)
+	e -= Timer::adjustment();
+    else
+	e -= Timer::adjustment() + Timer::adjustment();
+#if CLICK_USERLEVEL
+    }
+#endif
+    return e;
+}
+
+inline void
+TimerSet::lock_timers()
+{
+#if CLICK_LINUXMODULE
+    if (current != _timer_task)
+	spin_lock(&_timer_lock);
+#elif HAVE_MULTITHREAD
+    _timer_lock.acquire();
+#endif
+}
+
+inline bool
+TimerSet::attempt_lock_timers()
+{
+#if CLICK_LINUXMODULE
+    return spin_trylock(&_timer_lock);
+#elif HAVE_MULTITHREAD
+    return _timer_lock.attempt();
+#else
+    return true;
+#endif
+}
+
+inline void
+TimerSet::unlock_timers()
+{
+#if CLICK_LINUXMODULE
+    if (current != _timer_task)
+	spin_unlock(&_timer_lock);
+#elif HAVE_MULTITHREAD
+    _timer_lock.release();
+#endif
+}
+
+CLICK_ENDDECLS
+#endif
@@ -130,6 +130,8 @@ struct click_ip {
  * @a x must be two-byte aligned. */
 uint16_t click_in_cksum(const unsigned char *x, int len);
 uint16_t click_in_cksum_pseudohdr_raw(uint32_t csum, uint32_t src, uint32_t dst, int proto, int packet_len);
+int click_in_cksum_set_kernel(const char *name);
+const char *click_in_cksum_kernel(void);
 #else
 # define click_in_cksum(addr, len) \
 		ip_compute_csum((unsigned char *)(addr), (len))
@@ -182,6 +184,39 @@ click_update_in_cksum(uint16_t *csum, uint16_t old_hw, uint16_t new_hw)
     *csum = ~(sum + (sum >> 16));
 }
 
+/** @brief Incrementally adjust an Internet checksum for a changed word.
+ * @param[in, out] csum points to checksum
+ * @param old_w old 32-bit word
+ * @param new_w new 32-bit word
+ *
+ * Like click_update_in_cksum(), but accounts for a change of both halfwords
+ * of a 32-bit field, such as an IP address or TCP sequence number, at once.
+ * The words may be in either byte order, as long as both use the same. */
+static inline void
+click_update_in_cksum32(uint16_t *csum, uint32_t old_w, uint32_t new_w)
+{
+    uint32_t sum = (~*csum & 0xFFFF) + (~old_w & 0xFFFF) + (~old_w >> 16)
+	+ (new_w & 0xFFFF) + (new_w >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    *csum = ~(sum + (sum >> 16));
+}
+
+/** @brief Incrementally adjust an Internet checksum by a summed change.
+ * @param[in, out] csum points to checksum
+ * @param delta sum of ~old_halfword + new_halfword over changed halfwords
+ *
+ * Use this function when many halfwords change, such as the SACK blocks of
+ * a TCP header: add (~old & 0xFFFF) + new for each changed halfword into a
+ * 32-bit @a delta, then apply @a delta to the checksum once.  @a delta need
+ * not be folded, but must not have overflowed. */
+static inline void
+click_update_in_cksum_delta(uint16_t *csum, uint32_t delta)
+{
+    uint32_t sum = (~*csum & 0xFFFF) + (delta & 0xFFFF) + (delta >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    *csum = ~(sum + (sum >> 16));
+}
+
 /** @brief Potentially fix a zero-valued Internet checksum.
  * @param[in, out] csum points to checksum
  * @param x data to checksum
@@ -29,6 +29,7 @@
 #include <click/error.hh>
 #include <click/router.hh>
 #include <click/master.hh>
+#include <click/perthread.hh>
 #include <click/straccum.hh>
 #include <click/etheraddress.hh>
 #if CLICK_DEBUG_SCHEDULING
@@ -1724,7 +1725,7 @@ Element::selected(int fd)
 int
 Element::add_select(int fd, int mask)
 {
-    return master()->add_select(fd, this, mask);
+    return router()->home_thread(this)->select_set().add_select(fd, this, mask);
 }
 
 /** @brief Remove interest in @a mask events on file descriptor @a fd.
@@ -1743,7 +1744,7 @@ Element::add_select(int fd, int mask)
 int
 Element::remove_select(int fd, int mask)
 {
-    return master()->remove_select(fd, this, mask);
+    return router()->home_thread(this)->select_set().remove_select(fd, this, mask);
 }
 
 #endif
@@ -2283,6 +2284,21 @@ atomic_uint32_t_data_handler(int op, String &str, Element *element, const Handle
 	return errh->error("expected integer");
 }
 
+static int
+per_thread_counter_data_handler(int op, String &str, Element *element, const Handler *h, ErrorHandler *errh)
+{
+    PerThreadCounter *ptr = reinterpret_cast<PerThreadCounter *>(reinterpret_cast<uintptr_t>(element) + reinterpret_cast<uintptr_t>(h->user_data(op)));
+    PerThreadCounter::value_type value;
+    if (op == Handler::h_read) {
+	str = String(ptr->value());
+	return 0;
+    } else if (cp_integer(str, &value) && value == 0) {
+	ptr->clear();
+	return 0;
+    } else
+	return errh->error("expected 0");
+}
+
 #if HAVE_FLOAT_TYPES
 static int
 double_data_handler(int op, String &str, Element *element, const Handler *h, ErrorHandler *errh)
@@ -2414,6 +2430,19 @@ Element::add_data_handlers(const String &name, int flags, atomic_uint32_t *data)
     add_data_handlers(name, flags, atomic_uint32_t_data_handler, data);
 }
 
+/** @overload
+ *
+ * The read handler is marked Handler::h_read_counter, so samplers may read
+ * the counter directly (see Handler::read_counter()).  The write handler
+ * accepts only 0, which clears the counter. */
+void
+Element::add_data_handlers(const String &name, int flags, PerThreadCounter *data)
+{
+    if (flags & Handler::h_read)
+	flags |= Handler::h_read_counter;
+    add_data_handlers(name, flags, per_thread_counter_data_handler, data);
+}
+
 /** @overload */
 void
 Element::add_data_handlers(const String &name, int flags, long *data)
@@ -2855,6 +2884,60 @@ Element::simple_action(Packet *p)
     return p;
 }
 
+/** @brief Push a batch of packets onto push input @a port.
+ *
+ * @param port the input port number on which the packets arrive
+ * @param batch the packets
+ *
+ * An upstream element transferred every packet in @a batch to this element
+ * over a push connection, using Element::Port::push_batch().  push_batch()
+ * must account for every packet in the batch, just as push() accounts for a
+ * single packet, and must leave @a batch empty when it returns.
+ *
+ * Elements on hot paths override push_batch() so that a burst of packets
+ * costs one virtual call per element, rather than one per packet.  Packets
+ * in the batch should generally be processed and emitted in order.
+ *
+ * The default implementation calls push() once for each packet in the
+ * batch.
+ *
+ * @sa PacketBatch, pull_batch()
+ */
+void
+Element::push_batch(int port, PacketBatch &batch)
+{
+    while (Packet *p = batch.pop_front())
+	push(port, p);
+}
+
+/** @brief Pull a batch of packets from pull output @a port.
+ *
+ * @param port the output port number receiving the pull request
+ * @param max the maximum number of packets to return
+ * @return a batch of at most @a max packets
+ *
+ * A downstream element initiated a transfer of up to @a max packets from this
+ * element over a pull connection, using Element::Port::pull_batch().  The
+ * returned batch may be empty if no packets are available.
+ *
+ * The default implementation calls pull() until it returns null or @a max
+ * packets have been collected.
+ *
+ * @sa PacketBatch, push_batch()
+ */
+PacketBatch
+Element::pull_batch(int port, unsigned max)
+{
+    PacketBatch batch;
+    while (batch.count() < max) {
+	Packet *p = pull(port);
+	if (!p)
+	    break;
+	batch.append(p);
+    }
+    return batch;
+}
+
 /** @brief Run the element's task.
  *
  * @return true if the task accomplished some meaningful work, false otherwise
@@ -0,0 +1,98 @@
+// -*- c-basic-offset: 4; related-file-name: "../include/click/epoch.hh" -*-
+/*
+ * epoch.{cc,hh} -- deferred reclamation for lock-free tables
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include <click/epoch.hh>
+#include <click/master.hh>
+CLICK_DECLS
+
+/** @brief Destroy the EpochReclaimer, freeing all retired objects.
+ *
+ * No reader may still be using them. */
+EpochReclaimer::~EpochReclaimer()
+{
+    reclaim_all();
+}
+
+/** @brief Retire @a object, which will be freed by calling
+ * @a deleter(@a object, @a user_data).
+ *
+ * The caller must already have unlinked @a object, so that readers starting
+ * from now on cannot find it. */
+void
+EpochReclaimer::retire(void *object, Deleter deleter, void *user_data)
+{
+    Retired r;
+    r.epoch = (_master ? _master->advance_epoch() : 0);
+    r.object = object;
+    r.deleter = deleter;
+    r.user_data = user_data;
+    _retired.push_back(r);
+}
+
+/** @brief Free the retired objects that no reader can reach.
+ * @return the number of retired objects still waiting */
+int
+EpochReclaimer::reclaim()
+{
+    if (_head == _retired.size())
+	return 0;
+    if (!_master) {
+	reclaim_all();
+	return 0;
+    }
+
+    uint32_t oldest = _master->oldest_epoch();
+    Retired *r = _retired.begin() + _head;
+    for (; r != _retired.end() && (int32_t) (oldest - r->epoch) >= 0; ++r)
+	r->deleter(r->object, r->user_data);
+    _head = r - _retired.begin();
+
+    if (_head == _retired.size()) {
+	_retired.clear();
+	_head = 0;
+    } else if (_head >= 32 && _head * 2 >= _retired.size()) {
+	_retired.erase(_retired.begin(), r);
+	_head = 0;
+    }
+    return size();
+}
+
+/** @brief Free all retired objects now.
+ *
+ * Call this only when no reader can be running, as in cleanup(). */
+void
+EpochReclaimer::reclaim_all()
+{
+    for (Retired *r = _retired.begin() + _head; r != _retired.end(); ++r)
+	r->deleter(r->object, r->user_data);
+    _retired.clear();
+    _head = 0;
+}
+
+/** @brief Swap this reclaimer's retired objects and Master with @a x's. */
+void
+EpochReclaimer::swap(EpochReclaimer &x)
+{
+    Master *m = _master;
+    _master = x._master;
+    x._master = m;
+    _retired.swap(x._retired);
+    int h = _head;
+    _head = x._head;
+    x._head = h;
+}
+
+CLICK_ENDDECLS
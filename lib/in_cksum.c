@@ -16,9 +16,17 @@
 # include <string.h>
 #endif
 
+/* At user level on x86, also compile SSE2 and AVX2 checksum loops, and
+   choose among them at run time. */
+#if CLICK_USERLEVEL && (defined(__x86_64__) || defined(__i386__)) \
+    && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+# define IN_CKSUM_DISPATCH 1
+# include <immintrin.h>
+#endif
+
 #if !CLICK_LINUXMODULE
-uint16_t
-click_in_cksum(const unsigned char *addr, int len)
+static uint16_t
+in_cksum_generic(const unsigned char *addr, int len)
 {
     int nleft = len;
     const uint16_t *w = (const uint16_t *)addr;
@@ -50,6 +58,159 @@ click_in_cksum(const unsigned char *addr, int len)
     return answer;
 }
 
+# if IN_CKSUM_DISPATCH
+/* Fold a wide one's-complement sum of 16-bit words into a checksum. */
+static inline uint16_t
+in_cksum_fold(uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFFU) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFFU) + (sum >> 32);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return ~sum;
+}
+
+static inline uint64_t
+in_cksum_tail(const unsigned char *addr, int len)
+{
+    const uint16_t *w = (const uint16_t *) addr;
+    uint64_t sum = 0;
+    uint16_t odd = 0;
+    for (; len > 1; len -= 2)
+	sum += *w++;
+    if (len == 1) {
+	*(unsigned char *) &odd = *(const unsigned char *) w;
+	sum += odd;
+    }
+    return sum;
+}
+
+/* The vector loops add 16-bit words into 32-bit lanes, which could
+   overflow after 2^15 additions; they empty the lanes every 2^12 blocks. */
+#  define IN_CKSUM_BLOCKS	4096
+
+static __attribute__((target("sse2"))) uint16_t
+in_cksum_sse2(const unsigned char *addr, int len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t sum = 0;
+    uint32_t lanes[4];
+    while (len >= 16) {
+	int n = len >> 4;
+	__m128i acc0 = zero, acc1 = zero;
+	if (n > IN_CKSUM_BLOCKS)
+	    n = IN_CKSUM_BLOCKS;
+	len -= n << 4;
+	for (; n > 0; --n, addr += 16) {
+	    __m128i v = _mm_loadu_si128((const __m128i *) addr);
+	    acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(v, zero));
+	    acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(v, zero));
+	}
+	_mm_storeu_si128((__m128i *) lanes, _mm_add_epi32(acc0, acc1));
+	sum += (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    return in_cksum_fold(sum + in_cksum_tail(addr, len));
+}
+
+static __attribute__((target("avx2"))) uint16_t
+in_cksum_avx2(const unsigned char *addr, int len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t sum = 0;
+    uint32_t lanes[8];
+    while (len >= 32) {
+	int n = len >> 5;
+	__m256i acc0 = zero, acc1 = zero;
+	if (n > IN_CKSUM_BLOCKS)
+	    n = IN_CKSUM_BLOCKS;
+	len -= n << 5;
+	for (; n > 0; --n, addr += 32) {
+	    __m256i v = _mm256_loadu_si256((const __m256i *) addr);
+	    acc0 = _mm256_add_epi32(acc0, _mm256_unpacklo_epi16(v, zero));
+	    acc1 = _mm256_add_epi32(acc1, _mm256_unpackhi_epi16(v, zero));
+	}
+	_mm256_storeu_si256((__m256i *) lanes, _mm256_add_epi32(acc0, acc1));
+	sum += (uint64_t) lanes[0] + lanes[1] + lanes[2] + lanes[3]
+	    + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    }
+    return in_cksum_fold(sum + in_cksum_tail(addr, len));
+}
+
+static uint16_t in_cksum_select(const unsigned char *addr, int len);
+
+static uint16_t (*in_cksum_kernel)(const unsigned char *, int) = in_cksum_select;
+static const char *in_cksum_kernel_name = "generic";
+
+static uint16_t
+in_cksum_select(const unsigned char *addr, int len)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+	click_in_cksum_set_kernel("avx2");
+    else if (__builtin_cpu_supports("sse2"))
+	click_in_cksum_set_kernel("sse2");
+    else
+	click_in_cksum_set_kernel("generic");
+    return in_cksum_kernel(addr, len);
+}
+# endif
+
+/** @brief Choose the loop click_in_cksum() uses for long data.
+ * @param name "generic", "sse2", or "avx2"
+ * @return 0 on success, -1 if @a name is unknown or this CPU cannot run it
+ *
+ * click_in_cksum() normally picks the fastest loop the CPU supports. */
+int
+click_in_cksum_set_kernel(const char *name)
+{
+# if IN_CKSUM_DISPATCH
+    __builtin_cpu_init();
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+	in_cksum_kernel_name = "avx2";
+	in_cksum_kernel = in_cksum_avx2;
+	return 0;
+    } else if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+	in_cksum_kernel_name = "sse2";
+	in_cksum_kernel = in_cksum_sse2;
+	return 0;
+    } else if (strcmp(name, "generic") == 0) {
+	in_cksum_kernel_name = "generic";
+	in_cksum_kernel = in_cksum_generic;
+	return 0;
+    } else
+	return -1;
+# else
+    return strcmp(name, "generic") == 0 ? 0 : -1;
+# endif
+}
+
+/** @brief Return the name of the loop click_in_cksum() uses for long data. */
+const char *
+click_in_cksum_kernel(void)
+{
+# if IN_CKSUM_DISPATCH
+    if (in_cksum_kernel == in_cksum_select) {
+	unsigned char x[2] = { 0, 0 };
+	(void) in_cksum_select(x, 2);
+    }
+    return in_cksum_kernel_name;
+# else
+    return "generic";
+# endif
+}
+
+uint16_t
+click_in_cksum(const unsigned char *addr, int len)
+{
+# if IN_CKSUM_DISPATCH
+    /* Vector loops only pay off on longer data, such as whole payloads. */
+    if (len >= 64)
+	return in_cksum_kernel(addr, len);
+# endif
+    return in_cksum_generic(addr, len);
+}
+
 uint16_t
 click_in_cksum_pseudohdr_raw(uint32_t csum, uint32_t src, uint32_t dst, int proto, int packet_len)
 {
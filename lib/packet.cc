@@ -25,6 +25,11 @@
 #if CLICK_USERLEVEL
 # include <unistd.h>
 #endif
+#if HAVE_CLICK_PACKET_POOL
+# include <click/atomic.hh>
+# include <click/sync.hh>
+# include <click/straccum.hh>
+#endif
 CLICK_DECLS
 
 /** @file packet.hh
@@ -212,12 +217,255 @@ Packet::~Packet()
 #endif
 }
 
+#if HAVE_CLICK_PACKET_POOL
+//
+// PACKET POOL
+//
+
+// Each thread that makes packets owns a PacketPool.  A pool keeps dead
+// Packet objects on free lists; a dead packet may keep its data buffer when
+// the buffer's length matches one of the pool's size classes, so the common
+// Packet::make() path allocates no memory at all.  A packet killed by the
+// thread that made it goes straight back onto that thread's free lists.  A
+// packet killed by another thread is pushed onto its owner's lock-free
+// "remote" list, which the owner adopts when its own lists run dry.
+
+struct PacketPool {
+
+    enum { nclasses = 2, max_free = 4096 };
+    static const uint32_t class_size[nclasses];
+
+    WritablePacket *p;		// free packets without data
+    unsigned pcount;
+    WritablePacket *pd[nclasses]; // free packets with data, by size class
+    unsigned pdcount[nclasses];
+    atomic_pointer<WritablePacket> remote; // freed by other threads
+    PacketPool *next;
+
+# if HAVE_INT64_TYPES
+    typedef uint64_t counter_type;
+# else
+    typedef uint32_t counter_type;
+# endif
+    counter_type hits;
+    counter_type misses;
+    counter_type remote_frees;
+
+    static PacketPool *all;
+    static Spinlock all_lock;
+# if HAVE_MULTITHREAD
+    static __thread PacketPool *thread_pool;
+# else
+    static PacketPool *thread_pool;
+# endif
+
+    static inline PacketPool *local() {
+	if (PacketPool *pp = thread_pool)
+	    return pp;
+	return make_local();
+    }
+    static PacketPool *make_local();
+
+    // smallest size class holding n bytes, or -1
+    static inline int size_class(uint32_t n) {
+	for (int c = 0; c < nclasses; ++c)
+	    if (n <= class_size[c])
+		return c;
+	return -1;
+    }
+    // size class of exactly n bytes, or -1
+    static inline int exact_size_class(uint32_t n) {
+	for (int c = 0; c < nclasses; ++c)
+	    if (n == class_size[c])
+		return c;
+	return -1;
+    }
+
+    inline WritablePacket *make_header();
+    inline WritablePacket *make(uint32_t headroom, uint32_t length, uint32_t tailroom);
+    inline void free(WritablePacket *p, int c);
+    void adopt_remote();
+    static void recycle(Packet *p);
+
+};
+
+const uint32_t PacketPool::class_size[PacketPool::nclasses] = { 2048, 9216 };
+PacketPool *PacketPool::all;
+Spinlock PacketPool::all_lock;
+# if HAVE_MULTITHREAD
+__thread PacketPool *PacketPool::thread_pool;
+# else
+PacketPool *PacketPool::thread_pool;
+# endif
+
+PacketPool *
+PacketPool::make_local()
+{
+    PacketPool *pp = new PacketPool;
+    pp->p = 0;
+    pp->pcount = 0;
+    for (int c = 0; c < nclasses; ++c) {
+	pp->pd[c] = 0;
+	pp->pdcount[c] = 0;
+    }
+    pp->remote = 0;
+    pp->hits = pp->misses = pp->remote_frees = 0;
+    all_lock.acquire();
+    pp->next = all;
+    all = pp;
+    all_lock.release();
+    thread_pool = pp;
+    return pp;
+}
+
+void
+PacketPool::adopt_remote()
+{
+    WritablePacket *x = remote.swap(0);
+    while (x) {
+	WritablePacket *n = static_cast<WritablePacket *>(x->_next);
+	free(x, x->_head ? exact_size_class(x->_end - x->_head) : -1);
+	++remote_frees;
+	x = n;
+    }
+}
+
+inline void
+PacketPool::free(WritablePacket *x, int c)
+{
+    WritablePacket **list = (c >= 0 ? &pd[c] : &p);
+    unsigned *count = (c >= 0 ? &pdcount[c] : &pcount);
+    if (*count < max_free) {
+	x->_next = *list;
+	*list = x;
+	++*count;
+    } else
+	delete static_cast<Packet *>(x);
+}
+
+inline WritablePacket *
+PacketPool::make_header()
+{
+    if (!p && remote.value())
+	adopt_remote();
+    WritablePacket *x = p;
+    if (x) {
+	p = static_cast<WritablePacket *>(x->_next);
+	--pcount;
+	x->_use_count = 1;
+	x->clear_annotations();
+    } else if (!(x = static_cast<WritablePacket *>(new Packet)))
+	return 0;
+    x->_pool = this;
+    return x;
+}
+
+inline WritablePacket *
+PacketPool::make(uint32_t headroom, uint32_t length, uint32_t tailroom)
+{
+    uint32_t n = headroom + length + tailroom;
+    int c = size_class(n < Packet::min_buffer_length ? Packet::min_buffer_length : n);
+    if (c >= 0 && !pd[c] && remote.value())
+	adopt_remote();
+    if (c >= 0 && pd[c]) {
+	WritablePacket *x = pd[c];
+	pd[c] = static_cast<WritablePacket *>(x->_next);
+	--pdcount[c];
+	++hits;
+	x->_use_count = 1;
+	x->_data = x->_head + headroom;
+	x->_tail = x->_data + length;
+	x->clear_annotations();
+	x->_pool = this;
+	return x;
+    }
+
+    ++misses;
+    WritablePacket *x = make_header();
+    if (x && !x->alloc_data(headroom, length, tailroom)) {
+	free(x, -1);
+	x = 0;
+    }
+    return x;
+}
+
+void
+PacketPool::recycle(Packet *x)
+{
+    // release the data, keeping the buffer if it fits a size class
+    int c = -1;
+    if (x->_data_packet)
+	x->_data_packet->kill();
+    else if (x->_head && x->_destructor)
+	x->_destructor(x->_head, x->_end - x->_head);
+    else if (x->_head && (c = exact_size_class(x->_end - x->_head)) < 0)
+	delete[] x->_head;
+    if (c < 0)
+	x->_head = x->_data = x->_tail = x->_end = 0;
+    x->_data_packet = 0;
+    x->_destructor = 0;
+
+    WritablePacket *wx = static_cast<WritablePacket *>(x);
+    PacketPool *owner = x->_pool, *pp = local();
+    if (!owner || owner == pp)
+	pp->free(wx, c);
+    else {
+	WritablePacket *head;
+	do {
+	    head = owner->remote.value();
+	    wx->_next = head;
+	} while (!owner->remote.compare_and_swap(head, wx));
+    }
+}
+
+/** @brief Report packet pool statistics to @a sa.
+ *
+ * The report lists, for all threads' pools together, the number of
+ * Packet::make() calls satisfied from a pool without memory allocation
+ * ("hits"), the number that allocated memory ("misses"), the number of
+ * packets freed by a thread other than the one that made them ("remote"),
+ * and the number of packets currently free. */
+void
+Packet::pool_report(StringAccum &sa)
+{
+    PacketPool::counter_type hits = 0, misses = 0, remote_frees = 0;
+    unsigned npools = 0, nfree = 0;
+    PacketPool::all_lock.acquire();
+    for (PacketPool *pp = PacketPool::all; pp; pp = pp->next) {
+	++npools;
+	hits += pp->hits;
+	misses += pp->misses;
+	remote_frees += pp->remote_frees;
+	nfree += pp->pcount;
+	for (int c = 0; c < PacketPool::nclasses; ++c)
+	    nfree += pp->pdcount[c];
+    }
+    PacketPool::all_lock.release();
+    sa << "pools " << npools << '\n'
+       << "hits " << hits << '\n'
+       << "misses " << misses << '\n'
+       << "remote " << remote_frees << '\n'
+       << "free " << nfree << '\n';
+}
+
+void
+Packet::recycle(Packet *p)
+{
+    PacketPool::recycle(p);
+}
+
+#endif /* HAVE_CLICK_PACKET_POOL */
+
 #if !CLICK_LINUXMODULE
 
 inline WritablePacket *
 Packet::make(int, int, int)
 {
+#if HAVE_CLICK_PACKET_POOL
+    return PacketPool::local()->make_header();
+#else
     return static_cast<WritablePacket *>(new Packet(6, 6, 6));
+#endif
 }
 
 bool
@@ -229,6 +477,14 @@ Packet::alloc_data(uint32_t headroom, uint32_t len, uint32_t tailroom)
     n = min_buffer_length;
   }
 #if CLICK_USERLEVEL
+# if HAVE_CLICK_PACKET_POOL
+  // round up to a size class so the buffer can be recycled
+  int c = PacketPool::size_class(n);
+  if (c >= 0) {
+    tailroom += PacketPool::class_size[c] - n;
+    n = PacketPool::class_size[c];
+  }
+# endif
   unsigned char *d = new unsigned char[n];
   if (!d)
     return false;
@@ -303,6 +559,11 @@ Packet::make(uint32_t headroom, const void *data,
     } else
 	return 0;
 #else
+# if HAVE_CLICK_PACKET_POOL
+    WritablePacket *p = PacketPool::local()->make(headroom, length, tailroom);
+    if (!p)
+	return 0;
+# else
     WritablePacket *p = new WritablePacket;
     if (!p)
 	return 0;
@@ -310,6 +571,7 @@ Packet::make(uint32_t headroom, const void *data,
 	delete p;
 	return 0;
     }
+# endif
     if (data)
 	memcpy(p->data(), data, length);
     return p;
@@ -383,6 +645,9 @@ Packet::clone()
     p->_data_packet = this;
 # if CLICK_USERLEVEL
     p->_destructor = 0;
+#  if HAVE_CLICK_PACKET_POOL
+    p->_pool = PacketPool::thread_pool;
+#  endif
 # else
     p->_m = m;
 # endif
@@ -393,6 +658,45 @@ Packet::clone()
 #endif /* CLICK_LINUXMODULE */
 }
 
+/** @brief Create several clones of this packet.
+ * @param clones array of at least @a n packet pointers
+ * @param n number of clones to create
+ * @return the number of clones created
+ *
+ * Stores clones of this packet in @a clones[0] through @a clones[@a n - 1].
+ * Each clone is like one returned by clone().  At user level, the shared
+ * data's reference count is updated once for all clones, so flooding a
+ * packet to many outputs this way touches that shared count only once.
+ * Fewer than @a n clones are created only if memory runs out. */
+int
+Packet::clone(Packet **clones, int n)
+{
+#if CLICK_USERLEVEL
+    int made;
+    for (made = 0; made < n; ++made) {
+	Packet *p = Packet::make(6, 6, 6); // dummy arguments: no initialization
+	if (!p)
+	    break;
+	memcpy(p, this, sizeof(Packet));
+	p->_use_count = 1;
+	p->_data_packet = this;
+	p->_destructor = 0;
+# if HAVE_CLICK_PACKET_POOL
+	p->_pool = PacketPool::thread_pool;
+# endif
+	clones[made] = p;
+    }
+    _use_count += made;
+    return made;
+#else
+    int made;
+    for (made = 0; made < n; ++made)
+	if (!(clones[made] = clone()))
+	    break;
+    return made;
+#endif
+}
+
 WritablePacket *
 Packet::expensive_uniqueify(int32_t extra_headroom, int32_t extra_tailroom,
 			    bool free_on_failure)
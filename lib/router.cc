@@ -1250,7 +1250,7 @@ Handler::combine(const Handler &x)
     if (!(_flags & h_read) && (x._flags & h_read)) {
 	_read_hook = x._read_hook;
 	_read_user_data = x._read_user_data;
-	_flags |= x._flags & (h_read | h_read_comprehensive | ~h_special_flags);
+	_flags |= x._flags & (h_read | h_read_comprehensive | h_read_counter | ~h_special_flags);
     }
     if (!(_flags & h_write) && (x._flags & h_write)) {
 	_write_hook = x._write_hook;
@@ -1743,7 +1743,7 @@ Router::set_handler(const Element *e, const String &hname, uint32_t flags,
 	to_add._read_hook.h = callback;
 	flags |= Handler::h_read_comprehensive;
     } else
-	flags &= ~(Handler::h_read_comprehensive | Handler::h_read_param);
+	flags &= ~(Handler::h_read_comprehensive | Handler::h_read_param | Handler::h_read_counter);
     if (flags & Handler::h_write) {
 	to_add._write_hook.h = callback;
 	flags |= Handler::h_write_comprehensive;
@@ -1890,6 +1890,20 @@ ThreadSched::initial_home_thread_id(Element *, Task *, bool)
     return 0;
 }
 
+/** @brief Return the thread that runs @a owner's timers and selects.
+ *
+ * This is the thread chosen for @a owner by the router's ThreadSched, as
+ * reported by initial_home_thread_id().  Quiescent threads never run, so if
+ * that thread is quiescent or unknown, returns thread 0 instead. */
+RouterThread *
+Router::home_thread(Element *owner) const
+{
+    int tid = initial_home_thread_id(owner, 0, false);
+    if (tid < 0 || tid >= _master->nthreads())
+	tid = 0;
+    return _master->thread(tid);
+}
+
 /** @cond never */
 /** @brief  Create (if necessary) and return the NameInfo object for this router.
  *
@@ -2131,7 +2145,7 @@ Router::configuration_string() const
 
 enum { GH_VERSION, GH_CONFIG, GH_FLATCONFIG, GH_LIST, GH_REQUIREMENTS,
        GH_DRIVER, GH_ACTIVE_PORTS, GH_ACTIVE_PORT_STATS, GH_STRING_PROFILE,
-       GH_STRING_PROFILE_LONG, GH_SCHEDULING_PROFILE };
+       GH_STRING_PROFILE_LONG, GH_SCHEDULING_PROFILE, GH_PACKET_POOL };
 
 String
 Router::router_read_handler(Element *e, void *thunk)
@@ -2225,6 +2239,12 @@ Router::router_read_handler(Element *e, void *thunk)
 	break;
 #endif
 
+#if HAVE_CLICK_PACKET_POOL
+    case GH_PACKET_POOL:
+	Packet::pool_report(sa);
+	break;
+#endif
+
     }
     return sa.take_string();
 }
@@ -2266,6 +2286,9 @@ Router::static_initialize()
 #endif
 #if CLICK_DEBUG_MASTER || CLICK_DEBUG_SCHEDULING
 	add_read_handler(0, "scheduling_profile", router_read_handler, (void *) GH_SCHEDULING_PROFILE);
+#endif
+#if HAVE_CLICK_PACKET_POOL
+	add_read_handler(0, "packet_pool", router_read_handler, (void *) GH_PACKET_POOL);
 #endif
     }
 }
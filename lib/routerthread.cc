@@ -58,6 +58,10 @@ CLICK_DECLS
 static unsigned long greedy_schedule_jiffies;
 #endif
 
+#if !CLICK_LINUXMODULE && HAVE_MULTITHREAD
+__thread RouterThread *RouterThread::_current;
+#endif
+
 /** @file routerthread.hh
  * @brief The RouterThread class implementing the Click driver loop.
  */
@@ -72,13 +76,16 @@ RouterThread::RouterThread(Master *m, int id)
 #else
     : Task(Task::error_hook, 0), _master(m), _id(id)
 #endif
+#if CLICK_USERLEVEL
+    , _selects(this)
+#endif
 {
 #if HAVE_TASK_HEAP
     _pass = 0;
 #else
     _prev = _next = _thread = this;
 #endif
-    _any_pending = 0;
+    _pending_head = 0;
 #if CLICK_LINUXMODULE
     _linux_task = 0;
 #elif HAVE_MULTITHREAD
@@ -89,6 +96,7 @@ RouterThread::RouterThread(Master *m, int id)
 #endif
     _task_blocker = 0;
     _task_blocker_waiting = 0;
+    _epoch = 0;
 #if HAVE_ADAPTIVE_SCHEDULER
     _max_click_share = 80 * Task::MAX_UTILIZATION / 100;
     _min_click_share = Task::MAX_UTILIZATION / 200;
@@ -137,7 +145,7 @@ RouterThread::RouterThread(Master *m, int id)
 
 RouterThread::~RouterThread()
 {
-    _any_pending = 0;
+    _pending_head = 0;
     assert(!active());
 #if CLICK_USERLEVEL && HAVE_MULTITHREAD
     if (_wake_pipe[0] >= 0) {
@@ -371,7 +379,7 @@ RouterThread::run_tasks(int ntasks)
 
 	// 22.May.2008: If pending changes on this task, break early to
 	// take care of them.
-	if (t->_pending_nextptr)
+	if (t->_pending.value())
 	    break;
 
 #if HAVE_MULTITHREAD
@@ -430,8 +438,9 @@ RouterThread::run_os()
     driver_unlock_tasks();
 
 #if CLICK_USERLEVEL
-    _master->run_selects(this);
+    _selects.run_selects();
 #elif CLICK_LINUXMODULE		/* Linux kernel module */
+    _master->epoch_offline(this);
     if (_greedy) {
 	if (time_after(jiffies, greedy_schedule_jiffies + 5 * CLICK_HZ)) {
 	    greedy_schedule_jiffies = jiffies;
@@ -442,11 +451,7 @@ RouterThread::run_os()
 	set_thread_state(S_PAUSED);
 	set_current_state(TASK_RUNNING);
 	schedule();
-    } else if (_id != 0) {
-      block:
-	set_thread_state(S_BLOCKED);
-	schedule();
-    } else if (Timestamp wait = _master->next_timer_expiry_adjusted()) {
+    } else if (Timestamp wait = _timers.timer_expiry_adjusted()) {
 	wait -= Timestamp::now();
 	if (!(wait > Timestamp(0, Timestamp::subsec_per_sec / CLICK_HZ)))
 	    goto short_pause;
@@ -455,9 +460,13 @@ RouterThread::run_os()
 	    (void) schedule_timeout(LONG_MAX - CLICK_HZ - 1);
 	else
 	    (void) schedule_timeout(wait.jiffies() - 1);
-    } else
-	goto block;
+    } else {
+	set_thread_state(S_BLOCKED);
+	schedule();
+    }
+    _master->epoch_quiescent(this);
 #elif defined(CLICK_BSDMODULE)
+    _master->epoch_offline(this);
     if (_greedy)
 	/* do nothing */;
     else if (active()) {	// just schedule others for a moment
@@ -469,6 +478,7 @@ RouterThread::run_os()
 	tsleep(&_sleep_ident, PPAUSE, "pause", 1);
 	_sleep_ident = NULL;
     }
+    _master->epoch_quiescent(this);
 #else
 # error "Compiling for unknown target."
 #endif
@@ -486,6 +496,7 @@ RouterThread::driver()
     _linux_task = current;
 #elif HAVE_MULTITHREAD
     _running_processor = click_current_processor();
+    _current = this;
     if (_wake_pipe[0] < 0 && pipe(_wake_pipe) >= 0) {
 	fcntl(_wake_pipe[0], F_SETFL, O_NONBLOCK);
 	fcntl(_wake_pipe[1], F_SETFL, O_NONBLOCK);
@@ -515,6 +526,8 @@ RouterThread::driver()
 #if CLICK_DEBUG_SCHEDULING
     _driver_epoch++;
 #endif
+    // no element code is running, so no table references are held
+    _master->epoch_quiescent(this);
 
     if (*stopper == 0) {
 	// run occasional tasks: timers, select, etc.
@@ -529,7 +542,7 @@ RouterThread::driver()
 	    run_os();
 #endif
 
-	bool run_timers = (iter % _master->timer_stride()) == 0;
+	bool run_timers = (iter % _timers.timer_stride()) == 0;
 #if BSD_NETISRSCHED
 	run_timers = run_timers || _oticks != ticks;
 #endif
@@ -537,11 +550,11 @@ RouterThread::driver()
 #if BSD_NETISRSCHED
 	    _oticks = ticks;
 #endif
-	    _master->run_timers(this);
+	    _timers.run_timers(this, _master);
 #if CLICK_NS
 	    // If there's another timer, tell the simulator to make us
 	    // run when it's due to go off.
-	    if (Timestamp next_expiry = _master->next_timer_expiry()) {
+	    if (Timestamp next_expiry = _timers.timer_expiry()) {
 		struct timeval nexttime = next_expiry.timeval();
 		simclick_sim_command(_master->simnode(), SIMCLICK_SCHEDULE, &nexttime);
 	    }
@@ -550,8 +563,8 @@ RouterThread::driver()
     }
 
     // run task requests (1)
-    if (_any_pending)
-	_master->process_pending(this);
+    if (_pending_head.value())
+	process_pending();
 
 #if !HAVE_ADAPTIVE_SCHEDULER
     // run a bunch of tasks
@@ -598,6 +611,7 @@ RouterThread::driver()
   finish_driver:
 #endif
     driver_unlock_tasks();
+    _master->epoch_offline(this);
 
 #if HAVE_ADAPTIVE_SCHEDULER
     _cur_click_share = 0;
@@ -606,6 +620,7 @@ RouterThread::driver()
     _linux_task = 0;
 #elif HAVE_MULTITHREAD
     _running_processor = click_invalid_processor();
+    _current = 0;
 #endif
 }
 
@@ -627,25 +642,98 @@ RouterThread::driver_once()
     _linux_task = current;
 #elif HAVE_MULTITHREAD
     _running_processor = click_current_processor();
-#endif
+    RouterThread *old_current = _current;
+    _current = this;
+#endif
+    // driver_once() may be called from element code already running on this
+    // thread; only a thread that was not running elements is quiescent here
+    bool was_offline = !_epoch;
+    if (was_offline)
+	_master->epoch_quiescent(this);
     driver_lock_tasks();
 
     Task *t = task_begin();
-    if (t != task_end() && !t->_pending_nextptr) {
+    if (t != task_end() && !t->_pending.value()) {
 	t->fast_unschedule(false);
 	t->fire();
     }
 
     driver_unlock_tasks();
+    if (was_offline)
+	_master->epoch_offline(this);
 #if CLICK_BSDMODULE  /* XXX MARKO */
     splx(s);
 #elif CLICK_LINUXMODULE
     _linux_task = 0;
 #elif HAVE_MULTITHREAD
     _running_processor = click_invalid_processor();
+    _current = old_current;
 #endif
 }
 
+
+// PENDING TASKS
+
+void
+RouterThread::process_pending()
+{
+    // must be called with this thread's lock acquired
+
+    set_thread_state(S_RUNPENDING);
+    if (_master->paused())
+	return;
+
+    // claim the current pending list, then reverse it so tasks are processed
+    // in the order they were added
+    Task *t = _pending_head.swap(0), *my_pending = 0;
+    while (t) {
+	Task *next = t->_pending_next;
+	t->_pending_next = my_pending;
+	my_pending = t;
+	t = next;
+    }
+
+    // process the list
+    while ((t = my_pending)) {
+	my_pending = t->_pending_next;
+	t->_pending_next = 0;
+	t->_pending = 0;
+#if HAVE_MULTITHREAD
+	click_fence();
+#endif
+	t->process_pending(this);
+    }
+}
+
+void
+RouterThread::remove_pending(Task *task)
+{
+    // Pushes only ever change _pending_head, and only this thread's driver
+    // (which holds the task lock) pops, so interior links are stable here.
+    lock_tasks();
+    while (1) {
+	Task *head = _pending_head.value();
+	if (head == task) {
+	    if (!_pending_head.compare_and_swap(task, task->_pending_next))
+		continue;
+	    goto found;
+	}
+	for (Task *t = head; t; t = t->_pending_next)
+	    if (t->_pending_next == task) {
+		t->_pending_next = task->_pending_next;
+		goto found;
+	    }
+	break;
+    }
+    unlock_tasks();
+    return;
+
+ found:
+    task->_pending_next = 0;
+    task->_pending = 0;
+    unlock_tasks();
+}
+
 void
 RouterThread::unschedule_router_tasks(Router* r)
 {
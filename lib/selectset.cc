@@ -0,0 +1,729 @@
+// -*- c-basic-offset: 4; related-file-name: "../include/click/selectset.hh" -*-
+/*
+ * selectset.{cc,hh} -- per-thread file descriptor selection
+ * Eddie Kohler
+ *
+ * Copyright (c) 2003-7 The Regents of the University of California
+ * Copyright (c) 2010 Intel Corporation
+ * Copyright (c) 2008-2010 Meraki, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include <click/selectset.hh>
+#include <click/master.hh>
+#include <click/element.hh>
+#include <click/routerthread.hh>
+#include <click/timestamp.hh>
+#if HAVE_SYS_EVENT_H && HAVE_KQUEUE
+# include <sys/event.h>
+# if HAVE_EV_SET_UDATA_POINTER
+#  define EV_SET_UDATA_CAST	(void *)
+# else
+#  define EV_SET_UDATA_CAST	/* nothing */
+# endif
+#endif
+#if HAVE_USE_EPOLL
+# include <sys/epoll.h>
+# include <fcntl.h>
+#endif
+CLICK_DECLS
+
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+enum { POLLIN = Element::SELECT_READ, POLLOUT = Element::SELECT_WRITE };
+#endif
+
+namespace {
+enum { SELECT_READ = Element::SELECT_READ, SELECT_WRITE = Element::SELECT_WRITE };
+}
+
+SelectSet::SelectSet(RouterThread *thread)
+    : _thread(thread)
+{
+#if HAVE_USE_KQUEUE
+    _kqueue = kqueue();
+#endif
+#if HAVE_USE_EPOLL
+    _epoll = epoll_create(64);
+    if (_epoll >= 0)
+	fcntl(_epoll, F_SETFD, FD_CLOEXEC);
+# if HAVE_MULTITHREAD
+    _epoll_wake_registered = false;
+# endif
+#endif
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+    FD_ZERO(&_read_select_fd_set);
+    FD_ZERO(&_write_select_fd_set);
+    _max_select_fd = -1;
+#endif
+    assert(!_pollfds.size() && !_element_selectors.size());
+    // Add a null 'struct pollfd', then take it off. This ensures that
+    // _pollfds.begin() is nonnull, preventing crashes on Mac OS X
+    struct pollfd dummy;
+    dummy.events = dummy.fd = 0;
+#if HAVE_POLL_H && !HAVE_USE_SELECT
+    dummy.revents = 0;
+#endif
+    _pollfds.push_back(dummy);
+    _pollfds.clear();
+}
+
+SelectSet::~SelectSet()
+{
+#if HAVE_USE_KQUEUE
+    if (_kqueue >= 0)
+	close(_kqueue);
+#endif
+#if HAVE_USE_EPOLL
+    if (_epoll >= 0)
+	close(_epoll);
+#endif
+}
+
+#if HAVE_USE_EPOLL
+void
+SelectSet::epoll_update(int fd, int old_events, int new_events)
+{
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = (new_events & POLLIN ? EPOLLIN : 0)
+	| (new_events & POLLOUT ? EPOLLOUT : 0);
+    ev.data.fd = fd;
+    int op;
+    if (!old_events)
+	op = EPOLL_CTL_ADD;
+    else if (new_events)
+	op = EPOLL_CTL_MOD;
+    else
+	op = EPOLL_CTL_DEL;
+    if (epoll_ctl(_epoll, op, fd, &ev) < 0 && op != EPOLL_CTL_DEL) {
+	// Not all file descriptors are epollable (regular files, for
+	// example).  So if we encounter a problem, fall back to poll().
+	close(_epoll);
+	_epoll = -1;
+    }
+}
+#endif
+
+void
+SelectSet::register_select(int fd, bool add_read, bool add_write)
+{
+    // add the pollfd
+    if (fd >= _fd_to_pollfd.size())
+	_fd_to_pollfd.resize(fd + 1, -1);
+    if (_fd_to_pollfd[fd] < 0) {
+	_fd_to_pollfd[fd] = _pollfds.size();
+	_pollfds.push_back(pollfd());
+	_pollfds.back().fd = fd;
+	_pollfds.back().events = 0;
+    }
+    int pi = _fd_to_pollfd[fd];
+#if HAVE_USE_EPOLL
+    int old_events = _pollfds[pi].events;
+#endif
+
+    // add the elements
+    if (add_read)
+	_pollfds[pi].events |= POLLIN;
+    if (add_write)
+	_pollfds[pi].events |= POLLOUT;
+
+#if HAVE_USE_EPOLL
+    if (_epoll >= 0 && _pollfds[pi].events != old_events)
+	epoll_update(fd, old_events, _pollfds[pi].events);
+#endif
+
+#if HAVE_USE_KQUEUE
+    if (_kqueue >= 0) {
+	// Add events to the kqueue
+	struct kevent kev[2];
+	int nkev = 0;
+	if (add_read) {
+	    EV_SET(&kev[nkev], fd, EVFILT_READ, EV_ADD, 0, 0, EV_SET_UDATA_CAST ((intptr_t) 0));
+	    nkev++;
+	}
+	if (add_write) {
+	    EV_SET(&kev[nkev], fd, EVFILT_WRITE, EV_ADD, 0, 0, EV_SET_UDATA_CAST ((intptr_t) 0));
+	    nkev++;
+	}
+	int r = kevent(_kqueue, &kev[0], nkev, 0, 0, 0);
+	if (r < 0) {
+	    // Not all file descriptors are kqueueable.  So if we encounter
+	    // a problem, fall back to select() or poll().
+	    close(_kqueue);
+	    _kqueue = -1;
+	}
+    }
+#endif
+
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+    // Add 'mask' to the fd_sets
+    if (fd < FD_SETSIZE) {
+	if (add_read)
+	    FD_SET(fd, &_read_select_fd_set);
+	if (add_write)
+	    FD_SET(fd, &_write_select_fd_set);
+	if (fd > _max_select_fd)
+	    _max_select_fd = fd;
+    } else {
+	static int warned = 0;
+# if HAVE_USE_KQUEUE
+	if (_kqueue < 0)
+# endif
+	    if (!warned) {
+		click_chatter("SelectSet::add_select(%d): fd >= FD_SETSIZE", fd);
+		warned = 1;
+	    }
+    }
+#endif
+
+    // ensure the element selector exists
+    if (fd >= _element_selectors.size())
+	_element_selectors.resize(fd + 1);
+}
+
+int
+SelectSet::add_select(int fd, Element *element, int mask)
+{
+    if (fd < 0)
+	return -1;
+    if (mask == 0)
+	return 0;
+    assert(element && (mask & ~(SELECT_READ | SELECT_WRITE)) == 0);
+    _select_lock.acquire();
+
+    // check whether to add readability, writability, or both; it is an error
+    // for more than one element to wait on the same fd for the same status
+    bool add_read = false, add_write = false;
+    if (mask & SELECT_READ) {
+	if (fd >= _element_selectors.size() || !_element_selectors[fd].read)
+	    add_read = true;
+	else if (_element_selectors[fd].read != element) {
+	unlock_and_return_error:
+	    _select_lock.release();
+	    return -1;
+	}
+    }
+    if (mask & SELECT_WRITE) {
+	if (fd >= _element_selectors.size() || !_element_selectors[fd].write)
+	    add_write = true;
+	else if (_element_selectors[fd].write != element)
+	    goto unlock_and_return_error;
+    }
+    if (!add_read && !add_write) {
+	_select_lock.release();
+	return 0;
+    }
+
+    // add the pollfd
+    register_select(fd, add_read, add_write);
+
+    // add the elements
+    if (add_read)
+	_element_selectors[fd].read = element;
+    if (add_write)
+	_element_selectors[fd].write = element;
+
+#if HAVE_MULTITHREAD
+    // need to wake up the thread since there's more to select
+    _thread->wake();
+#endif
+
+    _select_lock.release();
+    return 0;
+}
+
+void
+SelectSet::remove_pollfd(int pi, int event)
+{
+    assert(event == POLLIN || event == POLLOUT);
+
+    // remove event
+    int fd = _pollfds[pi].fd;
+#if HAVE_USE_EPOLL
+    int old_events = _pollfds[pi].events;
+#endif
+    _pollfds[pi].events &= ~event;
+    if (event == POLLIN)
+	_element_selectors[fd].read = 0;
+    else
+	_element_selectors[fd].write = 0;
+
+#if HAVE_USE_KQUEUE
+    // remove event from kqueue
+    if (_kqueue >= 0) {
+	struct kevent kev;
+	EV_SET(&kev, fd, (event == POLLIN ? EVFILT_READ : EVFILT_WRITE), EV_DELETE, 0, 0, EV_SET_UDATA_CAST ((intptr_t) 0));
+	int r = kevent(_kqueue, &kev, 1, 0, 0, 0);
+	if (r < 0)
+	    click_chatter("SelectSet::remove_pollfd(fd %d): kevent: %s", _pollfds[pi].fd, strerror(errno));
+    }
+#endif
+#if HAVE_USE_EPOLL
+    if (_epoll >= 0 && _pollfds[pi].events != old_events)
+	epoll_update(fd, old_events, _pollfds[pi].events);
+#endif
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+    // remove event from select list
+    if (fd < FD_SETSIZE) {
+	fd_set *fd_ptr = (event == POLLIN ? &_read_select_fd_set : &_write_select_fd_set);
+	FD_CLR(fd, fd_ptr);
+    }
+#endif
+
+    // exit unless there are no events left
+    if (_pollfds[pi].events)
+	return;
+
+    // remove whole pollfd
+    _pollfds[pi] = _pollfds.back();
+    _pollfds.pop_back();
+    _fd_to_pollfd[fd] = -1;
+    if (pi < _pollfds.size())
+	_fd_to_pollfd[_pollfds[pi].fd] = pi;
+#if !HAVE_POLL_H || HAVE_USE_SELECT
+    if (fd == _max_select_fd) {
+	_max_select_fd = -1;
+	for (int pix = 0; pix < _pollfds.size(); ++pix)
+	    if (_pollfds[pix].fd < FD_SETSIZE
+		&& _pollfds[pix].fd > _max_select_fd)
+		_max_select_fd = _pollfds[pix].fd;
+    }
+#endif
+}
+
+int
+SelectSet::remove_select(int fd, Element *element, int mask)
+{
+    if (fd < 0)
+	return -1;
+    assert(element && (mask & ~(SELECT_READ | SELECT_WRITE)) == 0);
+    _select_lock.acquire();
+
+    bool remove_read = false, remove_write = false;
+    if ((mask & SELECT_READ) && fd < _element_selectors.size()
+	&& _element_selectors[fd].read == element)
+	remove_read = true;
+    if ((mask & SELECT_WRITE) && fd < _element_selectors.size()
+	&& _element_selectors[fd].write == element)
+	remove_write = true;
+    if (!remove_read && !remove_write) {
+	_select_lock.release();
+	return -1;
+    }
+
+    int pi = _fd_to_pollfd[fd];
+    if (remove_read)
+	remove_pollfd(pi, POLLIN);
+    if (remove_write)
+	remove_pollfd(pi, POLLOUT);
+    _select_lock.release();
+    return 0;
+}
+
+void
+SelectSet::kill_router(Router *router)
+{
+    _select_lock.acquire();
+    for (int pi = 0; pi < _pollfds.size(); pi++) {
+	int fd = _pollfds[pi].fd;
+	// take components out of the arrays early
+	if (fd < _element_selectors.size()) {
+	    ElementSelector &es = _element_selectors.at_u(fd);
+	    if (es.read && es.read->router() == router)
+		remove_pollfd(pi, POLLIN);
+	    if (es.write && es.write->router() == router)
+		remove_pollfd(pi, POLLOUT);
+	}
+	if (pi < _pollfds.size() && _pollfds[pi].fd != fd)
+	    pi--;
+    }
+    _select_lock.release();
+}
+
+
+inline void
+SelectSet::call_selected(int fd, int mask) const
+{
+    if ((unsigned) fd < (unsigned) _element_selectors.size()) {
+	const ElementSelector &es = _element_selectors[fd];
+	Element *read = (mask & Element::SELECT_READ ? es.read : 0);
+	Element *write = (mask & Element::SELECT_WRITE ? es.write : 0);
+	if (read)
+	    read->selected(fd, write == read ? mask : Element::SELECT_READ);
+	if (write && write != read)
+	    write->selected(fd, Element::SELECT_WRITE);
+    }
+}
+
+inline int
+SelectSet::next_timer_delay(bool more_tasks, Timestamp &t) const
+{
+#if CLICK_NS
+    // The simulator should never block.
+    (void) more_tasks, (void) t;
+    return 0;
+#else
+    if (more_tasks || Master::signals_pending)
+	return 0;
+    t = _thread->timer_set().timer_expiry_adjusted();
+    if (t.sec() == 0)
+	return -1;		// block forever
+    else if (unlikely(Timestamp::warp_jumping())) {
+	Timestamp::warp_jump(t);
+	return 0;
+    } else if ((t -= Timestamp::now(), t.sec() >= 0)) {
+	t = t.warp_real_delay();
+	return 1;
+    } else
+	return 0;
+#endif
+}
+
+#if HAVE_USE_KQUEUE
+static int
+kevent_compare(const void *ap, const void *bp, void *)
+{
+    const struct kevent *a = static_cast<const struct kevent *>(ap);
+    const struct kevent *b = static_cast<const struct kevent *>(bp);
+    int afd = (int) a->ident, bfd = (int) b->ident;
+    return afd - bfd;
+}
+
+void
+SelectSet::run_selects_kqueue(bool more_tasks)
+{
+# if HAVE_MULTITHREAD
+    _select_lock.release();
+
+    struct kevent wp_kev;
+    EV_SET(&wp_kev, _thread->_wake_pipe[0], EVFILT_READ, EV_ADD, 0, 0, EV_SET_UDATA_CAST ((intptr_t) 0));
+    (void) kevent(_kqueue, &wp_kev, 1, 0, 0, 0);
+# endif
+
+    // Decide how long to wait.
+    struct timespec wait, *wait_ptr = &wait;
+    Timestamp t;
+    int delay_type = next_timer_delay(more_tasks, t);
+    if (delay_type == 0)
+	wait.tv_sec = wait.tv_nsec = 0;
+    else if (delay_type > 0)
+	wait = t.timespec();
+    else
+	wait_ptr = 0;
+    _thread->set_thread_state_for_blocking(delay_type);
+    _thread->master()->epoch_offline(_thread);
+
+    struct kevent kev[256];
+    int n = kevent(_kqueue, 0, 0, &kev[0], 256, wait_ptr);
+    int was_errno = errno;
+    _thread->master()->epoch_quiescent(_thread);
+    _thread->master()->run_signals(_thread);
+
+# if HAVE_MULTITHREAD
+    _thread->set_thread_state(RouterThread::S_LOCKSELECT);
+    _select_lock.acquire();
+    click_fence();
+    _thread->_select_blocked = false;
+
+    _thread->set_thread_state(RouterThread::S_RUNSELECT);
+    wp_kev.flags = EV_DELETE;
+    (void) kevent(_kqueue, &wp_kev, 1, 0, 0, 0);
+# else
+    _thread->set_thread_state(RouterThread::S_RUNSELECT);
+# endif
+
+    if (n < 0 && was_errno != EINTR)
+	perror("kevent");
+    else if (n > 0) {
+	click_qsort(&kev[0], n, sizeof(struct kevent), kevent_compare, 0);
+	for (struct kevent *p = &kev[0]; p < &kev[n]; ) {
+	    int fd = (int) p->ident, mask = 0;
+	    for (; (int) p->ident == fd; ++p)
+		if (p->filter == EVFILT_READ)
+		    mask |= Element::SELECT_READ;
+		else if (p->filter == EVFILT_WRITE)
+		    mask |= Element::SELECT_WRITE;
+	    call_selected(fd, mask);
+	}
+    }
+}
+#endif /* HAVE_USE_KQUEUE */
+
+#if HAVE_USE_EPOLL
+void
+SelectSet::run_selects_epoll(bool more_tasks)
+{
+# if HAVE_MULTITHREAD
+    // The wake pipe stays registered.  It is edge-triggered because
+    // Master::process_signals() always drains it completely.
+    if (!_epoll_wake_registered) {
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.fd = _thread->_wake_pipe[0];
+	if (epoll_ctl(_epoll, EPOLL_CTL_ADD, _thread->_wake_pipe[0], &ev) < 0) {
+	    close(_epoll);
+	    _epoll = -1;
+# if HAVE_POLL_H && !HAVE_USE_SELECT
+	    run_selects_poll(more_tasks);
+# else
+	    run_selects_select(more_tasks);
+# endif
+	    return;
+	}
+	_epoll_wake_registered = true;
+    }
+    _select_lock.release();
+# endif
+
+    // Decide how long to wait.
+    int timeout;
+    Timestamp t;
+    int delay_type = next_timer_delay(more_tasks, t);
+    if (delay_type == 0)
+	timeout = 0;
+    else if (delay_type > 0)
+	timeout = (t.sec() >= INT_MAX / 1000 ? INT_MAX - 1000 : t.msecval());
+    else
+	timeout = -1;
+    _thread->set_thread_state_for_blocking(delay_type);
+    _thread->master()->epoch_offline(_thread);
+
+    struct epoll_event evs[256];
+    int n = epoll_wait(_epoll, &evs[0], 256, timeout);
+    int was_errno = errno;
+    _thread->master()->epoch_quiescent(_thread);
+    _thread->master()->run_signals(_thread);
+
+# if HAVE_MULTITHREAD
+    _thread->set_thread_state(RouterThread::S_LOCKSELECT);
+    _select_lock.acquire();
+    click_fence();
+    _thread->_select_blocked = false;
+# endif
+    _thread->set_thread_state(RouterThread::S_RUNSELECT);
+
+    // Each file descriptor appears at most once in the result, and
+    // call_selected() looks up its elements directly, so dispatch costs O(1)
+    // per ready file descriptor.  An earlier selected() call may have removed
+    // a later file descriptor; call_selected() then finds no element.
+    if (n < 0 && was_errno != EINTR)
+	perror("epoll_wait");
+    else if (n > 0)
+	for (struct epoll_event *p = &evs[0]; p < &evs[n]; ++p) {
+	    int mask = (p->events & ~EPOLLOUT ? Element::SELECT_READ : 0)
+		+ (p->events & ~EPOLLIN ? Element::SELECT_WRITE : 0);
+	    call_selected(p->data.fd, mask);
+	}
+}
+#endif /* HAVE_USE_EPOLL */
+
+#if HAVE_POLL_H && !HAVE_USE_SELECT
+void
+SelectSet::run_selects_poll(bool more_tasks)
+{
+# if HAVE_MULTITHREAD
+    // Need a private copy of _pollfds, since other threads may run while we
+    // block
+    Vector<struct pollfd> my_pollfds(_pollfds);
+    _select_lock.release();
+
+    pollfd wake_pollfd;
+    wake_pollfd.fd = _thread->_wake_pipe[0];
+    wake_pollfd.events = POLLIN;
+    my_pollfds.push_back(wake_pollfd);
+# else
+    Vector<struct pollfd> &my_pollfds(_pollfds);
+# endif
+
+    // Decide how long to wait.
+    int timeout;
+    Timestamp t;
+    int delay_type = next_timer_delay(more_tasks, t);
+    if (delay_type == 0)
+	timeout = 0;
+    else if (delay_type > 0)
+	timeout = (t.sec() >= INT_MAX / 1000 ? INT_MAX - 1000 : t.msecval());
+    else
+	timeout = -1;
+    _thread->set_thread_state_for_blocking(delay_type);
+    _thread->master()->epoch_offline(_thread);
+
+    int n = poll(my_pollfds.begin(), my_pollfds.size(), timeout);
+    int was_errno = errno;
+    _thread->master()->epoch_quiescent(_thread);
+    _thread->master()->run_signals(_thread);
+
+# if HAVE_MULTITHREAD
+    _thread->set_thread_state(RouterThread::S_LOCKSELECT);
+    _select_lock.acquire();
+    click_fence();
+    _thread->_select_blocked = false;
+    // the wake pipe was handled by run_signals()
+    my_pollfds.pop_back();
+# endif
+    _thread->set_thread_state(RouterThread::S_RUNSELECT);
+
+    if (n < 0 && was_errno != EINTR)
+	perror("poll");
+    else if (n > 0)
+	for (struct pollfd *p = my_pollfds.begin(); p < my_pollfds.end(); p++)
+	    if (p->revents) {
+		int pi = p - my_pollfds.begin();
+
+		// Beware: calling 'selected()' might call remove_select(),
+		// causing disaster! Load everything we need out of the
+		// vectors before calling out.
+
+		int fd = p->fd;
+		int mask = (p->revents & ~POLLOUT ? Element::SELECT_READ : 0)
+		    + (p->revents & ~POLLIN ? Element::SELECT_WRITE : 0);
+		call_selected(fd, mask);
+
+		// 31.Oct.2003 - Peter Swain: _pollfds may have grown or
+		// shrunk!
+		p = my_pollfds.begin() + pi;
+		if (p < my_pollfds.end() && fd != p->fd)
+		    p--;
+	    }
+}
+
+#else /* !HAVE_POLL_H || HAVE_USE_SELECT */
+void
+SelectSet::run_selects_select(bool more_tasks)
+{
+    fd_set read_mask = _read_select_fd_set;
+    fd_set write_mask = _write_select_fd_set;
+    int n_select_fd = _max_select_fd + 1;
+
+# if HAVE_MULTITHREAD
+    _select_lock.release();
+
+    FD_SET(_thread->_wake_pipe[0], &read_mask);
+    if (_thread->_wake_pipe[0] >= n_select_fd)
+	n_select_fd = _thread->_wake_pipe[0] + 1;
+# endif
+
+    // Decide how long to wait.
+    struct timeval wait, *wait_ptr = &wait;
+    Timestamp t;
+    int delay_type = next_timer_delay(more_tasks, t);
+    if (delay_type == 0)
+	timerclear(&wait);
+    else if (delay_type > 0)
+	wait = t.timeval();
+    else
+	wait_ptr = 0;
+    _thread->set_thread_state_for_blocking(delay_type);
+    _thread->master()->epoch_offline(_thread);
+
+    int n = select(n_select_fd, &read_mask, &write_mask, (fd_set*) 0, wait_ptr);
+    int was_errno = errno;
+    _thread->master()->epoch_quiescent(_thread);
+    _thread->master()->run_signals(_thread);
+
+# if HAVE_MULTITHREAD
+    _thread->set_thread_state(RouterThread::S_LOCKSELECT);
+    _select_lock.acquire();
+    click_fence();
+    _thread->_select_blocked = false;
+# endif
+    _thread->set_thread_state(RouterThread::S_RUNSELECT);
+
+    if (n < 0 && was_errno != EINTR)
+	perror("select");
+    else if (n > 0)
+	for (struct pollfd *p = _pollfds.begin(); p < _pollfds.end(); p++)
+	    if (p->fd >= FD_SETSIZE || FD_ISSET(p->fd, &read_mask)
+		|| FD_ISSET(p->fd, &write_mask)) {
+		int pi = p - _pollfds.begin();
+
+		// Beware: calling 'selected()' might call remove_select(),
+		// causing disaster! Load everything we need out of the
+		// vectors before calling out.
+
+		int fd = p->fd;
+		int mask = (fd >= FD_SETSIZE || FD_ISSET(fd, &read_mask) ? Element::SELECT_READ : 0)
+		    + (fd >= FD_SETSIZE || FD_ISSET(fd, &write_mask) ? Element::SELECT_WRITE : 0);
+		call_selected(fd, mask);
+
+		// 31.Oct.2003 - Peter Swain: _pollfds may have grown or
+		// shrunk!
+		p = _pollfds.begin() + pi;
+		if (p < _pollfds.end() && fd != p->fd)
+		    p--;
+	    }
+}
+#endif /* HAVE_POLL_H && !HAVE_USE_SELECT */
+
+void
+SelectSet::run_selects()
+{
+    // Wait in select() for input or timer, and call relevant elements'
+    // selected() methods.
+
+    if (!_select_lock.attempt())
+	return;
+
+#if HAVE_MULTITHREAD
+    // set _select_blocked to true first: then, if someone else is
+    // concurrently waking us up, we will either detect that the thread is now
+    // active(), or wake up on the write to the thread's _wake_pipe
+    _thread->_select_blocked = true;
+    click_fence();
+#endif
+
+    bool more_tasks = _thread->active();
+
+    // Return early if paused.
+    if (_thread->master()->paused()) {
+#if HAVE_MULTITHREAD
+	_thread->_select_blocked = false;
+#endif
+	goto unlock_exit;
+    }
+
+    // Return early (just run signals) if there are no selectors and there are
+    // tasks to run.
+    if (_pollfds.size() == 0 && more_tasks) {
+	_thread->master()->run_signals(_thread);
+#if HAVE_MULTITHREAD
+	_thread->_select_blocked = false;
+#endif
+	goto unlock_exit;
+    }
+
+    // Call the relevant selector implementation.
+#if HAVE_USE_KQUEUE
+    if (_kqueue >= 0) {
+	run_selects_kqueue(more_tasks);
+	goto unlock_exit;
+    }
+#endif
+#if HAVE_USE_EPOLL
+    if (_epoll >= 0) {
+	run_selects_epoll(more_tasks);
+	goto unlock_exit;
+    }
+#endif
+#if HAVE_POLL_H && !HAVE_USE_SELECT
+    run_selects_poll(more_tasks);
+#else
+    run_selects_select(more_tasks);
+#endif
+
+ unlock_exit:
+    _select_lock.release();
+}
+
+CLICK_ENDDECLS
@@ -89,8 +89,9 @@ CLICK_DECLS
 
 // - Changes to _thread are protected by _thread->lock.
 // - Resetting _should_be_scheduled to 0 is protected by _thread->lock.
-// - Changes to _home_thread_id are protected by
-//   router()->master()->task_lock.
+// - A task joins a thread's pending list only after changing _pending from
+//   0 to 1, so it is on at most one list at a time.  The list's thread
+//   resets _pending to 0 as it processes the task.
 
 bool
 Task::error_hook(Task *, void *)
@@ -102,10 +103,10 @@ Task::error_hook(Task *, void *)
 Task::~Task()
 {
 #if HAVE_TASK_HEAP
-    if (scheduled() || _pending_nextptr)
+    if (scheduled() || _pending.value())
 	cleanup();
 #else
-    if ((scheduled() || _pending_nextptr) && _thread != this)
+    if ((scheduled() || _pending.value()) && _thread != this)
 	cleanup();
 #endif
 }
@@ -161,34 +162,15 @@ Task::cleanup()
     if (initialized()) {
 	strong_unschedule();
 
-	if (_pending_nextptr) {
-	    // Perhaps the task is enqueued on the current pending collection.
-	    // If so, remove it.
+	if (_pending.value()) {
+	    // The task is on some thread's pending list, or another thread is
+	    // about to add it to one.  Remove it.  Processing a pending list
+	    // will NEVER cause a task to get deleted, so ~Task is never called
+	    // from RouterThread::process_pending().
 	    Master *m = _owner->master();
-	    SpinlockIRQ::flags_t flags = m->_master_task_lock.acquire();
-	    if (_pending_nextptr) {
-		volatile uintptr_t *tptr = &m->_pending_head;
-		while (Task *t = pending_to_task(*tptr))
-		    if (t == this) {
-			*tptr = _pending_nextptr;
-			if (!pending_to_task(_pending_nextptr))
-			    m->_pending_tail = tptr;
-			_pending_nextptr = 0;
-			break;
-		    } else
-			tptr = &t->_pending_nextptr;
-	    }
-	    m->_master_task_lock.release(flags);
-
-	    // If not on the current pending list, perhaps this task is on
-	    // some list currently being processed by
-	    // Master::process_pending().  Wait until that processing is done.
-	    // It is safe to simply spin because pending list processing is so
-	    // simple: processing a pending list will NEVER cause a task to
-	    // get deleted, so ~Task is never called from
-	    // Master::process_pending().
-	    while (_pending_nextptr)
-		/* do nothing */;
+	    while (_pending.value())
+		for (int tid = 0; tid < m->nthreads() && _pending.value(); ++tid)
+		    m->thread(tid)->remove_pending(this);
 	}
 
 	_owner = 0;
@@ -220,20 +202,25 @@ Task::attempt_lock_tasks()
     return false;
 }
 
+RouterThread *
+Task::pending_thread() const
+{
+    // Quiescent threads never run, so tasks on quiescent threads go on their
+    // home thread's list, or thread 0's list if that thread is quiescent too.
+    if (_thread->thread_id() >= 0)
+	return _thread;
+    Master *m = _thread->master();
+    RouterThread *t = m->thread(_home_thread_id);
+    return t->thread_id() >= 0 ? t : m->thread(0);
+}
+
 void
 Task::add_pending()
 {
     Router *router = _owner->router();
-    Master *m = router->master();
-    SpinlockIRQ::flags_t flags = m->_master_task_lock.acquire();
     if (router->_running >= Router::RUNNING_PREPARING
-	&& !_pending_nextptr) {
-	*m->_pending_tail = reinterpret_cast<uintptr_t>(this);
-	m->_pending_tail = &_pending_nextptr;
-	_pending_nextptr = 1;
-	_thread->add_pending();
-    }
-    m->_master_task_lock.release(flags);
+	&& _pending.compare_and_swap(0, 1))
+	pending_thread()->add_pending(this);
 }
 
 void
@@ -192,40 +192,58 @@ Timer::task_hook(Timer *, void *thunk)
 
 
 Timer::Timer()
-    : _schedpos1(0), _thunk(0), _owner(0)
+    : _schedpos1(0), _thunk(0), _owner(0), _thread(0)
 {
     _hook.callback = do_nothing_hook;
 }
 
 Timer::Timer(const do_nothing_t &)
-    : _schedpos1(0), _thunk((void *) 1), _owner(0)
+    : _schedpos1(0), _thunk((void *) 1), _owner(0), _thread(0)
 {
     _hook.callback = do_nothing_hook;
 }
 
 Timer::Timer(TimerCallback f, void *user_data)
-    : _schedpos1(0), _thunk(user_data), _owner(0)
+    : _schedpos1(0), _thunk(user_data), _owner(0), _thread(0)
 {
     _hook.callback = f;
 }
 
 Timer::Timer(Element* element)
-    : _schedpos1(0), _thunk(element), _owner(0)
+    : _schedpos1(0), _thunk(element), _owner(0), _thread(0)
 {
     _hook.callback = element_hook;
 }
 
 Timer::Timer(Task* task)
-    : _schedpos1(0), _thunk(task), _owner(0)
+    : _schedpos1(0), _thunk(task), _owner(0), _thread(0)
 {
     _hook.callback = task_hook;
 }
 
 Timer::Timer(const Timer &x)
-    : _schedpos1(0), _hook(x._hook), _thunk(x._thunk), _owner(0)
+    : _schedpos1(0), _hook(x._hook), _thunk(x._thunk), _owner(0), _thread(0)
 {
 }
 
+void
+Timer::initialize(Element *owner, bool quiet)
+{
+    assert(!initialized() || _owner->router() == owner->router());
+    if (_owner != owner) {
+	// move a scheduled timer to the new owner's thread
+	bool was_scheduled = scheduled();
+	if (was_scheduled)
+	    unschedule();
+	_owner = owner;
+	_thread = owner->router()->home_thread(owner);
+	if (was_scheduled)
+	    schedule_at(_expiry);
+    }
+    if (unlikely(_hook.callback == do_nothing_hook && !_thunk) && !quiet)
+	click_chatter("initializing Timer %{element} [%p], which does nothing", _owner, this);
+}
+
 void
 Timer::initialize(Router *router)
 {
@@ -237,35 +255,49 @@ Timer::schedule_at(const Timestamp& when)
 {
     // acquire lock, unschedule
     assert(_owner && initialized());
-    Master* master = _owner->master();
-    master->lock_timers();
+    TimerSet &ts = _thread->timer_set();
+    ts.lock_timers();
 
     // set expiration timer
     _expiry = when;
-
+#if HAVE_TIMER_WHEEL
+    if (_schedpos1 > 0)
+	ts.wheel_remove(this);
+    else if (_schedpos1 < 0)
+	ts._timer_runchunk[-_schedpos1 - 1] = 0;
+    ts.check_timer_expiry(this);
+    ts.wheel_insert(this);
+
+    // if we changed the timeout, wake up the timer's thread
+    if (!ts._timer_expiry || _expiry < ts._timer_expiry) {
+	ts._timer_expiry = _expiry;
+	_thread->wake();
+    }
+#else
     // manipulate list; this is essentially a "decrease-key" operation
     // any reschedule removes a timer from the runchunk (XXX -- even backwards
     // reschedulings)
     int old_schedpos1 = _schedpos1;
     if (_schedpos1 <= 0) {
 	if (_schedpos1 < 0)
-	    master->_timer_runchunk[-_schedpos1 - 1] = 0;
-	_schedpos1 = master->_timer_heap.size() + 1;
-	master->_timer_heap.push_back(this);
+	    ts._timer_runchunk[-_schedpos1 - 1] = 0;
+	_schedpos1 = ts._timer_heap.size() + 1;
+	ts._timer_heap.push_back(this);
     }
-    master->check_timer_expiry(this);
-    change_heap(master->_timer_heap.begin(), master->_timer_heap.end(),
-		master->_timer_heap.begin() + _schedpos1 - 1,
-		Master::timer_less(), Master::timer_place(master->_timer_heap.begin()));
+    ts.check_timer_expiry(this);
+    change_heap(ts._timer_heap.begin(), ts._timer_heap.end(),
+		ts._timer_heap.begin() + _schedpos1 - 1,
+		TimerSet::timer_less(), TimerSet::timer_place(ts._timer_heap.begin()));
     if (old_schedpos1 == 1 || _schedpos1 == 1)
-	master->set_timer_expiry();
+	ts.set_timer_expiry();
 
-    // if we changed the timeout, wake up the first thread
+    // if we changed the timeout, wake up the timer's thread
     if (_schedpos1 == 1)
-	master->_threads[2]->wake();
+	_thread->wake();
+#endif
 
     // done
-    master->unlock_timers();
+    ts.unlock_timers();
 }
 
 void
@@ -279,22 +311,29 @@ Timer::unschedule()
 {
     if (!scheduled())
 	return;
-    Master* master = _owner->master();
-    master->lock_timers();
+    TimerSet &ts = _thread->timer_set();
+    ts.lock_timers();
+#if HAVE_TIMER_WHEEL
+    // A stale _timer_expiry only makes the thread wake early.
+    if (_schedpos1 > 0)
+	ts.wheel_remove(this);
+#else
     int old_schedpos1 = _schedpos1;
     if (_schedpos1 > 0) {
-	remove_heap(master->_timer_heap.begin(), master->_timer_heap.end(),
-		    master->_timer_heap.begin() + _schedpos1 - 1,
-		    Master::timer_less(), Master::timer_place(master->_timer_heap.begin()));
-	master->_timer_heap.pop_back();
+	remove_heap(ts._timer_heap.begin(), ts._timer_heap.end(),
+		    ts._timer_heap.begin() + _schedpos1 - 1,
+		    TimerSet::timer_less(), TimerSet::timer_place(ts._timer_heap.begin()));
+	ts._timer_heap.pop_back();
 	if (old_schedpos1 == 1)
-	    master->set_timer_expiry();
-    } else if (_schedpos1 < 0)
-	master->_timer_runchunk[-_schedpos1 - 1] = 0;
+	    ts.set_timer_expiry();
+    }
+#endif
+    else if (_schedpos1 < 0)
+	ts._timer_runchunk[-_schedpos1 - 1] = 0;
     _schedpos1 = 0;
-    master->unlock_timers();
+    ts.unlock_timers();
 }
 
-// list-related functions in master.cc
+// list-related functions in timerset.cc
 
 CLICK_ENDDECLS
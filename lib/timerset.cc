@@ -0,0 +1,441 @@
+// -*- c-basic-offset: 4; related-file-name: "../include/click/timerset.hh" -*-
+/*
+ * timerset.{cc,hh} -- per-thread timer heaps
+ * Eddie Kohler
+ *
+ * Copyright (c) 2003-7 The Regents of the University of California
+ * Copyright (c) 2008-2010 Meraki, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, subject to the conditions
+ * listed in the Click LICENSE file. These conditions include: you must
+ * preserve this copyright notice, and you cannot mention the copyright
+ * holders in advertising related to the Software without their permission.
+ * The Software is provided WITHOUT ANY WARRANTY, EXPRESS OR IMPLIED. This
+ * notice is a summary of the Click LICENSE file; the license in that file is
+ * legally binding.
+ */
+
+#include <click/config.h>
+#include <click/timerset.hh>
+#include <click/master.hh>
+#include <click/routerthread.hh>
+#include <click/integers.hh>
+CLICK_DECLS
+
+TimerSet::TimerSet()
+{
+#if CLICK_NS
+    _max_timer_stride = 1;
+#else
+    _max_timer_stride = 32;
+#endif
+    _timer_stride = _max_timer_stride;
+    _timer_count = 0;
+#if CLICK_LINUXMODULE
+    spin_lock_init(&_timer_lock);
+    _timer_task = 0;
+#endif
+    _timer_check = Timestamp::now();
+    _timer_check_reports = 0;
+#if HAVE_TIMER_WHEEL
+    memset(_wheel, 0, sizeof(_wheel));
+    memset(_wheel_live, 0, sizeof(_wheel_live));
+    _wheel_now = _wheel_cascaded = wheel_tick(_timer_check);
+    _wheel_count = 0;
+#endif
+}
+
+void
+TimerSet::set_max_timer_stride(unsigned timer_stride)
+{
+    _max_timer_stride = timer_stride;
+    if (_timer_stride > _max_timer_stride)
+	_timer_stride = _max_timer_stride;
+}
+
+void
+TimerSet::check_timer_expiry(Timer *t)
+{
+    // do not schedule timers for too far in the past
+    if (t->_expiry.sec() + Timer::behind_sec < _timer_check.sec()) {
+	if (_timer_check_reports > 0) {
+	    --_timer_check_reports;
+	    click_chatter("timer %p outdated expiry %{timestamp} updated to %{timestamp}", t, &t->_expiry, &_timer_check, &t->_expiry);
+	}
+	t->_expiry = _timer_check;
+    }
+}
+
+#if HAVE_TIMER_WHEEL
+void
+TimerSet::wheel_insert(Timer *t)
+{
+    // Place @a t by how far its expiry tick is from the current tick, as in
+    // the classic BSD and Linux timing wheels.  Timers too far in the future
+    // land in the last level-3 slot; cascading will place them correctly.
+    wheel_tick_t tick = wheel_tick(t->_expiry);
+    if (tick < _wheel_now)
+	tick = _wheel_now;
+    wheel_tick_t delta = tick - _wheel_now;
+    int level = 0;
+    while (level < wheel_levels - 1
+	   && delta >= ((wheel_tick_t) 1 << (wheel_bits * (level + 1))))
+	++level;
+    if (level == wheel_levels - 1
+	&& delta >= ((wheel_tick_t) 1 << (wheel_bits * wheel_levels)))
+	tick = _wheel_now + ((wheel_tick_t) 1 << (wheel_bits * wheel_levels)) - 1;
+    int index = (tick >> (wheel_bits * level)) & wheel_mask;
+
+    Timer **slot = &_wheel[level][index];
+    t->_wheel_next = *slot;
+    if (*slot)
+	(*slot)->_wheel_pprev = &t->_wheel_next;
+    t->_wheel_pprev = slot;
+    *slot = t;
+    _wheel_live[level][index >> 5] |= 1U << (index & 31);
+    t->_schedpos1 = 1;
+    ++_wheel_count;
+}
+
+void
+TimerSet::wheel_remove(Timer *t)
+{
+    Timer **pprev = t->_wheel_pprev;
+    *pprev = t->_wheel_next;
+    if (t->_wheel_next)
+	t->_wheel_next->_wheel_pprev = pprev;
+    else if (pprev >= &_wheel[0][0]
+	     && pprev < &_wheel[0][0] + wheel_levels * wheel_size
+	     && !*pprev) {
+	// the slot is now empty
+	int pos = pprev - &_wheel[0][0];
+	_wheel_live[pos / wheel_size][(pos & wheel_mask) >> 5] &= ~(1U << (pos & 31));
+    }
+    --_wheel_count;
+}
+
+int
+TimerSet::wheel_next_slot(int level, int start) const
+{
+    // Return the distance from slot @a start to the next nonempty slot at
+    // @a level, wrapping around, or -1 if the level is empty.
+    const uint32_t *live = _wheel_live[level];
+    int w = start >> 5;
+    uint32_t bits = live[w] & (~0U << (start & 31));
+    for (int n = 0; n <= wheel_words; ++n) {
+	if (bits)
+	    return ((w << 5) + ffs_lsb(bits) - 1 - start) & wheel_mask;
+	w = (w + 1) % wheel_words;
+	bits = live[w];
+	if (n == wheel_words - 1)
+	    bits &= (1U << (start & 31)) - 1;
+    }
+    return -1;
+}
+
+void
+TimerSet::wheel_collect(Timer **slot)
+{
+    // Move the expired timers in @a slot to _timer_runchunk.
+    for (Timer *t = *slot, *next; t; t = next) {
+	next = t->_wheel_next;
+	if (t->_expiry <= _timer_check) {
+	    wheel_remove(t);
+	    t->_schedpos1 = -_timer_runchunk.size() - 1;
+	    _timer_runchunk.push_back(t);
+	}
+    }
+}
+
+static int
+wheel_expiry_compar(const void *a, const void *b, void *)
+{
+    const Timestamp &ea = (*static_cast<Timer * const *>(a))->expiry();
+    const Timestamp &eb = (*static_cast<Timer * const *>(b))->expiry();
+    return ea < eb ? -1 : (eb < ea ? 1 : 0);
+}
+
+void
+TimerSet::wheel_sort_runchunk()
+{
+    // Slots are unordered, so sort the collected timers by expiry and renumber
+    // their runchunk positions.
+    if (_timer_runchunk.size() > 1) {
+	click_qsort(_timer_runchunk.begin(), _timer_runchunk.size(),
+		    sizeof(Timer *), wheel_expiry_compar, 0);
+	for (int i = 0; i < _timer_runchunk.size(); ++i)
+	    _timer_runchunk[i]->_schedpos1 = -i - 1;
+    }
+}
+
+void
+TimerSet::wheel_cascade(int level, int index)
+{
+    // Reinsert the timers in a slot at @a level, which moves them to lower
+    // levels now that their expiry is near.
+    Timer *t = _wheel[level][index];
+    _wheel[level][index] = 0;
+    _wheel_live[level][index >> 5] &= ~(1U << (index & 31));
+    while (t) {
+	Timer *next = t->_wheel_next;
+	--_wheel_count;
+	wheel_insert(t);
+	t = next;
+    }
+}
+
+void
+TimerSet::wheel_advance()
+{
+    // Advance the wheel to the tick containing _timer_check, collecting
+    // expired timers.  The current tick's slot may hold timers that expire
+    // later in the tick, so the wheel stays on that tick.
+    wheel_tick_t target = wheel_tick(_timer_check);
+    if (_wheel_count == 0) {
+	if (target > _wheel_now)
+	    _wheel_now = target;
+	return;
+    }
+    while (1) {
+	int index = _wheel_now & wheel_mask;
+	if (index == 0 && _wheel_cascaded != _wheel_now) {
+	    _wheel_cascaded = _wheel_now;
+	    for (int level = 1; level < wheel_levels; ++level) {
+		int lindex = (_wheel_now >> (wheel_bits * level)) & wheel_mask;
+		wheel_cascade(level, lindex);
+		if (lindex != 0)
+		    break;
+	    }
+	}
+	if (_wheel[0][index])
+	    wheel_collect(&_wheel[0][index]);
+	if (_wheel_now >= target)
+	    break;
+
+	// skip empty slots, stopping at the next cascade
+	wheel_tick_t next = (_wheel_now | wheel_mask) + 1;
+	int d = wheel_next_slot(0, (index + 1) & wheel_mask);
+	if (d >= 0 && _wheel_now + 1 + d < next)
+	    next = _wheel_now + 1 + d;
+	_wheel_now = (next < target ? next : target);
+    }
+}
+
+void
+TimerSet::set_timer_expiry()
+{
+    // The first nonempty level-0 slot holds the first level-0 timer; find
+    // its exact expiry.  Each higher level contributes the time of its next
+    // cascade, which is a lower bound on its timers' expiries.  A far-off
+    // slot at a lower level may cascade after a near slot at a higher level,
+    // so every level must be consulted.  Waking at a lower bound costs only a
+    // cascade.
+    Timestamp e;
+    int index0 = _wheel_now & wheel_mask;
+    int d = wheel_next_slot(0, index0);
+    if (d >= 0)
+	for (Timer *t = _wheel[0][(index0 + d) & wheel_mask]; t; t = t->_wheel_next)
+	    if (!e || t->_expiry < e)
+		e = t->_expiry;
+    for (int level = 1; level < wheel_levels; ++level) {
+	int index = (_wheel_now >> (wheel_bits * level)) & wheel_mask;
+	if ((d = wheel_next_slot(level, index)) >= 0) {
+	    wheel_tick_t tick = (_wheel_now >> (wheel_bits * level)) + (d ? d : wheel_size);
+	    Timestamp cascade = wheel_tick_time(tick << (wheel_bits * level));
+	    if (!e || cascade < e)
+		e = cascade;
+	}
+    }
+    _timer_expiry = e;
+}
+#endif
+
+inline void
+TimerSet::run_one_timer(Timer *t)
+{
+#if CLICK_STATS >= 2
+    click_cycles_t start_cycles = click_get_cycles();
+#endif
+
+    t->_hook.callback(t, t->_thunk);
+
+#if CLICK_STATS >= 2
+    t->_owner->_timer_cycles += click_get_cycles() - start_cycles;
+    t->_owner->_timer_calls++;
+#endif
+}
+
+#if HAVE_TIMER_WHEEL
+void
+TimerSet::run_timers(RouterThread *thread, Master *master)
+{
+    if (!attempt_lock_timers())
+	return;
+    const volatile int *stopper = master->stopper_ptr();
+    if (!master->paused() && _timer_expiry && !*stopper) {
+	thread->set_thread_state(RouterThread::S_RUNTIMER);
+# if CLICK_LINUXMODULE
+	_timer_task = current;
+# endif
+	_timer_check = Timestamp::now();
+
+	if (_timer_expiry <= _timer_check) {
+	    // potentially adjust timer stride
+	    Timestamp adj_expiry = _timer_expiry + Timer::adjustment();
+	    if (adj_expiry <= _timer_check) {
+		_timer_count = 0;
+		if (_timer_stride > 1)
+		    _timer_stride = (_timer_stride * 4) / 5;
+	    } else if (++_timer_count >= 12) {
+		_timer_count = 0;
+		if (++_timer_stride >= _max_timer_stride)
+		    _timer_stride = _max_timer_stride;
+	    }
+
+	    // collect all expired timers in one batch, then run them
+	    wheel_advance();
+	    wheel_sort_runchunk();
+	    set_timer_expiry();
+
+	    Vector<Timer*>::iterator i = _timer_runchunk.begin();
+	    for (; !*stopper && i != _timer_runchunk.end(); ++i)
+		if (*i) {
+		    (*i)->_schedpos1 = 0;
+		    run_one_timer(*i);
+		}
+
+	    // reschedule unrun timers if stopped early
+	    for (; i != _timer_runchunk.end(); ++i)
+		if (*i) {
+		    (*i)->_schedpos1 = 0;
+		    (*i)->schedule_at((*i)->_expiry);
+		}
+	    _timer_runchunk.clear();
+	}
+
+# if CLICK_LINUXMODULE
+	_timer_task = 0;
+# endif
+    }
+    unlock_timers();
+}
+
+#else /* !HAVE_TIMER_WHEEL */
+
+void
+TimerSet::run_timers(RouterThread *thread, Master *master)
+{
+    if (!attempt_lock_timers())
+	return;
+    const volatile int *stopper = master->stopper_ptr();
+    if (!master->paused() && _timer_heap.size() > 0 && !*stopper) {
+	thread->set_thread_state(RouterThread::S_RUNTIMER);
+#if CLICK_LINUXMODULE
+	_timer_task = current;
+#endif
+	_timer_check = Timestamp::now();
+	Timer *t = _timer_heap.at_u(0);
+
+	if (t->_expiry <= _timer_check) {
+	    // potentially adjust timer stride
+	    Timestamp adj_expiry = t->_expiry + Timer::adjustment();
+	    if (adj_expiry <= _timer_check) {
+		_timer_count = 0;
+		if (_timer_stride > 1)
+		    _timer_stride = (_timer_stride * 4) / 5;
+	    } else if (++_timer_count >= 12) {
+		_timer_count = 0;
+		if (++_timer_stride >= _max_timer_stride)
+		    _timer_stride = _max_timer_stride;
+	    }
+
+	    // actually run timers
+	    int max_timers = 64;
+	    do {
+		pop_heap(_timer_heap.begin(), _timer_heap.end(), timer_less(), timer_place(_timer_heap.begin()));
+		_timer_heap.pop_back();
+		set_timer_expiry();
+		t->_schedpos1 = 0;
+
+		run_one_timer(t);
+	    } while (_timer_heap.size() > 0 && !*stopper
+		     && (t = _timer_heap.at_u(0), t->_expiry <= _timer_check)
+		     && --max_timers >= 0);
+
+	    // If we ran out of timers to run, then perhaps there's an
+	    // infinite timer loop or one timer is very far behind system
+	    // time.  Eventually the system would catch up and run all timers,
+	    // but in the meantime other timers could starve.  We detect this
+	    // case and run ALL expired timers, reducing possible damage.
+	    if (max_timers < 0 && !*stopper) {
+		_timer_runchunk.reserve(32);
+		do {
+		    pop_heap(_timer_heap.begin(), _timer_heap.end(), timer_less(), timer_place(_timer_heap.begin()));
+		    _timer_heap.pop_back();
+		    t->_schedpos1 = -_timer_runchunk.size() - 1;
+
+		    _timer_runchunk.push_back(t);
+		} while (_timer_heap.size() > 0
+			 && (t = _timer_heap.at_u(0), t->_expiry <= _timer_check));
+		set_timer_expiry();
+
+		Vector<Timer*>::iterator i = _timer_runchunk.begin();
+		for (; !*stopper && i != _timer_runchunk.end(); ++i)
+		    if (*i) {
+			(*i)->_schedpos1 = 0;
+			run_one_timer(*i);
+		    }
+
+		// reschedule unrun timers if stopped early
+		for (; i != _timer_runchunk.end(); ++i)
+		    if (*i) {
+			(*i)->_schedpos1 = 0;
+			(*i)->schedule_at((*i)->_expiry);
+		    }
+		_timer_runchunk.clear();
+	    }
+	}
+
+#if CLICK_LINUXMODULE
+	_timer_task = 0;
+#endif
+    }
+    unlock_timers();
+}
+#endif /* HAVE_TIMER_WHEEL */
+
+void
+TimerSet::kill_router(Router *router)
+{
+    lock_timers();
+    assert(!_timer_runchunk.size());
+#if HAVE_TIMER_WHEEL
+    for (int level = 0; level < wheel_levels; ++level)
+	for (int index = 0; index < wheel_size; ++index)
+	    for (Timer *t = _wheel[level][index], *next; t; t = next) {
+		next = t->_wheel_next;
+		if (t->router() == router) {
+		    wheel_remove(t);
+		    t->_owner = 0;
+		    t->_thread = 0;
+		    t->_schedpos1 = 0;
+		}
+	    }
+#else
+    Timer* t;
+    for (Timer** tp = _timer_heap.end(); tp > _timer_heap.begin(); )
+	if ((t = *--tp, t->router() == router)) {
+	    remove_heap(_timer_heap.begin(), _timer_heap.end(), tp, timer_less(), timer_place(_timer_heap.begin()));
+	    _timer_heap.pop_back();
+	    t->_owner = 0;
+	    t->_thread = 0;
+	    t->_schedpos1 = 0;
+	}
+#endif
+    set_timer_expiry();
+    unlock_timers();
+}
+
+CLICK_ENDDECLS
@@ -734,6 +734,9 @@ compressed_data(const unsigned char *buf, int len)
 	if (len >= 10 && memcmp(buf + 4, "1AY&SY", 6) == 0)
 	    return true;
     }
+    // check for zstd signatures
+    if (len >= 4 && memcmp(buf, "\x28\xB5\x2F\xFD", 4) == 0)
+	return true;
     // otherwise unknown
     return false;
 }
@@ -745,6 +748,8 @@ open_uncompress_pipe(const String &filename, const unsigned char *buf, int len,
     StringAccum cmd;
     if (buf[0] == 'B')
 	cmd << "bzcat";
+    else if (buf[0] == 0x28)
+	cmd << "zstd -dcq";
     else if (access("/usr/bin/gzcat", X_OK) >= 0)
 	cmd << "/usr/bin/gzcat";
     else
@@ -759,7 +764,7 @@ open_uncompress_pipe(const String &filename, const unsigned char *buf, int len,
 }
 
 enum {
-    COMP_COMPRESS = 1, COMP_GZIP = 2, COMP_BZ2 = 3
+    COMP_COMPRESS = 1, COMP_GZIP = 2, COMP_BZ2 = 3, COMP_ZSTD = 4
 };
 
 int
@@ -771,6 +776,8 @@ compressed_filename(const String &filename)
 	return COMP_GZIP;
     else if (filename.length() >= 4 && memcmp(filename.end() - 4, ".bz2", 4) == 0)
 	return COMP_BZ2;
+    else if (filename.length() >= 4 && memcmp(filename.end() - 4, ".zst", 4) == 0)
+	return COMP_ZSTD;
     else
 	return 0;
 }
@@ -790,6 +797,9 @@ open_compress_pipe(const String &filename, ErrorHandler *errh)
       case COMP_BZ2:
 	cmd << "bzip2";
 	break;
+      case COMP_ZSTD:
+	cmd << "zstd -q";
+	break;
       default:
 	errh->error("%s: unknown compression extension", filename.c_str());
 	errno = EINVAL;